@@ -64,6 +64,7 @@ static const char * const solver_code_names[NUM_SOLVER_CODES] = {
   "none",
   "rfw",
   "simplex",
+  "sparse-idl",
 };
 
 static const int32_t solver_code[NUM_SOLVER_CODES] = {
@@ -73,6 +74,7 @@ static const int32_t solver_code[NUM_SOLVER_CODES] = {
   CTX_CONFIG_NONE,
   CTX_CONFIG_ARITH_RFW,
   CTX_CONFIG_ARITH_SIMPLEX,
+  CTX_CONFIG_ARITH_SIDL,
 };
 
 
@@ -498,6 +500,16 @@ static int32_t arch_add_rfw(int32_t a) {
   return a;
 }
 
+// add the sparse IDL solver
+static int32_t arch_add_sidl(int32_t a) {
+  if (a == CTX_ARCH_NOSOLVERS) {
+    a = CTX_ARCH_SIDL;
+  } else {
+    a = -1;
+  }
+  return a;
+}
+
 
 // add solver identified by code c to a
 static int32_t arch_add_arith(int32_t a, solver_code_t c) {
@@ -518,6 +530,10 @@ static int32_t arch_add_arith(int32_t a, solver_code_t c) {
   case CTX_CONFIG_ARITH_RFW:
     a = arch_add_rfw(a);
     break;
+
+  case CTX_CONFIG_ARITH_SIDL:
+    a = arch_add_sidl(a);
+    break;
   }
   return a;
 }
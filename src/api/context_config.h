@@ -87,9 +87,10 @@ typedef enum solver_code {
   CTX_CONFIG_ARITH_SIMPLEX,   // simplex solver
   CTX_CONFIG_ARITH_IFW,       // integer Floyd-Warshall solver
   CTX_CONFIG_ARITH_RFW,       // real Floyd-Warshall solver
+  CTX_CONFIG_ARITH_SIDL,      // sparse integer difference logic solver
 } solver_code_t;
 
-#define NUM_SOLVER_CODES (CTX_CONFIG_ARITH_RFW+1)
+#define NUM_SOLVER_CODES (CTX_CONFIG_ARITH_SIDL+1)
 
 
 
@@ -38,6 +38,7 @@
  * Default restart parameters for SMT solving
  * Minisat-like behavior
  */
+#define DEFAULT_RESTART      RESTART_DEFAULT
 #define DEFAULT_FAST_RESTART false
 #define DEFAULT_C_THRESHOLD  100
 #define DEFAULT_D_THRESHOLD  100
@@ -52,6 +53,17 @@
 #define FAST_RESTART_C_FACTOR    1.1
 #define FAST_RESTART_D_FACTOR    1.1
 
+/*
+ * Parameters of the glucose and stable restart strategies:
+ * - glucose restarts when the recent glue average is 25% larger
+ *   than the long-term average
+ * - the first focused phase lasts 1000 conflicts, the next phases
+ *   are twice as long as the previous one
+ */
+#define DEFAULT_LBD_MARGIN      1.25
+#define DEFAULT_STAB_THRESHOLD  1000
+#define DEFAULT_STAB_FACTOR     2.0
+
 /*
  * Default clause deletion parameters
  */
@@ -74,6 +86,28 @@
 #define DEFAULT_TCLAUSE_SIZE   0
 
 
+/*
+ * Chronological backtracking is disabled by default
+ * - the default threshold is defined in smt_core.h
+ */
+#define DEFAULT_CHRONO_BACKTRACKING false
+#define DEFAULT_CHRONO_THRESHOLD    CHRONO_THRESHOLD
+
+
+/*
+ * Clause sharing is disabled by default
+ * - the default filters are defined in clause_ring.h
+ */
+#define DEFAULT_SHARE_CLAUSES     false
+#define DEFAULT_SHARE_MAX_LENGTH  DEF_SHARED_CLAUSE_LENGTH
+#define DEFAULT_SHARE_MAX_GLUE    DEF_SHARED_CLAUSE_GLUE
+
+/*
+ * SAT preprocessing is disabled by default
+ */
+#define DEFAULT_SAT_PREPROCESS    false
+
+
 /*
  * Default random seed as in smt_core.d
  */
@@ -84,6 +118,11 @@
  */
 #define DEFAULT_BRANCHING  BRANCHING_DEFAULT
 
+/*
+ * Default decision queue = the smt_core default (heap)
+ */
+#define DEFAULT_DECISION_QUEUE  DQUEUE_HEAP
+
 /*
  * The default EGRAPH parameters are defined in egraph_types.h
  * - DEFAULT_MAX_ACKERMANN = 1000
@@ -110,10 +149,12 @@
  * - propagation is disabled by default
  * - model adjustment is also disabled
  * - integer check is disabled too
+ * - cutting planes are disabled
  */
 #define DEFAULT_SIMPLEX_PROP_FLAG     false
 #define DEFAULT_SIMPLEX_ADJUST_FLAG   false
 #define DEFAULT_SIMPLEX_ICHECK_FLAG   false
+#define DEFAULT_SIMPLEX_CUTS_FLAG     false
 
 /*
  * Default parameters for the array solver (defined in fun_solver.h
@@ -122,15 +163,25 @@
  */
 
 
+/*
+ * Default for the bitvector solver: eager bit-blasting
+ */
+#define DEFAULT_LAZY_BITBLASTING      false
+
+
 /*
  * All default parameters
  */
 static const param_t default_settings = {
+  DEFAULT_RESTART,
   DEFAULT_FAST_RESTART,
   DEFAULT_C_THRESHOLD,
   DEFAULT_D_THRESHOLD,
   DEFAULT_C_FACTOR,
   DEFAULT_D_FACTOR,
+  DEFAULT_LBD_MARGIN,
+  DEFAULT_STAB_THRESHOLD,
+  DEFAULT_STAB_FACTOR,
 
   DEFAULT_R_THRESHOLD,
   DEFAULT_R_FRACTION,
@@ -140,9 +191,16 @@ static const param_t default_settings = {
   DEFAULT_RANDOMNESS,
   DEFAULT_RANDOM_SEED,
   DEFAULT_BRANCHING,
+  DEFAULT_DECISION_QUEUE,
   DEFAULT_CLAUSE_DECAY,
   DEFAULT_CACHE_TCLAUSES,
   DEFAULT_TCLAUSE_SIZE,
+  DEFAULT_CHRONO_BACKTRACKING,
+  DEFAULT_CHRONO_THRESHOLD,
+  DEFAULT_SHARE_CLAUSES,
+  DEFAULT_SHARE_MAX_LENGTH,
+  DEFAULT_SHARE_MAX_GLUE,
+  DEFAULT_SAT_PREPROCESS,
 
   DEFAULT_USE_DYN_ACK,
   DEFAULT_USE_BOOL_DYN_ACK,
@@ -161,9 +219,17 @@ static const param_t default_settings = {
   SIMPLEX_DEFAULT_PROP_ROW_SIZE,
   SIMPLEX_DEFAULT_BLAND_THRESHOLD,
   SIMPLEX_DEFAULT_CHECK_PERIOD,
+  DEFAULT_SIMPLEX_CUTS_FLAG,
+  SIMPLEX_DEFAULT_CUT_ROUNDS,
+  SIMPLEX_DEFAULT_MAX_CUTS,
+  SIMPLEX_DEFAULT_CUT_POOL_SIZE,
+  SIMPLEX_DEFAULT_CUT_EFFICACY,
+  SIMPLEX_DEFAULT_CUT_PARALLELISM,
 
   DEFAULT_MAX_UPDATE_CONFLICTS,
   DEFAULT_MAX_EXTENSIONALITY,
+
+  DEFAULT_LAZY_BITBLASTING,
 };
 
 
@@ -181,11 +247,15 @@ static const param_t default_settings = {
  */
 typedef enum param_key {
   // restart parameters
+  PARAM_RESTART,
   PARAM_FAST_RESTART,
   PARAM_C_THRESHOLD,
   PARAM_D_THRESHOLD,
   PARAM_C_FACTOR,
   PARAM_D_FACTOR,
+  PARAM_LBD_MARGIN,
+  PARAM_STAB_THRESHOLD,
+  PARAM_STAB_FACTOR,
   // clause deletion heuristic
   PARAM_R_THRESHOLD,
   PARAM_R_FRACTION,
@@ -195,10 +265,17 @@ typedef enum param_key {
   PARAM_RANDOMNESS,
   PARAM_RANDOM_SEED,
   PARAM_BRANCHING,
+  PARAM_DECISION_QUEUE,
   // learned clauses
   PARAM_CLAUSE_DECAY,
   PARAM_CACHE_TCLAUSES,
   PARAM_TCLAUSE_SIZE,
+  PARAM_CHRONO_BACKTRACKING,
+  PARAM_CHRONO_THRESHOLD,
+  PARAM_SHARE_CLAUSES,
+  PARAM_SHARE_MAX_LENGTH,
+  PARAM_SHARE_MAX_GLUE,
+  PARAM_SAT_PREPROCESS,
   // egraph parameters
   PARAM_DYN_ACK,
   PARAM_DYN_BOOL_ACK,
@@ -217,12 +294,20 @@ typedef enum param_key {
   PARAM_PROP_THRESHOLD,
   PARAM_BLAND_THRESHOLD,
   PARAM_ICHECK_PERIOD,
+  PARAM_SIMPLEX_CUTS,
+  PARAM_CUT_ROUNDS,
+  PARAM_MAX_CUTS,
+  PARAM_CUT_POOL_SIZE,
+  PARAM_CUT_MIN_EFFICACY,
+  PARAM_CUT_MAX_PARALLELISM,
   // array solver
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // bitvector solver
+  PARAM_LAZY_BITBLASTING,
 } param_key_t;
 
-#define NUM_PARAM_KEYS (PARAM_MAX_EXTENSIONALITY+1)
+#define NUM_PARAM_KEYS (PARAM_LAZY_BITBLASTING+1)
 
 // parameter names in lexicographic ordering
 static const char *const param_key_names[NUM_PARAM_KEYS] = {
@@ -233,9 +318,17 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "c-factor",
   "c-threshold",
   "cache-tclauses",
+  "chrono-backtracking",
+  "chrono-threshold",
   "clause-decay",
+  "cut-max-parallelism",
+  "cut-min-efficacy",
+  "cut-pool-size",
+  "cut-rounds",
+  "cuts",
   "d-factor",
   "d-threshold",
+  "decision-queue",
   "dyn-ack",
   "dyn-ack-threshold",
   "dyn-bool-ack",
@@ -243,8 +336,11 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "fast-restarts",
   "icheck",
   "icheck-period",
+  "lazy-bitblasting",
+  "lbd-margin",
   "max-ack",
   "max-bool-ack",
+  "max-cuts",
   "max-extensionality",
   "max-interface-eqs",
   "max-update-conflicts",
@@ -255,8 +351,15 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "r-threshold",
   "random-seed",
   "randomness",
+  "restart",
+  "sat-preprocess",
+  "share-clauses",
+  "share-max-glue",
+  "share-max-length",
   "simplex-adjust",
   "simplex-prop",
+  "stab-factor",
+  "stab-threshold",
   "tclause-size",
   "var-decay",
 };
@@ -270,9 +373,17 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_C_FACTOR,
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
+  PARAM_CHRONO_BACKTRACKING,
+  PARAM_CHRONO_THRESHOLD,
   PARAM_CLAUSE_DECAY,
+  PARAM_CUT_MAX_PARALLELISM,
+  PARAM_CUT_MIN_EFFICACY,
+  PARAM_CUT_POOL_SIZE,
+  PARAM_CUT_ROUNDS,
+  PARAM_SIMPLEX_CUTS,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
+  PARAM_DECISION_QUEUE,
   PARAM_DYN_ACK,
   PARAM_DYN_ACK_THRESHOLD,
   PARAM_DYN_BOOL_ACK,
@@ -280,8 +391,11 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_FAST_RESTART,
   PARAM_SIMPLEX_ICHECK,
   PARAM_ICHECK_PERIOD,
+  PARAM_LAZY_BITBLASTING,
+  PARAM_LBD_MARGIN,
   PARAM_MAX_ACK,
   PARAM_MAX_BOOL_ACK,
+  PARAM_MAX_CUTS,
   PARAM_MAX_EXTENSIONALITY,
   PARAM_MAX_INTERFACE_EQS,
   PARAM_MAX_UPDATE_CONFLICTS,
@@ -292,8 +406,15 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_R_THRESHOLD,
   PARAM_RANDOM_SEED,
   PARAM_RANDOMNESS,
+  PARAM_RESTART,
+  PARAM_SAT_PREPROCESS,
+  PARAM_SHARE_CLAUSES,
+  PARAM_SHARE_MAX_GLUE,
+  PARAM_SHARE_MAX_LENGTH,
   PARAM_SIMPLEX_ADJUST,
   PARAM_SIMPLEX_PROP,
+  PARAM_STAB_FACTOR,
+  PARAM_STAB_THRESHOLD,
   PARAM_TCLAUSE_SIZE,
   PARAM_VAR_DECAY,
 };
@@ -322,6 +443,42 @@ static const int32_t branching_code[NUM_BRANCHING_MODES] = {
 };
 
 
+/*
+ * Names of the decision queues (in lexicographic order)
+ */
+static const char * const decision_queues[NUM_DECISION_QUEUES] = {
+  "heap",
+  "vmtf",
+};
+
+static const int32_t decision_queue_code[NUM_DECISION_QUEUES] = {
+  DQUEUE_HEAP,
+  DQUEUE_VMTF,
+};
+
+
+/*
+ * Names of the restart strategies (in lexicographic order)
+ */
+static const char * const restart_strategies[NUM_RESTART_STRATEGIES] = {
+  "default",
+  "glucose",
+  "luby",
+  "minisat",
+  "picosat",
+  "stable",
+};
+
+static const int32_t restart_code[NUM_RESTART_STRATEGIES] = {
+  RESTART_DEFAULT,
+  RESTART_GLUCOSE,
+  RESTART_LUBY,
+  RESTART_MINISAT,
+  RESTART_PICOSAT,
+  RESTART_STABLE,
+};
+
+
 
 
 /****************
@@ -380,6 +537,52 @@ static int32_t set_branching_param(const char *value, branch_t *v) {
 }
 
 
+/*
+ * Parse value as a decision queue. Store the result in *v
+ * - return 0 if this works
+ * - return -2 otherwise
+ */
+static int32_t set_decision_queue_param(const char *value, dqueue_t *v) {
+  int32_t k;
+
+  k = parse_as_keyword(value, decision_queues, decision_queue_code, NUM_DECISION_QUEUES);
+  assert(k >= 0 || k == -1);
+
+  if (k >= 0) {
+    assert(DQUEUE_HEAP <= k && k <= DQUEUE_VMTF);
+    *v = (dqueue_t) k;
+    k = 0;
+  } else {
+    k = -2;
+  }
+
+  return k;
+}
+
+
+/*
+ * Parse value as a restart strategy. Store the result in *v
+ * - return 0 if this works
+ * - return -2 otherwise
+ */
+static int32_t set_restart_param(const char *value, restart_t *v) {
+  int32_t k;
+
+  k = parse_as_keyword(value, restart_strategies, restart_code, NUM_RESTART_STRATEGIES);
+  assert(k >= 0 || k == -1);
+
+  if (k >= 0) {
+    assert(RESTART_DEFAULT <= k && k <= RESTART_STABLE);
+    *v = (restart_t) k;
+    k = 0;
+  } else {
+    k = -2;
+  }
+
+  return k;
+}
+
+
 /*
  * Parse val as a signed 32bit integer. Check whether
  * the result is in the interval [low, high].
@@ -496,6 +699,10 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
 
   k = parse_as_keyword(key, param_key_names, param_code, NUM_PARAM_KEYS);
   switch (k) {
+  case PARAM_RESTART:
+    r = set_restart_param(value, &parameters->restart);
+    break;
+
   case PARAM_FAST_RESTART:
     r = set_bool_param(value, &parameters->fast_restart);
     break;
@@ -522,6 +729,21 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     r = set_double_param(value, &parameters->d_factor, 1.0, DBL_MAX);
     break;
 
+  case PARAM_LBD_MARGIN:
+    r = set_double_param(value, &parameters->lbd_margin, 1.0, DBL_MAX);
+    break;
+
+  case PARAM_STAB_THRESHOLD:
+    r = set_int32_param(value, &z, 1, INT32_MAX);
+    if (r == 0) {
+      parameters->stab_threshold = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_STAB_FACTOR:
+    r = set_double_param(value, &parameters->stab_factor, 1.0, DBL_MAX);
+    break;
+
   case PARAM_R_THRESHOLD:
     r = set_int32_param(value, &z, 1, INT32_MAX);
     if (r == 0) {
@@ -556,6 +778,10 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     r = set_branching_param(value, &parameters->branching);
     break;
 
+  case PARAM_DECISION_QUEUE:
+    r = set_decision_queue_param(value, &parameters->decision_queue);
+    break;
+
   case PARAM_CLAUSE_DECAY:
     r = set_double_param(value, &x, 0.0, 1.0);
     if (r == 0) {
@@ -574,6 +800,39 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_CHRONO_BACKTRACKING:
+    r = set_bool_param(value, &parameters->chrono_backtracking);
+    break;
+
+  case PARAM_CHRONO_THRESHOLD:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->chrono_threshold = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_SHARE_CLAUSES:
+    r = set_bool_param(value, &parameters->share_clauses);
+    break;
+
+  case PARAM_SHARE_MAX_LENGTH:
+    r = set_int32_param(value, &z, 1, CLAUSE_RING_MAX_LENGTH);
+    if (r == 0) {
+      parameters->share_max_length = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_SHARE_MAX_GLUE:
+    r = set_int32_param(value, &z, 1, INT32_MAX);
+    if (r == 0) {
+      parameters->share_max_glue = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_SAT_PREPROCESS:
+    r = set_bool_param(value, &parameters->sat_preprocess);
+    break;
+
   case PARAM_DYN_ACK:
     r = set_bool_param(value, &parameters->use_dyn_ack);
     break;
@@ -670,6 +929,39 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     r = set_int32_param(value, &parameters->integer_check_period, 1, INT32_MAX);
     break;
 
+  case PARAM_SIMPLEX_CUTS:
+    r = set_bool_param(value, &parameters->use_cuts);
+    break;
+
+  case PARAM_CUT_ROUNDS:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->cut_rounds = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_MAX_CUTS:
+    r = set_int32_param(value, &z, 1, INT32_MAX);
+    if (r == 0) {
+      parameters->max_cuts = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_CUT_POOL_SIZE:
+    r = set_int32_param(value, &z, 1, (int32_t) MAX_CUT_POOL_CAPACITY);
+    if (r == 0) {
+      parameters->cut_pool_size = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_CUT_MIN_EFFICACY:
+    r = set_double_param(value, &parameters->cut_min_efficacy, 0.0, DBL_MAX);
+    break;
+
+  case PARAM_CUT_MAX_PARALLELISM:
+    r = set_double_param(value, &parameters->cut_max_parallelism, 0.0, 1.0);
+    break;
+
   case PARAM_MAX_UPDATE_CONFLICTS:
     r = set_int32_param(value, &z, 1, INT32_MAX);
     if (r == 0) {
@@ -684,6 +976,10 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_LAZY_BITBLASTING:
+    r = set_bool_param(value, &parameters->lazy_bitblasting);
+    break;
+
   default:
     assert(k == -1);
     r = -1;
@@ -701,3 +997,99 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
 uint32_t params_default_random_seed(void) {
   return DEFAULT_RANDOM_SEED;
 }
+
+
+
+/****************************
+ *  PORTFOLIO PARAMETERS    *
+ ***************************/
+
+/*
+ * Profile for a portfolio worker:
+ * - restart = restart strategy (RESTART_DEFAULT means keep the base settings)
+ * - branching = branching heuristic
+ * - var_decay and randomness: same meaning as in param_t
+ *   (if var_decay is 0.0, the base settings are kept)
+ */
+typedef struct portfolio_profile_s {
+  restart_t restart;
+  branch_t branching;
+  double var_decay;
+  float randomness;
+} portfolio_profile_t;
+
+#define NUM_PORTFOLIO_PROFILES 8
+
+static const portfolio_profile_t portfolio_profile[NUM_PORTFOLIO_PROFILES] = {
+  { RESTART_DEFAULT, BRANCHING_DEFAULT,  0.0,  0.0F },
+  { RESTART_LUBY,    BRANCHING_DEFAULT,  0.95, 0.02F },
+  { RESTART_PICOSAT, BRANCHING_NEGATIVE, 0.95, 0.02F },
+  { RESTART_GLUCOSE, BRANCHING_DEFAULT,  0.90, 0.05F },
+  { RESTART_STABLE,  BRANCHING_POSITIVE, 0.99, 0.01F },
+  { RESTART_PICOSAT, BRANCHING_DEFAULT,  0.85, 0.02F },
+  { RESTART_MINISAT, BRANCHING_NEGATIVE, 0.99, 0.02F },
+  { RESTART_STABLE,  BRANCHING_DEFAULT,  0.90, 0.05F },
+};
+
+/*
+ * Multiplier used to derive a different random seed for each worker
+ */
+#define PORTFOLIO_SEED_MULTIPLIER 0x9e3779b9
+
+
+/*
+ * Initialize parameters for worker i of a portfolio:
+ * - copy base then modify the restart strategy, the branching
+ *   heuristic, var_decay, randomness, and the random seed.
+ * - worker 0 gets exactly the base parameters.
+ */
+void init_portfolio_params(param_t *parameters, const param_t *base, uint32_t i) {
+  const portfolio_profile_t *profile;
+
+  *parameters = *base;
+  if (i == 0) return;
+
+  parameters->random_seed = base->random_seed + i * ((uint32_t) PORTFOLIO_SEED_MULTIPLIER);
+
+  profile = portfolio_profile + (i % NUM_PORTFOLIO_PROFILES);
+  switch (profile->restart) {
+  case RESTART_DEFAULT:
+    break;
+
+  case RESTART_MINISAT:
+    parameters->restart = RESTART_MINISAT;
+    parameters->c_threshold = DEFAULT_C_THRESHOLD;
+    parameters->c_factor = DEFAULT_C_FACTOR;
+    break;
+
+  case RESTART_PICOSAT:
+    parameters->restart = RESTART_PICOSAT;
+    parameters->c_threshold = FAST_RESTART_C_THRESHOLD;
+    parameters->d_threshold = FAST_RESTART_D_THRESHOLD;
+    parameters->c_factor = FAST_RESTART_C_FACTOR;
+    parameters->d_factor = FAST_RESTART_D_FACTOR;
+    break;
+
+  case RESTART_LUBY:
+    parameters->restart = RESTART_LUBY;
+    parameters->c_threshold = FAST_RESTART_C_THRESHOLD;
+    break;
+
+  case RESTART_GLUCOSE:
+  case RESTART_STABLE:
+    parameters->restart = profile->restart;
+    parameters->c_threshold = FAST_RESTART_C_THRESHOLD;
+    parameters->lbd_margin = DEFAULT_LBD_MARGIN;
+    parameters->stab_threshold = DEFAULT_STAB_THRESHOLD;
+    parameters->stab_factor = DEFAULT_STAB_FACTOR;
+    break;
+  }
+
+  if (profile->branching != BRANCHING_DEFAULT) {
+    parameters->branching = profile->branching;
+  }
+  if (profile->var_decay > 0.0) {
+    parameters->var_decay = profile->var_decay;
+    parameters->randomness = profile->randomness;
+  }
+}
@@ -46,6 +46,50 @@ typedef enum {
 #define NUM_BRANCHING_MODES 6
 
 
+/*
+ * Decision queues: select the next decision variable
+ * - DQUEUE_HEAP: activity-based heuristic (VSIDS), the smt_core default
+ * - DQUEUE_VMTF: variable move-to-front: the most recently bumped
+ *   unassigned variable is selected
+ */
+typedef enum {
+  DQUEUE_HEAP,
+  DQUEUE_VMTF,
+} dqueue_t;
+
+#define NUM_DECISION_QUEUES 2
+
+
+/*
+ * Restart strategies:
+ * - RESTART_DEFAULT: select MINISAT, PICOSAT, or LUBY based on
+ *   fast_restart and c_factor (see param_s below)
+ * - RESTART_MINISAT: geometric restarts defined by c_threshold and c_factor
+ * - RESTART_PICOSAT: inner restarts (c_threshold, c_factor) and
+ *   outer restarts (d_threshold, d_factor)
+ * - RESTART_LUBY: Luby sequence, c_threshold is the base period
+ * - RESTART_GLUCOSE: dynamic restarts based on the glue (LBD) of
+ *   learned clauses: restart when the recent average glue is larger
+ *   than lbd_margin times the long-term average
+ * - RESTART_STABLE: alternate between focused phases that use glucose
+ *   restarts and stable phases that use Luby restarts with a long period.
+ *   In stable phases, decisions follow the target phase (the polarities
+ *   of the largest conflict-free assignment found since the last restart).
+ *   The first phase is focused and lasts stab_threshold conflicts. Each
+ *   subsequent phase is longer by a factor of stab_factor.
+ */
+typedef enum {
+  RESTART_DEFAULT,
+  RESTART_MINISAT,
+  RESTART_PICOSAT,
+  RESTART_LUBY,
+  RESTART_GLUCOSE,
+  RESTART_STABLE,
+} restart_t;
+
+#define NUM_RESTART_STRATEGIES 6
+
+
 struct param_s {
   /*
    * Restart heuristic: similar to PICOSAT or MINISAT
@@ -63,12 +107,19 @@ struct param_s {
    * - set fast_restart to true and c_factor to 0.0
    * - then c_threshold defines the base period
    * - d_threshold and d_factor are ignored
+   *
+   * These rules apply if restart is RESTART_DEFAULT. Otherwise,
+   * restart selects the strategy and fast_restart is ignored.
    */
+  restart_t restart;        // restart strategy
   bool     fast_restart;
   uint32_t c_threshold;     // initial value of c_threshold
   uint32_t d_threshold;     // initial value of d_threshold
   double   c_factor;        // increase factor for next c_threshold
   double   d_factor;        // increase factor for next d_threshold
+  double   lbd_margin;      // glucose restarts
+  uint32_t stab_threshold;  // length of the first phase (stable restarts)
+  double   stab_factor;     // increase factor for the next phase length
 
   /*
    * Clause-deletion heuristic
@@ -83,6 +134,8 @@ struct param_s {
    * SMT Core parameters:
    * - randomness and var_decay are used by the branching heuristic
    *   the default branching mode uses the cached polarity in smt_core.
+   * - decision_queue selects the decision variables (var_decay is
+   *   ignored by the VMTF queue)
    * - clause_decay influence clause deletion
    * - random seed
    *
@@ -95,14 +148,40 @@ struct param_s {
    *   in a conflict resolution
    * - parameter tclause_size controls the lemma size: only theory lemmas
    *   of size <= tclause_size are turned into learned clauses
+   *
+   * Chronological backtracking:
+   * - if chrono_backtracking is true, the core backtracks by a single
+   *   level after a conflict if a backjump would undo more than
+   *   chrono_threshold decision levels
    */
   double   var_decay;       // decay factor for variable activity
   float    randomness;      // probability of a random pick in select_unassigned_literal
   uint32_t random_seed;
   branch_t branching;       // branching heuristic
+  dqueue_t decision_queue;  // heap or VMTF
   float    clause_decay;    // decay factor for learned-clause activity
   bool     cache_tclauses;
   uint32_t tclause_size;
+  bool     chrono_backtracking;
+  uint32_t chrono_threshold;
+
+  /*
+   * Clause sharing between parallel searches (portfolio solver):
+   * - if share_clauses is true, the workers exchange their learned
+   *   clauses of length <= share_max_length and glue <= share_max_glue
+   * - share_max_length must be between 1 and CLAUSE_RING_MAX_LENGTH
+   */
+  bool     share_clauses;
+  uint32_t share_max_length;
+  uint32_t share_max_glue;
+
+  /*
+   * SAT preprocessing: if sat_preprocess is true, the clauses are
+   * simplified before the search (failed-literal probing, subsumption,
+   * and bounded variable elimination). This is used only by contexts
+   * that don't support push/pop.
+   */
+  bool     sat_preprocess;
 
   /*
    * EGRAPH PARAMETERS
@@ -152,6 +231,17 @@ struct param_s {
    * - max_prop_row_size: limit on the size of the propagation rows
    * - bland_threshold: threshold that triggers switching to Bland's rule
    * - integer_check_period: how often the integer solver is called
+   *
+   * Cutting planes:
+   * - use_cuts: if true, the simplex solver adds Gomory and MIR cuts
+   *   before creating branch-and-bound atoms
+   * - cut_rounds: number of cut rounds before a branch atom is created
+   * - max_cuts: maximal number of cuts added per round
+   * - cut_pool_size: number of cuts kept for reuse
+   * - cut_min_efficacy: cuts whose efficacy (distance to the current
+   *   solution) is less than this are ignored
+   * - cut_max_parallelism: a cut is not added if the cosine between it
+   *   and a cut of the same round is more than this
    */
   bool     use_simplex_prop;
   bool     adjust_simplex_model;
@@ -159,6 +249,12 @@ struct param_s {
   uint32_t max_prop_row_size;
   uint32_t bland_threshold;
   int32_t  integer_check_period;
+  bool     use_cuts;
+  uint32_t cut_rounds;
+  uint32_t max_cuts;
+  uint32_t cut_pool_size;
+  double   cut_min_efficacy;
+  double   cut_max_parallelism;
 
   /*
    * ARRAY SOLVER PARAMETERS
@@ -170,6 +266,14 @@ struct param_s {
   uint32_t max_update_conflicts;
   uint32_t max_extensionality;
 
+  /*
+   * BITVECTOR SOLVER PARAMETERS
+   * - lazy_bitblasting: if true, bvmul, division, and remainder
+   *   are not bitblasted upfront. They are treated as uninterpreted
+   *   and refined when the candidate model violates them.
+   */
+  bool     lazy_bitblasting;
+
 };
 
 
@@ -210,4 +314,14 @@ extern int32_t params_set_field(param_t *parameters, const char *key, const char
 extern uint32_t params_default_random_seed(void);
 
 
+/*
+ * Parameters for worker i of a portfolio (cf. context/portfolio.h)
+ * - base = parameters for worker 0
+ * - the other workers use a variant of base with a different restart
+ *   strategy, branching heuristic, var_decay, randomness, and random seed.
+ * - the result is stored in *parameters
+ */
+extern void init_portfolio_params(param_t *parameters, const param_t *base, uint32_t i);
+
+
 #endif /* __SEARCH_PARAMETERS_H */
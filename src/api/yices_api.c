@@ -66,6 +66,7 @@
 #include "api/yval.h"
 
 #include "context/context.h"
+#include "context/portfolio.h"
 
 #include "frontend/yices/yices_parser.h"
 
@@ -74,6 +75,7 @@
 #include "io/type_printer.h"
 #include "io/yices_pp.h"
 
+#include "model/eval_plans.h"
 #include "model/generalization.h"
 #include "model/literal_collector.h"
 #include "model/map_to_model.h"
@@ -241,6 +243,17 @@ typedef struct {
 static dl_list_t model_list;
 
 
+/*
+ * Evaluation plans
+ */
+typedef struct {
+  dl_list_t header;
+  eval_plan_t plan;
+} eval_plan_elem_t;
+
+static dl_list_t eval_plan_list;
+
+
 /*
  * Context configuration and parameter descriptors
  * are stored in one list.
@@ -626,6 +639,71 @@ static void free_model_list(void) {
 
 
 
+/**********************************
+ *  EVALUATION PLAN ALLOCATION    *
+ *********************************/
+
+/*
+ * Get the header of plan p, assuming p is embedded in an eval_plan_elem
+ */
+static inline dl_list_t *header_of_eval_plan(eval_plan_t *p) {
+  return (dl_list_t *)(((char *) p) - offsetof(eval_plan_elem_t, plan));
+}
+
+/*
+ * Get the plan of header l
+ */
+static inline eval_plan_t *eval_plan_of_header(dl_list_t *l) {
+  return (eval_plan_t *) (((char *) l) + offsetof(eval_plan_elem_t, plan));
+}
+
+/*
+ * Allocate a fresh plan object and insert it in the eval_plan_list
+ * - WARNING: the plan is not initialized
+ */
+static inline eval_plan_t *alloc_eval_plan(void) {
+  eval_plan_elem_t *new_elem;
+
+  new_elem = (eval_plan_elem_t *) safe_malloc(sizeof(eval_plan_elem_t));
+  list_insert_next(&eval_plan_list, &new_elem->header);
+  return &new_elem->plan;
+}
+
+
+/*
+ * Remove p from the list and free p
+ * - WARNING: make sure to call delete_eval_plan(p) before this
+ *   function
+ */
+static inline void free_eval_plan(eval_plan_t *p) {
+  dl_list_t *elem;
+
+  elem = header_of_eval_plan(p);
+  list_remove(elem);
+  safe_free(elem);
+}
+
+
+/*
+ * Cleanup the plan list
+ */
+static void free_eval_plan_list(void) {
+  dl_list_t *elem, *aux;
+
+  elem = eval_plan_list.next;
+  while (elem != &eval_plan_list) {
+    aux = elem->next;
+    delete_eval_plan(eval_plan_of_header(elem));
+    safe_free(elem);
+    elem = aux;
+  }
+
+  clear_list(&eval_plan_list);
+}
+
+
+
+
 /********************************************
  *  CONFIG AND SEARCH PARAMETER STRUCTURES  *
  *******************************************/
@@ -855,6 +933,7 @@ EXPORTED void yices_init(void) {
   // other dynamic object lists
   clear_list(&context_list);
   clear_list(&model_list);
+  clear_list(&eval_plan_list);
   clear_list(&generic_list);
 
   // parser etc.
@@ -903,6 +982,7 @@ EXPORTED void yices_exit(void) {
 
   free_context_list();
   free_model_list();
+  free_eval_plan_list();
   free_generic_list();
 
   delete_term_manager(&manager);
@@ -6707,16 +6787,24 @@ typedef enum ctx_option {
   CTX_OPTION_KEEP_ITE,
   CTX_OPTION_EAGER_ARITH_LEMMAS,
   CTX_OPTION_ASSERT_ITE_BOUNDS,
+  CTX_OPTION_ARITH_STEEPEST_EDGE,
+  CTX_OPTION_ARITH_DEVEX,
+  CTX_OPTION_ARITH_BOUND_FLIPPING,
+  CTX_OPTION_ARITH_FP_WARM_START,
 } ctx_option_t;
 
-#define NUM_CTX_OPTIONS (CTX_OPTION_ASSERT_ITE_BOUNDS+1)
+#define NUM_CTX_OPTIONS (CTX_OPTION_ARITH_FP_WARM_START+1)
 
 
 /*
  * Option names in lexicographic order
  */
 static const char * const ctx_option_names[NUM_CTX_OPTIONS] = {
+  "arith-bound-flipping",
+  "arith-devex",
   "arith-elim",
+  "arith-fp-warm-start",
+  "arith-steepest-edge",
   "assert-ite-bounds",
   "break-symmetries",
   "bvarith-elim",
@@ -6732,7 +6820,11 @@ static const char * const ctx_option_names[NUM_CTX_OPTIONS] = {
  * Corresponding index (cf. string_utils.h for parse_as_keyword)
  */
 static const int32_t ctx_option_key[NUM_CTX_OPTIONS] = {
+  CTX_OPTION_ARITH_BOUND_FLIPPING,
+  CTX_OPTION_ARITH_DEVEX,
   CTX_OPTION_ARITH_ELIM,
+  CTX_OPTION_ARITH_FP_WARM_START,
+  CTX_OPTION_ARITH_STEEPEST_EDGE,
   CTX_OPTION_ASSERT_ITE_BOUNDS,
   CTX_OPTION_BREAK_SYMMETRIES,
   CTX_OPTION_BVARITH_ELIM,
@@ -6789,6 +6881,22 @@ EXPORTED int32_t yices_context_enable_option(context_t *ctx, const char *option)
     enable_assert_ite_bounds(ctx);
     break;
 
+  case CTX_OPTION_ARITH_STEEPEST_EDGE:
+    enable_splx_steepest_edge(ctx);
+    break;
+
+  case CTX_OPTION_ARITH_DEVEX:
+    enable_splx_devex(ctx);
+    break;
+
+  case CTX_OPTION_ARITH_BOUND_FLIPPING:
+    enable_splx_bound_flipping(ctx);
+    break;
+
+  case CTX_OPTION_ARITH_FP_WARM_START:
+    enable_splx_fp_warm_start(ctx);
+    break;
+
   default:
     assert(k == -1);
     // not recognized
@@ -6846,6 +6954,22 @@ EXPORTED int32_t yices_context_disable_option(context_t *ctx, const char *option
     disable_assert_ite_bounds(ctx);
     break;
 
+  case CTX_OPTION_ARITH_STEEPEST_EDGE:
+    disable_splx_steepest_edge(ctx);
+    break;
+
+  case CTX_OPTION_ARITH_DEVEX:
+    disable_splx_devex(ctx);
+    break;
+
+  case CTX_OPTION_ARITH_BOUND_FLIPPING:
+    disable_splx_bound_flipping(ctx);
+    break;
+
+  case CTX_OPTION_ARITH_FP_WARM_START:
+    disable_splx_fp_warm_start(ctx);
+    break;
+
   default:
     assert(k == -1);
     // not recognized
@@ -7065,6 +7189,20 @@ EXPORTED void yices_reset_context(context_t *ctx) {
 }
 
 
+/*
+ * If ctx's status is UNSAT because of assumptions (cf.
+ * yices_check_context_with_assumptions), restore it to IDLE:
+ * the assertions may still be satisfiable.
+ * - this requires support for multiple checks
+ */
+static void clear_unsat_assumptions(context_t *ctx) {
+  if (context_unsat_by_assumptions(ctx) && context_supports_multichecks(ctx)) {
+    context_clear(ctx);
+    assert(context_status(ctx) == STATUS_IDLE);
+  }
+}
+
+
 /*
  * Push: mark a backtrack point
  * - return 0 if this operation is supported by the context
@@ -7082,6 +7220,8 @@ EXPORTED int32_t yices_push(context_t *ctx) {
     return -1;
   }
 
+  clear_unsat_assumptions(ctx);
+
   switch (context_status(ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -7244,6 +7384,8 @@ EXPORTED int32_t yices_assert_formula(context_t *ctx, term_t t) {
     return -1;
   }
 
+  clear_unsat_assumptions(ctx);
+
   switch (context_status(ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -7294,6 +7436,8 @@ EXPORTED int32_t yices_assert_formulas(context_t *ctx, uint32_t n, const term_t
     return -1;
   }
 
+  clear_unsat_assumptions(ctx);
+
   switch (context_status(ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -7399,6 +7543,7 @@ void yices_set_default_params(param_t *params, smt_logic_t logic, context_arch_t
     params->branching = BRANCHING_THEORY;
     params->cache_tclauses = true;
     params->tclause_size = 8;
+    params->chrono_backtracking = true;
     if (logic == QF_LIA || logic == QF_LIRA) {
       params->use_simplex_prop = true;
       params->tclause_size = 20;
@@ -7429,6 +7574,7 @@ void yices_set_default_params(param_t *params, smt_logic_t logic, context_arch_t
     params->cache_tclauses = true;
     params->tclause_size = 8;
     params->use_optimistic_fcheck = true;
+    params->chrono_backtracking = true;
     if (logic == QF_UFLIA || logic == QF_UFLIRA || logic == QF_AUFLIA || logic == QF_ALIA || logic == QF_UFIDL) {
       params->branching = BRANCHING_NEGATIVE;
       params->max_interface_eqs = 15;
@@ -7468,6 +7614,12 @@ void yices_set_default_params(param_t *params, smt_logic_t logic, context_arch_t
     }
     break;
 
+  case CTX_ARCH_SIDL:
+    params->branching = BRANCHING_THEORY;
+    params->cache_tclauses = true;
+    params->tclause_size = 8;
+    break;
+
   case CTX_ARCH_IFW:
   case CTX_ARCH_RFW:
     params->cache_tclauses = true;
@@ -7544,6 +7696,8 @@ EXPORTED smt_status_t yices_check_context(context_t *ctx, const param_t *params)
   param_t default_params;
   smt_status_t stat;
 
+  clear_unsat_assumptions(ctx);
+
   stat = context_status(ctx);
   switch (stat) {
   case STATUS_UNKNOWN:
@@ -7579,6 +7733,126 @@ EXPORTED smt_status_t yices_check_context(context_t *ctx, const param_t *params)
 }
 
 
+/*
+ * Check satisfiability under assumptions t[0 ... n-1]:
+ * - each t[i] must be a Boolean term
+ * - params is as in yices_check_context
+ * - the assumptions are decided first during the search, so the
+ *   learned clauses are kept after the check (no push/pop needed)
+ *
+ * If ctx's status is IDLE, the search is done as in yices_check_context.
+ * If ctx's status is SAT or UNKNOWN, or UNSAT because of the assumptions
+ * of the previous call, the context is cleared first. This requires
+ * support for multiple checks.
+ * If ctx's status is UNSAT (without assumptions), the function
+ * returns UNSAT.
+ *
+ * If the result is UNSAT, the subset of assumptions that caused unsat
+ * can be obtained by calling yices_get_unsat_core.
+ *
+ * Error report:
+ * - if some t[i] is not a Boolean term, or if internalization fails:
+ *   same error codes as yices_assert_formula
+ * - if ctx's status is SAT or UNKNOWN and ctx does not support
+ *   multiple checks:
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ * - if ctx uses MCSAT:
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ * - if ctx's status is SEARCHING or INTERRUPTED:
+ *   code = CTX_INVALID_OPERATION
+ */
+EXPORTED smt_status_t yices_check_context_with_assumptions(context_t *ctx, const param_t *params, uint32_t n, const term_t t[]) {
+  param_t default_params;
+  ivector_t assumptions;
+  smt_status_t stat;
+  int32_t code;
+
+  if (! check_good_terms(&manager, n, t) ||
+      ! check_boolean_args(&manager, n, t)) {
+    return STATUS_ERROR;
+  }
+
+  if (ctx->mcsat != NULL) {
+    error.code = CTX_OPERATION_NOT_SUPPORTED;
+    return STATUS_ERROR;
+  }
+
+  clear_unsat_assumptions(ctx);
+
+  stat = context_status(ctx);
+  switch (stat) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    if (! context_supports_multichecks(ctx)) {
+      error.code = CTX_OPERATION_NOT_SUPPORTED;
+      return STATUS_ERROR;
+    }
+    context_clear(ctx);
+    assert(context_status(ctx) == STATUS_IDLE);
+    // fall-through intended
+  case STATUS_IDLE:
+    init_ivector(&assumptions, n);
+    code = context_process_assumptions(ctx, n, t, &assumptions);
+    if (code < 0) {
+      convert_internalization_error(code);
+      stat = STATUS_ERROR;
+    } else {
+      if (params == NULL) {
+        yices_default_params_for_context(ctx, &default_params);
+        params = &default_params;
+      }
+      stat = check_context_with_assumptions(ctx, params, n, assumptions.data);
+      if (stat == STATUS_INTERRUPTED && context_supports_cleaninterrupt(ctx)) {
+        context_cleanup(ctx);
+      }
+    }
+    delete_ivector(&assumptions);
+    break;
+
+  case STATUS_UNSAT:
+    break;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    error.code = CTX_INVALID_OPERATION;
+    stat = STATUS_ERROR;
+    break;
+
+  case STATUS_ERROR:
+  default:
+    error.code = INTERNAL_EXCEPTION;
+    stat = STATUS_ERROR;
+    break;
+  }
+
+  return stat;
+}
+
+
+/*
+ * Get the assumptions that caused unsat:
+ * - ctx's status must be UNSAT
+ * - the assumptions are copied into vector v (which must be initialized)
+ * - v is empty if ctx is unsat independently of the assumptions
+ *
+ * Return code: 0 if there's no error, -1 otherwise
+ *
+ * Error report:
+ * - if ctx's status is not UNSAT
+ *   code = CTX_INVALID_OPERATION
+ */
+EXPORTED int32_t yices_get_unsat_core(context_t *ctx, term_vector_t *v) {
+  if (context_status(ctx) != STATUS_UNSAT) {
+    error.code = CTX_INVALID_OPERATION;
+    return -1;
+  }
+
+  context_build_unsat_core(ctx, (ivector_t *) v);
+
+  return 0;
+}
+
+
 /*
  * Interrupt the search:
  * - this can be called from a signal handler to stop the search,
@@ -7595,6 +7869,87 @@ EXPORTED void yices_stop_search(context_t *ctx) {
 }
 
 
+/*
+ * Portfolio check: search n contexts in parallel.
+ * - ctx[0 ... n-1] must be n distinct contexts, all with status IDLE,
+ *   that contain the same assertions.
+ * - params = base search parameters (if NULL, the default parameters
+ *   for ctx[0] are used)
+ * - context i is searched using a variant of params (different restart
+ *   strategy, branching, var_decay, and random seed). ctx[0] uses
+ *   params unchanged.
+ *
+ * The first context to return SAT or UNSAT wins. The search in the other
+ * contexts is interrupted. The function returns the winner's status and
+ * stores the winner's index in *winner. If no context decides the problem,
+ * the function returns UNKNOWN (and *winner is the index of a context whose
+ * status is UNKNOWN) or INTERRUPTED (and *winner is -1).
+ *
+ * After the call, the contexts that lost are either restored to IDLE (if they
+ * support clean interrupts) or left in state INTERRUPTED.
+ *
+ * Parallel search requires a thread-safe build of Yices. Otherwise,
+ * only ctx[0] is searched.
+ *
+ * Errors:
+ * - if n is zero or some context is repeated in ctx, or if
+ *   some context's status is not IDLE
+ *   code = CTX_INVALID_OPERATION
+ * - if some context uses MCSAT
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ */
+EXPORTED smt_status_t yices_check_context_portfolio(uint32_t n, context_t *ctx[], const param_t *params, int32_t *winner) {
+  param_t default_params;
+  param_t *wparams;
+  smt_status_t stat;
+  uint32_t i, j;
+
+  if (n == 0) {
+    error.code = CTX_INVALID_OPERATION;
+    return STATUS_ERROR;
+  }
+
+  for (i=0; i<n; i++) {
+    if (context_status(ctx[i]) != STATUS_IDLE) {
+      error.code = CTX_INVALID_OPERATION;
+      return STATUS_ERROR;
+    }
+    if (ctx[i]->mcsat != NULL) {
+      error.code = CTX_OPERATION_NOT_SUPPORTED;
+      return STATUS_ERROR;
+    }
+    for (j=0; j<i; j++) {
+      if (ctx[i] == ctx[j]) {
+        error.code = CTX_INVALID_OPERATION;
+        return STATUS_ERROR;
+      }
+    }
+  }
+
+  if (params == NULL) {
+    yices_default_params_for_context(ctx[0], &default_params);
+    params = &default_params;
+  }
+
+  wparams = (param_t *) safe_malloc(n * sizeof(param_t));
+  for (i=0; i<n; i++) {
+    init_portfolio_params(wparams + i, params, i);
+  }
+
+  stat = check_context_portfolio(ctx, wparams, n, winner);
+
+  for (i=0; i<n; i++) {
+    if (context_status(ctx[i]) == STATUS_INTERRUPTED && context_supports_cleaninterrupt(ctx[i])) {
+      context_cleanup(ctx[i]);
+    }
+  }
+
+  safe_free(wparams);
+
+  return stat;
+}
+
+
 /************
  *  MODELS  *
  ***********/
@@ -8730,6 +9085,116 @@ EXPORTED int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a
 
 
 
+/*
+ * EVALUATION PLANS
+ */
+
+/*
+ * Build an evaluation plan for terms a[0 ... n-1]
+ * - return NULL if a term is invalid
+ */
+EXPORTED eval_plan_t *yices_new_eval_plan(uint32_t n, const term_t a[]) {
+  eval_plan_t *plan;
+
+  if (! check_good_terms(&manager, n, a)) {
+    return NULL;
+  }
+
+  plan = alloc_eval_plan();
+  init_eval_plan(plan, &terms, n, a);
+
+  return plan;
+}
+
+
+/*
+ * Delete a plan
+ */
+EXPORTED void yices_free_eval_plan(eval_plan_t *plan) {
+  delete_eval_plan(plan);
+  free_eval_plan(plan);
+}
+
+
+/*
+ * Values of the plan's terms in mdl, converted to terms
+ * - same behavior as yices_term_array_value
+ */
+EXPORTED int32_t yices_eval_plan_value(eval_plan_t *plan, model_t *mdl, term_t b[]) {
+  int32_t eval_code;
+  uint32_t count, n;
+
+  eval_code = eval_plan_values(plan, mdl, b);
+  if (eval_code < 0) {
+    error.code = yices_eval_error(eval_code);
+    return -1;
+  }
+
+  n = eval_plan_num_terms(plan);
+  count = convert_value_array(&terms, model_get_vtbl(mdl), n, b);
+  if (count < n) {
+    error.code = EVAL_CONVERSION_FAILED;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+/*
+ * Evaluate plan[j] in mdl[j] for j=0 ... m-1, using up to nthreads threads
+ * - the evaluation is done in read-only mode, then the values are
+ *   converted to terms by the calling thread
+ */
+EXPORTED int32_t yices_eval_plans_in_models(uint32_t m, eval_plan_t *const plan[], model_t *const mdl[],
+                                            term_t *const b[], int32_t status[], uint32_t nthreads) {
+  eval_plan_job_t *job;
+  error_code_t first_error;
+  uint32_t j, count, n;
+
+  if (m == 0) {
+    return 0;
+  }
+
+  job = (eval_plan_job_t *) safe_malloc(m * sizeof(eval_plan_job_t));
+  for (j=0; j<m; j++) {
+    job[j].plan = plan[j];
+    job[j].model = mdl[j];
+    job[j].value = b[j];
+  }
+
+  eval_plan_run_jobs(job, m, nthreads);
+
+  first_error = NO_ERROR;
+  for (j=0; j<m; j++) {
+    status[j] = NO_ERROR;
+    if (job[j].code < 0) {
+      status[j] = yices_eval_error(job[j].code);
+    } else {
+      n = eval_plan_num_terms(plan[j]);
+      count = convert_value_array(&terms, &job[j].vtbl, n, b[j]);
+      if (count < n) {
+        status[j] = EVAL_CONVERSION_FAILED;
+      }
+    }
+    delete_value_table(&job[j].vtbl);
+    if (first_error == NO_ERROR) {
+      first_error = status[j];
+    }
+  }
+
+  safe_free(job);
+
+  if (first_error != NO_ERROR) {
+    error.code = first_error;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+
 
 
 /*
@@ -9091,6 +9556,17 @@ static void model_list_gc_mark(void) {
   }
 }
 
+// scan the list of evaluation plans and mark their terms
+static void eval_plan_list_gc_mark(void) {
+  dl_list_t *elem;
+
+  elem = eval_plan_list.next;
+  while (elem != &eval_plan_list) {
+    eval_plan_gc_mark(eval_plan_of_header(elem));
+    elem = elem->next;
+  }
+}
+
 // mark all terms in array a, n = size of a
 static void mark_term_array(term_table_t *tbl, const term_t *a, uint32_t n) {
   uint32_t i;
@@ -9137,6 +9613,7 @@ EXPORTED void yices_garbage_collect(const term_t t[], uint32_t nt,
    */
   context_list_gc_mark();
   model_list_gc_mark();
+  eval_plan_list_gc_mark();
 
   /*
    * Add roots from t and tau
@@ -27,6 +27,7 @@
 #include "context/ite_flattener.h"
 #include "solvers/bv/bvsolver.h"
 #include "solvers/floyd_warshall/idl_floyd_warshall.h"
+#include "solvers/floyd_warshall/idl_sparse.h"
 #include "solvers/floyd_warshall/rdl_floyd_warshall.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
@@ -4648,6 +4649,7 @@ static const uint32_t arch2theories[NUM_ARCH] = {
   ARITH_MASK,                  //  CTX_ARCH_SPLX
   IDL_MASK,                    //  CTX_ARCH_IFW
   RDL_MASK,                    //  CTX_ARCH_RFW
+  IDL_MASK,                    //  CTX_ARCH_SIDL
   BV_MASK,                     //  CTX_ARCH_BV
   UF_MASK|FUN_MASK,            //  CTX_ARCH_EGFUN
   UF_MASK|ARITH_MASK,          //  CTX_ARCH_EGSPLX
@@ -4678,6 +4680,7 @@ static const uint32_t arch2theories[NUM_ARCH] = {
 #define BVSLVR 0x10
 #define FSLVR  0x20
 #define MCSAT  0x40
+#define SIDL   0x80
 
 static const uint8_t arch_components[NUM_ARCH] = {
   0,                        //  CTX_ARCH_NOSOLVERS
@@ -4686,6 +4689,7 @@ static const uint8_t arch_components[NUM_ARCH] = {
   SPLX,                     //  CTX_ARCH_SPLX
   IFW,                      //  CTX_ARCH_IFW
   RFW,                      //  CTX_ARCH_RFW
+  SIDL,                     //  CTX_ARCH_SIDL
   BVSLVR,                   //  CTX_ARCH_BV
   EGRPH|FSLVR,              //  CTX_ARCH_EGFUN
   EGRPH|SPLX,               //  CTX_ARCH_EGSPLX
@@ -4747,6 +4751,12 @@ bool context_has_rdl_solver(context_t *ctx) {
   return ctx->arith_solver != NULL && (solvers & RFW);
 }
 
+bool context_has_sidl_solver(context_t *ctx) {
+  uint8_t solvers;
+  solvers = arch_components[ctx->arch];
+  return ctx->arith_solver != NULL && (solvers & SIDL);
+}
+
 bool context_has_simplex_solver(context_t *ctx) {
   uint8_t solvers;
   solvers = arch_components[ctx->arch];
@@ -4802,6 +4812,64 @@ void disable_splx_eqprop(context_t *ctx) {
   }
 }
 
+void enable_splx_steepest_edge(context_t *ctx) {
+  ctx->options &= ~SPLX_DEVEX_OPTION_MASK;
+  ctx->options |= SPLX_SEDGE_OPTION_MASK;
+  if (context_has_simplex_solver(ctx)) {
+    simplex_enable_steepest_edge(ctx->arith_solver);
+  }
+}
+
+void disable_splx_steepest_edge(context_t *ctx) {
+  ctx->options &= ~SPLX_SEDGE_OPTION_MASK;
+  if (context_has_simplex_solver(ctx)) {
+    simplex_disable_steepest_edge(ctx->arith_solver);
+  }
+}
+
+void enable_splx_devex(context_t *ctx) {
+  ctx->options &= ~SPLX_SEDGE_OPTION_MASK;
+  ctx->options |= SPLX_DEVEX_OPTION_MASK;
+  if (context_has_simplex_solver(ctx)) {
+    simplex_enable_devex(ctx->arith_solver);
+  }
+}
+
+void disable_splx_devex(context_t *ctx) {
+  ctx->options &= ~SPLX_DEVEX_OPTION_MASK;
+  if (context_has_simplex_solver(ctx)) {
+    simplex_disable_devex(ctx->arith_solver);
+  }
+}
+
+void enable_splx_bound_flipping(context_t *ctx) {
+  ctx->options |= SPLX_BFLIP_OPTION_MASK;
+  if (context_has_simplex_solver(ctx)) {
+    simplex_enable_bound_flipping(ctx->arith_solver);
+  }
+}
+
+void disable_splx_bound_flipping(context_t *ctx) {
+  ctx->options &= ~SPLX_BFLIP_OPTION_MASK;
+  if (context_has_simplex_solver(ctx)) {
+    simplex_disable_bound_flipping(ctx->arith_solver);
+  }
+}
+
+void enable_splx_fp_warm_start(context_t *ctx) {
+  ctx->options |= SPLX_FPWS_OPTION_MASK;
+  if (context_has_simplex_solver(ctx)) {
+    simplex_enable_fp_warm_start(ctx->arith_solver);
+  }
+}
+
+void disable_splx_fp_warm_start(context_t *ctx) {
+  ctx->options &= ~SPLX_FPWS_OPTION_MASK;
+  if (context_has_simplex_solver(ctx)) {
+    simplex_disable_fp_warm_start(ctx->arith_solver);
+  }
+}
+
 
 
 
@@ -4909,6 +4977,33 @@ static void create_idl_solver(context_t *ctx, bool automatic) {
 }
 
 
+/*
+ * Create and initialize the sparse idl solver and attach it to the core
+ * - same conventions as create_idl_solver
+ */
+static void create_sidl_solver(context_t *ctx, bool automatic) {
+  sidl_solver_t *solver;
+  smt_mode_t cmode;
+
+  assert(ctx->egraph == NULL && ctx->arith_solver == NULL && ctx->bv_solver == NULL &&
+         ctx->fun_solver == NULL && ctx->core != NULL);
+
+  cmode = core_mode[ctx->mode];
+  solver = (sidl_solver_t *) safe_malloc(sizeof(sidl_solver_t));
+  init_sidl_solver(solver, ctx->core, &ctx->gate_manager);
+  if (automatic) {
+    smt_core_reset_thsolver(ctx->core, solver, sidl_ctrl_interface(solver),
+			    sidl_smt_interface(solver));
+  } else {
+    init_smt_core(ctx->core, CTX_DEFAULT_CORE_SIZE, solver, sidl_ctrl_interface(solver),
+		  sidl_smt_interface(solver), cmode);
+  }
+  sidl_solver_init_jmpbuf(solver, &ctx->env);
+  ctx->arith_solver = solver;
+  ctx->arith = *sidl_arith_interface(solver);
+}
+
+
 /*
  * Create and initialize the rdl solver and attach it to the core.
  * - there must be no other solvers and no egraph
@@ -4965,6 +5060,18 @@ static void create_simplex_solver(context_t *ctx, bool automatic) {
   if (splx_eqprop_enabled(ctx)) {
     simplex_enable_eqprop(solver);
   }
+  if (splx_steepest_edge_enabled(ctx)) {
+    simplex_enable_steepest_edge(solver);
+  }
+  if (splx_devex_enabled(ctx)) {
+    simplex_enable_devex(solver);
+  }
+  if (splx_bound_flipping_enabled(ctx)) {
+    simplex_enable_bound_flipping(solver);
+  }
+  if (splx_fp_warm_start_enabled(ctx)) {
+    simplex_enable_fp_warm_start(solver);
+  }
 
   // row saving must be enabled unless we're in ONECHECK mode
   if (ctx->mode != CTX_MODE_ONECHECK) {
@@ -5014,9 +5121,10 @@ static void create_auto_idl_solver(context_t *ctx) {
     create_simplex_solver(ctx, true);
     ctx->arch = CTX_ARCH_SPLX;
   } else if (profile->num_vars >= 1000) {
-    // too many variables for FW
-    create_simplex_solver(ctx, true);
-    ctx->arch = CTX_ARCH_SPLX;
+    // too many variables for FW: use the sparse solver
+    create_sidl_solver(ctx, true);
+    ctx->arch = CTX_ARCH_SIDL;
+    enable_diseq_and_or_flattening(ctx);
   } else if (profile->num_vars <= 200 || profile->num_eqs == 0) {
     // use FW for now, until we've tested SIMPLEX more
     // 0 equalities usually means a scheduling problem
@@ -5178,6 +5286,8 @@ static void init_solvers(context_t *ctx) {
     create_idl_solver(ctx, false);
   } else if (solvers & RFW) {
     create_rdl_solver(ctx, false);
+  } else if (solvers & SIDL) {
+    create_sidl_solver(ctx, false);
   }
 
   // Bitvector solver
@@ -5244,6 +5354,8 @@ static void delete_arith_solver(context_t *ctx) {
     delete_idl_solver(ctx->arith_solver);
   } else if (solvers & RFW) {
     delete_rdl_solver(ctx->arith_solver);
+  } else if (solvers & SIDL) {
+    delete_sidl_solver(ctx->arith_solver);
   } else if (solvers & SPLX) {
     delete_simplex_solver(ctx->arith_solver);
   }
@@ -5342,6 +5454,7 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
   init_ivector(&ctx->aux_vector, CTX_DEFAULT_VECTOR_SIZE);
   init_int_queue(&ctx->queue, 0);
   init_istack(&ctx->istack);
+  init_ivector(&ctx->assumptions, 0);
   init_sharing_map(&ctx->sharing, &ctx->intern);
   init_objstore(&ctx->cstore, sizeof(conditional_t), 32);
 
@@ -5431,6 +5544,7 @@ void delete_context(context_t *ctx) {
   delete_ivector(&ctx->aux_vector);
   delete_int_queue(&ctx->queue);
   delete_istack(&ctx->istack);
+  delete_ivector(&ctx->assumptions);
   delete_sharing_map(&ctx->sharing);
   delete_objstore(&ctx->cstore);
 
@@ -5482,6 +5596,7 @@ void reset_context(context_t *ctx) {
   ivector_reset(&ctx->aux_vector);
   int_queue_reset(&ctx->queue);
   reset_istack(&ctx->istack);
+  ivector_reset(&ctx->assumptions);
   reset_sharing_map(&ctx->sharing);
   reset_objstore(&ctx->cstore);
 
@@ -5881,6 +5996,32 @@ int32_t context_internalize(context_t *ctx, term_t t) {
 }
 
 
+/*
+ * Convert the assumptions t[0 ... n-1] to literals
+ * - all t[i]s must be boolean terms
+ * - the terms are stored in ctx->assumptions and the literals in v
+ * - return CTX_NO_ERROR or a negative error code
+ */
+int32_t context_process_assumptions(context_t *ctx, uint32_t n, const term_t *t, ivector_t *v) {
+  uint32_t i;
+  literal_t l;
+
+  ivector_reset(&ctx->assumptions);
+  ivector_reset(v);
+  for (i=0; i<n; i++) {
+    l = context_internalize(ctx, t[i]);
+    if (l < 0) {
+      ivector_reset(&ctx->assumptions);
+      return l;
+    }
+    ivector_push(&ctx->assumptions, t[i]);
+    ivector_push(v, l);
+  }
+
+  return CTX_NO_ERROR;
+}
+
+
 /*
  * PROVISIONAL: FOR TESTING/DEBUGGING
  */
@@ -6160,6 +6301,8 @@ static void ctx_mark_eq(void *aux, const pmap2_rec_t *p) {
  * that they use.
  */
 void context_gc_mark(context_t *ctx) {
+  uint32_t i, n;
+
   if (ctx->egraph != NULL) {
     egraph_gc_mark(ctx->egraph);
   }
@@ -6169,6 +6312,11 @@ void context_gc_mark(context_t *ctx) {
 
   intern_tbl_gc_mark(&ctx->intern);
 
+  n = ctx->assumptions.size;
+  for (i=0; i<n; i++) {
+    term_table_set_gc_mark(ctx->terms, index_of(ctx->assumptions.data[i]));
+  }
+
   // empty all the term vectors to be safe
   ivector_reset(&ctx->top_eqs);
   ivector_reset(&ctx->top_atoms);
@@ -97,12 +97,32 @@ extern void disable_splx_periodic_icheck(context_t *ctx);
 extern void enable_splx_eqprop(context_t *ctx);
 extern void disable_splx_eqprop(context_t *ctx);
 
+/*
+ * Pivoting strategies: steepest-edge and devex pricing are exclusive
+ * (enabling one disables the other). Bound flipping can be combined
+ * with either.
+ */
+extern void enable_splx_steepest_edge(context_t *ctx);
+extern void disable_splx_steepest_edge(context_t *ctx);
+extern void enable_splx_devex(context_t *ctx);
+extern void disable_splx_devex(context_t *ctx);
+extern void enable_splx_bound_flipping(context_t *ctx);
+extern void disable_splx_bound_flipping(context_t *ctx);
+
+/*
+ * Floating-point warm start: when the search starts, the simplex
+ * solver computes a starting basis in floating point.
+ */
+extern void enable_splx_fp_warm_start(context_t *ctx);
+extern void disable_splx_fp_warm_start(context_t *ctx);
+
 
 /*
  * Check which variant of the arithmetic solver is present
  */
 extern bool context_has_idl_solver(context_t *ctx);
 extern bool context_has_rdl_solver(context_t *ctx);
+extern bool context_has_sidl_solver(context_t *ctx);
 extern bool context_has_simplex_solver(context_t *ctx);
 
 
@@ -142,6 +162,16 @@ extern int32_t assert_formulas(context_t *ctx, uint32_t n, const term_t *f);
 extern int32_t context_internalize(context_t *ctx, term_t t);
 
 
+/*
+ * Convert the assumptions t[0 ... n-1] to literals
+ * - all t[i]s must be boolean terms
+ * - the terms are stored in ctx->assumptions and their literals in v
+ * - return CTX_NO_ERROR if all the terms could be internalized
+ * - return a negative error code otherwise
+ */
+extern int32_t context_process_assumptions(context_t *ctx, uint32_t n, const term_t *t, ivector_t *v);
+
+
 /*
  * Add the blocking clause to ctx
  * - ctx->status must be either SAT or UNKNOWN
@@ -169,6 +199,31 @@ extern int32_t assert_blocking_clause(context_t *ctx);
 extern smt_status_t check_context(context_t *ctx, const param_t *parameters);
 
 
+/*
+ * Check whether the context is consistent under assumptions
+ * - a[0 ... n-1] = literals that must be true (e.g., obtained by
+ *   context_process_assumptions)
+ * - the assumptions are used as the first decisions in the search so
+ *   the learned clauses are kept after the check.
+ * - other parameters and return status are as in check_context
+ *
+ * If the result is UNSAT because of the assumptions, the context
+ * can be restored to IDLE by calling context_clear. The assumptions
+ * that caused unsat can be obtained by context_build_unsat_core.
+ */
+extern smt_status_t check_context_with_assumptions(context_t *ctx, const param_t *parameters,
+                                                   uint32_t n, const literal_t *a);
+
+
+/*
+ * Get the assumptions that caused UNSAT:
+ * - ctx's status must be UNSAT
+ * - the terms are copied into v (from ctx->assumptions)
+ * - v is empty if the context is UNSAT without assumptions
+ */
+extern void context_build_unsat_core(context_t *ctx, ivector_t *v);
+
+
 /*
  * Build a model: the context's status must be STATUS_SAT or STATUS_UNKNOWN
  * - model must be initialized (and empty)
@@ -206,6 +261,8 @@ extern void context_cleanup(context_t *ctx);
  * Clear boolean assignment and return to the IDLE state.
  * - this can be called after check returns UNKNOWN or SEARCHING
  *   provided the context's mode isn't ONECHECK
+ * - this can also be called if check_context_with_assumptions
+ *   returned UNSAT because of the assumptions
  * - after this call, additional formulas can be asserted and
  *   another call to check_context is allowed. Model construction
  *   is no longer possible until the next call to check_context.
@@ -282,6 +339,14 @@ static inline smt_status_t context_status(context_t *ctx) {
 }
 
 
+/*
+ * Check whether ctx's status is UNSAT because of the assumptions
+ */
+static inline bool context_unsat_by_assumptions(context_t *ctx) {
+  return ctx->arch != CTX_ARCH_MCSAT && smt_unsat_by_assumptions(ctx->core);
+}
+
+
 /*
  * Read the base_level (= number of calls to push)
  */
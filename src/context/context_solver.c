@@ -32,6 +32,7 @@
 #include "context/context.h"
 #include "context/internalization_codes.h"
 #include "model/models.h"
+#include "solvers/bv/bvsolver.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
 
@@ -132,6 +133,15 @@ static void search(smt_core_t *core, uint32_t conflict_bound, uint32_t *reduce_t
       trace_reduce(core, core->stats.learned_clauses_deleted - deletions);
     }
 
+    // assumptions are decided first
+    l = get_next_assumption(core);
+    if (l != null_literal) {
+      decide_literal(core, l);
+      smt_process(core);
+      continue;
+    }
+    if (smt_status(core) != STATUS_SEARCHING) break;
+
     // decision
     l = select_unassigned_literal(core);
     if (l == null_literal) {
@@ -148,15 +158,21 @@ static void search(smt_core_t *core, uint32_t conflict_bound, uint32_t *reduce_t
 
 
 /*
- * HACK: Variant for Luby restart:
+ * Polarity selection (implements branching heuristics)
+ * - filter is given a literal l + core and must return either l or not l
+ */
+typedef literal_t (*branching_fun_t)(smt_core_t *core, literal_t l);
+
+
+/*
+ * Bounded search with a non-default branching heuristics
  * - search until the conflict bound is reached or until the problem is solved.
  * - reduce_threshold: number of learned clauses above which reduce_clause_database is called
  * - r_factor = increment factor for reduce_threshold
- * - use the default branching heuristic implemented by the core
- *
- * This uses smt_bounded_process to force more frequent restarts.
+ * - use the branching heuristic implemented by branch
  */
-static void luby_search(smt_core_t *core, uint32_t conflict_bound, uint32_t *reduce_threshold, double r_factor) {
+static void special_search(smt_core_t *core, uint32_t conflict_bound, uint32_t *reduce_threshold,
+                           double r_factor, branching_fun_t branch) {
   uint64_t max_conflicts;
   uint64_t deletions;
   uint32_t r_threshold;
@@ -167,8 +183,8 @@ static void luby_search(smt_core_t *core, uint32_t conflict_bound, uint32_t *red
   max_conflicts = num_conflicts(core) + conflict_bound;
   r_threshold = *reduce_threshold;
 
-  smt_bounded_process(core, max_conflicts);
-  while (smt_status(core) == STATUS_SEARCHING && num_conflicts(core) < max_conflicts) {
+  smt_process(core);
+  while (smt_status(core) == STATUS_SEARCHING && num_conflicts(core) <= max_conflicts) {
     // reduce heuristic
     if (num_learned_clauses(core) >= r_threshold) {
       deletions = core->stats.learned_clauses_deleted;
@@ -177,48 +193,95 @@ static void luby_search(smt_core_t *core, uint32_t conflict_bound, uint32_t *red
       trace_reduce(core, core->stats.learned_clauses_deleted - deletions);
     }
 
+    // assumptions are decided first (no branching heuristic)
+    l = get_next_assumption(core);
+    if (l != null_literal) {
+      decide_literal(core, l);
+      smt_process(core);
+      continue;
+    }
+    if (smt_status(core) != STATUS_SEARCHING) break;
+
     // decision
     l = select_unassigned_literal(core);
     if (l == null_literal) {
-      // all variables assigned: Call final_check
+      // all variables assigned: call final check
       smt_final_check(core);
     } else {
+      // apply the branching heuristic
+      l = branch(core, l);
+      // propagation
       decide_literal(core, l);
-      smt_bounded_process(core, max_conflicts);
+      smt_process(core);
     }
   }
 
   *reduce_threshold = r_threshold;
 }
 
+
+
 /*
- * Polarity selection (implements branching heuristics)
- * - filter is given a literal l + core and must return either l or not l
+ * Dynamic restarts (glucose-style): a restart is triggered when the
+ * recent learned clauses have a larger glue than the long-term average
+ * (cf. smt_lbd_restart_due). To avoid restarting too often, at least
+ * LBD_RESTART_MIN_CONFLICTS conflicts must occur between two restarts.
  */
-typedef literal_t (*branching_fun_t)(smt_core_t *core, literal_t l);
+#define LBD_RESTART_MIN_CONFLICTS 50
+
+/*
+ * Bounded propagation for dynamic_search:
+ * - max_conflicts = conflict bound
+ * - if lbd_margin is positive, also stop after a conflict if a dynamic
+ *   restart is due and at least min_conflicts conflicts have been reached
+ * - return true if the search must stop for a restart, false if
+ *   propagation is complete (or if the core status is no longer SEARCHING)
+ */
+static bool dynamic_process(smt_core_t *core, uint64_t max_conflicts, uint64_t min_conflicts, double lbd_margin) {
+  uint64_t bound;
+
+  for (;;) {
+    bound = max_conflicts;
+    if (lbd_margin > 0.0) {
+      // stop after the next conflict
+      bound = num_conflicts(core) + 1;
+      if (bound < min_conflicts) bound = min_conflicts;
+      if (bound > max_conflicts) bound = max_conflicts;
+    }
+    if (smt_bounded_process(core, bound)) return false;
+    if (num_conflicts(core) >= max_conflicts) return true;
+    if (smt_lbd_restart_due(core, lbd_margin)) return true;
+  }
+}
 
 
 /*
- * Bounded search with a non-default branching heuristics
- * - search until the conflict bound is reached or until the problem is solved.
+ * Bounded search for Luby, glucose, and stable restarts
+ * - search until the conflict bound is reached, until a dynamic restart is due,
+ *   or until the problem is solved.
+ * - lbd_margin: margin for dynamic restarts (0.0 means no dynamic restarts)
  * - reduce_threshold: number of learned clauses above which reduce_clause_database is called
  * - r_factor = increment factor for reduce_threshold
- * - use the branching heuristic implemented by branch
+ * - branch = branching heuristic (NULL means use the default heuristic of the core)
+ *
+ * This uses smt_bounded_process to force more frequent restarts.
  */
-static void special_search(smt_core_t *core, uint32_t conflict_bound, uint32_t *reduce_threshold,
-                           double r_factor, branching_fun_t branch) {
-  uint64_t max_conflicts;
+static void dynamic_search(smt_core_t *core, uint32_t conflict_bound, double lbd_margin,
+                           uint32_t *reduce_threshold, double r_factor, branching_fun_t branch) {
+  uint64_t max_conflicts, min_conflicts;
   uint64_t deletions;
   uint32_t r_threshold;
   literal_t l;
+  bool restart;
 
   assert(smt_status(core) == STATUS_SEARCHING || smt_status(core) == STATUS_INTERRUPTED);
 
   max_conflicts = num_conflicts(core) + conflict_bound;
+  min_conflicts = num_conflicts(core) + LBD_RESTART_MIN_CONFLICTS;
   r_threshold = *reduce_threshold;
 
-  smt_process(core);
-  while (smt_status(core) == STATUS_SEARCHING && num_conflicts(core) <= max_conflicts) {
+  restart = dynamic_process(core, max_conflicts, min_conflicts, lbd_margin);
+  while (smt_status(core) == STATUS_SEARCHING && !restart) {
     // reduce heuristic
     if (num_learned_clauses(core) >= r_threshold) {
       deletions = core->stats.learned_clauses_deleted;
@@ -227,17 +290,26 @@ static void special_search(smt_core_t *core, uint32_t conflict_bound, uint32_t *
       trace_reduce(core, core->stats.learned_clauses_deleted - deletions);
     }
 
+    // assumptions are decided first (no branching heuristic)
+    l = get_next_assumption(core);
+    if (l != null_literal) {
+      decide_literal(core, l);
+      restart = dynamic_process(core, max_conflicts, min_conflicts, lbd_margin);
+      continue;
+    }
+    if (smt_status(core) != STATUS_SEARCHING) break;
+
     // decision
     l = select_unassigned_literal(core);
     if (l == null_literal) {
       // all variables assigned: call final check
       smt_final_check(core);
     } else {
-      // apply the branching heuristic
-      l = branch(core, l);
-      // propagation
+      if (branch != NULL) {
+        l = branch(core, l);
+      }
       decide_literal(core, l);
-      smt_process(core);
+      restart = dynamic_process(core, max_conflicts, min_conflicts, lbd_margin);
     }
   }
 
@@ -294,6 +366,27 @@ static literal_t theory_or_pos_branch(smt_core_t *core, literal_t l) {
 }
 
 
+/*
+ * Branching function for parameter b (NULL for the default heuristic)
+ */
+static branching_fun_t branching_function(branch_t b) {
+  switch (b) {
+  case BRANCHING_NEGATIVE:
+    return negative_branch;
+  case BRANCHING_POSITIVE:
+    return positive_branch;
+  case BRANCHING_THEORY:
+    return theory_branch;
+  case BRANCHING_TH_NEG:
+    return theory_or_neg_branch;
+  case BRANCHING_TH_POS:
+    return theory_or_pos_branch;
+  default:
+    return NULL;
+  }
+}
+
+
 
 
 
@@ -301,31 +394,93 @@ static literal_t theory_or_pos_branch(smt_core_t *core, literal_t l) {
  * CORE SOLVER
  */
 
+/*
+ * Restart strategy for the given parameters:
+ * - RESTART_DEFAULT is converted to Minisat, Picosat, or Luby
+ *   based on fast_restart and c_factor.
+ */
+static restart_t restart_strategy(const param_t *params) {
+  restart_t r;
+
+  r = params->restart;
+  if (r == RESTART_DEFAULT) {
+    r = RESTART_MINISAT;
+    if (params->fast_restart) {
+      // HACK to activate the Luby heuristic:
+      // c_factor must be 0.0 and fast_restart must be true
+      r = (params->c_factor == 0.0) ? RESTART_LUBY : RESTART_PICOSAT;
+    }
+  }
+
+  return r;
+}
+
+
+/*
+ * Next term in the Luby sequence: v = length of the next run
+ * (in multiples of the period)
+ */
+static void luby_next(uint32_t *u, uint32_t *v) {
+  if ((*u & - *u) == *v) {
+    (*u) ++;
+    *v = 1;
+  } else {
+    *v <<= 1;
+  }
+}
+
+
+/*
+ * In stable phases, the Luby period is STABLE_LUBY_FACTOR * c_threshold
+ */
+#define STABLE_LUBY_FACTOR 10
+
+
 /*
  * Full solver:
  * - params: heuristic parameters.
  *   If params is NULL, the default settings are used.
+ *
+ * Restart strategies:
+ * - Minisat: c_threshold is multiplied by c_factor after every restart
+ * - Picosat: inner restarts as in Minisat, with an outer loop that resets
+ *   c_threshold when it reaches d_threshold (d_threshold is multiplied by d_factor)
+ * - Luby: c_threshold = c_threshold * the Luby sequence
+ * - Glucose: restart when smt_lbd_restart_due(core, lbd_margin) holds
+ * - Stable: alternate between focused phases (glucose restarts) and stable
+ *   phases (Luby restarts with a longer period, target-phase branching).
+ *   The first phase is focused and lasts stab_threshold conflicts. The
+ *   length of each phase is multiplied by stab_factor.
  */
 static void solve(smt_core_t *core, const param_t *params) {
-  bool luby;
+  restart_t restart;
+  branching_fun_t branch;
   uint32_t c_threshold, d_threshold; // Picosat-style
   uint32_t u, v, period;             // for Luby-style
+  uint64_t phase_end;                // for stabilization
+  double phase_length;
+  uint32_t bound;
   uint32_t reduce_threshold;
+  bool stable;
 
   assert(smt_status(core) == STATUS_IDLE);
 
+  restart = restart_strategy(params);
+  branch = branching_function(params->branching);
+
   c_threshold = params->c_threshold;
   d_threshold = c_threshold; // required by trace_start in slow_restart mode
-  luby = false;
   u = 1;
   v = 1;
   period = c_threshold;
+  stable = false;
+  phase_length = params->stab_threshold;
+  phase_end = 0;
 
-  if (params->fast_restart) {
+  if (restart == RESTART_PICOSAT) {
     d_threshold = params->d_threshold;
-    // HACK to activate the Luby heuristic:
-    // c_factor must be 0.0 and fast_restart must be true
-    luby = params->c_factor == 0.0; 
+  } else if (restart == RESTART_STABLE) {
+    period = c_threshold * STABLE_LUBY_FACTOR;
   }
 
   reduce_threshold = (uint32_t) (num_prob_clauses(core) * params->r_fraction);
@@ -334,34 +489,41 @@ static void solve(smt_core_t *core, const param_t *params) {
   }
 
   // initialize then do a propagation + simplification step.
+  smt_set_stable_mode(core, false);
   start_search(core);
   trace_start(core);
+  phase_end = num_conflicts(core) + (uint64_t) phase_length;
 
   if (smt_status(core) == STATUS_SEARCHING) {
     // loop
     for (;;) {
-      switch (params->branching) {
-      case BRANCHING_DEFAULT:
-	if (luby) {
-	  luby_search(core, c_threshold, &reduce_threshold, params->r_factor);
-	} else {
-	  search(core, c_threshold, &reduce_threshold, params->r_factor);
-	}
-        break;
-      case BRANCHING_NEGATIVE:
-        special_search(core, c_threshold, &reduce_threshold, params->r_factor, negative_branch);
-        break;
-      case BRANCHING_POSITIVE:
-        special_search(core, c_threshold, &reduce_threshold, params->r_factor, positive_branch);
+      switch (restart) {
+      case RESTART_LUBY:
+        dynamic_search(core, c_threshold, 0.0, &reduce_threshold, params->r_factor, branch);
         break;
-      case BRANCHING_THEORY:
-        special_search(core, c_threshold, &reduce_threshold, params->r_factor, theory_branch);
+
+      case RESTART_GLUCOSE:
+        dynamic_search(core, UINT32_MAX, params->lbd_margin, &reduce_threshold, params->r_factor, branch);
         break;
-      case BRANCHING_TH_NEG:
-        special_search(core, c_threshold, &reduce_threshold, params->r_factor, theory_or_neg_branch);
+
+      case RESTART_STABLE:
+        // don't go past the end of the current phase
+        bound = (phase_end > num_conflicts(core)) ? (uint32_t) (phase_end - num_conflicts(core)) : 1;
+        if (stable) {
+          if (bound > c_threshold) bound = c_threshold;
+          dynamic_search(core, bound, 0.0, &reduce_threshold, params->r_factor, branch);
+        } else {
+          dynamic_search(core, bound, params->lbd_margin, &reduce_threshold, params->r_factor, branch);
+        }
         break;
-      case BRANCHING_TH_POS:
-        special_search(core, c_threshold, &reduce_threshold, params->r_factor, theory_or_pos_branch);
+
+      default:
+        // Minisat or Picosat
+        if (branch == NULL) {
+          search(core, c_threshold, &reduce_threshold, params->r_factor);
+        } else {
+          special_search(core, c_threshold, &reduce_threshold, params->r_factor, branch);
+        }
         break;
       }
 
@@ -370,18 +532,42 @@ static void solve(smt_core_t *core, const param_t *params) {
       smt_restart(core);
       //      smt_partial_restart_var(core);
 
-      if (luby) {
-	// Luby-style restart
-	if ((u & -u) == v) {
-	  u ++;
-	  v = 1;
-	} else {
-	  v <<= 1;
-	}
-	c_threshold = v * period;
-	trace_restart(core);
+      // get the clauses learned by other cores if any
+      smt_import_shared_clauses(core);
 
-      } else {
+      switch (restart) {
+      case RESTART_LUBY:
+        luby_next(&u, &v);
+        c_threshold = v * period;
+        trace_restart(core);
+        break;
+
+      case RESTART_GLUCOSE:
+        trace_inner_restart(core);
+        break;
+
+      case RESTART_STABLE:
+        if (num_conflicts(core) >= phase_end) {
+          // switch mode and start a longer phase
+          stable = !stable;
+          smt_set_stable_mode(core, stable);
+          phase_length *= params->stab_factor;
+          if (phase_length > (double) UINT32_MAX) phase_length = (double) UINT32_MAX;
+          phase_end = num_conflicts(core) + (uint64_t) phase_length;
+          u = 1;
+          v = 1;
+          c_threshold = period;
+          trace_restart(core);
+        } else if (stable) {
+          luby_next(&u, &v);
+          c_threshold = v * period;
+          trace_inner_restart(core);
+        } else {
+          trace_inner_restart(core);
+        }
+        break;
+
+      default:
 	// Either Minisat or Picosat-like restart
 
 	// inner restart: increase c_threshold
@@ -389,7 +575,7 @@ static void solve(smt_core_t *core, const param_t *params) {
 
 	if (c_threshold >= d_threshold) {
 	  d_threshold = c_threshold; // Minisat-style
-	  if (params->fast_restart) {
+	  if (restart == RESTART_PICOSAT) {
 	    // Picosat style
 	    // outer restart: reset c_threshold and increase d_threshold
 	    c_threshold = params->c_threshold;
@@ -399,10 +585,12 @@ static void solve(smt_core_t *core, const param_t *params) {
 	} else {
 	  trace_inner_restart(core);
 	}
+        break;
       }
     }
   }
 
+  smt_set_stable_mode(core, false);
   trace_done(core);
 }
 
@@ -415,6 +603,16 @@ static void solve(smt_core_t *core, const param_t *params) {
  * - if ctx->status is not IDLE, return the status.
  */
 smt_status_t check_context(context_t *ctx, const param_t *params) {
+  return check_context_with_assumptions(ctx, params, 0, NULL);
+}
+
+
+/*
+ * Same thing with assumptions a[0 ... n-1]
+ * - the assumptions are passed to the core before solve
+ */
+smt_status_t check_context_with_assumptions(context_t *ctx, const param_t *params,
+                                            uint32_t n, const literal_t *a) {
   smt_status_t stat;
   smt_core_t *core;
   egraph_t *egraph;
@@ -423,6 +621,7 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
   uint32_t quota;
 
   if (ctx->mcsat != NULL) {
+    assert(n == 0);
     mcsat_solve(ctx->mcsat, params);
     return mcsat_status(ctx->mcsat);
   }
@@ -451,6 +650,21 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
     } else {
       disable_theory_cache(core);
     }
+    if (params->chrono_backtracking) {
+      enable_chrono_backtracking(core, params->chrono_threshold);
+    } else {
+      disable_chrono_backtracking(core);
+    }
+    if (params->sat_preprocess) {
+      enable_sat_preprocessing(core);
+    } else {
+      disable_sat_preprocessing(core);
+    }
+    if (params->decision_queue == DQUEUE_VMTF) {
+      enable_vmtf(core);
+    } else {
+      disable_vmtf(core);
+    }
 
     /*
      * Set egraph parameters
@@ -498,6 +712,16 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
         simplex_enable_periodic_icheck(simplex);
         simplex_set_integer_check_period(simplex, params->integer_check_period);
       }
+      if (params->use_cuts) {
+        simplex_enable_cuts(simplex);
+        simplex_set_max_cut_rounds(simplex, params->cut_rounds);
+        simplex_set_max_cuts(simplex, params->max_cuts);
+        simplex_set_cut_pool_size(simplex, params->cut_pool_size);
+        simplex_set_cut_min_efficacy(simplex, params->cut_min_efficacy);
+        simplex_set_cut_max_parallelism(simplex, params->cut_max_parallelism);
+      } else {
+        simplex_disable_cuts(simplex);
+      }
     }
 
 
@@ -510,6 +734,18 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
       fun_solver_set_max_extensionality(fsolver, params->max_extensionality);
     }
 
+    /*
+     * Set bitvector solver parameters
+     */
+    if (context_has_bv_solver(ctx)) {
+      if (params->lazy_bitblasting) {
+        bv_solver_enable_lazy_blasting(ctx->bv_solver);
+      } else {
+        bv_solver_disable_lazy_blasting(ctx->bv_solver);
+      }
+    }
+
+    smt_set_assumptions(core, n, a);
     solve(core, params);
     stat = smt_status(core);
   }
@@ -518,6 +754,30 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
 }
 
 
+/*
+ * Get the assumptions that caused unsat
+ */
+void context_build_unsat_core(context_t *ctx, ivector_t *v) {
+  ivector_t *idx;
+  uint32_t i, n;
+
+  assert(context_status(ctx) == STATUS_UNSAT);
+
+  ivector_reset(v);
+  if (ctx->mcsat == NULL) {
+    idx = &ctx->aux_vector;
+    assert(idx->size == 0);
+    smt_failed_assumptions(ctx->core, idx);
+    n = idx->size;
+    for (i=0; i<n; i++) {
+      assert(idx->data[i] < ctx->assumptions.size);
+      ivector_push(v, ctx->assumptions.data[idx->data[i]]);
+    }
+    ivector_reset(idx);
+  }
+}
+
+
 
 /*
  * Precheck: force generation of clauses and other stuff that's
@@ -45,10 +45,14 @@ static void show_stats(FILE *f, dpll_stats_t *stat) {
   fprintf(f, " simplify db             : %"PRIu32"\n", stat->simplify_calls);
   fprintf(f, " reduce db               : %"PRIu32"\n", stat->reduce_calls);
   fprintf(f, " remove irrelevant       : %"PRIu32"\n", stat->remove_calls);
+  fprintf(f, " clause gc               : %"PRIu32"\n", stat->arena_compactions);
   fprintf(f, " decisions               : %"PRIu64"\n", stat->decisions);
   fprintf(f, " random decisions        : %"PRIu64"\n", stat->random_decisions);
   fprintf(f, " propagations            : %"PRIu64"\n", stat->propagations);
   fprintf(f, " conflicts               : %"PRIu64"\n", stat->conflicts);
+  if (stat->chrono_backtracks > 0) {
+    fprintf(f, " chrono backtracks       : %"PRIu32"\n", stat->chrono_backtracks);
+  }
   fprintf(f, " theory propagations     : %"PRIu32"\n", stat->th_props);
   fprintf(f, " propagation-lemmas      : %"PRIu32"\n", stat->th_prop_lemmas);
   fprintf(f, " theory conflicts        : %"PRIu32"\n", stat->th_conflicts);
@@ -60,7 +64,21 @@ static void show_stats(FILE *f, dpll_stats_t *stat) {
   fprintf(f, " subsumed lits.          : %"PRIu64"\n", stat->subsumed_literals);
   fprintf(f, " deleted pb. clauses     : %"PRIu64"\n", stat->prob_clauses_deleted);
   fprintf(f, " deleted learned clauses : %"PRIu64"\n", stat->learned_clauses_deleted);
+  fprintf(f, " core learned clauses    : %"PRIu64"\n", stat->core_clauses);
+  fprintf(f, " glue updates            : %"PRIu32"\n", stat->glue_updates);
   fprintf(f, " deleted binary clauses  : %"PRIu64"\n", stat->bin_clauses_deleted);
+  if (stat->exported_clauses > 0 || stat->imported_clauses > 0) {
+    fprintf(f, " exported clauses        : %"PRIu64"\n", stat->exported_clauses);
+    fprintf(f, " imported clauses        : %"PRIu64"\n", stat->imported_clauses);
+  }
+  if (stat->preprocess_calls > 0) {
+    fprintf(f, " preprocessing calls     : %"PRIu32"\n", stat->preprocess_calls);
+    fprintf(f, " failed literals         : %"PRIu32"\n", stat->failed_literals);
+    fprintf(f, " subsumed clauses        : %"PRIu64"\n", stat->subsumed_clauses);
+    fprintf(f, " strengthened clauses    : %"PRIu64"\n", stat->strengthened_clauses);
+    fprintf(f, " eliminated vars         : %"PRIu32"\n", stat->elim_vars);
+    fprintf(f, " restored vars           : %"PRIu32"\n", stat->restored_vars);
+  }
 }
 
 /*
@@ -111,6 +129,10 @@ static void show_simplex_stats(FILE *f, simplex_stats_t *stat) {
   fprintf(f, " calls to make_feasible  : %"PRIu32"\n", stat->num_make_feasible);
   fprintf(f, " pivots                  : %"PRIu32"\n", stat->num_pivots);
   fprintf(f, " bland-rule activations  : %"PRIu32"\n", stat->num_blands);
+  fprintf(f, " bound flips             : %"PRIu32"\n", stat->num_bound_flips);
+  fprintf(f, " repairs by flips only   : %"PRIu32"\n", stat->num_flip_repairs);
+  fprintf(f, " fp warm-start pivots    : %"PRIu32"\n", stat->num_fp_pivots);
+  fprintf(f, " warm-start exact pivots : %"PRIu32"\n", stat->num_warm_pivots);
   fprintf(f, " simple lemmas           : %"PRIu32"\n", stat->num_binary_lemmas);
   //  fprintf(f, " propagation lemmas      : %"PRIu32"\n", stat->num_prop_lemmas);  (it's always zero)
   fprintf(f, " prop. to core           : %"PRIu32"\n", stat->num_props);
@@ -138,6 +160,14 @@ static void show_simplex_stats(FILE *f, simplex_stats_t *stat) {
     fprintf(f, " dioph conflicts         : %"PRIu32"\n", stat->num_dioph_conflicts);
     fprintf(f, " bound conflicts         : %"PRIu32"\n", stat->num_dioph_bound_conflicts);
     fprintf(f, " recheck conflicts       : %"PRIu32"\n", stat->num_dioph_recheck_conflicts);
+    if (stat->num_cut_rounds > 0) {
+      fprintf(f, "cutting planes\n");
+      fprintf(f, " cut rounds              : %"PRIu32"\n", stat->num_cut_rounds);
+      fprintf(f, " gomory cuts             : %"PRIu32"\n", stat->num_gomory_cuts);
+      fprintf(f, " mir cuts                : %"PRIu32"\n", stat->num_mir_cuts);
+      fprintf(f, " cuts added              : %"PRIu32"\n", stat->num_cuts);
+      fprintf(f, " cuts from the pool      : %"PRIu32"\n", stat->num_pool_cuts);
+    }
   }
 }
 
@@ -157,6 +187,14 @@ static void show_bvsolver_stats(FILE *f, bv_solver_t *solver) {
   fprintf(f, " equiv conflicts         : %"PRIu32"\n", solver->stats.equiv_conflicts);
   fprintf(f, " semi-equiv lemmas       : %"PRIu32"\n", solver->stats.half_equiv_lemmas);
   fprintf(f, " interface lemmas        : %"PRIu32"\n", solver->stats.interface_lemmas);
+  if (bv_solver_lazy_ops(solver) > 0) {
+    fprintf(f, " lazy operators          : %"PRIu32"\n", bv_solver_lazy_ops(solver));
+    fprintf(f, " lazy refinements        : %"PRIu32"\n", bv_solver_lazy_refinements(solver));
+  }
+  if (bv_solver_bound_props(solver) > 0 || bv_solver_bound_conflicts(solver) > 0) {
+    fprintf(f, " bound propagations      : %"PRIu32"\n", bv_solver_bound_props(solver));
+    fprintf(f, " bound conflicts         : %"PRIu32"\n", bv_solver_bound_conflicts(solver));
+  }
 }
 
 
@@ -181,6 +219,8 @@ void yices_print_presearch_stats(FILE *f, context_t *ctx) {
     fprintf(f, "arithmetic solver       : IDL Floyd-Warshall\n");
   } else if (context_has_rdl_solver(ctx)) {
     fprintf(f, "arithmetic solver       : RDL Floyd-Warshall\n");
+  } else if (context_has_sidl_solver(ctx)) {
+    fprintf(f, "arithmetic solver       : Sparse IDL\n");
   }
   fprintf(f, "\n");
   fflush(f);
@@ -110,6 +110,10 @@ typedef enum {
  * - EAGER_LEMMAS
  * - ENABLE_ICHECK
  * - EQPROP
+ * - SEDGE: steepest-edge pricing
+ * - DEVEX: devex pricing (exclusive with SEDGE)
+ * - BFLIP: bound flipping
+ * - FPWS: floating-point warm start
  *
  * Options for testing and debugging
  * - LAX_OPTION: try to keep going when the assertions contain unsupported
@@ -138,9 +142,13 @@ typedef enum {
   FACTOR_OR_OPTION_MASK)
 
 // SIMPLEX OPTIONS
+#define SPLX_FPWS_OPTION_MASK     0x800000
 #define SPLX_EGRLMAS_OPTION_MASK  0x1000000
 #define SPLX_ICHECK_OPTION_MASK   0x2000000
 #define SPLX_EQPROP_OPTION_MASK   0x4000000
+#define SPLX_SEDGE_OPTION_MASK    0x8000000
+#define SPLX_DEVEX_OPTION_MASK    0x10000000
+#define SPLX_BFLIP_OPTION_MASK    0x20000000
 
 // FOR TESTING
 #define LAX_OPTION_MASK         0x40000000
@@ -163,6 +171,7 @@ typedef enum {
   CTX_ARCH_SPLX,         // simplex
   CTX_ARCH_IFW,          // integer floyd-warshall
   CTX_ARCH_RFW,          // real floyd-warshall
+  CTX_ARCH_SIDL,         // sparse integer difference logic
   CTX_ARCH_BV,           // bitvector solver
   CTX_ARCH_EGFUN,        // egraph+array/function theory
   CTX_ARCH_EGSPLX,       // egraph+simplex
@@ -172,7 +181,7 @@ typedef enum {
   CTX_ARCH_EGSPLXBV,     // egraph+simplex+bitvector
   CTX_ARCH_EGFUNSPLXBV,  // all solvers (should be the default)
 
-  CTX_ARCH_AUTO_IDL,     // either simplex or integer floyd-warshall
+  CTX_ARCH_AUTO_IDL,     // simplex, integer floyd-warshall, or sparse idl
   CTX_ARCH_AUTO_RDL,     // either simplex or real floyd-warshall
 
   CTX_ARCH_MCSAT         // mcsat solver
@@ -662,6 +671,9 @@ struct context_s {
   int_queue_t queue;
   int_stack_t istack;
 
+  // assumptions for the last call to check_context_with_assumptions
+  ivector_t assumptions;
+
   // data about shared subterms
   sharing_map_t sharing;
 
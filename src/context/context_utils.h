@@ -522,6 +522,22 @@ static inline bool splx_eqprop_enabled(context_t *ctx) {
   return (ctx->options & SPLX_EQPROP_OPTION_MASK) != 0;
 }
 
+static inline bool splx_steepest_edge_enabled(context_t *ctx) {
+  return (ctx->options & SPLX_SEDGE_OPTION_MASK) != 0;
+}
+
+static inline bool splx_devex_enabled(context_t *ctx) {
+  return (ctx->options & SPLX_DEVEX_OPTION_MASK) != 0;
+}
+
+static inline bool splx_bound_flipping_enabled(context_t *ctx) {
+  return (ctx->options & SPLX_BFLIP_OPTION_MASK) != 0;
+}
+
+static inline bool splx_fp_warm_start_enabled(context_t *ctx) {
+  return (ctx->options & SPLX_FPWS_OPTION_MASK) != 0;
+}
+
 
 /*
  * Provisional: set/clear/test dump mode
@@ -31,6 +31,7 @@
 #include "solvers/cdcl/smt_core_printer.h"
 #include "solvers/egraph/egraph_printer.h"
 #include "solvers/floyd_warshall/idl_fw_printer.h"
+#include "solvers/floyd_warshall/idl_sparse_printer.h"
 #include "solvers/floyd_warshall/rdl_fw_printer.h"
 #include "solvers/simplex/simplex_printer.h"
 
@@ -71,6 +72,15 @@ static void dump_rdl_solver(FILE *f, rdl_solver_t *rdl) {
   print_rdl_axioms(f, rdl);
 }
 
+static void dump_sidl_solver(FILE *f, sidl_solver_t *sidl) {
+  fprintf(f, "\n--- Sparse IDL Variables ---\n");
+  print_sidl_var_table(f, sidl);
+  fprintf(f, "\n--- Sparse IDL Atoms ---\n");
+  print_sidl_atoms(f, sidl);
+  fprintf(f, "\n--- Sparse IDL Constraints ---\n");
+  print_sidl_axioms(f, sidl);
+}
+
 static void dump_simplex_solver(FILE *f, simplex_solver_t *simplex) {
   fprintf(f, "\n--- Simplex ---\n");
 #ifndef NDEBUG
@@ -142,6 +152,8 @@ void dump_context(FILE *f, context_t *context) {
       dump_idl_solver(f, context->arith_solver);
     } else if (context_has_rdl_solver(context)) {
       dump_rdl_solver(f, context->arith_solver);
+    } else if (context_has_sidl_solver(context)) {
+      dump_sidl_solver(f, context->arith_solver);
     } else {
       assert(context_has_simplex_solver(context));
       dump_simplex_solver(f, context->arith_solver);
@@ -0,0 +1,314 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PORTFOLIO SOLVER
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "context/context.h"
+#include "context/portfolio.h"
+#include "utils/memalloc.h"
+#include "utils/yices_locks.h"
+
+
+/*
+ * Combine the worker results: used once all the workers are done
+ * - stat[i] = status returned by worker i
+ * - the first worker that returned UNKNOWN is used if there's no winner
+ */
+static smt_status_t portfolio_result(smt_status_t *stat, uint32_t n, int32_t *winner) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (stat[i] == STATUS_UNKNOWN) {
+      *winner = i;
+      return STATUS_UNKNOWN;
+    }
+  }
+
+  *winner = -1;
+  return STATUS_INTERRUPTED;
+}
+
+
+#ifdef THREAD_SAFE
+
+#include <pthread.h>
+#include <time.h>
+
+/*
+ * Shared state:
+ * - lock: protects all the other fields
+ * - ctx[i] = context for worker i
+ * - started[i] = true once worker i has decided to start its search
+ * - done[i] = true once worker i has returned from check_context
+ * - stat[i] = the status returned by worker i
+ * - winner = index of the first worker to return SAT or UNSAT (or -1)
+ * - ndone = number of workers that are done
+ */
+typedef struct portfolio_s {
+  yices_lock_t lock;
+  context_t **ctx;
+  bool *started;
+  bool *done;
+  smt_status_t *stat;
+  int32_t winner;
+  uint32_t ndone;
+} portfolio_t;
+
+/*
+ * Worker descriptor: passed to the thread
+ */
+typedef struct portfolio_worker_s {
+  portfolio_t *portfolio;
+  const param_t *params;
+  uint32_t id;
+} portfolio_worker_t;
+
+
+/*
+ * Check whether contexts c1 and c2 have been internalized in the same
+ * way: all terms must be mapped to the same objects in both contexts.
+ */
+static bool same_internalization(context_t *c1, context_t *c2) {
+  intern_tbl_t *t1, *t2;
+  uint32_t i, n;
+
+  t1 = &c1->intern;
+  t2 = &c2->intern;
+  n = intern_tbl_num_terms(t1);
+  if (intern_tbl_num_terms(t2) > n) {
+    n = intern_tbl_num_terms(t2);
+  }
+  for (i=0; i<n; i++) {
+    if (ai32_read(&t1->map, i) != ai32_read(&t2->map, i)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Check whether the workers can share clauses: the boolean variables
+ * must have the same meaning in all the cores. We check that all the
+ * contexts have the same internalization and the same number of variables.
+ * - if so, store the number of variables in *nvars and return true
+ */
+static bool portfolio_can_share(context_t **ctx, uint32_t n, uint32_t *nvars) {
+  uint32_t i, nv;
+
+  nv = num_vars(ctx[0]->core);
+  for (i=1; i<n; i++) {
+    if (num_vars(ctx[i]->core) != nv || !same_internalization(ctx[0], ctx[i])) {
+      return false;
+    }
+  }
+  *nvars = nv;
+
+  return true;
+}
+
+
+/*
+ * Interrupt all workers that are still running: must be called with p->lock held.
+ */
+static void portfolio_stop_others(portfolio_t *p, uint32_t n) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (p->started[i] && !p->done[i]) {
+      context_stop_search(p->ctx[i]);
+    }
+  }
+}
+
+
+/*
+ * Thread body
+ */
+static void *portfolio_worker(void *arg) {
+  portfolio_worker_t *w;
+  portfolio_t *p;
+  smt_status_t stat;
+  uint32_t i;
+  bool skip;
+
+  w = arg;
+  p = w->portfolio;
+  i = w->id;
+
+  // don't start if the problem is already solved
+  get_yices_lock(&p->lock);
+  skip = p->winner >= 0;
+  p->started[i] = !skip;
+  release_yices_lock(&p->lock);
+
+  stat = STATUS_INTERRUPTED;
+  if (!skip) {
+    stat = check_context(p->ctx[i], w->params);
+  }
+
+  get_yices_lock(&p->lock);
+  p->stat[i] = stat;
+  p->done[i] = true;
+  p->ndone ++;
+  if (p->winner < 0 && (stat == STATUS_SAT || stat == STATUS_UNSAT)) {
+    p->winner = i;
+  }
+  release_yices_lock(&p->lock);
+
+  return NULL;
+}
+
+
+/*
+ * Wait for all workers to finish.
+ *
+ * context_stop_search has no effect on a context whose search has
+ * not started yet (status IDLE). So a single call may be missed by a
+ * worker that's about to start. To deal with this race, we poll
+ * every millisecond and interrupt the remaining workers until they
+ * are all done.
+ */
+static void portfolio_wait(portfolio_t *p, uint32_t n) {
+  struct timespec delay;
+  bool all_done;
+
+  delay.tv_sec = 0;
+  delay.tv_nsec = 1000000;
+
+  for (;;) {
+    get_yices_lock(&p->lock);
+    all_done = (p->ndone == n);
+    if (!all_done && p->winner >= 0) {
+      portfolio_stop_others(p, n);
+    }
+    release_yices_lock(&p->lock);
+
+    if (all_done) break;
+    nanosleep(&delay, NULL);
+  }
+}
+
+
+smt_status_t check_context_portfolio(context_t **ctx, const param_t *params, uint32_t n, int32_t *winner) {
+  portfolio_t p;
+  portfolio_worker_t *w;
+  pthread_t *tid;
+  clause_ring_t ring;
+  smt_status_t result;
+  uint32_t i, nvars;
+  bool share;
+
+  assert(n > 0);
+
+  create_yices_lock(&p.lock);
+  p.ctx = ctx;
+  p.started = (bool *) safe_malloc(n * sizeof(bool));
+  p.done = (bool *) safe_malloc(n * sizeof(bool));
+  p.stat = (smt_status_t *) safe_malloc(n * sizeof(smt_status_t));
+  p.winner = -1;
+  p.ndone = 0;
+
+  w = (portfolio_worker_t *) safe_malloc(n * sizeof(portfolio_worker_t));
+  tid = (pthread_t *) safe_malloc(n * sizeof(pthread_t));
+
+  for (i=0; i<n; i++) {
+    assert(context_status(ctx[i]) == STATUS_IDLE);
+    p.started[i] = false;
+    p.done[i] = false;
+    p.stat[i] = STATUS_IDLE;
+    w[i].portfolio = &p;
+    w[i].params = params + i;
+    w[i].id = i;
+  }
+
+  share = params->share_clauses && n > 1 && portfolio_can_share(ctx, n, &nvars);
+  if (share) {
+    init_clause_ring(&ring, 0, nvars, params->share_max_length, params->share_max_glue);
+    for (i=0; i<n; i++) {
+      smt_attach_clause_ring(ctx[i]->core, &ring, i);
+    }
+  }
+
+  for (i=0; i<n; i++) {
+    if (pthread_create(tid + i, NULL, portfolio_worker, w + i) != 0) {
+      // can't create more threads: run this worker here
+      portfolio_worker(w + i);
+      tid[i] = pthread_self();
+    }
+  }
+
+  portfolio_wait(&p, n);
+
+  for (i=0; i<n; i++) {
+    if (! pthread_equal(tid[i], pthread_self())) {
+      pthread_join(tid[i], NULL);
+    }
+  }
+
+  if (share) {
+    for (i=0; i<n; i++) {
+      smt_detach_clause_ring(ctx[i]->core);
+    }
+    delete_clause_ring(&ring);
+  }
+
+  if (p.winner >= 0) {
+    *winner = p.winner;
+    result = p.stat[p.winner];
+  } else {
+    result = portfolio_result(p.stat, n, winner);
+  }
+
+  safe_free(tid);
+  safe_free(w);
+  safe_free(p.stat);
+  safe_free(p.done);
+  safe_free(p.started);
+  destroy_yices_lock(&p.lock);
+
+  return result;
+}
+
+#else
+
+/*
+ * Sequential version: only ctx[0] is searched
+ */
+smt_status_t check_context_portfolio(context_t **ctx, const param_t *params, uint32_t n, int32_t *winner) {
+  smt_status_t stat;
+
+  assert(n > 0 && context_status(ctx[0]) == STATUS_IDLE);
+
+  stat = check_context(ctx[0], params);
+  if (stat == STATUS_SAT || stat == STATUS_UNSAT) {
+    *winner = 0;
+  } else {
+    stat = portfolio_result(&stat, 1, winner);
+  }
+
+  return stat;
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PORTFOLIO SOLVER
+ *
+ * A portfolio runs check_context on several contexts in parallel. All
+ * contexts are expected to contain the same assertions. Each context
+ * is searched in its own thread with different search parameters
+ * (cf. init_portfolio_params in search_parameters.h).
+ *
+ * The first worker to return SAT or UNSAT wins. The other searches are
+ * then interrupted via context_stop_search.
+ *
+ * Contexts are internalized independently (and sequentially) before the
+ * portfolio is started. During the search, the workers only read the
+ * global term and type tables. The only global data structures that are
+ * updated during search are the rational-number bank and the type-table
+ * caches, which are protected by locks in the thread-safe build.
+ *
+ * If params[0].share_clauses is true, the workers also exchange short
+ * learned clauses via a clause ring (cf. clause_ring.h). This requires
+ * the boolean variables to have the same meaning in all the cores, which
+ * is the case if the contexts were built by asserting the same formulas
+ * in the same order. Sharing is disabled if the contexts don't have the
+ * same internalization table and number of variables.
+ *
+ * Parallel search requires a thread-safe build (option
+ * --enable-thread-safety). Otherwise, check_context_portfolio
+ * just runs the search on the first context.
+ */
+
+#ifndef __PORTFOLIO_H
+#define __PORTFOLIO_H
+
+#include <stdint.h>
+
+#include "context/context_types.h"
+
+
+/*
+ * Run a portfolio search
+ * - ctx[0 ... n-1] = n distinct contexts, all with status IDLE
+ * - params[0 ... n-1] = search parameters: context ctx[i] is searched
+ *   using params[i]
+ * - n must be positive
+ *
+ * The result is:
+ * - the status of the winner (SAT or UNSAT) if one worker decides the problem.
+ *   Then *winner is set to the winner's index.
+ * - otherwise, STATUS_UNKNOWN if one worker returned UNKNOWN. Then *winner is
+ *   the index of the first such worker.
+ * - otherwise STATUS_INTERRUPTED and *winner is set to -1. This happens if all
+ *   the searches were interrupted from outside (e.g., by a timeout handler
+ *   calling context_stop_search on all the contexts).
+ *
+ * The searches that don't win are interrupted: their status is either
+ * INTERRUPTED, or whatever they returned if they completed before being
+ * interrupted.
+ */
+extern smt_status_t check_context_portfolio(context_t **ctx, const param_t *params, uint32_t n, int32_t *winner);
+
+
+#endif /* __PORTFOLIO_H */
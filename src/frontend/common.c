@@ -146,14 +146,21 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "aux-eq-quota",
   "aux-eq-ratio",
   "bland-threshold",
+  "bound-flipping",
   "branching",
   "bvarith-elim",
   "c-factor",
   "c-threshold",
   "cache-tclauses",
   "clause-decay",
+  "cut-max-parallelism",
+  "cut-min-efficacy",
+  "cut-pool-size",
+  "cut-rounds",
+  "cuts",
   "d-factor",
   "d-threshold",
+  "devex",
   "dyn-ack",
   "dyn-ack-threshold",
   "dyn-bool-ack",
@@ -166,12 +173,15 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "ef-max-samples",
   "fast-restarts",
   "flatten",
+  "fp-warm-start",
   "icheck",
   "icheck-period",
   "keep-ite",
+  "lazy-bitblasting",
   "learn-eq",
   "max-ack",
   "max-bool-ack",
+  "max-cuts",
   "max-extensionality",
   "max-interface-eqs",
   "max-update-conflicts",
@@ -186,6 +196,7 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "randomness",
   "simplex-adjust",
   "simplex-prop",
+  "steepest-edge",
   "tclause-size",
   "var-decay",
   "var-elim",
@@ -197,14 +208,21 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_AUX_EQ_QUOTA,
   PARAM_AUX_EQ_RATIO,
   PARAM_BLAND_THRESHOLD,
+  PARAM_BOUND_FLIPPING,
   PARAM_BRANCHING,
   PARAM_BVARITH_ELIM,
   PARAM_C_FACTOR,
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
   PARAM_CLAUSE_DECAY,
+  PARAM_CUT_MAX_PARALLELISM,
+  PARAM_CUT_MIN_EFFICACY,
+  PARAM_CUT_POOL_SIZE,
+  PARAM_CUT_ROUNDS,
+  PARAM_CUTS,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
+  PARAM_DEVEX,
   PARAM_DYN_ACK,
   PARAM_DYN_ACK_THRESHOLD,
   PARAM_DYN_BOOL_ACK,
@@ -217,12 +235,15 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_EF_MAX_SAMPLES,
   PARAM_FAST_RESTARTS,
   PARAM_FLATTEN,
+  PARAM_FP_WARM_START,
   PARAM_ICHECK,
   PARAM_ICHECK_PERIOD,
   PARAM_KEEP_ITE,
+  PARAM_LAZY_BITBLASTING,
   PARAM_LEARN_EQ,
   PARAM_MAX_ACK,
   PARAM_MAX_BOOL_ACK,
+  PARAM_MAX_CUTS,
   PARAM_MAX_EXTENSIONALITY,
   PARAM_MAX_INTERFACE_EQS,
   PARAM_MAX_UPDATE_CONFLICTS,
@@ -237,6 +258,7 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_RANDOMNESS,
   PARAM_SIMPLEX_ADJUST,
   PARAM_SIMPLEX_PROP,
+  PARAM_STEEPEST_EDGE,
   PARAM_TCLAUSE_SIZE,
   PARAM_VAR_DECAY,
   PARAM_VAR_ELIM,
@@ -523,6 +545,10 @@ void default_ctx_params(ctx_param_t *ctx_parameters, param_t *parameters, smt_lo
   ctx_parameters->keep_ite = false;
   ctx_parameters->splx_eager_lemmas = true;
   ctx_parameters->splx_periodic_icheck = false;
+  ctx_parameters->splx_steepest_edge = false;
+  ctx_parameters->splx_devex = false;
+  ctx_parameters->splx_bound_flipping = false;
+  ctx_parameters->splx_fp_warm_start = false;
 
   // if the logic is UNKNOWN, integer arithmetic may happen
   iflag = (logic == SMT_UNKNOWN) || iflag_for_logic(logic);
@@ -552,6 +578,10 @@ void save_ctx_params(ctx_param_t *ctx_parameters, context_t *context) {
   ctx_parameters->keep_ite = context_keep_ite_enabled(context);
   ctx_parameters->splx_eager_lemmas = splx_eager_lemmas_enabled(context);
   ctx_parameters->splx_periodic_icheck = splx_periodic_icheck_enabled(context);
+  ctx_parameters->splx_steepest_edge = splx_steepest_edge_enabled(context);
+  ctx_parameters->splx_devex = splx_devex_enabled(context);
+  ctx_parameters->splx_bound_flipping = splx_bound_flipping_enabled(context);
+  ctx_parameters->splx_fp_warm_start = splx_fp_warm_start_enabled(context);
 }
 
 
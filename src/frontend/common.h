@@ -112,9 +112,21 @@ typedef enum yices_param {
   PARAM_BLAND_THRESHOLD,
   PARAM_ICHECK,
   PARAM_ICHECK_PERIOD,
+  PARAM_STEEPEST_EDGE,
+  PARAM_DEVEX,
+  PARAM_BOUND_FLIPPING,
+  PARAM_FP_WARM_START,
+  PARAM_CUTS,
+  PARAM_CUT_ROUNDS,
+  PARAM_MAX_CUTS,
+  PARAM_CUT_POOL_SIZE,
+  PARAM_CUT_MIN_EFFICACY,
+  PARAM_CUT_MAX_PARALLELISM,
   // array solver parameters
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // bitvector solver parameters
+  PARAM_LAZY_BITBLASTING,
   // EF solver
   PARAM_EF_FLATTEN_IFF,
   PARAM_EF_FLATTEN_ITE,
@@ -213,6 +225,10 @@ typedef struct ctx_param_s {
   bool keep_ite;
   bool splx_eager_lemmas;
   bool splx_periodic_icheck;
+  bool splx_steepest_edge;
+  bool splx_devex;
+  bool splx_bound_flipping;
+  bool splx_fp_warm_start;
 } ctx_param_t;
 
 
@@ -60,6 +60,7 @@
 // for statistics
 #include "solvers/bv/bvsolver.h"
 #include "solvers/floyd_warshall/idl_floyd_warshall.h"
+#include "solvers/floyd_warshall/idl_sparse.h"
 #include "solvers/floyd_warshall/rdl_floyd_warshall.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
@@ -87,6 +88,7 @@ static ctx_param_t ctx_parameters;
 #include "io/term_printer.h"
 #include "io/type_printer.h"
 #include "solvers/floyd_warshall/idl_fw_printer.h"
+#include "solvers/floyd_warshall/idl_sparse_printer.h"
 #include "solvers/floyd_warshall/rdl_fw_printer.h"
 #include "solvers/simplex/simplex_printer.h"
 #include "solvers/bv/bvsolver_printer.h"
@@ -130,6 +132,16 @@ static void dump_rdl_solver(FILE *f, rdl_solver_t *rdl) {
   fprintf(f, "\n");
 }
 
+static void dump_sidl_solver(FILE *f, sidl_solver_t *sidl) {
+  fprintf(f, "\n--- Sparse IDL Variables ---\n");
+  print_sidl_var_table(f, sidl);
+  fprintf(f, "\n--- Sparse IDL Atoms ---\n");
+  print_sidl_atoms(f, sidl);
+  fprintf(f, "\n--- Sparse IDL Constraints ---\n");
+  print_sidl_axioms(f, sidl);
+  fprintf(f, "\n");
+}
+
 static void dump_simplex_solver(FILE *f, simplex_solver_t *simplex) {
   fprintf(f, "\n--- Simplex Variables ---\n");
   print_simplex_vars(f, simplex);
@@ -185,6 +197,8 @@ static void dump_context(FILE *f, context_t *ctx) {
       dump_idl_solver(f, ctx->arith_solver);
     } else if (context_has_rdl_solver(ctx)) {
       dump_rdl_solver(f, ctx->arith_solver);
+    } else if (context_has_sidl_solver(ctx)) {
+      dump_sidl_solver(f, ctx->arith_solver);
     } else {
       assert(context_has_simplex_solver(ctx));
       dump_simplex_solver(f, ctx->arith_solver);
@@ -1620,6 +1634,14 @@ static void show_simplex_stats(simplex_solver_t *solver) {
   print_out(" :simplex-rows %"PRIu32"\n", simplex_num_rows(solver));
   print_out(" :simplex-atoms %"PRIu32"\n", simplex_num_atoms(solver));
   print_out(" :simplex-pivots %"PRIu32"\n", simplex_num_pivots(solver));
+  if (simplex_num_bound_flips(solver) > 0) {
+    print_out(" :simplex-bound-flips %"PRIu32"\n", simplex_num_bound_flips(solver));
+    print_out(" :simplex-flip-repairs %"PRIu32"\n", simplex_num_flip_repairs(solver));
+  }
+  if (simplex_num_fp_pivots(solver) > 0) {
+    print_out(" :simplex-fp-pivots %"PRIu32"\n", simplex_num_fp_pivots(solver));
+    print_out(" :simplex-warm-pivots %"PRIu32"\n", simplex_num_warm_pivots(solver));
+  }
   print_out(" :simplex-conflicts %"PRIu32"\n", simplex_num_conflicts(solver));
   print_out(" :simplex-interface-lemmas %"PRIu32"\n", simplex_num_interface_lemmas(solver));
   if (simplex_num_make_integer_feasible(solver) > 0 ||
@@ -1639,6 +1661,13 @@ static void show_simplex_stats(simplex_solver_t *solver) {
     print_out(" :simplex-dioph-conflicts %"PRIu32"\n", simplex_num_dioph_conflicts(solver));
     print_out(" :simplex-dioph-bound-conflicts %"PRIu32"\n", simplex_num_dioph_bound_conflicts(solver));
     print_out(" :simplex-dioph-recheck-conflicts %"PRIu32"\n", simplex_num_dioph_recheck_conflicts(solver));
+    if (simplex_num_cut_rounds(solver) > 0) {
+      print_out(" :simplex-cut-rounds %"PRIu32"\n", simplex_num_cut_rounds(solver));
+      print_out(" :simplex-gomory-cuts %"PRIu32"\n", simplex_num_gomory_cuts(solver));
+      print_out(" :simplex-mir-cuts %"PRIu32"\n", simplex_num_mir_cuts(solver));
+      print_out(" :simplex-cuts %"PRIu32"\n", simplex_num_cuts(solver));
+      print_out(" :simplex-pool-cuts %"PRIu32"\n", simplex_num_pool_cuts(solver));
+    }
   }
 }
 
@@ -1647,6 +1676,14 @@ static void show_bvsolver_stats(bv_solver_t *solver) {
   print_out(" :bvsolver-atoms %"PRIu32"\n", bv_solver_num_atoms(solver));
   print_out(" :bvsolver-equiv-lemmas %"PRIu32"\n", bv_solver_equiv_lemmas(solver));
   print_out(" :bvsolver-interface-lemmas %"PRIu32"\n", bv_solver_interface_lemmas(solver));
+  if (bv_solver_lazy_ops(solver) > 0) {
+    print_out(" :bvsolver-lazy-ops %"PRIu32"\n", bv_solver_lazy_ops(solver));
+    print_out(" :bvsolver-lazy-refinements %"PRIu32"\n", bv_solver_lazy_refinements(solver));
+  }
+  if (bv_solver_bound_props(solver) > 0 || bv_solver_bound_conflicts(solver) > 0) {
+    print_out(" :bvsolver-bound-props %"PRIu32"\n", bv_solver_bound_props(solver));
+    print_out(" :bvsolver-bound-conflicts %"PRIu32"\n", bv_solver_bound_conflicts(solver));
+  }
 }
 
 static void show_idl_fw_stats(idl_solver_t *solver) {
@@ -1654,6 +1691,16 @@ static void show_idl_fw_stats(idl_solver_t *solver) {
   print_out(" :idl-solver-atoms %"PRIu32"\n", idl_num_atoms(solver));
 }
 
+static void show_sidl_stats(sidl_solver_t *solver) {
+  print_out(" :idl-solver-vars %"PRIu32"\n", sidl_num_vars(solver));
+  print_out(" :idl-solver-atoms %"PRIu32"\n", sidl_num_atoms(solver));
+  print_out(" :idl-solver-vertices %"PRIu32"\n", sidl_num_vertices(solver));
+  print_out(" :idl-solver-conflicts %"PRIu32"\n", solver->stats.num_conflicts);
+  print_out(" :idl-solver-repairs %"PRIu32"\n", solver->stats.num_repairs);
+  print_out(" :idl-solver-propagations %"PRIu32"\n", solver->stats.num_propagations);
+  print_out(" :idl-solver-bounded-searches %"PRIu32"\n", solver->stats.num_bounded);
+}
+
 static void show_rdl_fw_stats(rdl_solver_t *solver) {
   print_out(" :rdl-solver-vars %"PRIu32"\n", rdl_num_vars(solver));
   print_out(" :rdl-solver-atoms %"PRIu32"\n", rdl_num_atoms(solver));
@@ -1679,6 +1726,8 @@ static void show_ctx_stats(context_t *ctx) {
       show_simplex_stats(ctx->arith_solver);
     } else if (context_has_idl_solver(ctx)) {
       show_idl_fw_stats(ctx->arith_solver);
+    } else if (context_has_sidl_solver(ctx)) {
+      show_sidl_stats(ctx->arith_solver);
     } else {
       assert(context_has_rdl_solver(ctx));
       show_rdl_fw_stats(ctx->arith_solver);
@@ -2366,7 +2415,22 @@ static void init_smt2_context(smt2_globals_t *g) {
    * TODO: override the default context options based on
    * ctx_parameters.  I don't want to do it now (2015/07/22). If we
    * make a mistake, we could get a major performance loss.
+   *
+   * The simplex pivoting options are disabled by default so we can
+   * safely copy them.
    */
+  if (ctx_parameters.splx_steepest_edge) {
+    enable_splx_steepest_edge(g->ctx);
+  }
+  if (ctx_parameters.splx_devex) {
+    enable_splx_devex(g->ctx);
+  }
+  if (ctx_parameters.splx_bound_flipping) {
+    enable_splx_bound_flipping(g->ctx);
+  }
+  if (ctx_parameters.splx_fp_warm_start) {
+    enable_splx_fp_warm_start(g->ctx);
+  }
 }
 
 
@@ -3834,6 +3898,22 @@ static bool yices_get_option(yices_param_t p, ef_param_t *ef_params) {
     print_boolean_value(ctx_parameters.splx_periodic_icheck);
     break;
 
+  case PARAM_STEEPEST_EDGE:
+    print_boolean_value(ctx_parameters.splx_steepest_edge);
+    break;
+
+  case PARAM_DEVEX:
+    print_boolean_value(ctx_parameters.splx_devex);
+    break;
+
+  case PARAM_BOUND_FLIPPING:
+    print_boolean_value(ctx_parameters.splx_bound_flipping);
+    break;
+
+  case PARAM_FP_WARM_START:
+    print_boolean_value(ctx_parameters.splx_fp_warm_start);
+    break;
+
   case PARAM_SIMPLEX_PROP:
     print_boolean_value(parameters.use_simplex_prop);
     break;
@@ -3854,6 +3934,30 @@ static bool yices_get_option(yices_param_t p, ef_param_t *ef_params) {
     print_uint32_value(parameters.integer_check_period);
     break;
 
+  case PARAM_CUTS:
+    print_boolean_value(parameters.use_cuts);
+    break;
+
+  case PARAM_CUT_ROUNDS:
+    print_uint32_value(parameters.cut_rounds);
+    break;
+
+  case PARAM_MAX_CUTS:
+    print_uint32_value(parameters.max_cuts);
+    break;
+
+  case PARAM_CUT_POOL_SIZE:
+    print_uint32_value(parameters.cut_pool_size);
+    break;
+
+  case PARAM_CUT_MIN_EFFICACY:
+    print_float_value(parameters.cut_min_efficacy);
+    break;
+
+  case PARAM_CUT_MAX_PARALLELISM:
+    print_float_value(parameters.cut_max_parallelism);
+    break;
+
   case PARAM_MAX_UPDATE_CONFLICTS:
     print_uint32_value(parameters.max_update_conflicts);
     break;
@@ -3862,6 +3966,10 @@ static bool yices_get_option(yices_param_t p, ef_param_t *ef_params) {
     print_uint32_value(parameters.max_extensionality);
     break;
 
+  case PARAM_LAZY_BITBLASTING:
+    print_boolean_value(parameters.lazy_bitblasting);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     print_boolean_value(ef_params->flatten_iff);
     break;
@@ -4395,12 +4503,106 @@ static void yices_set_option(const char *param, const param_val_t *val, ef_param
     }
     break;
 
+  case PARAM_STEEPEST_EDGE:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      ctx_parameters.splx_steepest_edge = tt;
+      if (tt) ctx_parameters.splx_devex = false;
+      context = __smt2_globals.ctx;
+      if (context != NULL) {
+	if (tt) {
+	  enable_splx_steepest_edge(context);
+	} else {
+	  disable_splx_steepest_edge(context);
+	}
+      }
+    }
+    break;
+
+  case PARAM_DEVEX:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      ctx_parameters.splx_devex = tt;
+      if (tt) ctx_parameters.splx_steepest_edge = false;
+      context = __smt2_globals.ctx;
+      if (context != NULL) {
+	if (tt) {
+	  enable_splx_devex(context);
+	} else {
+	  disable_splx_devex(context);
+	}
+      }
+    }
+    break;
+
+  case PARAM_BOUND_FLIPPING:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      ctx_parameters.splx_bound_flipping = tt;
+      context = __smt2_globals.ctx;
+      if (context != NULL) {
+	if (tt) {
+	  enable_splx_bound_flipping(context);
+	} else {
+	  disable_splx_bound_flipping(context);
+	}
+      }
+    }
+    break;
+
+  case PARAM_FP_WARM_START:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      ctx_parameters.splx_fp_warm_start = tt;
+      context = __smt2_globals.ctx;
+      if (context != NULL) {
+	if (tt) {
+	  enable_splx_fp_warm_start(context);
+	} else {
+	  disable_splx_fp_warm_start(context);
+	}
+      }
+    }
+    break;
+
   case PARAM_ICHECK_PERIOD:
     if (param_val_to_pos32(param, val, &n, &reason)) {
       parameters.integer_check_period = n;
     }
     break;
 
+  case PARAM_CUTS:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.use_cuts = tt;
+    }
+    break;
+
+  case PARAM_CUT_ROUNDS:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.cut_rounds = n;
+    }
+    break;
+
+  case PARAM_MAX_CUTS:
+    if (param_val_to_pos32(param, val, &n, &reason)) {
+      parameters.max_cuts = n;
+    }
+    break;
+
+  case PARAM_CUT_POOL_SIZE:
+    if (param_val_to_pos32(param, val, &n, &reason)) {
+      parameters.cut_pool_size = n;
+    }
+    break;
+
+  case PARAM_CUT_MIN_EFFICACY:
+    if (param_val_to_posfloat(param, val, &x, &reason)) {
+      parameters.cut_min_efficacy = x;
+    }
+    break;
+
+  case PARAM_CUT_MAX_PARALLELISM:
+    if (param_val_to_ratio(param, val, &x, &reason)) {
+      parameters.cut_max_parallelism = x;
+    }
+    break;
+
   case PARAM_MAX_UPDATE_CONFLICTS:
     if (param_val_to_pos32(param, val, &n, &reason)) {
       parameters.max_update_conflicts = n;
@@ -4413,6 +4615,12 @@ static void yices_set_option(const char *param, const param_val_t *val, ef_param
     }
     break;
 
+  case PARAM_LAZY_BITBLASTING:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.lazy_bitblasting = tt;
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       ef_params->flatten_iff = tt;
@@ -1576,11 +1576,102 @@ static const help_record_t help_data[] = {
     "The atom (is-int x) is true iff x is an integer.\n",
     NULL },
 
-  // END MARKER: index 158
+  // steepest-edge: index 158
+  { HPARAM,
+    "(set-param steepest-edge [boolean])",
+    "Enable/disable steepest-edge pricing in the Simplex solver",
+    "If 'steepest-edge' is true, Simplex picks the infeasible basic\n"
+    "variable with the largest bound violation relative to the norm\n"
+    "of its row. This disables 'devex'.\n",
+    NULL },
+
+  // devex: index 159
+  { HPARAM,
+    "(set-param devex [boolean])",
+    "Enable/disable devex pricing in the Simplex solver",
+    "This is like 'steepest-edge' with approximate row norms\n"
+    "that are cheaper to maintain. This disables 'steepest-edge'.\n",
+    NULL },
+
+  // bound-flipping: index 160
+  { HPARAM,
+    "(set-param bound-flipping [boolean])",
+    "Enable/disable bound flipping in the Simplex solver",
+    "If 'bound-flipping' is true, Simplex tries to repair an infeasible\n"
+    "variable by moving variables from one bound to the other before\n"
+    "it pivots.\n",
+    NULL },
+
+  // cuts: index 161
+  { HPARAM,
+    "(set-param cuts [boolean])",
+    "Enable/disable cutting planes in the Simplex solver",
+    "If 'cuts' is true, Simplex tries to add Gomory and MIR cuts\n"
+    "before it creates branch-and-bound atoms.\n",
+    NULL },
+
+  // cut-rounds: index 162
+  { HPARAM,
+    "(set-param cut-rounds [integer])",
+    "Number of rounds of cuts before branching",
+    "This parameter matters only if cuts is true.\n",
+    NULL },
+
+  // max-cuts: index 163
+  { HPARAM,
+    "(set-param max-cuts [integer])",
+    "Maximal number of cuts added per round",
+    "This parameter matters only if cuts is true.\n",
+    NULL },
+
+  // cut-pool-size: index 164
+  { HPARAM,
+    "(set-param cut-pool-size [integer])",
+    "Number of cuts kept for reuse",
+    "This parameter matters only if cuts is true.\n",
+    NULL },
+
+  // cut-min-efficacy: index 165
+  { HPARAM,
+    "(set-param cut-min-efficacy [number])",
+    "Minimal efficacy of a cut",
+    "The efficacy of a cut is the distance between the current\n"
+    "Simplex solution and the cut's hyperplane. Cuts of lower\n"
+    "efficacy are ignored.\n",
+    NULL },
+
+  // cut-max-parallelism: index 166
+  { HPARAM,
+    "(set-param cut-max-parallelism [number])",
+    "Maximal parallelism between cuts of the same round",
+    "A cut is not added if the cosine between it and a cut already\n"
+    "added in the same round is more than this. The value must be\n"
+    "between 0.0 and 1.0.\n",
+    NULL },
+
+  // fp-warm-start: index 167
+  { HPARAM,
+    "(set-param fp-warm-start [boolean])",
+    "Enable/disable the floating-point warm start in the Simplex solver",
+    "If 'fp-warm-start' is true, Simplex first searches for a feasible\n"
+    "basis using floating-point arithmetic, then pivots the exact\n"
+    "tableau to that basis before it starts the exact search.\n",
+    NULL },
+
+  // lazy-bitblasting: index 168
+  { HPARAM,
+    "(set-param lazy-bitblasting [boolean])",
+    "Enable/disable lazy bit-blasting of multiplications and divisions",
+    "If 'lazy-bitblasting' is true, bvmul, bvudiv, bvurem, bvsdiv, bvsrem,\n"
+    "and bvsmod are first treated as uninterpreted functions. They are\n"
+    "bit-blasted only if the candidate model does not satisfy them.\n",
+    NULL },
+
+  // END MARKER: index 169
   { HMISC, NULL, NULL, NULL, NULL },
 };
 
-#define END_HELP_DATA 158
+#define END_HELP_DATA 169
 
 
 
@@ -1936,6 +2027,7 @@ static const help_index_t help_index[] = {
   { "bool", NULL, 23, help_basic },
   { "bool-to-bv", NULL, 142, help_basic },
   { "booleans", "Boolean Operators", HBOOLEAN, help_for_category },
+  { "bound-flipping", NULL, 160, help_basic },
   { "branching", NULL, 117, help_basic },
   { "bv-add", NULL, 58, help_basic },
   { "bv-and", NULL, 64, help_basic },
@@ -1988,10 +2080,16 @@ static const help_index_t help_index[] = {
   { "check", NULL, 5, help_basic },
   { "clause-decay", NULL, 118, help_basic },
   { "commands", "Command Summary", HCOMMAND, help_for_category },
+  { "cut-max-parallelism", NULL, 166, help_basic },
+  { "cut-min-efficacy", NULL, 165, help_basic },
+  { "cut-pool-size", NULL, 164, help_basic },
+  { "cut-rounds", NULL, 162, help_basic },
+  { "cuts", NULL, 161, help_basic },
   { "d-factor", NULL, 110, help_basic },
   { "d-threshold", NULL, 109, help_basic },
   { "define", "Declare or define a term", 2, help_variant },
   { "define-type", "Declare or define a type", 0, help_variant },
+  { "devex", NULL, 159, help_basic },
   { "distinct", NULL, 34, help_basic },
   { "div", NULL, 154, help_basic },
   { "divides", NULL, 156, help_basic },
@@ -2014,6 +2112,7 @@ static const help_index_t help_index[] = {
   { "fast-restarts", NULL, 106, help_basic },
   { "flatten", NULL, 103, help_basic },
   { "floor", NULL, 152, help_basic },
+  { "fp-warm-start", NULL, 167, help_basic },
   { "generic", "Generic Operators", HGENERIC, help_for_category },
   { "help", "Show help", 20, help_variant },
   { "icheck", NULL, 135, help_basic },
@@ -2025,9 +2124,11 @@ static const help_index_t help_index[] = {
   { "is-int", NULL, 157, help_basic },
   { "ite", NULL, 30, help_basic },
   { "keep-ite", NULL, 105, help_basic },
+  { "lazy-bitblasting", NULL, 168, help_basic },
   { "learn-eq", NULL, 104, help_basic },
   { "max-ack", NULL, 123, help_basic },
   { "max-bool-ack", NULL, 124, help_basic },
+  { "max-cuts", NULL, 163, help_basic },
   { "max-extensionality", NULL, 138, help_basic },
   { "max-interface-eqs", NULL, 129, help_basic },
   { "max-update-conflicts", NULL, 137, help_basic },
@@ -2061,6 +2162,7 @@ static const help_index_t help_index[] = {
   { "show-timeout", NULL, 19, help_basic },
   { "simplex-adjust", NULL, 133, help_basic },
   { "simplex-prop", NULL, 131, help_basic },
+  { "steepest-edge", NULL, 158, help_basic },
   { "syntax", syntax_summary, 0, help_special },
   { "tclause-size", NULL, 120, help_basic },
   { "true", NULL, 39, help_basic },
@@ -1095,10 +1095,50 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_bool_param(param2string[p], ctx_parameters.splx_periodic_icheck, n);
     break;
 
+  case PARAM_STEEPEST_EDGE:
+    show_bool_param(param2string[p], ctx_parameters.splx_steepest_edge, n);
+    break;
+
+  case PARAM_DEVEX:
+    show_bool_param(param2string[p], ctx_parameters.splx_devex, n);
+    break;
+
+  case PARAM_BOUND_FLIPPING:
+    show_bool_param(param2string[p], ctx_parameters.splx_bound_flipping, n);
+    break;
+
+  case PARAM_FP_WARM_START:
+    show_bool_param(param2string[p], ctx_parameters.splx_fp_warm_start, n);
+    break;
+
   case PARAM_ICHECK_PERIOD:
     show_pos32_param(param2string[p], parameters.integer_check_period, n);
     break;
 
+  case PARAM_CUTS:
+    show_bool_param(param2string[p], parameters.use_cuts, n);
+    break;
+
+  case PARAM_CUT_ROUNDS:
+    show_pos32_param(param2string[p], parameters.cut_rounds, n);
+    break;
+
+  case PARAM_MAX_CUTS:
+    show_pos32_param(param2string[p], parameters.max_cuts, n);
+    break;
+
+  case PARAM_CUT_POOL_SIZE:
+    show_pos32_param(param2string[p], parameters.cut_pool_size, n);
+    break;
+
+  case PARAM_CUT_MIN_EFFICACY:
+    show_float_param(param2string[p], parameters.cut_min_efficacy, n);
+    break;
+
+  case PARAM_CUT_MAX_PARALLELISM:
+    show_float_param(param2string[p], parameters.cut_max_parallelism, n);
+    break;
+
   case PARAM_MAX_UPDATE_CONFLICTS:
     show_pos32_param(param2string[p], parameters.max_update_conflicts, n);
     break;
@@ -1107,6 +1147,10 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_pos32_param(param2string[p], parameters.max_extensionality, n);
     break;
 
+  case PARAM_LAZY_BITBLASTING:
+    show_bool_param(param2string[p], parameters.lazy_bitblasting, n);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     show_bool_param(param2string[p], ef_client_globals.ef_parameters.flatten_iff, n);
     break;
@@ -1509,6 +1553,64 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_STEEPEST_EDGE:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      ctx_parameters.splx_steepest_edge = tt;
+      if (tt) ctx_parameters.splx_devex = false;
+      if (context != NULL) {
+	if (tt) {
+	  enable_splx_steepest_edge(context);
+	} else {
+	  disable_splx_steepest_edge(context);
+	}
+      }
+      print_ok();
+    }
+    break;
+
+  case PARAM_DEVEX:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      ctx_parameters.splx_devex = tt;
+      if (tt) ctx_parameters.splx_steepest_edge = false;
+      if (context != NULL) {
+	if (tt) {
+	  enable_splx_devex(context);
+	} else {
+	  disable_splx_devex(context);
+	}
+      }
+      print_ok();
+    }
+    break;
+
+  case PARAM_BOUND_FLIPPING:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      ctx_parameters.splx_bound_flipping = tt;
+      if (context != NULL) {
+	if (tt) {
+	  enable_splx_bound_flipping(context);
+	} else {
+	  disable_splx_bound_flipping(context);
+	}
+      }
+      print_ok();
+    }
+    break;
+
+  case PARAM_FP_WARM_START:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      ctx_parameters.splx_fp_warm_start = tt;
+      if (context != NULL) {
+	if (tt) {
+	  enable_splx_fp_warm_start(context);
+	} else {
+	  disable_splx_fp_warm_start(context);
+	}
+      }
+      print_ok();
+    }
+    break;
+
   case PARAM_ICHECK_PERIOD:
     if (param_val_to_pos32(param, val, &n, &reason)) {
       parameters.integer_check_period = n;
@@ -1516,6 +1618,48 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_CUTS:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.use_cuts = tt;
+      print_ok();
+    }
+    break;
+
+  case PARAM_CUT_ROUNDS:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.cut_rounds = n;
+      print_ok();
+    }
+    break;
+
+  case PARAM_MAX_CUTS:
+    if (param_val_to_pos32(param, val, &n, &reason)) {
+      parameters.max_cuts = n;
+      print_ok();
+    }
+    break;
+
+  case PARAM_CUT_POOL_SIZE:
+    if (param_val_to_pos32(param, val, &n, &reason)) {
+      parameters.cut_pool_size = n;
+      print_ok();
+    }
+    break;
+
+  case PARAM_CUT_MIN_EFFICACY:
+    if (param_val_to_posfloat(param, val, &x, &reason)) {
+      parameters.cut_min_efficacy = x;
+      print_ok();
+    }
+    break;
+
+  case PARAM_CUT_MAX_PARALLELISM:
+    if (param_val_to_ratio(param, val, &x, &reason)) {
+      parameters.cut_max_parallelism = x;
+      print_ok();
+    }
+    break;
+
   case PARAM_MAX_UPDATE_CONFLICTS:
     if (param_val_to_pos32(param, val, &n, &reason)) {
       parameters.max_update_conflicts = n;
@@ -1530,6 +1674,13 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_LAZY_BITBLASTING:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.lazy_bitblasting = tt;
+      print_ok();
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       ef_client_globals.ef_parameters.flatten_iff = tt;
@@ -1671,6 +1822,10 @@ static void show_simplex_stats(simplex_stats_t *stat) {
   printf(" calls to make_feasible  : %"PRIu32"\n", stat->num_make_feasible);
   printf(" pivots                  : %"PRIu32"\n", stat->num_pivots);
   printf(" bland-rule activations  : %"PRIu32"\n", stat->num_blands);
+  printf(" bound flips             : %"PRIu32"\n", stat->num_bound_flips);
+  printf(" repairs by flips only   : %"PRIu32"\n", stat->num_flip_repairs);
+  printf(" fp warm-start pivots    : %"PRIu32"\n", stat->num_fp_pivots);
+  printf(" warm-start exact pivots : %"PRIu32"\n", stat->num_warm_pivots);
   printf(" simple lemmas           : %"PRIu32"\n", stat->num_binary_lemmas);
   printf(" prop. to core           : %"PRIu32"\n", stat->num_props);
   printf(" derived bounds          : %"PRIu32"\n", stat->num_bound_props);
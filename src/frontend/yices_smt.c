@@ -54,6 +54,8 @@
 #include "solvers/egraph/egraph_printer.h"
 #include "solvers/floyd_warshall/idl_floyd_warshall.h"
 #include "solvers/floyd_warshall/idl_fw_printer.h"
+#include "solvers/floyd_warshall/idl_sparse.h"
+#include "solvers/floyd_warshall/idl_sparse_printer.h"
 #include "solvers/floyd_warshall/rdl_floyd_warshall.h"
 #include "solvers/floyd_warshall/rdl_fw_printer.h"
 #include "solvers/funs/fun_solver.h"
@@ -160,6 +162,10 @@ static bool show_model;
  * Simplex options not in params_t
  */
 static bool eager_lemmas;
+static bool steepest_edge;
+static bool devex;
+static bool bound_flipping;
+static bool fp_warm_start;
 
 
 /*
@@ -265,6 +271,10 @@ typedef enum optid {
   simplex_adjust_model,       // enable optimized model reconciliation (egraph + simplex)
   simplex_bland_threshold,    // threshold that triggers activation of Bland's rule
   simplex_check_period,       // for integer arithmetic: period of calls to integer_check
+  simplex_steepest_edge,      // steepest-edge pricing
+  simplex_devex,              // devex pricing
+  simplex_bound_flipping,     // bound flipping before pivoting
+  simplex_fp_warm_start,      // floating-point warm start
 
   // Array solver
   max_update_conflicts,       // max instances of the update axiom per round
@@ -336,6 +346,10 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "simplex-adjust-model", '\0', FLAG_OPTION, simplex_adjust_model },
   { "bland-threshold", '\0', MANDATORY_INT, simplex_bland_threshold },
   { "icheck-period", '\0', MANDATORY_INT, simplex_check_period },
+  { "steepest-edge", '\0', FLAG_OPTION, simplex_steepest_edge },
+  { "devex", '\0', FLAG_OPTION, simplex_devex },
+  { "bound-flipping", '\0', FLAG_OPTION, simplex_bound_flipping },
+  { "fp-warm-start", '\0', FLAG_OPTION, simplex_fp_warm_start },
 
   { "max-update-conflicts", '\0', MANDATORY_INT, max_update_conflicts },
   { "max-extensionality", '\0', MANDATORY_INT, max_extensionality },
@@ -435,6 +449,10 @@ static void yices_help(char *progname) {
          "   --simplex-adjust-model\n"
          "   --bland-threshold\n"
          "   --icheck-period\n"
+         "   --steepest-edge\n"
+         "   --devex\n"
+         "   --bound-flipping\n"
+         "   --fp-warm-start\n"
          "  Array solver options:\n"
          "   --max-update-conflicts=<int>\n"
          "   --max-extensionality=<int>\n"
@@ -541,6 +559,15 @@ static void check_parameters(char *progname) {
 
   // simplex-specific options
   eager_lemmas = opt_set[simplex_eager_lemmas];
+  steepest_edge = opt_set[simplex_steepest_edge];
+  devex = opt_set[simplex_devex];
+  bound_flipping = opt_set[simplex_bound_flipping];
+  fp_warm_start = opt_set[simplex_fp_warm_start];
+  if (steepest_edge && devex) {
+    fprintf(stderr, "%s: options %s and %s are exclusive\n", progname,
+            opt_name(simplex_steepest_edge), opt_name(simplex_devex));
+    goto error;
+  }
 
   // simplex-propagation
   if (opt_set[simplex_prop_enabled]) {
@@ -989,6 +1016,10 @@ static void parse_command_line(int argc, char *argv[]) {
       case simplex_eager_lemmas:
       case simplex_prop_enabled:
       case simplex_adjust_model:
+      case simplex_steepest_edge:
+      case simplex_devex:
+      case simplex_bound_flipping:
+      case simplex_fp_warm_start:
         break;
 
         // integer parameters
@@ -1074,10 +1105,14 @@ static void show_stats(dpll_stats_t *stat) {
   printf(" simplify db             : %"PRIu32"\n", stat->simplify_calls);
   printf(" reduce db               : %"PRIu32"\n", stat->reduce_calls);
   printf(" remove irrelevant       : %"PRIu32"\n", stat->remove_calls);
+  printf(" clause gc               : %"PRIu32"\n", stat->arena_compactions);
   printf(" decisions               : %"PRIu64"\n", stat->decisions);
   printf(" random decisions        : %"PRIu64"\n", stat->random_decisions);
   printf(" propagations            : %"PRIu64"\n", stat->propagations);
   printf(" conflicts               : %"PRIu64"\n", stat->conflicts);
+  if (stat->chrono_backtracks > 0) {
+    printf(" chrono backtracks       : %"PRIu32"\n", stat->chrono_backtracks);
+  }
   printf(" theory propagations     : %"PRIu32"\n", stat->th_props);
   printf(" propagation-lemmas      : %"PRIu32"\n", stat->th_prop_lemmas);
   printf(" theory conflicts        : %"PRIu32"\n", stat->th_conflicts);
@@ -1089,7 +1124,17 @@ static void show_stats(dpll_stats_t *stat) {
   printf(" subsumed lits.          : %"PRIu64"\n", stat->subsumed_literals);
   printf(" deleted pb. clauses     : %"PRIu64"\n", stat->prob_clauses_deleted);
   printf(" deleted learned clauses : %"PRIu64"\n", stat->learned_clauses_deleted);
+  printf(" core learned clauses    : %"PRIu64"\n", stat->core_clauses);
+  printf(" glue updates            : %"PRIu32"\n", stat->glue_updates);
   printf(" deleted binary clauses  : %"PRIu64"\n", stat->bin_clauses_deleted);
+  if (stat->preprocess_calls > 0) {
+    printf(" preprocessing calls     : %"PRIu32"\n", stat->preprocess_calls);
+    printf(" failed literals         : %"PRIu32"\n", stat->failed_literals);
+    printf(" subsumed clauses        : %"PRIu64"\n", stat->subsumed_clauses);
+    printf(" strengthened clauses    : %"PRIu64"\n", stat->strengthened_clauses);
+    printf(" eliminated vars         : %"PRIu32"\n", stat->elim_vars);
+    printf(" restored vars           : %"PRIu32"\n", stat->restored_vars);
+  }
 }
 
 /*
@@ -1140,6 +1185,10 @@ static void show_simplex_stats(simplex_stats_t *stat) {
   printf(" calls to make_feasible  : %"PRIu32"\n", stat->num_make_feasible);
   printf(" pivots                  : %"PRIu32"\n", stat->num_pivots);
   printf(" bland-rule activations  : %"PRIu32"\n", stat->num_blands);
+  printf(" bound flips             : %"PRIu32"\n", stat->num_bound_flips);
+  printf(" repairs by flips only   : %"PRIu32"\n", stat->num_flip_repairs);
+  printf(" fp warm-start pivots    : %"PRIu32"\n", stat->num_fp_pivots);
+  printf(" warm-start exact pivots : %"PRIu32"\n", stat->num_warm_pivots);
   printf(" simple lemmas           : %"PRIu32"\n", stat->num_binary_lemmas);
   //  printf(" propagation lemmas      : %"PRIu32"\n", stat->num_prop_lemmas);  (it's always zero)
   printf(" prop. to core           : %"PRIu32"\n", stat->num_props);
@@ -1167,6 +1216,14 @@ static void show_simplex_stats(simplex_stats_t *stat) {
     printf(" dioph conflicts         : %"PRIu32"\n", stat->num_dioph_conflicts);
     printf(" bound conflicts         : %"PRIu32"\n", stat->num_dioph_bound_conflicts);
     printf(" recheck conflicts       : %"PRIu32"\n", stat->num_dioph_recheck_conflicts);
+    if (stat->num_cut_rounds > 0) {
+      printf("cutting planes\n");
+      printf(" cut rounds              : %"PRIu32"\n", stat->num_cut_rounds);
+      printf(" gomory cuts             : %"PRIu32"\n", stat->num_gomory_cuts);
+      printf(" mir cuts                : %"PRIu32"\n", stat->num_mir_cuts);
+      printf(" cuts added              : %"PRIu32"\n", stat->num_cuts);
+      printf(" cuts from the pool      : %"PRIu32"\n", stat->num_pool_cuts);
+    }
   }
 }
 
@@ -1287,6 +1344,8 @@ static void print_presearch_stats(void) {
     printf("arithmetic solver       : IDL Floyd-Warshall\n");
   } else if (context_has_rdl_solver(&context)) {
     printf("arithmetic solver       : RDL Floyd-Warshall\n");
+  } else if (context_has_sidl_solver(&context)) {
+    printf("arithmetic solver       : Sparse IDL\n");
   }
 
   printf("\n");
@@ -1345,6 +1404,18 @@ static void print_options(FILE *f, context_t *ctx) {
           params.adjust_simplex_model) {
         fprintf(f, " --simplex-adjust-model");
       }
+      if (simplex_option_enabled(simplex, SIMPLEX_STEEPEST_EDGE)) {
+        fprintf(f, " --steepest-edge");
+      }
+      if (simplex_option_enabled(simplex, SIMPLEX_DEVEX)) {
+        fprintf(f, " --devex");
+      }
+      if (simplex_option_enabled(simplex, SIMPLEX_BOUND_FLIPPING)) {
+        fprintf(f, " --bound-flipping");
+      }
+      if (simplex_option_enabled(simplex, SIMPLEX_FP_WARM_START)) {
+        fprintf(f, " --fp-warm-start");
+      }
       fprintf(f, " --bland-threshold=%"PRIu32, params.bland_threshold);
       fprintf(f, " --icheck-period=%"PRId32, params.integer_check_period);
     } else if (context_has_rdl_solver(ctx) || context_has_idl_solver(ctx)) {
@@ -1579,6 +1650,9 @@ static void dump_the_context(context_t *context, smt_benchmark_t *bench, char *f
     print_idl_atoms(dump, context->arith_solver);
   } else if (context_has_rdl_solver(context)) {
     fprintf(dump, "\n==== RDL ATOMS ====\n");
+  } else if (context_has_sidl_solver(context)) {
+    fprintf(dump, "\n==== SPARSE IDL ATOMS ====\n");
+    print_sidl_atoms(dump, context->arith_solver);
   } else if (context_has_simplex_solver(context)) {
     fprintf(dump, "\n==== SIMPLEX VARIABLES ====\n");
     print_simplex_vars(dump, context->arith_solver);
@@ -1944,6 +2018,18 @@ static int process_benchmark(char *filename) {
   if (eager_lemmas) {
     enable_splx_eager_lemmas(&context);
   }
+  if (steepest_edge) {
+    enable_splx_steepest_edge(&context);
+  }
+  if (devex) {
+    enable_splx_devex(&context);
+  }
+  if (bound_flipping) {
+    enable_splx_bound_flipping(&context);
+  }
+  if (fp_warm_start) {
+    enable_splx_fp_warm_start(&context);
+  }
   if (need_icheck) {
     enable_splx_periodic_icheck(&context);
   }
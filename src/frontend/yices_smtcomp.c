@@ -417,6 +417,8 @@ static void print_presearch_stats(FILE *f) {
     fprintf(f, "arithmetic solver       : IDL Floyd-Warshall\n");
   } else if (context_has_rdl_solver(&context)) {
     fprintf(f, "arithmetic solver       : RDL Floyd-Warshall\n");
+  } else if (context_has_sidl_solver(&context)) {
+    fprintf(f, "arithmetic solver       : Sparse IDL\n");
   }
   fprintf(f, "\n");
   fflush(f);
@@ -626,6 +628,10 @@ static void show_simplex_stats(simplex_stats_t *stat) {
   fprintf(stderr, " calls to make_feasible  : %"PRIu32"\n", stat->num_make_feasible);
   fprintf(stderr, " pivots                  : %"PRIu32"\n", stat->num_pivots);
   fprintf(stderr, " bland-rule activations  : %"PRIu32"\n", stat->num_blands);
+  fprintf(stderr, " bound flips             : %"PRIu32"\n", stat->num_bound_flips);
+  fprintf(stderr, " repairs by flips only   : %"PRIu32"\n", stat->num_flip_repairs);
+  fprintf(stderr, " fp warm-start pivots    : %"PRIu32"\n", stat->num_fp_pivots);
+  fprintf(stderr, " warm-start exact pivots : %"PRIu32"\n", stat->num_warm_pivots);
   fprintf(stderr, " simple lemmas           : %"PRIu32"\n", stat->num_binary_lemmas);
   fprintf(stderr, " prop. to core           : %"PRIu32"\n", stat->num_props);
   fprintf(stderr, " derived bounds          : %"PRIu32"\n", stat->num_bound_props);
@@ -1185,8 +1191,8 @@ static int process_benchmark(void) {
      */
     switch (arch) {
     case CTX_ARCH_AUTO_IDL:
-      if (context_has_idl_solver(&context)) {
-        // IDL/Floyd-Warshall: --flatten --cache-tclauses --fast-restarts
+      if (context_has_idl_solver(&context) || context_has_sidl_solver(&context)) {
+        // IDL/Floyd-Warshall or sparse IDL: --flatten --cache-tclauses --fast-restarts
         params.cache_tclauses = true;
         params.tclause_size = 8;
         params.fast_restart = true;
@@ -2956,6 +2956,19 @@ __YICES_DLLSPEC__ extern int32_t yices_pop(context_t *ctx);
  *   (ite c 10 (ite d 3 20)), then the context with include the assertion
  *   3 <= t <= 20.
  *
+ *   arith-steepest-edge, arith-devex: pivoting rules for the simplex solver.
+ *   They select the leaving variable with the largest bound violation relative
+ *   to the norm of its row (exact norm for steepest-edge, approximate for devex).
+ *   Enabling one of them disables the other. By default, both are disabled.
+ *
+ *   arith-bound-flipping: if enabled, the simplex solver tries to fix an
+ *   infeasible basic variable by moving non-basic variables to their
+ *   opposite bound before it pivots.
+ *
+ *   arith-fp-warm-start: if enabled, the simplex solver searches for a
+ *   feasible basis in floating-point arithmetic when the search starts.
+ *   This basis is the starting point of the exact simplex.
+ *
  * The parameter must be given as a string. For example, to disable var-elim,
  * call  yices_context_disable_option(ctx, "var-elim")
  *
@@ -3053,6 +3066,69 @@ __YICES_DLLSPEC__ extern int32_t yices_assert_formulas(context_t *ctx, uint32_t
 __YICES_DLLSPEC__ extern smt_status_t yices_check_context(context_t *ctx, const param_t *params);
 
 
+/*
+ * Check satisfiability under assumptions: check whether the assertions
+ * stored in ctx conjoined with the Boolean terms t[0 ... n-1] are
+ * satisfiable.
+ * - params is an optional structure that stores heuristic parameters
+ *   (as in yices_check_context).
+ * - the assumptions are not asserted: they're used as the first decisions
+ *   of the search. The clauses learned during the search are kept so
+ *   a sequence of checks with different assumptions is much cheaper than
+ *   yices_push/yices_assert_formulas/yices_check_context/yices_pop.
+ *
+ * The behavior and returned value depend on ctx's current status:
+ *
+ * 1) If ctx's status is STATUS_UNSAT and this does not depend on the
+ *    assumptions of a previous call, the function returns STATUS_UNSAT.
+ *
+ * 2) If ctx's status is STATUS_SAT or STATUS_UNKNOWN, or STATUS_UNSAT
+ *    because of the previous assumptions, the current assignment is
+ *    cleared and the search proceeds as in case 3. This requires a context
+ *    that supports multiple checks.
+ *
+ * 3) If ctx's status is STATUS_IDLE, the solver searches for a
+ *    satisfying assignment that makes all t[i]s true. The returned
+ *    codes are the same as for yices_check_context.
+ *
+ * If the result is STATUS_UNSAT, the subset of t[0 ... n-1] that caused
+ * unsatisfiability can be obtained by yices_get_unsat_core.
+ *
+ * After a call that returns STATUS_UNSAT because of the assumptions,
+ * yices_assert_formula, yices_assert_formulas, yices_push, and
+ * yices_check_context restore ctx's status to STATUS_IDLE first.
+ *
+ * Error report:
+ * - if some t[i] is invalid or not Boolean, or can't be internalized:
+ *   same error codes as yices_assert_formula
+ * - if ctx's status is STATUS_SAT or STATUS_UNKNOWN and ctx does not
+ *   support multiple checks, or if ctx uses MCSAT:
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ * - if ctx's status is STATUS_SEARCHING or STATUS_INTERRUPTED:
+ *   code = CTX_INVALID_OPERATION
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_check_context_with_assumptions(context_t *ctx, const param_t *params, uint32_t n, const term_t t[]);
+
+
+/*
+ * Get the assumptions that caused unsatisfiability:
+ * - ctx's status must be STATUS_UNSAT
+ * - if the last call to yices_check_context_with_assumptions returned
+ *   STATUS_UNSAT because of the assumptions, then a subset of these
+ *   assumptions that's inconsistent with the assertions is stored in v.
+ *   (The subset is not necessarily minimal.)
+ * - otherwise, v is empty (the assertions are unsatisfiable).
+ * - v must be initialized by yices_init_term_vector.
+ *
+ * Return code: 0 if there's no error, -1 otherwise.
+ *
+ * Error report:
+ * - if ctx's status is not STATUS_UNSAT
+ *   code = CTX_INVALID_OPERATION
+ */
+__YICES_DLLSPEC__ extern int32_t yices_get_unsat_core(context_t *ctx, term_vector_t *v);
+
+
 /*
  * Add a blocking clause: this is intended to help enumerate different models
  * for a set of assertions.
@@ -3086,6 +3162,52 @@ __YICES_DLLSPEC__ extern int32_t yices_assert_blocking_clause(context_t *ctx);
 __YICES_DLLSPEC__ extern void yices_stop_search(context_t *ctx);
 
 
+/*
+ * Portfolio check: search n contexts in parallel.
+ * - ctx[0 ... n-1] must be n distinct contexts, all with status STATUS_IDLE,
+ *   that contain the same assertions (e.g., created with the same configuration
+ *   and populated with the same calls to yices_assert_formula).
+ * - params is an optional structure that stores the base search parameters.
+ *   If params is NULL, the default parameters for ctx[0] are used.
+ * - context ctx[0] is searched with params. The other contexts are searched
+ *   with variants of params that use different restart strategies,
+ *   branching heuristics, variable-activity decay, and random seeds.
+ *
+ * Each context is searched in a separate thread. The first context to
+ * return STATUS_SAT or STATUS_UNSAT wins. The search in all the other contexts
+ * is then interrupted.
+ *
+ * The function returns:
+ * - the winner's status (STATUS_SAT or STATUS_UNSAT) and stores the winner's
+ *   index in *winner. A model can then be obtained from ctx[*winner].
+ * - STATUS_UNKNOWN if no context was decided but some context returned
+ *   STATUS_UNKNOWN. Then *winner is the index of that context.
+ * - STATUS_INTERRUPTED if all the searches were interrupted by calls to
+ *   yices_stop_search. Then *winner is -1.
+ *
+ * After this call, the contexts that did not win are either in state
+ * STATUS_IDLE (if they were interrupted and their mode is interactive),
+ * or in state STATUS_INTERRUPTED, or in whatever state they reached
+ * before they could be interrupted.
+ *
+ * If parameter "share-clauses" is true in params, then the searches exchange
+ * short learned clauses (cf. parameters "share-max-length" and "share-max-glue").
+ * This is done only if all the contexts were built in the same way (same
+ * configuration and same sequence of assertions).
+ *
+ * Parallel search requires Yices to be built with thread-safety enabled
+ * (configure option --enable-thread-safety). Otherwise, only ctx[0] is searched.
+ *
+ * Error report: the function returns STATUS_ERROR and sets the error report
+ * if n is 0, or if a context occurs twice in ctx, or if a context's status is
+ * not STATUS_IDLE
+ *   code = CTX_INVALID_OPERATION
+ * if a context uses the MCSAT solver
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_check_context_portfolio(uint32_t n, context_t *ctx[], const param_t *params, int32_t *winner);
+
+
 
 
 /*
@@ -3657,6 +3779,67 @@ __YICES_DLLSPEC__ extern term_t yices_get_value_as_term(model_t *mdl, term_t t);
 __YICES_DLLSPEC__ extern int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a[], term_t b[]);
 
 
+/*
+ * EVALUATION PLANS
+ *
+ * To evaluate the same terms in many models, the terms can be compiled
+ * into an evaluation plan. The plan lists all subterms in topological
+ * order and folds the ground subterms into constants, so this work is
+ * done once rather than once per model.
+ *
+ * yices_new_eval_plan(n, a) builds a plan for terms a[0 ... n-1]
+ * - a must be an array of n valid terms
+ * - return NULL if there's an error
+ *
+ * Error report:
+ *   code = INVALID_TERM
+ *   term1 = a[i] if a[i] is not valid
+ *
+ * The plan stays valid until it's deleted by yices_free_eval_plan or
+ * by a call to yices_exit or yices_reset. Its terms are kept by the
+ * garbage collector.
+ */
+__YICES_DLLSPEC__ extern eval_plan_t *yices_new_eval_plan(uint32_t n, const term_t a[]);
+
+/*
+ * Delete a plan
+ */
+__YICES_DLLSPEC__ extern void yices_free_eval_plan(eval_plan_t *plan);
+
+/*
+ * Get the values of the plan's terms a[0 ... n-1] in mdl and convert the values to terms.
+ * - b must be large enough to store n terms
+ *
+ * This is equivalent to yices_term_array_value(mdl, n, a, b), with
+ * the same behavior and error codes.
+ *
+ * A plan can't be used by several threads at the same time.
+ */
+__YICES_DLLSPEC__ extern int32_t yices_eval_plan_value(eval_plan_t *plan, model_t *mdl, term_t b[]);
+
+/*
+ * Evaluate several plans in several models, possibly in parallel
+ * - m = number of jobs: job j evaluates plan[j] in mdl[j]
+ * - b[j] = array to store the values of job j as constant terms
+ *   (b[j] must be large enough for all the terms of plan[j])
+ * - status[j] = result of job j: 0 if all values were computed, or
+ *   an error code (same codes as yices_eval_plan_value)
+ * - nthreads = maximal number of threads to use
+ *
+ * The same plan or the same model can be used by several jobs. The
+ * models are not modified: evaluation uses a private value table per
+ * job. All the values are converted to terms once all jobs are done.
+ *
+ * Return 0 if all jobs succeed. Otherwise, return -1 and set the error
+ * report to the status of the first job that failed.
+ *
+ * Parallel evaluation requires a thread-safe build. Otherwise, the
+ * jobs are done sequentially.
+ */
+__YICES_DLLSPEC__ extern int32_t yices_eval_plans_in_models(uint32_t m, eval_plan_t *const plan[], model_t *const mdl[],
+                                                            term_t *const b[], int32_t status[], uint32_t nthreads);
+
+
 
 
 /*
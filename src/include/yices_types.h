@@ -59,6 +59,12 @@ typedef struct context_s context_t;
 typedef struct model_s model_t;
 
 
+/*
+ * Evaluation plan: terms compiled for evaluation in many models (opaque type)
+ */
+typedef struct eval_plan_s eval_plan_t;
+
+
 /*
  * Context configuration (opaque type)
  */
@@ -28,6 +28,7 @@
 #include "utils/hash_functions.h"
 #include "utils/int_array_sort.h"
 #include "utils/memalloc.h"
+#include "utils/yices_locks.h"
 
 #ifdef HAVE_MCSAT
 #include <poly/algebraic_number.h>
@@ -62,6 +63,21 @@ static void init_map_htbl(map_htbl_t *htbl) {
 
 
 
+/*
+ * Initialize htbl as a copy of src
+ */
+static void init_map_htbl_copy(map_htbl_t *htbl, const map_htbl_t *src) {
+  uint32_t n;
+
+  n = src->size;
+  htbl->data = (map_pair_t *) safe_malloc(n * sizeof(map_pair_t));
+  memcpy(htbl->data, src->data, n * sizeof(map_pair_t));
+  htbl->size = n;
+  htbl->nelems = src->nelems;
+  htbl->resize_threshold = src->resize_threshold;
+}
+
+
 /*
  * Delete the table
  */
@@ -613,6 +629,54 @@ void init_value_table(value_table_t *table, uint32_t n, type_table_t *ttbl) {
 
   table->aux_namer = NULL;
   table->unint_namer = NULL;
+
+  table->base_objects = 0;
+}
+
+
+/*
+ * Initialize table as an extension of base
+ */
+void init_value_table_extension(value_table_t *table, value_table_t *base) {
+  uint32_t n, size;
+
+  n = base->nobjects;
+  size = base->size;
+  assert(n <= size && size > 0);
+
+  table->size = size;
+  table->nobjects = n;
+  table->kind = (uint8_t *) safe_malloc(size * sizeof(uint8_t));
+  table->desc = (value_desc_t *) safe_malloc(size * sizeof(value_desc_t));
+  table->canonical = allocate_bitvector0(size);
+  memcpy(table->kind, base->kind, n * sizeof(uint8_t));
+  memcpy(table->desc, base->desc, n * sizeof(value_desc_t));
+  memcpy(table->canonical, base->canonical, (n + 7) >> 3);
+
+  table->type_table = base->type_table;
+  init_int_htbl_copy(&table->htbl, &base->htbl);
+  init_bvconstant(&table->buffer);
+  init_ivector(&table->aux_vector, 0);
+  init_map_htbl_copy(&table->mtbl, &base->mtbl);
+  init_vtbl_queue(&table->queue);
+
+  table->hset1 = NULL;
+  table->hset2 = NULL;
+
+  table->unknown_value = base->unknown_value;
+  table->true_value = base->true_value;
+  table->false_value = base->false_value;
+
+  table->zero_rdiv_fun = base->zero_rdiv_fun;
+  table->zero_idiv_fun = base->zero_idiv_fun;
+  table->zero_mod_fun = base->zero_mod_fun;
+
+  table->first_tmp = -1;
+
+  table->aux_namer = base->aux_namer;
+  table->unint_namer = base->unint_namer;
+
+  table->base_objects = n;
 }
 
 
@@ -775,6 +839,7 @@ static void vtbl_delete_descriptors(value_table_t *table, uint32_t k) {
  * - empty the table.
  */
 void reset_value_table(value_table_t *table) {
+  assert(table->base_objects == 0);
   vtbl_delete_descriptors(table, 0);
   reset_int_htbl(&table->htbl);
   reset_map_htbl(&table->mtbl);
@@ -795,7 +860,7 @@ void reset_value_table(value_table_t *table) {
  * Delete the table
  */
 void delete_value_table(value_table_t *table) {
-  vtbl_delete_descriptors(table, 0);
+  vtbl_delete_descriptors(table, table->base_objects);
   safe_free(table->kind);
   safe_free(table->desc);
   delete_bitvector(table->canonical);
@@ -1734,53 +1799,55 @@ static value_t build_update_value(update_hobj_t *o) {
 
 /*
  * Hash-consing objects for int_htbl
+ * - they are thread-local so that several threads can create objects
+ *   in different tables (cf. init_value_table_extension)
  */
-static rational_hobj_t rational_hobj = {
+static YICES_THREAD_LOCAL rational_hobj_t rational_hobj = {
   { (hobj_hash_t) hash_rational_value, (hobj_eq_t) equal_rational_value, (hobj_build_t) build_rational_value },
   NULL,
   NULL,
 };
 
-static algebraic_hobj_t algebraic_hobj = {
+static YICES_THREAD_LOCAL algebraic_hobj_t algebraic_hobj = {
   { (hobj_hash_t) hash_algebraic_value, (hobj_eq_t) equal_algebraic_value, (hobj_build_t) build_algebraic_value },
   NULL,
   NULL,
 };
 
-static const_hobj_t const_hobj = {
+static YICES_THREAD_LOCAL const_hobj_t const_hobj = {
   { (hobj_hash_t) hash_const_value, (hobj_eq_t) equal_const_value, (hobj_build_t) build_const_value },
   NULL,
   0,
   0,
 };
 
-static bv_hobj_t bv_hobj = {
+static YICES_THREAD_LOCAL bv_hobj_t bv_hobj = {
   { (hobj_hash_t) hash_bv_value, (hobj_eq_t) equal_bv_value, (hobj_build_t) build_bv_value },
   NULL,
   0, NULL,
 };
 
-static tuple_hobj_t tuple_hobj = {
+static YICES_THREAD_LOCAL tuple_hobj_t tuple_hobj = {
   { (hobj_hash_t) hash_tuple_value, (hobj_eq_t) equal_tuple_value, (hobj_build_t) build_tuple_value },
   NULL,
   0, NULL,
 };
 
-static map_hobj_t map_hobj = {
+static YICES_THREAD_LOCAL map_hobj_t map_hobj = {
   { (hobj_hash_t) hash_map_value, (hobj_eq_t) equal_map_value, (hobj_build_t) build_map_value },
   NULL,
   0, NULL, 0,
 };
 
 
-static fun_hobj_t fun_hobj = {
+static YICES_THREAD_LOCAL fun_hobj_t fun_hobj = {
   { (hobj_hash_t) hash_fun_value, (hobj_eq_t) equal_fun_value, (hobj_build_t) build_fun_value },
   NULL,
   0, 0, 0, 0, NULL,
 };
 
 
-static update_hobj_t update_hobj = {
+static YICES_THREAD_LOCAL update_hobj_t update_hobj = {
   { (hobj_hash_t) hash_update_value, (hobj_eq_t) equal_update_value, (hobj_build_t) build_update_value },
   NULL,
   0, 0, 0, 0, 0, 0, NULL,
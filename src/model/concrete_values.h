@@ -320,6 +320,11 @@ typedef const char *(*unint_namer_fun_t)(void *aux, value_unint_t *d);
  *   and objects in [first_tmp .. nobjects - 1] are temporary.
  *
  * - pointer for getting names of uninterpreted constants
+ *
+ * - base_objects = number of objects borrowed from a base table
+ *   (cf. init_value_table_extension). Objects [0 .. base_objects - 1]
+ *   share their descriptors with the base table and they are not
+ *   deleted with this table. base_objects is 0 for a normal table.
  */
 typedef struct value_table_s {
   uint32_t size;
@@ -349,6 +354,8 @@ typedef struct value_table_s {
 
   void *aux_namer;
   unint_namer_fun_t unint_namer;
+
+  uint32_t base_objects;
 } value_table_t;
 
 
@@ -369,13 +376,31 @@ typedef struct value_table_s {
  */
 extern void init_value_table(value_table_t *table, uint32_t n, type_table_t *ttbl);
 
+/*
+ * Initialize table as an extension of base
+ * - all objects of base are visible in table, with the same indices
+ *   and descriptors, and hash consing takes them into account
+ * - new objects are created in table only: base is not modified
+ *
+ * This can be used to evaluate terms in a model without modifying the
+ * model's value table, for example, if several threads evaluate terms
+ * in the same model. Each thread must then use its own extension.
+ * The base table must not be modified or deleted while the extension
+ * is in use.
+ *
+ * Creating the extension costs O(size of base).
+ */
+extern void init_value_table_extension(value_table_t *table, value_table_t *base);
+
 /*
  * Delete table: free all memory
+ * - if table is an extension, the objects borrowed from the base table are kept
  */
 extern void delete_value_table(value_table_t *table);
 
 /*
  * Reset: empty the table
+ * - table must not be an extension
  */
 extern void reset_value_table(value_table_t *table);
 
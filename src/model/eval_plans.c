@@ -0,0 +1,565 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * EVALUATION PLANS
+ */
+
+#include <assert.h>
+
+#include "model/eval_plans.h"
+#include "model/model_eval.h"
+#include "model/val_to_term.h"
+#include "utils/int_hash_map.h"
+#include "utils/int_vectors.h"
+#include "utils/memalloc.h"
+#include "utils/yices_locks.h"
+
+
+/*
+ * Add the indices of t's children to vector v
+ * - t is given by its index i
+ * - the children are the terms the evaluator may need to compute
+ *   t's value (quantifiers and lambdas are considered as leaves since
+ *   they can't be evaluated)
+ */
+static void get_children(term_table_t *terms, int32_t i, ivector_t *v) {
+  composite_term_t *c;
+  pprod_t *p;
+  polynomial_t *poly;
+  bvpoly64_t *bvp64;
+  bvpoly_t *bvp;
+  uint32_t j, n;
+
+  switch (kind_for_idx(terms, i)) {
+  case CONSTANT_TERM:
+  case ARITH_CONSTANT:
+  case BV64_CONSTANT:
+  case BV_CONSTANT:
+  case VARIABLE:
+  case UNINTERPRETED_TERM:
+  case FORALL_TERM:
+  case LAMBDA_TERM:
+    break;
+
+  case ARITH_EQ_ATOM:
+  case ARITH_GE_ATOM:
+  case ARITH_IS_INT_ATOM:
+  case ARITH_FLOOR:
+  case ARITH_CEIL:
+  case ARITH_ABS:
+    ivector_push(v, index_of(integer_value_for_idx(terms, i)));
+    break;
+
+  case ITE_TERM:
+  case ITE_SPECIAL:
+  case APP_TERM:
+  case UPDATE_TERM:
+  case TUPLE_TERM:
+  case EQ_TERM:
+  case DISTINCT_TERM:
+  case OR_TERM:
+  case XOR_TERM:
+  case ARITH_BINEQ_ATOM:
+  case ARITH_RDIV:
+  case ARITH_IDIV:
+  case ARITH_MOD:
+  case ARITH_DIVIDES_ATOM:
+  case BV_ARRAY:
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR:
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+    c = composite_for_idx(terms, i);
+    n = c->arity;
+    for (j=0; j<n; j++) {
+      ivector_push(v, index_of(c->arg[j]));
+    }
+    break;
+
+  case SELECT_TERM:
+  case BIT_TERM:
+    ivector_push(v, index_of(select_for_idx(terms, i)->arg));
+    break;
+
+  case POWER_PRODUCT:
+    p = pprod_for_idx(terms, i);
+    n = p->len;
+    for (j=0; j<n; j++) {
+      ivector_push(v, index_of(p->prod[j].var));
+    }
+    break;
+
+  case ARITH_POLY:
+    poly = polynomial_for_idx(terms, i);
+    n = poly->nterms;
+    for (j=0; j<n; j++) {
+      if (poly->mono[j].var != const_idx) {
+        ivector_push(v, index_of(poly->mono[j].var));
+      }
+    }
+    break;
+
+  case BV64_POLY:
+    bvp64 = bvpoly64_for_idx(terms, i);
+    n = bvp64->nterms;
+    for (j=0; j<n; j++) {
+      if (bvp64->mono[j].var != const_idx) {
+        ivector_push(v, index_of(bvp64->mono[j].var));
+      }
+    }
+    break;
+
+  case BV_POLY:
+    bvp = bvpoly_for_idx(terms, i);
+    n = bvp->nterms;
+    for (j=0; j<n; j++) {
+      if (bvp->mono[j].var != const_idx) {
+        ivector_push(v, index_of(bvp->mono[j].var));
+      }
+    }
+    break;
+
+  default:
+    assert(false);
+    break;
+  }
+}
+
+
+/*
+ * Check whether a term of kind k can be ground (provided its children are)
+ * - uninterpreted terms, variables, quantifiers, and lambdas are not ground
+ * - the value of (/ x 0), (div x 0), and (mod x 0) depends on the model
+ */
+static bool ground_kind(term_kind_t k) {
+  switch (k) {
+  case VARIABLE:
+  case UNINTERPRETED_TERM:
+  case FORALL_TERM:
+  case LAMBDA_TERM:
+  case ARITH_RDIV:
+  case ARITH_IDIV:
+  case ARITH_MOD:
+    return false;
+
+  default:
+    return true;
+  }
+}
+
+
+
+/*
+ * Collect all subterms of a[0 ... n-1] in topological order
+ * - the subterm indices are added to vector slots
+ * - the mapping from index to slot is stored in map
+ * - ground[s] is set to true if the term of slot s is ground
+ */
+static void collect_subterms(term_table_t *terms, uint32_t n, const term_t a[], int_hmap_t *map,
+                             ivector_t *slots, ivector_t *ground) {
+  ivector_t stack, children;
+  int_hmap_pair_t *r;
+  uint32_t k, j;
+  int32_t i, g;
+
+  init_ivector(&stack, 64);
+  init_ivector(&children, 10);
+
+  for (k=0; k<n; k++) {
+    assert(stack.size == 0);
+    ivector_push(&stack, index_of(a[k]));
+
+    while (stack.size > 0) {
+      i = ivector_last(&stack);
+      r = int_hmap_get(map, i);
+      if (r->val == -1) {
+        // first visit: push the children
+        r->val = -2;
+        get_children(terms, i, &children);
+        for (j=0; j<children.size; j++) {
+          if (int_hmap_find(map, children.data[j]) == NULL) {
+            ivector_push(&stack, children.data[j]);
+          }
+        }
+        ivector_reset(&children);
+
+      } else {
+        ivector_pop(&stack);
+        if (r->val == -2) {
+          // all children have a slot: i gets the next slot
+          r->val = slots->size;
+          ivector_push(slots, i);
+
+          g = ground_kind(kind_for_idx(terms, i));
+          get_children(terms, i, &children);
+          for (j=0; j<children.size && g; j++) {
+            g = ground->data[int_hmap_find(map, children.data[j])->val];
+          }
+          ivector_reset(&children);
+          ivector_push(ground, g);
+        }
+      }
+    }
+  }
+
+  delete_ivector(&children);
+  delete_ivector(&stack);
+}
+
+
+/*
+ * Build the plan
+ */
+void init_eval_plan(eval_plan_t *plan, term_table_t *terms, uint32_t n, const term_t a[]) {
+  int_hmap_t map;
+  ivector_t slots, ground, children;
+  model_t scratch;
+  evaluator_t eval;
+  value_t v;
+  uint32_t i, j, nslots, map_size;
+  int32_t s;
+  byte_t *required;
+  bool has_scratch;
+  term_t t;
+
+  init_int_hmap(&map, 0);
+  init_ivector(&slots, 64);
+  init_ivector(&ground, 64);
+  collect_subterms(terms, n, a, &map, &slots, &ground);
+
+  nslots = slots.size;
+  map_size = 0;
+  for (i=0; i<nslots; i++) {
+    if (slots.data[i] >= map_size) {
+      map_size = slots.data[i] + 1;
+    }
+  }
+
+  plan->terms = terms;
+  plan->nroots = n;
+  plan->nslots = nslots;
+  plan->map_size = map_size;
+  plan->root = (term_t *) safe_malloc(n * sizeof(term_t));
+  plan->slot_term = (term_t *) safe_malloc(nslots * sizeof(term_t));
+  plan->slot_def = (term_t *) safe_malloc(nslots * sizeof(term_t));
+  plan->slot_map = (int32_t *) safe_malloc(map_size * sizeof(int32_t));
+  plan->slot_value = (value_t *) safe_malloc(nslots * sizeof(value_t));
+
+  for (i=0; i<n; i++) {
+    plan->root[i] = a[i];
+  }
+  for (i=0; i<map_size; i++) {
+    plan->slot_map[i] = -1;
+  }
+  for (i=0; i<nslots; i++) {
+    plan->slot_term[i] = pos_term(slots.data[i]);
+    plan->slot_map[slots.data[i]] = i;
+  }
+
+  /*
+   * Decide how each slot is filled: parents are visited before
+   * their children. A slot is required if it's the slot of an input
+   * term or a child of a required slot that's not folded.
+   */
+  required = (byte_t *) safe_malloc(nslots * sizeof(byte_t));
+  for (i=0; i<nslots; i++) {
+    required[i] = false;
+  }
+  for (i=0; i<n; i++) {
+    required[plan->slot_map[index_of(a[i])]] = true;
+  }
+
+  init_ivector(&children, 10);
+  has_scratch = false;
+  i = nslots;
+  while (i > 0) {
+    i --;
+    t = plan->slot_term[i];
+    if (! required[i]) {
+      plan->slot_def[i] = NULL_TERM;
+      continue;
+    }
+
+    if (ground.data[i] && !is_const_term(terms, t)) {
+      // try to fold t: evaluate it in an empty model
+      if (! has_scratch) {
+        init_model(&scratch, terms, false);
+        init_evaluator(&eval, &scratch);
+        has_scratch = true;
+      }
+      v = eval_in_model(&eval, t);
+      if (v >= 0) {
+        t = convert_value_to_term(terms, &scratch.vtbl, v);
+        if (t >= 0) {
+          plan->slot_def[i] = t;
+          continue;
+        }
+      }
+      t = plan->slot_term[i];
+    }
+
+    plan->slot_def[i] = t;
+    get_children(terms, index_of(t), &children);
+    for (j=0; j<children.size; j++) {
+      s = plan->slot_map[children.data[j]];
+      assert(s >= 0 && s < i);
+      required[s] = true;
+    }
+    ivector_reset(&children);
+  }
+
+  if (has_scratch) {
+    delete_evaluator(&eval);
+    delete_model(&scratch);
+  }
+
+  delete_ivector(&children);
+  safe_free(required);
+  delete_ivector(&ground);
+  delete_ivector(&slots);
+  delete_int_hmap(&map);
+}
+
+
+/*
+ * Delete the plan
+ */
+void delete_eval_plan(eval_plan_t *plan) {
+  safe_free(plan->root);
+  safe_free(plan->slot_term);
+  safe_free(plan->slot_def);
+  safe_free(plan->slot_map);
+  safe_free(plan->slot_value);
+  plan->root = NULL;
+  plan->slot_term = NULL;
+  plan->slot_def = NULL;
+  plan->slot_map = NULL;
+  plan->slot_value = NULL;
+}
+
+
+/*
+ * Execute the plan using evaluator eval
+ * - val = array of plan->nslots values to store the slot values
+ * - all slots are evaluated in order: since all children of a term
+ *   have a smaller slot, evaluating the term does not recurse.
+ * - if the evaluation of a slot fails, the error code is stored in
+ *   the slot. It's reported only if the value of this slot is needed
+ *   to evaluate an input term.
+ */
+static int32_t execute_eval_plan(eval_plan_t *plan, evaluator_t *eval, value_t *val, value_t b[]) {
+  value_t v;
+  uint32_t i, n;
+  term_t t;
+
+  n = plan->nslots;
+  for (i=0; i<n; i++) {
+    val[i] = null_value;
+  }
+
+  evaluator_set_slots(eval, plan->slot_map, plan->map_size, val);
+
+  for (i=0; i<n; i++) {
+    t = plan->slot_def[i];
+    if (t != NULL_TERM && val[i] == null_value) {
+      v = eval_in_model(eval, t);
+      // if t is folded, or if t has a value in mdl, val[i] is still null here
+      if (val[i] == null_value) {
+        val[i] = v;
+      }
+    }
+  }
+
+  n = plan->nroots;
+  for (i=0; i<n; i++) {
+    v = eval_in_model(eval, plan->root[i]);
+    b[i] = v;
+    if (v < 0) {
+      return v;
+    }
+  }
+
+  return 0;
+}
+
+
+/*
+ * Execute the plan in mdl
+ */
+int32_t eval_plan_values(eval_plan_t *plan, model_t *mdl, value_t b[]) {
+  evaluator_t eval;
+  int32_t code;
+
+  assert(mdl->terms == plan->terms);
+
+  init_evaluator(&eval, mdl);
+  code = execute_eval_plan(plan, &eval, plan->slot_value, b);
+  delete_evaluator(&eval);
+
+  return code;
+}
+
+
+/*
+ * Run a job in read-only mode
+ * - buffer = slot array for the thread that runs the job
+ */
+static void run_eval_plan_job(eval_plan_job_t *job, ivector_t *buffer) {
+  evaluator_t eval;
+
+  assert(job->model->terms == job->plan->terms);
+
+  resize_ivector(buffer, job->plan->nslots);
+  init_value_table_extension(&job->vtbl, &job->model->vtbl);
+  init_evaluator_readonly(&eval, job->model, &job->vtbl);
+  job->code = execute_eval_plan(job->plan, &eval, buffer->data, job->value);
+  delete_evaluator(&eval);
+}
+
+
+#ifdef THREAD_SAFE
+
+#include <pthread.h>
+
+/*
+ * Shared state for the worker threads:
+ * - lock: protects next
+ * - job = array of n jobs
+ * - next = index of the next job to run
+ */
+typedef struct eval_plan_jobs_s {
+  yices_lock_t lock;
+  eval_plan_job_t *job;
+  uint32_t n;
+  uint32_t next;
+} eval_plan_jobs_t;
+
+
+/*
+ * Thread body: run jobs until there are none left
+ */
+static void *eval_plan_worker(void *arg) {
+  eval_plan_jobs_t *jobs;
+  ivector_t buffer;
+  uint32_t i;
+
+  jobs = arg;
+  init_ivector(&buffer, 0);
+  for (;;) {
+    get_yices_lock(&jobs->lock);
+    i = jobs->next;
+    if (i < jobs->n) {
+      jobs->next ++;
+    }
+    release_yices_lock(&jobs->lock);
+
+    if (i >= jobs->n) break;
+    run_eval_plan_job(jobs->job + i, &buffer);
+  }
+  delete_ivector(&buffer);
+
+  return NULL;
+}
+
+
+void eval_plan_run_jobs(eval_plan_job_t *job, uint32_t n, uint32_t nthreads) {
+  eval_plan_jobs_t jobs;
+  pthread_t *tid;
+  uint32_t i;
+
+  if (n == 0) {
+    return;
+  }
+  if (nthreads == 0) {
+    nthreads = 1;
+  }
+  if (nthreads > n) {
+    nthreads = n;
+  }
+
+  create_yices_lock(&jobs.lock);
+  jobs.job = job;
+  jobs.n = n;
+  jobs.next = 0;
+
+  // the calling thread is the last worker
+  tid = (pthread_t *) safe_malloc(nthreads * sizeof(pthread_t));
+  for (i=0; i<nthreads-1; i++) {
+    if (pthread_create(tid + i, NULL, eval_plan_worker, &jobs) != 0) {
+      break;
+    }
+  }
+  nthreads = i;
+
+  eval_plan_worker(&jobs);
+
+  for (i=0; i<nthreads; i++) {
+    pthread_join(tid[i], NULL);
+  }
+
+  safe_free(tid);
+  destroy_yices_lock(&jobs.lock);
+}
+
+#else
+
+/*
+ * Sequential version: all jobs are run in the calling thread
+ */
+void eval_plan_run_jobs(eval_plan_job_t *job, uint32_t n, uint32_t nthreads) {
+  ivector_t buffer;
+  uint32_t i;
+
+  init_ivector(&buffer, 0);
+  for (i=0; i<n; i++) {
+    run_eval_plan_job(job + i, &buffer);
+  }
+  delete_ivector(&buffer);
+}
+
+#endif
+
+
+/*
+ * Mark all terms of plan
+ */
+void eval_plan_gc_mark(eval_plan_t *plan) {
+  term_table_t *terms;
+  uint32_t i, n;
+
+  terms = plan->terms;
+  n = plan->nroots;
+  for (i=0; i<n; i++) {
+    term_table_set_gc_mark(terms, index_of(plan->root[i]));
+  }
+  n = plan->nslots;
+  for (i=0; i<n; i++) {
+    term_table_set_gc_mark(terms, index_of(plan->slot_term[i]));
+    if (plan->slot_def[i] != NULL_TERM) {
+      term_table_set_gc_mark(terms, index_of(plan->slot_def[i]));
+    }
+  }
+}
@@ -0,0 +1,165 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * EVALUATION PLANS: EVALUATE THE SAME TERMS IN MANY MODELS
+ */
+
+/*
+ * An evaluation plan is built once for an array of terms a[0 ... n-1].
+ * It can then be used to compute the values of a[0 ... n-1] in any
+ * model (cf. eval_plan_values).
+ *
+ * The plan lists all the subterms of a[0 ... n-1] in topological order
+ * (children before parents) and gives each of them a slot. The slot
+ * index of a term is found by direct indexing in slot_map. When the
+ * plan is executed in a model, the evaluator stores the value of each
+ * subterm in its slot instead of a hash table (cf. model_eval.h) and
+ * the subterms are evaluated in order, so the evaluation of a term
+ * never recurses into its children.
+ *
+ * Constant folding: a ground subterm (i.e., a term that does not contain
+ * uninterpreted terms, variables, or operators whose value depends on
+ * the model such as division) has the same value in all models.
+ * The value of such a term is computed once when the plan is built,
+ * and stored as a constant term. The subterms of a folded term are not
+ * evaluated when the plan is executed.
+ *
+ * Data structures:
+ * - terms = the term table
+ * - nroots = number of input terms
+ * - root = array of nroots terms: the input terms
+ * - nslots = number of slots
+ * - slot_term[s] = term attached to slot s (a positive term)
+ * - slot_def[s] = term to evaluate to fill slot s:
+ *   slot_def[s] = slot_term[s] by default
+ *   slot_def[s] = constant term if slot_term[s] is folded
+ *   slot_def[s] = NULL_TERM if slot_term[s] does not need to be evaluated
+ * - slot_map = array of size map_size
+ *   slot_map[i] = slot of term index i or -1
+ * - slot_value = array of nslots values used during execution
+ */
+#ifndef __EVAL_PLANS_H
+#define __EVAL_PLANS_H
+
+#include <stdint.h>
+
+#include "model/models.h"
+#include "terms/terms.h"
+
+
+typedef struct eval_plan_s {
+  term_table_t *terms;
+  uint32_t nroots;
+  uint32_t nslots;
+  uint32_t map_size;
+  term_t *root;
+  term_t *slot_term;
+  term_t *slot_def;
+  int32_t *slot_map;
+  value_t *slot_value;
+} eval_plan_t;
+
+
+/*
+ * Build a plan for terms a[0 ... n-1]
+ * - terms = the term table where a[0 ... n-1] are defined
+ * - all terms in a must be valid
+ */
+extern void init_eval_plan(eval_plan_t *plan, term_table_t *terms, uint32_t n, const term_t a[]);
+
+
+/*
+ * Delete plan: free memory
+ */
+extern void delete_eval_plan(eval_plan_t *plan);
+
+
+/*
+ * Number of input terms and number of slots
+ */
+static inline uint32_t eval_plan_num_terms(eval_plan_t *plan) {
+  return plan->nroots;
+}
+
+static inline uint32_t eval_plan_num_slots(eval_plan_t *plan) {
+  return plan->nslots;
+}
+
+
+/*
+ * Compute the values of the input terms in mdl
+ * - mdl must use the same term table as the plan
+ * - the values are stored in b[0 ... n-1] where n = number of input terms
+ * - return 0 if all values were computed
+ * - return a negative error code (as in model_eval.h) otherwise: this is the
+ *   error code for the first input term a[i] that can't be evaluated.
+ *
+ * As in eval_in_model, evaluation may create new objects in mdl->vtbl.
+ */
+extern int32_t eval_plan_values(eval_plan_t *plan, model_t *mdl, value_t b[]);
+
+
+/*
+ * PARALLEL EVALUATION
+ *
+ * A job evaluates a plan in a model in read-only mode: the model is not
+ * modified and the values are stored in a scratch value table that
+ * extends the model's table (cf. init_value_table_extension). Several
+ * jobs can then run in parallel, even if they share a plan or a model.
+ *
+ * Each job is described by:
+ * - plan = the plan to execute
+ * - model = the model to use
+ * - value = array where the values of the plan's terms are stored
+ *   (its size must be at least eval_plan_num_terms(plan))
+ * - vtbl = scratch value table initialized by eval_plan_run_jobs
+ * - code = result: 0 or an error code as in eval_plan_values
+ */
+typedef struct eval_plan_job_s {
+  eval_plan_t *plan;
+  model_t *model;
+  value_t *value;
+  value_table_t vtbl;
+  int32_t code;
+} eval_plan_job_t;
+
+
+/*
+ * Run jobs job[0 ... n-1] using at most nthreads threads (at least one)
+ * - for each job, plan, model, and value must be set
+ * - on return, job[i].code is set and job[i].vtbl is initialized:
+ *   if job[i].code is 0, then job[i].value[0 ... k-1] are objects
+ *   of job[i].vtbl. The caller must delete job[i].vtbl.
+ *
+ * The calling thread is one of the workers. While jobs are running,
+ * the term table, the plans, and the models must not be modified.
+ *
+ * Parallel evaluation requires a thread-safe build. Otherwise, the
+ * jobs are run sequentially and nthreads is ignored.
+ */
+extern void eval_plan_run_jobs(eval_plan_job_t *job, uint32_t n, uint32_t nthreads);
+
+
+/*
+ * Prepare for garbage collection: mark all the terms used by plan
+ */
+extern void eval_plan_gc_mark(eval_plan_t *plan);
+
+
+#endif /* __EVAL_PLANS_H */
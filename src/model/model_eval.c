@@ -46,10 +46,35 @@ void init_evaluator(evaluator_t *eval, model_t *model) {
 
   init_int_hmap(&eval->cache, 0); // use the default hmap size
   init_istack(&eval->stack);
+  eval->slot_map = NULL;
+  eval->slot_value = NULL;
+  eval->slot_map_size = 0;
   // eval->env is not initialized
 }
 
 
+/*
+ * Read-only mode: use vtbl instead of the model's table
+ */
+void init_evaluator_readonly(evaluator_t *eval, model_t *model, value_table_t *vtbl) {
+  assert(vtbl->type_table == model->vtbl.type_table &&
+         vtbl->base_objects == model->vtbl.nobjects);
+
+  init_evaluator(eval, model);
+  eval->vtbl = vtbl;
+}
+
+
+/*
+ * Attach a slot table
+ */
+void evaluator_set_slots(evaluator_t *eval, const int32_t *map, uint32_t n, value_t *val) {
+  eval->slot_map = map;
+  eval->slot_value = val;
+  eval->slot_map_size = n;
+}
+
+
 /*
  * Delete caches and stack
  */
@@ -74,15 +99,39 @@ void reset_evaluator(evaluator_t *eval) {
 
 
 
+/*
+ * Slot of term t: -1 if t has no slot
+ */
+static inline int32_t eval_slot(evaluator_t *eval, term_t t) {
+  uint32_t i;
+
+  i = index_of(t);
+  return i < eval->slot_map_size ? eval->slot_map[i] : -1;
+}
+
+
 /*
  * Get the value mapped to term t in the internal cache
  * - return null_value if nothing is mapped to t
+ * - if t has a slot that records an evaluation error, raise the
+ *   error again
  */
 static value_t eval_cached_value(evaluator_t *eval, term_t t) {
   int_hmap_pair_t *r;
+  int32_t s;
+  value_t v;
 
   assert(good_term(eval->terms, t));
 
+  s = eval_slot(eval, t);
+  if (s >= 0) {
+    v = eval->slot_value[s];
+    if (v < null_value) {
+      longjmp(eval->env, v);
+    }
+    return v;
+  }
+
   r = int_hmap_find(&eval->cache, t);
   if (r == NULL) {
     return null_value;
@@ -98,9 +147,17 @@ static value_t eval_cached_value(evaluator_t *eval, term_t t) {
  */
 static void eval_cache_map(evaluator_t *eval, term_t t, value_t v) {
   int_hmap_pair_t *r;
+  int32_t s;
 
   assert(good_term(eval->terms, t) && good_object(eval->vtbl, v));
 
+  s = eval_slot(eval, t);
+  if (s >= 0) {
+    assert(eval->slot_value[s] == null_value);
+    eval->slot_value[s] = v;
+    return;
+  }
+
   r = int_hmap_get(&eval->cache, t);
   assert(r->val < 0);
   r->val = v;
@@ -1186,13 +1243,15 @@ static value_t eval_term(evaluator_t *eval, term_t t) {
   t = unsigned_term(t);
 
   /*
-   * First check the model itself then check the cache.
+   * First check the cache then check the model itself.
    * If no value is mapped to t in either of them, compute t's
    * value v and add the mapping t := v to the cache.
+   * (A term that has a value in the model is never computed, so
+   * the order of the two lookups does not matter.)
    */
-  v = model_find_term_value(eval->model, t);
+  v = eval_cached_value(eval, t);
   if (v == null_value) {
-    v = eval_cached_value(eval, t);
+    v = model_find_term_value(eval->model, t);
     if (v == null_value) {
       terms = eval->terms;
 
@@ -56,6 +56,12 @@ enum {
  * - cache: keeps track of the value of evaluated terms
  * - env: jump buffer for error handling
  * - stack of integer arrays
+ * - optional slot table (used by evaluation plans, cf. eval_plans.h):
+ *   slot_map[i] = slot for the term of index i, or -1 if the term has no slot,
+ *   for 0 <= i < slot_map_size. The value of a term that has a slot s
+ *   is stored in slot_value[s] instead of the cache. slot_value[s] is
+ *   null_value if the term hasn't been evaluated yet, and an error code
+ *   if its evaluation failed.
  */
 typedef struct evaluator_s {
   model_t *model;
@@ -63,6 +69,9 @@ typedef struct evaluator_s {
   value_table_t *vtbl;
   int_hmap_t cache;
   int_stack_t stack;
+  const int32_t *slot_map;
+  value_t *slot_value;
+  uint32_t slot_map_size;
   jmp_buf env;
 } evaluator_t;
 
@@ -74,10 +83,24 @@ typedef struct evaluator_s {
  *
  * NOTE: because the evaluator has side effects on model->vtbl,
  * we can't attach several evaluators to the same model.
+ * Use read-only evaluators for this (see below).
  */
 extern void init_evaluator(evaluator_t *eval, model_t *model);
 
 
+/*
+ * Read-only evaluator for the given model
+ * - vtbl must be an extension of model->vtbl (cf. init_value_table_extension)
+ * - all objects created during evaluation are stored in vtbl, and the
+ *   values returned by eval_in_model are objects of vtbl
+ *
+ * The model is not modified. So several read-only evaluators can be
+ * attached to the same model (and used in different threads) as long
+ * as each evaluator has its own extension table.
+ */
+extern void init_evaluator_readonly(evaluator_t *eval, model_t *model, value_table_t *vtbl);
+
+
 /*
  * Deletion: free all memory
  */
@@ -90,11 +113,22 @@ extern void delete_evaluator(evaluator_t *eval);
 extern void reset_evaluator(evaluator_t *eval);
 
 
+/*
+ * Attach a slot table to the evaluator
+ * - map = array of size n: map[i] = slot of the term of index i or -1
+ * - val = array of slot values: val[map[i]] must be initialized to
+ *   null_value or to the value of term i.
+ * The arrays are not copied.
+ */
+extern void evaluator_set_slots(evaluator_t *eval, const int32_t *map, uint32_t n, value_t *val);
+
+
 /*
  * Compute the value of term t in the model
  * - t must be a valid term
  * - return a negative code if there's an error
- * - return the id of a concrete objects of eval->model.vtbl otherwise
+ * - return the id of a concrete objects of eval->vtbl otherwise
+ *   (i.e., model->vtbl or the extension table of a read-only evaluator)
  *
  * Evaluation may create new objects. All these new objects are
  * permanent in eval->vtbl. So they survive a call to delete_evaluator
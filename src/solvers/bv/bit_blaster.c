@@ -24,6 +24,7 @@
 
 #include "solvers/bv/bit_blaster.h"
 #include "utils/int_array_sort.h"
+#include "utils/memalloc.h"
 
 
 
@@ -434,6 +435,122 @@ static uint32_t cbuffer_nvars(cbuffer_t *buffer) {
 }
 
 
+/**********************
+ *  DEFINITION TABLE  *
+ *********************/
+
+/*
+ * Initialize: the def array is allocated on the first call to bdef_table_set
+ */
+static void init_bdef_table(bdef_table_t *table) {
+  table->def = NULL;
+  table->size = 0;
+  init_ivector(&table->vars, 0);
+  init_ivector(&table->levels, 0);
+}
+
+static void delete_bdef_table(bdef_table_t *table) {
+  safe_free(table->def);
+  table->def = NULL;
+  delete_ivector(&table->vars);
+  delete_ivector(&table->levels);
+}
+
+/*
+ * Remove the definitions of vars[k ... ]
+ */
+static void bdef_table_remove_defs(bdef_table_t *table, uint32_t k) {
+  uint32_t i, n;
+  bvar_t x;
+
+  n = table->vars.size;
+  for (i=k; i<n; i++) {
+    x = table->vars.data[i];
+    assert(x < table->size);
+    table->def[x].lit[0] = null_literal;
+  }
+  ivector_shrink(&table->vars, k);
+}
+
+static void reset_bdef_table(bdef_table_t *table) {
+  bdef_table_remove_defs(table, 0);
+  ivector_reset(&table->levels);
+}
+
+static void bdef_table_push(bdef_table_t *table) {
+  ivector_push(&table->levels, table->vars.size);
+}
+
+static void bdef_table_pop(bdef_table_t *table) {
+  uint32_t k;
+
+  assert(table->levels.size > 0);
+  k = ivector_pop2(&table->levels);
+  bdef_table_remove_defs(table, k);
+}
+
+
+/*
+ * Make the def array large enough to store def[x]
+ */
+static void bdef_table_resize(bdef_table_t *table, bvar_t x) {
+  uint32_t i, n;
+
+  n = table->size;
+  if (x >= n) {
+    if (n == 0) {
+      n = DEF_BDEF_TABLE_SIZE;
+    } else {
+      n += n >> 1;
+    }
+    if (n <= x) {
+      n = x + 1;
+    }
+    if (n > MAX_BDEF_TABLE_SIZE) {
+      out_of_memory();
+    }
+    table->def = (bdef_t *) safe_realloc(table->def, n * sizeof(bdef_t));
+    for (i=table->size; i<n; i++) {
+      table->def[i].lit[0] = null_literal;
+    }
+    table->size = n;
+  }
+}
+
+
+/*
+ * Record pos_lit(x) = (op a b)
+ */
+static void bdef_table_set(bdef_table_t *table, bvar_t x, gate_op_t op, literal_t a, literal_t b) {
+  bdef_table_resize(table, x);
+  assert(table->def[x].lit[0] == null_literal);
+  table->def[x].op = op;
+  table->def[x].lit[0] = a;
+  table->def[x].lit[1] = b;
+  ivector_push(&table->vars, x);
+}
+
+
+/*
+ * Get the definition of var_of(l) if it's a gate of type op
+ * - return NULL if var_of(l) has no such definition
+ */
+static bdef_t *bdef_table_get(bdef_table_t *table, literal_t l, gate_op_t op) {
+  bdef_t *d;
+  bvar_t x;
+
+  x = var_of(l);
+  if (x < table->size) {
+    d = table->def + x;
+    if (d->lit[0] != null_literal && d->op == op) {
+      return d;
+    }
+  }
+  return NULL;
+}
+
+
+
 /*****************
  *  BIT BLASTER  *
  ****************/
@@ -447,6 +564,7 @@ void init_bit_blaster(bit_blaster_t *s, smt_core_t *solver, remap_table_t *remap
   s->solver = solver;
   s->remap = remap;
   init_gate_table(&s->htbl);
+  init_bdef_table(&s->defs);
   init_cbuffer(&s->buffer);
   init_ivector(&s->aux_vector, 0);
   init_ivector(&s->aux_vector2, 0);
@@ -464,6 +582,7 @@ void init_bit_blaster(bit_blaster_t *s, smt_core_t *solver, remap_table_t *remap
 void delete_bit_blaster(bit_blaster_t *s) {
   s->solver = NULL;
   delete_gate_table(&s->htbl);
+  delete_bdef_table(&s->defs);
   delete_ivector(&s->aux_vector);
   delete_ivector(&s->aux_vector2);
   delete_ivector(&s->aux_vector3);
@@ -476,6 +595,7 @@ void delete_bit_blaster(bit_blaster_t *s) {
  */
 void reset_bit_blaster(bit_blaster_t *s) {
   reset_gate_table(&s->htbl);
+  reset_bdef_table(&s->defs);
   reset_cbuffer(&s->buffer);
   ivector_reset(&s->aux_vector);
   ivector_reset(&s->aux_vector2);
@@ -484,6 +604,32 @@ void reset_bit_blaster(bit_blaster_t *s) {
 }
 
 
+/*
+ * Push/pop
+ */
+void bit_blaster_push(bit_blaster_t *s) {
+  gate_table_push(&s->htbl);
+  bdef_table_push(&s->defs);
+}
+
+void bit_blaster_pop(bit_blaster_t *s) {
+  gate_table_pop(&s->htbl);
+  bdef_table_pop(&s->defs);
+}
+
+
+/*
+ * Set level: same effect as calling push n times
+ */
+void bit_blaster_set_level(bit_blaster_t *s, uint32_t n) {
+  gate_table_set_level(&s->htbl, n);
+  while (n > 0) {
+    bdef_table_push(&s->defs);
+    n --;
+  }
+}
+
+
 
 
 
@@ -1672,6 +1818,180 @@ literal_t bit_blaster_eval_bveq(bit_blaster_t *s, uint32_t n, literal_t *a, lite
 
 
 
+/*************************
+ *  TWO-LEVEL REWRITING  *
+ ************************/
+
+/*
+ * The rewrite functions below replace an argument of a binary gate by
+ * an input of its definition. The inputs of a gate are created before
+ * its output, so each such step decreases the variable index of an
+ * argument. This ensures termination.
+ */
+
+/*
+ * Rewrite (or x y) using the definition of x:
+ * - if x is (or p q):
+ *     (or x p) --> x
+ *     (or x (not p)) --> true
+ * - if x is (not (or p q)) = (and (not p) (not q)):
+ *     (or x (not p)) --> (not p)
+ *     (or x p) --> (or (not q) p)
+ * Return the result if (or x y) reduces to a literal. Otherwise
+ * return null_literal and store in *nx a literal such that
+ * (or *nx y) is equivalent to (or x y).
+ */
+static literal_t rewrite_or_def(bit_blaster_t *s, literal_t x, literal_t y, literal_t *nx) {
+  bdef_t *d;
+  literal_t p, q;
+
+  d = bdef_table_get(&s->defs, x, OR_GATE);
+  if (d != NULL) {
+    p = d->lit[0];
+    q = d->lit[1];
+    if (is_pos(x)) {
+      if (y == p || y == q) return x;
+      if (y == not(p) || y == not(q)) return true_literal;
+    } else {
+      if (y == not(p) || y == not(q)) return y;
+      if (y == p) {
+        *nx = not(q);
+      } else if (y == q) {
+        *nx = not(p);
+      }
+    }
+  }
+
+  return null_literal;
+}
+
+
+/*
+ * Resolution: if x is (and (not p) (not q)) and y is (and p (not q))
+ * then (or x y) is (not q).
+ * - return null_literal if this rule does not apply
+ */
+static literal_t rewrite_or_resolve(bit_blaster_t *s, literal_t x, literal_t y) {
+  bdef_t *dx, *dy;
+  literal_t p, q, r, t;
+
+  if (is_pos(x) || is_pos(y)) return null_literal;
+
+  dx = bdef_table_get(&s->defs, x, OR_GATE);
+  dy = bdef_table_get(&s->defs, y, OR_GATE);
+  if (dx == NULL || dy == NULL) return null_literal;
+
+  p = dx->lit[0];
+  q = dx->lit[1];
+  r = dy->lit[0];
+  t = dy->lit[1];
+  if ((p == r && q == not(t)) || (p == t && q == not(r))) return not(p);
+  if ((q == r && p == not(t)) || (q == t && p == not(r))) return not(q);
+
+  return null_literal;
+}
+
+
+/*
+ * Rewrite (or *a *b)
+ * - return the result if that reduces to a literal
+ * - otherwise return null_literal and replace *a and *b by
+ *   equivalent arguments
+ */
+static literal_t rewrite_or2(bit_blaster_t *s, literal_t *a, literal_t *b) {
+  literal_t l, x, y, nx, ny;
+
+  x = *a;
+  y = *b;
+  for (;;) {
+    l = bit_blaster_eval_or2(s, x, y);
+    if (l != null_literal) return l;
+
+    nx = x;
+    l = rewrite_or_def(s, x, y, &nx);
+    if (l != null_literal) return l;
+    ny = y;
+    l = rewrite_or_def(s, y, x, &ny);
+    if (l != null_literal) return l;
+
+    if (nx == x && ny == y) break;
+    x = nx;
+    y = ny;
+  }
+
+  l = rewrite_or_resolve(s, x, y);
+  if (l == null_literal && x > y) {
+    // normalize: ensure x < y
+    l = x; x = y; y = l;
+    l = null_literal;
+  }
+  *a = x;
+  *b = y;
+
+  return l;
+}
+
+
+/*
+ * Rewrite (xor *a *b)
+ * - *a and *b must be positive literals
+ * - if x is (xor p q) then (xor x p) --> q
+ * - if x is (xor p q) and y is (xor p r) then (xor x y) --> (xor q r)
+ * - return the result if that reduces to a literal
+ * - otherwise return null_literal and replace *a and *b by equivalent
+ *   positive literals with *a < *b
+ */
+static literal_t rewrite_xor2(bit_blaster_t *s, literal_t *a, literal_t *b) {
+  bdef_t *dx, *dy;
+  literal_t l, x, y, p, q;
+
+  x = *a;
+  y = *b;
+  for (;;) {
+    assert(is_pos(x) && is_pos(y));
+    l = bit_blaster_eval_xor2(s, x, y);
+    if (l != null_literal) return l;
+
+    dx = bdef_table_get(&s->defs, x, XOR_GATE);
+    if (dx != NULL) {
+      if (y == dx->lit[0]) return dx->lit[1];
+      if (y == dx->lit[1]) return dx->lit[0];
+    }
+    dy = bdef_table_get(&s->defs, y, XOR_GATE);
+    if (dy != NULL) {
+      if (x == dy->lit[0]) return dy->lit[1];
+      if (x == dy->lit[1]) return dy->lit[0];
+    }
+    if (dx == NULL || dy == NULL) break;
+
+    // search for a common input
+    p = dx->lit[0];
+    q = dx->lit[1];
+    if (p == dy->lit[0]) {
+      x = q; y = dy->lit[1];
+    } else if (p == dy->lit[1]) {
+      x = q; y = dy->lit[0];
+    } else if (q == dy->lit[0]) {
+      x = p; y = dy->lit[1];
+    } else if (q == dy->lit[1]) {
+      x = p; y = dy->lit[0];
+    } else {
+      break;
+    }
+  }
+
+  if (x > y) {
+    l = x; x = y; y = l;
+  }
+  *a = x;
+  *b = y;
+
+  return null_literal;
+}
+
+
+
+
 /************************
  *  GATE CONSTRUCTION   *
  ***********************/
@@ -1717,6 +2037,11 @@ literal_t bit_blaster_make_or(bit_blaster_t *s, uint32_t n, literal_t *a) {
   if (n == 0) return false_literal;
   if (n == 1) return v->data[0];
 
+  if (n == 2) {
+    l = rewrite_or2(s, v->data, v->data + 1);
+    if (l != null_literal) return l;
+  }
+
   if (n <= BIT_BLASTER_MAX_HASHCONS_SIZE) {
     g = gate_table_get_or(&s->htbl, n, v->data);
     l = g->lit[n];  // output literal for an or gate
@@ -1724,6 +2049,9 @@ literal_t bit_blaster_make_or(bit_blaster_t *s, uint32_t n, literal_t *a) {
       // this is a new gate
       l = bit_blaster_create_or(s, v);
       g->lit[n] = l;
+      if (n == 2) {
+        bdef_table_set(&s->defs, var_of(l), OR_GATE, g->lit[0], g->lit[1]);
+      }
     }
   } else {
     // No hash consing
@@ -1777,6 +2105,11 @@ literal_t bit_blaster_make_xor(bit_blaster_t *s, uint32_t n, literal_t *a) {
   if (n == 0) return false_literal ^ sgn;  // i.e., sgn = 1 --> true_literal
   if (n == 1) return v->data[0] ^ sgn;     // i.e., sgn = 1 --> not v[0]
 
+  if (n == 2) {
+    l = rewrite_xor2(s, v->data, v->data + 1);
+    if (l != null_literal) return l ^ sgn;
+  }
+
   if (n <= BIT_BLASTER_MAX_HASHCONS_SIZE) {
     /*
      * Check the hash table
@@ -1787,6 +2120,9 @@ literal_t bit_blaster_make_xor(bit_blaster_t *s, uint32_t n, literal_t *a) {
       // new XOR gate
       l = bit_blaster_create_xor(s, n, v->data);
       g->lit[n] = l;
+      if (n == 2) {
+        bdef_table_set(&s->defs, var_of(l), XOR_GATE, g->lit[0], g->lit[1]);
+      }
     }
   } else {
     // no hash consing
@@ -2823,18 +3159,16 @@ static literal_t make_and2(bit_blaster_t *s, literal_t a, literal_t b) {
    */
   a = not(a);
   b = not(b);
-  l = bit_blaster_eval_or2(s, a, b);
+  l = rewrite_or2(s, &a, &b); // this normalizes a and b
   if (l == null_literal) {
-    // normalize
-    if (a > b) {
-      l = a; a = b; b = l;
-    }
+    assert(a < b);
     g = gate_table_get_or2(&s->htbl, a, b);
     l = g->lit[2]; // output literal of (or a b);
     if (l == null_literal) {
       // new gate
       l = bit_blaster_fresh_literal(s);
       g->lit[2] = l;
+      bdef_table_set(&s->defs, var_of(l), OR_GATE, a, b);
       bit_blaster_or2_gate(s, a, b, l);
     }
   }
@@ -79,6 +79,38 @@ typedef struct cbuffer_s {
 
 
 
+/*
+ * GATE DEFINITIONS
+ *
+ * The gate table maps gates to their output. For two-level rewriting,
+ * we also need the reverse map: given a literal l, is l the output of
+ * a gate and what are the gate's inputs? This is stored in a
+ * definition table for the binary OR and XOR gates:
+ * - def[x] = definition of variable x: if lit[0] is null_literal,
+ *   x has no definition, otherwise pos_lit(x) = (op lit[0] lit[1])
+ *   where op is OR_GATE or XOR_GATE
+ * - size = size of the def array
+ * - vars = variables with a definition in creation order
+ * - levels = stack for push/pop: levels.data[k] = number of elements
+ *   in vars when level k+1 was entered
+ */
+typedef struct bdef_s {
+  gate_op_t op;
+  literal_t lit[2];
+} bdef_t;
+
+typedef struct bdef_table_s {
+  bdef_t *def;
+  uint32_t size;
+  ivector_t vars;
+  ivector_t levels;
+} bdef_table_t;
+
+#define DEF_BDEF_TABLE_SIZE 100
+#define MAX_BDEF_TABLE_SIZE (UINT32_MAX/sizeof(bdef_t))
+
+
+
 /*
  * BIT-BLASTER:
  *
@@ -90,12 +122,14 @@ typedef struct cbuffer_s {
  *   where the clauses and literals are created
  * - remap_table to interface with the bvsolver
  * - gate table for hash consing
+ * - definition table for rewriting
  * - buffers
  */
 typedef struct bit_blaster_s {
   smt_core_t *solver;
   remap_table_t *remap;
   gate_table_t htbl;
+  bdef_table_t defs;
   cbuffer_t buffer;
   ivector_t aux_vector;
   ivector_t aux_vector2;
@@ -144,15 +178,10 @@ extern void reset_bit_blaster(bit_blaster_t *blaster);
 
 
 /*
- * Push/pop just apply to the internal gate table
+ * Push/pop apply to the internal gate table and definitions
  */
-static inline void bit_blaster_push(bit_blaster_t *blaster) {
-  gate_table_push(&blaster->htbl);
-}
-
-static inline void bit_blaster_pop(bit_blaster_t *blaster) {
-  gate_table_pop(&blaster->htbl);
-}
+extern void bit_blaster_push(bit_blaster_t *blaster);
+extern void bit_blaster_pop(bit_blaster_t *blaster);
 
 
 /*
@@ -160,9 +189,7 @@ static inline void bit_blaster_pop(bit_blaster_t *blaster) {
  * - this is used to ensure that the bit-blaster trail stack
  *   has the same depth as the bv_solver when the bit_blaster is allocated
  */
-static inline void bit_blaster_set_level(bit_blaster_t *blaster, uint32_t n) {
-  gate_table_set_level(&blaster->htbl, n);
-}
+extern void bit_blaster_set_level(bit_blaster_t *blaster, uint32_t n);
 
 
 
@@ -382,6 +409,14 @@ static inline literal_t bit_blaster_fresh_literal(bit_blaster_t *blaster) {
  * 3) If that fails create a fresh literal l, assert
  *    the constraints l = (op a b ...) and add the gate to
  *    the hash table.
+ *
+ * For binary gates, step 1 also looks one level down: if a or b
+ * is the output of a binary OR or XOR gate, the two-level term is
+ * rewritten when possible. For example:
+ *   (or a (and a c))        --> a
+ *   (or a (and (not a) c))  --> (or a c)
+ *   (or (and a c) (and (not a) c)) --> c
+ *   (xor a (xor a c))       --> c
  */
 
 /*
@@ -436,9 +436,10 @@ static void init_bv_trail(bv_trail_stack_t *stack) {
  * - ndm = number of delayed mapped variables
  * - ndb = number of delayed blasted variables
  * - bb = bitblast pointer
+ * - nl = size of the lazy queue
  */
 static void bv_trail_save(bv_trail_stack_t *stack, uint32_t nv, uint32_t na, uint32_t nb,
-                          uint32_t ns, uint32_t ndm, uint32_t ndb, uint32_t bb) {
+                          uint32_t ns, uint32_t ndm, uint32_t ndb, uint32_t bb, uint32_t nl) {
   uint32_t i, n;
 
   i = stack->top;
@@ -465,6 +466,7 @@ static void bv_trail_save(bv_trail_stack_t *stack, uint32_t nv, uint32_t na, uin
   stack->data[i].ndelayed_mapped = ndm;
   stack->data[i].ndelayed_blasted = ndb;
   stack->data[i].nbblasted = bb;
+  stack->data[i].nlazy = nl;
 
   stack->top = i+1;
 }
@@ -522,6 +524,10 @@ static void init_bv_stats(bv_stats_t *s) {
   s->equiv_conflicts = 0;
   s->half_equiv_lemmas = 0;
   s->interface_lemmas = 0;
+  s->lazy_ops = 0;
+  s->lazy_refinements = 0;
+  s->bound_props = 0;
+  s->bound_conflicts = 0;
 }
 
 static inline void reset_bv_stats(bv_stats_t *s) {
@@ -694,6 +700,270 @@ static void bv_solver_set_map(bv_solver_t *solver, thvar_t x, literal_t *m) {
 
 
 
+/****************
+ *  LAZY QUEUE  *
+ ***************/
+
+static inline void init_bv_lazy_queue(bv_lazy_queue_t *queue) {
+  queue->data = NULL;
+  queue->size = 0;
+  queue->top = 0;
+}
+
+static void bv_lazy_queue_extend(bv_lazy_queue_t *queue) {
+  uint32_t n;
+
+  n = queue->size;
+  if (n == 0) {
+    n = DEF_BV_LAZY_QUEUE_SIZE;
+    assert(n > 0 && n <= MAX_BV_LAZY_QUEUE_SIZE && queue->data == NULL);
+  } else {
+    n += (n >> 1);
+    assert(n > queue->size);
+    if (n > MAX_BV_LAZY_QUEUE_SIZE) {
+      out_of_memory();
+    }
+  }
+
+  queue->data = (bv_lazy_op_t *) safe_realloc(queue->data, n * sizeof(bv_lazy_op_t));
+  queue->size = n;
+}
+
+/*
+ * Add x to the queue: x is not refined
+ */
+static void bv_lazy_queue_push(bv_lazy_queue_t *queue, thvar_t x) {
+  uint32_t i;
+
+  i = queue->top;
+  if (i == queue->size) {
+    bv_lazy_queue_extend(queue);
+  }
+  assert(i < queue->size);
+  queue->data[i].var = x;
+  queue->data[i].level = -1;
+  queue->top = i + 1;
+}
+
+/*
+ * Backtrack to base level k
+ * - n = size of the queue at the corresponding push
+ * - the variables refined at a base level larger than k are no
+ *   longer refined
+ */
+static void bv_lazy_queue_pop(bv_lazy_queue_t *queue, uint32_t n, uint32_t k) {
+  uint32_t i;
+
+  assert(n <= queue->top);
+
+  queue->top = n;
+  for (i=0; i<n; i++) {
+    if (queue->data[i].level > (int32_t) k) {
+      queue->data[i].level = -1;
+    }
+  }
+}
+
+static inline void reset_bv_lazy_queue(bv_lazy_queue_t *queue) {
+  queue->top = 0;
+}
+
+static void delete_bv_lazy_queue(bv_lazy_queue_t *queue) {
+  safe_free(queue->data);
+  queue->data = NULL;
+}
+
+
+
+
+/*****************************
+ *  WORD-LEVEL PROPAGATOR    *
+ ****************************/
+
+static void init_bv_wprop(bv_wprop_t *prop) {
+  prop->bound = NULL;
+  prop->nbounds = 0;
+  prop->bsize = 0;
+  prop->map = NULL;
+  prop->map_size = 0;
+  init_ivector(&prop->atom, 0);
+  init_ivector(&prop->queue, 0);
+  prop->trail = NULL;
+  prop->trail_top = 0;
+  prop->trail_size = 0;
+  init_ivector(&prop->marks, 0);
+  prop->ready = false;
+}
+
+static void delete_bv_wprop(bv_wprop_t *prop) {
+  safe_free(prop->bound);
+  safe_free(prop->map);
+  safe_free(prop->trail);
+  prop->bound = NULL;
+  prop->map = NULL;
+  prop->trail = NULL;
+  delete_ivector(&prop->atom);
+  delete_ivector(&prop->queue);
+  delete_ivector(&prop->marks);
+}
+
+/*
+ * Empty the propagator: it must be rebuilt before it's used again
+ */
+static void reset_bv_wprop(bv_wprop_t *prop) {
+  prop->nbounds = 0;
+  ivector_reset(&prop->atom);
+  ivector_reset(&prop->queue);
+  prop->trail_top = 0;
+  ivector_reset(&prop->marks);
+  prop->ready = false;
+}
+
+/*
+ * Make the map large enough for variables 0 ... n-1 and clear it
+ */
+static void bv_wprop_init_map(bv_wprop_t *prop, uint32_t n) {
+  uint32_t i;
+
+  if (n > prop->map_size) {
+    if (n > MAX_BV_WPROP_MAP_SIZE) {
+      out_of_memory();
+    }
+    prop->map = (int32_t *) safe_realloc(prop->map, n * sizeof(int32_t));
+    prop->map_size = n;
+  }
+  for (i=0; i<prop->map_size; i++) {
+    prop->map[i] = -1;
+  }
+}
+
+static void bv_wprop_extend(bv_wprop_t *prop) {
+  uint32_t n;
+
+  n = prop->bsize;
+  if (n == 0) {
+    n = DEF_BV_WPROP_SIZE;
+    assert(n > 0 && n <= MAX_BV_WPROP_SIZE && prop->bound == NULL);
+  } else {
+    n += (n >> 1);
+    assert(n > prop->bsize);
+    if (n > MAX_BV_WPROP_SIZE) {
+      out_of_memory();
+    }
+  }
+
+  prop->bound = (bv_wbound_t *) safe_realloc(prop->bound, n * sizeof(bv_wbound_t));
+  prop->bsize = n;
+}
+
+/*
+ * Add a descriptor for variable x with initial interval [low, high]
+ * - nbits = number of bits in x
+ * - x must not have a descriptor already
+ * - return the descriptor index
+ */
+static int32_t bv_wprop_add_var(bv_wprop_t *prop, thvar_t x, uint32_t nbits, uint64_t low, uint64_t high) {
+  bv_wbound_t *b;
+  uint32_t i;
+
+  assert(0 <= x && x < prop->map_size && prop->map[x] < 0);
+
+  i = prop->nbounds;
+  if (i == prop->bsize) {
+    bv_wprop_extend(prop);
+  }
+  assert(i < prop->bsize);
+  b = prop->bound + i;
+  b->var = x;
+  b->nbits = nbits;
+  b->start = 0;
+  b->end = 0;
+  b->low = low;
+  b->high = high;
+  b->low_expl = null_literal;
+  b->high_expl = null_literal;
+  prop->nbounds = i + 1;
+  prop->map[x] = i;
+
+  return i;
+}
+
+static void bv_wprop_extend_trail(bv_wprop_t *prop) {
+  uint32_t n;
+
+  n = prop->trail_size;
+  if (n == 0) {
+    n = DEF_BV_WTRAIL_SIZE;
+    assert(n > 0 && n <= MAX_BV_WTRAIL_SIZE && prop->trail == NULL);
+  } else {
+    n += (n >> 1);
+    assert(n > prop->trail_size);
+    if (n > MAX_BV_WTRAIL_SIZE) {
+      out_of_memory();
+    }
+  }
+
+  prop->trail = (bv_wsaved_t *) safe_realloc(prop->trail, n * sizeof(bv_wsaved_t));
+  prop->trail_size = n;
+}
+
+/*
+ * Save the bounds of descriptor i on the trail
+ */
+static void bv_wprop_save(bv_wprop_t *prop, uint32_t i) {
+  bv_wsaved_t *s;
+  bv_wbound_t *b;
+  uint32_t k;
+
+  assert(i < prop->nbounds);
+
+  k = prop->trail_top;
+  if (k == prop->trail_size) {
+    bv_wprop_extend_trail(prop);
+  }
+  assert(k < prop->trail_size);
+  b = prop->bound + i;
+  s = prop->trail + k;
+  s->idx = i;
+  s->low = b->low;
+  s->high = b->high;
+  s->low_expl = b->low_expl;
+  s->high_expl = b->high_expl;
+  prop->trail_top = k + 1;
+}
+
+/*
+ * Backtrack: keep the marks for the first k decision levels above the
+ * base level and restore the bounds saved at higher levels
+ */
+static void bv_wprop_backtrack(bv_wprop_t *prop, uint32_t k) {
+  bv_wsaved_t *s;
+  bv_wbound_t *b;
+  uint32_t n, top;
+
+  ivector_reset(&prop->queue);
+  if (prop->marks.size <= k) return;
+
+  n = prop->marks.data[k];
+  ivector_shrink(&prop->marks, k);
+
+  top = prop->trail_top;
+  assert(n <= top);
+  while (top > n) {
+    top --;
+    s = prop->trail + top;
+    b = prop->bound + s->idx;
+    b->low = s->low;
+    b->high = s->high;
+    b->low_expl = s->low_expl;
+    b->high_expl = s->high_expl;
+  }
+  prop->trail_top = n;
+}
+
+
+
+
 /*****************
  *  BIT EXTRACT  *
  ****************/
@@ -1460,9 +1730,75 @@ static void collect_bvvar_literals(bv_solver_t *solver, thvar_t x, ivector_t *v)
 
 
 
+/*
+ * Check whether x must be abstracted (in lazy mode)
+ * - x must be (op y z) where op is one of mul/div/rem/smod
+ * - x must have at least BV_LAZY_MIN_BITSIZE bits
+ * - y and z must not be constants (if one of them is, the
+ *   bit-blaster can simplify the circuit a lot)
+ */
+static bool bv_solver_lazy_op(bv_solver_t *solver, thvar_t x) {
+  bv_vartable_t *vtbl;
+  thvar_t y;
+  uint32_t i;
+
+  vtbl = &solver->vtbl;
+
+  if (! solver->lazy || bvvar_bitsize(vtbl, x) < BV_LAZY_MIN_BITSIZE) {
+    return false;
+  }
+
+  switch (bvvar_tag(vtbl, x)) {
+  case BVTAG_MUL:
+  case BVTAG_UDIV:
+  case BVTAG_UREM:
+  case BVTAG_SDIV:
+  case BVTAG_SREM:
+  case BVTAG_SMOD:
+    for (i=0; i<2; i++) {
+      y = mtbl_get_root(&solver->mtbl, vtbl->def[x].op[i]);
+      if (bvvar_tag(vtbl, y) == BVTAG_CONST64 || bvvar_tag(vtbl, y) == BVTAG_CONST) {
+        return false;
+      }
+    }
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * Abstract x: treat x as a variable
+ * - u = pseudo map of x
+ * - n = number of bits
+ * - x is added to the lazy queue
+ */
+static void bv_solver_abstract_op(bv_solver_t *solver, thvar_t x, literal_t *u, uint32_t n) {
+  remap_table_t *rmap;
+  uint32_t i;
+  literal_t l;
+
+  rmap = solver->remap;
+  for (i=0; i<n; i++) {
+    l = remap_table_find(rmap, u[i]);
+    if (l == null_literal) {
+      l = bit_blaster_fresh_literal(solver->blaster);
+      remap_table_assign(rmap, u[i], l);
+    }
+  }
+
+  bv_lazy_queue_push(&solver->lazy_queue, x);
+  solver->stats.lazy_ops ++;
+}
+
+
 /*
  * Recursive bit-blasting:
  * - if x is bitblasted already: do nothing
+ * - in lazy mode, expensive operators are abstracted
+ *   (cf. bv_solver_lazy_op)
  */
 static void bv_solver_bitblast_variable(bv_solver_t *solver, thvar_t x) {
   bv_vartable_t *vtbl;
@@ -1570,6 +1906,10 @@ static void bv_solver_bitblast_variable(bv_solver_t *solver, thvar_t x) {
         z = vtbl->def[x].op[1];
         bv_solver_bitblast_variable(solver, y);
         bv_solver_bitblast_variable(solver, z);
+        if (bv_solver_lazy_op(solver, x)) {
+          bv_solver_abstract_op(solver, x, u, n);
+          break;
+        }
         a = &solver->a_vector;
         b = &solver->b_vector;
         collect_bvvar_literals(solver, y, a);
@@ -1589,6 +1929,10 @@ static void bv_solver_bitblast_variable(bv_solver_t *solver, thvar_t x) {
         z = vtbl->def[x].op[1];
         bv_solver_bitblast_variable(solver, y);
         bv_solver_bitblast_variable(solver, z);
+        if (bv_solver_lazy_op(solver, x)) {
+          bv_solver_abstract_op(solver, x, u, n);
+          break;
+        }
         a = &solver->a_vector;
         b = &solver->b_vector;
         collect_bvvar_literals(solver, y, a);
@@ -6746,6 +7090,492 @@ thvar_t bv_solver_create_on_the_fly_var(bv_solver_t *solver, uint32_t n) {
 
 
 
+/***********************
+ *  LAZY BIT-BLASTING  *
+ **********************/
+
+static bool get_bitblasted_var_value(bv_solver_t *solver, thvar_t x, uint32_t *c);
+
+/*
+ * Check whether x = (op y z) holds in the current assignment
+ * - x, y, and z must be bitblasted
+ * - return false if the value of x is not (op val(y) val(z))
+ *   or if some bits are not assigned
+ */
+static bool bv_solver_lazy_op_holds(bv_solver_t *solver, thvar_t x) {
+  bv_vartable_t *vtbl;
+  uint32_t aux[16];
+  uint32_t *a, *b, *c, *d;
+  uint32_t n, k;
+  bvvar_tag_t op;
+  bool holds;
+
+  vtbl = &solver->vtbl;
+  op = bvvar_tag(vtbl, x);
+  n = bvvar_bitsize(vtbl, x);
+  k = (n + 31) >> 5;
+
+  a = aux;
+  if (k > 4) {
+    a = (uint32_t *) safe_malloc(4 * k * sizeof(uint32_t));
+  }
+  b = a + k;
+  c = b + k;
+  d = c + k;
+
+  holds = get_bitblasted_var_value(solver, vtbl->def[x].op[0], a)
+    && get_bitblasted_var_value(solver, vtbl->def[x].op[1], b)
+    && get_bitblasted_var_value(solver, x, d);
+
+  if (holds) {
+    switch (op) {
+    case BVTAG_MUL:
+      bvconst_mul2(c, k, a, b);
+      break;
+
+    case BVTAG_UDIV:
+      bvconst_udiv2z(c, n, a, b);
+      break;
+
+    case BVTAG_UREM:
+      bvconst_urem2z(c, n, a, b);
+      break;
+
+    case BVTAG_SDIV:
+      bvconst_sdiv2z(c, n, a, b);
+      break;
+
+    case BVTAG_SREM:
+      bvconst_srem2z(c, n, a, b);
+      break;
+
+    case BVTAG_SMOD:
+      bvconst_smod2z(c, n, a, b);
+      break;
+
+    default:
+      assert(false);
+      break;
+    }
+    bvconst_normalize(c, n);
+    holds = bvconst_eq(c, d, k);
+  }
+
+  if (k > 4) {
+    safe_free(a);
+  }
+
+  return holds;
+}
+
+
+/*
+ * Division or remainder that shares its circuit with x = (op y z)
+ * - return null_thvar if there's none
+ */
+static thvar_t bvvar_division_partner(bv_vartable_t *vtbl, bvvar_tag_t op, thvar_t y, thvar_t z) {
+  switch (op) {
+  case BVTAG_UDIV:
+    return find_rem(vtbl, y, z);
+
+  case BVTAG_UREM:
+    return find_div(vtbl, y, z);
+
+  case BVTAG_SDIV:
+    return find_srem(vtbl, y, z);
+
+  case BVTAG_SREM:
+    return find_sdiv(vtbl, y, z);
+
+  default:
+    return null_thvar;
+  }
+}
+
+
+/*
+ * Refine x: add the clauses for x = (op y z)
+ * - for a division or remainder, the circuit also defines the
+ *   partner operator if it exists. We mark the partner
+ *   and add it to vector v.
+ */
+static void bv_solver_refine_lazy_op(bv_solver_t *solver, thvar_t x, ivector_t *v) {
+  bv_vartable_t *vtbl;
+  ivector_t *a, *b;
+  literal_t *u;
+  uint32_t n;
+  bvvar_tag_t op;
+  thvar_t y, z, w;
+
+  vtbl = &solver->vtbl;
+  op = bvvar_tag(vtbl, x);
+  n = bvvar_bitsize(vtbl, x);
+  y = vtbl->def[x].op[0];
+  z = vtbl->def[x].op[1];
+
+  u = bvvar_pseudo_map(solver, x);
+  a = &solver->a_vector;
+  b = &solver->b_vector;
+  collect_bvvar_literals(solver, y, a);
+  collect_bvvar_literals(solver, z, b);
+  assert(a->size == n && b->size == n);
+
+  if (op == BVTAG_MUL || op == BVTAG_SMOD) {
+    bit_blaster_make_bvop(solver->blaster, op, a->data, b->data, u, n);
+  } else {
+    bit_blaster_make_bvdivop(solver, op, y, z, a->data, b->data, u, n);
+    w = bvvar_division_partner(vtbl, op, y, z);
+    if (w != null_thvar && !bvvar_is_marked(vtbl, w)) {
+      bvvar_set_mark(vtbl, w);
+      ivector_push(v, w);
+    }
+  }
+}
+
+
+/*
+ * Check all the abstracted operators and refine those that don't hold
+ * - return the number of refined operators
+ */
+static uint32_t bv_solver_refine_lazy_ops(bv_solver_t *solver) {
+  bv_vartable_t *vtbl;
+  bv_lazy_queue_t *queue;
+  ivector_t *v;
+  uint32_t i, n, count;
+  thvar_t x;
+
+  vtbl = &solver->vtbl;
+  queue = &solver->lazy_queue;
+  v = &solver->aux_vector;
+  ivector_reset(v);
+
+  count = 0;
+  n = queue->top;
+  for (i=0; i<n; i++) {
+    x = queue->data[i].var;
+    if (queue->data[i].level < 0 && !bvvar_is_marked(vtbl, x) && !bv_solver_lazy_op_holds(solver, x)) {
+      bv_solver_refine_lazy_op(solver, x, v);
+      queue->data[i].level = solver->base_level;
+      count ++;
+    }
+  }
+
+  if (v->size > 0) {
+    // the marked variables are refined too
+    for (i=0; i<n; i++) {
+      if (queue->data[i].level < 0 && bvvar_is_marked(vtbl, queue->data[i].var)) {
+        queue->data[i].level = solver->base_level;
+      }
+    }
+    for (i=0; i<v->size; i++) {
+      bvvar_clr_mark(vtbl, v->data[i]);
+    }
+    ivector_reset(v);
+  }
+
+  solver->stats.lazy_refinements += count;
+
+  return count;
+}
+
+
+
+
+/**********************************
+ *  WORD-LEVEL BOUND PROPAGATION  *
+ *********************************/
+
+/*
+ * Check whether atom a is (bvge x c), (bvge c x), or (bveq x c) where
+ * c is a constant of at most 64 bits and x is not a constant.
+ * - if so, return x and store the value of c in *c
+ * - otherwise, return null_thvar
+ * Atoms that are not attached to a literal or that are trivially
+ * true or false are ignored.
+ */
+static thvar_t bv_wprop_atom_var(bv_solver_t *solver, bvatm_t *a, uint64_t *c) {
+  bv_vartable_t *vtbl;
+
+  if (bvatm_is_sge(a) || a->lit == null_literal ||
+      a->lit == true_literal || a->lit == false_literal) {
+    return null_thvar;
+  }
+
+  vtbl = &solver->vtbl;
+  if (bvvar_is_const64(vtbl, a->right) && !is_constant(vtbl, a->left)) {
+    *c = bvvar_val64(vtbl, a->right);
+    return a->left;
+  }
+  if (bvvar_is_const64(vtbl, a->left) && !is_constant(vtbl, a->right)) {
+    *c = bvvar_val64(vtbl, a->left);
+    return a->right;
+  }
+
+  return null_thvar;
+}
+
+
+/*
+ * Build the propagator for the current search:
+ * - collect the bound atoms and group them by variable
+ * - compute the initial interval of every variable
+ * - queue the atoms already assigned
+ */
+static void bv_solver_build_wprop(bv_solver_t *solver) {
+  bv_wprop_t *prop;
+  bv_atomtable_t *atbl;
+  bvatm_t *a;
+  bv64_interval_t intv;
+  bv_wbound_t *b;
+  uint32_t i, n, nbits, s;
+  int32_t k;
+  uint64_t c;
+  thvar_t x;
+
+  prop = &solver->wprop;
+  atbl = &solver->atbl;
+
+  reset_bv_wprop(prop);
+  bv_wprop_init_map(prop, solver->vtbl.nvars);
+
+  // first pass: descriptors + number of atoms per variable
+  n = atbl->natoms;
+  for (i=0; i<n; i++) {
+    a = bvatom_desc(atbl, i);
+    x = bv_wprop_atom_var(solver, a, &c);
+    if (x != null_thvar) {
+      k = prop->map[x];
+      if (k < 0) {
+        nbits = bvvar_bitsize(&solver->vtbl, x);
+        bvvar_bounds_u64(solver, x, nbits, MAX_RECUR_DEPTH, &intv);
+        k = bv_wprop_add_var(prop, x, nbits, intv.low, intv.high);
+      }
+      prop->bound[k].end ++;
+    }
+  }
+
+  if (prop->nbounds == 0) return;
+
+  // atom lists: bound[k].start and end are set so that
+  // atom[start ... end-1] is the list of atoms for descriptor k
+  s = 0;
+  for (i=0; i<prop->nbounds; i++) {
+    b = prop->bound + i;
+    b->start = s;
+    s += b->end;
+    b->end = b->start;
+  }
+  resize_ivector(&prop->atom, s);
+  prop->atom.size = s;
+
+  for (i=0; i<n; i++) {
+    a = bvatom_desc(atbl, i);
+    x = bv_wprop_atom_var(solver, a, &c);
+    if (x != null_thvar) {
+      b = prop->bound + prop->map[x];
+      prop->atom.data[b->end] = i;
+      b->end ++;
+
+      switch (literal_value(solver->core, a->lit)) {
+      case VAL_TRUE:
+        ivector_push(&prop->queue, i);
+        ivector_push(&prop->queue, a->lit);
+        break;
+      case VAL_FALSE:
+        ivector_push(&prop->queue, i);
+        ivector_push(&prop->queue, not(a->lit));
+        break;
+      default:
+        break;
+      }
+    }
+  }
+
+  prop->ready = true;
+  fprintf(stderr, "wprop: %u atoms, %u bounds, %u queued\n", atbl->natoms, prop->nbounds, prop->queue.size);
+}
+
+
+/*
+ * Propagate the atoms implied by the bounds of descriptor i
+ * - every implied atom is explained by a single literal (low_expl or high_expl)
+ * - atoms implied by the initial bounds only are skipped: they are
+ *   handled by the bit-blasted constraints
+ */
+static void bv_wprop_propagate_atoms(bv_solver_t *solver, uint32_t i) {
+  bv_wprop_t *prop;
+  bv_wbound_t *b;
+  bvatm_t *a;
+  literal_t l, expl;
+  uint32_t j;
+  uint64_t c;
+  thvar_t x;
+
+  prop = &solver->wprop;
+  b = prop->bound + i;
+
+  for (j=b->start; j<b->end; j++) {
+    a = bvatom_desc(&solver->atbl, prop->atom.data[j]);
+    l = a->lit;
+    if (! bval_is_undef(literal_value(solver->core, l))) continue;
+
+    x = bv_wprop_atom_var(solver, a, &c);
+    assert(x == b->var);
+
+    expl = null_literal;
+    if (bvatm_is_eq(a)) {
+      if (c < b->low) {
+        l = not(l);
+        expl = b->low_expl;
+      } else if (c > b->high) {
+        l = not(l);
+        expl = b->high_expl;
+      } else if (b->low == c && b->high == c && b->low_expl == b->high_expl) {
+        expl = b->low_expl;
+      }
+    } else if (x == a->left) {
+      // (bvge x c)
+      if (b->low >= c) {
+        expl = b->low_expl;
+      } else if (b->high < c) {
+        l = not(l);
+        expl = b->high_expl;
+      }
+    } else {
+      // (bvge c x)
+      if (b->high <= c) {
+        expl = b->high_expl;
+      } else if (b->low > c) {
+        l = not(l);
+        expl = b->low_expl;
+      }
+    }
+
+    if (expl != null_literal) {
+      propagate_literal(solver->core, l, mk_i32_expl(expl));
+      solver->stats.bound_props ++;
+    }
+  }
+}
+
+
+/*
+ * Process atom i assigned to l (i.e., the atom is true if l is its literal
+ * or false if l is the negation of its literal)
+ * - update the interval of the atom's variable
+ * - return false if the interval becomes empty (and report the conflict)
+ */
+static bool bv_wprop_process_atom(bv_solver_t *solver, int32_t i, literal_t l) {
+  bv_wprop_t *prop;
+  bv_wbound_t *b;
+  bvatm_t *a;
+  uint64_t c, low, high, max;
+  thvar_t x;
+  int32_t k;
+  bool truth, saved;
+
+  prop = &solver->wprop;
+  a = bvatom_desc(&solver->atbl, i);
+  x = bv_wprop_atom_var(solver, a, &c);
+  if (x == null_thvar || x >= prop->map_size || prop->map[x] < 0) {
+    // atom created after the propagator was built
+    return true;
+  }
+
+  k = prop->map[x];
+  b = prop->bound + k;
+  max = mask64(b->nbits);
+  fprintf(stderr, "process atom %d on x%d, l = %d: c = %lu, [%lu, %lu]\n", i, x, l, (unsigned long) c, (unsigned long) b->low, (unsigned long) b->high);
+
+  assert(l == a->lit || l == not(a->lit));
+  truth = (l == a->lit);
+
+  low = 0;
+  high = max;
+  if (bvatm_is_eq(a)) {
+    if (! truth) return true;
+    low = c;
+    high = c;
+  } else if (x == a->left) {
+    // (bvge x c) or (bvlt x c)
+    if (truth) {
+      low = c;
+    } else {
+      if (c == 0) return true;
+      high = c - 1;
+    }
+  } else {
+    // (bvge c x) or (bvlt c x)
+    if (truth) {
+      high = c;
+    } else {
+      if (c == max) return true;
+      low = c + 1;
+    }
+  }
+
+  saved = false;
+  if (low > b->low) {
+    bv_wprop_save(prop, k);
+    saved = true;
+    b->low = low;
+    b->low_expl = l;
+  }
+  if (high < b->high) {
+    if (! saved) {
+      bv_wprop_save(prop, k);
+      saved = true;
+    }
+    b->high = high;
+    b->high_expl = l;
+  }
+
+  if (b->low > b->high) {
+    assert(b->low_expl != null_literal || b->high_expl != null_literal);
+    if (b->low_expl == null_literal) {
+      record_unit_theory_conflict(solver->core, not(b->high_expl));
+    } else if (b->high_expl == null_literal || b->high_expl == b->low_expl) {
+      record_unit_theory_conflict(solver->core, not(b->low_expl));
+    } else {
+      record_binary_theory_conflict(solver->core, not(b->low_expl), not(b->high_expl));
+    }
+    solver->stats.bound_conflicts ++;
+    return false;
+  }
+
+  if (saved) {
+    bv_wprop_propagate_atoms(solver, k);
+  }
+
+  return true;
+}
+
+
+/*
+ * Process all the atoms in the propagator's queue
+ * - return false if a conflict is found
+ */
+static bool bv_solver_wprop_process(bv_solver_t *solver) {
+  bv_wprop_t *prop;
+  uint32_t i;
+
+  prop = &solver->wprop;
+  assert(prop->ready);
+
+  for (i=0; i<prop->queue.size; i += 2) {
+    if (! bv_wprop_process_atom(solver, prop->queue.data[i], prop->queue.data[i+1])) {
+      ivector_reset(&prop->queue);
+      return false;
+    }
+  }
+  ivector_reset(&prop->queue);
+
+  return true;
+}
+
+
+
+
 /**********************
  *  SOLVER INTERFACE  *
  *********************/
@@ -6755,6 +7585,7 @@ thvar_t bv_solver_create_on_the_fly_var(bv_solver_t *solver, uint32_t n) {
  */
 void bv_solver_start_internalization(bv_solver_t *solver) {
   solver->bitblasted = false;
+  fprintf(stderr, "reset at line 7588\n"); reset_bv_wprop(&solver->wprop);
 }
 
 
@@ -6763,6 +7594,7 @@ void bv_solver_start_internalization(bv_solver_t *solver) {
  * - perform bit blasting
  * - if a conflict is detected by bit blasting, add the empty clause
  *   to the smt_core
+ * - otherwise, build the word-level bound propagator
  */
 void bv_solver_start_search(bv_solver_t *solver) {
   bool feasible;
@@ -6775,6 +7607,8 @@ void bv_solver_start_search(bv_solver_t *solver) {
   feasible = bv_solver_bitblast(solver);
   if (! feasible) {
     add_empty_clause(solver->core);
+  } else {
+    bv_solver_build_wprop(solver);
   }
 }
 
@@ -6785,6 +7619,10 @@ void bv_solver_start_search(bv_solver_t *solver) {
  * - return true otherwise
  */
 bool bv_solver_propagate(bv_solver_t *solver) {
+  fprintf(stderr, "propagate: ready = %d, queue = %u\n", solver->wprop.ready, solver->wprop.queue.size);
+  if (solver->wprop.queue.size > 0 && !bv_solver_wprop_process(solver)) {
+    return false;
+  }
   if (eassertion_queue_is_nonempty(&solver->egraph_queue)) {
     assert(solver->bitblasted);
     return bv_solver_process_egraph_assertions(solver);
@@ -6793,9 +7631,13 @@ bool bv_solver_propagate(bv_solver_t *solver) {
 }
 
 /*
- * Final check: nothing to do
+ * Final check: refine the abstracted operators that don't hold
+ * in the current assignment (lazy mode)
  */
 fcheck_code_t bv_solver_final_check(bv_solver_t *solver) {
+  if (bv_solver_refine_lazy_ops(solver) > 0) {
+    return FCHECK_CONTINUE;
+  }
   return FCHECK_SAT;
 }
 
@@ -6806,6 +7648,9 @@ void bv_solver_clear(bv_solver_t *solver) {
 
 void bv_solver_increase_decision_level(bv_solver_t *solver) {
   solver->decision_level ++;
+  if (solver->wprop.ready) {
+    ivector_push(&solver->wprop.marks, solver->wprop.trail_top);
+  }
 
 #if DUMP
   if (solver->core->stats.decisions == 1) {
@@ -6817,6 +7662,9 @@ void bv_solver_increase_decision_level(bv_solver_t *solver) {
 void bv_solver_backtrack(bv_solver_t *solver, uint32_t backlevel) {
   assert(solver->base_level <= backlevel && backlevel < solver->decision_level);
   reset_eassertion_queue(&solver->egraph_queue);
+  if (solver->wprop.ready) {
+    bv_wprop_backtrack(&solver->wprop, backlevel - solver->base_level);
+  }
   solver->decision_level = backlevel;
 }
 
@@ -6829,19 +7677,25 @@ void bv_solver_backtrack(bv_solver_t *solver, uint32_t backlevel) {
  * - if l is negative (i.e., neg_lit(v)), assert its negation
  * Return false if that causes a conflict, true otherwise.
  *
- * Do nothing (although we could try more simplification if
- * this is called before start_search).
+ * If the word-level propagator is ready, the atom is queued.
+ * It's processed in the next call to bv_solver_propagate.
  */
 bool bv_solver_assert_atom(bv_solver_t *solver, void *a, literal_t l) {
+  fprintf(stderr, "assert atom %d, ready = %d\n", bvatom_tagged_ptr2idx(a), solver->wprop.ready);
+  if (solver->wprop.ready) {
+    ivector_push(&solver->wprop.queue, bvatom_tagged_ptr2idx(a));
+    ivector_push(&solver->wprop.queue, l);
+  }
   return true;
 }
 
 
 /*
- * This function should never be called.
+ * Explanation for a literal propagated by the word-level propagator:
+ * expl is a single literal (cf. bv_wprop_propagate_atoms).
  */
 void bv_solver_expand_explanation(bv_solver_t *solver, literal_t l, void *expl, ivector_t *v) {
-  assert(false);
+  ivector_push(v, i32_of_expl(expl));
 }
 
 
@@ -6870,6 +7724,7 @@ void init_bv_solver(bv_solver_t *solver, smt_core_t *core, egraph_t *egraph) {
   solver->base_level = 0;
   solver->decision_level = 0;
   solver->bitblasted = false;
+  solver->lazy = false;
   solver->bbptr = 0;
 
   init_bv_vartable(&solver->vtbl);
@@ -6890,6 +7745,8 @@ void init_bv_solver(bv_solver_t *solver, smt_core_t *core, egraph_t *egraph) {
   init_bv_queue(&solver->select_queue);
   init_bv_queue(&solver->delayed_mapped);
   init_bv_queue(&solver->delayed_blasted);
+  init_bv_lazy_queue(&solver->lazy_queue);
+  init_bv_wprop(&solver->wprop);
   init_bv_trail(&solver->trail_stack);
 
   init_bvpoly_buffer(&solver->buffer);
@@ -6962,6 +7819,8 @@ void delete_bv_solver(bv_solver_t *solver) {
   delete_bv_queue(&solver->select_queue);
   delete_bv_queue(&solver->delayed_mapped);
   delete_bv_queue(&solver->delayed_blasted);
+  delete_bv_lazy_queue(&solver->lazy_queue);
+  delete_bv_wprop(&solver->wprop);
   delete_bv_trail(&solver->trail_stack);
 
   delete_bvpoly_buffer(&solver->buffer);
@@ -6991,7 +7850,7 @@ void delete_bv_solver(bv_solver_t *solver) {
  * Start a new base level
  */
 void bv_solver_push(bv_solver_t *solver) {
-  uint32_t na, nv, nb, ns, ndm, ndb, bb;
+  uint32_t na, nv, nb, ns, ndm, ndb, bb, nl;
 
   assert(solver->decision_level == solver->base_level &&
          all_bvvars_unmarked(solver));
@@ -7003,8 +7862,9 @@ void bv_solver_push(bv_solver_t *solver) {
   ndm = solver->delayed_mapped.top;
   ndb = solver->delayed_blasted.top;
   bb = solver->bbptr;
+  nl = solver->lazy_queue.top;
 
-  bv_trail_save(&solver->trail_stack, nv, na, nb, ns, ndm, ndb, bb);
+  bv_trail_save(&solver->trail_stack, nv, na, nb, ns, ndm, ndb, bb, nl);
 
   mtbl_push(&solver->mtbl);
 
@@ -7020,6 +7880,7 @@ void bv_solver_push(bv_solver_t *solver) {
     cache_push(solver->cache);
   }
 
+  fprintf(stderr, "reset at line 7883\n"); reset_bv_wprop(&solver->wprop);
   solver->base_level ++;
   bv_solver_increase_decision_level(solver);
 }
@@ -7126,6 +7987,7 @@ void bv_solver_pop(bv_solver_t *solver) {
   assert(solver->base_level > 0 &&
          solver->base_level == solver->decision_level);
 
+  fprintf(stderr, "reset at line 7990\n"); reset_bv_wprop(&solver->wprop);
   solver->base_level --;
   bv_solver_backtrack(solver, solver->base_level);
 
@@ -7175,6 +8037,9 @@ void bv_solver_pop(bv_solver_t *solver) {
   // restore the bitblast pointer
   solver->bbptr = top->nbblasted;
 
+  // remove the abstracted operators of the popped level
+  bv_lazy_queue_pop(&solver->lazy_queue, top->nlazy, solver->base_level);
+
   mtbl_pop(&solver->mtbl);
 
   bv_trail_pop(&solver->trail_stack);
@@ -7233,6 +8098,8 @@ void bv_solver_reset(bv_solver_t *solver) {
   reset_bv_queue(&solver->select_queue);
   reset_bv_queue(&solver->delayed_mapped);
   reset_bv_queue(&solver->delayed_blasted);
+  reset_bv_lazy_queue(&solver->lazy_queue);
+  fprintf(stderr, "reset at line 8102\n"); reset_bv_wprop(&solver->wprop);
   reset_bv_trail(&solver->trail_stack);
 
   reset_bvpoly_buffer(&solver->buffer, 32);
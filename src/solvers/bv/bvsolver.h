@@ -200,6 +200,28 @@ extern thvar_t bv_solver_var_compiles_to(bv_solver_t *solver, thvar_t x);
 
 
 
+/***********************
+ *  LAZY BIT-BLASTING  *
+ **********************/
+
+/*
+ * In lazy mode, bvmul/bvudiv/bvurem/bvsdiv/bvsrem/bvsmod are abstracted
+ * when they're bitblasted: the result bits are treated as fresh
+ * literals. The clauses for these operators are added in final_check,
+ * only for the operators whose value is wrong in the current assignment.
+ * - the mode must be set before bitblasting (i.e., before start_search)
+ * - it's disabled by default
+ */
+static inline void bv_solver_enable_lazy_blasting(bv_solver_t *solver) {
+  solver->lazy = true;
+}
+
+static inline void bv_solver_disable_lazy_blasting(bv_solver_t *solver) {
+  solver->lazy = false;
+}
+
+
+
 /****************
  *  STATISTICS  *
  ***************/
@@ -269,6 +291,32 @@ static inline uint32_t bv_solver_interface_lemmas(bv_solver_t *solver) {
 }
 
 
+/*
+ * Lazy bit-blasting: number of abstracted operators
+ * and number of refinements
+ */
+static inline uint32_t bv_solver_lazy_ops(bv_solver_t *solver) {
+  return solver->stats.lazy_ops;
+}
+
+static inline uint32_t bv_solver_lazy_refinements(bv_solver_t *solver) {
+  return solver->stats.lazy_refinements;
+}
+
+
+/*
+ * Word-level bound propagation: number of propagated atoms
+ * and number of conflicts
+ */
+static inline uint32_t bv_solver_bound_props(bv_solver_t *solver) {
+  return solver->stats.bound_props;
+}
+
+static inline uint32_t bv_solver_bound_conflicts(bv_solver_t *solver) {
+  return solver->stats.bound_conflicts;
+}
+
+
 
 /************************
  *  MODEL CONSTRUCTION  *
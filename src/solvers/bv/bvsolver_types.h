@@ -192,6 +192,123 @@ typedef struct bv_queue_s {
 
 
 
+/************************
+ *  LAZY BIT-BLASTING   *
+ ***********************/
+
+/*
+ * In lazy mode, the expensive operators (bvmul, bvudiv, bvurem,
+ * bvsdiv, bvsrem, bvsmod) are not converted to clauses when they're
+ * bitblasted. A variable x = (op y z) is treated as an uninterpreted
+ * bitvector: its bits are fresh literals and x is added to the
+ * lazy queue. In final_check, the value of x is compared with
+ * (op val(y) val(z)). If they differ, the clauses for x = (op y z)
+ * are added (x is refined).
+ *
+ * Each element of the queue stores x and the base level at which
+ * x was refined (or -1 if x is not refined yet). Refined variables
+ * become unrefined again when the solver backtracks to a lower
+ * base level (since the clauses for x are removed by pop).
+ *
+ * Operators are abstracted only if they have at least
+ * BV_LAZY_MIN_BITSIZE bits and no constant operand.
+ */
+typedef struct bv_lazy_op_s {
+  thvar_t var;
+  int32_t level;
+} bv_lazy_op_t;
+
+typedef struct bv_lazy_queue_s {
+  bv_lazy_op_t *data;
+  uint32_t size;
+  uint32_t top;
+} bv_lazy_queue_t;
+
+#define DEF_BV_LAZY_QUEUE_SIZE 20
+#define MAX_BV_LAZY_QUEUE_SIZE (UINT32_MAX/sizeof(bv_lazy_op_t))
+
+#define BV_LAZY_MIN_BITSIZE 8
+
+
+
+/**********************************
+ *  WORD-LEVEL BOUND PROPAGATION  *
+ *********************************/
+
+/*
+ * During the search, the solver keeps an unsigned interval [low, high]
+ * for every variable x of 64 bits or less that occurs in bound atoms
+ * (i.e., (bvge x c), (bvge c x), or (bveq x c) where c is a constant).
+ * This allows conflicts and implied atoms to be detected at the word
+ * level, without waiting for propagation through the comparator
+ * circuits.
+ *
+ * - the initial interval for x is computed when the search starts
+ *   (from the definition of x and the bounds asserted at the base level)
+ * - when a bound atom on x is assigned, the interval is narrowed. If
+ *   it becomes empty, the conflict is reported to the core. Otherwise,
+ *   the other atoms on x that are implied by the new interval are
+ *   propagated.
+ * - low_expl/high_expl = literal that justifies the bound, or
+ *   null_literal for the initial bounds. Every conflict or propagation
+ *   is explained by one or two of these literals.
+ *
+ * Descriptor of variable x:
+ * - var = x, nbits = its size
+ * - the atoms on x are atom[start ... end-1] in the propagator
+ * - low, high, low_expl, high_expl = current bounds
+ *
+ * Propagator:
+ * - bound = array of descriptors, nbounds = number of descriptors
+ * - map[x] = index of x's descriptor or -1, for 0 <= x < map_size
+ * - atom = atom lists of all descriptors
+ * - queue = assigned atoms to process: pairs (atom id, literal)
+ * - trail = saved descriptors for backtracking
+ * - marks = trail size at each decision level above the base level
+ * - ready = true if the propagator is built for the current search
+ */
+typedef struct bv_wbound_s {
+  thvar_t var;
+  uint32_t nbits;
+  uint32_t start;
+  uint32_t end;
+  uint64_t low;
+  uint64_t high;
+  literal_t low_expl;
+  literal_t high_expl;
+} bv_wbound_t;
+
+typedef struct bv_wsaved_s {
+  uint32_t idx;
+  uint64_t low;
+  uint64_t high;
+  literal_t low_expl;
+  literal_t high_expl;
+} bv_wsaved_t;
+
+typedef struct bv_wprop_s {
+  bv_wbound_t *bound;
+  uint32_t nbounds;
+  uint32_t bsize;
+  int32_t *map;
+  uint32_t map_size;
+  ivector_t atom;
+  ivector_t queue;
+  bv_wsaved_t *trail;
+  uint32_t trail_top;
+  uint32_t trail_size;
+  ivector_t marks;
+  bool ready;
+} bv_wprop_t;
+
+#define DEF_BV_WPROP_SIZE 20
+#define MAX_BV_WPROP_SIZE (UINT32_MAX/sizeof(bv_wbound_t))
+#define MAX_BV_WPROP_MAP_SIZE (UINT32_MAX/sizeof(int32_t))
+#define DEF_BV_WTRAIL_SIZE 50
+#define MAX_BV_WTRAIL_SIZE (UINT32_MAX/sizeof(bv_wsaved_t))
+
+
+
 /********************
  *  PUSH/POP STACK  *
  *******************/
@@ -200,7 +317,7 @@ typedef struct bv_queue_s {
  * For every push, we keep track of the number of variables and atoms
  * on entry to the new base level, the size of the bound queue, and
  * the size of the queue of select vars and delayed mapped/bitblasting vars, the
- * number of bitblasted atoms.
+ * number of bitblasted atoms, and the size of the lazy queue.
  */
 typedef struct bv_trail_s {
   uint32_t nvars;
@@ -210,6 +327,7 @@ typedef struct bv_trail_s {
   uint32_t ndelayed_mapped;
   uint32_t ndelayed_blasted;
   uint32_t nbblasted;
+  uint32_t nlazy;
 } bv_trail_t;
 
 typedef struct bv_trail_stack_s {
@@ -272,6 +390,10 @@ typedef struct bv_stats_s {
   uint32_t equiv_conflicts;
   uint32_t half_equiv_lemmas;
   uint32_t interface_lemmas;
+  uint32_t lazy_ops;
+  uint32_t lazy_refinements;
+  uint32_t bound_props;
+  uint32_t bound_conflicts;
 } bv_stats_t;
 
 
@@ -296,8 +418,11 @@ typedef struct bv_solver_s {
    * Bitblast flag: false when new variables/assertions are added
    * true after the constraints have been bitblasted (converted to CNF).
    * - bbptr = number of atoms that have already been bitblasted
+   * - lazy: if true, expensive operators are abstracted when
+   *   they're bitblasted and refined on demand (see lazy queue)
    */
   bool bitblasted;
+  bool lazy;
   uint32_t bbptr;
 
   /*
@@ -350,6 +475,16 @@ typedef struct bv_solver_s {
   bv_queue_t delayed_mapped;
   bv_queue_t delayed_blasted;
 
+  /*
+   * Abstracted operators (lazy mode)
+   */
+  bv_lazy_queue_t lazy_queue;
+
+  /*
+   * Word-level bound propagation
+   */
+  bv_wprop_t wprop;
+
   /*
    * Push/pop stack
    */
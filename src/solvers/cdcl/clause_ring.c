@@ -0,0 +1,196 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RING BUFFER FOR SHARING LEARNED CLAUSES BETWEEN SMT CORES
+ *
+ * We use the GCC __atomic builtins (also supported by clang).
+ * - writer: CAS seq from an even value to 2 * pos + 1, release fence,
+ *   write the clause (relaxed stores), then store seq = 2 * pos + 2 (release).
+ * - reader: load seq (acquire), read the clause (relaxed loads),
+ *   acquire fence, reload seq. The copy is valid if both values
+ *   are equal to 2 * pos + 2.
+ */
+
+#include <assert.h>
+
+#include "solvers/cdcl/clause_ring.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Initialize ring
+ */
+void init_clause_ring(clause_ring_t *ring, uint32_t n, uint32_t nvars, uint32_t max_length, uint32_t max_glue) {
+  uint32_t i, size;
+
+  assert(0 < max_length && max_length <= CLAUSE_RING_MAX_LENGTH);
+
+  if (n == 0) {
+    n = DEF_CLAUSE_RING_SIZE;
+  }
+  size = 1;
+  while (size < n) {
+    size <<= 1;
+    if (size >= (UINT32_MAX/sizeof(ring_slot_t))) {
+      out_of_memory();
+    }
+  }
+
+  ring->head = 0;
+  ring->size = size;
+  ring->mask = size - 1;
+  ring->nvars = nvars;
+  ring->max_length = max_length;
+  ring->max_glue = max_glue;
+  ring->slot = (ring_slot_t *) safe_malloc(size * sizeof(ring_slot_t));
+
+  for (i=0; i<size; i++) {
+    ring->slot[i].seq = 0;
+  }
+}
+
+
+/*
+ * Free memory
+ */
+void delete_clause_ring(clause_ring_t *ring) {
+  safe_free(ring->slot);
+  ring->slot = NULL;
+}
+
+
+/*
+ * Head position
+ */
+uint64_t clause_ring_head(clause_ring_t *ring) {
+  return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+}
+
+
+/*
+ * Filters
+ */
+bool clause_ring_accepts(clause_ring_t *ring, uint32_t n, const literal_t *a, uint32_t glue) {
+  uint32_t i;
+
+  if (n > ring->max_length || glue > ring->max_glue) {
+    return false;
+  }
+  for (i=0; i<n; i++) {
+    if ((uint32_t) var_of(a[i]) >= ring->nvars) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Export a[0 ... n-1]
+ */
+bool clause_ring_export(clause_ring_t *ring, uint32_t source, uint32_t n, const literal_t *a, uint32_t glue) {
+  ring_slot_t *s;
+  uint64_t pos, seq;
+  uint32_t i;
+
+  assert(clause_ring_accepts(ring, n, a, glue));
+
+  pos = __atomic_fetch_add(&ring->head, 1, __ATOMIC_RELAXED);
+  s = ring->slot + (pos & ring->mask);
+
+  // claim the slot: fail if another writer has it
+  seq = __atomic_load_n(&s->seq, __ATOMIC_RELAXED);
+  if ((seq & 1) != 0 ||
+      !__atomic_compare_exchange_n(&s->seq, &seq, 2 * pos + 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    return false;
+  }
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  __atomic_store_n(&s->source, source, __ATOMIC_RELAXED);
+  __atomic_store_n(&s->glue, glue, __ATOMIC_RELAXED);
+  __atomic_store_n(&s->len, n, __ATOMIC_RELAXED);
+  for (i=0; i<n; i++) {
+    __atomic_store_n(s->lit + i, a[i], __ATOMIC_RELAXED);
+  }
+
+  __atomic_store_n(&s->seq, 2 * pos + 2, __ATOMIC_RELEASE);
+
+  return true;
+}
+
+
+/*
+ * Try to read the clause at position pos
+ * - return false if the slot doesn't contain that clause
+ */
+static bool read_slot(clause_ring_t *ring, uint64_t pos, uint32_t *source, shared_clause_t *c) {
+  ring_slot_t *s;
+  uint64_t seq;
+  uint32_t i, n;
+
+  s = ring->slot + (pos & ring->mask);
+  seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+  if (seq != 2 * pos + 2) {
+    return false;
+  }
+
+  *source = __atomic_load_n(&s->source, __ATOMIC_RELAXED);
+  c->glue = __atomic_load_n(&s->glue, __ATOMIC_RELAXED);
+  n = __atomic_load_n(&s->len, __ATOMIC_RELAXED);
+  if (n > CLAUSE_RING_MAX_LENGTH) {
+    n = CLAUSE_RING_MAX_LENGTH; // partial write: checked below
+  }
+  for (i=0; i<n; i++) {
+    c->lit[i] = __atomic_load_n(s->lit + i, __ATOMIC_RELAXED);
+  }
+  c->len = n;
+
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+  return __atomic_load_n(&s->seq, __ATOMIC_RELAXED) == seq;
+}
+
+
+/*
+ * Get the next clause for reader
+ */
+bool clause_ring_import(clause_ring_t *ring, uint64_t *cursor, uint32_t reader, shared_clause_t *c) {
+  uint64_t pos, head;
+  uint32_t source;
+
+  head = clause_ring_head(ring);
+  pos = *cursor;
+
+  // skip what's been overwritten
+  if (head - pos > ring->size) {
+    pos = head - ring->size;
+  }
+
+  while (pos < head) {
+    if (read_slot(ring, pos, &source, c) && source != reader) {
+      *cursor = pos + 1;
+      return true;
+    }
+    pos ++;
+  }
+
+  *cursor = pos;
+  return false;
+}
@@ -0,0 +1,158 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RING BUFFER FOR SHARING LEARNED CLAUSES BETWEEN SMT CORES
+ *
+ * Several smt_core instances that solve the same problem in parallel
+ * (with the same boolean variable numbering) can exchange short
+ * learned clauses through this ring:
+ * - a core exports a clause by writing it in the next slot
+ * - every core has its own read cursor and imports the clauses
+ *   written by others at its next restart.
+ *
+ * The ring is lock-free:
+ * - writers claim a position using an atomic increment of head
+ * - each slot is protected by a sequence number (seqlock):
+ *   seq is odd while the slot is written; it's set to 2 * pos + 2
+ *   once the clause of position pos is complete.
+ * - readers never block writers: a reader that finds a slot being
+ *   written or overwritten just skips it.
+ * Sharing is best effort: a clause may be dropped if a writer finds
+ * its slot busy, or if a reader is more than one lap behind.
+ *
+ * Only variables whose index is less than ring->nvars are shared.
+ * These variables must have the same meaning in all the cores.
+ */
+
+#ifndef __CLAUSE_RING_H
+#define __CLAUSE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "solvers/cdcl/smt_core_base_types.h"
+
+
+/*
+ * Maximal length of a shared clause
+ */
+#define CLAUSE_RING_MAX_LENGTH 16
+
+/*
+ * Default ring size (number of slots) and default filters
+ */
+#define DEF_CLAUSE_RING_SIZE 4096
+#define DEF_SHARED_CLAUSE_LENGTH 8
+#define DEF_SHARED_CLAUSE_GLUE 4
+
+
+/*
+ * Slot:
+ * - seq = sequence number
+ * - source = id of the core that wrote the clause
+ * - glue = glue of the clause in the source core
+ * - len = number of literals
+ * - lit[0 ... len-1] = the clause
+ */
+typedef struct ring_slot_s {
+  uint64_t seq;
+  uint32_t source;
+  uint32_t glue;
+  uint32_t len;
+  literal_t lit[CLAUSE_RING_MAX_LENGTH];
+} ring_slot_t;
+
+
+/*
+ * Ring:
+ * - head = next position to write (all positions < head
+ *   have been claimed by a writer)
+ * - size = number of slots (a power of two)
+ * - mask = size - 1
+ * - nvars = variable bound: only clauses on variables < nvars
+ *   are exported
+ * - max_length, max_glue: only clauses of length <= max_length
+ *   and glue <= max_glue are exported
+ */
+typedef struct clause_ring_s {
+  uint64_t head;
+  uint32_t size;
+  uint32_t mask;
+  uint32_t nvars;
+  uint32_t max_length;
+  uint32_t max_glue;
+  ring_slot_t *slot;
+} clause_ring_t;
+
+
+/*
+ * Shared clause as read by an importer
+ */
+typedef struct shared_clause_s {
+  uint32_t glue;
+  uint32_t len;
+  literal_t lit[CLAUSE_RING_MAX_LENGTH];
+} shared_clause_t;
+
+
+/*
+ * Initialize ring:
+ * - n = number of slots: it's rounded up to a power of two
+ *   (if n is 0, the default size is used)
+ * - nvars = bound on the variables to share
+ * - max_length = maximal clause length (must be between 1 and CLAUSE_RING_MAX_LENGTH)
+ * - max_glue = maximal glue
+ */
+extern void init_clause_ring(clause_ring_t *ring, uint32_t n, uint32_t nvars, uint32_t max_length, uint32_t max_glue);
+
+/*
+ * Delete: free memory
+ */
+extern void delete_clause_ring(clause_ring_t *ring);
+
+/*
+ * Current head position: a new reader should start there
+ */
+extern uint64_t clause_ring_head(clause_ring_t *ring);
+
+/*
+ * Check whether clause a[0 ... n-1] with the given glue passes the ring's filters
+ */
+extern bool clause_ring_accepts(clause_ring_t *ring, uint32_t n, const literal_t *a, uint32_t glue);
+
+/*
+ * Export clause a[0 ... n-1]:
+ * - source = id of the exporting core
+ * - the clause must pass the filters
+ * - return false if the clause was dropped (slot busy)
+ */
+extern bool clause_ring_export(clause_ring_t *ring, uint32_t source, uint32_t n, const literal_t *a, uint32_t glue);
+
+/*
+ * Read the next clause written by another core:
+ * - *cursor = position of the next slot to read for this reader
+ * - reader = id of this reader: clauses whose source is reader are skipped
+ * - if a clause is found, it's copied into *c, *cursor is updated, and
+ *   the function returns true
+ * - return false if there's nothing left to read
+ */
+extern bool clause_ring_import(clause_ring_t *ring, uint64_t *cursor, uint32_t reader, shared_clause_t *c);
+
+
+#endif /* __CLAUSE_RING_H */
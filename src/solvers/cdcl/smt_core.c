@@ -22,11 +22,13 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <string.h>
 #include <float.h>
 
 #include "solvers/cdcl/smt_core.h"
 #include "utils/gcd.h"
 #include "utils/int_array_sort.h"
+#include "utils/int_array_sort2.h"
 #include "utils/memalloc.h"
 
 
@@ -50,6 +52,7 @@ extern void print_bvar(FILE *f, bvar_t x);
 // All debugging functions are defined at the end of this file
 static void check_heap_content(smt_core_t *s);
 static void check_heap(smt_core_t *s);
+static void check_vmtf(smt_core_t *s);
 static void check_propagation(smt_core_t *s);
 static void check_marks(smt_core_t *s);
 static void check_theory_conflict(smt_core_t *s, literal_t *a);
@@ -156,6 +159,21 @@ static inline void multiply_activity(clause_t *cl, float scale) {
   learned(cl)->activity *= scale;
 }
 
+/*
+ * Glue of a learned clause
+ */
+static inline uint32_t get_glue(const clause_t *cl) {
+  return learned(cl)->glue;
+}
+
+static inline void set_glue(clause_t *cl, uint32_t glue) {
+  learned(cl)->glue = (glue < MAX_CLAUSE_GLUE) ? glue : MAX_CLAUSE_GLUE;
+}
+
+static inline bool is_core_clause(const clause_t *cl) {
+  return get_glue(cl) <= CORE_GLUE;
+}
+
 /*
  * Mark a clause cl for removal
  */
@@ -191,18 +209,138 @@ static uint32_t clause_length(clause_t *cl) {
   return a - cl->cl;
 }
 
+/*****************
+ *  CLAUSE ARENA  *
+ ****************/
+
+/*
+ * Initialize arena a: no block allocated yet
+ */
+static void init_clause_arena(clause_arena_t *a) {
+  a->block = NULL;
+  a->capacity = 0;
+  a->live = 0;
+  a->wasted = 0;
+}
+
+/*
+ * Free all the blocks in list b
+ */
+static void free_clause_blocks(clause_block_t *b) {
+  clause_block_t *next;
+
+  while (b != NULL) {
+    next = b->next;
+    safe_free(b);
+    b = next;
+  }
+}
+
+/*
+ * Free all the blocks of a
+ */
+static void delete_clause_arena(clause_arena_t *a) {
+  free_clause_blocks(a->block);
+  a->block = NULL;
+}
+
+/*
+ * Empty the arena: free all blocks
+ */
+static void reset_clause_arena(clause_arena_t *a) {
+  free_clause_blocks(a->block);
+  init_clause_arena(a);
+}
+
+/*
+ * Allocate a new block of n words and add it to a
+ */
+static clause_block_t *new_clause_block(clause_arena_t *a, uint32_t n) {
+  clause_block_t *b;
+
+  if (n > MAX_CLAUSE_BLOCK_SIZE) {
+    out_of_memory();
+  }
+  b = (clause_block_t *) safe_malloc(sizeof(clause_block_t) + n * sizeof(uint64_t));
+  b->next = a->block;
+  b->capacity = n;
+  b->size = 0;
+  a->block = b;
+  a->capacity += n;
+
+  return b;
+}
+
+/*
+ * Number of words needed for a clause of n literals
+ * - learned = true means that space for the learned_clause_t header is included
+ */
+static inline uint32_t clause_words(uint32_t n, bool learned) {
+  uint32_t bytes;
+
+  bytes = sizeof(clause_t) + (n + 1) * sizeof(literal_t);
+  if (learned) {
+    bytes += offsetof(learned_clause_t, clause);
+  }
+  return (bytes + 7) >> 3;
+}
+
+/*
+ * Allocate n words in a
+ * - if the current block is too small, a new block is allocated,
+ *   at least as large as all the existing blocks together, so that
+ *   the number of blocks grows logarithmically.
+ */
+static void *arena_alloc(clause_arena_t *a, uint32_t n) {
+  clause_block_t *b;
+  uint64_t size;
+  uint32_t i;
+
+  b = a->block;
+  if (b == NULL || b->capacity - b->size < n) {
+    size = a->capacity;
+    if (size < DEF_CLAUSE_BLOCK_SIZE) {
+      size = DEF_CLAUSE_BLOCK_SIZE;
+    }
+    if (size < n) {
+      size = n;
+    }
+    if (size > MAX_CLAUSE_BLOCK_SIZE) {
+      size = MAX_CLAUSE_BLOCK_SIZE;
+    }
+    b = new_clause_block(a, (uint32_t) size);
+    if (b->capacity < n) {
+      out_of_memory();
+    }
+  }
+
+  i = b->size;
+  b->size = i + n;
+  a->live += n;
+
+  return b->data + i;
+}
+
+/*
+ * Record that n words are no longer used
+ */
+static inline void arena_free(clause_arena_t *a, uint32_t n) {
+  assert(a->live >= n);
+  a->live -= n;
+  a->wasted += n;
+}
+
+
 /*
  * Allocate and initialize a new clause (not a learned clause)
  * \param len = number of literals
  * \param lit = array of len literals
- * The watched pointers are not initialized
  */
-static clause_t *new_clause(uint32_t len, literal_t *lit) {
+static clause_t *new_clause(smt_core_t *s, uint32_t len, literal_t *lit) {
   clause_t *result;
   uint32_t i;
 
-  result = (clause_t *) safe_malloc(sizeof(clause_t) + sizeof(literal_t) +
-                                    len * sizeof(literal_t));
+  result = (clause_t *) arena_alloc(&s->arena, clause_words(len, false));
 
   for (i=0; i<len; i++) {
     result->cl[i] = lit[i];
@@ -216,25 +354,25 @@ static clause_t *new_clause(uint32_t len, literal_t *lit) {
  * Delete clause cl
  * cl must be a non-learned clause, allocated via the previous function.
  */
-static inline void delete_clause(clause_t *cl) {
-  safe_free(cl);
+static inline void delete_clause(smt_core_t *s, clause_t *cl) {
+  arena_free(&s->arena, clause_words(clause_length(cl), false));
 }
 
 /*
  * Allocate and initialize a new learned clause
  * \param len = number of literals
  * \param lit = array of len literals
- * The watched pointers are not initialized.
- * The activity is initialized to 0.0
+ * The activity is initialized to 0.0, glue to MAX_CLAUSE_GLUE, and used to 0.
  */
-static clause_t *new_learned_clause(uint32_t len, literal_t *lit) {
+static clause_t *new_learned_clause(smt_core_t *s, uint32_t len, literal_t *lit) {
   learned_clause_t *tmp;
   clause_t *result;
   uint32_t i;
 
-  tmp = (learned_clause_t *) safe_malloc(sizeof(learned_clause_t) + sizeof(literal_t) +
-                                         len * sizeof(literal_t));
+  tmp = (learned_clause_t *) arena_alloc(&s->arena, clause_words(len, true));
   tmp->activity = 0.0;
+  tmp->glue = MAX_CLAUSE_GLUE;
+  tmp->used = 0;
   result = &(tmp->clause);
 
   for (i=0; i<len; i++) {
@@ -249,8 +387,8 @@ static clause_t *new_learned_clause(uint32_t len, literal_t *lit) {
  * Delete learned clause cl
  * cl must have been allocated via the new_learned_clause function
  */
-static inline void delete_learned_clause(clause_t *cl) {
-  safe_free(learned(cl));
+static inline void delete_learned_clause(smt_core_t *s, clause_t *cl) {
+  arena_free(&s->arena, clause_words(clause_length(cl), true));
 }
 
 
@@ -411,6 +549,119 @@ static inline literal_t last_lv_elem(literal_t *v) {
 #endif
 
 
+/********************
+ *  WATCH VECTORS   *
+ *******************/
+
+/*
+ * Watch vectors are initially empty (data = NULL). Memory is
+ * allocated on the first addition.
+ */
+static inline void init_watch_vector(watch_vector_t *v) {
+  v->data = NULL;
+  v->start = 0;
+  v->size = 0;
+}
+
+
+/*
+ * Make room for one more element in vector v
+ * - allocate a fresh array if v->data == NULL
+ * - if v is full: move its elements to the start of the
+ *   array if that frees more than a quarter of the capacity,
+ *   otherwise resize the array.
+ */
+static void make_room_in_watch_vector(watch_vector_t *v) {
+  watcher_array_t *array;
+  uint32_t i, k, n;
+
+  if (v->data == NULL) {
+    n = DEF_WATCH_VECTOR_SIZE;
+    array = (watcher_array_t *)
+      safe_malloc(sizeof(watcher_array_t) + n * sizeof(watcher_t));
+    array->capacity = n;
+    v->data = array->data;
+    v->start = 0;
+    v->size = 0;
+  } else {
+    array = wa_header(v->data);
+    i = v->size;
+    n = array->capacity;
+    assert(i == n);
+    k = v->start;
+    if (k <= (n >> 2)) {
+      n ++;
+      n += n>>1; // new cap = 50% more than old capacity
+      if (n > MAX_WATCH_VECTOR_SIZE) {
+        out_of_memory();
+      }
+      array = (watcher_array_t *)
+        safe_realloc(array, sizeof(watcher_array_t) + n * sizeof(watcher_t));
+      array->capacity = n;
+      v->data = array->data;
+    }
+    if (k > 0) {
+      memmove(v->data, v->data + k, (i - k) * sizeof(watcher_t));
+      v->size = i - k;
+      v->start = 0;
+    }
+  }
+}
+
+
+/*
+ * Add watcher (cl, blocker) at the end of vector v
+ */
+static inline void add_watcher(watch_vector_t *v, clause_t *cl, literal_t blocker) {
+  uint32_t i;
+
+  if (v->data == NULL || v->size == get_wa_capacity(v->data)) {
+    make_room_in_watch_vector(v);
+  }
+
+  i = v->size;
+  assert(i < get_wa_capacity(v->data));
+  v->data[i].clause = cl;
+  v->data[i].blocker = blocker;
+  v->size = i+1;
+}
+
+
+/*
+ * Delete watch vector v: free its array and make it empty
+ */
+static void delete_watch_vector(watch_vector_t *v) {
+  if (v->data != NULL) {
+    safe_free(wa_header(v->data));
+  }
+  init_watch_vector(v);
+}
+
+
+/*
+ * Empty watch vector v
+ */
+static inline void reset_watch_vector(watch_vector_t *v) {
+  v->start = 0;
+  v->size = 0;
+}
+
+
+/*
+ * Add clause cl to the watch vectors of cl[0] and cl[1]
+ * - the blocker for each watched literal is the other one
+ */
+static void add_clause_watchers(smt_core_t *s, clause_t *cl) {
+  literal_t l0, l1;
+
+  l0 = cl->cl[0];
+  l1 = cl->cl[1];
+  assert(l0 >= 0 && l1 >= 0);
+  add_watcher(s->watch + l0, cl, l1);
+  add_watcher(s->watch + l1, cl, l0);
+}
+
+
 /***********
  *  STACK  *
  **********/
@@ -791,168 +1042,530 @@ static void rescale_var_activities(var_heap_t *heap, uint32_t n) {
 
 
 
-/*****************
- *  TRAIL STACK  *
- ****************/
+/****************
+ *  VMTF QUEUE  *
+ ***************/
 
 /*
- * Initialize a trail stack. Size = 0
+ * Initialize the queue for n variables: the queue is empty
  */
-static void init_trail_stack(trail_stack_t *stack) {
-  stack->size = 0;
-  stack->top = 0;
-  stack->data = NULL;
+static void init_vmtf(vmtf_queue_t *q, uint32_t n) {
+  uint32_t i;
+  uint64_t *tmp;
+
+  q->size = n;
+  q->prev = (bvar_t *) safe_malloc(n * sizeof(bvar_t));
+  q->next = (bvar_t *) safe_malloc(n * sizeof(bvar_t));
+  tmp = (uint64_t *) safe_malloc((n+1) * sizeof(uint64_t));
+  q->stamp = tmp + 1;
+
+  for (i=0; i<n; i++) {
+    q->stamp[i] = 0;
+  }
+  q->stamp[-1] = 0;
+
+  q->first = null_bvar;
+  q->last = null_bvar;
+  q->search = null_bvar;
+  q->counter = VMTF_INIT_STAMP;
+  q->low = VMTF_INIT_STAMP;
+  init_ivector(&q->bumped, 0);
 }
 
 /*
- * Save level:
- * - v = number of variables
- * - u = number of unit clauses
- * - b = number of binary clauses
- * - p = number of (non-unit and non-binary) problem clauses
- * - b_ptr = boolean propagation pointer
- * - t_ptr = theory propagation pointer
+ * Extend the queue for n variables
  */
-static void trail_stack_save(trail_stack_t *stack, uint32_t v, uint32_t u, uint32_t b, uint32_t p,
-                             uint32_t b_ptr, uint32_t t_ptr) {
-  uint32_t i, n;
+static void extend_vmtf(vmtf_queue_t *q, uint32_t n) {
+  uint32_t old_size, i;
+  uint64_t *tmp;
 
-  i = stack->top;
-  n = stack->size;
-  if (i == n) {
-    if (n == 0) {
-      n = DEFAULT_DPLL_TRAIL_SIZE;
-    } else {
-      n += n;
-      if (n >= MAX_DPLL_TRAIL_SIZE) {
-        out_of_memory();
-      }
-    }
-    stack->data = (trail_t *) safe_realloc(stack->data, n * sizeof(trail_t));
-    stack->size = n;
-  }
-  stack->data[i].nvars = v;
-  stack->data[i].nunits = u;
-  stack->data[i].nbins = b;
-  stack->data[i].nclauses = p;
-  stack->data[i].prop_ptr = b_ptr;
-  stack->data[i].theory_ptr = t_ptr;
+  old_size = q->size;
+  assert(old_size < n);
+  q->size = n;
+  q->prev = (bvar_t *) safe_realloc(q->prev, n * sizeof(bvar_t));
+  q->next = (bvar_t *) safe_realloc(q->next, n * sizeof(bvar_t));
+  tmp = q->stamp - 1;
+  tmp = (uint64_t *) safe_realloc(tmp, (n+1) * sizeof(uint64_t));
+  q->stamp = tmp + 1;
 
-  stack->top = i + 1;
+  for (i=old_size; i<n; i++) {
+    q->stamp[i] = 0;
+  }
 }
 
-
 /*
- * Get top record
+ * Free the queue
  */
-static inline trail_t *trail_stack_top(trail_stack_t *stack) {
-  assert(stack->top > 0);
-  return stack->data + (stack->top - 1);
+static void delete_vmtf(vmtf_queue_t *q) {
+  safe_free(q->prev);
+  safe_free(q->next);
+  safe_free(q->stamp - 1);
+  delete_ivector(&q->bumped);
 }
 
 /*
- * Remove top record
+ * Reset: remove all variables from the queue
  */
-static inline void trail_stack_pop(trail_stack_t *stack) {
-  assert(stack->top > 0);
-  stack->top --;
+static void reset_vmtf(vmtf_queue_t *q) {
+  uint32_t i, n;
+
+  n = q->size;
+  for (i=0; i<n; i++) {
+    q->stamp[i] = 0;
+  }
+  q->first = null_bvar;
+  q->last = null_bvar;
+  q->search = null_bvar;
+  q->counter = VMTF_INIT_STAMP;
+  q->low = VMTF_INIT_STAMP;
+  ivector_reset(&q->bumped);
 }
 
 
 /*
- * Empty the stack
+ * Check whether x is in the queue
  */
-static inline void reset_trail_stack(trail_stack_t *stack) {
-  stack->top = 0;
+static inline bool vmtf_member(vmtf_queue_t *q, bvar_t x) {
+  return q->stamp[x] > 0;
 }
 
 
 /*
- * Delete
+ * Add x at the end of the list (with a new stamp)
+ * - x must not be in the list
  */
-static inline void delete_trail_stack(trail_stack_t *stack) {
-  safe_free(stack->data);
-  stack->data = NULL;
-}
-
+static void vmtf_append(vmtf_queue_t *q, bvar_t x) {
+  assert(! vmtf_member(q, x));
 
+  q->prev[x] = q->last;
+  q->next[x] = null_bvar;
+  if (q->last == null_bvar) {
+    q->first = x;
+  } else {
+    q->next[q->last] = x;
+  }
+  q->last = x;
+  q->counter ++;
+  q->stamp[x] = q->counter;
+}
 
-/******************
- *   ATOM TABLE   *
- *****************/
 
 /*
- * Initialization: the table is initially empty.
+ * Add x at the start of the list (with a new stamp): this gives x
+ * the lowest priority, like a new variable in the heap
+ * - x must not be in the list and it must be unassigned
  */
-static void init_atom_table(atom_table_t *tbl) {
-  tbl->has_atom = NULL;
-  tbl->atom = NULL;
-  tbl->size = 0;
-  tbl->natoms = 0;
+static void vmtf_prepend(vmtf_queue_t *q, bvar_t x) {
+  assert(! vmtf_member(q, x) && q->low > 1);
+
+  q->prev[x] = null_bvar;
+  q->next[x] = q->first;
+  if (q->first == null_bvar) {
+    q->last = x;
+  } else {
+    q->prev[q->first] = x;
+  }
+  q->first = x;
+  q->low --;
+  q->stamp[x] = q->low;
+  if (q->search == null_bvar) {
+    q->search = x;
+  }
 }
 
 
 /*
- * Make room for more atoms: n = new size
+ * Remove x from the list
+ * - x must be in the list and it must not be the search variable
  */
-static void resize_atom_table(atom_table_t *tbl, uint32_t n) {
-  uint32_t k;
+static void vmtf_unlink(vmtf_queue_t *q, bvar_t x) {
+  bvar_t p, n;
 
-  // round up to a multiple of 8
-  n = (n + 7) & ~7;
-  k = tbl->size;
+  assert(vmtf_member(q, x) && q->search != x);
 
-  if (n > k) {
-    assert(n <= MAX_ATOM_TABLE_SIZE);
+  p = q->prev[x];
+  n = q->next[x];
+  if (p == null_bvar) {
+    q->first = n;
+  } else {
+    q->next[p] = n;
+  }
+  if (n == null_bvar) {
+    q->last = p;
+  } else {
+    q->prev[n] = p;
+  }
+  q->stamp[x] = 0;
+}
 
-    tbl->has_atom = extend_bitvector(tbl->has_atom, n);
-    tbl->atom = (void **) safe_realloc(tbl->atom, n * sizeof(void *));
-    tbl->size = n;
 
-    // clear new bitvector elements
-    clear_bitvector(tbl->has_atom + (k>>3), n - k);
+/*
+ * Insert x in the queue if it's not present, then update
+ * the search variable.
+ * - x must be unassigned
+ */
+static void vmtf_insert(vmtf_queue_t *q, bvar_t x) {
+  if (! vmtf_member(q, x)) {
+    vmtf_append(q, x);
+  }
+  if (q->stamp[x] > q->stamp[q->search]) {
+    q->search = x;
   }
 }
 
 
 /*
- * Deletion
+ * Remove x from the queue (no effect if x is not in the queue)
  */
-static void delete_atom_table(atom_table_t *tbl) {
-  delete_bitvector(tbl->has_atom);
-  safe_free(tbl->atom);
-  tbl->has_atom = NULL;
-  tbl->atom = NULL;
+static void vmtf_remove(vmtf_queue_t *q, bvar_t x) {
+  if (vmtf_member(q, x)) {
+    if (q->search == x) {
+      q->search = q->prev[x];
+    }
+    vmtf_unlink(q, x);
+  }
 }
 
 
 /*
- * Reset the table: empty it
+ * Move x to the end of the list
+ * - unassigned = true if x is unassigned
  */
-static void reset_atom_table(atom_table_t *tbl) {
-  tbl->natoms = 0;
-  clear_bitvector(tbl->has_atom, tbl->size);
+static void vmtf_move_to_end(vmtf_queue_t *q, bvar_t x, bool unassigned) {
+  assert(vmtf_member(q, x));
+
+  if (q->last != x) {
+    if (q->search == x) {
+      q->search = q->prev[x];
+    }
+    vmtf_unlink(q, x);
+    vmtf_append(q, x);
+  }
+  if (unassigned) {
+    q->search = x;
+  }
 }
 
 
 
 
+/********************
+ *  DECISION QUEUE  *
+ *******************/
+
 /*
- * Attach atom atm to variable v:
- * - v must not have an atom attached already and there must be enough
- * room in tbl for variable v (i.e., tbl must be resized before this
- * function is called).
+ * The heap and the VMTF queue are accessed via the following
+ * functions. Only the queue in use is kept up to date.
  */
-static void add_atom(atom_table_t *tbl, bvar_t v, void *atm) {
-  assert(v < tbl->size && !tst_bit(tbl->has_atom, v));
-  set_bit(tbl->has_atom, v);
-  tbl->atom[v] = atm;
-  tbl->natoms ++;
-}
 
+/*
+ * Add a new variable x to the queue
+ * - x has activity 0 so it's after all the bumped variables in the heap.
+ *   Likewise, it's added at the start of the VMTF list.
+ */
+static inline void decision_queue_add(smt_core_t *s, bvar_t x) {
+  if (s->use_vmtf) {
+    vmtf_prepend(&s->vmtf, x);
+  } else {
+    heap_insert(&s->heap, x);
+  }
+}
 
 /*
- * Remove the atom attached to v
+ * Add x to the queue (after backtracking, or when x is restored)
+ */
+static inline void decision_queue_insert(smt_core_t *s, bvar_t x) {
+  if (s->use_vmtf) {
+    vmtf_insert(&s->vmtf, x);
+  } else {
+    heap_insert(&s->heap, x);
+  }
+}
+
+/*
+ * Remove x from the queue (when x is deleted or eliminated)
+ */
+static inline void decision_queue_remove(smt_core_t *s, bvar_t x) {
+  if (s->use_vmtf) {
+    vmtf_remove(&s->vmtf, x);
+  } else {
+    heap_remove(&s->heap, x);
+  }
+}
+
+
+/*
+ * Get the next decision variable: the unassigned variable of highest
+ * activity (heap) or the most recently bumped unassigned variable (VMTF).
+ * - return null_bvar if all variables are assigned
+ * - eliminated variables may be in the heap after backtracking
+ *   but they must not be decided
+ */
+static bvar_t decision_queue_select(smt_core_t *s) {
+  vmtf_queue_t *q;
+  uint8_t *v;
+  bvar_t x;
+
+  v = s->value;
+  if (s->use_vmtf) {
+    q = &s->vmtf;
+    x = q->search;
+    while (x >= 0 && (bval_is_def(v[x]) || bvar_is_eliminated(s, x))) {
+      x = q->prev[x];
+    }
+    q->search = x;
+    return x;
+  }
+
+  while (! heap_is_empty(&s->heap)) {
+    x = heap_get_top(&s->heap);
+    if (bval_is_undef(v[x]) && ! bvar_is_eliminated(s, x)) {
+      return x;
+    }
+  }
+  return null_bvar;
+}
+
+
+/*
+ * Ordering for enable_vmtf: x precedes y if y is before x in the heap ordering
+ * (so that the most active variable is at the end of the VMTF list).
+ */
+static bool vmtf_init_precedes(void *data, bvar_t x, bvar_t y) {
+  return heap_precedes(data, y, x);
+}
+
+/*
+ * Switch to the VMTF queue: add all variables that are not eliminated
+ * in increasing order of activity. The heap is emptied.
+ */
+void enable_vmtf(smt_core_t *s) {
+  vmtf_queue_t *q;
+  var_heap_t *heap;
+  ivector_t *v;
+  uint32_t i, n;
+
+  assert(s->status != STATUS_SEARCHING);
+
+  if (! s->use_vmtf) {
+    heap = &s->heap;
+    n = heap->size;
+    for (i=0; i<n; i++) {
+      heap->heap_index[i] = -1;
+    }
+    heap->heap_last = 0;
+
+    q = &s->vmtf;
+    reset_vmtf(q);
+
+    v = &q->bumped;
+    n = s->nvars;
+    for (i=0; i<n; i++) {
+      if (! bvar_is_eliminated(s, i)) {
+        ivector_push(v, i);
+      }
+    }
+    int_array_sort2(v->data, v->size, s->heap.activity, vmtf_init_precedes);
+
+    n = v->size;
+    for (i=0; i<n; i++) {
+      vmtf_append(q, v->data[i]);
+    }
+    q->search = q->last;
+    ivector_reset(v);
+
+    s->use_vmtf = true;
+  }
+}
+
+/*
+ * Switch back to the heap: add all variables that are not eliminated
+ * (the heap is empty in VMTF mode)
+ */
+void disable_vmtf(smt_core_t *s) {
+  var_heap_t *heap;
+  uint32_t i, n;
+
+  assert(s->status != STATUS_SEARCHING);
+
+  if (s->use_vmtf) {
+    heap = &s->heap;
+    assert(heap->heap_last == 0);
+    n = s->nvars;
+    for (i=0; i<n; i++) {
+      if (! bvar_is_eliminated(s, i)) {
+        heap_insert(heap, i);
+      }
+    }
+
+    s->use_vmtf = false;
+  }
+}
+
+
+
+/*****************
+ *  TRAIL STACK  *
+ ****************/
+
+/*
+ * Initialize a trail stack. Size = 0
+ */
+static void init_trail_stack(trail_stack_t *stack) {
+  stack->size = 0;
+  stack->top = 0;
+  stack->data = NULL;
+}
+
+/*
+ * Save level:
+ * - v = number of variables
+ * - u = number of unit clauses
+ * - b = number of binary clauses
+ * - p = number of (non-unit and non-binary) problem clauses
+ * - b_ptr = boolean propagation pointer
+ * - t_ptr = theory propagation pointer
+ */
+static void trail_stack_save(trail_stack_t *stack, uint32_t v, uint32_t u, uint32_t b, uint32_t p,
+                             uint32_t b_ptr, uint32_t t_ptr) {
+  uint32_t i, n;
+
+  i = stack->top;
+  n = stack->size;
+  if (i == n) {
+    if (n == 0) {
+      n = DEFAULT_DPLL_TRAIL_SIZE;
+    } else {
+      n += n;
+      if (n >= MAX_DPLL_TRAIL_SIZE) {
+        out_of_memory();
+      }
+    }
+    stack->data = (trail_t *) safe_realloc(stack->data, n * sizeof(trail_t));
+    stack->size = n;
+  }
+  stack->data[i].nvars = v;
+  stack->data[i].nunits = u;
+  stack->data[i].nbins = b;
+  stack->data[i].nclauses = p;
+  stack->data[i].prop_ptr = b_ptr;
+  stack->data[i].theory_ptr = t_ptr;
+
+  stack->top = i + 1;
+}
+
+
+/*
+ * Get top record
+ */
+static inline trail_t *trail_stack_top(trail_stack_t *stack) {
+  assert(stack->top > 0);
+  return stack->data + (stack->top - 1);
+}
+
+/*
+ * Remove top record
+ */
+static inline void trail_stack_pop(trail_stack_t *stack) {
+  assert(stack->top > 0);
+  stack->top --;
+}
+
+
+/*
+ * Empty the stack
+ */
+static inline void reset_trail_stack(trail_stack_t *stack) {
+  stack->top = 0;
+}
+
+
+/*
+ * Delete
+ */
+static inline void delete_trail_stack(trail_stack_t *stack) {
+  safe_free(stack->data);
+  stack->data = NULL;
+}
+
+
+
+/******************
+ *   ATOM TABLE   *
+ *****************/
+
+/*
+ * Initialization: the table is initially empty.
+ */
+static void init_atom_table(atom_table_t *tbl) {
+  tbl->has_atom = NULL;
+  tbl->atom = NULL;
+  tbl->size = 0;
+  tbl->natoms = 0;
+}
+
+
+/*
+ * Make room for more atoms: n = new size
+ */
+static void resize_atom_table(atom_table_t *tbl, uint32_t n) {
+  uint32_t k;
+
+  // round up to a multiple of 8
+  n = (n + 7) & ~7;
+  k = tbl->size;
+
+  if (n > k) {
+    assert(n <= MAX_ATOM_TABLE_SIZE);
+
+    tbl->has_atom = extend_bitvector(tbl->has_atom, n);
+    tbl->atom = (void **) safe_realloc(tbl->atom, n * sizeof(void *));
+    tbl->size = n;
+
+    // clear new bitvector elements
+    clear_bitvector(tbl->has_atom + (k>>3), n - k);
+  }
+}
+
+
+/*
+ * Deletion
+ */
+static void delete_atom_table(atom_table_t *tbl) {
+  delete_bitvector(tbl->has_atom);
+  safe_free(tbl->atom);
+  tbl->has_atom = NULL;
+  tbl->atom = NULL;
+}
+
+
+/*
+ * Reset the table: empty it
+ */
+static void reset_atom_table(atom_table_t *tbl) {
+  tbl->natoms = 0;
+  clear_bitvector(tbl->has_atom, tbl->size);
+}
+
+
+
+
+/*
+ * Attach atom atm to variable v:
+ * - v must not have an atom attached already and there must be enough
+ * room in tbl for variable v (i.e., tbl must be resized before this
+ * function is called).
+ */
+static void add_atom(atom_table_t *tbl, bvar_t v, void *atm) {
+  assert(v < tbl->size && !tst_bit(tbl->has_atom, v));
+  set_bit(tbl->has_atom, v);
+  tbl->atom[v] = atm;
+  tbl->natoms ++;
+}
+
+
+/*
+ * Remove the atom attached to v
  */
 static void remove_atom(atom_table_t *tbl, bvar_t v) {
   assert(v < tbl->size && tst_bit(tbl->has_atom, v));
@@ -1272,6 +1885,9 @@ static void init_statistics(dpll_stats_t *stat) {
   stat->simplify_calls = 0;
   stat->reduce_calls = 0;
   stat->remove_calls = 0;
+  stat->glue_updates = 0;
+  stat->arena_compactions = 0;
+  stat->chrono_backtracks = 0;
   stat->decisions = 0;
   stat->random_decisions = 0;
   stat->propagations = 0;
@@ -1284,9 +1900,18 @@ static void init_statistics(dpll_stats_t *stat) {
   stat->learned_literals = 0;
   stat->prob_clauses_deleted = 0;
   stat->learned_clauses_deleted = 0;
+  stat->core_clauses = 0;
   stat->bin_clauses_deleted = 0;
   stat->literals_before_simpl = 0;
   stat->subsumed_literals = 0;
+  stat->exported_clauses = 0;
+  stat->imported_clauses = 0;
+  stat->preprocess_calls = 0;
+  stat->failed_literals = 0;
+  stat->elim_vars = 0;
+  stat->restored_vars = 0;
+  stat->subsumed_clauses = 0;
+  stat->strengthened_clauses = 0;
 }
 
 
@@ -1517,6 +2142,10 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->th_cache_enabled = false;
   s->th_cache_cl_size = 0;
 
+  // chronological backtracking: disabled initially
+  s->chrono_enabled = false;
+  s->chrono_threshold = CHRONO_THRESHOLD;
+
   // conflict data: no need to initialize conflict_buffer
   s->inconsistent = false;
   s->theory_conflict = false;
@@ -1527,8 +2156,17 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   init_ivector(&s->buffer, DEF_LBUFFER_SIZE);
   init_ivector(&s->buffer2, DEF_LBUFFER_SIZE);
   init_ivector(&s->explanation, DEF_LBUFFER_SIZE);
+  init_tag_map(&s->glue_map, 0);
+
+  // restart heuristics: focused mode initially
+  s->lbd_fast = 0.0;
+  s->lbd_slow = 0.0;
+  s->stable = false;
+  s->target_phase = allocate_bitvector0(n);
+  s->target_assigned = 0;
 
   // clause database: all empty
+  init_clause_arena(&s->arena);
   s->problem_clauses = new_clause_vector(DEF_CLAUSE_VECTOR_SIZE);
   s->learned_clauses = new_clause_vector(DEF_CLAUSE_VECTOR_SIZE);
   init_ivector(&s->binary_clauses, 0);
@@ -1552,7 +2190,7 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
    * Literal-indexed arrays
    */
   s->bin = (literal_t **) safe_malloc(lsize * sizeof(literal_t *));
-  s->watch = (link_t *) safe_malloc(lsize * sizeof(link_t));
+  s->watch = (watch_vector_t *) safe_malloc(lsize * sizeof(watch_vector_t));
 
   /*
    * Initialize data structures for true_literal and false_literal
@@ -1566,11 +2204,13 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
 
   s->bin[true_literal] = NULL;
   s->bin[false_literal] = NULL;
-  s->watch[true_literal] = NULL_LINK;
-  s->watch[false_literal] = NULL_LINK;
+  init_watch_vector(s->watch + true_literal);
+  init_watch_vector(s->watch + false_literal);
 
   init_stack(&s->stack, n);
+  s->use_vmtf = false;
   init_heap(&s->heap, n);
+  init_vmtf(&s->vmtf, n);
   init_lemma_queue(&s->lemmas);
   init_statistics(&s->stats);
   init_atom_table(&s->atoms);
@@ -1580,6 +2220,20 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
 
   s->etable = NULL;
   s->trace = NULL;
+
+  s->ring = NULL;
+  s->ring_cursor = 0;
+  s->ring_id = 0;
+
+  s->sat_preprocess = false;
+  s->elim = allocate_bitvector0(n);
+  init_ivector(&s->elim_stack, 0);
+  s->nb_elim_vars = 0;
+
+  init_ivector(&s->assumptions, 0);
+  s->assumption_index = 0;
+  s->bad_assumption = null_literal;
+  init_ivector(&s->failed_assumptions, 0);
 }
 
 
@@ -1601,26 +2255,17 @@ void smt_core_reset_thsolver(smt_core_t *s, void *th, th_ctrl_interface_t *ctrl,
  */
 void delete_smt_core(smt_core_t *s) {
   uint32_t i, n;
-  clause_t **cl;
 
   delete_ivector(&s->buffer);
   delete_ivector(&s->buffer2);
   delete_ivector(&s->explanation);
+  delete_tag_map(&s->glue_map);
+  delete_bitvector(s->target_phase);
 
   // Delete all the clauses
-  cl = s->problem_clauses;
-  n = get_cv_size(cl);
-  for (i=0; i<n; i++) {
-    delete_clause(cl[i]);
-  }
-  delete_clause_vector(cl);
-
-  cl = s->learned_clauses;
-  n = get_cv_size(cl);
-  for (i=0; i<n; i++) {
-    delete_learned_clause(cl[i]);
-  }
-  delete_clause_vector(cl);
+  delete_clause_arena(&s->arena);
+  delete_clause_vector(s->problem_clauses);
+  delete_clause_vector(s->learned_clauses);
 
   delete_ivector(&s->binary_clauses);
 
@@ -1634,17 +2279,25 @@ void delete_smt_core(smt_core_t *s) {
   n = s->nlits;
   for (i=0; i<n; i++) {
     delete_literal_vector(s->bin[i]);
+    delete_watch_vector(s->watch + i);
   }
   safe_free(s->bin);
   safe_free(s->watch);
 
   delete_stack(&s->stack);
   delete_heap(&s->heap);
+  delete_vmtf(&s->vmtf);
   delete_lemma_queue(&s->lemmas);
   delete_atom_table(&s->atoms);
   delete_trail_stack(&s->trail_stack);
   delete_checkpoint_stack(&s->checkpoints);
 
+  delete_bitvector(s->elim);
+  delete_ivector(&s->elim_stack);
+
+  delete_ivector(&s->assumptions);
+  delete_ivector(&s->failed_assumptions);
+
   // EXPERIMENTAL
   //  delete_etable(s);
 }
@@ -1657,35 +2310,26 @@ void delete_smt_core(smt_core_t *s) {
  */
 void reset_smt_core(smt_core_t *s) {
   uint32_t i, n;
-  clause_t **cl;
 
   s->status = STATUS_IDLE;
 
   // delete the clauses
-  cl = s->problem_clauses;
-  n = get_cv_size(cl);
-  for (i=0; i<n; i++) {
-    delete_clause(cl[i]);
-  }
-  reset_clause_vector(cl);
-
-  cl = s->learned_clauses;
-  n = get_cv_size(cl);
-  for (i=0; i<n; i++) {
-    delete_learned_clause(cl[i]);
-  }
-  reset_clause_vector(cl);
+  reset_clause_arena(&s->arena);
+  reset_clause_vector(s->problem_clauses);
+  reset_clause_vector(s->learned_clauses);
 
   ivector_reset(&s->binary_clauses);
 
-  // delete binary-watched literal vectors
+  // delete binary-watched literal vectors and watch vectors
   n = s->nlits;
   for (i=0; i<n; i++) {
     delete_literal_vector(s->bin[i]);
+    delete_watch_vector(s->watch + i);
   }
 
   reset_stack(&s->stack);
   reset_heap(&s->heap);
+  reset_vmtf(&s->vmtf);
   reset_lemma_queue(&s->lemmas);
   reset_statistics(&s->stats);
   reset_atom_table(&s->atoms);
@@ -1693,6 +2337,22 @@ void reset_smt_core(smt_core_t *s) {
   reset_checkpoint_stack(&s->checkpoints);
   s->cp_flag = false;
 
+  // the elim bits are cleared when variables are created
+  ivector_reset(&s->elim_stack);
+  s->nb_elim_vars = 0;
+
+  // restart heuristics: the target_phase bits are also cleared
+  // when variables are created
+  s->lbd_fast = 0.0;
+  s->lbd_slow = 0.0;
+  s->stable = false;
+  s->target_assigned = 0;
+
+  ivector_reset(&s->assumptions);
+  s->assumption_index = 0;
+  s->bad_assumption = null_literal;
+  ivector_reset(&s->failed_assumptions);
+
   // reset all counters
   s->nvars = 1;
   s->nlits = 2;
@@ -1748,11 +2408,14 @@ static void extend_smt_core(smt_core_t *s, uint32_t n) {
   s->antecedent = (antecedent_t *) safe_realloc(s->antecedent, n * sizeof(antecedent_t));
   s->level = (uint32_t *) safe_realloc(s->level - 1, (n + 1) * sizeof(uint32_t)) + 1;
   s->mark = extend_bitvector(s->mark, n);
+  s->elim = extend_bitvector(s->elim, n);
+  s->target_phase = extend_bitvector(s->target_phase, n);
 
   s->bin = (literal_t **) safe_realloc(s->bin, lsize * sizeof(literal_t *));
-  s->watch = (link_t *) safe_realloc(s->watch, lsize * sizeof(link_t));
+  s->watch = (watch_vector_t *) safe_realloc(s->watch, lsize * sizeof(watch_vector_t));
 
   extend_heap(&s->heap, n);
+  extend_vmtf(&s->vmtf, n);
   extend_stack(&s->stack, n);
 }
 
@@ -1814,12 +2477,14 @@ void smt_core_set_trace(smt_core_t *s, tracer_t *tracer) {
  *
  * For l=pos_lit(x) and neg_lit(x):
  * - bin[l] = NULL
- * - watch[l] = NULL
+ * - watch[l] = empty vector
  */
 static void init_variable(smt_core_t *s, bvar_t x) {
   literal_t l0, l1;
 
   clr_bit(s->mark, x);
+  clr_bit(s->elim, x);
+  clr_bit(s->target_phase, x);
   s->value[x] = VAL_UNDEF_FALSE;
   s->antecedent[x] = mk_literal_antecedent(null_literal);
   s->level[x] = UINT32_MAX;
@@ -1834,14 +2499,14 @@ static void init_variable(smt_core_t *s, bvar_t x) {
 #if 0
   printf("bvar %"PRId32": activity = %f\n", x, s->heap.activity[x]);
 #endif
-  heap_insert(&s->heap, x);
+  decision_queue_add(s, x);
 
   l0 = pos_lit(x);
   l1 = neg_lit(x);
   s->bin[l0] = NULL;
   s->bin[l1] = NULL;
-  s->watch[l0] = NULL_LINK;
-  s->watch[l1] = NULL_LINK;
+  init_watch_vector(s->watch + l0);
+  init_watch_vector(s->watch + l1);
 }
 
 /*
@@ -1901,6 +2566,13 @@ void add_boolean_variables(smt_core_t *s, uint32_t n) {
  */
 void attach_atom_to_bvar(smt_core_t *s, bvar_t x, void *atom) {
   atom_table_t *tbl;
+  literal_t l;
+
+  if (bvar_is_eliminated(s, x)) {
+    // atoms are frozen: x must be restored
+    l = pos_lit(x);
+    smt_restore_literals(s, 1, &l);
+  }
 
   tbl = &s->atoms;
   if (tbl->size <= x) {
@@ -1958,10 +2630,14 @@ void remove_bvar_atom(smt_core_t *s, bvar_t x) {
  */
 void set_bvar_activity(smt_core_t *s, bvar_t x, double a) {
   assert(0 <= x && x < s->nvars && a < DBL_MAX);
-  heap_remove(&s->heap, x);
-  s->heap.activity[x] = a;
-  heap_insert(&s->heap, x);
-}
+  if (s->use_vmtf) {
+    s->heap.activity[x] = a;
+  } else {
+    heap_remove(&s->heap, x);
+    s->heap.activity[x] = a;
+    heap_insert(&s->heap, x);
+  }
+}
 
 
 
@@ -2043,18 +2719,22 @@ void decide_literal(smt_core_t *s, literal_t l) {
 
 
 /*
- * Assign literal l to true with the given antecedent
- * - s->mark[v] is set if decision level = base level
+ * Assign literal l to true with the given antecedent at level k
+ * - k must be between base_level and decision_level
+ * - if k < decision_level, l is assigned out of order (this is
+ *   used by chronological backtracking)
+ * - s->mark[v] is set if k = base level
  */
-static void implied_literal(smt_core_t *s, literal_t l, antecedent_t a) {
+static void implied_literal_at_level(smt_core_t *s, literal_t l, antecedent_t a, uint32_t k) {
   bvar_t v;
 
   assert(literal_is_unassigned(s, l));
+  assert(s->base_level <= k && k <= s->decision_level);
 
 #if TRACE
   printf("---> DPLL:   Implied literal ");
   print_literal(stdout, l);
-  printf(", decision level = %"PRIu32"\n", s->decision_level);
+  printf(", level = %"PRIu32", decision level = %"PRIu32"\n", k, s->decision_level);
   fflush(stdout);
 #endif
 
@@ -2064,9 +2744,9 @@ static void implied_literal(smt_core_t *s, literal_t l, antecedent_t a) {
 
   v = var_of(l);
   s->value[v] = (VAL_TRUE ^ sign_of_lit(l));
-  s->level[v] = s->decision_level;
+  s->level[v] = k;
   s->antecedent[v] = a;
-  if (s->decision_level == s->base_level) {
+  if (k == s->base_level) {
     set_bit(s->mark, v);
     s->nb_unit_clauses ++;
   }
@@ -2074,6 +2754,13 @@ static void implied_literal(smt_core_t *s, literal_t l, antecedent_t a) {
   assert(literal_value(s, l) == VAL_TRUE && literal_value(s, not(l)) == VAL_FALSE);
 }
 
+/*
+ * Assign literal l to true with the given antecedent at the current decision level
+ */
+static inline void implied_literal(smt_core_t *s, literal_t l, antecedent_t a) {
+  implied_literal_at_level(s, l, a, s->decision_level);
+}
+
 
 void propagate_literal(smt_core_t *s, literal_t l, void *expl) {
   bvar_t v;
@@ -2121,7 +2808,9 @@ literal_t select_unassigned_literal(smt_core_t *s) {
   uint8_t *v;
 
 #if DEBUG
-  check_heap(s);
+  if (! s->use_vmtf) {
+    check_heap(s);
+  }
 #endif
 
   v = s->value;
@@ -2131,7 +2820,7 @@ literal_t select_unassigned_literal(smt_core_t *s) {
     if (rnd < s->scaled_random) {
       x = random_uint(s, s->nvars);
       assert(0 <= x && x < s->nvars);
-      if (bval_is_undef(v[x])) {
+      if (bval_is_undef(v[x]) && ! bvar_is_eliminated(s, x)) {
 #if TRACE
 	printf("---> DPLL:   Random selection: variable ");
 	print_bvar(stdout, x);
@@ -2145,20 +2834,20 @@ literal_t select_unassigned_literal(smt_core_t *s) {
   }
 
   /*
-   * select unassigned variable x with highest activity
+   * select the next variable from the decision queue
    */
-  while (! heap_is_empty(&s->heap)) {
-    x = heap_get_top(&s->heap);
-    if (bval_is_undef(v[x])) {
-      goto var_found;
-    }
+  x = decision_queue_select(s);
+  if (x < 0) {
+    // all variables are assigned
+    return null_literal;
   }
 
-  // empty heap
-  return null_literal;
-
 
  var_found:
+  if (s->stable) {
+    // use the target phase
+    return mk_signed_lit(x, tst_bit(s->target_phase, x));
+  }
   // if polarity x == 1 use pos_lit(x) otherwise use neg_lit(x)
   return mk_signed_lit(x, v[x] & 1);
 }
@@ -2167,24 +2856,11 @@ literal_t select_unassigned_literal(smt_core_t *s) {
 
 /*
  * Get the unassigned variable of highest activity
+ * (or the first unassigned variable in the VMTF queue)
  * return null_bvar if all variables are assigned
  */
 bvar_t select_most_active_bvar(smt_core_t *s) {
-  bvar_t x;
-  uint8_t *v;
-
-  v = s->value;
-  while (! heap_is_empty(&s->heap)) {
-    x = heap_get_top(&s->heap);
-    if (bval_is_undef(v[x])) {
-      goto var_found;
-    }
-  }
-
-  x = null_bvar;
-
- var_found:
-  return x;
+  return decision_queue_select(s);
 }
 
 
@@ -2203,10 +2879,13 @@ bvar_t select_random_bvar(smt_core_t *s) {
   x = random_uint(s, n); // 0 ... n-1
   assert(0 <= x && x < n);
 
-  if (bval_is_undef(v[x])) return x;
+  if (bval_is_undef(v[x]) && ! bvar_is_eliminated(s, x)) return x;
 
   if (all_variables_assigned(s)) return null_bvar;
 
+  // the search below may not terminate if eliminated variables are unassigned
+  if (s->nb_elim_vars > 0) return select_most_active_bvar(s);
+
   // d = random increment, must be prime with n.
   d = 1 + random_uint(s, n - 1); // 1 ... n-1
   while (gcd32(d, n) != 1) d--;
@@ -2227,6 +2906,8 @@ bvar_t select_random_bvar(smt_core_t *s) {
 
 /*
  * Increase activity of variable x
+ * - in VMTF mode, x is stored in the bumped vector. It's moved
+ *   to the end of the queue by vmtf_bump_variables
  */
 static void increase_bvar_activity(smt_core_t *s, bvar_t x) {
   int32_t i;
@@ -2235,6 +2916,11 @@ static void increase_bvar_activity(smt_core_t *s, bvar_t x) {
   bool rescaled = false;
 #endif
 
+  if (s->use_vmtf) {
+    ivector_push(&s->vmtf.bumped, x);
+    return;
+  }
+
   heap = &s->heap;
   if ((heap->activity[x] += heap->act_increment) > VAR_ACTIVITY_THRESHOLD) {
     rescale_var_activities(heap, s->nvars);
@@ -2258,6 +2944,41 @@ static void increase_bvar_activity(smt_core_t *s, bvar_t x) {
 }
 
 
+/*
+ * Ordering of the bumped variables in VMTF mode: the variables are
+ * sorted by stamp so that their relative order is preserved.
+ * Theory-aware bumping: variables with an atom attached are moved
+ * after the others, so they're the first to be decided.
+ */
+static bool vmtf_bump_precedes(void *data, bvar_t x, bvar_t y) {
+  smt_core_t *s;
+  bool ax, ay;
+
+  s = data;
+  ax = bvar_has_atom(s, x);
+  ay = bvar_has_atom(s, y);
+  return ax < ay || (ax == ay && s->vmtf.stamp[x] < s->vmtf.stamp[y]);
+}
+
+/*
+ * Move all the bumped variables to the end of the VMTF queue
+ */
+static void vmtf_bump_variables(smt_core_t *s) {
+  vmtf_queue_t *q;
+  bvar_t *a;
+  uint32_t i, n;
+
+  q = &s->vmtf;
+  a = q->bumped.data;
+  n = q->bumped.size;
+  int_array_sort2(a, n, s, vmtf_bump_precedes);
+  for (i=0; i<n; i++) {
+    vmtf_move_to_end(q, a[i], bvar_is_unassigned(s, a[i]));
+  }
+  ivector_reset(&q->bumped);
+}
+
+
 
 /***********************
  *  CLAUSE ACTIVITIES  *
@@ -2292,6 +3013,85 @@ static void increase_clause_activity(smt_core_t *s, clause_t *cl) {
 
 
 
+/*****************
+ *  CLAUSE GLUE  *
+ ****************/
+
+/*
+ * Glue score of a[0 ... n-1] = number of distinct decision levels
+ * in level[var_of(a[0])], ..., level[var_of(a[n-1])].
+ * - all literals of a must be assigned
+ */
+static uint32_t glue_score(smt_core_t *s, uint32_t n, const literal_t *a) {
+  tag_map_t *map;
+  uint32_t i, k, glue;
+
+  map = &s->glue_map;
+  glue = 0;
+  for (i=0; i<n; i++) {
+    assert(literal_is_assigned(s, a[i]));
+    k = s->level[var_of(a[i])];
+    if (tag_map_read(map, k) == 0) {
+      tag_map_write(map, k, 1);
+      glue ++;
+    }
+  }
+  clear_tag_map(map);
+
+  return glue;
+}
+
+
+/*
+ * Set the initial glue of a new learned clause cl
+ */
+static void init_clause_glue(smt_core_t *s, clause_t *cl, uint32_t glue) {
+  set_glue(cl, glue);
+  if (is_core_clause(cl)) {
+    s->stats.core_clauses ++;
+  }
+}
+
+
+/*
+ * Update the glue of a learned clause cl that's used in conflict resolution
+ * - all literals of cl are assigned
+ * - core clauses are skipped: their glue can't matter anymore
+ */
+static void update_clause_glue(smt_core_t *s, clause_t *cl) {
+  literal_t *a;
+  uint32_t n, glue;
+
+  if (! is_core_clause(cl)) {
+    a = cl->cl;
+    n = 0;
+    while (a[n] >= 0) n ++;
+    glue = glue_score(s, n, a);
+    if (glue < get_glue(cl)) {
+      set_glue(cl, glue);
+      s->stats.glue_updates ++;
+      if (is_core_clause(cl)) {
+        s->stats.core_clauses ++;
+      }
+    }
+  }
+}
+
+
+/*
+ * Learned clause cl is involved in conflict resolution:
+ * - increase its activity and update its glue
+ * - mark it as used: it will survive the next reduction (or
+ *   the next two if it's in the second tier).
+ */
+static void bump_learned_clause(smt_core_t *s, clause_t *cl) {
+  increase_clause_activity(s, cl);
+  update_clause_glue(s, cl);
+  learned(cl)->used = (get_glue(cl) <= TIER2_GLUE) ? 2 : 1;
+}
+
+
+
 
 /*******************
  *  BACKTRACKING   *
@@ -2303,10 +3103,16 @@ static void increase_clause_activity(smt_core_t *s, clause_t *cl) {
  * - requires decision_level > back_level >= base_level
  * Also clear conflict data and sets cp_flag if deletion of atoms is enabled
  *
+ * With chronological backtracking, literals of level <= back_level
+ * may be on the stack above level_index[back_level + 1]. These
+ * literals are kept: they are moved down (in order) and put back
+ * in the propagation queues since the theory solver will forget them
+ * when it backtracks.
+ *
  * NOTE: this function does not force the theory solver to backtrack.
  */
 static void backtrack(smt_core_t *s, uint32_t back_level) {
-  uint32_t i, k;
+  uint32_t i, j, k, n;
   literal_t *u, l;
   bvar_t x;
 
@@ -2319,27 +3125,34 @@ static void backtrack(smt_core_t *s, uint32_t back_level) {
 
   u = s->stack.lit;
   k = s->stack.level_index[back_level + 1];
-  i = s->stack.top;
-  while (i > k) {
-    i --;
+  n = s->stack.top;
+  j = k;
+  for (i=k; i<n; i++) {
     l = u[i];
+    x = var_of(l);
 
     assert(literal_value(s, l) == VAL_TRUE);
-    assert(s->level[var_of(l)] > back_level);
-
-    // clear assignment of x, keep polarity bit
-    x = var_of(l);
-    s->value[x] &= 1;
-    heap_insert(&s->heap, x);
 
-    assert(literal_value(s, l) == VAL_UNDEF_TRUE);
+    if (s->level[x] <= back_level) {
+      // out-of-order literal: keep it
+      u[j] = l;
+      j ++;
+    } else {
+      // clear assignment of x, keep polarity bit
+      s->value[x] &= 1;
+      decision_queue_insert(s, x);
+      assert(literal_value(s, l) == VAL_UNDEF_TRUE);
+    }
   }
 
-  s->stack.top = i;
-  s->stack.prop_ptr = i;
-  s->stack.theory_ptr = i;
+  s->stack.top = j;
+  s->stack.prop_ptr = k;
+  s->stack.theory_ptr = k;
   s->decision_level = back_level;
 
+  // some assumptions may be unassigned now
+  s->assumption_index = 0;
+
   // Update the cp_flag: the deletion of atoms is enabled if there's a checkpoint
   // and if the top checkpoint has level >= the new decision level
   s->cp_flag = non_empty_checkpoint_stack(&s->checkpoints) &&
@@ -2547,92 +3360,113 @@ static bool propagation_via_bin_vector(smt_core_t *s, uint8_t *val, literal_t l0
 
 
 /*
- * Propagation via the watched lists of a literal l0.
+ * Propagation via the watch vector of a literal l0.
  * - val = literal value array (must be s->value)
+ * - l0 must be false
+ *
+ * The watchers whose blocker is true are skipped without reading
+ * the clause. The watchers of clauses that get a new watched literal
+ * are moved to another vector.
+ *
+ * The vector is scanned from the end, so that the most recent
+ * clauses are visited first. The watchers to keep are compacted
+ * toward the end of the vector and the vector's start is updated.
  *
  * Return true if there's no conflict, false otherwise
  */
-static bool propagation_via_watched_list(smt_core_t *s, uint8_t *val, literal_t l0) {
+static bool propagation_via_watch_vector(smt_core_t *s, uint8_t *val, literal_t l0) {
+  watcher_t *w;
   clause_t *cl;
-  link_t *list;
-  link_t link;
   bval_t v1;
-  uint32_t k, i;
+  uint32_t i, j, k, low, idx;
   literal_t l1, l, *b;
+  bool ok;
 
   assert(s->value == val);
 
-  list = &s->watch[l0];
-  link = *list;
-  while (link != NULL_LINK) {
-    cl = clause_of(link);
-    i = idx_of(link);
-    l1 = get_other_watch(cl, i);
-    v1 = lit_val(val, l1);
+  w = s->watch[l0].data;
+  low = s->watch[l0].start;
+  i = s->watch[l0].size;
+  ok = true;
+  j = i;
+  while (i > low) {
+    i --;
+    if (lit_val(val, w[i].blocker) == VAL_TRUE) {
+      // skip: the clause is true
+      j --;
+      if (i != j) {
+        w[j] = w[i];
+      }
+      continue;
+    }
 
-    assert(next_of(link) == cl->link[i]);
-    assert(cdr_ptr(link) == cl->link + i);
+    cl = w[i].clause;
+    b = cl->cl;
+    idx = (b[0] != l0); // l0 is b[idx]
+    assert(b[idx] == l0);
+    l1 = b[idx ^ 1];
+    v1 = lit_val(val, l1);
 
     if (v1 == VAL_TRUE) {
+      // clause cl is true: l1 is the new blocker
+      j --;
+      w[j].clause = cl;
+      w[j].blocker = l1;
+      continue;
+    }
+
+    /*
+     * Search for a new watched literal in cl.
+     * The loop terminates since cl->cl terminates with an end marked
+     * and val[end_marker] == VAL_UNDEF.
+     */
+    k = 1;
+    do {
+      k ++;
+      l = b[k];
+    } while (lit_val(val, l) == VAL_FALSE);
+
+    if (l >= 0) {
       /*
-       * Skip clause cl: it's already true
+       * l occurs in b[k] = cl->cl[k] and is either TRUE or UNDEF
+       * make l a new watched literal
+       * - swap b[idx] and b[k]
+       * - move the watcher to l's watch vector (l != l0 since l0 is false)
        */
-      *list = link;
-      list = cl->link + i;
-      link = cl->link[i];
+      b[k] = l0;
+      b[idx] = l;
+      add_watcher(s->watch + l, cl, l1);
 
     } else {
       /*
-       * Search for a new watched literal in cl.
-       * The loop terminates since cl->cl terminates with an end marked
-       * and val[end_marker] == VAL_UNDEF.
+       * All literals of cl, except possibly l1, are false
        */
-      k = 1;
-      b = cl->cl;
-      do {
-        k ++;
-        l = b[k];
-      } while (lit_val(val, l) == VAL_FALSE);
-
-      if (l >= 0) {
-        /*
-         * l occurs in b[k] = cl->cl[k] and is either TRUE or UNDEF
-         * make l a new watched literal
-         * - swap b[i] and b[k]
-         * - insert cl into l's watched list (link[i])
-         */
-        b[k] = b[i];
-        b[i] = l;
+      j --;
+      w[j].clause = cl;
+      w[j].blocker = l1;
 
-        // insert cl in watch[l] list and move to the next clause
-        link = cl->link[i];
-        s->watch[l] = cons(i, cl, s->watch[l]);
+      if (bval_is_undef(v1)) {
+        // l1 is implied
+        implied_literal(s, l1, mk_clause_antecedent(cl, idx^1));
       } else {
-        /*
-         * All literals of cl, except possibly l1, are false
-         */
-	if (bval_is_undef(v1)) {
-          // l1 is implied
-          implied_literal(s, l1, mk_clause_antecedent(cl, i^1));
-
-          // move to the next clause
-          *list = link;
-          list = cl->link + i;
-          link = cl->link[i];
-
-        } else {
-          // v1 == VAL_FALSE: conflict found
-          record_clause_conflict(s, cl);
-          *list = link;
-          return false;
+        // v1 == VAL_FALSE: conflict found
+        // keep the remaining watchers
+        record_clause_conflict(s, cl);
+        while (i > low) {
+          i --;
+          j --;
+          w[j] = w[i];
         }
+        ok = false;
+        break;
       }
     }
   }
 
-  *list = NULL_LINK;
+  // the watchers to keep are in w[j ... size-1]
+  s->watch[l0].start = j;
 
-  return true;
+  return ok;
 }
 
 
@@ -2658,7 +3492,7 @@ static bool boolean_propagation(smt_core_t *s) {
       return false;
     }
 
-    if (! propagation_via_watched_list(s, val, l)) {
+    if (! propagation_via_watch_vector(s, val, l)) {
       return false;
     }
   }
@@ -2771,11 +3605,9 @@ static inline bool is_var_unmarked(smt_core_t *s, bvar_t x) {
   return ! tst_bit(s->mark, x);
 }
 
-#if DEBUG || !defined(NDEBUG)
 static inline bool is_var_marked(smt_core_t *s, bvar_t x) {
   return tst_bit(s->mark, x);
 }
-#endif
 
 static inline void set_var_mark(smt_core_t *s, bvar_t x) {
   set_bit(s->mark, x);
@@ -2843,16 +3675,51 @@ static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2) {
 }
 
 
+/*
+ * Export a learned clause a[0 ... n-1] to the clause ring if it's small enough
+ * - glue = its glue score
+ */
+static void export_learned_clause(smt_core_t *s, uint32_t n, const literal_t *a, uint32_t glue) {
+  assert(s->ring != NULL);
+
+  if (clause_ring_accepts(s->ring, n, a, glue) &&
+      clause_ring_export(s->ring, s->ring_id, n, a, glue)) {
+    s->stats.exported_clauses ++;
+  }
+}
+
+
+/*
+ * Backtrack after conflict resolution
+ * - k = the level at which the learned clause is asserting
+ * - normally, this backtracks to level k
+ * - if chronological backtracking is enabled and this would undo more
+ *   than chrono_threshold levels, we backtrack to decision_level - 1
+ *   instead. The implied literal must then be assigned out of order.
+ */
+static void backjump(smt_core_t *s, uint32_t k) {
+  assert(k < s->decision_level);
+
+  if (s->chrono_enabled && s->decision_level - k > s->chrono_threshold) {
+    s->stats.chrono_backtracks ++;
+    k = s->decision_level - 1;
+  }
+  backtrack_to_level(s, k);
+}
+
+
 /*
  * Add an array of literals a as a new learned clause, after conflict resolution.
  * - n must be at least 1
  * - all literals must be assigned to false
  * - a[0] must be the implied literal: all other literals must have
  *   a lower assignment level than a[0].
- * - backtrack to the decision_level where a[0] is implied, then
- *   add a[0] to the propagation queue
+ * - glue = glue score of a[0 ... n-1]
+ * - backtrack to the decision_level where a[0] is implied (or just
+ *   one level if chronological backtracking applies), then add a[0]
+ *   to the propagation queue
  */
-static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
+static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a, uint32_t glue) {
   clause_t *cl;
   uint32_t i, j, k, q;
   literal_t l0, l1;
@@ -2867,6 +3734,10 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   fflush(stdout);
 #endif
 
+  if (s->ring != NULL) {
+    export_learned_clause(s, n, a, glue);
+  }
+
   l0 = a[0];
 
   if (n == 1) {
@@ -2896,8 +3767,8 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
     assert(k < s->level[var_of(l0)]);
 
     direct_binary_clause(s, l0, l1);
-    backtrack_to_level(s, k);
-    implied_literal(s, l0, mk_literal_antecedent(l1));
+    backjump(s, k);
+    implied_literal_at_level(s, l0, mk_literal_antecedent(l1), k);
 
   } else {
 
@@ -2921,22 +3792,22 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
     l1 = a[j]; a[j] = a[1]; a[1] = l1;
 
     // create the new clause with l0 and l1 as watched literals
-    cl = new_learned_clause(n, a);
+    cl = new_learned_clause(s, n, a);
     add_clause_to_vector(&s->learned_clauses, cl);
     increase_clause_activity(s, cl);
+    init_clause_glue(s, cl, glue);
 
-    // add cl at the start of watch[l0] and watch[l1]
-    s->watch[l0] = cons(0, cl, s->watch[l0]);
-    s->watch[l1] = cons(1, cl, s->watch[l1]);
+    // add cl to watch[l0] and watch[l1]
+    add_clause_watchers(s, cl);
 
     s->nb_clauses ++;
     s->stats.learned_literals += n;
 
     // backtrack and assert l0
     assert(k < s->level[var_of(l0)]);
-    backtrack_to_level(s, k);
+    backjump(s, k);
 
-    implied_literal(s, l0, mk_clause0_antecedent(cl));
+    implied_literal_at_level(s, l0, mk_clause0_antecedent(cl), k);
   }
 }
 
@@ -3014,13 +3885,13 @@ static bool try_cache_theory_clause(smt_core_t *s, uint32_t n, literal_t *a) {
 #endif
 
     // create the new clause with l0 and l1 as watched literals
-    cl = new_learned_clause(n, a);
+    cl = new_learned_clause(s, n, a);
     add_clause_to_vector(&s->learned_clauses, cl);
     increase_clause_activity(s, cl);
+    init_clause_glue(s, cl, glue_score(s, n, a));
 
-    // insert cl at the head of watch[l0] and watch[l1]
-    s->watch[l0] = cons(0, cl, s->watch[l0]);
-    s->watch[l1] = cons(1, cl, s->watch[l1]);
+    // add cl to watch[l0] and watch[l1]
+    add_clause_watchers(s, cl);
 
     s->nb_clauses ++;
     s->stats.learned_literals += n;
@@ -3359,7 +4230,8 @@ static void simplify_learned_clause(smt_core_t *s) {
  *
  * Note: computing conflict level is necessary for theory conflicts.
  * For conflicts detected by boolean propagation, the conflict_level
- * is the same as the current decision_level
+ * is the same as the current decision_level, unless literals were
+ * assigned out of order by chronological backtracking.
  */
 static uint32_t get_conflict_level(smt_core_t *s, literal_t *a) {
   uint32_t k, q, i;
@@ -3386,6 +4258,49 @@ static uint32_t get_conflict_level(smt_core_t *s, literal_t *a) {
 
 
 
+/*
+ * Update the moving averages of the glue after a conflict
+ * - during the first conflicts, the smoothing factors are raised
+ *   to 1/number of conflicts so that the averages are not biased
+ *   toward their initial value (0)
+ */
+static void update_lbd_averages(smt_core_t *s, uint32_t glue) {
+  double alpha;
+
+  assert(s->stats.conflicts > 0);
+
+  alpha = 1.0/s->stats.conflicts;
+  if (alpha < LBD_FAST_ALPHA) alpha = LBD_FAST_ALPHA;
+  s->lbd_fast += alpha * (glue - s->lbd_fast);
+
+  alpha = 1.0/s->stats.conflicts;
+  if (alpha < LBD_SLOW_ALPHA) alpha = LBD_SLOW_ALPHA;
+  s->lbd_slow += alpha * (glue - s->lbd_slow);
+}
+
+
+/*
+ * Update the target phase in stable mode (on a conflict)
+ * - the assignment below the current decision level is conflict free:
+ *   if it's larger than the current target, it becomes the new target
+ */
+static void update_target_phase(smt_core_t *s) {
+  literal_t *stack;
+  uint32_t i, n;
+  bvar_t x;
+
+  n = s->stack.level_index[s->decision_level];
+  if (n > s->target_assigned) {
+    stack = s->stack.lit;
+    for (i=0; i<n; i++) {
+      x = var_of(stack[i]);
+      assign_bit(s->target_phase, x, s->value[x] & 1);
+    }
+    s->target_assigned = n;
+  }
+}
+
+
 /*
  * Search for first UIP and build the learned clause
  * d = solver state
@@ -3413,7 +4328,7 @@ do {                                          \
 
 
 static void resolve_conflict(smt_core_t *s) {
-  uint32_t i, j, conflict_level, unresolved;
+  uint32_t i, j, n, glue, conflict_level, unresolved;
   literal_t l, b;
   bvar_t x;
   literal_t *c,  *stack;
@@ -3422,7 +4337,8 @@ static void resolve_conflict(smt_core_t *s) {
   ivector_t *buffer;
 
   assert(s->inconsistent);
-  assert(s->theory_conflict || get_conflict_level(s, s->conflict) == s->decision_level);
+  assert(s->theory_conflict || s->chrono_enabled ||
+         get_conflict_level(s, s->conflict) == s->decision_level);
 
   s->stats.conflicts ++;
 
@@ -3431,16 +4347,17 @@ static void resolve_conflict(smt_core_t *s) {
 
   /*
    * adjust conflict_level and backtrack to that level if the conflict
-   * was reported by the theory solver.
+   * was reported by the theory solver or if it involves literals
+   * assigned out of order.
    */
-  if (s->theory_conflict) {
+  if (s->theory_conflict || s->chrono_enabled) {
     conflict_level = get_conflict_level(s, c);
     assert(s->base_level <= conflict_level && conflict_level <= s->decision_level);
     backtrack_to_level(s, conflict_level);
     assert(s->decision_level == conflict_level);
 
     // Cache as a clause
-    if (s->th_cache_enabled) {
+    if (s->theory_conflict && s->th_cache_enabled) {
       try_cache_theory_conflict(s, s->th_conflict_size, c);
     }
   }
@@ -3450,6 +4367,10 @@ static void resolve_conflict(smt_core_t *s) {
     return;
   }
 
+  if (s->stable) {
+    update_target_phase(s);
+  }
+
 #if DEBUG
   check_marks(s);
 #endif
@@ -3481,9 +4402,10 @@ static void resolve_conflict(smt_core_t *s) {
 
   /*
    * If the conflict is a learned clause, increase its activity
+   * and update its glue
    */
   if (l == end_learned) {
-    increase_clause_activity(s, s->false_clause);
+    bump_learned_clause(s, s->false_clause);
   }
 
   assert(unresolved > 0);
@@ -3492,6 +4414,8 @@ static void resolve_conflict(smt_core_t *s) {
    * Scan the assignment stack from top to bottom and process the
    * antecedent of all marked literals:
    * - all the literals processed have decision_level == conflict_level
+   * - literals of lower levels can be on the stack if they were
+   *   assigned out of order. They must be skipped.
    * - the code works if unresolved == 1 (which may happen for theory conflicts)
    */
   stack = s->stack.lit;
@@ -3499,8 +4423,8 @@ static void resolve_conflict(smt_core_t *s) {
   for (;;) {
     j --;
     b = stack[j];
-    assert(d_level(s, b) == conflict_level);
-    if (is_lit_marked(s, b)) {
+    assert(d_level(s, b) <= conflict_level);
+    if (is_lit_marked(s, b) && d_level(s, b) == conflict_level) {
       if (unresolved == 1) {
         // not b is the implied literal; we're done.
         buffer->data[0] = not(b);
@@ -3532,7 +4456,7 @@ static void resolve_conflict(smt_core_t *s) {
             l = *c;
           }
           if (l == end_learned) {
-            increase_clause_activity(s, cl);
+            bump_learned_clause(s, cl);
           }
           break;
 
@@ -3583,11 +4507,22 @@ static void resolve_conflict(smt_core_t *s) {
   s->inconsistent = false;
   s->theory_conflict = false;
 
+  if (s->use_vmtf) {
+    vmtf_bump_variables(s);
+  }
+
+  /*
+   * Glue of the learned clause: must be computed before backtracking
+   */
+  n = s->buffer.size;
+  glue = (n <= 2) ? n : glue_score(s, n, s->buffer.data);
+  update_lbd_averages(s, glue);
+
   /*
    * Add the learned clause: this causes backtracking
    * and assert the implied literal
    */
-  add_learned_clause(s, s->buffer.size, s->buffer.data);
+  add_learned_clause(s, n, s->buffer.data, glue);
 }
 
 
@@ -3652,7 +4587,6 @@ static void resolve_conflict(smt_core_t *s) {
  */
 static clause_t *new_problem_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   clause_t *cl;
-  literal_t l;
 
 #if TRACE
   uint32_t i;
@@ -3665,15 +4599,11 @@ static clause_t *new_problem_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   fflush(stdout);
 #endif
 
-  cl = new_clause(n, a);
+  cl = new_clause(s, n, a);
   add_clause_to_vector(&s->problem_clauses, cl);
 
-  // add cl at the start of watch lists
-  l = a[0];
-  s->watch[l] = cons(0, cl, s->watch[l]);
-
-  l = a[1];
-  s->watch[l] = cons(1, cl, s->watch[l]);
+  // add cl to the watch vectors of a[0] and a[1]
+  add_clause_watchers(s, cl);
 
   s->nb_prob_clauses ++;
   s->nb_clauses ++;
@@ -4009,6 +4939,7 @@ void add_unit_clause(smt_core_t *s, literal_t l) {
 
   assert(0 <= l && l < s->nlits);
 
+  smt_restore_literals(s, 1, &l);
   if (literal_value(s, l) == VAL_TRUE && s->level[var_of(l)] <= s->base_level) {
     return; // l is already true at the base level
   }
@@ -4040,6 +4971,7 @@ void add_clause_unsafe(smt_core_t *s, uint32_t n, literal_t *a) {
     return;
   }
 
+  smt_restore_literals(s, n, a);
   if (preprocess_clause(s, &n, a)) {
     if (n > 2) {
       //      add_simplified_clause(s, n, a);
@@ -4076,6 +5008,8 @@ void add_clause(smt_core_t *s, uint32_t n, literal_t *a) {
     return;
   }
 
+  smt_restore_literals(s, n, a);
+
   // use s->buffer2 as an auxiliary buffer to make a copy of a[0 .. n-1]
   v = &s->buffer2;
   assert(v->size == 0);
@@ -4158,6 +5092,7 @@ static uint32_t lemma_length(literal_t *a) {
  * - a = array of literals (lemma is a[0] ... a[n-1])
  */
 static void add_lemma(smt_core_t *s, uint32_t n, literal_t *a) {
+  smt_restore_literals(s, n, a);
   if (preprocess_clause(s, &n, a)) {
     if (n > 2) {
       add_simplified_clause(s, n, a);
@@ -4221,16 +5156,30 @@ static void add_all_lemmas(smt_core_t *s) {
  *  DELETION OF LEARNED CLAUSES  *
  ********************************/
 
+/*
+ * Ranking of learned clauses for deletion:
+ * - c1 is better than c2 if it has a smaller glue or the
+ *   same glue and a higher activity
+ */
+static inline bool better_clause(const clause_t *c1, const clause_t *c2) {
+  uint32_t g1, g2;
+
+  g1 = get_glue(c1);
+  g2 = get_glue(c2);
+  return g1 < g2 || (g1 == g2 && get_activity(c1) > get_activity(c2));
+}
+
+
 /*
  * Reorder an array  a[low ... high-1] of learned clauses so that
  * the clauses are divided in two half arrays:
- * - the clauses of highest activities are all stored in a[low...half - 1]
- * - the clauses of lowest activities are in a[half ... high-1],
+ * - the best clauses are all stored in a[low...half - 1]
+ * - the worst clauses are in a[half ... high-1],
  * where half = (low + high) / 2.
  */
 static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
   uint32_t i, j, half;
-  float pivot;
+  clause_t *pivot;
   clause_t *aux;
 
   if (high <= low + 1) return;
@@ -4240,31 +5189,31 @@ static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
   do {
     i = low;
     j = high;
-    pivot = get_activity(a[i]);
+    pivot = a[i];
 
-    do { j --; } while (get_activity(a[j]) < pivot);
-    do { i ++; } while (i <= j && get_activity(a[i]) > pivot);
+    do { j --; } while (better_clause(pivot, a[j]));
+    do { i ++; } while (i <= j && better_clause(a[i], pivot));
 
     while (i < j) {
-      // a[i].act <= pivot and a[j].act >= pivot: swap a[i] and a[j]
+      // a[i] is not better than pivot and pivot is not better than a[j]: swap a[i] and a[j]
       aux = a[i];
       a[i] = a[j];
       a[j] = aux;
 
-      do { j--; } while (get_activity(a[j]) < pivot);
-      do { i++; } while (get_activity(a[i]) > pivot);
+      do { j--; } while (better_clause(pivot, a[j]));
+      do { i++; } while (better_clause(a[i], pivot));
     }
 
-    // a[j].act >= pivot, a[low].act = pivot: swap a[low] and a[i]
+    // swap a[low] = pivot and a[j]
     aux = a[low];
     a[low] = a[j];
     a[j] = aux;
 
     /*
      * at this point:
-     * - all clauses in a[low,.., j - 1] have activity >= pivot
-     * - activity of a[j] == pivot
-     * - all clauses in a[j+1,..., high-1] have activity <= pivot
+     * - no clause in a[j+1,..., high-1] is better than the pivot
+     * - a[j] == pivot
+     * - the pivot is not better than any clause in a[low,.., j - 1]
      * reapply the procedure to whichever of the two subarrays
      * contains the half point
      */
@@ -4278,32 +5227,23 @@ static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
 
 
 /*
- * Apply this to a vector v of learned_clauses
- */
-static void reorder_clause_vector(clause_t **v) {
-  quick_split(v, 0, get_cv_size(v));
-}
-
-
-/*
- * Auxiliary function: follow clause list of l0
+ * Auxiliary function: scan the watch vector of l0
  * Remove all clauses marked for removal
  */
 static void cleanup_watch_list(smt_core_t *s, literal_t l0) {
-  link_t lnk;
-  clause_t *cl;
-  link_t *list;
+  watcher_t *w;
+  uint32_t i, j, n;
 
-  list = s->watch + l0;
-  for (lnk = *list; lnk != NULL_LINK; lnk = next_of(lnk)) {
-    cl = clause_of(lnk);
-    if (! is_clause_to_be_removed(cl)) {
-      *list = lnk;
-      list = cdr_ptr(lnk);
+  w = s->watch[l0].data;
+  n = s->watch[l0].size;
+  j = s->watch[l0].start;
+  for (i=j; i<n; i++) {
+    if (! is_clause_to_be_removed(w[i].clause)) {
+      w[j] = w[i];
+      j ++;
     }
   }
-
-  *list = NULL_LINK; // end of list
+  s->watch[l0].size = j;
 }
 
 
@@ -4335,78 +5275,250 @@ static bool clause_is_locked(smt_core_t *s, clause_t *cl) {
 
 
 /*
- * Delete all clauses that are marked for deletion
+ * ARENA COMPACTION
  */
-static void delete_learned_clauses(smt_core_t *s) {
-  uint32_t i, j, n;
-  clause_t **v;
 
-  v = s->learned_clauses;
-  n = get_cv_size(v);
+/*
+ * During compaction, a relocated clause cl stores a forwarding pointer
+ * in place of its literals:
+ * - cl->cl[0 ... 1] = new address of cl (every clause has at least
+ *   two literals and an end marker, and it's aligned on 8 bytes)
+ * - cl->cl[2] = forward_marker
+ * Deleted clauses are not relocated. Their cl[2] is either a literal
+ * or an end marker so it's distinct from forward_marker.
+ */
+enum {
+  forward_marker = -3,
+};
 
-  // clean up all the watch-literal lists
-  cleanup_watch_lists(s);
+static inline bool clause_is_forwarded(clause_t *cl) {
+  return cl->cl[2] == forward_marker;
+}
 
-  // do the real deletion
-  s->stats.learned_literals = 0;
+static inline clause_t *forward_clause(clause_t *cl) {
+  clause_t *copy;
 
-  j = 0;
-  for (i = 0; i<n; i++) {
-    if (is_clause_to_be_removed(v[i])) {
-      delete_learned_clause(v[i]);
-    } else {
-      s->stats.learned_literals += clause_length(v[i]);
-      v[j] = v[i];
-      j ++;
-    }
+  assert(clause_is_forwarded(cl));
+  memcpy(&copy, cl->cl, sizeof(clause_t *));
+  return copy;
+}
+
+
+/*
+ * Copy clause cl to the end of block b and store the forwarding pointer in cl
+ * - is_learned = true if cl is a learned clause
+ * - return the copy
+ */
+static clause_t *relocate_clause(clause_block_t *b, clause_t *cl, bool is_learned) {
+  uint64_t *dst;
+  clause_t *copy;
+  uint32_t n;
+
+  n = clause_words(clause_length(cl), is_learned);
+  assert(b->capacity - b->size >= n);
+  dst = b->data + b->size;
+  b->size += n;
+
+  if (is_learned) {
+    memcpy(dst, learned(cl), n * sizeof(uint64_t));
+    copy = &((learned_clause_t *) dst)->clause;
+  } else {
+    memcpy(dst, cl, n * sizeof(uint64_t));
+    copy = (clause_t *) dst;
   }
 
-  // set new size of the learned clause vector
-  set_cv_size(s->learned_clauses, j);
-  s->nb_clauses -= (n - j);
+  memcpy(cl->cl, &copy, sizeof(clause_t *));
+  cl->cl[2] = forward_marker;
 
-  s->stats.learned_clauses_deleted += (n - j);
+  return copy;
 }
 
 
 /*
- * Delete half the learned clauses, minus the locked ones (Minisat style).
- * This is expensive: the function scans and reconstructs the
- * watched lists.
+ * Move all the live clauses into a single new block
+ * - the problem clauses are stored first, then the learned clauses,
+ *   in the order of the clause vectors
+ * - the watch vectors keep the same order
+ * - the clause antecedents of all assigned variables are updated.
+ *   A deleted clause can still be the antecedent of a variable assigned
+ *   at the base level (e.g., a learned clause removed by pop). We replace
+ *   such antecedents by a literal antecedent (true_literal) so that
+ *   they don't refer to freed memory.
  */
-void reduce_clause_database(smt_core_t *s) {
-  uint32_t i, n;
+static void compact_clause_arena(smt_core_t *s) {
+  clause_arena_t *a;
+  clause_block_t *old, *b;
   clause_t **v;
-  float act_threshold;
-
-  v = s->learned_clauses;
-  n = get_cv_size(v);
-  if (n == 0) return;
+  clause_t *cl;
+  watcher_t *w;
+  antecedent_t ante;
+  uint64_t size;
+  uint32_t i, j, n, m;
+  bvar_t x;
 
-  // put the clauses with lowest activity in the upper
-  // half of the learned clause vector.
-  reorder_clause_vector(v);
+  assert(! s->inconsistent);
 
-  act_threshold = s->cla_inc/n;
+  a = &s->arena;
+  if (a->live > MAX_CLAUSE_BLOCK_SIZE) return; // can't fit in a single block
 
-  // prepare for deletion: all non-locked clauses, with activity less
-  // than activity_threshold are marked for deletion.
-  for (i=0; i<n/2; i++) {
-    if (get_activity(v[i]) <= act_threshold && ! clause_is_locked(s, v[i])) {
-      mark_for_removal(v[i]);
-    }
+  size = a->live + (a->live >> 1);
+  if (size < DEF_CLAUSE_BLOCK_SIZE) {
+    size = DEF_CLAUSE_BLOCK_SIZE;
   }
-  for (i = n/2; i<n; i++) {
-    if (! clause_is_locked(s, v[i])) {
-      mark_for_removal(v[i]);
-    }
+  if (size > MAX_CLAUSE_BLOCK_SIZE) {
+    size = MAX_CLAUSE_BLOCK_SIZE;
   }
 
-  delete_learned_clauses(s);
-  s->stats.reduce_calls ++;
-}
-
-
+  old = a->block;
+  a->block = NULL;
+  a->capacity = 0;
+  b = new_clause_block(a, (uint32_t) size);
+
+  // copy the clauses
+  v = s->problem_clauses;
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    v[i] = relocate_clause(b, v[i], false);
+  }
+  v = s->learned_clauses;
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    v[i] = relocate_clause(b, v[i], true);
+  }
+  assert(b->size == a->live);
+
+  // watch vectors: they contain only live clauses
+  n = s->nlits;
+  for (i=0; i<n; i++) {
+    w = s->watch[i].data;
+    m = s->watch[i].size;
+    for (j=s->watch[i].start; j<m; j++) {
+      w[j].clause = forward_clause(w[j].clause);
+    }
+  }
+
+  // antecedents
+  n = s->stack.top;
+  for (i=0; i<n; i++) {
+    x = var_of(s->stack.lit[i]);
+    ante = s->antecedent[x];
+    if (antecedent_tag(ante) <= clause1_tag) {
+      cl = clause_antecedent(ante);
+      if (clause_is_forwarded(cl)) {
+        s->antecedent[x] = mk_clause_antecedent(forward_clause(cl), clause_index(ante));
+      } else {
+        assert(s->level[x] <= s->base_level);
+        s->antecedent[x] = mk_literal_antecedent(true_literal);
+      }
+    }
+  }
+
+  s->false_clause = NULL;
+
+  free_clause_blocks(old);
+  a->wasted = 0;
+  s->stats.arena_compactions ++;
+}
+
+
+/*
+ * Compact the arena if enough space is wasted
+ */
+static void collect_clause_garbage(smt_core_t *s) {
+  clause_arena_t *a;
+
+  a = &s->arena;
+  if (a->wasted > (a->live + a->wasted)/CLAUSE_ARENA_WASTE_RATIO) {
+    compact_clause_arena(s);
+  }
+}
+
+
+/*
+ * Delete all clauses that are marked for deletion
+ */
+static void delete_learned_clauses(smt_core_t *s) {
+  uint32_t i, j, n;
+  clause_t **v;
+
+  v = s->learned_clauses;
+  n = get_cv_size(v);
+
+  // clean up all the watch-literal lists
+  cleanup_watch_lists(s);
+
+  // do the real deletion
+  s->stats.learned_literals = 0;
+
+  j = 0;
+  for (i = 0; i<n; i++) {
+    if (is_clause_to_be_removed(v[i])) {
+      delete_learned_clause(s, v[i]);
+    } else {
+      s->stats.learned_literals += clause_length(v[i]);
+      v[j] = v[i];
+      j ++;
+    }
+  }
+
+  // set new size of the learned clause vector
+  set_cv_size(s->learned_clauses, j);
+  s->nb_clauses -= (n - j);
+
+  s->stats.learned_clauses_deleted += (n - j);
+}
+
+
+/*
+ * Reduce the learned clause database (Glucose-style):
+ * - the core clauses (glue <= CORE_GLUE) are kept
+ * - the clauses used since the previous reductions are kept
+ *   (and their used counter is decremented)
+ * - the other clauses are candidates for deletion: we delete the
+ *   worst half of them (based on glue then activity), except
+ *   the locked ones.
+ * This is expensive: the function scans and reconstructs the
+ * watched lists.
+ */
+void reduce_clause_database(smt_core_t *s) {
+  uint32_t i, k, n;
+  clause_t **v;
+  clause_t *cl;
+  learned_clause_t *lcl;
+
+  v = s->learned_clauses;
+  n = get_cv_size(v);
+  if (n == 0) return;
+
+  // move the clauses to keep to v[0 ... k-1]
+  // the candidates for deletion are in v[k ... n-1]
+  k = 0;
+  for (i=0; i<n; i++) {
+    cl = v[i];
+    lcl = learned(cl);
+    if (is_core_clause(cl) || lcl->used > 0) {
+      if (lcl->used > 0) lcl->used --;
+      v[i] = v[k];
+      v[k] = cl;
+      k ++;
+    }
+  }
+
+  // put the worst candidates in the upper half of v[k ... n-1]
+  quick_split(v, k, n);
+
+  for (i = (k + n)/2; i<n; i++) {
+    if (! clause_is_locked(s, v[i])) {
+      mark_for_removal(v[i]);
+    }
+  }
+
+  delete_learned_clauses(s);
+  collect_clause_garbage(s);
+  s->stats.reduce_calls ++;
+}
+
+
 
 
 
@@ -4439,6 +5551,7 @@ static uint32_t unassigned_literals(smt_core_t *s, clause_t *cl) {
  * - split the set of learned clauses into two parts: old-clauses and young-clauses
  * - if there are n learned clauses in total, then the n/young_ratio most recent are young,
  *   the rest are old. (young_ratio is 16)
+ * - learned clauses in the core tier (glue <= CORE_GLUE) are never removed
  */
 void remove_irrelevant_learned_clauses(smt_core_t *s) {
   clause_t **v;
@@ -4455,7 +5568,7 @@ void remove_irrelevant_learned_clauses(smt_core_t *s) {
 
   for (i=0; i<n; i++) {
     cl = v[i];
-    if (! clause_is_locked(s, cl)) {
+    if (! is_core_clause(cl) && ! clause_is_locked(s, cl)) {
       relevance = i < p ? HEAD_RELEVANCE : TAIL_RELEVANCE;
       if (get_activity(cl) < HEAD_ACTIVITY - coeff * i &&
           unassigned_literals(s, cl) > relevance) {
@@ -4465,6 +5578,7 @@ void remove_irrelevant_learned_clauses(smt_core_t *s) {
   }
 
   delete_learned_clauses(s);
+  collect_clause_garbage(s);
   s->stats.remove_calls ++;
 }
 
@@ -4509,6 +5623,7 @@ static inline bval_t unsafe_literal_is_unassigned(smt_core_t *s, literal_t l) {
 static void simplify_clause(smt_core_t *s, clause_t *cl) {
   uint32_t i, j;
   literal_t l;
+  bool is_learned;
 
   assert(s->base_level == 0 && s->decision_level ==0);
 
@@ -4536,6 +5651,10 @@ static void simplify_clause(smt_core_t *s, clause_t *cl) {
   s->aux_literals += j - 1;
   s->aux_clauses ++;
   // could migrate cl to two-literal if j is 3??
+
+  // the removed literals are wasted space in the arena
+  is_learned = (l == end_learned);
+  arena_free(&s->arena, clause_words(i - 1, is_learned) - clause_words(j - 1, is_learned));
 }
 
 
@@ -4654,7 +5773,7 @@ static void simplify_clause_set(smt_core_t *s) {
     j = 0;
     for (i=0; i<n; i++) {
       if (is_clause_to_be_removed(v[i])) {
-        delete_clause(v[i]);
+        delete_clause(s, v[i]);
       } else {
         v[j] = v[i];
         j ++;
@@ -4674,7 +5793,7 @@ static void simplify_clause_set(smt_core_t *s) {
   j = 0;
   for (i=0; i<n; i++) {
     if (is_clause_to_be_removed(v[i])) {
-      delete_learned_clause(v[i]);
+      delete_learned_clause(s, v[i]);
     } else {
       v[j] = v[i];
       j ++;
@@ -4748,58 +5867,1123 @@ static void simplify_binary_vectors(smt_core_t *s) {
       s->aux_literals += n;
     }
 
-    // remove all binary clauses that contain not(l0)
-    l0 = not(l0);
-    v0 = s->bin[l0];
-    if (v0 != NULL) {
-      s->aux_literals += get_lv_size(v0);
-      delete_literal_vector(v0);
-      s->bin[l0] = NULL;
-    }
+    // remove all binary clauses that contain not(l0)
+    l0 = not(l0);
+    v0 = s->bin[l0];
+    if (v0 != NULL) {
+      s->aux_literals += get_lv_size(v0);
+      delete_literal_vector(v0);
+      s->bin[l0] = NULL;
+    }
+  }
+
+  s->aux_literals /= 2;
+  s->stats.bin_clauses_deleted += s->aux_literals;
+  s->nb_bin_clauses -= s->aux_literals;
+
+  s->aux_literals = 0;
+}
+
+
+/*
+ * Simplify the database: problem clauses and learned clauses
+ * - remove clauses that are true at the base level from the watched lists
+ * - if base_level is 0, also remove binary clauses that are true at the
+ *   base level.
+ */
+static void simplify_clause_database(smt_core_t *s) {
+  assert(s->stack.top == s->stack.prop_ptr && s->decision_level == s->base_level);
+
+  simplify_clause_set(s);
+  if (s->base_level == 0) {
+    simplify_binary_vectors(s);
+  }
+
+  s->stats.simplify_calls ++;
+
+  /*
+   * The next call to simplify_clause_database is enabled when
+   *   s->decision_level == base_level &&
+   *   s->stack.top > s->simplify_bottom &&
+   *   s->stats.propagations > s->simplify_props + s->simplify_threshold
+   *
+   * s->simplify_threshold is set to the total number of literals.
+   *
+   * This is an arbitrary choice that avoids calling simplify too often.
+   * This is copied from Minisat.
+   */
+  s->simplify_bottom = s->stack.top;
+  s->simplify_props = s->stats.propagations;
+  s->simplify_threshold = s->stats.learned_literals + s->stats.prob_literals +
+    2 * s->nb_bin_clauses;
+}
+
+
+
+
+/***********************
+ *  SAT PREPROCESSING  *
+ **********************/
+
+/*
+ * The preprocessor works on a copy of the problem clauses (binary
+ * clauses included) that are not true at level 0:
+ * - the core's problem clauses and binary vectors are emptied
+ * - subsumption and variable elimination are applied to the copy
+ *   using occurrence lists
+ * - the remaining clauses are then added back to the core.
+ *
+ * Failed-literal probing is done before that, directly on the core's
+ * clause database (using boolean propagation only).
+ *
+ * Each clause removed by eliminating variable x is stored in
+ * s->elim_stack as a record [n, l_0, ..., l_n-1] where l_0 is the
+ * literal of x (the pivot). The records are used for extending the
+ * assignment to the eliminated variables, and for restoring x.
+ */
+
+/*
+ * Clause in the preprocessor:
+ * - len = number of literals
+ * - live = false if the clause has been removed
+ * - sgn = 64bit signature (one bit per variable, modulo 64)
+ */
+typedef struct pp_clause_s {
+  uint32_t len;
+  bool live;
+  uint64_t sgn;
+  literal_t lit[0];
+} pp_clause_t;
+
+typedef struct sat_pp_s {
+  smt_core_t *core;
+  pp_clause_t **clause;
+  uint32_t nclauses;
+  uint32_t size;
+  uint32_t nlits;
+  ivector_t *occ;        // occ[l] = indices of the clauses that contain l (some may be dead)
+  uint8_t *lmark;        // lmark[l] = 1 if l is in the current clause
+  uint32_t *cost;        // number of occurrences of each variable (for elimination)
+  byte_t *frozen;        // frozen[x] = 1 if x is an assumption (must not be eliminated)
+  ivector_t vars;        // candidate variables for elimination
+  ivector_t queue;       // clauses to use for backward subsumption
+  ivector_t units;       // unit literals to propagate
+  ivector_t aux;         // general-purpose buffer
+  ivector_t resolvents;  // resolvents (each stored as n, l_0 ... l_n-1)
+  int64_t effort;        // remaining effort (number of literal visits)
+  bool unsat;            // true if the empty clause was derived
+} sat_pp_t;
+
+
+/*
+ * Initialize pp for core s
+ */
+static void init_sat_pp(sat_pp_t *pp, smt_core_t *s) {
+  uint32_t i, n;
+
+  n = s->nlits;
+  pp->core = s;
+  pp->clause = (pp_clause_t **) safe_malloc(DEF_CLAUSE_VECTOR_SIZE * sizeof(pp_clause_t *));
+  pp->nclauses = 0;
+  pp->size = DEF_CLAUSE_VECTOR_SIZE;
+  pp->nlits = n;
+  pp->occ = (ivector_t *) safe_malloc(n * sizeof(ivector_t));
+  for (i=0; i<n; i++) {
+    init_ivector(pp->occ + i, 0);
+  }
+  pp->lmark = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+  memset(pp->lmark, 0, n * sizeof(uint8_t));
+  pp->cost = NULL;
+  pp->frozen = allocate_bitvector0(s->nvars);
+  for (i=0; i<s->assumptions.size; i++) {
+    set_bit(pp->frozen, var_of(s->assumptions.data[i]));
+  }
+  init_ivector(&pp->vars, 0);
+  init_ivector(&pp->queue, 0);
+  init_ivector(&pp->units, 0);
+  init_ivector(&pp->aux, DEF_LBUFFER_SIZE);
+  init_ivector(&pp->resolvents, 0);
+  pp->effort = PP_EFFORT;
+  pp->unsat = false;
+}
+
+
+/*
+ * Delete pp
+ */
+static void delete_sat_pp(sat_pp_t *pp) {
+  uint32_t i, n;
+
+  n = pp->nclauses;
+  for (i=0; i<n; i++) {
+    safe_free(pp->clause[i]);
+  }
+  safe_free(pp->clause);
+
+  n = pp->nlits;
+  for (i=0; i<n; i++) {
+    delete_ivector(pp->occ + i);
+  }
+  safe_free(pp->occ);
+  safe_free(pp->lmark);
+  safe_free(pp->cost);
+  delete_bitvector(pp->frozen);
+  delete_ivector(&pp->vars);
+  delete_ivector(&pp->queue);
+  delete_ivector(&pp->units);
+  delete_ivector(&pp->aux);
+  delete_ivector(&pp->resolvents);
+}
+
+
+/*
+ * Signature of clause c
+ */
+static uint64_t pp_signature(pp_clause_t *c) {
+  uint64_t sgn;
+  uint32_t i, n;
+
+  sgn = 0;
+  n = c->len;
+  for (i=0; i<n; i++) {
+    sgn |= ((uint64_t) 1) << (var_of(c->lit[i]) & 63);
+  }
+  return sgn;
+}
+
+
+/*
+ * Record unit clause { l }
+ * - l is assigned in the core (at level 0) and added to the unit queue
+ */
+static void pp_unit(sat_pp_t *pp, literal_t l) {
+  smt_core_t *s;
+
+  s = pp->core;
+  switch (literal_base_value(s, l)) {
+  case VAL_FALSE:
+    pp->unsat = true;
+    break;
+
+  case VAL_UNDEF_FALSE:
+  case VAL_UNDEF_TRUE:
+    assign_literal(s, l);
+    s->nb_unit_clauses ++;
+    ivector_push(&pp->units, l);
+    break;
+
+  case VAL_TRUE:
+    break;
+  }
+}
+
+
+/*
+ * Add clause a[0 ... n-1]
+ * - a must not contain duplicate or complementary literals
+ * - the clause is ignored if it's true at level 0
+ * - literals false at level 0 are removed
+ * - units and empty clauses are handled here
+ */
+static void pp_add_clause(sat_pp_t *pp, uint32_t n, const literal_t *a) {
+  smt_core_t *s;
+  pp_clause_t *c;
+  uint32_t i, j, k, m;
+  literal_t u;
+
+  s = pp->core;
+  m = 0;
+  u = null_literal;
+  for (i=0; i<n; i++) {
+    switch (literal_base_value(s, a[i])) {
+    case VAL_TRUE:
+      return;
+    case VAL_UNDEF_FALSE:
+    case VAL_UNDEF_TRUE:
+      u = a[i];
+      m ++;
+      break;
+    default:
+      break;
+    }
+  }
+
+  if (m <= 1) {
+    if (m == 0) {
+      pp->unsat = true;
+    } else {
+      pp_unit(pp, u);
+    }
+    return;
+  }
+
+  k = pp->nclauses;
+  if (k == pp->size) {
+    pp->size += (pp->size >> 1) + 1;
+    if (pp->size >= MAX_CLAUSE_VECTOR_SIZE) {
+      out_of_memory();
+    }
+    pp->clause = (pp_clause_t **) safe_realloc(pp->clause, pp->size * sizeof(pp_clause_t *));
+  }
+
+  c = (pp_clause_t *) safe_malloc(sizeof(pp_clause_t) + m * sizeof(literal_t));
+  c->len = m;
+  c->live = true;
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (bval_is_undef(literal_base_value(s, a[i]))) {
+      c->lit[j] = a[i];
+      j ++;
+      ivector_push(pp->occ + a[i], k);
+    }
+  }
+  assert(j == m);
+  c->sgn = pp_signature(c);
+
+  pp->clause[k] = c;
+  pp->nclauses = k+1;
+  ivector_push(&pp->queue, k);
+}
+
+
+/*
+ * Remove index k from occ[l] (if it's there)
+ */
+static void pp_remove_occ(sat_pp_t *pp, literal_t l, uint32_t k) {
+  ivector_t *v;
+  uint32_t i, n;
+
+  v = pp->occ + l;
+  n = v->size;
+  for (i=0; i<n; i++) {
+    if (v->data[i] == k) {
+      v->data[i] = v->data[n-1];
+      v->size = n-1;
+      break;
+    }
+  }
+}
+
+
+/*
+ * Remove the dead clauses from occ[l]
+ * - return the number of live clauses that contain l
+ */
+static uint32_t pp_clean_occ(sat_pp_t *pp, literal_t l) {
+  ivector_t *v;
+  uint32_t i, j, n;
+  int32_t k;
+
+  v = pp->occ + l;
+  n = v->size;
+  j = 0;
+  for (i=0; i<n; i++) {
+    k = v->data[i];
+    if (pp->clause[k]->live) {
+      v->data[j] = k;
+      j ++;
+    }
+  }
+  v->size = j;
+
+  return j;
+}
+
+
+/*
+ * Remove literal l from clause k
+ * - if that leaves a single literal, the clause is turned into a unit
+ */
+static void pp_strengthen(sat_pp_t *pp, uint32_t k, literal_t l) {
+  pp_clause_t *c;
+  uint32_t i, j, n;
+
+  c = pp->clause[k];
+  assert(c->live);
+
+  n = c->len;
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (c->lit[i] != l) {
+      c->lit[j] = c->lit[i];
+      j ++;
+    }
+  }
+  assert(j == n-1);
+  c->len = j;
+  c->sgn = pp_signature(c);
+  pp_remove_occ(pp, l, k);
+
+  if (j == 1) {
+    c->live = false;
+    pp_unit(pp, c->lit[0]);
+  } else {
+    ivector_push(&pp->queue, k);
+  }
+}
+
+
+/*
+ * Propagate the unit literals:
+ * - remove the clauses that contain a true literal
+ * - remove the false literals from the other clauses
+ */
+static void pp_propagate_units(sat_pp_t *pp) {
+  ivector_t *v, aux;
+  literal_t l;
+  uint32_t i, n;
+  int32_t k;
+
+  while (pp->units.size > 0 && !pp->unsat) {
+    l = ivector_pop2(&pp->units);
+
+    v = pp->occ + l;
+    n = v->size;
+    for (i=0; i<n; i++) {
+      pp->clause[v->data[i]]->live = false;
+    }
+    ivector_reset(v);
+
+    // detach occ[not(l)] so that pp_strengthen leaves it alone
+    aux = pp->occ[not(l)];
+    init_ivector(pp->occ + not(l), 0);
+    n = aux.size;
+    for (i=0; i<n; i++) {
+      k = aux.data[i];
+      if (pp->clause[k]->live) {
+	pp_strengthen(pp, k, not(l));
+      }
+    }
+    delete_ivector(&aux);
+  }
+}
+
+
+/*
+ * Backward subsumption and self-subsuming resolution using clause k:
+ * - if clause k subsumes another clause, that clause is removed
+ * - if clause k = C \/ l and another clause is D \/ not(l) where
+ *   C is a subset of D, then not(l) is removed from that clause
+ */
+static void pp_backward_subsume(sat_pp_t *pp, uint32_t k) {
+  pp_clause_t *c, *d;
+  ivector_t *cand;
+  uint32_t i, j, n, m, hits;
+  literal_t l, p, flip;
+  int32_t h;
+
+  c = pp->clause[k];
+  if (! c->live) return;
+
+  // p = literal of c that has the fewest occurrences
+  n = c->len;
+  p = c->lit[0];
+  m = UINT32_MAX;
+  for (i=0; i<n; i++) {
+    l = c->lit[i];
+    j = pp->occ[l].size + pp->occ[not(l)].size;
+    if (j < m) {
+      m = j;
+      p = l;
+    }
+    pp->lmark[l] = 1;
+  }
+
+  // candidates: all clauses that contain p or not(p)
+  cand = &pp->aux;
+  ivector_reset(cand);
+  ivector_add(cand, pp->occ[p].data, pp->occ[p].size);
+  ivector_add(cand, pp->occ[not(p)].data, pp->occ[not(p)].size);
+
+  for (i=0; i<cand->size; i++) {
+    h = cand->data[i];
+    if (h == k) continue;
+    d = pp->clause[h];
+    if (! d->live || d->len < n || (c->sgn & ~d->sgn) != 0) continue;
+
+    pp->effort -= d->len;
+    hits = 0;
+    flip = null_literal;
+    for (j=0; j<d->len; j++) {
+      l = d->lit[j];
+      if (pp->lmark[l]) {
+	hits ++;
+      } else if (pp->lmark[not(l)]) {
+	if (flip != null_literal) break;
+	flip = l;
+      }
+    }
+
+    if (hits == n) {
+      d->live = false;
+      pp->core->stats.subsumed_clauses ++;
+    } else if (hits == n-1 && flip != null_literal) {
+      pp_strengthen(pp, h, flip);
+      pp->core->stats.strengthened_clauses ++;
+    }
+  }
+
+  for (i=0; i<n; i++) {
+    pp->lmark[c->lit[i]] = 0;
+  }
+}
+
+
+/*
+ * Process the subsumption queue
+ */
+static void pp_subsume(sat_pp_t *pp) {
+  uint32_t i;
+
+  i = 0;
+  while (i < pp->queue.size && pp->effort > 0) {
+    pp_propagate_units(pp);
+    if (pp->unsat) return;
+    pp_backward_subsume(pp, pp->queue.data[i]);
+    i ++;
+  }
+  ivector_reset(&pp->queue);
+  pp_propagate_units(pp);
+}
+
+
+/*
+ * Check whether x can be eliminated
+ */
+static bool pp_candidate_var(sat_pp_t *pp, bvar_t x) {
+  smt_core_t *s;
+
+  s = pp->core;
+  return bvar_is_unassigned(s, x) && !bvar_has_atom(s, x) && !bvar_is_eliminated(s, x) &&
+    !tst_bit(pp->frozen, x);
+}
+
+
+/*
+ * Compute the resolvents of clauses c (contains x) and d (contains not(x))
+ * - the literals of c must be marked
+ * - if the resolvent is not a tautology, it's added to pp->resolvents
+ * - return its length or -1 if it's a tautology
+ */
+static int32_t pp_resolve(sat_pp_t *pp, pp_clause_t *c, pp_clause_t *d, bvar_t x) {
+  ivector_t *v;
+  uint32_t i, start;
+  literal_t l;
+
+  v = &pp->resolvents;
+  start = v->size;
+  ivector_push(v, 0); // place holder for the length
+
+  for (i=0; i<d->len; i++) {
+    l = d->lit[i];
+    if (var_of(l) != x) {
+      if (pp->lmark[not(l)]) {
+	// tautology
+	ivector_shrink(v, start);
+	return -1;
+      }
+      if (! pp->lmark[l]) {
+	ivector_push(v, l);
+      }
+    }
+  }
+  for (i=0; i<c->len; i++) {
+    l = c->lit[i];
+    if (var_of(l) != x) {
+      ivector_push(v, l);
+    }
+  }
+  pp->effort -= c->len + d->len;
+
+  v->data[start] = v->size - start - 1;
+  return v->data[start];
+}
+
+
+/*
+ * Save clause c on the elimination stack (with pivot l first)
+ */
+static void pp_save_clause(smt_core_t *s, pp_clause_t *c, literal_t l) {
+  ivector_t *v;
+  uint32_t i;
+
+  v = &s->elim_stack;
+  ivector_push(v, c->len);
+  ivector_push(v, l);
+  for (i=0; i<c->len; i++) {
+    if (c->lit[i] != l) {
+      ivector_push(v, c->lit[i]);
+    }
+  }
+}
+
+
+/*
+ * Try to eliminate variable x
+ * - x is eliminated if the number of non-tautological resolvents is no
+ *   more than the number of clauses that contain x or not(x), and all
+ *   resolvents have length <= PP_MAX_RESOLVENT_LENGTH.
+ * - return true if x is eliminated
+ */
+static bool pp_eliminate_var(sat_pp_t *pp, bvar_t x) {
+  smt_core_t *s;
+  ivector_t *pos, *neg;
+  pp_clause_t *c, *d;
+  uint32_t i, j, k, n, np, nn, nres;
+  int32_t len;
+
+  s = pp->core;
+  np = pp_clean_occ(pp, pos_lit(x));
+  nn = pp_clean_occ(pp, neg_lit(x));
+  if (np + nn == 0 || (np > PP_MAX_OCCURRENCES && nn > PP_MAX_OCCURRENCES)) {
+    return false;
+  }
+
+  pos = pp->occ + pos_lit(x);
+  neg = pp->occ + neg_lit(x);
+
+  // compute the resolvents
+  ivector_reset(&pp->resolvents);
+  nres = 0;
+  for (i=0; i<np; i++) {
+    c = pp->clause[pos->data[i]];
+    for (k=0; k<c->len; k++) pp->lmark[c->lit[k]] = 1;
+
+    for (j=0; j<nn; j++) {
+      d = pp->clause[neg->data[j]];
+      len = pp_resolve(pp, c, d, x);
+      if (len >= 0) {
+	nres ++;
+	if (len > PP_MAX_RESOLVENT_LENGTH || nres > np + nn) {
+	  nres = UINT32_MAX;
+	  break;
+	}
+      }
+    }
+
+    for (k=0; k<c->len; k++) pp->lmark[c->lit[k]] = 0;
+    if (nres == UINT32_MAX || pp->effort <= 0) {
+      ivector_reset(&pp->resolvents);
+      return false;
+    }
+  }
+
+  // remove the clauses of x and save them
+  for (i=0; i<np; i++) {
+    c = pp->clause[pos->data[i]];
+    pp_save_clause(s, c, pos_lit(x));
+    c->live = false;
+  }
+  for (i=0; i<nn; i++) {
+    c = pp->clause[neg->data[i]];
+    pp_save_clause(s, c, neg_lit(x));
+    c->live = false;
+  }
+  ivector_reset(pos);
+  ivector_reset(neg);
+
+  set_bit(s->elim, x);
+  s->nb_elim_vars ++;
+  s->stats.elim_vars ++;
+  decision_queue_remove(s, x);
+
+  // add the resolvents: their literals are distinct
+  i = 0;
+  n = pp->resolvents.size;
+  while (i < n) {
+    len = pp->resolvents.data[i];
+    pp_add_clause(pp, len, pp->resolvents.data + i + 1);
+    i += len + 1;
+  }
+  ivector_reset(&pp->resolvents);
+
+  return true;
+}
+
+
+/*
+ * Ordering for elimination: fewer occurrences first
+ */
+static bool pp_cheaper_var(void *data, int32_t x, int32_t y) {
+  uint32_t *cost;
+
+  cost = data;
+  return cost[x] < cost[y] || (cost[x] == cost[y] && x < y);
+}
+
+
+/*
+ * Bounded variable elimination
+ */
+static void pp_eliminate(sat_pp_t *pp) {
+  smt_core_t *s;
+  ivector_t *v;
+  uint32_t i, n;
+  bvar_t x;
+
+  s = pp->core;
+  n = s->nvars;
+  pp->cost = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
+
+  v = &pp->vars;
+  ivector_reset(v);
+  for (x=1; x<n; x++) {
+    if (pp_candidate_var(pp, x)) {
+      pp->cost[x] = pp_clean_occ(pp, pos_lit(x)) + pp_clean_occ(pp, neg_lit(x));
+      ivector_push(v, x);
+    }
+  }
+  int_array_sort2(v->data, v->size, pp->cost, pp_cheaper_var);
+
+  n = v->size;
+  for (i=0; i<n && pp->effort > 0; i++) {
+    x = v->data[i];
+    if (pp_candidate_var(pp, x) && pp_eliminate_var(pp, x)) {
+      pp_subsume(pp);
+      if (pp->unsat) break;
+    }
+  }
+}
+
+
+/*
+ * Copy the problem clauses of s into pp
+ * - the clauses that are true at level 0 are ignored (the locked
+ *   clauses are kept in s, the others are deleted)
+ * - all binary clauses are removed from s
+ */
+static void pp_import_clauses(sat_pp_t *pp) {
+  smt_core_t *s;
+  clause_t **v, *cl;
+  ivector_t *b;
+  literal_t l0, l1, *bin;
+  literal_t a[2];
+  uint32_t i, j, n;
+
+  s = pp->core;
+  b = &pp->aux;
+
+  v = s->problem_clauses;
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    cl = v[i];
+    assert(! is_clause_to_be_removed(cl));
+    if (! clause_is_locked(s, cl)) {
+      ivector_reset(b);
+      j = 0;
+      while (cl->cl[j] >= 0) {
+	ivector_push(b, cl->cl[j]);
+	j ++;
+      }
+      pp_add_clause(pp, b->size, b->data);
+      mark_for_removal(cl);
+    }
+  }
+
+  for (l0=0; l0<s->nlits; l0++) {
+    bin = s->bin[l0];
+    if (bin != NULL) {
+      for (j=0; bin[j] >= 0; j++) {
+	l1 = bin[j];
+	if (l0 < l1) {
+	  a[0] = l0;
+	  a[1] = l1;
+	  pp_add_clause(pp, 2, a);
+	}
+      }
+      delete_literal_vector(bin);
+      s->bin[l0] = NULL;
+    }
+  }
+  s->nb_bin_clauses = 0;
+
+  // remove the marked clauses from s
+  cleanup_watch_lists(s);
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (is_clause_to_be_removed(v[i])) {
+      delete_clause(s, v[i]);
+    } else {
+      v[j] = v[i];
+      j ++;
+    }
+  }
+  set_cv_size(v, j);
+  s->nb_clauses -= n - j;
+  s->nb_prob_clauses -= n - j;
+}
+
+
+/*
+ * Add the live clauses of pp back to s
+ * - all literals of these clauses are unassigned
+ */
+static void pp_export_clauses(sat_pp_t *pp) {
+  smt_core_t *s;
+  pp_clause_t *c;
+  clause_t **v;
+  uint32_t i, n;
+
+  s = pp->core;
+  n = pp->nclauses;
+  for (i=0; i<n; i++) {
+    c = pp->clause[i];
+    if (c->live) {
+      assert(c->len >= 2);
+      if (c->len == 2) {
+	direct_binary_clause(s, c->lit[0], c->lit[1]);
+      } else {
+	new_problem_clause(s, c->len, c->lit);
+      }
+    }
+  }
+
+  // recount the problem literals
+  s->stats.prob_literals = 0;
+  v = s->problem_clauses;
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    s->stats.prob_literals += clause_length(v[i]);
+  }
+}
+
+
+/*
+ * Delete the learned clauses that contain an eliminated variable
+ * (except the locked ones, which are true at level 0)
+ */
+static void remove_learned_clauses_with_eliminated_vars(smt_core_t *s) {
+  clause_t **v, *cl;
+  uint32_t i, j, n;
+  bool found;
+
+  found = false;
+  v = s->learned_clauses;
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    cl = v[i];
+    if (! clause_is_locked(s, cl)) {
+      for (j=0; cl->cl[j] >= 0; j++) {
+	if (bvar_is_eliminated(s, var_of(cl->cl[j]))) {
+	  mark_for_removal(cl);
+	  found = true;
+	  break;
+	}
+      }
+    }
+  }
+
+  if (found) {
+    delete_learned_clauses(s);
+  }
+}
+
+
+/*
+ * Probe literal l: assign l at level base_level+1, do boolean propagation
+ * then backtrack. The theory solver is not notified.
+ * - if this causes a conflict, not(l) is asserted at the base level
+ * - return false if the base level becomes inconsistent
+ */
+static bool probe_literal(smt_core_t *s, literal_t l) {
+  uint32_t k, theory_ptr;
+  bool ok;
+  bvar_t v;
+
+  assert(s->decision_level == s->base_level && literal_is_unassigned(s, l));
+
+  theory_ptr = s->stack.theory_ptr;
+
+  k = s->decision_level + 1;
+  s->decision_level = k;
+  if (s->stack.nlevels <= k) {
+    increase_stack_levels(&s->stack);
+  }
+  s->stack.level_index[k] = s->stack.top;
+  push_literal(&s->stack, l);
+  v = var_of(l);
+  s->value[v] = (VAL_TRUE ^ sign_of_lit(l));
+  s->level[v] = k;
+  s->antecedent[v] = mk_literal_antecedent(null_literal);
+
+  ok = boolean_propagation(s);
+  backtrack(s, s->base_level);
+  s->stack.theory_ptr = theory_ptr;
+
+  if (! ok) {
+    // failed literal
+    s->inconsistent = false;
+    s->conflict = NULL;
+    s->false_clause = NULL;
+    s->stats.failed_literals ++;
+
+    assign_literal(s, not(l));
+    s->nb_unit_clauses ++;
+    return boolean_propagation(s);
+  }
+
+  return true;
+}
+
+
+/*
+ * Failed-literal probing: we probe the roots of the binary implication
+ * graph (i.e., literals l that occur in no binary clause but such that
+ * not(l) does).
+ * - return false if a conflict is found at the base level
+ */
+static bool probe_failed_literals(smt_core_t *s) {
+  uint64_t max_props;
+  literal_t l;
+
+  max_props = s->stats.propagations + PP_PROBE_EFFORT;
+  for (l=2; l<s->nlits && s->stats.propagations < max_props; l++) {
+    if (s->bin[l] == NULL && s->bin[not(l)] != NULL &&
+	literal_is_unassigned(s, l) && ! bvar_is_eliminated(s, var_of(l))) {
+      if (! probe_literal(s, l)) return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Preprocessing
+ */
+void smt_preprocess(smt_core_t *s) {
+  sat_pp_t pp;
+  bool unsat;
+
+  if (! s->sat_preprocess || (s->option_flag & PUSH_POP_MASK) != 0 ||
+      s->base_level > 0 || non_empty_checkpoint_stack(&s->checkpoints)) {
+    return;
+  }
+
+  assert(s->status == STATUS_SEARCHING && s->decision_level == 0);
+
+  s->stats.preprocess_calls ++;
+
+  // the clauses created by the theory solver in start_search are in the lemma queue
+  if (! empty_lemma_queue(&s->lemmas)) {
+    add_all_lemmas(s);
+  }
+  if (s->inconsistent || !boolean_propagation(s)) return;
+
+  simplify_clause_database(s);
+  if (! probe_failed_literals(s)) return;
+
+  init_sat_pp(&pp, s);
+  pp_import_clauses(&pp);
+  pp_subsume(&pp);
+  if (! pp.unsat) {
+    pp_eliminate(&pp);
+  }
+  unsat = pp.unsat;
+  if (! unsat) {
+    pp_export_clauses(&pp);
+  }
+  delete_sat_pp(&pp);
+
+  if (unsat) {
+    record_empty_conflict(s);
+    return;
+  }
+
+  remove_learned_clauses_with_eliminated_vars(s);
+
+  // propagate the units found by the preprocessor
+  // then compact the clause arena: most problem clauses were rebuilt
+  if (boolean_propagation(s)) {
+    simplify_clause_database(s);
+    collect_clause_garbage(s);
+  }
+}
+
+
+/*
+ * Add a clause removed by variable elimination back to s
+ * - s must be at the base level
+ */
+static void add_restored_clause(smt_core_t *s, uint32_t n, literal_t *a) {
+  assert(s->decision_level == s->base_level);
+
+  if (preprocess_clause(s, &n, a)) {
+    if (n > 2) {
+      new_problem_clause(s, n, a);
+    } else if (n == 2) {
+      direct_binary_clause(s, a[0], a[1]);
+    } else if (n == 1) {
+      add_simplified_unit_clause(s, a[0]);
+    } else {
+      record_empty_conflict(s);
+    }
+  }
+}
+
+
+/*
+ * Restore eliminated variable x:
+ * - remove the records of x from the elimination stack
+ * - add the corresponding clauses back to s (this may restore
+ *   other variables).
+ */
+static void restore_bvar(smt_core_t *s, bvar_t x) {
+  ivector_t *v, saved;
+  uint32_t i, j, k, n;
+  int32_t *d;
+
+  assert(bvar_is_eliminated(s, x) && s->decision_level == s->base_level);
+
+  clr_bit(s->elim, x);
+  s->nb_elim_vars --;
+  s->stats.restored_vars ++;
+  decision_queue_insert(s, x);
+
+  init_ivector(&saved, 0);
+  v = &s->elim_stack;
+  d = v->data;
+  i = 0;
+  j = 0;
+  while (i < v->size) {
+    n = d[i];
+    if (var_of(d[i+1]) == x) {
+      ivector_add(&saved, d + i, n + 1);
+    } else {
+      for (k=0; k<=n; k++) {
+	d[j+k] = d[i+k];
+      }
+      j += n + 1;
+    }
+    i += n + 1;
+  }
+  ivector_shrink(v, j);
+
+  i = 0;
+  while (i < saved.size) {
+    n = saved.data[i];
+    smt_restore_literals(s, n, saved.data + i + 1);
+    add_restored_clause(s, n, saved.data + i + 1);
+    i += n + 1;
   }
 
-  s->aux_literals /= 2;
-  s->stats.bin_clauses_deleted += s->aux_literals;
-  s->nb_bin_clauses -= s->aux_literals;
+  delete_ivector(&saved);
+}
 
-  s->aux_literals = 0;
+
+/*
+ * Restore all eliminated variables of a[0 ... n-1]
+ */
+void smt_restore_literals(smt_core_t *s, uint32_t n, const literal_t *a) {
+  uint32_t i;
+  bvar_t x;
+
+  if (s->nb_elim_vars == 0) return;
+
+  for (i=0; i<n; i++) {
+    x = var_of(a[i]);
+    if (bvar_is_eliminated(s, x)) {
+      if (s->decision_level > s->base_level) {
+	s->inconsistent = false; // clear conflict if any
+	backtrack_to_base_level(s);
+      }
+      restore_bvar(s, x);
+    }
+  }
 }
 
 
 /*
- * Simplify the database: problem clauses and learned clauses
- * - remove clauses that are true at the base level from the watched lists
- * - if base_level is 0, also remove binary clauses that are true at the
- *   base level.
+ * Extend the current assignment to the eliminated variables
+ * - all other variables must be assigned
+ * - the eliminated variables are assigned at a new decision level so
+ *   that they're unassigned on backtracking
+ * - the clauses of the elimination stack are processed in reverse
+ *   order: if a clause is false, its pivot literal is set to true.
+ * - the eliminated variables have no atoms so the theory solver
+ *   doesn't need to see them.
  */
-static void simplify_clause_database(smt_core_t *s) {
-  assert(s->stack.top == s->stack.prop_ptr && s->decision_level == s->base_level);
+static void extend_assignment(smt_core_t *s) {
+  ivector_t start;
+  uint32_t i, j, k, n;
+  literal_t l, *a;
+  int32_t *d;
+  bool sat;
+  bvar_t x;
 
-  simplify_clause_set(s);
-  if (s->base_level == 0) {
-    simplify_binary_vectors(s);
+  // theory_ptr is not used if s->bool_only is true
+  assert(s->stack.prop_ptr == s->stack.top &&
+         (s->bool_only || s->stack.theory_ptr == s->stack.top));
+
+  // new decision level
+  k = s->decision_level + 1;
+  s->decision_level = k;
+  if (s->stack.nlevels <= k) {
+    increase_stack_levels(&s->stack);
   }
+  s->stack.level_index[k] = s->stack.top;
+  s->th_ctrl.increase_decision_level(s->th_solver);
 
-  s->stats.simplify_calls ++;
+  // collect the start of each record
+  init_ivector(&start, 0);
+  d = s->elim_stack.data;
+  i = 0;
+  while (i < s->elim_stack.size) {
+    ivector_push(&start, i);
+    i += d[i] + 1;
+  }
 
-  /*
-   * The next call to simplify_clause_database is enabled when
-   *   s->decision_level == base_level &&
-   *   s->stack.top > s->simplify_bottom &&
-   *   s->stats.propagations > s->simplify_props + s->simplify_threshold
-   *
-   * s->simplify_threshold is set to the total number of literals.
-   *
-   * This is an arbitrary choice that avoids calling simplify too often.
-   * This is copied from Minisat.
-   */
-  s->simplify_bottom = s->stack.top;
-  s->simplify_props = s->stats.propagations;
-  s->simplify_threshold = s->stats.learned_literals + s->stats.prob_literals +
-    2 * s->nb_bin_clauses;
+  i = start.size;
+  while (i > 0) {
+    i --;
+    n = d[start.data[i]];
+    a = d + start.data[i] + 1;
+    x = var_of(a[0]);
+    if (bval_is_undef(s->value[x])) {
+      // assign x using its preferred polarity
+      s->value[x] |= 2;
+      s->level[x] = k;
+      s->antecedent[x] = mk_literal_antecedent(null_literal);
+      push_literal(&s->stack, pos_lit(x));
+    }
+    sat = false;
+    for (j=0; j<n; j++) {
+      if (literal_value(s, a[j]) == VAL_TRUE) {
+	sat = true;
+	break;
+      }
+    }
+    if (! sat) {
+      s->value[x] = (VAL_TRUE ^ sign_of_lit(a[0]));
+    }
+  }
+  delete_ivector(&start);
+
+  // fix the literals on the stack
+  for (i=s->stack.level_index[k]; i<s->stack.top; i++) {
+    x = var_of(s->stack.lit[i]);
+    l = pos_lit(x);
+    if (s->value[x] == VAL_FALSE) l = neg_lit(x);
+    s->stack.lit[i] = l;
+  }
+
+  if (s->stack.theory_ptr == s->stack.prop_ptr) {
+    s->stack.theory_ptr = s->stack.top;
+  }
+  s->stack.prop_ptr = s->stack.top;
 }
 
 
+/*
+ * Check whether the eliminated variables need to be assigned
+ */
+static bool eliminated_vars_unassigned(smt_core_t *s) {
+  ivector_t *v;
+
+  v = &s->elim_stack;
+  return v->size > 0 && bvar_is_unassigned(s, var_of(v->data[1]));
+}
+
 
 
 /**************
@@ -4899,14 +7083,14 @@ static void remove_problem_clauses(smt_core_t *s, uint32_t n) {
 
 
 /*
- * Reset the watch lists (to empty lists)
+ * Reset the watch vectors (to empty vectors)
  */
 static void reset_watch_lists(smt_core_t *s) {
   uint32_t i, n;
 
   n = s->nlits;
   for (i=0; i<n; i++) {
-    s->watch[i] = NULL_LINK;
+    reset_watch_vector(s->watch + i);
   }
 }
 
@@ -4920,7 +7104,6 @@ static void restore_clauses(smt_core_t *s, uint32_t n) {
   uint32_t i, m, nlits;
   clause_t **v;
   clause_t *cl;
-  literal_t l;
 
   // mark clauses for removal
   remove_all_learned_clauses(s);
@@ -4933,14 +7116,14 @@ static void restore_clauses(smt_core_t *s, uint32_t n) {
   v = s->learned_clauses;
   m = get_cv_size(v);
   for (i=0; i<m; i++) {
-    delete_learned_clause(v[i]);
+    delete_learned_clause(s, v[i]);
   }
   reset_clause_vector(v);
 
   v = s->problem_clauses;
   m = get_cv_size(v);
   for (i=n; i<m; i++) {
-    delete_clause(v[i]);
+    delete_clause(s, v[i]);
   }
   set_cv_size(v, n);
 
@@ -4957,12 +7140,8 @@ static void restore_clauses(smt_core_t *s, uint32_t n) {
     }
     nlits += clause_length(cl);
 
-    // add cl at the start of its watch lists
-    l = cl->cl[0];
-    s->watch[l] = cons(0, cl, s->watch[l]);
-
-    l = cl->cl[1];
-    s->watch[l] = cons(1, cl, s->watch[l]);
+    // add cl to its watch vectors
+    add_clause_watchers(s, cl);
   }
 
 
@@ -5018,7 +7197,7 @@ static void restore_variables(smt_core_t *s, uint32_t n) {
 
   nv = s->nvars;
   for (i=n; i<nv; i++) {
-    heap_remove(&s->heap, i);
+    decision_queue_remove(s, i);
     if (bvar_has_atom(s, i)) {
       remove_atom(&s->atoms, i);
     }
@@ -5029,8 +7208,8 @@ static void restore_variables(smt_core_t *s, uint32_t n) {
     delete_literal_vector(s->bin[l1]);
     s->bin[l0] = NULL;
     s->bin[l1] = NULL;
-    s->watch[l0] = NULL_LINK;
-    s->watch[l1] = NULL_LINK;
+    delete_watch_vector(s->watch + l0);
+    delete_watch_vector(s->watch + l1);
   }
 
   s->nvars = n;
@@ -5117,7 +7296,14 @@ void smt_cleanup(smt_core_t *s) {
  * Clear the current boolean assignment and reset status to IDLE
  */
 void smt_clear(smt_core_t *s) {
-  assert(s->status == STATUS_SAT || s->status == STATUS_UNKNOWN);
+  assert(s->status == STATUS_SAT || s->status == STATUS_UNKNOWN ||
+         smt_unsat_by_assumptions(s));
+
+  // remove the assumptions
+  ivector_reset(&s->assumptions);
+  s->assumption_index = 0;
+  s->bad_assumption = null_literal;
+  ivector_reset(&s->failed_assumptions);
 
   // Give a chance to the theory solver to cleanup its own state
   s->th_ctrl.clear(s->th_solver);
@@ -5216,7 +7402,7 @@ static bool delete_variables(smt_core_t *s, uint32_t n) {
     m = tbl->size;
   }
   for (x=n; x<m; x++) {
-    heap_remove(&s->heap, x);
+    decision_queue_remove(s, x);
     if (tst_bit(tbl->has_atom, x)) {
       s->th_smt.delete_atom(s->th_solver, tbl->atom[x]);
       remove_atom(tbl, x);
@@ -5279,9 +7465,10 @@ static void remove_garbage_bin_clauses(smt_core_t *s, uint32_t old_nvars) {
   // s->aux_literal counts the number of literals removed
   s->aux_literals = 0;
 
-  // cleanup the vectors bin[l]
+  // cleanup the vectors bin[l] and delete the watch vectors of the removed literals
   for (l0=max; l0<pos_lit(old_nvars); l0++) {
     // l0 is a removed literal
+    delete_watch_vector(s->watch + l0);
     v0 = s->bin[l0];
     if (v0 != NULL) {
       n = get_lv_size(v0);
@@ -5294,7 +7481,6 @@ static void remove_garbage_bin_clauses(smt_core_t *s, uint32_t old_nvars) {
       delete_literal_vector(v0);
       s->bin[l0] = NULL;
       s->aux_literals += n;
-      s->watch[l0] = NULL_LINK; // not strictly necessary
     }
   }
 
@@ -5367,7 +7553,7 @@ static void remove_garbage_clauses(smt_core_t *s) {
   j = 0;
   for (i=0; i<n; i++) {
     if (is_clause_to_be_removed(v[i])) {
-      delete_clause(v[i]);
+      delete_clause(s, v[i]);
     } else {
       v[j] = v[i];
       j++;
@@ -5383,7 +7569,7 @@ static void remove_garbage_clauses(smt_core_t *s) {
   j = 0;
   for (i=0; i<n; i++) {
     if (is_clause_to_be_removed(v[i])) {
-      delete_learned_clause(v[i]);
+      delete_learned_clause(s, v[i]);
     } else {
       v[j] = v[i];
       j ++;
@@ -5578,14 +7764,26 @@ void start_search(smt_core_t *s) {
   s->simplify_props = 0;
   s->simplify_threshold = 0;
 
+  s->assumption_index = 0;
+  s->bad_assumption = null_literal;
+  ivector_reset(&s->failed_assumptions);
+
   /*
    * Allow theory solver to do whatever initializations it needs
    */
   s->th_ctrl.start_search(s->th_solver);
 
+  if (s->sat_preprocess) {
+    smt_preprocess(s);
+  }
+
 #if DEBUG
-  check_heap_content(s);
-  check_heap(s);
+  if (s->use_vmtf) {
+    check_vmtf(s);
+  } else {
+    check_heap_content(s);
+    check_heap(s);
+  }
 #endif
 }
 
@@ -5603,6 +7801,175 @@ void stop_search(smt_core_t *s) {
 }
 
 
+/*
+ * Set the assumptions for the next search
+ * - the eliminated variables of a[0 ... n-1] are restored
+ */
+void smt_set_assumptions(smt_core_t *s, uint32_t n, const literal_t *a) {
+  assert(s->status == STATUS_IDLE);
+
+  smt_restore_literals(s, n, a);
+  ivector_reset(&s->assumptions);
+  ivector_add(&s->assumptions, a, n);
+  s->assumption_index = 0;
+  s->bad_assumption = null_literal;
+  ivector_reset(&s->failed_assumptions);
+}
+
+
+/*
+ * Mark variable x if it's assigned above the base level
+ */
+static inline void mark_assumption_var(smt_core_t *s, bvar_t x) {
+  if (s->level[x] > s->base_level) {
+    set_var_mark(s, x);
+  }
+}
+
+
+/*
+ * Compute the assumptions that caused unsat:
+ * - k = index of the assumption l that's false
+ * - all the decisions above the base level are assumptions
+ * - we follow the antecedents of not(l) back to the decisions
+ *   (as in resolve_conflict) then collect the indices of the marked
+ *   decisions in s->failed_assumptions.
+ */
+static void collect_failed_assumptions(smt_core_t *s, uint32_t k) {
+  ivector_t *v;
+  literal_t *stack, *c;
+  literal_t l, b;
+  antecedent_t a;
+  clause_t *cl;
+  uint32_t i, j, bottom, n;
+  bvar_t x;
+
+  v = &s->failed_assumptions;
+  ivector_reset(v);
+  ivector_push(v, k);
+
+  l = s->assumptions.data[k];
+  assert(literal_value(s, l) == VAL_FALSE);
+
+  x = var_of(l);
+  if (s->level[x] <= s->base_level) {
+    // l is false at the base level
+    return;
+  }
+
+  mark_assumption_var(s, x);
+
+  stack = s->stack.lit;
+  bottom = s->stack.level_index[s->base_level + 1];
+  j = s->stack.top;
+  while (j > bottom) {
+    j --;
+    b = stack[j];
+    x = var_of(b);
+    if (is_var_marked(s, x)) {
+      a = s->antecedent[x];
+      switch (antecedent_tag(a)) {
+      case clause0_tag:
+      case clause1_tag:
+        cl = clause_antecedent(a);
+        i = clause_index(a);
+        c = cl->cl;
+        assert(c[i] == b);
+        mark_assumption_var(s, var_of(c[i^1]));
+        c += 2;
+        while (*c >= 0) {
+          mark_assumption_var(s, var_of(*c));
+          c ++;
+        }
+        break;
+
+      case literal_tag:
+        l = literal_antecedent(a);
+        if (l == null_literal) {
+          // decision: keep the mark
+          continue;
+        }
+        mark_assumption_var(s, var_of(l));
+        break;
+
+      case generic_tag:
+        explain_antecedent(s, b, a);
+        c = s->explanation.data;
+        for (i=0; i<s->explanation.size; i++) {
+          mark_assumption_var(s, var_of(c[i]));
+        }
+        break;
+      }
+      clr_var_mark(s, x);
+    }
+  }
+
+  // collect the marked decisions
+  n = s->assumptions.size;
+  for (i=0; i<n; i++) {
+    l = s->assumptions.data[i];
+    x = var_of(l);
+    if (i != k && is_var_marked(s, x) && literal_value(s, l) == VAL_TRUE &&
+        s->level[x] > s->base_level) {
+      assert(s->antecedent[x] == mk_literal_antecedent(null_literal));
+      ivector_push(v, i);
+    }
+  }
+
+  // clear the marks
+  for (i=s->base_level+1; i<=s->decision_level; i++) {
+    x = var_of(stack[s->stack.level_index[i]]);
+    clr_var_mark(s, x);
+  }
+}
+
+
+/*
+ * Next assumption to decide (or null_literal)
+ */
+literal_t get_next_assumption(smt_core_t *s) {
+  uint32_t i, n;
+  literal_t l;
+
+  assert(s->status == STATUS_SEARCHING);
+
+  n = s->assumptions.size;
+  for (i=s->assumption_index; i<n; i++) {
+    l = s->assumptions.data[i];
+    switch (literal_value(s, l)) {
+    case VAL_FALSE:
+      s->assumption_index = i;
+      s->bad_assumption = l;
+      collect_failed_assumptions(s, i);
+      s->status = STATUS_UNSAT;
+      return null_literal;
+
+    case VAL_UNDEF_FALSE:
+    case VAL_UNDEF_TRUE:
+      s->assumption_index = i;
+      return l;
+
+    case VAL_TRUE:
+      break;
+    }
+  }
+
+  s->assumption_index = n;
+  return null_literal;
+}
+
+
+/*
+ * Get the failed assumptions
+ */
+void smt_failed_assumptions(smt_core_t *s, ivector_t *v) {
+  assert(s->status == STATUS_UNSAT);
+
+  ivector_reset(v);
+  ivector_add(v, s->failed_assumptions.data, s->failed_assumptions.size);
+}
+
+
 /*
  * Core solving function.
  *
@@ -5630,7 +7997,9 @@ static bool smt_core_process(smt_core_t *s, uint64_t max_conflicts) {
       }
       // decay activities after every conflict
       s->cla_inc *= s->inv_cla_decay;
-      s->heap.act_increment *= s->heap.inv_act_decay;
+      if (! s->use_vmtf) {
+        s->heap.act_increment *= s->heap.inv_act_decay;
+      }
 
       // exit if max_conflict reached
       if (num_conflicts(s) >= max_conflicts) {
@@ -5695,6 +8064,14 @@ void smt_final_check(smt_core_t *s) {
   assert(s->status == STATUS_SEARCHING || s->status == STATUS_INTERRUPTED);
 
   if (s->status == STATUS_SEARCHING) {
+    /*
+     * The theory solver and the model construction may need the
+     * value of eliminated variables (e.g., bit-blasted variables).
+     */
+    if (eliminated_vars_unassigned(s)) {
+      extend_assignment(s);
+    }
+
     switch (s->th_ctrl.final_check(s->th_solver)) {
     case FCHECK_CONTINUE:
       /*
@@ -5758,6 +8135,7 @@ static void cleanup_heap(smt_core_t *s) {
 /*
  * Check whether all variables assigned at level k have
  * activity less than ax
+ * - literals of lower levels assigned out of order are skipped
  */
 static bool level_has_lower_activity(smt_core_t *s, double ax, uint32_t k) {
   prop_stack_t *stack;
@@ -5777,8 +8155,8 @@ static bool level_has_lower_activity(smt_core_t *s, double ax, uint32_t k) {
 
   while (i < n) {
     x = var_of(stack->lit[i]);
-    assert(bvar_is_assigned(s, x) && s->level[x] == k);
-    if (s->heap.activity[x] >= ax) {
+    assert(bvar_is_assigned(s, x) && s->level[x] <= k);
+    if (s->level[x] == k && s->heap.activity[x] >= ax) {
       return false;
     }
     i ++;
@@ -5823,6 +8201,7 @@ void smt_restart(smt_core_t *s) {
   printf("\n---> DPLL RESTART\n");
 #endif
   s->stats.restarts ++;
+  s->target_assigned = 0;
   if (s->base_level < s->decision_level) {
     full_restart(s);
   }
@@ -5841,11 +8220,18 @@ void smt_partial_restart(smt_core_t *s) {
 
   assert(s->status == STATUS_SEARCHING);
 
+  if (s->use_vmtf) {
+    // partial restarts require variable activities
+    smt_restart(s);
+    return;
+  }
+
 #if TRACE
   printf("\n---> DPLL PARTIAL RESTART\n");
 #endif
 
   s->stats.restarts ++;
+  s->target_assigned = 0;
 
   if (s->base_level < s->decision_level) {
     cleanup_heap(s);
@@ -5893,11 +8279,18 @@ void smt_partial_restart_var(smt_core_t *s) {
 
   assert(s->status == STATUS_SEARCHING);
 
+  if (s->use_vmtf) {
+    // partial restarts require variable activities
+    smt_restart(s);
+    return;
+  }
+
 #if TRACE
   printf("\n---> DPLL PARTIAL RESTART (VARIANT)\n");
 #endif
 
   s->stats.restarts ++;
+  s->target_assigned = 0;
   if (s->base_level < s->decision_level) {
     cleanup_heap(s);
     if (heap_is_empty(&s->heap)) {
@@ -5923,6 +8316,86 @@ void smt_partial_restart_var(smt_core_t *s) {
 
 
 
+/********************
+ *  CLAUSE SHARING  *
+ *******************/
+
+/*
+ * Attach/detach a clause ring
+ */
+void smt_attach_clause_ring(smt_core_t *s, clause_ring_t *ring, uint32_t id) {
+  assert(ring->nvars <= s->nvars);
+
+  s->ring = ring;
+  s->ring_cursor = clause_ring_head(ring);
+  s->ring_id = id;
+}
+
+void smt_detach_clause_ring(smt_core_t *s) {
+  s->ring = NULL;
+  s->ring_cursor = 0;
+  s->ring_id = 0;
+}
+
+
+/*
+ * Add a clause c read from the ring
+ * - s must be at the base level
+ * - the clause is added as a learned clause if it has more than two literals
+ */
+static void import_clause(smt_core_t *s, shared_clause_t *c) {
+  clause_t *cl;
+  literal_t *a;
+  uint32_t n;
+
+  assert(s->decision_level == s->base_level);
+
+  n = c->len;
+  a = c->lit;
+  smt_restore_literals(s, n, a);
+  if (preprocess_clause(s, &n, a)) {
+    if (n > 2) {
+      // all literals are unassigned so a[0] and a[1] can be watched
+      cl = new_learned_clause(s, n, a);
+      add_clause_to_vector(&s->learned_clauses, cl);
+      increase_clause_activity(s, cl);
+      set_glue(cl, (c->glue < n) ? c->glue : n);
+      learned(cl)->used = 1;
+
+      add_clause_watchers(s, cl);
+
+      s->nb_clauses ++;
+      s->stats.learned_literals += n;
+    } else if (n == 2) {
+      add_simplified_binary_clause(s, a[0], a[1]);
+    } else if (n == 1) {
+      add_simplified_unit_clause(s, a[0]);
+    } else {
+      record_empty_conflict(s);
+    }
+  }
+}
+
+
+/*
+ * Import the clauses exported by the other cores
+ */
+void smt_import_shared_clauses(smt_core_t *s) {
+  shared_clause_t c;
+
+  if (s->ring != NULL) {
+    assert(s->status == STATUS_SEARCHING && s->decision_level == s->base_level);
+    while (!s->inconsistent && clause_ring_import(s->ring, &s->ring_cursor, s->ring_id, &c)) {
+      import_clause(s, &c);
+      s->stats.imported_clauses ++;
+    }
+  }
+}
+
+
+
+
+
 /*******************
  *  CHECK CLAUSES  *
  ******************/
@@ -6097,6 +8570,60 @@ static void check_heap(smt_core_t *s) {
 
 
 
+/*
+ * Check the VMTF queue: all variables that are not eliminated must be
+ * in the list, stamps must be increasing, and all variables after
+ * the search variable must be assigned.
+ */
+static void check_vmtf(smt_core_t *s) {
+  vmtf_queue_t *q;
+  bvar_t x, y;
+  uint32_t n;
+  bool after_search;
+
+  q = &s->vmtf;
+  n = 0;
+  y = null_bvar;
+  after_search = (q->search == null_bvar);
+  for (x = q->first; x >= 0; x = q->next[x]) {
+    n ++;
+    if (q->prev[x] != y) {
+      printf("ERROR: incorrect VMTF queue: bad predecessor for variable %"PRId32"\n", x);
+      fflush(stdout);
+    }
+    if (q->stamp[x] <= q->stamp[y]) {
+      printf("ERROR: incorrect VMTF queue: stamps are not increasing at variable %"PRId32"\n", x);
+      fflush(stdout);
+    }
+    if (after_search && bval_is_undef(s->value[x]) && ! bvar_is_eliminated(s, x)) {
+      printf("ERROR: incorrect VMTF queue: unassigned variable %"PRId32" is after the search variable\n", x);
+      fflush(stdout);
+    }
+    if (x == q->search) {
+      after_search = true;
+    }
+    y = x;
+  }
+  if (y != q->last) {
+    printf("ERROR: incorrect VMTF queue: bad last variable\n");
+    fflush(stdout);
+  }
+
+  for (x=0; x<s->nvars; x++) {
+    if (! bvar_is_eliminated(s, x) && ! vmtf_member(q, x)) {
+      printf("ERROR: incorrect VMTF queue: variable %"PRId32" is not in the queue\n", x);
+      fflush(stdout);
+    } else if (vmtf_member(q, x)) {
+      n --;
+    }
+  }
+  if (n != 0) {
+    printf("ERROR: incorrect VMTF queue: bad number of elements\n");
+    fflush(stdout);
+  }
+}
+
+
 /*
  * Check propagation results
  */
@@ -6122,15 +8649,18 @@ static inline int32_t indicator(bval_t v, bval_t c) {
 }
 
 static void check_watch_list(smt_core_t *s, literal_t l, clause_t *cl) {
-  link_t lnk;
+  watcher_t *w;
+  uint32_t i, n;
 
-  for (lnk = s->watch[l]; lnk != NULL_LINK; lnk = next_of(lnk)) {
-    if (clause_of(lnk) == cl) {
+  w = s->watch[l].data;
+  n = s->watch[l].size;
+  for (i=s->watch[l].start; i<n; i++) {
+    if (w[i].clause == cl) {
       return;
     }
   }
 
-  printf("ERROR: missing watch, literal = %"PRId32", clause = %p\n", l, clause_of(lnk));
+  printf("ERROR: missing watch, literal = %"PRId32", clause = %p\n", l, cl);
 }
 
 
@@ -6331,7 +8861,7 @@ static bool check_precedence(smt_core_t *s, literal_t l0, literal_t l) {
   for (;;) {
     assert(i < s->stack.top);
     l1 = s->stack.lit[i];
-    assert(d_level(s, l1) == k);
+    assert(d_level(s, l1) <= k);
     if (l1 == l0) return true;
     if (l1 == l) return false;
     i ++;
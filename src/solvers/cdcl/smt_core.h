@@ -54,9 +54,11 @@
 #include <stddef.h>
 
 #include "io/tracer.h"
+#include "solvers/cdcl/clause_ring.h"
 #include "solvers/cdcl/smt_core_base_types.h"
 #include "utils/bitvectors.h"
 #include "utils/int_vectors.h"
+#include "utils/tag_map.h"
 
 #include "yices_types.h"
 
@@ -71,21 +73,22 @@
 
 /*
  * Clauses structure
- * - two pointers to form lists of clauses for the watched literals
  * - a clause is an array of literals terminated by an end marker
  *   (a negative number).
  * - the first two literals stored in cl[0] and cl[1]
  *   are the watched literals.
  * Learned clauses have the same components as a clause
- * and an activity, i.e., a float used by the clause-deletion
- * heuristic. (Because of alignment and padding, this wastes 32bits
- * on a 64bit machine....)
- *
- * Linked lists:
- * - a link lnk is a pointer to a clause cl
- *   the low-order bits of lnk encode whether the next link is
- *   in cl->link[0] or cl->link[1]
- * - this is compatible with the tagged pointers used as antecedents.
+ * and extra data used by the clause-deletion heuristic:
+ * - activity: a float increased every time the clause is
+ *   involved in conflict resolution
+ * - glue: literal block distance (LBD), i.e., number of distinct
+ *   decision levels in the clause. It's computed when the clause
+ *   is created and updated if it decreases during conflict resolution.
+ *   It's capped at MAX_CLAUSE_GLUE.
+ * - used: set when the clause is involved in conflict resolution,
+ *   decremented by each call to reduce_clause_database.
+ * (activity, glue, and used fit in 8 bytes, so the clause stays
+ * aligned on 8 bytes in the clause arena).
  *
  * SPECIAL CODING: to distinguish between learned clauses and problem
  * clauses, the end marker is different.
@@ -108,63 +111,47 @@ enum {
 
 typedef struct clause_s clause_t;
 
-typedef uintptr_t link_t;
-
 struct clause_s {
-  link_t link[2];
   literal_t cl[0];
 };
 
 typedef struct learned_clause_s {
   float activity;
+  uint16_t glue;
+  uint16_t used;
   clause_t clause;
 } learned_clause_t;
 
 
 /*
- * Tagging/untagging of link pointers
+ * Watch lists:
+ * - for a literal l, watch[l] is a vector of watchers, one for
+ *   each clause cl where l is a watched literal (i.e., l is cl[0] or cl[1])
+ * - each watcher stores a pointer to cl and a blocker literal:
+ *   if the blocker is true, then cl is true and propagation can skip cl
+ *   without reading it. The blocker is initially the other watched literal
+ *   of cl, and it's updated to a true literal of cl when one is found.
  */
-#define LINK_TAG ((uintptr_t) 0x1)
-#define NULL_LINK ((link_t) 0)
-
-static inline link_t mk_link(clause_t *c, uint32_t i) {
-  assert((i & ~LINK_TAG) == 0 && (((uintptr_t) c) & LINK_TAG) == 0);
-  return (link_t)(((uintptr_t) c) | ((uintptr_t) i));
-}
-
-static inline clause_t *clause_of(link_t lnk) {
-  return (clause_t *)(lnk & ~LINK_TAG);
-}
-
-static inline uint32_t idx_of(link_t lnk) {
-  return (uint32_t)(lnk & LINK_TAG);
-}
-
-static inline link_t next_of(link_t lnk) {
-  return clause_of(lnk)->link[idx_of(lnk)];
-}
-
-
-/*
- * return a new link lnk0 such that
- * - clause_of(lnk0) = c
- * - idx_of(lnk0) = i
- * - next_of(lnk0) = lnk
- */
-static inline link_t cons(uint32_t i, clause_t *c, link_t lnk) {
-  assert(i <= 1);
-  c->link[i] = lnk;
-  return mk_link(c, i);
-}
+typedef struct watcher_s {
+  clause_t *clause;
+  literal_t blocker;
+} watcher_t;
 
 /*
- * If lnk points to a clause cl, then return
- * a pointer to either cl->link[0] or cl->link[1], depending on
- * the lower order bit of lnk.
+ * Watch vector: watch[l] is a descriptor (not a pointer) so that
+ * propagation can find the watchers of l without an extra indirection.
+ * - data = array of watchers (NULL if nothing has been allocated yet)
+ * - the elements are data[start ... size-1]
+ * - new elements are added at the end
+ * - propagation scans the vector from the end (so that the
+ *   most recent clauses are visited first) and moves the
+ *   elements it keeps toward the end, which increases start.
  */
-static inline link_t *cdr_ptr(link_t lnk) {
-  return clause_of(lnk)->link + idx_of(lnk);
-}
+typedef struct watch_vector_s {
+  watcher_t *data;
+  uint32_t start;
+  uint32_t size;
+} watch_vector_t;
 
 
 
@@ -192,6 +179,15 @@ typedef struct literal_vector_s {
   literal_t data[0];
 } literal_vector_t;
 
+/*
+ * The watchers of a watch vector are stored in an array preceded by
+ * a hidden header that gives the array's capacity.
+ */
+typedef struct watcher_array_s {
+  uint32_t capacity;
+  watcher_t data[0];
+} watcher_array_t;
+
 
 /*
  * Acces to header of clause vector v
@@ -233,6 +229,18 @@ static inline uint32_t get_lv_capacity(literal_t *v) {
 }
 
 
+/*
+ * Header and capacity of a watcher array d
+ */
+static inline watcher_array_t *wa_header(watcher_t *d) {
+  return (watcher_array_t *)(((char *) d) - offsetof(watcher_array_t, data));
+}
+
+static inline uint32_t get_wa_capacity(watcher_t *d) {
+  return wa_header(d)->capacity;
+}
+
+
 
 /*
  * Default sizes and max sizes of vectors
@@ -244,6 +252,67 @@ static inline uint32_t get_lv_capacity(literal_t *v) {
 #define DEF_LITERAL_BUFFER_SIZE 100
 #define MAX_LITERAL_VECTOR_SIZE (((uint32_t)(UINT32_MAX-sizeof(literal_vector_t)))/4)
 
+#define DEF_WATCH_VECTOR_SIZE 4
+#define MAX_WATCH_VECTOR_SIZE (((uint32_t)(UINT32_MAX-sizeof(watcher_array_t)))/sizeof(watcher_t))
+
+
+
+
+/*******************
+ *  CLAUSE ARENA   *
+ ******************/
+
+/*
+ * All problem and learned clauses are allocated in an arena:
+ * - the arena is a list of large blocks; clauses are allocated
+ *   sequentially in the most recent block (no per-clause malloc).
+ * - block sizes are counted in 8-byte words (so that every clause
+ *   is aligned on 8 bytes, as required by tagged antecedents).
+ * - deleting a clause does not free memory: it only increments
+ *   the number of wasted words.
+ * - when the wasted fraction is large, the arena is compacted:
+ *   all live clauses are copied into a single new block, in the
+ *   order of the clause vectors, and all pointers to them (clause
+ *   vectors, watch lists, antecedents) are updated.
+ *
+ * Pointers to clauses remain valid until the next compaction.
+ * Compaction is done only after the clause database is reduced
+ * or simplified, outside of conflict resolution.
+ *
+ * For each block:
+ * - next = previous block in the list
+ * - capacity = number of words in data
+ * - size = number of words used
+ * For the arena:
+ * - block = most recent block (or NULL)
+ * - capacity = total capacity of all the blocks
+ * - live = number of words in live clauses
+ * - wasted = number of words in deleted clauses
+ */
+typedef struct clause_block_s clause_block_t;
+
+struct clause_block_s {
+  clause_block_t *next;
+  uint32_t capacity;
+  uint32_t size;
+  uint64_t data[0];
+};
+
+typedef struct clause_arena_s {
+  clause_block_t *block;
+  uint64_t capacity;
+  uint64_t live;
+  uint64_t wasted;
+} clause_arena_t;
+
+#define DEF_CLAUSE_BLOCK_SIZE 4096
+#define MAX_CLAUSE_BLOCK_SIZE ((uint32_t)((UINT32_MAX-sizeof(clause_block_t))/8))
+
+/*
+ * The arena is compacted when wasted > (live + wasted)/CLAUSE_ARENA_WASTE_RATIO
+ */
+#define CLAUSE_ARENA_WASTE_RATIO 4
+
 
 
 /**********************************
@@ -262,6 +331,10 @@ static inline uint32_t get_lv_capacity(literal_t *v) {
  * - for each decision level, an index into the stack points
  *   to the literal decided or assigned at that level (for backtracking)
  * - for level 0, level_index[0] = 0 = index of the first literal assigned
+ * - if chronological backtracking is enabled, the literals of a level
+ *   are not necessarily contiguous: literals of lower levels may be
+ *   assigned out of order above level_index[k] (but level_index[k] is
+ *   always the decision literal of level k).
  */
 typedef struct {
   literal_t *lit;
@@ -397,6 +470,45 @@ typedef struct var_heap_s {
 } var_heap_t;
 
 
+/*
+ * VMTF queue (variable move-to-front): alternative to the heap
+ * - the variables are stored in a doubly-linked list, ordered by the
+ *   time they were last bumped (most recent at the end of the list)
+ * - prev[x] and next[x] = predecessor and successor of x in the list
+ *   (null_bvar at both ends)
+ * - stamp[x] = enqueue time of x, stamp[x] = 0 if x is not in the list.
+ *   Stamps are increasing from first to last.
+ *   stamp[-1] = 0 is used as a marker.
+ * - bumped variables are added at the end of the list, new variables
+ *   are added at the start (so they have the lowest priority)
+ * - first = least recently bumped variable
+ * - last = most recently bumped variable
+ * - search = where the next search for a decision variable starts:
+ *   all variables after search in the list are assigned
+ *   (search = null_bvar if all variables are assigned)
+ * - counter = largest stamp used
+ * - low = smallest stamp used
+ * - bumped = variables to move to the end of the list after a conflict
+ */
+typedef struct vmtf_queue_s {
+  uint32_t size;
+  bvar_t *prev;
+  bvar_t *next;
+  uint64_t *stamp;
+  bvar_t first;
+  bvar_t last;
+  bvar_t search;
+  uint64_t counter;
+  uint64_t low;
+  ivector_t bumped;
+} vmtf_queue_t;
+
+/*
+ * Initial value of counter and low
+ */
+#define VMTF_INIT_STAMP (((uint64_t) 1) << 40)
+
+
 
 
 /*****************
@@ -779,6 +891,9 @@ typedef struct dpll_stats_s {
   uint32_t simplify_calls;   // number of calls to simplify_clause_database
   uint32_t reduce_calls;     // number of calls to reduce_learned_clause_set
   uint32_t remove_calls;     // number of calls to remove_irrelevant_learned_clauses
+  uint32_t glue_updates;     // number of times the glue of a learned clause decreased
+  uint32_t arena_compactions; // number of compactions of the clause arena
+  uint32_t chrono_backtracks; // number of conflicts followed by chronological backtracking
 
   uint64_t decisions;        // number of decisions
   uint64_t random_decisions; // number of random decisions
@@ -795,10 +910,21 @@ typedef struct dpll_stats_s {
 
   uint64_t prob_clauses_deleted;     // number of problem clauses deleted
   uint64_t learned_clauses_deleted;  // number of learned clauses deleted
+  uint64_t core_clauses;             // number of learned clauses that entered the core tier
   uint64_t bin_clauses_deleted;      // number of binary clauses deleted
 
   uint64_t literals_before_simpl;
   uint64_t subsumed_literals;
+
+  uint64_t exported_clauses;  // number of clauses written to the clause ring
+  uint64_t imported_clauses;  // number of clauses read from the clause ring
+
+  uint32_t preprocess_calls;      // number of calls to the SAT preprocessor
+  uint32_t failed_literals;       // number of failed literals found by probing
+  uint32_t elim_vars;             // number of variables eliminated
+  uint32_t restored_vars;         // number of eliminated variables restored
+  uint64_t subsumed_clauses;      // number of clauses removed by subsumption
+  uint64_t strengthened_clauses;  // number of clauses strengthened by self-subsumption
 } dpll_stats_t;
 
 
@@ -875,10 +1001,8 @@ typedef enum smt_mode {
  *
  * Propagation structures: for every literal l
  * - bin[l] = literal vector for binary clauses
- * - watch[l] = list of clauses where l is a watched literal
- *   (i.e., clauses where l occurs in position 0 or 1)
- * - optional: end_watch[l] = pointer to the last element in the watch list of l
- *   end_watch is used if USE_END_WATCH is set a compilation time
+ * - watch[l] = watch vector: clauses where l is a watched literal
+ *   (i.e., clauses where l occurs in position 0 or 1) and their blockers
  *
  * For every variable x between 0 and nb_vars - 1
  * - antecedent[x]: antecedent type and value
@@ -971,6 +1095,10 @@ typedef struct smt_core_s {
   bool th_cache_enabled;      // true means caching enabled
   uint32_t th_cache_cl_size;  // max. size of cached clauses
 
+  /* Chronological backtracking parameters */
+  bool chrono_enabled;        // true means enabled
+  uint32_t chrono_threshold;  // min. backjump distance for chronological backtracking
+
   /* Conflict data */
   bool inconsistent;
   bool theory_conflict;
@@ -983,10 +1111,29 @@ typedef struct smt_core_s {
   ivector_t buffer;
   ivector_t buffer2;
 
+  /* Level marks for computing the glue of learned clauses */
+  tag_map_t glue_map;
+
+  /* Moving averages of the glue of learned clauses (for dynamic restarts) */
+  double lbd_fast;   // recent conflicts
+  double lbd_slow;   // long-term average
+
+  /*
+   * Target phase: used for branching in stable mode
+   * - target_phase[x] = 1 if x is true in the target assignment
+   * - target_assigned = size of the target assignment
+   * The target is the largest conflict-free assignment seen since
+   * the last restart.
+   */
+  bool stable;
+  byte_t *target_phase;
+  uint32_t target_assigned;
+
   /* Buffer for expanding theory explanations */
   ivector_t explanation;
 
   /* Clause database */
+  clause_arena_t arena;
   clause_t **problem_clauses;
   clause_t **learned_clauses;
 
@@ -1000,13 +1147,18 @@ typedef struct smt_core_s {
 
   /* Literal-indexed arrays (of size lsize) */
   literal_t **bin;   // array of literal vectors
-  link_t *watch;     // array of watch lists
+  watch_vector_t *watch; // array of watch vectors
 
   /* Stack/propagation queue */
   prop_stack_t stack;
 
-  /* Heap */
+  /*
+   * Decision queue: heap (default) or VMTF queue if use_vmtf is true
+   * - the activities stored in heap are updated only in heap mode
+   */
+  bool use_vmtf;
   var_heap_t heap;
+  vmtf_queue_t vmtf;
 
   /* Lemma queue */
   lemma_queue_t lemmas;
@@ -1030,6 +1182,23 @@ typedef struct smt_core_s {
   /* Tracer object (default to NULL) */
   tracer_t *trace;
 
+  /* Clause sharing (default to NULL) */
+  clause_ring_t *ring;
+  uint64_t ring_cursor;
+  uint32_t ring_id;
+
+  /* SAT preprocessing (disabled by default) */
+  bool sat_preprocess;    // true means preprocess the clauses in start_search
+  byte_t *elim;           // bitvector: elim[x] = 1 if x is eliminated
+  ivector_t elim_stack;   // clauses removed by variable elimination
+  uint32_t nb_elim_vars;  // number of variables currently eliminated
+
+  /* Assumptions (see smt_set_assumptions) */
+  ivector_t assumptions;          // assumption literals for the next search
+  uint32_t assumption_index;      // assumptions[0 ... index-1] are true
+  literal_t bad_assumption;       // assumption found false or null_literal
+  ivector_t failed_assumptions;   // indices of the assumptions that caused unsat
+
 } smt_core_t;
 
 
@@ -1058,6 +1227,52 @@ typedef struct smt_core_s {
 #define INIT_CLAUSE_ACTIVITY_INCREMENT (1.0F)
 
 
+/*
+ * Glue-based tiers for reducing the learned clause database
+ * - clauses with glue <= CORE_GLUE are never deleted
+ * - clauses with glue <= TIER2_GLUE survive the next two
+ *   reductions after they've been used in conflict resolution.
+ * - other clauses survive the next reduction after they've
+ *   been used.
+ * The remaining clauses are ranked by glue then activity,
+ * and the worst half is deleted.
+ */
+#define CORE_GLUE 2
+#define TIER2_GLUE 6
+#define MAX_CLAUSE_GLUE UINT16_MAX
+
+
+/*
+ * Smoothing factors for the moving averages of the glue:
+ * lbd_fast follows the last few dozen conflicts, lbd_slow
+ * the last few thousands.
+ */
+#define LBD_FAST_ALPHA (1.0/32)
+#define LBD_SLOW_ALPHA (1.0/4096)
+
+
+/*
+ * Default threshold for chronological backtracking: if enabled, the
+ * core backtracks chronologically when a backjump would undo more
+ * than CHRONO_THRESHOLD decision levels.
+ */
+#define CHRONO_THRESHOLD 100
+
+
+/*
+ * Limits for the SAT preprocessor (see smt_preprocess)
+ * - PP_PROBE_EFFORT: max number of propagations for failed-literal probing
+ * - PP_EFFORT: max number of literal visits for subsumption and elimination
+ * - a variable is not eliminated if it occurs positively and negatively
+ *   in more than PP_MAX_OCCURRENCES clauses or if that would create a
+ *   resolvent with more than PP_MAX_RESOLVENT_LENGTH literals
+ */
+#define PP_PROBE_EFFORT 2000000
+#define PP_EFFORT 40000000
+#define PP_MAX_OCCURRENCES 10
+#define PP_MAX_RESOLVENT_LENGTH 20
+
+
 /*
  * Parameters for removing irrelevant learned clauses
  * (zchaff-style).
@@ -1188,6 +1403,16 @@ extern void smt_pop(smt_core_t *s);
 extern void set_var_decay_factor(smt_core_t *s, double factor);
 extern void set_clause_decay_factor(smt_core_t *s, float factor);
 
+/*
+ * Select the decision queue
+ * - enable_vmtf: use the VMTF queue. The queue is initialized from
+ *   the current variable activities.
+ * - disable_vmtf: use the activity-based heap (default)
+ * These must not be called when search is under way.
+ */
+extern void enable_vmtf(smt_core_t *s);
+extern void disable_vmtf(smt_core_t *s);
+
 /*
  * Set the randomness parameter used by the default variable
  * selection heuristic: random_factor must be a floating point
@@ -1218,6 +1443,57 @@ static inline void disable_theory_cache(smt_core_t *s) {
   s->th_cache_enabled = false;
 }
 
+/*
+ * Activate chronological backtracking
+ * - after a conflict, if the learned clause would cause a backjump
+ *   of more than threshold levels, the core backtracks by one level
+ *   only and the implied literal is assigned out of order (at its
+ *   correct level).
+ * - this saves re-propagating the levels in between, which can be
+ *   expensive if the theory solver does a lot of propagation.
+ */
+static inline void enable_chrono_backtracking(smt_core_t *s, uint32_t threshold) {
+  s->chrono_enabled = true;
+  s->chrono_threshold = threshold;
+}
+
+/*
+ * Disable chronological backtracking (always backjump)
+ */
+static inline void disable_chrono_backtracking(smt_core_t *s) {
+  s->chrono_enabled = false;
+}
+
+/*
+ * Enable/disable SAT preprocessing (see smt_preprocess)
+ */
+static inline void enable_sat_preprocessing(smt_core_t *s) {
+  s->sat_preprocess = true;
+}
+
+static inline void disable_sat_preprocessing(smt_core_t *s) {
+  s->sat_preprocess = false;
+}
+
+/*
+ * Switch between focused mode (the default) and stable mode:
+ * - in stable mode, select_unassigned_literal uses the target phase
+ *   rather than the cached polarity
+ * - the target assignment is emptied on every switch
+ */
+static inline void smt_set_stable_mode(smt_core_t *s, bool stable) {
+  s->stable = stable;
+  s->target_assigned = 0;
+}
+
+/*
+ * Check whether a dynamic restart is due: the recent conflicts produced
+ * learned clauses with a glue larger than margin times the long-term average
+ */
+static inline bool smt_lbd_restart_due(smt_core_t *s, double margin) {
+  return s->lbd_fast > margin * s->lbd_slow;
+}
+
 
 /*
  * Read the current decision level
@@ -1371,7 +1647,7 @@ static inline uint32_t num_clauses(smt_core_t *s) {
  * For l=pos_lit(x) or neg_lit(x):
  * - value[l] = VAL_UNDEF
  * - bin[l] = NULL
- * - watch[l] = NULL
+ * - watch[l] = empty vector
  */
 extern bvar_t create_boolean_variable(smt_core_t *s);
 
@@ -1406,6 +1682,30 @@ extern bool bvar_has_atom(smt_core_t *s, bvar_t x);
 extern void *bvar_atom(smt_core_t *s, bvar_t x);
 
 
+/*
+ * Check whether x has been removed by variable elimination
+ * (see smt_preprocess). The preprocessor never eliminates
+ * variables that have an atom attached.
+ */
+static inline bool bvar_is_eliminated(smt_core_t *s, bvar_t x) {
+  assert(0 <= x && x < s->nvars);
+  return tst_bit(s->elim, x);
+}
+
+/*
+ * Restore the eliminated variables that occur in a[0 ... n-1]
+ * - the clauses removed when these variables were eliminated are
+ *   added back to s, so that a can be used in new clauses or
+ *   as decisions.
+ * - this may cause backtracking to the base level.
+ * - this function is called internally by the clause-addition
+ *   functions and by attach_atom_to_bvar. It's exported so that
+ *   other modules can make literals usable again before they're
+ *   assigned by decide_literal.
+ */
+extern void smt_restore_literals(smt_core_t *s, uint32_t n, const literal_t *a);
+
+
 /*
  * Faster than bvar_atom, but requires bvar_has_atom(s, x) to be true
  */
@@ -1428,6 +1728,8 @@ static inline antecedent_t get_bvar_antecedent(smt_core_t *s, bvar_t x) {
  * Set the initial activity of variable x.
  * This determines the initial variable ordering in the decision heuristics.
  * By default, all variables have the same initial activity, namely, 0.0
+ * In VMTF mode, the activity is recorded but it's used only if the queue
+ * is rebuilt by enable_vmtf.
  */
 extern void set_bvar_activity(smt_core_t *s, bvar_t x, double a);
 
@@ -1611,11 +1913,71 @@ extern bool base_propagate(smt_core_t *s);
  * - reset the search statistics counters
  * - if clean_interrupt is enabled, save the current state to
  *   enable cleanup after interrupt (this uses push)
+ * - if SAT preprocessing is enabled, call smt_preprocess
  * The current status must be IDLE.
  */
 extern void start_search(smt_core_t *s);
 
 
+/*
+ * SAT preprocessing of the clause database:
+ * - failed-literal probing on the binary implication graph
+ * - backward subsumption and self-subsuming resolution
+ * - bounded variable elimination (SatELite style)
+ *
+ * Variables with an atom attached and assumption variables are frozen:
+ * they're never eliminated.
+ * The clauses removed by elimination are kept in s->elim_stack. They're
+ * used to extend the assignment to the eliminated variables before
+ * the theory's final check (so that the model is complete) and they're
+ * added back if an eliminated variable occurs in a new clause or
+ * atom (see smt_restore_literals).
+ *
+ * This is done only if s is at base level 0 and push/pop is not
+ * supported. The status must be SEARCHING. If the preprocessing
+ * detects unsatisfiability, s->inconsistent is set and the conflict
+ * will be resolved by the next call to smt_process.
+ */
+extern void smt_preprocess(smt_core_t *s);
+
+
+/*
+ * Set the assumptions for the next search:
+ * - a[0 ... n-1] = literals that must be true (n may be zero)
+ * - s->status must be IDLE
+ * - the assumptions are decided first, in order, above the base level.
+ *   They're kept until the next call to smt_set_assumptions, smt_clear,
+ *   or reset_smt_core.
+ * - if an assumption is found false, the search returns UNSAT and
+ *   the subset of assumptions responsible is available via
+ *   smt_failed_assumptions.
+ */
+extern void smt_set_assumptions(smt_core_t *s, uint32_t n, const literal_t *a);
+
+
+/*
+ * Get the next assumption to decide:
+ * - return null_literal if all assumptions are true (the search can
+ *   continue with the default decisions)
+ * - return null_literal and set status to UNSAT if an assumption is false
+ * - otherwise, return the next unassigned assumption
+ * s->status must be SEARCHING.
+ */
+extern literal_t get_next_assumption(smt_core_t *s);
+
+
+/*
+ * Collect the indices of the assumptions that caused unsat:
+ * - if the search returned UNSAT because of the assumptions, then
+ *   the conjunction of the assumptions a[i] for i in v is inconsistent
+ *   with the clauses (each index i refers to the array passed to
+ *   smt_set_assumptions).
+ * - if the search returned UNSAT without the assumptions, v is empty.
+ * - s->status must be UNSAT.
+ */
+extern void smt_failed_assumptions(smt_core_t *s, ivector_t *v);
+
+
 /*
  * Stop the search:
  * - if s->status is SEARCHING, this sets status to INTERRUPTED
@@ -1644,10 +2006,45 @@ extern void decide_literal(smt_core_t *s, literal_t l);
 extern void smt_restart(smt_core_t *s);
 
 
+/*
+ * CLAUSE SHARING
+ */
+
+/*
+ * Attach ring to s for exchanging learned clauses with other cores
+ * - id = identifier of s: it must be distinct from the ids of the
+ *   other cores attached to the same ring.
+ * - the variables of index < ring->nvars must have the same meaning
+ *   in all these cores (e.g., the cores are attached to contexts
+ *   built by asserting the same formulas in the same order).
+ * Once attached, s exports its learned clauses that pass the ring's
+ * filters. Clauses exported by other cores are imported by
+ * smt_import_shared_clauses.
+ */
+extern void smt_attach_clause_ring(smt_core_t *s, clause_ring_t *ring, uint32_t id);
+
+/*
+ * Stop sharing clauses
+ */
+extern void smt_detach_clause_ring(smt_core_t *s);
+
+/*
+ * Import all clauses exported by other cores since the previous call
+ * - this must be called at the base level (e.g., just after smt_restart)
+ *   and s->status must be SEARCHING
+ * - the imported clauses are added as learned clauses
+ * - this may make s inconsistent (if an imported clause is false at
+ *   the base level). The caller must then call smt_process.
+ * - no effect if s has no clause ring
+ */
+extern void smt_import_shared_clauses(smt_core_t *s);
+
+
 /*
  * Variant of restart: attempt to reuse the assignment trail
  * - find the unassigned variable x of highest activity
  * - keep all current decisions that have a higher activity than x
+ * In VMTF mode, this is the same as smt_restart (and so is the next variant).
  */
 extern void smt_partial_restart(smt_core_t *s);
 
@@ -1662,8 +2059,11 @@ extern void smt_partial_restart_var(smt_core_t *s);
 
 
 /*
- * Reduce the clause database by removing half the learned clauses
- * (the ones with lowest activities)
+ * Reduce the clause database by removing learned clauses:
+ * - clauses in the core tier (glue <= CORE_GLUE), clauses used
+ *   recently, and antecedent clauses are kept
+ * - the others are ranked by glue and activity and the worst
+ *   half is removed.
  */
 extern void reduce_clause_database(smt_core_t *s);
 
@@ -1810,13 +2210,24 @@ extern void smt_cleanup(smt_core_t *s);
 
 /*
  * Clear assignment and enable addition of new clauses after a search.
- * - this can be called if s->status is UNKNOWN or SAT
+ * - this can be called if s->status is UNKNOWN or SAT, or if
+ *   s->status is UNSAT because of the assumptions
  * - s->status is reset to STATUS_IDLE and the current boolean
  *   assignment is cleared (i.e., we backtrack to the current base_level)
+ * - the assumptions are removed
  */
 extern void smt_clear(smt_core_t *s);
 
 
+/*
+ * Check whether the search returned UNSAT because of the assumptions
+ * (i.e., the clauses may be satisfiable without the assumptions).
+ */
+static inline bool smt_unsat_by_assumptions(smt_core_t *s) {
+  return s->status == STATUS_UNSAT && s->bad_assumption != null_literal;
+}
+
+
 /*
  * Cleanup after the search returned unsat
  * - s->status must be UNSAT.
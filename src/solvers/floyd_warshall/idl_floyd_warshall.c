@@ -364,9 +364,13 @@ static void init_idl_graph(idl_graph_t *graph) {
   init_idl_matrix(&graph->matrix);
   init_edge_stack(&graph->edges, DEFAULT_IDL_EDGE_STACK_SIZE);
   init_cell_stack(&graph->cstack, DEFAULT_IDL_CELL_STACK_SIZE);
+  init_cell_stack(&graph->changed, DEFAULT_IDL_CELL_STACK_SIZE);
   init_ivector(&graph->buffer, DEFAULT_IDL_BUFFER_SIZE);
 
   push_edge(&graph->edges, null_idl_vertex, null_idl_vertex, 0, true_literal);
+  graph->cmark = graph->edges.top;
+  graph->wdim = 0;
+  graph->watch = NULL;
 }
 
 /*
@@ -374,6 +378,9 @@ static void init_idl_graph(idl_graph_t *graph) {
  */
 static void delete_idl_graph(idl_graph_t *graph) {
   delete_cell_stack(&graph->cstack);
+  delete_cell_stack(&graph->changed);
+  safe_free(graph->watch);
+  graph->watch = NULL;
   delete_edge_stack(&graph->edges);
   delete_idl_matrix(&graph->matrix);
   delete_ivector(&graph->buffer);
@@ -386,9 +393,14 @@ static void reset_idl_graph(idl_graph_t *graph) {
   reset_idl_matrix(&graph->matrix);
   reset_edge_stack(&graph->edges);
   reset_cell_stack(&graph->cstack);
+  reset_cell_stack(&graph->changed);
   ivector_reset(&graph->buffer);
 
   push_edge(&graph->edges, null_idl_vertex, null_idl_vertex, 0, true_literal);
+  graph->cmark = graph->edges.top;
+  safe_free(graph->watch);
+  graph->wdim = 0;
+  graph->watch = NULL;
 }
 
 
@@ -421,9 +433,79 @@ static inline void idl_graph_save_cell(idl_graph_t *graph, idl_cell_t *r) {
 }
 
 
+/*
+ * Attach index k to cell M[x, y]
+ * - if needed, the watch matrix is made larger
+ */
+static void idl_graph_set_watch(idl_graph_t *graph, int32_t x, int32_t y, int32_t k) {
+  uint64_t new_size;
+  int32_t *w;
+  uint32_t i, j, d, n;
+
+  assert(0 <= x && x < MAX_IDL_MATRIX_DIMENSION && 0 <= y && y < MAX_IDL_MATRIX_DIMENSION);
+
+  d = graph->wdim;
+  if (x >= d || y >= d) {
+    n = d + (d >> 1) + 1;
+    if (n <= x) n = x + 1;
+    if (n <= y) n = y + 1;
+    if (n > MAX_IDL_MATRIX_DIMENSION) n = MAX_IDL_MATRIX_DIMENSION;
+
+    new_size = ((uint64_t) n * n) * sizeof(int32_t);
+    if (new_size >= SIZE_MAX) {
+      out_of_memory();
+    }
+    w = (int32_t *) safe_malloc(new_size);
+    for (i=0; i<n; i++) {
+      for (j=0; j<n; j++) {
+        w[i * n + j] = (i < d && j < d) ? graph->watch[i * d + j] : -1;
+      }
+    }
+    safe_free(graph->watch);
+    graph->watch = w;
+    graph->wdim = n;
+    d = n;
+  }
+
+  graph->watch[x * d + y] = k;
+}
+
+
+/*
+ * Index attached to cell M[x, y] or -1 if the cell is not watched
+ */
+static inline int32_t idl_graph_get_watch(idl_graph_t *graph, int32_t x, int32_t y) {
+  return (x < graph->wdim && y < graph->wdim) ? graph->watch[x * graph->wdim + y] : -1;
+}
+
+
+/*
+ * Record that cell r = M[x, y] is about to be modified
+ * - if the cell is watched, it is pushed into the changed stack with index
+ *   (x << 16 | y) unless it's been modified since the last call to
+ *   idl_graph_clear_changes.
+ */
+static inline void idl_graph_record_change(idl_graph_t *graph, int32_t x, int32_t y, idl_cell_t *r) {
+  assert(0 <= x && x <= MAX_IDL_MATRIX_DIMENSION && 0 <= y && y <= MAX_IDL_MATRIX_DIMENSION);
+  if (r->id < graph->cmark && idl_graph_get_watch(graph, x, y) >= 0) {
+    save_cell(&graph->changed, ((uint32_t) x << 16) | (uint32_t) y, r);
+  }
+}
+
+
+/*
+ * Empty the changed stack
+ */
+static void idl_graph_clear_changes(idl_graph_t *graph) {
+  reset_cell_stack(&graph->changed);
+  graph->cmark = graph->edges.top;
+}
+
+
 /*
  * Add new edge to the graph and update the matrix
  * Save any modified cell onto the saved-cell stack
+ * and record it in the changed stack
  * - x = source vertex
  * - y = target vertex
  * - c = cost
@@ -498,6 +580,7 @@ static void idl_graph_add_edge(idl_graph_t *graph, int32_t x, int32_t y, int32_t
             if (r[z].id < k) {
               idl_graph_save_cell(graph, r + z);
             }
+            idl_graph_record_change(graph, w, z, r + z);
             r[z].id = id;
             r[z].dist = d;
           }
@@ -513,6 +596,7 @@ static void idl_graph_add_edge(idl_graph_t *graph, int32_t x, int32_t y, int32_t
  * Backtrack: remove edges and restore the matrix
  * - e = first edge to remove (edges of index i ... top-1) are removed
  * - c = pointer into the saved cell stack
+ * - the changed stack is emptied
  */
 static void idl_graph_remove_edges(idl_graph_t *graph, int32_t e, uint32_t c) {
   saved_cell_t *saved;
@@ -533,6 +617,8 @@ static void idl_graph_remove_edges(idl_graph_t *graph, int32_t e, uint32_t c) {
     m[k] = saved[i].saved;
   }
   graph->cstack.top = c;
+
+  idl_graph_clear_changes(graph);
 }
 
 
@@ -1173,6 +1259,126 @@ int32_t idl_zero_vertex(idl_solver_t *solver) {
 
 
 
+/****************
+ *  ATOM INDEX  *
+ ***************/
+
+/*
+ * Initialize the index: n = initial size of the list array
+ */
+static void init_idl_atom_index(idl_atom_index_t *index, uint32_t n) {
+  uint32_t i;
+
+  if (n >= MAX_IDL_ATOM_INDEX_SIZE) {
+    out_of_memory();
+  }
+
+  index->list = (ivector_t *) safe_malloc(n * sizeof(ivector_t));
+  for (i=0; i<n; i++) {
+    init_ivector(index->list + i, 0);
+  }
+  index->nlists = 0;
+  index->size = n;
+}
+
+
+/*
+ * Make the list array 50% larger
+ */
+static void extend_idl_atom_index(idl_atom_index_t *index) {
+  uint32_t i, n;
+
+  n = index->size + 1;
+  n += n >> 1;
+  if (n >= MAX_IDL_ATOM_INDEX_SIZE) {
+    out_of_memory();
+  }
+
+  index->list = (ivector_t *) safe_realloc(index->list, n * sizeof(ivector_t));
+  for (i=index->size; i<n; i++) {
+    init_ivector(index->list + i, 0);
+  }
+  index->size = n;
+}
+
+
+/*
+ * Empty the index
+ */
+static void reset_idl_atom_index(idl_atom_index_t *index) {
+  uint32_t i;
+
+  for (i=0; i<index->nlists; i++) {
+    ivector_reset(index->list + i);
+  }
+  index->nlists = 0;
+}
+
+
+/*
+ * Delete the index
+ */
+static void delete_idl_atom_index(idl_atom_index_t *index) {
+  uint32_t i;
+
+  for (i=0; i<index->size; i++) {
+    delete_ivector(index->list + i);
+  }
+  safe_free(index->list);
+  index->list = NULL;
+}
+
+
+/*
+ * List of atoms (x - y <= c) or NULL if there's no atom on x and y
+ */
+static ivector_t *idl_atom_list(idl_solver_t *solver, int32_t x, int32_t y) {
+  int32_t k;
+
+  k = idl_graph_get_watch(&solver->graph, x, y);
+  return (k < 0) ? NULL : solver->aindex.list + 2 * k + (x > y);
+}
+
+
+/*
+ * Add atom i to the index
+ * - if the atom is the first one on x and y, allocate two lists
+ *   for the pair and watch cells M[x, y] and M[y, x]
+ * - the atom is inserted before the first atom of larger cost
+ */
+static void idl_index_atom(idl_solver_t *solver, int32_t i) {
+  idl_atom_index_t *index;
+  idl_atom_t *a;
+  ivector_t *v;
+  int32_t k;
+  uint32_t j;
+
+  index = &solver->aindex;
+  a = get_idl_atom(&solver->atoms, i);
+  k = idl_graph_get_watch(&solver->graph, a->source, a->target);
+  if (k < 0) {
+    if (index->nlists + 2 > index->size) {
+      extend_idl_atom_index(index);
+    }
+    assert(index->nlists + 2 <= index->size);
+    k = index->nlists >> 1;
+    index->nlists += 2;
+    idl_graph_set_watch(&solver->graph, a->source, a->target, k);
+    idl_graph_set_watch(&solver->graph, a->target, a->source, k);
+  }
+
+  v = index->list + 2 * k + (a->source > a->target);
+  ivector_push(v, i);
+  j = v->size - 1;
+  while (j > 0 && a->cost < get_idl_atom(&solver->atoms, v->data[j-1])->cost) {
+    v->data[j] = v->data[j-1];
+    j --;
+  }
+  v->data[j] = i;
+}
+
+
+
 /***************************
  *  HASH-CONSING OF ATOMS  *
  **************************/
@@ -1226,7 +1432,7 @@ static idlatom_hobj_t atom_hobj = {
 /*
  * Atom constructor: use hash consing
  * - if the atom is new, create a fresh boolean variable v
- *   and the atom index to v in the core
+ *   and the atom index to v in the core, and add the atom to the index
  */
 static bvar_t bvar_for_atom(idl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
   int32_t id;
@@ -1244,6 +1450,7 @@ static bvar_t bvar_for_atom(idl_solver_t *solver, int32_t x, int32_t y, int32_t
     v = create_boolean_variable(solver->core);
     atm->boolvar = v;
     attach_atom_to_bvar(solver->core, v, index2atom(id));
+    idl_index_atom(solver, id);
   }
   return v;
 }
@@ -1521,19 +1728,154 @@ static void check_atom_for_propagation(idl_solver_t *solver, int32_t i) {
 
 
 /*
- * Scan all unassigned atoms and check propagation
+ * Binary search in list v (sorted by increasing cost)
+ * - return the first position k in v such that atom v[k] has cost >= c
+ *   (or v->size if all atoms in v have cost < c)
+ */
+static uint32_t idl_atom_list_search(idl_atbl_t *table, ivector_t *v, int32_t c) {
+  uint32_t l, h, k;
+
+  l = 0;
+  h = v->size;
+  while (l < h) {
+    k = (l + h) >> 1;
+    if (get_idl_atom(table, v->data[k])->cost < c) {
+      l = k+1;
+    } else {
+      h = k;
+    }
+  }
+  return l;
+}
+
+
+/*
+ * Check the unassigned atoms v[k], v[k+1], ... for propagation
+ * - if all is true, scan v to the end
+ * - otherwise, stop at the first atom whose cost is c or more
+ */
+static void check_atom_list_for_propagation(idl_solver_t *solver, ivector_t *v, uint32_t k, bool all, int32_t c) {
+  idl_atbl_t *tbl;
+  int32_t i;
+
+  tbl = &solver->atoms;
+  while (k < v->size) {
+    i = v->data[k];
+    if (! all && get_idl_atom(tbl, i)->cost >= c) break;
+    if (! idl_atom_is_assigned(tbl, i)) {
+      check_atom_for_propagation(solver, i);
+    }
+    k ++;
+  }
+}
+
+
+/*
+ * Check the atoms that may be implied because the distance from x to y
+ * was reduced: old = content of cell M[x, y] before it was modified.
+ * - let D be the new distance from x to y and D' be the old distance
+ *   (D' = +infinity if there was no path from x to y)
+ * - atoms (x - y <= c) with D <= c < D' are now true
+ * - atoms (y - x <= c) with -D' <= c < -D are now false
+ * The atoms are found by binary search in the sorted lists of the index.
+ */
+static void check_changed_cell_for_propagation(idl_solver_t *solver, int32_t x, int32_t y, idl_cell_t *old) {
+  idl_cell_t *cell;
+  ivector_t *v;
+  uint32_t k;
+  int32_t d;
+
+  cell = idl_cell(&solver->graph.matrix, x, y);
+  if (cell->id < 0 || (old->id >= 0 && old->dist <= cell->dist)) return;
+  d = cell->dist;
+
+  v = idl_atom_list(solver, x, y);
+  if (v != NULL) {
+    k = idl_atom_list_search(&solver->atoms, v, d);
+    check_atom_list_for_propagation(solver, v, k, old->id < 0, old->dist);
+  }
+
+  v = idl_atom_list(solver, y, x);
+  if (v != NULL) {
+    k = 0;
+    if (old->id >= 0) {
+      k = idl_atom_list_search(&solver->atoms, v, - old->dist);
+    }
+    check_atom_list_for_propagation(solver, v, k, false, -d);
+  }
+}
+
+
+#ifndef NDEBUG
+
+/*
+ * For debugging: check that no unassigned atom is implied by the graph
+ */
+static bool all_implied_atoms_assigned(idl_solver_t *solver) {
+  idl_atbl_t *tbl;
+  idl_atom_t *a;
+  idl_cell_t *cell;
+  int32_t i;
+
+  tbl = &solver->atoms;
+  for (i=first_unassigned_atom(tbl); i >= 0; i = next_unassigned_atom(tbl, i)) {
+    a = get_idl_atom(tbl, i);
+    cell = idl_cell(&solver->graph.matrix, a->source, a->target);
+    if (cell->id >= 0 && cell->dist <= a->cost) return false;
+    cell = idl_cell(&solver->graph.matrix, a->target, a->source);
+    if (cell->id >= 0 && cell->dist < - a->cost) return false;
+  }
+
+  return true;
+}
+
+#endif
+
+
+/*
+ * Check propagation for all unassigned atoms that may be implied
  * - must be called after all atoms in the queue have been processed
+ * - new atoms (of index >= prop_atoms) are all checked
+ * - other atoms are checked only if the distance between their vertices
+ *   was reduced: we use the changed cells and the atom index for this
  */
 static void idl_atom_propagation(idl_solver_t *solver) {
   idl_atbl_t *tbl;
-  int32_t i;
+  cell_stack_t *changed;
+  saved_cell_t *c;
+  uint32_t i, n;
 
   assert(solver->astack.top == solver->astack.prop_ptr);
 
   tbl = &solver->atoms;
-  for (i=first_unassigned_atom(tbl); i >= 0; i = next_unassigned_atom(tbl, i)) {
-    check_atom_for_propagation(solver, i);
+  changed = &solver->graph.changed;
+  n = tbl->natoms;
+
+  if (changed->top >= n - solver->astack.top) {
+    /*
+     * more changed cells than unassigned atoms: it's cheaper
+     * to check all the atoms.
+     */
+    for (i=0; i<n; i++) {
+      if (! idl_atom_is_assigned(tbl, i)) {
+        check_atom_for_propagation(solver, i);
+      }
+    }
+  } else {
+    for (i=solver->prop_atoms; i<n; i++) {
+      if (! idl_atom_is_assigned(tbl, i)) {
+        check_atom_for_propagation(solver, i);
+      }
+    }
+    c = changed->data;
+    for (i=0; i<changed->top; i++) {
+      check_changed_cell_for_propagation(solver, c[i].index >> 16, c[i].index & 0xFFFF, &c[i].saved);
+    }
   }
+  solver->prop_atoms = n;
+  idl_graph_clear_changes(&solver->graph);
+
+  assert(all_implied_atoms_assigned(solver));
 
   // update prop_ptr to skip all implied atoms in the next
   // call to idl_propagate.
@@ -1814,6 +2156,8 @@ void idl_reset(idl_solver_t *solver) {
 
   reset_idl_atbl(&solver->atoms);
   reset_idl_astack(&solver->astack);
+  reset_idl_atom_index(&solver->aindex);
+  solver->prop_atoms = 0;
   reset_idl_undo_stack(&solver->stack);
   reset_idl_trail_stack(&solver->trail_stack);
 
@@ -2802,6 +3146,8 @@ void init_idl_solver(idl_solver_t *solver, smt_core_t *core, gate_manager_t *gat
 
   init_idl_atbl(&solver->atoms, DEFAULT_IDL_ATBL_SIZE);
   init_idl_astack(&solver->astack, DEFAULT_IDL_ASTACK_SIZE);
+  init_idl_atom_index(&solver->aindex, DEFAULT_IDL_ATOM_INDEX_SIZE);
+  solver->prop_atoms = 0;
   init_idl_undo_stack(&solver->stack, DEFAULT_IDL_UNDO_STACK_SIZE);
   init_idl_trail_stack(&solver->trail_stack);
 
@@ -2837,6 +3183,7 @@ void delete_idl_solver(idl_solver_t *solver) {
   delete_idl_graph(&solver->graph);
   delete_idl_atbl(&solver->atoms);
   delete_idl_astack(&solver->astack);
+  delete_idl_atom_index(&solver->aindex);
   delete_idl_undo_stack(&solver->stack);
   delete_idl_trail_stack(&solver->trail_stack);
 
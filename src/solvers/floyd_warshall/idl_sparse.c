@@ -0,0 +1,2495 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SPARSE SOLVER FOR INTEGER DIFFERENCE LOGIC
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "solvers/floyd_warshall/idl_sparse.h"
+#include "utils/hash_functions.h"
+#include "utils/index_vectors.h"
+#include "utils/memalloc.h"
+
+
+#define TRACE 0
+
+#if TRACE
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#endif
+
+
+
+/****************
+ *  EDGE STACK  *
+ ***************/
+
+/*
+ * Initialize the stack
+ * - n = initial size
+ */
+static void init_sidl_edge_stack(sidl_edge_stack_t *stack, uint32_t n) {
+  assert(n < MAX_SIDL_EDGE_STACK_SIZE);
+
+  stack->data = (sidl_edge_t *) safe_malloc(n * sizeof(sidl_edge_t));
+  stack->lit = (literal_t *) safe_malloc(n * sizeof(literal_t));
+  stack->size = n;
+  stack->top = 0;
+}
+
+
+/*
+ * Make the stack 50% larger
+ */
+static void extend_sidl_edge_stack(sidl_edge_stack_t *stack) {
+  uint32_t n;
+
+  n = stack->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_EDGE_STACK_SIZE) {
+    out_of_memory();
+  }
+
+  stack->data = (sidl_edge_t *) safe_realloc(stack->data, n * sizeof(sidl_edge_t));
+  stack->lit = (literal_t *) safe_realloc(stack->lit, n * sizeof(literal_t));
+  stack->size = n;
+}
+
+
+/*
+ * Add an edge to the stack and return its index
+ * - x = source, y = target, c = cost, l = literal attached
+ */
+static int32_t push_sidl_edge(sidl_edge_stack_t *stack, int32_t x, int32_t y, int32_t c, literal_t l) {
+  uint32_t i;
+
+  i = stack->top;
+  if (i == stack->size) {
+    extend_sidl_edge_stack(stack);
+  }
+  assert(i < stack->size);
+  stack->data[i].source = x;
+  stack->data[i].target = y;
+  stack->data[i].cost = c;
+  stack->lit[i] = l;
+  stack->top = i+1;
+
+  return i;
+}
+
+
+/*
+ * Delete the stack
+ */
+static inline void delete_sidl_edge_stack(sidl_edge_stack_t *stack) {
+  safe_free(stack->data);
+  safe_free(stack->lit);
+  stack->data = NULL;
+  stack->lit = NULL;
+}
+
+
+
+
+/***********
+ *  GRAPH  *
+ **********/
+
+/*
+ * Ordering for the heap: data is one of the distance arrays
+ */
+static bool sidl_dist_lt(int64_t *dist, int32_t x, int32_t y) {
+  return dist[x] < dist[y];
+}
+
+
+/*
+ * Initialize graph:
+ * - n = initial size of the vertex arrays
+ * - store edge 0 (used as a marker)
+ */
+static void init_sidl_graph(sidl_graph_t *graph, uint32_t n) {
+  assert(n < MAX_SIDL_GRAPH_SIZE);
+
+  graph->size = n;
+  graph->nvertices = 0;
+  graph->out = (int32_t **) safe_malloc(n * sizeof(int32_t *));
+  graph->in = (int32_t **) safe_malloc(n * sizeof(int32_t *));
+  graph->occ = (int32_t **) safe_malloc(n * sizeof(int32_t *));
+  graph->val = (int64_t *) safe_malloc(n * sizeof(int64_t));
+
+  graph->gamma = (int64_t *) safe_malloc(n * sizeof(int64_t));
+  graph->pred = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  graph->fdist = (int64_t *) safe_malloc(n * sizeof(int64_t));
+  graph->fpred = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  graph->bdist = (int64_t *) safe_malloc(n * sizeof(int64_t));
+  graph->bpred = (int32_t *) safe_malloc(n * sizeof(int32_t));
+
+  init_sidl_edge_stack(&graph->edges, DEFAULT_SIDL_EDGE_STACK_SIZE);
+  init_generic_heap(&graph->heap, 0, n, (heap_cmp_fun_t) sidl_dist_lt, NULL);
+  init_ivector(&graph->touched, DEFAULT_SIDL_BUFFER_SIZE);
+  init_ivector(&graph->fvisited, DEFAULT_SIDL_BUFFER_SIZE);
+  init_ivector(&graph->bvisited, DEFAULT_SIDL_BUFFER_SIZE);
+
+  push_sidl_edge(&graph->edges, null_sidl_vertex, null_sidl_vertex, 0, true_literal);
+}
+
+
+/*
+ * Make the vertex arrays 50% larger
+ */
+static void extend_sidl_graph(sidl_graph_t *graph) {
+  uint32_t n;
+
+  n = graph->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_GRAPH_SIZE) {
+    out_of_memory();
+  }
+
+  graph->size = n;
+  graph->out = (int32_t **) safe_realloc(graph->out, n * sizeof(int32_t *));
+  graph->in = (int32_t **) safe_realloc(graph->in, n * sizeof(int32_t *));
+  graph->occ = (int32_t **) safe_realloc(graph->occ, n * sizeof(int32_t *));
+  graph->val = (int64_t *) safe_realloc(graph->val, n * sizeof(int64_t));
+
+  graph->gamma = (int64_t *) safe_realloc(graph->gamma, n * sizeof(int64_t));
+  graph->pred = (int32_t *) safe_realloc(graph->pred, n * sizeof(int32_t));
+  graph->fdist = (int64_t *) safe_realloc(graph->fdist, n * sizeof(int64_t));
+  graph->fpred = (int32_t *) safe_realloc(graph->fpred, n * sizeof(int32_t));
+  graph->bdist = (int64_t *) safe_realloc(graph->bdist, n * sizeof(int64_t));
+  graph->bpred = (int32_t *) safe_realloc(graph->bpred, n * sizeof(int32_t));
+}
+
+
+/*
+ * Add a new vertex and return its index
+ */
+static int32_t sidl_graph_add_vertex(sidl_graph_t *graph) {
+  uint32_t i;
+
+  i = graph->nvertices;
+  if (i == graph->size) {
+    extend_sidl_graph(graph);
+  }
+  assert(i < graph->size);
+  graph->out[i] = NULL;
+  graph->in[i] = NULL;
+  graph->occ[i] = NULL;
+  graph->val[i] = 0;
+  graph->gamma[i] = 0;
+  graph->pred[i] = null_sidl_edge;
+  graph->fpred[i] = null_sidl_edge;
+  graph->bpred[i] = null_sidl_edge;
+  graph->nvertices = i+1;
+
+  return i;
+}
+
+
+/*
+ * Remove all vertices of index >= n
+ * - the vertices must not have any edges
+ */
+static void sidl_graph_remove_vertices(sidl_graph_t *graph, uint32_t n) {
+  uint32_t i;
+
+  assert(n <= graph->nvertices);
+
+  for (i=n; i<graph->nvertices; i++) {
+    assert(iv_is_empty(graph->out[i]) && iv_is_empty(graph->in[i]));
+    delete_index_vector(graph->out[i]);
+    delete_index_vector(graph->in[i]);
+    delete_index_vector(graph->occ[i]);
+  }
+  graph->nvertices = n;
+}
+
+
+/*
+ * Delete all
+ */
+static void delete_sidl_graph(sidl_graph_t *graph) {
+  uint32_t i;
+
+  for (i=0; i<graph->nvertices; i++) {
+    delete_index_vector(graph->out[i]);
+    delete_index_vector(graph->in[i]);
+    delete_index_vector(graph->occ[i]);
+  }
+
+  safe_free(graph->out);
+  safe_free(graph->in);
+  safe_free(graph->occ);
+  safe_free(graph->val);
+  safe_free(graph->gamma);
+  safe_free(graph->pred);
+  safe_free(graph->fdist);
+  safe_free(graph->fpred);
+  safe_free(graph->bdist);
+  safe_free(graph->bpred);
+  graph->out = NULL;
+  graph->in = NULL;
+  graph->occ = NULL;
+  graph->val = NULL;
+  graph->gamma = NULL;
+  graph->pred = NULL;
+  graph->fdist = NULL;
+  graph->fpred = NULL;
+  graph->bdist = NULL;
+  graph->bpred = NULL;
+
+  delete_sidl_edge_stack(&graph->edges);
+  delete_generic_heap(&graph->heap);
+  delete_ivector(&graph->touched);
+  delete_ivector(&graph->fvisited);
+  delete_ivector(&graph->bvisited);
+}
+
+
+/*
+ * Remove all edges of index >= n
+ */
+static void sidl_graph_remove_edges(sidl_graph_t *graph, uint32_t n) {
+  sidl_edge_t *e;
+  uint32_t i;
+
+  assert(n > 0);
+
+  i = graph->edges.top;
+  while (i > n) {
+    i --;
+    e = graph->edges.data + i;
+    assert(index_vector_last(graph->out[e->source]) == i);
+    assert(index_vector_last(graph->in[e->target]) == i);
+    index_vector_pop(graph->out[e->source]);
+    index_vector_pop(graph->in[e->target]);
+  }
+  graph->edges.top = n;
+}
+
+
+/*
+ * Reset: empty graph
+ */
+static void reset_sidl_graph(sidl_graph_t *graph) {
+  sidl_graph_remove_edges(graph, 1);
+  sidl_graph_remove_vertices(graph, 0);
+  reset_generic_heap(&graph->heap);
+  ivector_reset(&graph->touched);
+  ivector_reset(&graph->fvisited);
+  ivector_reset(&graph->bvisited);
+}
+
+
+/*
+ * Add edge x --> y with cost c and literal l
+ * - return the edge index
+ */
+static int32_t sidl_graph_add_edge(sidl_graph_t *graph, int32_t x, int32_t y, int32_t c, literal_t l) {
+  int32_t i;
+
+  assert(0 <= x && x < graph->nvertices && 0 <= y && y < graph->nvertices && x != y);
+
+  i = push_sidl_edge(&graph->edges, x, y, c, l);
+  add_index_to_vector(graph->out + x, i);
+  add_index_to_vector(graph->in + y, i);
+
+  return i;
+}
+
+
+/*
+ * Remove the last edge
+ */
+static inline void sidl_graph_remove_last_edge(sidl_graph_t *graph) {
+  sidl_graph_remove_edges(graph, graph->edges.top - 1);
+}
+
+
+/*
+ * Reduced cost of edge i: cost - val[source] + val[target]
+ * - this is non-negative if the assignment is feasible
+ */
+static inline int64_t sidl_reduced_cost(sidl_graph_t *graph, int32_t i) {
+  sidl_edge_t *e;
+
+  e = graph->edges.data + i;
+  return (int64_t) e->cost - graph->val[e->source] + graph->val[e->target];
+}
+
+
+/*
+ * REPAIR OF THE ASSIGNMENT
+ */
+
+/*
+ * When edge i from x to y with cost c is added and val[x] - val[y] > c,
+ * we decrease val[x], which may require decreasing the values of the
+ * predecessors of x (Cotton & Maler's algorithm). We store in gamma[z]
+ * the amount by which vertex z must decrease: gamma[z] < 0 for all
+ * vertices that must be updated, and pred[z] is the edge from z that
+ * caused the update. The vertices are processed in increasing order
+ * of gamma (largest change first). If y must decrease, edge i is on a
+ * negative circuit.
+ *
+ * Decreasing the sources (rather than increasing the targets) keeps
+ * the assignment close to the earliest-start schedule, which makes
+ * the polarity heuristic work much better on scheduling problems.
+ */
+
+/*
+ * Literals of the negative circuit through edge i
+ * - the circuit starts at the target of i and follows the pred edges
+ * - the literals are added to v
+ */
+static void sidl_graph_explain_circuit(sidl_graph_t *graph, int32_t i, ivector_t *v) {
+  int32_t y, z, f;
+  literal_t l;
+
+  y = graph->edges.data[i].target;
+  z = y;
+  do {
+    f = graph->pred[z];
+    assert(f > 0);
+    l = graph->edges.lit[f];
+    if (l != true_literal) {
+      ivector_push(v, l);
+    }
+    z = graph->edges.data[f].target;
+  } while (z != y);
+}
+
+
+/*
+ * Update the assignment after edge i was added.
+ * - the assignment must be feasible for all edges except i
+ * - return true if the assignment can be updated to satisfy edge i
+ * - return false if edge i creates a negative circuit. The
+ *   literals of the circuit are then added to v.
+ *
+ * The assignment is updated only if there's no conflict.
+ */
+static bool sidl_graph_repair(sidl_graph_t *graph, int32_t i, ivector_t *v) {
+  sidl_edge_t *edges;
+  generic_heap_t *heap;
+  int64_t *gamma, *val;
+  int32_t *pred, *in;
+  int64_t g, nz;
+  int32_t x, y, z, w, f;
+  uint32_t k, n;
+  bool ok;
+
+  edges = graph->edges.data;
+  val = graph->val;
+  x = edges[i].source;
+  y = edges[i].target;
+
+  g = val[y] + edges[i].cost - val[x];
+  if (g >= 0) return true;
+
+  heap = &graph->heap;
+  gamma = graph->gamma;
+  pred = graph->pred;
+
+  assert(graph->touched.size == 0 && generic_heap_is_empty(heap));
+  heap->data = gamma;
+
+  gamma[x] = g;
+  pred[x] = i;
+  ivector_push(&graph->touched, x);
+  generic_heap_add(heap, x);
+
+  ok = true;
+  while (! generic_heap_is_empty(heap)) {
+    z = generic_heap_get_min(heap);
+    nz = val[z] + gamma[z]; // new value for z
+
+    in = graph->in[z];
+    n = iv_len(in);
+    for (k=0; k<n; k++) {
+      f = in[k];
+      w = edges[f].source;
+      // edge w ---> z requires new val[w] <= nz + cost
+      g = nz + edges[f].cost - val[w];
+      if (g < gamma[w]) {
+        pred[w] = f;
+        if (w == y) {
+          ok = false;
+          goto done;
+        }
+        if (gamma[w] == 0) {
+          ivector_push(&graph->touched, w);
+        }
+        gamma[w] = g;
+        if (generic_heap_member(heap, w)) {
+          generic_heap_move_up(heap, w);
+        } else {
+          generic_heap_add(heap, w);
+        }
+      }
+    }
+  }
+
+ done:
+  if (! ok) {
+    sidl_graph_explain_circuit(graph, i, v);
+  }
+
+  n = graph->touched.size;
+  for (k=0; k<n; k++) {
+    z = graph->touched.data[k];
+    if (ok) {
+      val[z] += gamma[z];
+    }
+    gamma[z] = 0;
+  }
+  ivector_reset(&graph->touched);
+  reset_generic_heap(heap);
+
+  return ok;
+}
+
+
+
+/*
+ * BOUNDED SEARCH FOR THEORY PROPAGATION
+ */
+
+/*
+ * Remove all vertices from the heap and clear their pred field
+ * - these are vertices that were reached but not visited by a search
+ */
+static void sidl_graph_clear_heap(sidl_graph_t *graph, int32_t *pred) {
+  generic_heap_t *heap;
+  uint32_t i, n;
+
+  heap = &graph->heap;
+  n = heap->nelems;
+  for (i=1; i<=n; i++) {
+    pred[heap->heap[i]] = null_sidl_edge;
+  }
+  reset_generic_heap(heap);
+}
+
+
+/*
+ * Forward search from vertex x: Dijkstra's algorithm on reduced costs
+ * - the search stops after scanning bound edges
+ * - for every visited vertex y, fdist[y] = reduced distance from x to y
+ *   and fpred[y] = last edge on the shortest path from x to y
+ *   (fpred[x] = 0)
+ * - the visited vertices are stored in graph->fvisited
+ * - all other vertices have fpred = null_sidl_edge
+ * - return true if the search was stopped by the bound
+ *
+ * The distance to a vertex is exact once it's visited, so stopping
+ * the search anywhere is sound. Bounding the number of edges rather
+ * than the number of vertices keeps the cost of a search small even
+ * when it visits a vertex of high degree.
+ */
+static bool sidl_graph_forward_search(sidl_graph_t *graph, int32_t x, uint32_t bound) {
+  generic_heap_t *heap;
+  ivector_t *visited;
+  sidl_edge_t *edges;
+  int64_t *dist;
+  int32_t *pred, *out;
+  int64_t d;
+  int32_t y, z, f;
+  uint32_t i, n;
+
+  heap = &graph->heap;
+  visited = &graph->fvisited;
+  edges = graph->edges.data;
+  dist = graph->fdist;
+  pred = graph->fpred;
+
+  assert(visited->size == 0 && generic_heap_is_empty(heap));
+  heap->data = dist;
+
+  dist[x] = 0;
+  pred[x] = 0;
+  generic_heap_add(heap, x);
+
+  while (! generic_heap_is_empty(heap)) {
+    y = generic_heap_get_min(heap);
+    ivector_push(visited, y);
+
+    out = graph->out[y];
+    n = iv_len(out);
+    for (i=0; i<n; i++) {
+      if (bound == 0) goto bounded;
+      bound --;
+      f = out[i];
+      z = edges[f].target;
+      d = dist[y] + sidl_reduced_cost(graph, f);
+      if (pred[z] == null_sidl_edge) {
+        dist[z] = d;
+        pred[z] = f;
+        generic_heap_add(heap, z);
+      } else if (d < dist[z] && generic_heap_member(heap, z)) {
+        dist[z] = d;
+        pred[z] = f;
+        generic_heap_move_up(heap, z);
+      }
+    }
+  }
+
+  return false;
+
+ bounded:
+  sidl_graph_clear_heap(graph, pred);
+  return true;
+}
+
+
+/*
+ * Backward search to vertex x: same thing on the reverse graph
+ * - for every visited vertex y, bdist[y] = reduced distance from y to x
+ *   and bpred[y] = first edge on the shortest path from y to x
+ *   (bpred[x] = 0)
+ * - the visited vertices are stored in graph->bvisited
+ */
+static bool sidl_graph_backward_search(sidl_graph_t *graph, int32_t x, uint32_t bound) {
+  generic_heap_t *heap;
+  ivector_t *visited;
+  sidl_edge_t *edges;
+  int64_t *dist;
+  int32_t *pred, *in;
+  int64_t d;
+  int32_t y, z, f;
+  uint32_t i, n;
+
+  heap = &graph->heap;
+  visited = &graph->bvisited;
+  edges = graph->edges.data;
+  dist = graph->bdist;
+  pred = graph->bpred;
+
+  assert(visited->size == 0 && generic_heap_is_empty(heap));
+  heap->data = dist;
+
+  dist[x] = 0;
+  pred[x] = 0;
+  generic_heap_add(heap, x);
+
+  while (! generic_heap_is_empty(heap)) {
+    y = generic_heap_get_min(heap);
+    ivector_push(visited, y);
+
+    in = graph->in[y];
+    n = iv_len(in);
+    for (i=0; i<n; i++) {
+      if (bound == 0) goto bounded;
+      bound --;
+      f = in[i];
+      z = edges[f].source;
+      d = dist[y] + sidl_reduced_cost(graph, f);
+      if (pred[z] == null_sidl_edge) {
+        dist[z] = d;
+        pred[z] = f;
+        generic_heap_add(heap, z);
+      } else if (d < dist[z] && generic_heap_member(heap, z)) {
+        dist[z] = d;
+        pred[z] = f;
+        generic_heap_move_up(heap, z);
+      }
+    }
+  }
+
+  return false;
+
+ bounded:
+  sidl_graph_clear_heap(graph, pred);
+  return true;
+}
+
+
+/*
+ * Clear the search results
+ */
+static void sidl_graph_clear_searches(sidl_graph_t *graph) {
+  ivector_t *v;
+  uint32_t i, n;
+
+  v = &graph->fvisited;
+  n = v->size;
+  for (i=0; i<n; i++) {
+    graph->fpred[v->data[i]] = null_sidl_edge;
+  }
+  ivector_reset(v);
+
+  v = &graph->bvisited;
+  n = v->size;
+  for (i=0; i<n; i++) {
+    graph->bpred[v->data[i]] = null_sidl_edge;
+  }
+  ivector_reset(v);
+}
+
+
+/*
+ * Check whether y was visited by the forward/backward search
+ */
+static inline bool sidl_graph_fvisited(sidl_graph_t *graph, int32_t y) {
+  return graph->fpred[y] != null_sidl_edge;
+}
+
+static inline bool sidl_graph_bvisited(sidl_graph_t *graph, int32_t y) {
+  return graph->bpred[y] != null_sidl_edge;
+}
+
+
+/*
+ * Length of the path x ---> u -> v ---> y where u -> v is edge i, and
+ * x ---> u and v ---> y are the paths found by the two searches.
+ * - x must be visited by the backward search to u
+ * - y must be visited by the forward search from v
+ */
+static int64_t sidl_graph_path_length(sidl_graph_t *graph, int32_t x, int32_t i, int32_t y) {
+  int64_t *val;
+  int32_t u, v;
+
+  assert(sidl_graph_bvisited(graph, x) && sidl_graph_fvisited(graph, y));
+
+  val = graph->val;
+  u = graph->edges.data[i].source;
+  v = graph->edges.data[i].target;
+
+  return graph->bdist[x] + val[x] - val[u] + graph->edges.data[i].cost + graph->fdist[y] + val[v] - val[y];
+}
+
+
+/*
+ * Collect the literals on the path x ---> u -> v ---> y into vector v
+ */
+static void sidl_graph_explain_path(sidl_graph_t *graph, int32_t x, int32_t i, int32_t y, ivector_t *v) {
+  sidl_edge_t *edges;
+  literal_t *lit;
+  int32_t u, f;
+
+  edges = graph->edges.data;
+  lit = graph->edges.lit;
+
+  // path x ---> u
+  u = edges[i].source;
+  while (x != u) {
+    f = graph->bpred[x];
+    assert(f > 0 && edges[f].source == x);
+    if (lit[f] != true_literal) {
+      ivector_push(v, lit[f]);
+    }
+    x = edges[f].target;
+  }
+
+  if (lit[i] != true_literal) {
+    ivector_push(v, lit[i]);
+  }
+
+  // path v ---> y (in reverse)
+  u = edges[i].target;
+  while (y != u) {
+    f = graph->fpred[y];
+    assert(f > 0 && edges[f].target == y);
+    if (lit[f] != true_literal) {
+      ivector_push(v, lit[f]);
+    }
+    y = edges[f].source;
+  }
+}
+
+
+
+
+/****************
+ *  ATOM TABLE  *
+ ***************/
+
+/*
+ * Initialize the table
+ * - n = initial size
+ */
+static void init_sidl_atbl(sidl_atbl_t *table, uint32_t n) {
+  assert(n < MAX_SIDL_ATBL_SIZE);
+
+  table->size = n;
+  table->natoms = 0;
+  table->nassigned = 0;
+  table->atoms = (sidl_atom_t *) safe_malloc(n * sizeof(sidl_atom_t));
+  table->mark = allocate_bitvector(n);
+}
+
+
+/*
+ * Make the table 50% larger
+ */
+static void extend_sidl_atbl(sidl_atbl_t *table) {
+  uint32_t n;
+
+  n = table->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_ATBL_SIZE) {
+    out_of_memory();
+  }
+
+  table->size = n;
+  table->atoms = (sidl_atom_t *) safe_realloc(table->atoms, n * sizeof(sidl_atom_t));
+  table->mark = extend_bitvector(table->mark, n);
+}
+
+
+/*
+ * Create a new atom: (x - y <= c)
+ * returned value = the atom id
+ * boolvar is initialized to null_bvar and the mark is cleared
+ */
+static int32_t new_sidl_atom(sidl_atbl_t *table, int32_t x, int32_t y, int32_t c) {
+  uint32_t i;
+
+  i = table->natoms;
+  if (i == table->size) {
+    extend_sidl_atbl(table);
+  }
+  assert(i < table->size);
+  table->atoms[i].source = x;
+  table->atoms[i].target = y;
+  table->atoms[i].cost = c;
+  table->atoms[i].boolvar = null_bvar;
+  clr_bit(table->mark, i);
+  table->natoms ++;
+
+  return i;
+}
+
+
+/*
+ * Get atom descriptor for atom i
+ */
+static inline sidl_atom_t *get_sidl_atom(sidl_atbl_t *table, int32_t i) {
+  assert(0 <= i && i < table->natoms);
+  return table->atoms + i;
+}
+
+
+/*
+ * Check whether atom i is assigned (i.e., marked)
+ */
+static inline bool sidl_atom_is_assigned(sidl_atbl_t *table, int32_t i) {
+  assert(0 <= i && i < table->natoms);
+  return tst_bit(table->mark, i);
+}
+
+
+/*
+ * Mark atom i as assigned/unassigned
+ */
+static inline void mark_sidl_atom_assigned(sidl_atbl_t *table, int32_t i) {
+  assert(0 <= i && i < table->natoms && ! tst_bit(table->mark, i));
+  set_bit(table->mark, i);
+  table->nassigned ++;
+}
+
+static inline void mark_sidl_atom_unassigned(sidl_atbl_t *table, int32_t i) {
+  assert(0 <= i && i < table->natoms && tst_bit(table->mark, i));
+  clr_bit(table->mark, i);
+  table->nassigned --;
+}
+
+
+/*
+ * Check whether all atoms are assigned
+ */
+static inline bool sidl_all_atoms_assigned(sidl_atbl_t *table) {
+  return table->nassigned == table->natoms;
+}
+
+
+/*
+ * Empty the table
+ */
+static inline void reset_sidl_atbl(sidl_atbl_t *table) {
+  table->natoms = 0;
+  table->nassigned = 0;
+}
+
+
+/*
+ * Delete the table
+ */
+static inline void delete_sidl_atbl(sidl_atbl_t *table) {
+  safe_free(table->atoms);
+  delete_bitvector(table->mark);
+  table->atoms = NULL;
+  table->mark = NULL;
+}
+
+
+
+
+/**********************************
+ *  ATOM STACK/PROPAGATION QUEUE  *
+ *********************************/
+
+/*
+ * Initialize: n = initial size
+ */
+static void init_sidl_astack(sidl_astack_t *stack, uint32_t n) {
+  assert(n < MAX_SIDL_ASTACK_SIZE);
+  stack->size = n;
+  stack->top = 0;
+  stack->prop_ptr = 0;
+  stack->data = (int32_t *) safe_malloc(n * sizeof(int32_t));
+}
+
+/*
+ * Make the stack 50% larger
+ */
+static void extend_sidl_astack(sidl_astack_t *stack) {
+  uint32_t n;
+
+  n = stack->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_ASTACK_SIZE) {
+    out_of_memory();
+  }
+
+  stack->data = (int32_t *) safe_realloc(stack->data, n * sizeof(int32_t));
+  stack->size = n;
+}
+
+
+/*
+ * Atom id + sign packed into a 32 bit integer
+ * - the sign is 0 for positive, 1 for negative
+ */
+static inline int32_t mk_sidl_index(int32_t id, uint32_t sign) {
+  assert(sign == 0 || sign == 1);
+  return (id<<1) | sign;
+}
+
+static inline int32_t sidl_atom_of_index(int32_t idx) {
+  return idx>>1;
+}
+
+static inline bool is_pos_sidl_index(int32_t idx) {
+  return (idx & 1) == 0;
+}
+
+
+/*
+ * Push atom index k on top of the stack
+ */
+static void push_sidl_atom_index(sidl_astack_t *stack, int32_t k) {
+  uint32_t i;
+
+  i = stack->top;
+  if (i == stack->size) {
+    extend_sidl_astack(stack);
+  }
+  assert(i < stack->size);
+  stack->data[i] = k;
+  stack->top = i+1;
+}
+
+
+/*
+ * Empty the stack
+ */
+static inline void reset_sidl_astack(sidl_astack_t *stack) {
+  stack->top = 0;
+  stack->prop_ptr = 0;
+}
+
+
+/*
+ * Delete the stack
+ */
+static inline void delete_sidl_astack(sidl_astack_t *stack) {
+  safe_free(stack->data);
+  stack->data = NULL;
+}
+
+
+
+
+/****************
+ *  UNDO STACK  *
+ ***************/
+
+/*
+ * Initialize: n = size
+ */
+static void init_sidl_undo_stack(sidl_undo_stack_t *stack, uint32_t n) {
+  assert(n < MAX_SIDL_UNDO_STACK_SIZE);
+
+  stack->size = n;
+  stack->top = 0;
+  stack->data = (sidl_undo_record_t *) safe_malloc(n * sizeof(sidl_undo_record_t));
+}
+
+/*
+ * Extend the stack: make it 50% larger
+ */
+static void extend_sidl_undo_stack(sidl_undo_stack_t *stack) {
+  uint32_t n;
+
+  n = stack->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_UNDO_STACK_SIZE) {
+    out_of_memory();
+  }
+  stack->size = n;
+  stack->data = (sidl_undo_record_t *) safe_realloc(stack->data, n * sizeof(sidl_undo_record_t));
+}
+
+
+/*
+ * Push record (e, a) on top of the stack
+ * - e = number of edges
+ * - a = top of the atom stack
+ */
+static void push_sidl_undo_record(sidl_undo_stack_t *stack, uint32_t e, uint32_t a) {
+  uint32_t i;
+
+  i = stack->top;
+  if (i == stack->size) {
+    extend_sidl_undo_stack(stack);
+  }
+  assert(i < stack->size);
+  stack->data[i].nedges = e;
+  stack->data[i].natoms = a;
+  stack->top = i+1;
+}
+
+
+/*
+ * Empty the stack
+ */
+static inline void reset_sidl_undo_stack(sidl_undo_stack_t *stack) {
+  stack->top = 0;
+}
+
+/*
+ * Delete the stack
+ */
+static inline void delete_sidl_undo_stack(sidl_undo_stack_t *stack) {
+  safe_free(stack->data);
+  stack->data = NULL;
+}
+
+
+
+/********************
+ *  PUSH/POP STACK  *
+ *******************/
+
+/*
+ * Initialize: size = 0;
+ */
+static void init_sidl_trail_stack(sidl_trail_stack_t *stack) {
+  stack->size = 0;
+  stack->top = 0;
+  stack->data = NULL;
+}
+
+
+/*
+ * Save data for the current base_level:
+ * - nv = number of vertices
+ * - na = number of atoms
+ */
+static void sidl_trail_stack_save(sidl_trail_stack_t *stack, uint32_t nv, uint32_t na) {
+  uint32_t i, n;
+
+  i = stack->top;
+  n = stack->size;
+  if (i == n) {
+    if (n == 0) {
+      n = DEFAULT_SIDL_TRAIL_SIZE;
+    } else {
+      n += n>>1; // 50% larger
+      if (n >= MAX_SIDL_TRAIL_SIZE) {
+        out_of_memory();
+      }
+    }
+    stack->data = (sidl_trail_t *) safe_realloc(stack->data, n * sizeof(sidl_trail_t));
+    stack->size = n;
+  }
+  assert(i < n);
+  stack->data[i].nvertices = nv;
+  stack->data[i].natoms = na;
+  stack->top = i+1;
+}
+
+
+/*
+ * Get the top record
+ */
+static inline sidl_trail_t *sidl_trail_stack_top(sidl_trail_stack_t *stack) {
+  assert(stack->top > 0);
+  return stack->data + (stack->top - 1);
+}
+
+
+/*
+ * Remove the top record
+ */
+static inline void sidl_trail_stack_pop(sidl_trail_stack_t *stack) {
+  assert(stack->top > 0);
+  stack->top --;
+}
+
+
+/*
+ * Empty the stack
+ */
+static inline void reset_sidl_trail_stack(sidl_trail_stack_t *stack) {
+  stack->top = 0;
+}
+
+
+/*
+ * Delete the stack
+ */
+static inline void delete_sidl_trail_stack(sidl_trail_stack_t *stack) {
+  safe_free(stack->data);
+  stack->data = NULL;
+}
+
+
+
+
+/*********************
+ *  VERTEX CREATION  *
+ ********************/
+
+/*
+ * Create a new vertex and return its index
+ */
+int32_t sidl_new_vertex(sidl_solver_t *solver) {
+  if (solver->graph.nvertices >= MAX_SIDL_VERTICES) {
+    return null_sidl_vertex;
+  }
+  return sidl_graph_add_vertex(&solver->graph);
+}
+
+
+/*
+ * Get the zero vertex (create a new vertex if needed)
+ */
+int32_t sidl_zero_vertex(sidl_solver_t *solver) {
+  int32_t z;
+
+  z = solver->zero_vertex;
+  if (z == null_sidl_vertex) {
+    z = sidl_new_vertex(solver);
+    solver->zero_vertex = z;
+  }
+  return z;
+}
+
+
+
+
+/***************************
+ *  HASH-CONSING OF ATOMS  *
+ **************************/
+
+/*
+ * Hash code for atom (x - y <= d)
+ */
+static inline uint32_t hash_sidl_atom(int32_t x, int32_t y, int32_t d) {
+  return jenkins_hash_triple(x, y, d, 0x3d4a1b6c);
+}
+
+
+/*
+ * Hash consing object for interfacing with int_hash_table
+ */
+typedef struct sidlatom_hobj_s {
+  int_hobj_t m;      // methods
+  sidl_atbl_t *atbl; // atom table
+  int32_t source, target, cost; // atom components
+} sidlatom_hobj_t;
+
+
+/*
+ * Functions for int_hash_table
+ */
+static uint32_t hash_atom(sidlatom_hobj_t *p) {
+  return hash_sidl_atom(p->source, p->target, p->cost);
+}
+
+static bool equal_atom(sidlatom_hobj_t *p, int32_t id) {
+  sidl_atom_t *atm;
+
+  atm = get_sidl_atom(p->atbl, id);
+  return atm->source == p->source && atm->target == p->target && atm->cost == p->cost;
+}
+
+static int32_t build_atom(sidlatom_hobj_t *p) {
+  return new_sidl_atom(p->atbl, p->source, p->target, p->cost);
+}
+
+/*
+ * Hobject
+ */
+static sidlatom_hobj_t atom_hobj = {
+  { (hobj_hash_t) hash_atom, (hobj_eq_t) equal_atom, (hobj_build_t) build_atom },
+  NULL,
+  0, 0, 0,
+};
+
+
+/*
+ * Atom constructor: use hash consing
+ * - if the atom is new, create a fresh boolean variable v,
+ *   attach the atom index to v in the core, and add the
+ *   atom to the occurrence vectors of x and y.
+ */
+static bvar_t bvar_for_atom(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
+  int32_t id;
+  sidl_atom_t *atm;
+  bvar_t v;
+
+  atom_hobj.atbl = &solver->atoms;
+  atom_hobj.source = x;
+  atom_hobj.target = y;
+  atom_hobj.cost = d;
+  id = int_htbl_get_obj(&solver->htbl, (int_hobj_t *) &atom_hobj);
+  atm = get_sidl_atom(&solver->atoms, id);
+  v = atm->boolvar;
+  if (v == null_bvar) {
+    v = create_boolean_variable(solver->core);
+    atm->boolvar = v;
+    attach_atom_to_bvar(solver->core, v, sidl_index2atom(id));
+    add_index_to_vector(solver->graph.occ + x, id);
+    add_index_to_vector(solver->graph.occ + y, id);
+  }
+  return v;
+}
+
+
+/*
+ * Get literal for atom (x - y <= d)
+ */
+literal_t sidl_make_atom(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
+  assert(0 <= x && x < solver->graph.nvertices && 0 <= y && y < solver->graph.nvertices);
+
+  if (x == y) {
+    return (d >= 0) ? true_literal : false_literal;
+  }
+
+  return pos_lit(bvar_for_atom(solver, x, y, d));
+}
+
+
+/*
+ * Remove all atoms of index >= n
+ * - remove them from the hash table and the occurrence vectors
+ */
+static void sidl_remove_atoms(sidl_solver_t *solver, uint32_t n) {
+  sidl_atom_t *a;
+  uint32_t i, h;
+
+  assert(n <= solver->atoms.natoms);
+
+  i = solver->atoms.natoms;
+  while (i > n) {
+    i --;
+    a = get_sidl_atom(&solver->atoms, i);
+    assert(! sidl_atom_is_assigned(&solver->atoms, i));
+    h = hash_sidl_atom(a->source, a->target, a->cost);
+    int_htbl_erase_record(&solver->htbl, h, i);
+    assert(index_vector_last(solver->graph.occ[a->source]) == i);
+    assert(index_vector_last(solver->graph.occ[a->target]) == i);
+    index_vector_pop(solver->graph.occ[a->source]);
+    index_vector_pop(solver->graph.occ[a->target]);
+  }
+  solver->atoms.natoms = n;
+}
+
+
+
+
+/****************
+ *  ASSERTIONS  *
+ ***************/
+
+/*
+ * Assert (x - y <= d) as an axiom: attach true_literal to the edge
+ */
+void sidl_add_axiom_edge(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
+  int32_t i;
+
+  assert(0 <= x && x < solver->graph.nvertices && 0 <= y && y < solver->graph.nvertices);
+  assert(solver->decision_level == solver->base_level);
+
+  // do nothing if the solver is already in an inconsistent state
+  if (solver->unsat_before_search) return;
+
+  if (x == y) {
+    if (d < 0) solver->unsat_before_search = true;
+    return;
+  }
+
+  i = sidl_graph_add_edge(&solver->graph, x, y, d, true_literal);
+  ivector_reset(&solver->expl_buffer);
+  if (! sidl_graph_repair(&solver->graph, i, &solver->expl_buffer)) {
+    sidl_graph_remove_last_edge(&solver->graph);
+    solver->unsat_before_search = true;
+  }
+}
+
+
+/*
+ * Assert (x - y == d) as an axiom: (x - y <= d && y - x <= -d)
+ */
+void sidl_add_axiom_eq(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
+  sidl_add_axiom_edge(solver, x, y, d);
+  sidl_add_axiom_edge(solver, y, x, -d);
+}
+
+
+/*
+ * Try to assert (x - y <= d) with explanation l
+ * - if that causes a conflict, generate the conflict explanation and return false
+ * - return true if the edge does not cause a conflict
+ */
+static bool sidl_add_edge(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d, literal_t l) {
+  sidl_graph_t *graph;
+  ivector_t *v;
+  uint32_t i, n;
+  int32_t e;
+
+  graph = &solver->graph;
+  e = sidl_graph_add_edge(graph, x, y, d, l);
+  if (sidl_reduced_cost(graph, e) < 0) {
+    solver->stats.num_repairs ++;
+  }
+  v = &solver->expl_buffer;
+  ivector_reset(v);
+  if (sidl_graph_repair(graph, e, v)) {
+    return true;
+  }
+
+  solver->stats.num_conflicts ++;
+
+#if TRACE
+  printf("---> SIDL: conflict on edge %"PRId32" -> %"PRId32", cost %"PRId32"\n", x, y, d);
+#endif
+
+  /*
+   * v contains the literals on the negative circuit: the conflict
+   * clause is their negation + the end marker.
+   */
+  sidl_graph_remove_last_edge(graph);
+
+  n = v->size;
+  for (i=0; i<n; i++) {
+    v->data[i] = not(v->data[i]);
+  }
+  ivector_push(v, null_literal);
+  record_theory_conflict(solver->core, v->data);
+
+  return false;
+}
+
+
+
+
+/**************************
+ *   THEORY PROPAGATION   *
+ *************************/
+
+/*
+ * Build the antecedent for an atom implied by path x ---> u -> v ---> y
+ * where u -> v is edge i.
+ * - return a pointer to a literal array, terminated by null_literal
+ *   and stored in the arena
+ */
+static literal_t *gen_sidl_prop_antecedent(sidl_solver_t *solver, int32_t x, int32_t i, int32_t y) {
+  ivector_t *v;
+  literal_t *expl;
+  uint32_t j, n;
+
+  v = &solver->expl_buffer;
+  ivector_reset(v);
+  sidl_graph_explain_path(&solver->graph, x, i, y, v);
+
+  n = v->size;
+  expl = (literal_t *) arena_alloc(&solver->arena, (n + 1) * sizeof(int32_t));
+  for (j=0; j<n; j++) {
+    expl[j] = v->data[j];
+  }
+  expl[j] = null_literal;
+
+  return expl;
+}
+
+
+/*
+ * Assign atom k to true or false (sign = 0 or 1) and propagate the literal
+ * - the path x ---> u -> v ---> y (where u -> v is edge i) is the explanation
+ */
+static void sidl_propagate_atom(sidl_solver_t *solver, int32_t k, uint32_t sign, int32_t x, int32_t i, int32_t y) {
+  sidl_atom_t *a;
+  literal_t *expl;
+
+  expl = gen_sidl_prop_antecedent(solver, x, i, y);
+  mark_sidl_atom_assigned(&solver->atoms, k);
+  push_sidl_atom_index(&solver->astack, mk_sidl_index(k, sign));
+  a = get_sidl_atom(&solver->atoms, k);
+  propagate_literal(solver->core, mk_lit(a->boolvar, sign), expl);
+  solver->stats.num_propagations ++;
+
+#if TRACE
+  printf("---> SIDL propagation: atom %"PRId32" - %"PRId32" <= %"PRId32" is %s\n",
+         a->source, a->target, a->cost, sign == 0 ? "true" : "false");
+#endif
+}
+
+
+/*
+ * Check the unassigned atoms in which vertex z occurs
+ * - both searches for edge i must be done
+ * - atom (x - y <= d) is true if there's a path from x to y
+ *   through edge i of length <= d
+ * - it's false if there's a path from y to x through edge i
+ *   of length < -d
+ */
+static void sidl_check_atoms_of_vertex(sidl_solver_t *solver, int32_t z, int32_t i) {
+  sidl_graph_t *graph;
+  sidl_atom_t *a;
+  int32_t *occ;
+  int32_t k, x, y;
+  uint32_t j, n;
+
+  graph = &solver->graph;
+  occ = graph->occ[z];
+  n = iv_len(occ);
+  for (j=0; j<n; j++) {
+    k = occ[j];
+    if (! sidl_atom_is_assigned(&solver->atoms, k)) {
+      a = get_sidl_atom(&solver->atoms, k);
+      x = a->source;
+      y = a->target;
+      if (sidl_graph_bvisited(graph, x) && sidl_graph_fvisited(graph, y) &&
+          sidl_graph_path_length(graph, x, i, y) <= a->cost) {
+        sidl_propagate_atom(solver, k, 0, x, i, y);
+      } else if (sidl_graph_bvisited(graph, y) && sidl_graph_fvisited(graph, x) &&
+                 sidl_graph_path_length(graph, y, i, x) < - (int64_t) a->cost) {
+        sidl_propagate_atom(solver, k, 1, y, i, x);
+      }
+    }
+  }
+}
+
+
+/*
+ * Theory propagation for edge i (from u to v):
+ * - search backward from u and forward from v
+ * - then check all the atoms that occur in the smallest set of visited vertices
+ */
+static void sidl_propagate_edge(sidl_solver_t *solver, int32_t i) {
+  sidl_graph_t *graph;
+  ivector_t *v;
+  uint32_t j, n;
+  bool bounded;
+
+  graph = &solver->graph;
+  bounded = sidl_graph_backward_search(graph, graph->edges.data[i].source, solver->prop_bound);
+  bounded |= sidl_graph_forward_search(graph, graph->edges.data[i].target, solver->prop_bound);
+  if (bounded) {
+    solver->stats.num_bounded ++;
+  }
+
+  v = &graph->bvisited;
+  if (graph->fvisited.size < v->size) {
+    v = &graph->fvisited;
+  }
+  n = v->size;
+  for (j=0; j<n; j++) {
+    sidl_check_atoms_of_vertex(solver, v->data[j], i);
+  }
+
+  sidl_graph_clear_searches(graph);
+}
+
+
+
+
+/********************
+ *  SMT OPERATIONS  *
+ *******************/
+
+/*
+ * Start internalization: do nothing
+ */
+void sidl_start_internalization(sidl_solver_t *solver) {
+}
+
+
+/*
+ * Start search: if unsat flag is true, force a conflict in the core.
+ * Otherwise, do nothing.
+ */
+void sidl_start_search(sidl_solver_t *solver) {
+  if (solver->unsat_before_search) {
+    record_empty_theory_conflict(solver->core);
+  }
+}
+
+
+/*
+ * Start a new decision level:
+ * - save the current number of edges and the size of the atom stack
+ */
+void sidl_increase_decision_level(sidl_solver_t *solver) {
+  assert(! solver->unsat_before_search);
+  assert(solver->astack.top == solver->astack.prop_ptr);
+
+  push_sidl_undo_record(&solver->stack, solver->graph.edges.top, solver->astack.top);
+  solver->decision_level ++;
+
+  // open new scope in the arena (for storing propagation antecedents)
+  arena_push(&solver->arena);
+}
+
+
+/*
+ * Assert atom:
+ * - a stores the index of an atom attached to a boolean variable v
+ * - l is either pos_lit(v) or neg_lit(v)
+ * - pos_lit means assert atom (x - y <= c)
+ * - neg_lit means assert its negation (y - x <= -c-1)
+ * We just push the corresponding atom index onto the propagation queue
+ */
+bool sidl_assert_atom(sidl_solver_t *solver, void *a, literal_t l) {
+  int32_t k;
+
+  k = sidl_atom2index(a);
+  assert(var_of(l) == get_sidl_atom(&solver->atoms, k)->boolvar);
+
+  if (! sidl_atom_is_assigned(&solver->atoms, k)) {
+    mark_sidl_atom_assigned(&solver->atoms, k);
+    push_sidl_atom_index(&solver->astack, mk_sidl_index(k, sign_of_lit(l)));
+  }
+
+  return true;
+}
+
+
+/*
+ * Process all asserted atoms then propagate implied atoms to the core
+ */
+bool sidl_propagate(sidl_solver_t *solver) {
+  uint32_t i, n, e;
+  int32_t k, *a;
+  int32_t x, y, d;
+  literal_t l;
+  sidl_atom_t *atom;
+
+  e = solver->graph.edges.top;
+
+  a = solver->astack.data;
+  n = solver->astack.top;
+  for (i=solver->astack.prop_ptr; i<n; i++) {
+    k = a[i];
+    atom = get_sidl_atom(&solver->atoms, sidl_atom_of_index(k));
+    // turn atom or its negation into (x - y <= d)
+    if (is_pos_sidl_index(k)) {
+      x = atom->source;
+      y = atom->target;
+      d = atom->cost;
+      l = pos_lit(atom->boolvar);
+    } else {
+      x = atom->target;
+      y = atom->source;
+      d = - atom->cost - 1;
+      l = neg_lit(atom->boolvar);
+    }
+
+    if (! sidl_add_edge(solver, x, y, d, l)) return false; // conflict
+  }
+  solver->astack.prop_ptr = n;
+
+  // theory propagation: edges e to top-1 are new
+  if (solver->prop_bound > 0) {
+    n = solver->graph.edges.top;
+    while (e < n && ! sidl_all_atoms_assigned(&solver->atoms)) {
+      sidl_propagate_edge(solver, e);
+      e ++;
+    }
+    // skip the implied atoms in the next call to sidl_propagate
+    solver->astack.prop_ptr = solver->astack.top;
+  }
+
+  return true;
+}
+
+
+/*
+ * Final check: do nothing and return SAT
+ */
+fcheck_code_t sidl_final_check(sidl_solver_t *solver) {
+  return FCHECK_SAT;
+}
+
+
+/*
+ * Clear: do nothing
+ */
+void sidl_clear(sidl_solver_t *solver) {
+}
+
+
+/*
+ * Expand explanation for literal l
+ * - l was implied with expl as antecedent
+ * - expl is a null-terminated array of literals stored in the arena.
+ * - v = vector where the explanation is to be added
+ */
+void sidl_expand_explanation(sidl_solver_t *solver, literal_t l, literal_t *expl, ivector_t *v) {
+  literal_t x;
+
+  for (;;) {
+    x = *expl ++;
+    if (x == null_literal) break;
+    ivector_push(v, x);
+  }
+}
+
+
+/*
+ * Backtrack to back_level
+ */
+void sidl_backtrack(sidl_solver_t *solver, uint32_t back_level) {
+  sidl_undo_record_t *undo;
+  uint32_t i, n;
+  int32_t *a;
+
+  assert(solver->base_level <= back_level && back_level < solver->decision_level);
+
+  /*
+   * stack->data[back_level+1] = undo record created on entry to back_level + 1
+   */
+  assert(back_level + 1 < solver->stack.top);
+  undo = solver->stack.data + back_level + 1;
+
+  // remove all edges of level >= back_level + 1
+  sidl_graph_remove_edges(&solver->graph, undo->nedges);
+
+  // all atoms assigned at levels > back_level are now unassigned
+  n = undo->natoms;
+  i = solver->astack.top;
+  a = solver->astack.data;
+  while (i > n) {
+    i --;
+    mark_sidl_atom_unassigned(&solver->atoms, sidl_atom_of_index(a[i]));
+  }
+  solver->astack.top = n;
+  solver->astack.prop_ptr = n;
+
+  // delete the antecedents
+  i = solver->decision_level;
+  do {
+    arena_pop(&solver->arena);
+    i --;
+  } while (i > back_level);
+
+  solver->stack.top = back_level + 1;
+  solver->decision_level = back_level;
+}
+
+
+/*
+ * Push:
+ * - store current number of vertices and atoms on the trail_stack
+ * - increment both decision level and base level
+ */
+void sidl_push(sidl_solver_t *solver) {
+  assert(solver->base_level == solver->decision_level);
+
+  dl_vartable_push(&solver->vtbl);
+  sidl_trail_stack_save(&solver->trail_stack, solver->graph.nvertices, solver->atoms.natoms);
+  solver->base_level ++;
+  sidl_increase_decision_level(solver);
+  assert(solver->decision_level == solver->base_level);
+}
+
+
+/*
+ * Pop: remove vertices and atoms created at the current base-level
+ */
+void sidl_pop(sidl_solver_t *solver) {
+  sidl_trail_t *top;
+
+  assert(solver->base_level > 0 && solver->base_level == solver->decision_level);
+  top = sidl_trail_stack_top(&solver->trail_stack);
+
+  // backtrack to the previous base level: this removes all the edges
+  // added since the push
+  solver->base_level --;
+  sidl_backtrack(solver, solver->base_level);
+
+  // remove variables, atoms, and vertices
+  dl_vartable_pop(&solver->vtbl);
+  sidl_remove_atoms(solver, top->natoms);
+  sidl_graph_remove_vertices(&solver->graph, top->nvertices);
+  if (solver->zero_vertex >= (int32_t) top->nvertices) {
+    solver->zero_vertex = null_sidl_vertex;
+  }
+
+  sidl_trail_stack_pop(&solver->trail_stack);
+
+  /*
+   * The axioms asserted since the push may have been inconsistent
+   * but the ones asserted before were not (otherwise we couldn't
+   * have pushed).
+   */
+  solver->unsat_before_search = false;
+}
+
+
+/*
+ * Reset
+ */
+void sidl_reset(sidl_solver_t *solver) {
+  solver->base_level = 0;
+  solver->decision_level = 0;
+  solver->unsat_before_search = false;
+
+  reset_dl_vartable(&solver->vtbl);
+
+  solver->zero_vertex = null_sidl_vertex;
+  reset_sidl_graph(&solver->graph);
+
+  reset_sidl_atbl(&solver->atoms);
+  reset_sidl_astack(&solver->astack);
+  reset_sidl_undo_stack(&solver->stack);
+  reset_sidl_trail_stack(&solver->trail_stack);
+
+  reset_int_htbl(&solver->htbl);
+  arena_reset(&solver->arena);
+  ivector_reset(&solver->expl_buffer);
+  ivector_reset(&solver->aux_vector);
+
+  solver->triple.target = nil_vertex;
+  solver->triple.source = nil_vertex;
+  q_clear(&solver->triple.constant);
+  reset_poly_buffer(&solver->buffer);
+
+  if (solver->value != NULL) {
+    safe_free(solver->value);
+    solver->value = NULL;
+  }
+
+  // undo record for level 0
+  push_sidl_undo_record(&solver->stack, 1, 0);
+}
+
+
+
+/*
+ * THEORY-BRANCHING
+ */
+
+/*
+ * To decide whether to case-split (x - y <= b) = true or false
+ * we check whether val[x] - val[y] <= b in the current assignment.
+ */
+literal_t sidl_select_polarity(sidl_solver_t *solver, void *a, literal_t l) {
+  sidl_atom_t *atom;
+  int64_t *val;
+  bvar_t v;
+
+  v = var_of(l);
+  atom = get_sidl_atom(&solver->atoms, sidl_atom2index(a));
+  assert(atom->boolvar == v);
+
+  val = solver->graph.val;
+  if (val[atom->source] - val[atom->target] <= atom->cost) {
+    return pos_lit(v);
+  } else {
+    return neg_lit(v);
+  }
+}
+
+
+
+
+/**********************
+ *  INTERNALIZATION   *
+ *********************/
+
+/*
+ * Raise exception or abort
+ */
+static __attribute__ ((noreturn)) void sidl_exception(sidl_solver_t *solver, int code) {
+  if (solver->env != NULL) {
+    longjmp(*solver->env, code);
+  }
+  abort();
+}
+
+
+/*
+ * Store a triple (x, y, c) into the internal triple
+ * create/get the corresponding variable from vtbl.
+ * - x = target vertex
+ * - y = source vertex
+ * - c = constant
+ * This returns a variable id whose descriptor is (x - y + c).
+ */
+static thvar_t sidl_var_for_triple(sidl_solver_t *solver, int32_t x, int32_t y, int32_t c) {
+  dl_triple_t *triple;
+
+  triple = &solver->triple;
+  triple->target = x;
+  triple->source = y;
+  q_set32(&triple->constant, c);
+
+  return get_dl_var(&solver->vtbl, triple);
+}
+
+
+/*
+ * Apply renaming and substitution to polynomial p
+ * - map is a variable renaming: if p is a_0 t_0 + ... + a_n t_n
+ *   then map[i] is the theory variable x_i that replaces t_i.
+ * - so the function construct p = a_0 x_0 + ... + a_n x_n
+ * The result is stored into solver->buffer.
+ */
+static void sidl_rename_poly(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  poly_buffer_t *b;
+  monomial_t *mono;
+  uint32_t i, n;
+
+  b = &solver->buffer;
+  reset_poly_buffer(b);
+
+  n = p->nterms;
+  mono = p->mono;
+
+  // deal with p's constant term if any
+  if (map[0] == null_thvar) {
+    assert(mono[0].var == const_idx);
+    poly_buffer_add_const(b, &mono[0].coeff);
+    n --;
+    map ++;
+    mono ++;
+  }
+
+  for (i=0; i<n; i++) {
+    assert(mono[i].var != const_idx);
+    addmul_dl_var_to_buffer(&solver->vtbl, b, map[i], &mono[i].coeff);
+  }
+
+  normalize_poly_buffer(b);
+}
+
+
+/*
+ * Create the zero_vertex but raise an exception if that fails.
+ */
+static int32_t sidl_get_zero_vertex(sidl_solver_t *solver) {
+  int32_t z;
+
+  z = sidl_zero_vertex(solver);
+  if (z < 0) {
+    sidl_exception(solver, TOO_MANY_ARITH_VARS);
+  }
+  return z;
+}
+
+
+/*
+ * Convert triple d = (x - y + c) to vertices and an int32 constant
+ * - d must not be trivial (i.e., x != y)
+ * - raise an exception if c doesn't fit in 32 bits or if c is INT32_MIN
+ *   (we need to be able to represent -c).
+ * - a nil vertex in d denotes zero
+ */
+static void sidl_convert_triple(sidl_solver_t *solver, dl_triple_t *d, int32_t *x, int32_t *y, int32_t *c) {
+  assert(d->target != d->source);
+
+  if (! q_get32(&d->constant, c) || *c == INT32_MIN) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  *x = d->target;
+  *y = d->source;
+  if (*x < 0) {
+    *x = sidl_get_zero_vertex(solver);
+  } else if (*y < 0) {
+    *y = sidl_get_zero_vertex(solver);
+  }
+}
+
+
+/*
+ * Create the atom (x - y + c) == 0 for d = (x - y + c)
+ */
+static literal_t sidl_eq_from_triple(sidl_solver_t *solver, dl_triple_t *d) {
+  literal_t l1, l2;
+  int32_t c, x, y;
+
+  // trivial equality
+  if (d->target == d->source) {
+    return q_is_zero(&d->constant) ? true_literal : false_literal;
+  }
+
+  sidl_convert_triple(solver, d, &x, &y, &c);
+
+  // v == 0 is the conjunction of (y - x <= c) and (x - y <= -c)
+  l1 = sidl_make_atom(solver, y, x, c);
+  l2 = sidl_make_atom(solver, x, y, -c);
+  return mk_and_gate2(solver->gate_manager, l1, l2);
+}
+
+
+/*
+ * Create the atom (x - y + c) >= 0 for d = (x - y + c)
+ */
+static literal_t sidl_ge_from_triple(sidl_solver_t *solver, dl_triple_t *d) {
+  int32_t c, x, y;
+
+  if (d->target == d->source) {
+    return q_is_nonneg(&d->constant) ? true_literal : false_literal;
+  }
+
+  sidl_convert_triple(solver, d, &x, &y, &c);
+
+  // (x - y + c >= 0) is (y - x <= c)
+  return sidl_make_atom(solver, y, x, c);
+}
+
+
+/*
+ * Assert (x - y + c) == 0 or (x - y + c) != 0, given a triple d = x - y + c
+ * - tt true: assert the equality
+ * - tt false: assert the disequality
+ */
+static void sidl_assert_triple_eq(sidl_solver_t *solver, dl_triple_t *d, bool tt) {
+  int32_t x, y, c;
+  literal_t l1, l2;
+
+  if (d->target == d->source) {
+    if (q_is_zero(&d->constant) != tt) {
+      solver->unsat_before_search = true;
+    }
+    return;
+  }
+
+  sidl_convert_triple(solver, d, &x, &y, &c);
+
+  if (tt) {
+    // (x - y + c) == 0 is equivalent to y - x == c
+    sidl_add_axiom_eq(solver, y, x, c);
+  } else {
+    // (x - y + c) != 0 is equivalent to
+    // (not (y - x <= c)) or (not (x - y <= -c))
+    l1 = sidl_make_atom(solver, y, x, c);
+    l2 = sidl_make_atom(solver, x, y, -c);
+    add_binary_clause(solver->core, not(l1), not(l2));
+  }
+}
+
+
+/*
+ * Assert (x - y + c) >= 0 or (x - y + c) < 0, given a triple d = x - y + c
+ * - tt true: assert  (x - y + c) >= 0
+ * - tt false: assert (x - y + c) < 0
+ */
+static void sidl_assert_triple_ge(sidl_solver_t *solver, dl_triple_t *d, bool tt) {
+  int32_t x, y, c;
+
+  if (d->target == d->source) {
+    if (q_is_nonneg(&d->constant) != tt) {
+      solver->unsat_before_search = true;
+    }
+    return;
+  }
+
+  sidl_convert_triple(solver, d, &x, &y, &c);
+
+  if (tt) {
+    // (x - y + c) >= 0 is equivalent to (y - x <= c)
+    sidl_add_axiom_edge(solver, y, x, c);
+  } else {
+    // (x - y + c) < 0 is equivalent to (x - y <= -c-1)
+    sidl_add_axiom_edge(solver, x, y, -c-1);
+  }
+}
+
+
+/*
+ * TERM CONSTRUCTORS
+ */
+
+/*
+ * Create a new theory variable
+ * - raise exception NOT_IDL if is_int is false
+ * - raise exception TOO_MANY_VARS if we can't create a new vertex
+ */
+thvar_t sidl_create_var(sidl_solver_t *solver, bool is_int) {
+  int32_t v;
+
+  if (! is_int) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  v = sidl_new_vertex(solver);
+  if (v < 0) {
+    sidl_exception(solver, TOO_MANY_ARITH_VARS);
+  }
+
+  return sidl_var_for_triple(solver, v, nil_vertex, 0);
+}
+
+
+/*
+ * Create a variable that represents the constant q
+ * - fails if q is not an integer or doesn't fit in 32 bits
+ */
+thvar_t sidl_create_const(sidl_solver_t *solver, rational_t *q) {
+  int32_t c;
+
+  if (! q_get32(q, &c)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  return sidl_var_for_triple(solver, nil_vertex, nil_vertex, c);
+}
+
+
+/*
+ * Create a variable for a polynomial p, with variables defined by map
+ * - fails if p is not of the form (x - y + c)
+ */
+thvar_t sidl_create_poly(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  dl_triple_t *triple;
+
+  sidl_rename_poly(solver, p, map);
+  triple = &solver->triple;
+  if (! convert_poly_buffer_to_dl_triple(&solver->buffer, triple) ||
+      ! q_is_int32(&triple->constant)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  return get_dl_var(&solver->vtbl, triple);
+}
+
+
+/*
+ * Internalization for a product: always fails with NOT_IDL exception
+ */
+thvar_t sidl_create_pprod(sidl_solver_t *solver, pprod_t *p, thvar_t *map) {
+  sidl_exception(solver, FORMULA_NOT_IDL);
+}
+
+
+
+/*
+ * ATOM CONSTRUCTORS
+ */
+
+/*
+ * Create the atom v = 0
+ */
+literal_t sidl_create_eq_atom(sidl_solver_t *solver, thvar_t v) {
+  return sidl_eq_from_triple(solver, dl_var_triple(&solver->vtbl, v));
+}
+
+
+/*
+ * Create the atom v >= 0
+ */
+literal_t sidl_create_ge_atom(sidl_solver_t *solver, thvar_t v) {
+  return sidl_ge_from_triple(solver, dl_var_triple(&solver->vtbl, v));
+}
+
+
+/*
+ * Create the atom (v = w)
+ */
+literal_t sidl_create_vareq_atom(sidl_solver_t *solver, thvar_t v, thvar_t w) {
+  dl_triple_t *triple;
+
+  triple = &solver->triple;
+  if (! diff_dl_vars(&solver->vtbl, v, w, triple)) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  return sidl_eq_from_triple(solver, triple);
+}
+
+
+/*
+ * Create the atom (p = 0)
+ */
+literal_t sidl_create_poly_eq_atom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  dl_triple_t *triple;
+
+  sidl_rename_poly(solver, p, map);
+  triple = &solver->triple;
+  if (! rescale_poly_buffer_to_dl_triple(&solver->buffer, triple)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  return sidl_eq_from_triple(solver, triple);
+}
+
+
+/*
+ * Create the atom (p >= 0)
+ */
+literal_t sidl_create_poly_ge_atom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  dl_triple_t *triple;
+
+  sidl_rename_poly(solver, p, map);
+  triple = &solver->triple;
+  if (! rescale_poly_buffer_to_dl_triple(&solver->buffer, triple)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  return sidl_ge_from_triple(solver, triple);
+}
+
+
+
+/*
+ * TOP-LEVEL ASSERTIONS
+ */
+
+/*
+ * Assert (v == 0) or (v != 0)
+ */
+void sidl_assert_eq_axiom(sidl_solver_t *solver, thvar_t v, bool tt) {
+  sidl_assert_triple_eq(solver, dl_var_triple(&solver->vtbl, v), tt);
+}
+
+
+/*
+ * Assert (v >= 0) or (v < 0)
+ */
+void sidl_assert_ge_axiom(sidl_solver_t *solver, thvar_t v, bool tt) {
+  sidl_assert_triple_ge(solver, dl_var_triple(&solver->vtbl, v), tt);
+}
+
+
+/*
+ * Assert (p == 0) or (p != 0) depending on tt
+ */
+void sidl_assert_poly_eq_axiom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map, bool tt) {
+  dl_triple_t *triple;
+
+  sidl_rename_poly(solver, p, map);
+  triple = &solver->triple;
+  if (! rescale_poly_buffer_to_dl_triple(&solver->buffer, triple)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  sidl_assert_triple_eq(solver, triple, tt);
+}
+
+
+/*
+ * Assert (p >= 0) or (p < 0) depending on tt
+ */
+void sidl_assert_poly_ge_axiom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map, bool tt) {
+  dl_triple_t *triple;
+
+  sidl_rename_poly(solver, p, map);
+  triple = &solver->triple;
+  if (! rescale_poly_buffer_to_dl_triple(&solver->buffer, triple)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  sidl_assert_triple_ge(solver, triple, tt);
+}
+
+
+/*
+ * Assert (v == w) or (v != w)
+ */
+void sidl_assert_vareq_axiom(sidl_solver_t *solver, thvar_t v, thvar_t w, bool tt) {
+  dl_triple_t *triple;
+
+  triple = &solver->triple;
+  if (! diff_dl_vars(&solver->vtbl, v, w, triple)) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  sidl_assert_triple_eq(solver, triple, tt);
+}
+
+
+/*
+ * Assert (c ==> v == w)
+ */
+void sidl_assert_cond_vareq_axiom(sidl_solver_t *solver, literal_t c, thvar_t v, thvar_t w) {
+  dl_triple_t *triple;
+  int32_t x, y, d;
+  literal_t l1, l2;
+
+  triple = &solver->triple;
+  if (! diff_dl_vars(&solver->vtbl, v, w, triple)) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  if (triple->target == triple->source) {
+    if (q_is_nonzero(&triple->constant)) {
+      // v == w is false
+      add_unit_clause(solver->core, not(c));
+    }
+    return;
+  }
+
+  sidl_convert_triple(solver, triple, &x, &y, &d);
+
+  // c ==> (y - x <= d) and c ==> (x - y <= -d)
+  l1 = sidl_make_atom(solver, y, x, d);
+  l2 = sidl_make_atom(solver, x, y, -d);
+  add_binary_clause(solver->core, not(c), l1);
+  add_binary_clause(solver->core, not(c), l2);
+}
+
+
+/*
+ * Assert (c[0] \/ .... \/ c[n-1] \/ v == w)
+ */
+void sidl_assert_clause_vareq_axiom(sidl_solver_t *solver, uint32_t n, literal_t *c, thvar_t v, thvar_t w) {
+  dl_triple_t *triple;
+  ivector_t *aux;
+  int32_t x, y, d;
+  literal_t l1, l2;
+
+  triple = &solver->triple;
+  if (! diff_dl_vars(&solver->vtbl, v, w, triple)) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  if (triple->target == triple->source) {
+    if (q_is_nonzero(&triple->constant)) {
+      // v == w is false
+      add_clause(solver->core, n, c);
+    }
+    return;
+  }
+
+  sidl_convert_triple(solver, triple, &x, &y, &d);
+
+  l1 = sidl_make_atom(solver, y, x, d);  // (y - x <= d)
+  l2 = sidl_make_atom(solver, x, y, -d); // (x - y <= -d)
+
+  aux = &solver->aux_vector;
+  assert(aux->size == 0);
+  ivector_copy(aux, c, n);
+
+  ivector_push(aux, l1);
+  add_clause(solver->core, n+1, aux->data);
+
+  aux->data[n] = l2;
+  add_clause(solver->core, n+1, aux->data);
+
+  ivector_reset(aux);
+}
+
+
+
+
+/************************
+ *  MODEL CONSTRUCTION  *
+ ***********************/
+
+#ifndef NDEBUG
+
+/*
+ * For debugging: check whether the model satisfies all the edges
+ */
+static bool good_sidl_model(sidl_solver_t *solver) {
+  sidl_edge_t *e;
+  uint32_t i, n;
+
+  n = solver->graph.edges.top;
+  for (i=1; i<n; i++) {
+    e = solver->graph.edges.data + i;
+    if (solver->value[e->source] - solver->value[e->target] > e->cost) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif
+
+
+/*
+ * Build the model: shift the current assignment so that the zero vertex
+ * is mapped to 0.
+ */
+void sidl_build_model(sidl_solver_t *solver) {
+  int64_t *val;
+  int64_t zero;
+  uint32_t i, n;
+
+  assert(solver->value == NULL);
+
+  n = solver->graph.nvertices;
+  val = solver->graph.val;
+  zero = 0;
+  if (solver->zero_vertex >= 0) {
+    zero = val[solver->zero_vertex];
+  }
+
+  solver->value = (int64_t *) safe_malloc(n * sizeof(int64_t));
+  for (i=0; i<n; i++) {
+    solver->value[i] = val[i] - zero;
+  }
+
+  assert(good_sidl_model(solver));
+}
+
+
+/*
+ * Free the model
+ */
+void sidl_free_model(sidl_solver_t *solver) {
+  assert(solver->value != NULL);
+  safe_free(solver->value);
+  solver->value = NULL;
+}
+
+
+/*
+ * Value of variable x in the model
+ * - copy the value in v and return true
+ */
+bool sidl_value_in_model(sidl_solver_t *solver, thvar_t x, rational_t *v) {
+  dl_triple_t *d;
+  int64_t aux;
+
+  assert(solver->value != NULL && 0 <= x && x < solver->vtbl.nvars);
+  d = dl_var_triple(&solver->vtbl, x);
+
+  // d is of the form (target - source + constant)
+  aux = 0;
+  if (d->target >= 0) {
+    aux = sidl_vertex_value(solver, d->target);
+  }
+  if (d->source >= 0) {
+    aux -= sidl_vertex_value(solver, d->source);
+  }
+
+  q_set64(v, aux);
+  q_add(v, &d->constant);
+
+  return true;
+}
+
+
+/*
+ * Interface function: check whether x is an integer variable.
+ */
+bool sidl_var_is_integer(sidl_solver_t *solver, thvar_t x) {
+  assert(0 <= x && x < solver->vtbl.nvars);
+  return true;
+}
+
+
+
+
+/***************************
+ *  INTERFACE DESCRIPTORS  *
+ **************************/
+
+/*
+ * Control interface
+ */
+static th_ctrl_interface_t sidl_control = {
+  (start_intern_fun_t) sidl_start_internalization,
+  (start_fun_t) sidl_start_search,
+  (propagate_fun_t) sidl_propagate,
+  (final_check_fun_t) sidl_final_check,
+  (increase_level_fun_t) sidl_increase_decision_level,
+  (backtrack_fun_t) sidl_backtrack,
+  (push_fun_t) sidl_push,
+  (pop_fun_t) sidl_pop,
+  (reset_fun_t) sidl_reset,
+  (clear_fun_t) sidl_clear,
+};
+
+
+/*
+ * SMT interface: delete_atom and end_atom_deletion are not supported.
+ */
+static th_smt_interface_t sidl_smt = {
+  (assert_fun_t) sidl_assert_atom,
+  (expand_expl_fun_t) sidl_expand_explanation,
+  (select_pol_fun_t) sidl_select_polarity,
+  NULL,
+  NULL,
+};
+
+
+/*
+ * Internalization interface
+ */
+static arith_interface_t sidl_intern = {
+  (create_arith_var_fun_t) sidl_create_var,
+  (create_arith_const_fun_t) sidl_create_const,
+  (create_arith_poly_fun_t) sidl_create_poly,
+  (create_arith_pprod_fun_t) sidl_create_pprod,
+
+  (create_arith_atom_fun_t) sidl_create_eq_atom,
+  (create_arith_atom_fun_t) sidl_create_ge_atom,
+  (create_arith_patom_fun_t) sidl_create_poly_eq_atom,
+  (create_arith_patom_fun_t) sidl_create_poly_ge_atom,
+  (create_arith_vareq_atom_fun_t) sidl_create_vareq_atom,
+
+  (assert_arith_axiom_fun_t) sidl_assert_eq_axiom,
+  (assert_arith_axiom_fun_t) sidl_assert_ge_axiom,
+  (assert_arith_paxiom_fun_t) sidl_assert_poly_eq_axiom,
+  (assert_arith_paxiom_fun_t) sidl_assert_poly_ge_axiom,
+  (assert_arith_vareq_axiom_fun_t) sidl_assert_vareq_axiom,
+  (assert_arith_cond_vareq_axiom_fun_t) sidl_assert_cond_vareq_axiom,
+  (assert_arith_clause_vareq_axiom_fun_t) sidl_assert_clause_vareq_axiom,
+
+  NULL, // attach_eterm is not supported
+  NULL, // eterm of var is not supported
+
+  (build_model_fun_t) sidl_build_model,
+  (free_model_fun_t) sidl_free_model,
+  (arith_val_in_model_fun_t) sidl_value_in_model,
+
+  (arith_var_is_int_fun_t) sidl_var_is_integer,
+};
+
+
+
+
+/*****************
+ *  FULL SOLVER  *
+ ****************/
+
+/*
+ * Initialize solver:
+ * - core = attached smt_core solver
+ * - gates = the attached gate manager
+ */
+void init_sidl_solver(sidl_solver_t *solver, smt_core_t *core, gate_manager_t *gates) {
+  solver->core = core;
+  solver->gate_manager = gates;
+  solver->base_level = 0;
+  solver->decision_level = 0;
+  solver->unsat_before_search = false;
+  solver->prop_bound = DEFAULT_SIDL_PROP_BOUND;
+
+  init_dl_vartable(&solver->vtbl);
+
+  solver->zero_vertex = null_sidl_vertex;
+  init_sidl_graph(&solver->graph, DEFAULT_SIDL_GRAPH_SIZE);
+
+  init_sidl_atbl(&solver->atoms, DEFAULT_SIDL_ATBL_SIZE);
+  init_sidl_astack(&solver->astack, DEFAULT_SIDL_ASTACK_SIZE);
+  init_sidl_undo_stack(&solver->stack, DEFAULT_SIDL_UNDO_STACK_SIZE);
+  init_sidl_trail_stack(&solver->trail_stack);
+
+  solver->stats.num_conflicts = 0;
+  solver->stats.num_repairs = 0;
+  solver->stats.num_propagations = 0;
+  solver->stats.num_bounded = 0;
+
+  init_int_htbl(&solver->htbl, 0);
+  init_arena(&solver->arena);
+  init_ivector(&solver->expl_buffer, DEFAULT_SIDL_BUFFER_SIZE);
+  init_ivector(&solver->aux_vector, DEFAULT_SIDL_BUFFER_SIZE);
+
+  solver->triple.target = nil_vertex;
+  solver->triple.source = nil_vertex;
+  q_init(&solver->triple.constant);
+  init_poly_buffer(&solver->buffer);
+
+  solver->value = NULL;
+  solver->env = NULL;
+
+  // undo record for level 0
+  push_sidl_undo_record(&solver->stack, 1, 0);
+}
+
+
+/*
+ * Delete solver
+ */
+void delete_sidl_solver(sidl_solver_t *solver) {
+  delete_dl_vartable(&solver->vtbl);
+  delete_sidl_graph(&solver->graph);
+  delete_sidl_atbl(&solver->atoms);
+  delete_sidl_astack(&solver->astack);
+  delete_sidl_undo_stack(&solver->stack);
+  delete_sidl_trail_stack(&solver->trail_stack);
+
+  delete_int_htbl(&solver->htbl);
+  delete_arena(&solver->arena);
+  delete_ivector(&solver->expl_buffer);
+  delete_ivector(&solver->aux_vector);
+
+  q_clear(&solver->triple.constant);
+  delete_poly_buffer(&solver->buffer);
+
+  if (solver->value != NULL) {
+    safe_free(solver->value);
+    solver->value = NULL;
+  }
+}
+
+
+/*
+ * Attach a jump buffer
+ */
+void sidl_solver_init_jmpbuf(sidl_solver_t *solver, jmp_buf *buffer) {
+  solver->env = buffer;
+}
+
+
+/*
+ * Get the control and smt interfaces
+ */
+th_ctrl_interface_t *sidl_ctrl_interface(sidl_solver_t *solver) {
+  return &sidl_control;
+}
+
+th_smt_interface_t *sidl_smt_interface(sidl_solver_t *solver) {
+  return &sidl_smt;
+}
+
+
+/*
+ * Get the internalization interface
+ */
+arith_interface_t *sidl_arith_interface(sidl_solver_t *solver) {
+  return &sidl_intern;
+}
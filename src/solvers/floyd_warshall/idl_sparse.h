@@ -0,0 +1,609 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SPARSE SOLVER FOR INTEGER DIFFERENCE LOGIC
+ */
+
+/*
+ * This solver is an alternative to the Floyd-Warshall solver for
+ * problems with many variables and few constraints per variable.
+ * Like the Floyd-Warshall solver, it's for integer difference logic
+ * only and it cannot be attached to the egraph.
+ *
+ * The graph is stored as adjacency lists. Instead of a distance
+ * matrix, we maintain a feasible assignment (a potential function):
+ * an integer value val[x] for every vertex x such that
+ *    val[x] - val[y] <= c for every edge from x to y of cost c.
+ *
+ * - When an edge is added, the assignment is repaired incrementally
+ *   (using the algorithm of Cotton & Maler, 2006). The repair fails
+ *   if and only if the new edge creates a negative circuit.
+ * - Theory propagation uses Dijkstra's algorithm with reduced costs
+ *   (c - val[x] + val[y] >= 0). The search is bounded by the number
+ *   of edges scanned so propagation is incomplete.
+ * - The assignment is the model.
+ *
+ * Edge costs are 32bit integers but the assignment and all path
+ * lengths are computed using 64bit integers.
+ */
+
+#ifndef __IDL_SPARSE_H
+#define __IDL_SPARSE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "context/context_types.h"
+#include "solvers/cdcl/smt_core.h"
+#include "solvers/floyd_warshall/dl_vartable.h"
+#include "terms/poly_buffer.h"
+#include "utils/arena.h"
+#include "utils/bitvectors.h"
+#include "utils/generic_heap.h"
+#include "utils/int_hash_tables.h"
+#include "utils/int_vectors.h"
+
+
+/***********
+ *  GRAPH  *
+ **********/
+
+/*
+ * Edge and vertex indices are signed 32bit integers
+ * - null_sidl_edge = -1 and null_sidl_vertex = -1 are markers
+ */
+enum {
+  null_sidl_edge = -1,
+  null_sidl_vertex = -1,
+};
+
+
+/*
+ * Edge from source to target with the given cost: it encodes
+ * the constraint (source - target <= cost).
+ */
+typedef struct sidl_edge_s {
+  int32_t source;
+  int32_t target;
+  int32_t cost;
+} sidl_edge_t;
+
+
+/*
+ * Stack of edges + a literal for each edge
+ * - for edge i: lit[i] == true_literal if i was asserted as an axiom
+ * - otherwise lit[i] = a literal l in the smt_core, such that l is true
+ *   and l is attached to an atom.
+ * - edge 0 is a marker (it's not a real edge)
+ */
+typedef struct sidl_edge_stack_s {
+  uint32_t size;
+  uint32_t top;
+  sidl_edge_t *data;
+  literal_t *lit;
+} sidl_edge_stack_t;
+
+#define DEFAULT_SIDL_EDGE_STACK_SIZE 100
+#define MAX_SIDL_EDGE_STACK_SIZE (UINT32_MAX/sizeof(sidl_edge_t))
+
+
+/*
+ * Graph: for every vertex x
+ * - out[x] = index vector of edges whose source is x
+ * - in[x] = index vector of edges whose target is x
+ * - occ[x] = index vector of atoms where x occurs
+ * - val[x] = value of x in the current assignment
+ * Edges are removed in the reverse order of their creation, so an edge
+ * being removed is always the last element of its out and in vectors.
+ *
+ * Work arrays for the search algorithms:
+ * - gamma[x] and pred[x] are used when the assignment is repaired
+ * - fdist[x] and fpred[x] for forward search (from the target of an edge)
+ * - bdist[x] and bpred[x] for backward search (to the source of an edge)
+ * The pred arrays store edge indices. We use null_sidl_edge to indicate
+ * that x has not been reached.
+ *
+ * - size = size of all the arrays
+ * - nvertices = number of vertices
+ */
+typedef struct sidl_graph_s {
+  uint32_t size;
+  uint32_t nvertices;
+  int32_t **out;
+  int32_t **in;
+  int32_t **occ;
+  int64_t *val;
+
+  int64_t *gamma;
+  int32_t *pred;
+  int64_t *fdist;
+  int32_t *fpred;
+  int64_t *bdist;
+  int32_t *bpred;
+
+  sidl_edge_stack_t edges;
+  generic_heap_t heap;
+  ivector_t touched;  // vertices reached by the repair algorithm
+  ivector_t fvisited; // vertices visited by forward search
+  ivector_t bvisited; // vertices visited by backward search
+} sidl_graph_t;
+
+#define DEFAULT_SIDL_GRAPH_SIZE 100
+#define MAX_SIDL_GRAPH_SIZE (UINT32_MAX/sizeof(int64_t))
+
+
+/*
+ * Maximal number of edges scanned by each search in theory propagation
+ */
+#define DEFAULT_SIDL_PROP_BOUND 20
+
+
+
+/***********
+ *  ATOMS  *
+ **********/
+
+/*
+ * Each atom has an index i (in the global atom table)
+ * - the atom includes <source vertex, target vertex, cost, boolean variable>
+ * - if atom->boolvar = v then the atom index is attached to v in the smt_core
+ */
+typedef struct sidl_atom_s {
+  int32_t source;
+  int32_t target;
+  int32_t cost;
+  bvar_t boolvar;
+} sidl_atom_t;
+
+
+/*
+ * Conversion from atom index to void* (and back)
+ */
+static inline void *sidl_index2atom(int32_t i) {
+  return (void *) ((size_t) i);
+}
+
+static inline int32_t sidl_atom2index(void *a) {
+  return (int32_t) ((size_t) a);
+}
+
+
+/*
+ * Atom table
+ * - size = size of the atoms array
+ * - natoms = number of atoms
+ * - nassigned = number of assigned atoms
+ * - mark = one bit per atom: 1 means that the atom is assigned
+ *   (present in the atom stack)
+ */
+typedef struct sidl_atbl_s {
+  uint32_t size;
+  uint32_t natoms;
+  uint32_t nassigned;
+  sidl_atom_t *atoms;
+  byte_t *mark;
+} sidl_atbl_t;
+
+#define DEFAULT_SIDL_ATBL_SIZE 100
+#define MAX_SIDL_ATBL_SIZE (UINT32_MAX/sizeof(sidl_atom_t))
+
+
+/*
+ * Atom stack & propagation queue: same encoding as in the
+ * Floyd-Warshall solver (atom index + sign bit).
+ * - the propagation queue consists of the atoms in
+ *   data[prop_ptr ... top -1]
+ */
+typedef struct sidl_astack_s {
+  uint32_t size;
+  uint32_t top;
+  uint32_t prop_ptr;
+  int32_t *data;
+} sidl_astack_t;
+
+#define DEFAULT_SIDL_ASTACK_SIZE 100
+#define MAX_SIDL_ASTACK_SIZE (UINT32_MAX/sizeof(int32_t))
+
+
+
+/****************
+ *  UNDO STACK  *
+ ***************/
+
+/*
+ * For backtracking: on entry to each decision level k we store:
+ * - number of edges in the graph
+ * - top of the atom stack
+ */
+typedef struct sidl_undo_record_s {
+  uint32_t nedges;
+  uint32_t natoms;
+} sidl_undo_record_t;
+
+typedef struct sidl_undo_stack_s {
+  uint32_t size;
+  uint32_t top;
+  sidl_undo_record_t *data;
+} sidl_undo_stack_t;
+
+#define DEFAULT_SIDL_UNDO_STACK_SIZE 100
+#define MAX_SIDL_UNDO_STACK_SIZE (UINT32_MAX/sizeof(sidl_undo_record_t))
+
+
+
+/******************
+ * PUSH/POP STACK *
+ *****************/
+
+/*
+ * For each base level, we keep the number of vertices and atoms
+ * on entry to that level.
+ */
+typedef struct sidl_trail_s {
+  uint32_t nvertices;
+  uint32_t natoms;
+} sidl_trail_t;
+
+typedef struct sidl_trail_stack_s {
+  uint32_t size;
+  uint32_t top;
+  sidl_trail_t *data;
+} sidl_trail_stack_t;
+
+#define DEFAULT_SIDL_TRAIL_SIZE  20
+#define MAX_SIDL_TRAIL_SIZE (UINT32_MAX/sizeof(sidl_trail_t))
+
+
+
+/****************
+ *  STATISTICS  *
+ ***************/
+
+typedef struct sidl_stats_s {
+  uint32_t num_conflicts;     // negative circuits found
+  uint32_t num_repairs;       // edges that required updating the assignment
+  uint32_t num_propagations;  // atoms implied by theory propagation
+  uint32_t num_bounded;       // searches stopped by the propagation bound
+} sidl_stats_t;
+
+
+
+/*******************
+ *  SPARSE SOLVER  *
+ ******************/
+
+typedef struct sidl_solver_s {
+  /*
+   * Attached smt core + gate manager
+   */
+  smt_core_t *core;
+  gate_manager_t *gate_manager;
+
+  /*
+   * Base level and decision level (same interpretation as in smt_core)
+   */
+  uint32_t base_level;
+  uint32_t decision_level;
+
+  /*
+   * Unsat flag: set to true if the asserted axioms are inconsistent
+   */
+  bool unsat_before_search;
+
+  /*
+   * Propagation bound: maximal number of edges scanned
+   * by each search. Propagation is disabled if this is 0.
+   */
+  uint32_t prop_bound;
+
+  /*
+   * Variable table: every variable is mapped to a
+   * difference logic triple (x - y + c)
+   */
+  dl_vartable_t vtbl;
+
+  /*
+   * Graph
+   */
+  int32_t zero_vertex; // index of zero vertex or null
+  sidl_graph_t graph;
+
+  /*
+   * Atom table and stack
+   */
+  sidl_atbl_t atoms;
+  sidl_astack_t astack;
+
+  /*
+   * Backtracking stack and push/pop stack
+   */
+  sidl_undo_stack_t stack;
+  sidl_trail_stack_t trail_stack;
+
+  /*
+   * Statistics
+   */
+  sidl_stats_t stats;
+
+  /*
+   * Auxiliary buffers and data structures
+   */
+  int_htbl_t htbl;        // for hash-consing of atoms
+  arena_t arena;          // for storing explanations of implied atoms
+  ivector_t expl_buffer;  // for constructing explanations
+  ivector_t aux_vector;   // general-purpose vector
+
+  dl_triple_t triple;     // for variable construction
+  poly_buffer_t buffer;   // for internal polynomial operations
+
+  /*
+   * Model: value[x] for every vertex x (allocated in build_model)
+   */
+  int64_t *value;
+
+  /*
+   * Jump buffer for exception handling during internalization
+   */
+  jmp_buf *env;
+} sidl_solver_t;
+
+
+/*
+ * Maximal number of vertices
+ */
+#define MAX_SIDL_VERTICES MAX_SIDL_GRAPH_SIZE
+
+#define DEFAULT_SIDL_BUFFER_SIZE 20
+
+
+
+/*********************
+ *  MAIN OPERATIONS  *
+ ********************/
+
+/*
+ * Initialize a solver
+ * - core = the attached smt-core object
+ * - gates = the attached gate manager
+ */
+extern void init_sidl_solver(sidl_solver_t *solver, smt_core_t *core, gate_manager_t *gates);
+
+
+/*
+ * Attach a jump buffer for internalization exception
+ */
+extern void sidl_solver_init_jmpbuf(sidl_solver_t *solver, jmp_buf *buffer);
+
+
+/*
+ * Delete: free all allocated memory
+ */
+extern void delete_sidl_solver(sidl_solver_t *solver);
+
+
+/*
+ * Set the propagation bound
+ */
+static inline void sidl_set_prop_bound(sidl_solver_t *solver, uint32_t bound) {
+  solver->prop_bound = bound;
+}
+
+
+/*
+ * Get interface descriptors to attach solver to a core
+ */
+extern th_ctrl_interface_t *sidl_ctrl_interface(sidl_solver_t *solver);
+extern th_smt_interface_t  *sidl_smt_interface(sidl_solver_t *solver);
+
+
+/*
+ * Get interface descriptor for the internalization functions.
+ */
+extern arith_interface_t *sidl_arith_interface(sidl_solver_t *solver);
+
+
+
+/******************************
+ *  VERTEX AND ATOM CREATION  *
+ *****************************/
+
+/*
+ * Create a new vertex
+ * - return null_sidl_vertex if there are too many vertices
+ */
+extern int32_t sidl_new_vertex(sidl_solver_t *solver);
+
+
+/*
+ * Return the zero_vertex (create it if needed)
+ * - return null_sidl_vertex if the vertex can't be created
+ */
+extern int32_t sidl_zero_vertex(sidl_solver_t *solver);
+
+
+/*
+ * Create the atom (x - y <= d) and return the corresponding literal
+ * - x and y must be vertices in the solver
+ */
+extern literal_t sidl_make_atom(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d);
+
+
+/*
+ * Assert (x - y <= d) as an axiom
+ * - x and y must be vertices in solver
+ * - the solver must be at base level
+ * - if the edge causes a conflict, then solver->unsat_before_search is set to true
+ */
+extern void sidl_add_axiom_edge(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d);
+
+
+/*
+ * Assert (x - y == d) as an axiom:
+ * - add edge x ---> y with cost d   (x - y <= d)
+ *   and edge y ---> x with cost -d  (y - x <= -d)
+ */
+extern void sidl_add_axiom_eq(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d);
+
+
+
+/*******************************
+ *  INTERNALIZATION FUNCTIONS  *
+ ******************************/
+
+/*
+ * These functions are used by the context to convert terms to
+ * variables and literals. They form the arith_interface descriptor.
+ * They behave like the functions of the Floyd-Warshall solver
+ * (see idl_floyd_warshall.h).
+ */
+extern thvar_t sidl_create_var(sidl_solver_t *solver, bool is_int);
+extern thvar_t sidl_create_const(sidl_solver_t *solver, rational_t *q);
+extern thvar_t sidl_create_poly(sidl_solver_t *solver, polynomial_t *p, thvar_t *map);
+extern thvar_t sidl_create_pprod(sidl_solver_t *solver, pprod_t *p, thvar_t *map);
+
+extern literal_t sidl_create_eq_atom(sidl_solver_t *solver, thvar_t x);
+extern literal_t sidl_create_ge_atom(sidl_solver_t *solver, thvar_t x);
+extern literal_t sidl_create_poly_eq_atom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map);
+extern literal_t sidl_create_poly_ge_atom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map);
+extern literal_t sidl_create_vareq_atom(sidl_solver_t *solver, thvar_t x, thvar_t y);
+
+extern void sidl_assert_eq_axiom(sidl_solver_t *solver, thvar_t x, bool tt);
+extern void sidl_assert_ge_axiom(sidl_solver_t *solver, thvar_t x, bool tt);
+extern void sidl_assert_poly_eq_axiom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map, bool tt);
+extern void sidl_assert_poly_ge_axiom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map, bool tt);
+extern void sidl_assert_vareq_axiom(sidl_solver_t *solver, thvar_t x, thvar_t y, bool tt);
+extern void sidl_assert_cond_vareq_axiom(sidl_solver_t *solver, literal_t c, thvar_t x, thvar_t y);
+extern void sidl_assert_clause_vareq_axiom(sidl_solver_t *solver, uint32_t n, literal_t *c, thvar_t x, thvar_t y);
+
+
+
+/**********************
+ *  SOLVER FUNCTIONS  *
+ *********************/
+
+/*
+ * These functions are used by the core. They form the th_ctrl and
+ * th_smt interfaces.
+ */
+extern void sidl_start_search(sidl_solver_t *solver);
+extern void sidl_increase_decision_level(sidl_solver_t *solver);
+extern void sidl_backtrack(sidl_solver_t *solver, uint32_t back_level);
+extern void sidl_push(sidl_solver_t *solver);
+extern void sidl_pop(sidl_solver_t *solver);
+extern void sidl_reset(sidl_solver_t *solver);
+
+
+/*
+ * Push an assertion into the queue
+ * - atom is the index of an atom with boolean variable v
+ * - l is either pos_lit(v) or neg_lit(v)
+ * - always return true (conflicts are detected in sidl_propagate)
+ */
+extern bool sidl_assert_atom(sidl_solver_t *solver, void *atom, literal_t l);
+
+
+/*
+ * Propagate: process the assertion queue
+ * - return false if a conflict is detected
+ * - return true otherwise.
+ */
+extern bool sidl_propagate(sidl_solver_t *solver);
+
+
+/*
+ * Theory-branching heuristic: evaluate the atom attached to l
+ * in the current assignment.
+ */
+extern literal_t sidl_select_polarity(sidl_solver_t *solver, void *atom, literal_t l);
+
+
+/*
+ * Final check: do nothing and return SAT
+ */
+extern fcheck_code_t sidl_final_check(sidl_solver_t *solver);
+
+
+/*
+ * Explain why literal l is true (l was propagated by the solver)
+ * - expl is the null-terminated array of literals given to propagate_literal
+ * - its elements are copied into v
+ */
+extern void sidl_expand_explanation(sidl_solver_t *solver, literal_t l, literal_t *expl, ivector_t *v);
+
+
+
+/************************
+ *  MODEL CONSTRUCTION  *
+ ***********************/
+
+/*
+ * Build a model: copy the current assignment, shifted so that
+ * the zero vertex has value 0.
+ */
+extern void sidl_build_model(sidl_solver_t *solver);
+
+
+/*
+ * Value of vertex x in the model
+ */
+static inline int64_t sidl_vertex_value(sidl_solver_t *solver, int32_t x) {
+  assert(solver->value != NULL && 0 <= x && x < solver->graph.nvertices);
+  return solver->value[x];
+}
+
+
+/*
+ * Value of variable v in the model
+ * - copy the value in rational q and return true
+ */
+extern bool sidl_value_in_model(sidl_solver_t *solver, thvar_t v, rational_t *q);
+
+
+/*
+ * Free the model
+ */
+extern void sidl_free_model(sidl_solver_t *solver);
+
+
+
+/*****************
+ *  STATISTICS   *
+ ****************/
+
+static inline uint32_t sidl_num_vars(sidl_solver_t *solver) {
+  return solver->vtbl.nvars;
+}
+
+static inline uint32_t sidl_num_atoms(sidl_solver_t *solver) {
+  return solver->atoms.natoms;
+}
+
+static inline uint32_t sidl_num_vertices(sidl_solver_t *solver) {
+  return solver->graph.nvertices;
+}
+
+static inline uint32_t sidl_num_edges(sidl_solver_t *solver) {
+  return solver->graph.edges.top - 1;
+}
+
+
+
+#endif /* __IDL_SPARSE_H */
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PRINTER FOR THE SPARSE IDL SOLVER
+ */
+
+#include <inttypes.h>
+
+#include "solvers/cdcl/smt_core_printer.h"
+#include "solvers/floyd_warshall/idl_fw_printer.h"
+#include "solvers/floyd_warshall/idl_sparse_printer.h"
+
+
+/*
+ * Vertices and triples are printed as in the Floyd-Warshall solver
+ */
+void print_sidl_atom(FILE *f, sidl_atom_t *atom) {
+  fputc('[', f);
+  print_bvar(f, atom->boolvar);
+  fputs(" := (", f);
+  print_idl_vertex(f, atom->source);
+  fputs(" - ", f);
+  print_idl_vertex(f, atom->target);
+  fprintf(f, " <= %"PRId32")]", atom->cost);
+}
+
+
+/*
+ * Print all atoms
+ */
+void print_sidl_atoms(FILE *f, sidl_solver_t *sidl) {
+  uint32_t i, n;
+
+  n = sidl->atoms.natoms;
+  for (i=0; i<n; i++) {
+    print_sidl_atom(f, sidl->atoms.atoms + i);
+    fputc('\n', f);
+  }
+}
+
+
+/*
+ * Print the full variable table
+ */
+void print_sidl_var_table(FILE *f, sidl_solver_t *sidl) {
+  uint32_t i, n;
+
+  n = sidl->vtbl.nvars;
+  for (i=0; i<n; i++) {
+    print_idl_var_name(f, i);
+    fputs(" := ", f);
+    print_idl_triple(f, dl_var_triple(&sidl->vtbl, i));
+    fputc('\n', f);
+  }
+}
+
+
+/*
+ * Print edge i
+ */
+static void print_sidl_edge(FILE *f, sidl_solver_t *sidl, uint32_t i) {
+  sidl_edge_t *e;
+
+  assert(0 < i && i < sidl->graph.edges.top);
+  e = sidl->graph.edges.data + i;
+  fprintf(f, "edge[%"PRIu32"]: ", i);
+  print_idl_vertex(f, e->source);
+  fputs(" - ", f);
+  print_idl_vertex(f, e->target);
+  fprintf(f, " <= %"PRId32, e->cost);
+}
+
+
+/*
+ * Print all edges
+ */
+void print_sidl_edges(FILE *f, sidl_solver_t *sidl) {
+  uint32_t i, n;
+
+  n = sidl->graph.edges.top;
+  for (i=1; i<n; i++) {
+    print_sidl_edge(f, sidl, i);
+    fputc('\n', f);
+  }
+}
+
+
+/*
+ * All axioms: edges labeled with true_literal
+ */
+void print_sidl_axioms(FILE *f, sidl_solver_t *sidl) {
+  uint32_t i, n;
+
+  n = sidl->graph.edges.top;
+  for (i=1; i<n; i++) {
+    if (sidl->graph.edges.lit[i] == true_literal) {
+      print_sidl_edge(f, sidl, i);
+      fputc('\n', f);
+    }
+  }
+}
+
+
+/*
+ * Current assignment
+ */
+void print_sidl_assignment(FILE *f, sidl_solver_t *sidl) {
+  uint32_t i, n;
+
+  n = sidl->graph.nvertices;
+  for (i=0; i<n; i++) {
+    fputs("val[", f);
+    print_idl_vertex(f, i);
+    fprintf(f, "] = %"PRId64"\n", sidl->graph.val[i]);
+  }
+}
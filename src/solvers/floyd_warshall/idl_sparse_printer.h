@@ -0,0 +1,60 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PRINTER FOR THE SPARSE IDL SOLVER
+ */
+
+#ifndef __IDL_SPARSE_PRINTER_H
+#define __IDL_SPARSE_PRINTER_H
+
+#include <stdio.h>
+
+#include "solvers/floyd_warshall/idl_sparse.h"
+
+
+/*
+ * Atom: in format [<bool var> := (x - y <= d)]
+ * - x and y are vertices
+ */
+extern void print_sidl_atom(FILE *f, sidl_atom_t *atom);
+extern void print_sidl_atoms(FILE *f, sidl_solver_t *sidl);
+
+
+/*
+ * Variable triples: in the format u := (x - y + d)
+ * - x and y are vertices
+ * - u is a theory variable
+ */
+extern void print_sidl_var_table(FILE *f, sidl_solver_t *sidl);
+
+
+/*
+ * Edges: in the format edge[i]: x - y <= d
+ */
+extern void print_sidl_axioms(FILE *f, sidl_solver_t *sidl);
+extern void print_sidl_edges(FILE *f, sidl_solver_t *sidl);
+
+
+/*
+ * Current assignment: one line per vertex
+ */
+extern void print_sidl_assignment(FILE *f, sidl_solver_t *sidl);
+
+
+#endif /* __IDL_SPARSE_PRINTER_H */
@@ -544,10 +544,14 @@ static void init_rdl_graph(rdl_graph_t *graph) {
   init_rdl_matrix(&graph->matrix);
   init_rdl_edge_stack(&graph->edges, DEFAULT_RDL_EDGE_STACK_SIZE);
   init_rdl_cell_stack(&graph->cstack, DEFAULT_RDL_CELL_STACK_SIZE);
+  init_rdl_cell_stack(&graph->changed, DEFAULT_RDL_CELL_STACK_SIZE);
   init_ivector(&graph->buffer, DEFAULT_RDL_BUFFER_SIZE);
   init_rdl_const(&graph->c0);
 
   push_edge(&graph->edges, null_rdl_vertex, null_rdl_vertex, true_literal);
+  graph->cmark = graph->edges.top;
+  graph->wdim = 0;
+  graph->watch = NULL;
 }
 
 /*
@@ -555,6 +559,9 @@ static void init_rdl_graph(rdl_graph_t *graph) {
  */
 static void delete_rdl_graph(rdl_graph_t *graph) {
   delete_rdl_cell_stack(&graph->cstack);
+  delete_rdl_cell_stack(&graph->changed);
+  safe_free(graph->watch);
+  graph->watch = NULL;
   delete_rdl_edge_stack(&graph->edges);
   delete_rdl_matrix(&graph->matrix);
   delete_ivector(&graph->buffer);
@@ -568,10 +575,15 @@ static void reset_rdl_graph(rdl_graph_t *graph) {
   reset_rdl_matrix(&graph->matrix);
   reset_rdl_edge_stack(&graph->edges);
   reset_rdl_cell_stack(&graph->cstack);
+  reset_rdl_cell_stack(&graph->changed);
   ivector_reset(&graph->buffer);
   reset_rdl_const(&graph->c0);
 
   push_edge(&graph->edges, null_rdl_vertex, null_rdl_vertex, true_literal);
+  graph->cmark = graph->edges.top;
+  safe_free(graph->watch);
+  graph->wdim = 0;
+  graph->watch = NULL;
 }
 
 
@@ -604,6 +616,75 @@ static inline void rdl_graph_save_cell(rdl_graph_t *graph, rdl_cell_t *r) {
 }
 
 
+/*
+ * Attach index k to cell M[x, y]
+ * - if needed, the watch matrix is made larger
+ */
+static void rdl_graph_set_watch(rdl_graph_t *graph, int32_t x, int32_t y, int32_t k) {
+  uint64_t new_size;
+  int32_t *w;
+  uint32_t i, j, d, n;
+
+  assert(0 <= x && x < MAX_RDL_MATRIX_DIMENSION && 0 <= y && y < MAX_RDL_MATRIX_DIMENSION);
+
+  d = graph->wdim;
+  if (x >= d || y >= d) {
+    n = d + (d >> 1) + 1;
+    if (n <= x) n = x + 1;
+    if (n <= y) n = y + 1;
+    if (n > MAX_RDL_MATRIX_DIMENSION) n = MAX_RDL_MATRIX_DIMENSION;
+
+    new_size = ((uint64_t) n * n) * sizeof(int32_t);
+    if (new_size >= SIZE_MAX) {
+      out_of_memory();
+    }
+    w = (int32_t *) safe_malloc(new_size);
+    for (i=0; i<n; i++) {
+      for (j=0; j<n; j++) {
+        w[i * n + j] = (i < d && j < d) ? graph->watch[i * d + j] : -1;
+      }
+    }
+    safe_free(graph->watch);
+    graph->watch = w;
+    graph->wdim = n;
+    d = n;
+  }
+
+  graph->watch[x * d + y] = k;
+}
+
+
+/*
+ * Index attached to cell M[x, y] or -1 if the cell is not watched
+ */
+static inline int32_t rdl_graph_get_watch(rdl_graph_t *graph, int32_t x, int32_t y) {
+  return (x < graph->wdim && y < graph->wdim) ? graph->watch[x * graph->wdim + y] : -1;
+}
+
+
+/*
+ * Record that cell r = M[x, y] is about to be modified
+ * - if the cell is watched, it is pushed into the changed stack with index
+ *   (x << 16 | y) unless it's been modified since the last call to
+ *   rdl_graph_clear_changes.
+ */
+static inline void rdl_graph_record_change(rdl_graph_t *graph, int32_t x, int32_t y, rdl_cell_t *r) {
+  assert(0 <= x && x <= MAX_RDL_MATRIX_DIMENSION && 0 <= y && y <= MAX_RDL_MATRIX_DIMENSION);
+  if (r->id < graph->cmark && rdl_graph_get_watch(graph, x, y) >= 0) {
+    save_cell(&graph->changed, ((uint32_t) x << 16) | (uint32_t) y, r);
+  }
+}
+
+
+/*
+ * Empty the changed stack
+ */
+static void rdl_graph_clear_changes(rdl_graph_t *graph) {
+  reset_rdl_cell_stack(&graph->changed);
+  graph->cmark = graph->edges.top;
+}
+
+
 /*
  * Auxiliary function: check whether c + r->dist < s->dist
  * - use d as a buffer
@@ -620,6 +701,7 @@ static bool dist_reduced(rdl_cell_t *r, rdl_cell_t *s, rdl_const_t *c, rdl_const
 /*
  * Add new edge to the graph and update the matrix
  * Save any modified cell onto the saved-cell stack
+ * and record it in the changed stack
  * - x = source vertex
  * - y = target vertex
  * - c = cost
@@ -696,6 +778,7 @@ static void rdl_graph_add_edge(rdl_graph_t *graph, int32_t x, int32_t y, rdl_con
             if (r[z].id < k) {
               rdl_graph_save_cell(graph, r + z);
             }
+            rdl_graph_record_change(graph, w, z, r + z);
             r[z].id = id;
             rdl_const_set(&r[z].dist, d);
           }
@@ -711,6 +794,7 @@ static void rdl_graph_add_edge(rdl_graph_t *graph, int32_t x, int32_t y, rdl_con
  * Backtrack: remove edges and restore the matrix
  * - e = first edge to remove (edges of index i ... top-1) are removed
  * - c = pointer into the saved cell stack
+ * - the changed stack is emptied
  */
 static void rdl_graph_remove_edges(rdl_graph_t *graph, int32_t e, uint32_t c) {
   rdl_saved_cell_t *saved;
@@ -732,6 +816,8 @@ static void rdl_graph_remove_edges(rdl_graph_t *graph, int32_t e, uint32_t c) {
     rdl_const_set(&m[k].dist, &saved[i].saved.dist);
   }
   graph->cstack.top = c;
+
+  rdl_graph_clear_changes(graph);
 }
 
 
@@ -1414,6 +1500,126 @@ int32_t rdl_zero_vertex(rdl_solver_t *solver) {
 
 
 
+/****************
+ *  ATOM INDEX  *
+ ***************/
+
+/*
+ * Initialize the index: n = initial size of the list array
+ */
+static void init_rdl_atom_index(rdl_atom_index_t *index, uint32_t n) {
+  uint32_t i;
+
+  if (n >= MAX_RDL_ATOM_INDEX_SIZE) {
+    out_of_memory();
+  }
+
+  index->list = (ivector_t *) safe_malloc(n * sizeof(ivector_t));
+  for (i=0; i<n; i++) {
+    init_ivector(index->list + i, 0);
+  }
+  index->nlists = 0;
+  index->size = n;
+}
+
+
+/*
+ * Make the list array 50% larger
+ */
+static void extend_rdl_atom_index(rdl_atom_index_t *index) {
+  uint32_t i, n;
+
+  n = index->size + 1;
+  n += n >> 1;
+  if (n >= MAX_RDL_ATOM_INDEX_SIZE) {
+    out_of_memory();
+  }
+
+  index->list = (ivector_t *) safe_realloc(index->list, n * sizeof(ivector_t));
+  for (i=index->size; i<n; i++) {
+    init_ivector(index->list + i, 0);
+  }
+  index->size = n;
+}
+
+
+/*
+ * Empty the index
+ */
+static void reset_rdl_atom_index(rdl_atom_index_t *index) {
+  uint32_t i;
+
+  for (i=0; i<index->nlists; i++) {
+    ivector_reset(index->list + i);
+  }
+  index->nlists = 0;
+}
+
+
+/*
+ * Delete the index
+ */
+static void delete_rdl_atom_index(rdl_atom_index_t *index) {
+  uint32_t i;
+
+  for (i=0; i<index->size; i++) {
+    delete_ivector(index->list + i);
+  }
+  safe_free(index->list);
+  index->list = NULL;
+}
+
+
+/*
+ * List of atoms (x - y <= c) or NULL if there's no atom on x and y
+ */
+static ivector_t *rdl_atom_list(rdl_solver_t *solver, int32_t x, int32_t y) {
+  int32_t k;
+
+  k = rdl_graph_get_watch(&solver->graph, x, y);
+  return (k < 0) ? NULL : solver->aindex.list + 2 * k + (x > y);
+}
+
+
+/*
+ * Add atom i to the index
+ * - if the atom is the first one on x and y, allocate two lists
+ *   for the pair and watch cells M[x, y] and M[y, x]
+ * - the atom is inserted before the first atom of larger cost
+ */
+static void rdl_index_atom(rdl_solver_t *solver, int32_t i) {
+  rdl_atom_index_t *index;
+  rdl_atom_t *a;
+  ivector_t *v;
+  int32_t k;
+  uint32_t j;
+
+  index = &solver->aindex;
+  a = get_rdl_atom(&solver->atoms, i);
+  k = rdl_graph_get_watch(&solver->graph, a->source, a->target);
+  if (k < 0) {
+    if (index->nlists + 2 > index->size) {
+      extend_rdl_atom_index(index);
+    }
+    assert(index->nlists + 2 <= index->size);
+    k = index->nlists >> 1;
+    index->nlists += 2;
+    rdl_graph_set_watch(&solver->graph, a->source, a->target, k);
+    rdl_graph_set_watch(&solver->graph, a->target, a->source, k);
+  }
+
+  v = index->list + 2 * k + (a->source > a->target);
+  ivector_push(v, i);
+  j = v->size - 1;
+  while (j > 0 && q_lt(&a->cost, &get_rdl_atom(&solver->atoms, v->data[j-1])->cost)) {
+    v->data[j] = v->data[j-1];
+    j --;
+  }
+  v->data[j] = i;
+}
+
+
+
 /***************************
  *  HASH-CONSING OF ATOMS  *
  **************************/
@@ -1470,7 +1676,7 @@ static rdlatom_hobj_t atom_hobj = {
 /*
  * Atom constructor: use hash consing
  * - if the atom is new, create a fresh boolean variable v
- *   and the atom index to v in the core
+ *   and the atom index to v in the core, and add the atom to the index
  */
 static bvar_t bvar_for_atom(rdl_solver_t *solver, int32_t x, int32_t y, rational_t *d) {
   int32_t id;
@@ -1488,6 +1694,7 @@ static bvar_t bvar_for_atom(rdl_solver_t *solver, int32_t x, int32_t y, rational
     v = create_boolean_variable(solver->core);
     atm->boolvar = v;
     attach_atom_to_bvar(solver->core, v, rdl_index2atom(id));
+    rdl_index_atom(solver, id);
   }
   return v;
 }
@@ -1763,19 +1970,177 @@ static void check_atom_for_propagation(rdl_solver_t *solver, int32_t i) {
 
 
 /*
- * Scan all unassigned atoms and check propagation
+ * Compare distance d with the cost c of atom i
+ * - if neg is false: check whether d <= c
+ *   (i.e., atom (x - y <= c) is implied if d is the distance from x to y)
+ * - if neg is true: check whether -c <= d
+ *   (i.e., atom (y - x <= c) is not refuted if d is the distance from x to y)
+ * Both predicates are monotonic in c.
+ * Side effect: modify solver->c1
+ */
+static bool rdl_atom_beyond(rdl_solver_t *solver, int32_t i, rdl_const_t *d, bool neg) {
+  rdl_const_t *c;
+
+  c = &solver->c1;
+  rdl_const_set_rational(c, &get_rdl_atom(&solver->atoms, i)->cost);
+  if (neg) {
+    rdl_const_negate(c);
+    return rdl_const_le(c, d);
+  }
+  return rdl_const_le(d, c);
+}
+
+
+/*
+ * Binary search in list v (sorted by increasing cost)
+ * - return the first position k in v such that rdl_atom_beyond(v[k], d, neg)
+ *   is true (or v->size if there's no such atom)
+ */
+static uint32_t rdl_atom_list_search(rdl_solver_t *solver, ivector_t *v, rdl_const_t *d, bool neg) {
+  uint32_t l, h, k;
+
+  l = 0;
+  h = v->size;
+  while (l < h) {
+    k = (l + h) >> 1;
+    if (rdl_atom_beyond(solver, v->data[k], d, neg)) {
+      h = k;
+    } else {
+      l = k+1;
+    }
+  }
+  return l;
+}
+
+
+/*
+ * Check the unassigned atoms v[k], v[k+1], ... for propagation
+ * - if d is NULL, scan v to the end
+ * - otherwise, stop at the first atom i such that rdl_atom_beyond(i, d, neg) is true
+ */
+static void check_atom_list_for_propagation(rdl_solver_t *solver, ivector_t *v, uint32_t k, rdl_const_t *d, bool neg) {
+  rdl_atbl_t *tbl;
+  int32_t i;
+
+  tbl = &solver->atoms;
+  while (k < v->size) {
+    i = v->data[k];
+    if (d != NULL && rdl_atom_beyond(solver, i, d, neg)) break;
+    if (! rdl_atom_is_assigned(tbl, i)) {
+      check_atom_for_propagation(solver, i);
+    }
+    k ++;
+  }
+}
+
+
+/*
+ * Check the atoms that may be implied because the distance from x to y
+ * was reduced: old = content of cell M[x, y] before it was modified.
+ * - let D be the new distance from x to y and D' be the old distance
+ *   (D' = +infinity if there was no path from x to y)
+ * - atoms (x - y <= c) with D <= c < D' are now true
+ * - atoms (y - x <= c) with -D' <= c < -D are now false
+ * The atoms are found by binary search in the sorted lists of the index.
+ */
+static void check_changed_cell_for_propagation(rdl_solver_t *solver, int32_t x, int32_t y, rdl_cell_t *old) {
+  rdl_cell_t *cell;
+  rdl_const_t *d, *d_old;
+  ivector_t *v;
+  uint32_t k;
+
+  cell = rdl_cell(&solver->graph.matrix, x, y);
+  if (cell->id < 0 || (old->id >= 0 && rdl_const_le(&old->dist, &cell->dist))) return;
+  d = &cell->dist;
+  d_old = (old->id >= 0) ? &old->dist : NULL;
+
+  v = rdl_atom_list(solver, x, y);
+  if (v != NULL) {
+    k = rdl_atom_list_search(solver, v, d, false);
+    check_atom_list_for_propagation(solver, v, k, d_old, false);
+  }
+
+  v = rdl_atom_list(solver, y, x);
+  if (v != NULL) {
+    k = 0;
+    if (d_old != NULL) {
+      k = rdl_atom_list_search(solver, v, d_old, true);
+    }
+    check_atom_list_for_propagation(solver, v, k, d, true);
+  }
+}
+
+
+#ifndef NDEBUG
+
+/*
+ * For debugging: check that no unassigned atom is implied by the graph
+ */
+static bool all_implied_atoms_assigned(rdl_solver_t *solver) {
+  rdl_atbl_t *tbl;
+  rdl_atom_t *a;
+  rdl_cell_t *cell;
+  int32_t i;
+
+  tbl = &solver->atoms;
+  for (i=first_unassigned_atom(tbl); i >= 0; i = next_unassigned_atom(tbl, i)) {
+    a = get_rdl_atom(tbl, i);
+    cell = rdl_cell(&solver->graph.matrix, a->source, a->target);
+    if (cell->id >= 0 && rdl_atom_beyond(solver, i, &cell->dist, false)) return false;
+    cell = rdl_cell(&solver->graph.matrix, a->target, a->source);
+    if (cell->id >= 0 && ! rdl_atom_beyond(solver, i, &cell->dist, true)) return false;
+  }
+
+  return true;
+}
+
+#endif
+
+
+/*
+ * Check propagation for all unassigned atoms that may be implied
  * - must be called after all atoms in the queue have been processed
+ * - new atoms (of index >= prop_atoms) are all checked
+ * - other atoms are checked only if the distance between their vertices
+ *   was reduced: we use the changed cells and the atom index for this
  */
 static void rdl_atom_propagation(rdl_solver_t *solver) {
   rdl_atbl_t *tbl;
-  int32_t i;
+  rdl_cell_stack_t *changed;
+  rdl_saved_cell_t *c;
+  uint32_t i, n;
 
   assert(solver->astack.top == solver->astack.prop_ptr);
 
   tbl = &solver->atoms;
-  for (i=first_unassigned_atom(tbl); i >= 0; i = next_unassigned_atom(tbl, i)) {
-    check_atom_for_propagation(solver, i);
+  changed = &solver->graph.changed;
+  n = tbl->natoms;
+
+  if (changed->top >= n - solver->astack.top) {
+    /*
+     * more changed cells than unassigned atoms: it's cheaper
+     * to check all the atoms.
+     */
+    for (i=0; i<n; i++) {
+      if (! rdl_atom_is_assigned(tbl, i)) {
+        check_atom_for_propagation(solver, i);
+      }
+    }
+  } else {
+    for (i=solver->prop_atoms; i<n; i++) {
+      if (! rdl_atom_is_assigned(tbl, i)) {
+        check_atom_for_propagation(solver, i);
+      }
+    }
+    c = changed->data;
+    for (i=0; i<changed->top; i++) {
+      check_changed_cell_for_propagation(solver, c[i].index >> 16, c[i].index & 0xFFFF, &c[i].saved);
+    }
   }
+  solver->prop_atoms = n;
+  rdl_graph_clear_changes(&solver->graph);
+
+  assert(all_implied_atoms_assigned(solver));
 
   // update prop_ptr to skip all implied atoms in the next
   // call to rdl_propagate.
@@ -2062,6 +2427,8 @@ void rdl_reset(rdl_solver_t *solver) {
 
   reset_rdl_atbl(&solver->atoms);
   reset_rdl_astack(&solver->astack);
+  reset_rdl_atom_index(&solver->aindex);
+  solver->prop_atoms = 0;
   reset_rdl_undo_stack(&solver->stack);
   reset_rdl_trail_stack(&solver->trail_stack);
 
@@ -2080,7 +2447,6 @@ void rdl_reset(rdl_solver_t *solver) {
   q_clear(&solver->epsilon);
   q_clear(&solver->factor);
   q_clear(&solver->aux);
-  q_clear(&solver->aux2);
 
   if (solver->value != NULL) {
     free_rational_array(solver->value, solver->nvertices);
@@ -2718,131 +3084,46 @@ void rdl_assert_clause_vareq_axiom(rdl_solver_t *solver, uint32_t n, literal_t *
  ***********************/
 
 /*
- * Compute a safe rational value for delta.
- *
- * This assumes the system is feasible, i.e., there is no negative
- * circuit in the graph.
+ * The model is first built in symbolic form: each vertex x is assigned
+ * a value sval[x] = a + k delta such that sval[x] - sval[y] <= d[x, y]
+ * for every pair (x, y) with a path from x to y (in the extended
+ * rationals). Then we compute a positive rational epsilon such that these
+ * inequalities still hold when delta is replaced by epsilon.
  *
- * For any circuit x --> y ---> x
- *    d[x, y] = a + b delta
- *    d[y, x] = a' + b' delta
- * So d[x, y] + d[y, x] >= 0 over the extended rationals, means
- * either (a + a') > 0 or (a + a') = 0 and (b + b') > 0.
+ * For a pair (x, y), let sval[x] - sval[y] = a + b delta
+ * and d[x, y] = a' + b' delta. We have a + b delta <= a' + b' delta so
+ * either a < a' or (a = a' and b <= b'). If b > b' we must
+ * take epsilon <= (a' - a)/(b - b'). Otherwise any epsilon > 0 works.
  *
- * We want to find a positive rational epsilon for which the inequality
- * d[x, y] + d[y, x] >= 0 holds in the rationals. If (b + b') < 0, we must
- * take  epsilon <= - (a + a')/(b + b'). If (b + b') >= 0, any epsilon > 0 works.
- */
-
-/*
- * Assign epsilon := min(epsilon, - (a+a')/(b + b')) for the two vertices x, y
- * - x and y must be distinct and there must be a path from x to y
- */
-static void rdl_adjust_epsilon(rdl_solver_t *solver, int32_t x, int32_t y) {
-  rdl_cell_t *cell_xy, *cell_yx;
-  rational_t *aux, *factor;
-  int32_t b;
-
-  assert(x != y);
-  cell_xy = rdl_cell(&solver->graph.matrix, x, y);
-  cell_yx = rdl_cell(&solver->graph.matrix, y, x);
-  assert(cell_xy->id > 0);
-  if (cell_yx->id > 0) {
-    // a circuit x --> y --> x exists
-    b = cell_xy->dist.delta + cell_yx->dist.delta; // (b + b')
-    if (b < 0) {
-      aux = &solver->aux;
-      q_set(aux, &cell_xy->dist.q);
-      q_add(aux, &cell_yx->dist.q); // (a + a')
-      assert(q_is_pos(aux));
-      factor = &solver->factor;
-      q_set32(factor, -b);
-      q_div(aux, factor);  // aux := - (a+a')/(b+b');
-      if (q_lt(aux, &solver->epsilon)) {
-        q_set(&solver->epsilon, aux);
-      }
-    }
-  }
-}
-
-static void rdl_compute_model_epsilon(rdl_solver_t *solver) {
-  rdl_edge_t *edges;
-  uint32_t i, n;
-
-  q_set_one(&solver->epsilon); // any positive value as default
-
-  // scan all the edges in the graph
-  edges = solver->graph.edges.data;
-  n = solver->graph.edges.top; // number of edges
-  for (i=1; i<n; i++) {  // skip edge 0 = marker
-    rdl_adjust_epsilon(solver, edges[i].source, edges[i].target);
-  }
-}
-
-
-/*
- * Add a rational distance (computed using solver->epsilon) to rational v
- * - c = distance in symbolic form (a + k delta)
+ * NOTE: computing epsilon from the circuits x --> y --> x (i.e., so that
+ * d[x, y] + d[y, x] >= 0 holds in the rationals) is not enough: the
+ * rational values computed from d[x, y] may then violate the triangle
+ * inequalities.
  */
-static void rdl_add_rational_distance(rdl_solver_t *solver, rational_t *v, rdl_const_t *c) {
-  rational_t *factor;
-
-  factor = &solver->factor;
-  assert(v != factor);
-  q_add(v, &c->q);
-  if (c->delta != 0) {
-    q_set32(factor, c->delta);
-    q_addmul(v, factor, &solver->epsilon);
-  }
-}
-
-/*
- * Subtract a rational distance (computed using solver->epsilon) from rational v
- * - c = distance in symbolic form (a + k delta)
- */
-static void rdl_sub_rational_distance(rdl_solver_t *solver, rational_t *v, rdl_const_t *c) {
-  rational_t *factor;
-
-  factor = &solver->factor;
-  assert(v != factor);
-  q_sub(v, &c->q);
-  if (c->delta != 0) {
-    q_set32(factor, c->delta);
-    q_submul(v, factor, &solver->epsilon);
-  }
-}
-
 
 /*
  * Assign value v to vertex x, then extend the model to predecessors of x
  * that are not marked. If y is not marked and there's a path from y to x,
- *  val[y] is set to v + d[x, y] (as computed using solver->epsilon).
+ * sval[y] is set to v + d[y, x].
  */
-static void rdl_set_reference_point(rdl_solver_t *solver, int32_t x, rational_t *v, byte_t *mark) {
+static void rdl_set_reference_point(rdl_solver_t *solver, int32_t x, rdl_const_t *v, rdl_const_t *sval, byte_t *mark) {
   rdl_matrix_t *m;
   rdl_cell_t *cell;
-  rational_t *val, *aux;
   int32_t y, n;
 
-  assert(solver->value != NULL && 0 <= x && x < solver->nvertices && ! tst_bit(mark, x));
+  assert(0 <= x && x < solver->nvertices && ! tst_bit(mark, x));
 
-  val = solver->value;
-  aux = &solver->aux2;
   m = &solver->graph.matrix;
 
-  assert(aux != v);
-
-  q_set(val + x, v);
+  rdl_const_set(sval + x, v);
   set_bit(mark, x);
 
   n = solver->nvertices;
   for (y=0; y<n; y++) {
     cell = rdl_cell(m, y, x);
     if (cell->id > 0 && ! tst_bit(mark, y)) {
-      q_set(aux, v);
-      rdl_add_rational_distance(solver, aux, &cell->dist);
-      // store that as value of y
-      q_set(val + y, aux);
+      rdl_const_set(sval + y, v);
+      rdl_const_add(sval + y, &cell->dist);
       set_bit(mark, y);
     }
   }
@@ -2852,33 +3133,71 @@ static void rdl_set_reference_point(rdl_solver_t *solver, int32_t x, rational_t
 /*
  * Compute a value for vertex x in a new strongly connected component.
  * - there's no path from x to any of the already marked vertices
- * - we can set val[x] to anything larger than val[y] - d[y, x] where y is marked
- *   and is a predecessor of x
+ * - we can set sval[x] to anything larger than sval[y] - d[y, x] where y
+ *   is marked and is a predecessor of x
+ * - aux = buffer
  */
-static void rdl_get_value_for_new_vertex(rdl_solver_t *solver, int32_t x, rational_t *v, byte_t *mark) {
+static void rdl_get_value_for_new_vertex(rdl_solver_t *solver, int32_t x, rdl_const_t *v, rdl_const_t *aux,
+                                         rdl_const_t *sval, byte_t *mark) {
   rdl_matrix_t *m;
   rdl_cell_t *cell;
-  rational_t *val, *aux;
   int32_t y, n;
 
-  val = solver->value;
-  aux = &solver->aux2;
   m = &solver->graph.matrix;
   n = solver->nvertices;
 
   assert(aux != v);
 
-  q_clear(v); // set default to 0
+  reset_rdl_const(v); // set default to 0
 
   // scan predecessors and increase v if needed
   for (y=0; y<n; y++) {
     cell = rdl_cell(m, y, x);
     if (cell->id > 0 && tst_bit(mark, y)) {
-      q_set(aux, val + y);
-      rdl_sub_rational_distance(solver, aux, &cell->dist);
-      // aux is val[y] - dist[y, x]
-      if (q_gt(aux, v)) {
-        q_set(v, aux);
+      rdl_const_set(aux, sval + y);
+      rdl_const_sub(aux, &cell->dist);
+      // aux is sval[y] - dist[y, x]
+      if (rdl_const_lt(v, aux)) {
+        rdl_const_set(v, aux);
+      }
+    }
+  }
+}
+
+
+/*
+ * Compute a safe value for delta given the symbolic model sval
+ * - the result is stored in solver->epsilon
+ */
+static void rdl_compute_model_epsilon(rdl_solver_t *solver, rdl_const_t *sval) {
+  rdl_matrix_t *m;
+  rdl_cell_t *cell;
+  rational_t *aux, *factor;
+  uint32_t n;
+  int32_t x, y, b;
+
+  q_set_one(&solver->epsilon); // any positive value as default
+
+  m = &solver->graph.matrix;
+  aux = &solver->aux;
+  factor = &solver->factor;
+  n = solver->nvertices;
+  for (x=0; x<n; x++) {
+    for (y=0; y<n; y++) {
+      cell = rdl_cell(m, x, y);
+      if (cell->id > 0) {
+        b = sval[x].delta - sval[y].delta - cell->dist.delta; // (b - b')
+        if (b > 0) {
+          q_set(aux, &cell->dist.q);
+          q_sub(aux, &sval[x].q);
+          q_add(aux, &sval[y].q); // (a' - a)
+          assert(q_is_pos(aux));
+          q_set32(factor, b);
+          q_div(aux, factor);  // aux := (a' - a)/(b - b')
+          if (q_lt(aux, &solver->epsilon)) {
+            q_set(&solver->epsilon, aux);
+          }
+        }
       }
     }
   }
@@ -2949,37 +3268,56 @@ static bool good_rdl_model(rdl_solver_t *solver) {
  */
 void rdl_build_model(rdl_solver_t *solver) {
   byte_t *mark;
-  uint32_t nvars;
-  rational_t *aux;
+  rdl_const_t *sval;
+  rdl_const_t v, aux;
+  rational_t *factor;
+  uint32_t i, nvars;
   int32_t x;
 
   assert(solver->value == NULL);
 
-  rdl_compute_model_epsilon(solver);
-  assert(q_is_pos(&solver->epsilon));
-
   nvars = solver->nvertices;
-  solver->value = new_rational_array(nvars);
+  sval = (rdl_const_t *) safe_malloc(nvars * sizeof(rdl_const_t));
+  for (i=0; i<nvars; i++) {
+    init_rdl_const(sval + i);
+  }
   mark = allocate_bitvector0(nvars);
-  aux = &solver->aux;
+  init_rdl_const(&v);
+  init_rdl_const(&aux);
 
   // make sure the zero vertex has value 0
   x = solver->zero_vertex;
   if (x >= 0) {
-    q_clear(aux);
-    rdl_set_reference_point(solver, x, aux, mark);
+    rdl_set_reference_point(solver, x, &v, sval, mark);
   }
 
   // extend the model
   for (x=0; x<nvars; x++) {
     if (! tst_bit(mark, x)) {
-      rdl_get_value_for_new_vertex(solver, x, aux, mark);
-      rdl_set_reference_point(solver, x, aux, mark);
+      rdl_get_value_for_new_vertex(solver, x, &v, &aux, sval, mark);
+      rdl_set_reference_point(solver, x, &v, sval, mark);
     }
   }
 
+  // convert to rationals
+  rdl_compute_model_epsilon(solver, sval);
+  assert(q_is_pos(&solver->epsilon));
+
+  solver->value = new_rational_array(nvars);
+  factor = &solver->factor;
+  for (i=0; i<nvars; i++) {
+    q_set(solver->value + i, &sval[i].q);
+    if (sval[i].delta != 0) {
+      q_set32(factor, sval[i].delta);
+      q_addmul(solver->value + i, factor, &solver->epsilon);
+    }
+    clear_rdl_const(sval + i);
+  }
 
+  clear_rdl_const(&v);
+  clear_rdl_const(&aux);
   delete_bitvector(mark);
+  safe_free(sval);
 
   assert(good_rdl_model(solver));
 }
@@ -3130,6 +3468,8 @@ void init_rdl_solver(rdl_solver_t *solver, smt_core_t *core, gate_manager_t *gat
 
   init_rdl_atbl(&solver->atoms, DEFAULT_RDL_ATBL_SIZE);
   init_rdl_astack(&solver->astack, DEFAULT_RDL_ASTACK_SIZE);
+  init_rdl_atom_index(&solver->aindex, DEFAULT_RDL_ATOM_INDEX_SIZE);
+  solver->prop_atoms = 0;
   init_rdl_undo_stack(&solver->stack, DEFAULT_RDL_UNDO_STACK_SIZE);
   init_rdl_trail_stack(&solver->trail_stack);
 
@@ -3150,7 +3490,6 @@ void init_rdl_solver(rdl_solver_t *solver, smt_core_t *core, gate_manager_t *gat
   q_init(&solver->epsilon);
   q_init(&solver->factor);
   q_init(&solver->aux);
-  q_init(&solver->aux2);
   solver->value = NULL;
 
   // No jump buffer yet
@@ -3171,6 +3510,7 @@ void delete_rdl_solver(rdl_solver_t *solver) {
   delete_rdl_graph(&solver->graph);
   delete_rdl_atbl(&solver->atoms);
   delete_rdl_astack(&solver->astack);
+  delete_rdl_atom_index(&solver->aindex);
   delete_rdl_undo_stack(&solver->stack);
   delete_rdl_trail_stack(&solver->trail_stack);
 
@@ -3187,7 +3527,6 @@ void delete_rdl_solver(rdl_solver_t *solver) {
   q_clear(&solver->epsilon);
   q_clear(&solver->factor);
   q_clear(&solver->aux);
-  q_clear(&solver->aux2);
 
   if (solver->value != NULL) {
     free_rational_array(solver->value, solver->nvertices);
@@ -209,11 +209,25 @@ typedef struct rdl_cell_stack_s {
 
 /*
  * Graph
+ * - changed = cells modified since the last call to theory propagation
+ *   (cf. rdl_graph_add_edge). This uses the same stack type as cstack but
+ *   the index of cell M[x, y] is (x << 16 | y) so that it does not depend
+ *   on the matrix dimension.
+ * - cmark = number of edges when changed was last emptied: a cell is pushed
+ *   into changed only if its edge id is less than cmark (so it's recorded once).
+ * - only the watched cells are recorded: watch is a matrix of dimension wdim
+ *   that attaches an index to some cells. If watch[x * wdim + y] is -1,
+ *   then M[x, y] is not watched. Otherwise, it's an index chosen by the
+ *   solver (cf. the atom index).
  */
 typedef struct rdl_graph_s {
   rdl_matrix_t matrix;
   rdl_edge_stack_t edges;
   rdl_cell_stack_t cstack;
+  rdl_cell_stack_t changed;
+  int32_t      cmark;
+  uint32_t     wdim;
+  int32_t      *watch;
   ivector_t    buffer;
   rdl_const_t  c0;      // auxiliary variables for internal computations
 } rdl_graph_t;
@@ -301,12 +315,33 @@ typedef struct rdl_astack_s {
 
 
 
+/*
+ * Atom index for theory propagation
+ * - for every pair of vertices {x, y} used in an atom, we keep two lists:
+ *   the atoms (x - y <= c) and the atoms (y - x <= c), sorted by increasing c
+ * - the pair is identified by an integer k attached to cells M[x, y] and
+ *   M[y, x] in the graph's watch matrix. If x < y, then list[2k] contains
+ *   the atoms (x - y <= c) and list[2k+1] contains the atoms (y - x <= c).
+ * - nlists = number of lists in use
+ * - size = size of the list array (all vectors in list[0 ... size-1]
+ *   are initialized)
+ */
+typedef struct rdl_atom_index_s {
+  ivector_t *list;
+  uint32_t nlists;
+  uint32_t size;
+} rdl_atom_index_t;
+
+
 #define DEFAULT_RDL_ATBL_SIZE 100
 #define MAX_RDL_ATBL_SIZE (UINT32_MAX/sizeof(rdl_atom_t))
 
 #define DEFAULT_RDL_ASTACK_SIZE 100
 #define MAX_RDL_ASTACK_SIZE (UINT32_MAX/sizeof(int32_t))
 
+#define DEFAULT_RDL_ATOM_INDEX_SIZE 100
+#define MAX_RDL_ATOM_INDEX_SIZE (UINT32_MAX/sizeof(ivector_t))
+
 
 /*
  * Maximal number of atoms: same as MAX_RDL_ATBL_SIZE
@@ -410,9 +445,16 @@ typedef struct rdl_solver_s {
 
   /*
    * Atom table and stack
+   * - aindex = index of the atoms by vertex pairs
+   * - prop_atoms = number of atoms checked for propagation: atoms of index
+   *   prop_atoms or more are new and must be checked in the next call to
+   *   rdl_propagate. The other atoms are checked only if the distance
+   *   between their vertices is reduced.
    */
   rdl_atbl_t atoms;
   rdl_astack_t astack;
+  rdl_atom_index_t aindex;
+  uint32_t prop_atoms;
 
   /*
    * Backtracking stack
@@ -446,7 +488,6 @@ typedef struct rdl_solver_s {
   rational_t epsilon;
   rational_t factor;
   rational_t aux;
-  rational_t aux2;
   rational_t *value;
 
   /*
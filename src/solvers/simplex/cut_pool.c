@@ -0,0 +1,291 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * POOL OF CUTTING PLANES
+ */
+
+#include "solvers/simplex/cut_pool.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Initialize pool with the given capacity
+ */
+void init_cut_pool(cut_pool_t *pool, uint32_t capacity) {
+  assert(0 < capacity && capacity <= MAX_CUT_POOL_CAPACITY);
+
+  pool->data = (cut_t **) safe_malloc(capacity * sizeof(cut_t *));
+  pool->ncuts = 0;
+  pool->capacity = capacity;
+  pool->round = 0;
+  q_init(&pool->aux);
+}
+
+
+/*
+ * Delete a cut descriptor
+ */
+static void free_cut(cut_t *c) {
+  uint32_t i, n;
+
+  n = c->nbounds;
+  for (i=0; i<n; i++) {
+    q_clear(c->bound + i);
+  }
+  safe_free(c->var);
+  safe_free(c->bound);
+  safe_free(c->tag);
+  free_polynomial(c->poly);
+  safe_free(c);
+}
+
+
+/*
+ * Remove all cuts
+ */
+void reset_cut_pool(cut_pool_t *pool) {
+  uint32_t i, n;
+
+  n = pool->ncuts;
+  for (i=0; i<n; i++) {
+    free_cut(pool->data[i]);
+  }
+  pool->ncuts = 0;
+  pool->round = 0;
+  q_clear(&pool->aux);
+}
+
+
+/*
+ * Delete the pool
+ */
+void delete_cut_pool(cut_pool_t *pool) {
+  reset_cut_pool(pool);
+  safe_free(pool->data);
+  pool->data = NULL;
+}
+
+
+/*
+ * Index of the least recently used cut
+ * - if two cuts have the same stamp, the one with the lowest efficacy is returned
+ */
+static uint32_t cut_pool_lru(cut_pool_t *pool) {
+  cut_t *c, *best;
+  uint32_t i, n, k;
+
+  assert(pool->ncuts > 0);
+
+  k = 0;
+  best = pool->data[0];
+  n = pool->ncuts;
+  for (i=1; i<n; i++) {
+    c = pool->data[i];
+    if (c->stamp < best->stamp || (c->stamp == best->stamp && c->sq_efficacy < best->sq_efficacy)) {
+      k = i;
+      best = c;
+    }
+  }
+
+  return k;
+}
+
+
+/*
+ * Remove the cut of index k: replace it by the last cut
+ */
+static void cut_pool_remove(cut_pool_t *pool, uint32_t k) {
+  uint32_t n;
+
+  assert(k < pool->ncuts);
+
+  free_cut(pool->data[k]);
+  n = pool->ncuts - 1;
+  pool->data[k] = pool->data[n];
+  pool->ncuts = n;
+}
+
+
+/*
+ * Change the capacity
+ */
+void cut_pool_set_capacity(cut_pool_t *pool, uint32_t capacity) {
+  assert(0 < capacity && capacity <= MAX_CUT_POOL_CAPACITY);
+
+  while (pool->ncuts > capacity) {
+    cut_pool_remove(pool, cut_pool_lru(pool));
+  }
+  pool->data = (cut_t **) safe_realloc(pool->data, capacity * sizeof(cut_t *));
+  pool->capacity = capacity;
+}
+
+
+/*
+ * Normalize the buffer: divide by the absolute value of the first
+ * non-constant coefficient.
+ */
+static void cut_pool_normalize(cut_pool_t *pool, poly_buffer_t *buffer) {
+  monomial_t *a;
+
+  a = poly_buffer_mono(buffer);
+  if (a[0].var == const_idx) {
+    a ++;
+  }
+  assert(a[0].var != const_idx && a[0].var != max_idx);
+
+  q_set_abs(&pool->aux, &a[0].coeff);
+  if (! q_is_one(&pool->aux)) {
+    q_inv(&pool->aux);
+    poly_buffer_rescale(buffer, &pool->aux);
+  }
+}
+
+
+/*
+ * Search for a cut equal to p
+ * - h = hash of p
+ * - return NULL if there's none
+ */
+static cut_t *cut_pool_find(cut_pool_t *pool, polynomial_t *p, uint32_t h) {
+  cut_t *c;
+  uint32_t i, n;
+
+  n = pool->ncuts;
+  for (i=0; i<n; i++) {
+    c = pool->data[i];
+    if (c->hash == h && equal_polynomials(c->poly, p)) {
+      return c;
+    }
+  }
+
+  return NULL;
+}
+
+
+/*
+ * Copy the premises stored in g into c
+ */
+static void cut_copy_premises(cut_t *c, gomory_vector_t *g) {
+  uint32_t i, j, n;
+
+  n = g->nelems;
+  c->var = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  c->bound = (rational_t *) safe_malloc(n * sizeof(rational_t));
+  c->tag = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (g->var[i] != const_idx) {
+      c->var[j] = g->var[i];
+      q_init(c->bound + j);
+      q_set(c->bound + j, g->bound + i);
+      c->tag[j] = g->tag[i];
+      j ++;
+    }
+  }
+  c->nbounds = j;
+}
+
+
+/*
+ * Add a cut
+ */
+cut_t *cut_pool_add(cut_pool_t *pool, poly_buffer_t *buffer, gomory_vector_t *premises, double sq_efficacy) {
+  polynomial_t *p;
+  cut_t *c;
+  uint32_t h;
+
+  cut_pool_normalize(pool, buffer);
+  h = hash_monarray(poly_buffer_mono(buffer), poly_buffer_nterms(buffer));
+  p = poly_buffer_get_poly(buffer);
+
+  c = cut_pool_find(pool, p, h);
+  if (c != NULL) {
+    free_polynomial(p);
+  } else {
+    if (pool->ncuts == pool->capacity) {
+      cut_pool_remove(pool, cut_pool_lru(pool));
+    }
+    assert(pool->ncuts < pool->capacity);
+
+    c = (cut_t *) safe_malloc(sizeof(cut_t));
+    c->poly = p;
+    c->hash = h;
+    c->sqnorm = monarray_sqnorm(p->mono);
+    cut_copy_premises(c, premises);
+    pool->data[pool->ncuts] = c;
+    pool->ncuts ++;
+  }
+
+  c->sq_efficacy = sq_efficacy;
+  c->stamp = pool->round;
+
+  return c;
+}
+
+
+/*
+ * Squared Euclidean norm
+ */
+double monarray_sqnorm(monomial_t *a) {
+  double x, s;
+
+  s = 0.0;
+  while (a->var != max_idx) {
+    if (a->var != const_idx) {
+      x = q_get_double(&a->coeff);
+      s += x * x;
+    }
+    a ++;
+  }
+
+  return s;
+}
+
+
+/*
+ * Parallelism: both polynomials are sorted by increasing variable index
+ * - the cosine is dot/(norm1 * norm2) where dot is the dot product
+ * - so cosine > max is equivalent to dot > 0 and dot^2 > max^2 * sqnorm1 * sqnorm2
+ */
+bool cuts_are_parallel(cut_t *c1, cut_t *c2, double max) {
+  monomial_t *a, *b;
+  double dot;
+
+  assert(0.0 <= max && max <= 1.0);
+
+  a = c1->poly->mono;
+  b = c2->poly->mono;
+  dot = 0.0;
+  while (a->var != max_idx && b->var != max_idx) {
+    if (a->var < b->var) {
+      a ++;
+    } else if (a->var > b->var) {
+      b ++;
+    } else {
+      if (a->var != const_idx) {
+	dot += q_get_double(&a->coeff) * q_get_double(&b->coeff);
+      }
+      a ++;
+      b ++;
+    }
+  }
+
+  return dot > 0.0 && dot * dot > max * max * c1->sqnorm * c2->sqnorm;
+}
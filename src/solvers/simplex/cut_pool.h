@@ -0,0 +1,162 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * POOL OF CUTTING PLANES
+ */
+
+/*
+ * The Simplex solver generates Gomory and MIR cuts from rows of the
+ * tableau. A cut is an inequality (p >= 0) that's implied by a set of
+ * bounds on variables (the premises). The cut itself is valid only when
+ * the premises hold, but the clause
+ *
+ *    (x_1 >= l_1) /\ ... /\ (x_n <= u_n) => (p >= 0)
+ *
+ * is valid at all decision levels. So cuts don't need to be removed on
+ * backtracking. The pool keeps them so that they can be added again
+ * later, when their premises are implied by the bounds and the current
+ * assignment violates them.
+ *
+ * The pool has a bounded capacity. When it's full, the cut that was
+ * least recently used is removed to make room for a new one.
+ *
+ * Each cut stores:
+ * - the polynomial p (in normalized form: the first non-constant
+ *   coefficient is either 1 or -1)
+ * - the premises: variable, bound, and tag (as in gomory_vector_t)
+ * - the squared Euclidean norm of p's non-constant coefficients
+ * - the square of its efficacy when it was last evaluated (the efficacy
+ *   is the distance from the current assignment to the hyperplane p = 0)
+ * - a stamp: the last round where the cut was created or used
+ */
+
+#ifndef __CUT_POOL_H
+#define __CUT_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "solvers/simplex/gomory_cuts.h"
+#include "terms/poly_buffer.h"
+#include "terms/polynomials.h"
+#include "terms/rationals.h"
+
+
+/*
+ * Cut descriptor
+ */
+typedef struct cut_s {
+  polynomial_t *poly;
+  uint32_t hash;
+  uint32_t nbounds;
+  int32_t *var;
+  rational_t *bound;
+  uint8_t *tag;
+  double sqnorm;
+  double sq_efficacy;
+  uint32_t stamp;
+} cut_t;
+
+
+/*
+ * Pool
+ * - data = array of size capacity
+ * - ncuts = number of cuts in the pool
+ * - round = counter incremented at every round of cut generation
+ * - aux = buffer for normalization
+ */
+typedef struct cut_pool_s {
+  cut_t **data;
+  uint32_t ncuts;
+  uint32_t capacity;
+  uint32_t round;
+  rational_t aux;
+} cut_pool_t;
+
+
+#define DEF_CUT_POOL_CAPACITY 256
+#define MAX_CUT_POOL_CAPACITY (UINT32_MAX/sizeof(cut_t *))
+
+
+
+/*
+ * Initialize pool with the given capacity
+ * - capacity must be positive and no more than MAX_CUT_POOL_CAPACITY
+ */
+extern void init_cut_pool(cut_pool_t *pool, uint32_t capacity);
+
+/*
+ * Delete: free all memory
+ */
+extern void delete_cut_pool(cut_pool_t *pool);
+
+/*
+ * Reset: remove all cuts and reset the round counter
+ */
+extern void reset_cut_pool(cut_pool_t *pool);
+
+/*
+ * Change the capacity
+ * - if the new capacity is smaller than the number of cuts, the least
+ *   recently used cuts are removed
+ */
+extern void cut_pool_set_capacity(cut_pool_t *pool, uint32_t capacity);
+
+/*
+ * Start a new round
+ */
+static inline void cut_pool_next_round(cut_pool_t *pool) {
+  pool->round ++;
+}
+
+/*
+ * Add a cut to the pool:
+ * - buffer must contain a normalized polynomial p with at least one
+ *   non-constant monomial (the cut is p >= 0)
+ * - premises must contain the bounds that imply the cut: the premises
+ *   are all the elements of vector g, except the ones on const_idx
+ *   (i.e., the constant term)
+ * - sq_efficacy = square of the cut's efficacy
+ *
+ * The buffer is normalized then reset.
+ *
+ * If the pool already contains an equivalent cut (i.e., same polynomial
+ * after normalization), then the new cut is not added but the existing
+ * cut's stamp and sq_efficacy are updated.
+ *
+ * Return the new or existing cut.
+ */
+extern cut_t *cut_pool_add(cut_pool_t *pool, poly_buffer_t *buffer, gomory_vector_t *premises, double sq_efficacy);
+
+/*
+ * Squared Euclidean norm of the non-constant coefficients of a monomial array
+ * - a must be terminated by the end marker max_idx
+ */
+extern double monarray_sqnorm(monomial_t *a);
+
+/*
+ * Parallelism test: check whether the cosine of the angle between the
+ * coefficient vectors of c1 and c2 (ignoring the constant terms) is
+ * more than max.
+ * - max must be between 0.0 and 1.0
+ */
+extern bool cuts_are_parallel(cut_t *c1, cut_t *c2, double max);
+
+
+#endif /* __CUT_POOL_H */
@@ -0,0 +1,620 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * FLOATING-POINT SIMPLEX
+ */
+
+#include <assert.h>
+
+#include "solvers/simplex/fp_simplex.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Mark for variables that have left the basis (used to detect cycling)
+ */
+#define FP_LEFT_MASK ((uint8_t) 0x4)
+
+
+static inline double fp_abs(double x) {
+  return x < 0.0 ? -x : x;
+}
+
+
+/*
+ * ROWS
+ */
+
+#define DEF_FP_ROW_SIZE 8
+#define MAX_FP_ROW_SIZE (UINT32_MAX/sizeof(double))
+
+static void init_fp_row(fp_row_t *row) {
+  row->size = 0;
+  row->capacity = 0;
+  row->var = NULL;
+  row->coeff = NULL;
+}
+
+static void delete_fp_row(fp_row_t *row) {
+  safe_free(row->var);
+  safe_free(row->coeff);
+  row->var = NULL;
+  row->coeff = NULL;
+}
+
+/*
+ * Add a.y at the end of row
+ */
+static void fp_row_push(fp_row_t *row, int32_t y, double a) {
+  uint32_t i, n;
+
+  i = row->size;
+  if (i == row->capacity) {
+    n = row->capacity;
+    if (n == 0) {
+      n = DEF_FP_ROW_SIZE;
+    } else {
+      n += (n >> 1) + 1;
+      if (n >= MAX_FP_ROW_SIZE) {
+	out_of_memory();
+      }
+    }
+    row->var = (int32_t *) safe_realloc(row->var, n * sizeof(int32_t));
+    row->coeff = (double *) safe_realloc(row->coeff, n * sizeof(double));
+    row->capacity = n;
+  }
+  assert(i < row->capacity);
+  row->var[i] = y;
+  row->coeff[i] = a;
+  row->size = i+1;
+}
+
+/*
+ * Index of y in row or -1
+ */
+static int32_t fp_row_find(fp_row_t *row, int32_t y) {
+  uint32_t i, n;
+
+  n = row->size;
+  for (i=0; i<n; i++) {
+    if (row->var[i] == y) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+/*
+ * Remove r from column v
+ */
+static void fp_column_remove(ivector_t *v, int32_t r) {
+  uint32_t i, n;
+
+  n = v->size;
+  for (i=0; i<n; i++) {
+    if (v->data[i] == r) {
+      v->data[i] = v->data[n-1];
+      v->size = n-1;
+      return;
+    }
+  }
+  assert(false);
+}
+
+
+
+/*
+ * TABLEAU
+ */
+
+/*
+ * Initialize for n variables and m rows
+ */
+void init_fp_simplex(fp_simplex_t *fp, uint32_t n, uint32_t m) {
+  uint32_t i;
+
+  assert(n > 0);
+
+  fp->nvars = n;
+  fp->nrows = 0;
+  fp->row_cap = m;
+  fp->row = (fp_row_t *) safe_malloc(m * sizeof(fp_row_t));
+  fp->base_var = (int32_t *) safe_malloc(m * sizeof(int32_t));
+
+  fp->column = (ivector_t *) safe_malloc(n * sizeof(ivector_t));
+  fp->base_row = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  fp->value = (double *) safe_malloc(n * sizeof(double));
+  fp->lb = (double *) safe_malloc(n * sizeof(double));
+  fp->ub = (double *) safe_malloc(n * sizeof(double));
+  fp->tag = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+  fp->index = (int32_t *) safe_malloc(n * sizeof(int32_t));
+
+  for (i=0; i<n; i++) {
+    init_ivector(fp->column + i, 0);
+    fp->base_row[i] = -1;
+    fp->value[i] = 0.0;
+    fp->lb[i] = 0.0;
+    fp->ub[i] = 0.0;
+    fp->tag[i] = 0;
+    fp->index[i] = -1;
+  }
+
+  // variable 0 is the constant
+  fp->value[0] = 1.0;
+  fp->lb[0] = 1.0;
+  fp->ub[0] = 1.0;
+  fp->tag[0] = FP_LB_MASK | FP_UB_MASK;
+
+  init_ivector(&fp->aux, 0);
+  fp->npivots = 0;
+}
+
+
+/*
+ * Delete
+ */
+void delete_fp_simplex(fp_simplex_t *fp) {
+  uint32_t i, n;
+
+  n = fp->nrows;
+  for (i=0; i<n; i++) {
+    delete_fp_row(fp->row + i);
+  }
+  n = fp->nvars;
+  for (i=0; i<n; i++) {
+    delete_ivector(fp->column + i);
+  }
+  safe_free(fp->row);
+  safe_free(fp->base_var);
+  safe_free(fp->column);
+  safe_free(fp->base_row);
+  safe_free(fp->value);
+  safe_free(fp->lb);
+  safe_free(fp->ub);
+  safe_free(fp->tag);
+  safe_free(fp->index);
+  delete_ivector(&fp->aux);
+
+  fp->row = NULL;
+  fp->base_var = NULL;
+  fp->column = NULL;
+  fp->base_row = NULL;
+  fp->value = NULL;
+  fp->lb = NULL;
+  fp->ub = NULL;
+  fp->tag = NULL;
+  fp->index = NULL;
+}
+
+
+/*
+ * Add a new row with basic variable x
+ */
+uint32_t fp_simplex_add_row(fp_simplex_t *fp, int32_t x) {
+  uint32_t r;
+
+  assert(0 < x && x < fp->nvars && fp->base_row[x] < 0);
+
+  r = fp->nrows;
+  assert(r < fp->row_cap);
+  init_fp_row(fp->row + r);
+  fp->base_var[r] = x;
+  fp->base_row[x] = r;
+  fp->nrows = r + 1;
+
+  return r;
+}
+
+
+/*
+ * Add a.y to row r
+ */
+void fp_simplex_row_add(fp_simplex_t *fp, uint32_t r, int32_t y, double a) {
+  assert(r < fp->nrows && 0 <= y && y < fp->nvars);
+  assert(fp_row_find(fp->row + r, y) < 0);
+  assert(a != 0.0 && (y != fp->base_var[r] || a == 1.0));
+
+  fp_row_push(fp->row + r, y, a);
+  ivector_push(fp->column + y, r);
+}
+
+
+
+/*
+ * ASSIGNMENT
+ */
+
+/*
+ * Compute the value of the basic variable of row r
+ */
+static void fp_simplex_set_basic_value(fp_simplex_t *fp, uint32_t r) {
+  fp_row_t *row;
+  double v;
+  uint32_t i, n;
+  int32_t x, y;
+
+  x = fp->base_var[r];
+  row = fp->row + r;
+  v = 0.0;
+  n = row->size;
+  for (i=0; i<n; i++) {
+    y = row->var[i];
+    if (y != x) {
+      v -= row->coeff[i] * fp->value[y];
+    }
+  }
+  fp->value[x] = v;
+}
+
+
+/*
+ * Initial assignment
+ */
+void fp_simplex_init_assignment(fp_simplex_t *fp) {
+  uint32_t i, n;
+  int32_t x;
+
+  n = fp->nvars;
+  for (x=1; x<n; x++) {
+    if (fp->base_row[x] < 0) {
+      if (fp->tag[x] & FP_UB_MASK) {
+	fp->value[x] = fp->ub[x];
+      } else if (fp->tag[x] & FP_LB_MASK) {
+	fp->value[x] = fp->lb[x];
+      } else {
+	fp->value[x] = 0.0;
+      }
+    }
+  }
+
+  n = fp->nrows;
+  for (i=0; i<n; i++) {
+    fp_simplex_set_basic_value(fp, i);
+  }
+}
+
+
+/*
+ * Check whether x is below its lower bound or above its upper bound
+ */
+static bool fp_below_lb(fp_simplex_t *fp, int32_t x) {
+  double l;
+
+  l = fp->lb[x];
+  return (fp->tag[x] & FP_LB_MASK) && fp->value[x] < l - FP_FEAS_TOL * (1.0 + fp_abs(l));
+}
+
+static bool fp_above_ub(fp_simplex_t *fp, int32_t x) {
+  double u;
+
+  u = fp->ub[x];
+  return (fp->tag[x] & FP_UB_MASK) && fp->value[x] > u + FP_FEAS_TOL * (1.0 + fp_abs(u));
+}
+
+
+/*
+ * Check whether x has a lower bound and is closer to it than to its upper bound
+ */
+bool fp_simplex_at_lower(fp_simplex_t *fp, int32_t x) {
+  assert(0 <= x && x < fp->nvars);
+
+  switch (fp->tag[x] & (FP_LB_MASK|FP_UB_MASK)) {
+  case FP_LB_MASK:
+    return true;
+
+  case FP_LB_MASK|FP_UB_MASK:
+    return fp->value[x] - fp->lb[x] <= fp->ub[x] - fp->value[x];
+
+  default:
+    return false;
+  }
+}
+
+
+
+/*
+ * PIVOTING
+ */
+
+/*
+ * Eliminate y from row s using row r0 (where y has coefficient 1)
+ * - dy = change in y's value: the value of s's basic variable is updated
+ */
+static void fp_simplex_eliminate(fp_simplex_t *fp, uint32_t s, fp_row_t *row0, int32_t y, double dy) {
+  fp_row_t *row;
+  int32_t *index;
+  double c, a;
+  uint32_t i, j, n;
+  int32_t k, p, v;
+
+  row = fp->row + s;
+  index = fp->index;
+
+  k = fp_row_find(row, y);
+  assert(k >= 0);
+  c = row->coeff[k];
+  fp->value[fp->base_var[s]] -= c * dy;
+
+  n = row->size;
+  for (i=0; i<n; i++) {
+    index[row->var[i]] = i;
+  }
+
+  // row := row - c * row0
+  n = row0->size;
+  for (i=0; i<n; i++) {
+    v = row0->var[i];
+    if (v != y) {
+      a = - c * row0->coeff[i];
+      p = index[v];
+      if (p >= 0) {
+	row->coeff[p] += a;
+      } else {
+	index[v] = row->size;
+	fp_row_push(row, v, a);
+	ivector_push(fp->column + v, s);
+      }
+    }
+  }
+  row->coeff[k] = 0.0;
+
+  // remove the zero elements and clear the index
+  n = row->size;
+  j = 0;
+  for (i=0; i<n; i++) {
+    v = row->var[i];
+    index[v] = -1;
+    if (fp_abs(row->coeff[i]) < FP_ZERO_TOL) {
+      fp_column_remove(fp->column + v, s);
+    } else {
+      row->var[j] = v;
+      row->coeff[j] = row->coeff[i];
+      j ++;
+    }
+  }
+  row->size = j;
+
+  assert(fp->base_var[s] != y && fp_row_find(row, fp->base_var[s]) >= 0);
+}
+
+
+/*
+ * Pivot: make the variable of index k in row r basic
+ * - dy = change in the entering variable's value
+ */
+static void fp_simplex_pivot(fp_simplex_t *fp, uint32_t r, uint32_t k, double dy) {
+  fp_row_t *row0;
+  ivector_t *v;
+  double a;
+  uint32_t i, n;
+  int32_t x, y;
+
+  row0 = fp->row + r;
+  assert(k < row0->size);
+
+  y = row0->var[k];
+  x = fp->base_var[r];
+  assert(x != y && fp->base_row[y] < 0);
+
+  // scale row0 so that y has coefficient 1
+  a = row0->coeff[k];
+  n = row0->size;
+  for (i=0; i<n; i++) {
+    row0->coeff[i] /= a;
+  }
+  row0->coeff[k] = 1.0;
+
+  fp->base_row[x] = -1;
+  fp->base_row[y] = r;
+  fp->base_var[r] = y;
+
+  // eliminate y from the other rows
+  // we copy column[y] since it's modified by the elimination
+  v = &fp->aux;
+  ivector_reset(v);
+  ivector_add(v, fp->column[y].data, fp->column[y].size);
+  n = v->size;
+  for (i=0; i<n; i++) {
+    if (v->data[i] != r) {
+      fp_simplex_eliminate(fp, v->data[i], row0, y, dy);
+    }
+  }
+  ivector_reset(v);
+
+  assert(fp->column[y].size == 1 && fp->column[y].data[0] == r);
+
+  fp->npivots ++;
+}
+
+
+
+/*
+ * FEASIBILITY SEARCH
+ */
+
+/*
+ * Select the infeasible basic variable of smallest index
+ * - return -1 if all basic variables are within their bounds
+ */
+static int32_t fp_select_leaving_var(fp_simplex_t *fp) {
+  uint32_t i, n;
+  int32_t x, best;
+
+  best = -1;
+  n = fp->nrows;
+  for (i=0; i<n; i++) {
+    x = fp->base_var[i];
+    if ((best < 0 || x < best) && (fp_below_lb(fp, x) || fp_above_ub(fp, x))) {
+      best = x;
+    }
+  }
+
+  return best;
+}
+
+
+/*
+ * Check whether y can be used to increase the basic variable of row r
+ * - a = coefficient of y in the row
+ * - if a > 0, y must decrease; if a < 0, y must increase
+ */
+static bool fp_possible_entering_var(fp_simplex_t *fp, int32_t y, double a, bool increase) {
+  if ((a > 0.0) == increase) {
+    // y must decrease
+    return (fp->tag[y] & FP_LB_MASK) == 0 || fp->value[y] > fp->lb[y];
+  } else {
+    // y must increase
+    return (fp->tag[y] & FP_UB_MASK) == 0 || fp->value[y] < fp->ub[y];
+  }
+}
+
+
+/*
+ * Score of a candidate entering variable y (same heuristic as in simplex.c)
+ * - number of basic variables with a bound whose row contains y
+ *   + 1 if y has a bound
+ * - the function returns as soon as the score exceeds best_score
+ */
+static uint32_t fp_entering_var_score(fp_simplex_t *fp, int32_t y, uint32_t best_score) {
+  ivector_t *col;
+  uint32_t i, n, score;
+
+  score = 0;
+  if (fp->tag[y] & (FP_LB_MASK|FP_UB_MASK)) {
+    score ++;
+  }
+
+  col = fp->column + y;
+  n = col->size;
+  for (i=0; i<n && score <= best_score; i++) {
+    if (fp->tag[fp->base_var[col->data[i]]] & (FP_LB_MASK|FP_UB_MASK)) {
+      score ++;
+    }
+  }
+
+  return score;
+}
+
+
+/*
+ * Search for an entering variable in row r
+ * - x = basic variable in that row
+ * - increase = true if x must increase, false if it must decrease
+ * - return the index of the entering variable in the row or -1
+ */
+static int32_t fp_find_entering_var(fp_simplex_t *fp, uint32_t r, int32_t x, bool increase) {
+  fp_row_t *row;
+  double a, max;
+  uint32_t i, n, score, best_score;
+  int32_t y, best;
+
+  row = fp->row + r;
+  n = row->size;
+
+  max = 0.0;
+  for (i=0; i<n; i++) {
+    a = fp_abs(row->coeff[i]);
+    if (a > max) max = a;
+  }
+  max *= FP_PIVOT_TOL;
+
+  best = -1;
+  best_score = UINT32_MAX;
+  for (i=0; i<n; i++) {
+    y = row->var[i];
+    a = row->coeff[i];
+    if (y > 0 && y != x && fp_abs(a) >= max && fp_possible_entering_var(fp, y, a, increase)) {
+      score = fp_entering_var_score(fp, y, best_score);
+      if (score < best_score) {
+	best_score = score;
+	best = i;
+      }
+    }
+  }
+
+  return best;
+}
+
+
+/*
+ * Search for a feasible assignment
+ */
+bool fp_simplex_make_feasible(fp_simplex_t *fp, uint32_t max_pivots) {
+  fp_row_t *row;
+  double b, dy;
+  uint32_t i, n, npivots, repeats;
+  int32_t x, y, r, k;
+  bool increase, feasible;
+
+  n = fp->nvars;
+  for (i=0; i<n; i++) {
+    fp->tag[i] &= ~FP_LEFT_MASK;
+  }
+
+  npivots = 0;
+  repeats = 0;
+
+  for (;;) {
+    x = fp_select_leaving_var(fp);
+    if (x < 0) {
+      feasible = true;
+      break;
+    }
+    if (npivots >= max_pivots) {
+      feasible = false;
+      break;
+    }
+
+    r = fp->base_row[x];
+    increase = fp_below_lb(fp, x);
+    k = fp_find_entering_var(fp, r, x, increase);
+    if (k < 0) {
+      // infeasible (or we can't find a good pivot)
+      feasible = false;
+      break;
+    }
+
+    /*
+     * x + a.y + ... = 0 so moving x to b requires changing y by
+     * dy = - (b - value[x])/a
+     */
+    row = fp->row + r;
+    y = row->var[k];
+    b = increase ? fp->lb[x] : fp->ub[x];
+    dy = (fp->value[x] - b)/row->coeff[k];
+    fp->value[y] += dy;
+    fp_simplex_pivot(fp, r, k, dy);
+    fp->value[x] = b;
+    npivots ++;
+
+    if (fp->tag[x] & FP_LEFT_MASK) {
+      repeats ++;
+      if (repeats > FP_MAX_REPEATS) {
+	// probably cycling: give up
+	feasible = false;
+	break;
+      }
+    } else {
+      fp->tag[x] |= FP_LEFT_MASK;
+    }
+  }
+
+  return feasible;
+}
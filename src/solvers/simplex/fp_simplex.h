@@ -0,0 +1,213 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * FLOATING-POINT SIMPLEX
+ */
+
+/*
+ * This is a copy of the simplex tableau where coefficients, bounds,
+ * and values are approximated by doubles. It's used to compute a
+ * good starting basis for the exact simplex: the feasibility search
+ * is done first in floating point (where pivoting is cheap), then the
+ * exact tableau is pivoted to the resulting basis. The exact simplex
+ * then checks feasibility from that basis as usual, so the floating-point
+ * result is never trusted.
+ *
+ * The tableau uses the same conventions as matrix_t:
+ * - each row is of the form x + a_1 y_1 + ... + a_n y_n = 0 where x is
+ *   the basic variable (with coefficient 1)
+ * - variable 0 is the constant: its value is always 1
+ *
+ * Rows are stored as parallel arrays (no free list), and each column
+ * is the list of rows where the variable occurs.
+ *
+ * The search is the same as in the exact simplex: pick an infeasible
+ * basic variable x of smallest index, then an entering variable y in
+ * x's row, then pivot and move x to its bound. The entering variable
+ * is selected with the same heuristic as in the exact simplex.
+ * Coefficients that are too small are not used as pivots.
+ *
+ * There's no Bland's rule: the search gives up if it looks like it's
+ * cycling. The exact simplex ensures termination anyway.
+ */
+
+#ifndef __FP_SIMPLEX_H
+#define __FP_SIMPLEX_H
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "utils/int_vectors.h"
+
+
+/*
+ * Sparse row
+ * - var[i] and coeff[i] for i in 0 ... size-1
+ */
+typedef struct fp_row_s {
+  uint32_t size;
+  uint32_t capacity;
+  int32_t *var;
+  double *coeff;
+} fp_row_t;
+
+
+/*
+ * Tags: which bounds a variable has
+ */
+#define FP_LB_MASK ((uint8_t) 0x1)
+#define FP_UB_MASK ((uint8_t) 0x2)
+
+
+/*
+ * Tableau + assignment
+ * - nvars = number of variables
+ * - nrows = number of rows
+ * - row[r] = row r (for 0 <= r < nrows)
+ * - column[x] = rows where x occurs
+ * - base_var[r] = basic variable of row r
+ * - base_row[x] = row where x is basic or -1
+ * - value[x], lb[x], ub[x] = value and bounds (lb[x] is valid if
+ *   tag[x] & FP_LB_MASK is non-zero, and similarly for ub[x])
+ * - index = auxiliary array for row operations (index[x] = -1 outside
+ *   these operations)
+ * - aux = auxiliary vector
+ * - npivots = number of pivots so far
+ */
+typedef struct fp_simplex_s {
+  uint32_t nvars;
+  uint32_t nrows;
+  uint32_t row_cap;
+  fp_row_t *row;
+  ivector_t *column;
+  int32_t *base_var;
+  int32_t *base_row;
+  double *value;
+  double *lb;
+  double *ub;
+  uint8_t *tag;
+  int32_t *index;
+  ivector_t aux;
+  uint32_t npivots;
+} fp_simplex_t;
+
+
+/*
+ * Tolerances:
+ * - a coefficient is considered zero if its absolute value is less than FP_ZERO_TOL
+ * - a value v violates a lower bound l if v < l - FP_FEAS_TOL * (1 + |l|)
+ *   (and similarly for upper bounds)
+ * - a coefficient a can be used as pivot in row r if |a| >= FP_PIVOT_TOL * max
+ *   where max is the largest absolute value of coefficients in row r
+ */
+#define FP_ZERO_TOL  1e-12
+#define FP_FEAS_TOL  1e-9
+#define FP_PIVOT_TOL 1e-7
+
+/*
+ * Bound on the number of repeats (a repeat is counted when a variable
+ * leaves the basis for the second time or more): the search gives up
+ * after that many repeats.
+ */
+#define FP_MAX_REPEATS 1000
+
+
+/*
+ * Initialize for n variables and m rows
+ * - all variables are unbounded (except the constant) and non-basic
+ * - the rows are empty (they must be added by fp_simplex_add_row)
+ */
+extern void init_fp_simplex(fp_simplex_t *fp, uint32_t n, uint32_t m);
+
+/*
+ * Delete: free memory
+ */
+extern void delete_fp_simplex(fp_simplex_t *fp);
+
+/*
+ * Add a new row with basic variable x
+ * - the row is empty: its elements must be added by fp_simplex_row_add
+ * - return the row index
+ */
+extern uint32_t fp_simplex_add_row(fp_simplex_t *fp, int32_t x);
+
+/*
+ * Add element a.y to row r
+ * - y must not occur in r already
+ * - a must be non-zero (and equal to 1 if y is the basic variable)
+ */
+extern void fp_simplex_row_add(fp_simplex_t *fp, uint32_t r, int32_t y, double a);
+
+/*
+ * Set a lower or upper bound on x
+ */
+static inline void fp_simplex_set_lb(fp_simplex_t *fp, int32_t x, double l) {
+  assert(0 < x && x < fp->nvars);
+  fp->lb[x] = l;
+  fp->tag[x] |= FP_LB_MASK;
+}
+
+static inline void fp_simplex_set_ub(fp_simplex_t *fp, int32_t x, double u) {
+  assert(0 < x && x < fp->nvars);
+  fp->ub[x] = u;
+  fp->tag[x] |= FP_UB_MASK;
+}
+
+/*
+ * Initial assignment: every non-basic variable is set to its upper bound
+ * if it has one, or to its lower bound, or to zero. The basic variables
+ * are computed from the rows.
+ * - this must be called after all rows and bounds are set
+ */
+extern void fp_simplex_init_assignment(fp_simplex_t *fp);
+
+/*
+ * Search for a feasible assignment
+ * - max_pivots = bound on the number of pivots
+ * - return true if the assignment is feasible (up to the tolerances)
+ * - return false if the problem is infeasible in floating point, or if
+ *   max_pivots or FP_MAX_REPEATS is reached
+ */
+extern bool fp_simplex_make_feasible(fp_simplex_t *fp, uint32_t max_pivots);
+
+
+/*
+ * Check whether x is basic
+ */
+static inline bool fp_simplex_is_basic(fp_simplex_t *fp, int32_t x) {
+  assert(0 <= x && x < fp->nvars);
+  return fp->base_row[x] >= 0;
+}
+
+/*
+ * Check whether x has a lower bound and its value is closer to the
+ * lower bound than to its upper bound
+ */
+extern bool fp_simplex_at_lower(fp_simplex_t *fp, int32_t x);
+
+/*
+ * Number of pivots
+ */
+static inline uint32_t fp_simplex_num_pivots(fp_simplex_t *fp) {
+  return fp->npivots;
+}
+
+
+#endif /* __FP_SIMPLEX_H */
@@ -17,7 +17,7 @@
  */
 
 /*
- * Support for constructing Mixed-integer Gomory cuts.
+ * Support for constructing Mixed-integer Gomory cuts and MIR cuts.
  */
 
 #include "solvers/simplex/gomory_cuts.h"
@@ -216,6 +216,11 @@ bool make_gomory_cut(gomory_vector_t *v, poly_buffer_t *buffer) {
       q_set(c_i, v->coeff + i);
     }
 
+    if (q_is_zero(c_i)) {
+      // integer variable with an integral coefficient: no contribution
+      continue;
+    }
+
     if (gomory_bound_is_lb(v, i)) {
       // c_i * (x_i - l_i) with x_i >= l_i
       if (q_is_pos(c_i)) {
@@ -252,3 +257,94 @@ bool make_gomory_cut(gomory_vector_t *v, poly_buffer_t *buffer) {
 
 
 
+
+
+/*
+ * MIR CUT
+ */
+
+/*
+ * Build the MIR cut from vector v, constant beta, and scaling factor s:
+ * - v must store an equality a_1 x_1 + ... + a_n x_n = beta
+ * - the cut is of the form (poly >= 0)
+ * - this function stores poly in buffer
+ */
+bool make_mir_cut(gomory_vector_t *v, rational_t *beta, rational_t *s, poly_buffer_t *buffer) {
+  uint32_t i, n;
+  rational_t *f, *e, *f_i, *g_i;
+
+  assert(q_is_nonzero(s));
+
+  /*
+   * beta' = s * (beta - sum a_i * bound_i)
+   */
+  q_clear(&v->sum);
+  n = v->nelems;
+  for (i=0; i<n; i++) {
+    q_addmul(&v->sum, v->coeff + i, v->bound + i);
+  }
+  q_neg(&v->sum);
+  q_add(&v->sum, beta);
+  q_mul(&v->sum, s);
+
+  f = &v->fraction;
+  e = &v->ext;
+  get_fraction(f, &v->sum);
+  if (q_is_zero(f)) {
+    return false;
+  }
+  q_set_one(e);
+  q_sub(e, f);
+
+  f_i = &v->aux_fraction;
+  g_i = &v->aux_coeff;
+
+  reset_poly_buffer(buffer);
+
+  for (i=0; i<n; i++) {
+    // abar_i = s * a_i or - s * a_i
+    q_set(g_i, v->coeff + i);
+    q_mul(g_i, s);
+    if (gomory_bound_is_ub(v, i)) {
+      q_neg(g_i);
+    }
+
+    if (gomory_var_is_int(v, i)) {
+      // g_i := floor(abar_i) + max(0, f_i - f)/(1 - f)
+      get_fraction(f_i, g_i);
+      q_sub(g_i, f_i);
+      if (q_gt(f_i, f)) {
+	q_sub(f_i, f);
+	q_div(f_i, e);
+	q_add(g_i, f_i);
+      }
+    } else if (q_is_neg(g_i)) {
+      // g_i := abar_i/(1 - f)
+      q_div(g_i, e);
+    } else {
+      q_clear(g_i);
+    }
+
+    if (q_is_nonzero(g_i)) {
+      /*
+       * Add - g_i * z_i to buffer:
+       * - if x_i has a lower bound, that's - g_i * (x_i - l_i)
+       * - otherwise it's g_i * (x_i - u_i)
+       */
+      if (gomory_bound_is_lb(v, i)) {
+	q_neg(g_i);
+      }
+      poly_buffer_add_monomial(buffer, v->var[i], g_i);
+      q_mul(g_i, v->bound + i);
+      poly_buffer_sub_const(buffer, g_i);
+    }
+  }
+
+  // add floor(beta')
+  q_set(&v->aux, &v->sum);
+  q_floor(&v->aux);
+  poly_buffer_add_const(buffer, &v->aux);
+  normalize_poly_buffer(buffer);
+
+  return true;
+}
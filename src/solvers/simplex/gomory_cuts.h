@@ -62,6 +62,31 @@
  *    
  *    c_1 (x_1 - l_1) + ... + c_k (x_k - l_k) + c_k+1 (x_k+1 - u_k+1) + ... + c_n (x_n - u_n) >= 1.
  *
+ *
+ * Mixed-integer rounding (MIR) cuts use the same vector but a different
+ * interpretation:
+ *
+ * 1) the vector stores an equality a_1 x_1 + ... + a_n x_n = beta
+ *    that holds for all feasible solutions.
+ *
+ * 2) each variable x_i has a bound: either x_i >= l_i or x_i <= u_i.
+ *    The bound doesn't have to be the current value of x_i.
+ *
+ * To build the cut, we first scale the equality by a non-zero factor s then
+ * we complement the variables: x_i = l_i + z_i or x_i = u_i - z_i where z_i >= 0.
+ * This gives
+ *
+ *    abar_1 z_1 + ... + abar_n z_n = beta'
+ *
+ * where abar_i = s a_i if x_i has a lower bound, abar_i = - s a_i otherwise.
+ * Let f = fractional part of beta'. If f is 0, there's no cut. Otherwise,
+ * the MIR cut is
+ *
+ *    g_1 z_1 + ... + g_n z_n <= floor(beta')
+ *
+ * where g_i = floor(abar_i) + max(0, f_i - f)/(1 - f) if x_i is an integer
+ * variable and f_i is the fractional part of abar_i, and g_i = min(0, abar_i)/(1 - f)
+ * if x_i is not an integer variable.
  */
 
 
@@ -195,4 +220,15 @@ static inline uint8_t gomory_tag(bool is_int, bool is_lb) {
 extern bool make_gomory_cut(gomory_vector_t *v, poly_buffer_t *buffer);
 
 
+/*
+ * Build the MIR cut from vector v, constant beta, and scaling factor s
+ * - v must store an equality a_1 x_1 + ... + a_n x_n = beta
+ * - s must be non-zero
+ * - the cut is returned as (poly >= 0), with poly stored in buffer
+ *
+ * Return false if the cut can't be constructed (i.e., the fraction f is 0)
+ */
+extern bool make_mir_cut(gomory_vector_t *v, rational_t *beta, rational_t *s, poly_buffer_t *buffer);
+
+
 #endif
@@ -295,6 +295,64 @@ static void delete_row(row_t *v) {
 
 
 
+/*
+ * PIVOT ROW
+ */
+
+/*
+ * Initialize: the arrays are allocated on demand
+ */
+static void init_pivot_row(pivot_row_t *p) {
+  p->src = NULL;
+  p->nelems = 0;
+  p->size = 0;
+  p->stamp = 0;
+  p->col = NULL;
+  p->ptr = NULL;
+  p->coeff = NULL;
+  p->mark = NULL;
+  p->zero = NULL;
+}
+
+static void delete_pivot_row(pivot_row_t *p) {
+  safe_free(p->col);
+  safe_free(p->ptr);
+  safe_free(p->coeff);
+  safe_free(p->mark);
+  safe_free(p->zero);
+  init_pivot_row(p);
+}
+
+/*
+ * Make the arrays large enough for n elements
+ */
+static void resize_pivot_row(pivot_row_t *p, uint32_t n) {
+  uint32_t new_size;
+
+  if (p->size < n) {
+    new_size = p->size + 1;
+    new_size += new_size >> 1;
+    if (new_size < DEF_PIVOT_ROW_SIZE) {
+      new_size = DEF_PIVOT_ROW_SIZE;
+    }
+    if (new_size < n) {
+      new_size = n;
+    }
+    if (new_size >= MAX_PIVOT_ROW_SIZE) {
+      out_of_memory();
+    }
+    p->col = (int32_t *) safe_realloc(p->col, new_size * sizeof(int32_t));
+    p->ptr = (int32_t *) safe_realloc(p->ptr, new_size * sizeof(int32_t));
+    p->coeff = (int64_t *) safe_realloc(p->coeff, new_size * sizeof(int64_t));
+    p->mark = (uint32_t *) safe_realloc(p->mark, new_size * sizeof(uint32_t));
+    p->zero = (int32_t *) safe_realloc(p->zero, new_size * sizeof(int32_t));
+    p->size = new_size;
+  }
+}
+
+
+
+
 /*
  * MATRIX
  */
@@ -331,6 +389,8 @@ void init_matrix(matrix_t *matrix, uint32_t n, uint32_t m) {
 
   // constant is not allocated here
   matrix->constant = NULL;
+
+  init_pivot_row(&matrix->pivot);
 }
 
 
@@ -357,6 +417,7 @@ void delete_matrix(matrix_t *matrix) {
   safe_free(matrix->base_var);
   safe_free(matrix->base_row);
   delete_bitvector(matrix->marks);
+  delete_pivot_row(&matrix->pivot);
 
   q_clear(&matrix->factor);
 
@@ -1832,6 +1893,241 @@ void matrix_submul_row(matrix_t *matrix, uint32_t r, uint32_t k, row_t *row0) {
 
 
 
+/*
+ * Elimination using a pivot row in split form
+ *
+ * To eliminate x from rows r_1, ..., r_k, we subtract a_i * row0 from
+ * each row r_i. The generic matrix_submul_row rebuilds the index of r_i
+ * for each row, then scans row0, then scans r_i again to reset the index
+ * and remove zero elements.
+ *
+ * If all coefficients of row0 are small integers, we copy row0 once
+ * into matrix->pivot (column indices and int64 coefficients in separate
+ * arrays) and set index[j] to the position of column j in row0. Then
+ * each row r_i is updated in two passes:
+ * - scan r_i and update the elements whose column occurs in row0
+ * - scan row0 and add the elements that don't occur in r_i
+ * When a_i and an element c of r_i are small integers, c - a_i * b
+ * is computed on 64bit integers. This can't overflow since small integers
+ * are less than 2^31 in absolute value.
+ *
+ * The elements of r_i that become zero are removed at the end, so the
+ * resulting row is the same as with matrix_submul_row.
+ *
+ * In tableaux with fractional coefficients, the rational arithmetic
+ * dominates and the extra work of loading row0 does not pay off, so
+ * the pivot row is not used.
+ */
+
+/*
+ * Load row0 into matrix->pivot
+ * - col = column of the variable to eliminate
+ * - row0 is not loaded if one of its coefficients is not a small integer,
+ *   or if loading does not pay off: loading and unloading cost two scans
+ *   of row0 and we save one scan of each row to update. To be on the safe
+ *   side, we require the rows in col (other than row0) to have at least
+ *   four times as many elements as row0.
+ * - if row0 is not loaded, matrix_eliminate uses matrix_submul_row.
+ * - index[j] must be -1 for all j
+ */
+static void matrix_load_pivot_row(matrix_t *matrix, row_t *row0, column_t *col) {
+  pivot_row_t *p;
+  row_t *row;
+  int32_t *index;
+  uint32_t i, j, n, work;
+  int32_t x;
+
+  p = &matrix->pivot;
+  assert(p->src == NULL);
+
+  work = 0;
+  n = col->size;
+  for (i=0; i<n; i++) {
+    x = col->data[i].r_idx;
+    if (x >= 0) {
+      row = matrix->row[x];
+      if (row != row0) {
+        work += row->size;
+      }
+    }
+  }
+  if (work < 4 * row0->size) {
+    return;
+  }
+
+  n = row0->size;
+  for (i=0; i<n; i++) {
+    if (row0->data[i].c_idx >= 0 && ! q_is_smallint(&row0->data[i].coeff)) {
+      return;
+    }
+  }
+
+  resize_pivot_row(p, n);
+
+  // the stamp is incremented once per row in submul_pivot_row
+  if (p->stamp > UINT32_MAX - matrix->nrows) {
+    p->stamp = 0;
+  }
+
+  index = matrix->index;
+  j = 0;
+  for (i=0; i<n; i++) {
+    x = row0->data[i].c_idx;
+    if (x >= 0) {
+      assert(index[x] < 0);
+      index[x] = j;
+      p->col[j] = x;
+      p->ptr[j] = i;
+      p->coeff[j] = q_get_smallint(&row0->data[i].coeff);
+      p->mark[j] = p->stamp;
+      j ++;
+    }
+  }
+
+  p->src = row0;
+  p->nelems = j;
+}
+
+
+/*
+ * Unload the pivot row and reset index to -1
+ */
+static void matrix_unload_pivot_row(matrix_t *matrix) {
+  pivot_row_t *p;
+  int32_t *index;
+  uint32_t i, n;
+
+  p = &matrix->pivot;
+  index = matrix->index;
+  n = p->nelems;
+  for (i=0; i<n; i++) {
+    index[p->col[i]] = -1;
+  }
+  p->src = NULL;
+  p->nelems = 0;
+}
+
+
+/*
+ * Subtract a * pivot row from row r
+ * - k = index of an element a.x in row r, where x has coefficient 1 in the pivot row
+ */
+static void matrix_submul_pivot_row(matrix_t *matrix, uint32_t r, uint32_t k) {
+  pivot_row_t *p;
+  row_t *row, *row0;
+  rational_t *a, *c;
+  int32_t *index;
+  uint32_t i, j, n, nz, nm;
+  int32_t x, t, unit;
+  int64_t b;
+  bool is_int;
+
+  assert(r < matrix->nrows && matrix->pivot.src != NULL && matrix->row[r] != matrix->pivot.src);
+
+  p = &matrix->pivot;
+  row0 = p->src;
+  row = matrix->row[r];
+
+  // coefficient: a = row[k].coeff
+  a = &matrix->factor;
+  q_set(a, &row->data[k].coeff);
+  is_int = q_is_smallint(a);
+  b = is_int ? q_get_smallint(a) : 0;
+
+  // unit = +1 if a is 1, -1 if a is -1, 0 otherwise
+  unit = 0;
+  if (q_is_one(a)) {
+    unit = 1;
+  } else if (q_is_minus_one(a)) {
+    unit = -1;
+  }
+
+  // pass 1: update the elements of row r that occur in row0
+  p->stamp ++;
+  index = matrix->index;
+  nz = 0;
+  nm = 0;
+  n = row->size;
+  for (j=0; j<n; j++) {
+    x = row->data[j].c_idx;
+    if (x >= 0) {
+      t = index[x];
+      if (t >= 0) {
+        p->mark[t] = p->stamp;
+        nm ++;
+        c = &row->data[j].coeff;
+        if (is_int && q_is_smallint(c)) {
+          q_set64(c, q_get_smallint(c) - b * p->coeff[t]);
+        } else if (unit > 0) {
+          q_sub(c, &row0->data[p->ptr[t]].coeff);
+        } else if (unit < 0) {
+          q_add(c, &row0->data[p->ptr[t]].coeff);
+        } else {
+          q_submul(c, a, &row0->data[p->ptr[t]].coeff);
+        }
+        if (q_is_zero(c)) {
+          p->zero[nz] = j;
+          nz ++;
+        }
+      }
+    }
+  }
+
+  assert(q_is_zero(&row->data[k].coeff));
+
+  // pass 2: add the elements of row0 that don't occur in row r (if any)
+  n = (nm < p->nelems) ? p->nelems : 0;
+  for (i=0; i<n; i++) {
+    if (p->mark[i] != p->stamp) {
+      x = p->col[i];
+      j = alloc_row_elem(&row);
+      row->data[j].c_idx = x;
+      row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+      c = &row->data[j].coeff;
+      if (is_int) {
+        q_set64(c, - b * p->coeff[i]);
+      } else if (unit > 0) {
+        q_set_neg(c, &row0->data[p->ptr[i]].coeff);
+      } else if (unit < 0) {
+        q_set(c, &row0->data[p->ptr[i]].coeff);
+      } else {
+        q_set_neg(c, a);
+        q_mul(c, &row0->data[p->ptr[i]].coeff);
+      }
+    }
+  }
+
+  /*
+   * row must be copied back since alloc_row_elem may change it
+   */
+  matrix->row[r] = row;
+
+  // remove the zero elements
+  for (i=0; i<nz; i++) {
+    remove_row_elem(matrix, r, p->zero[i]);
+  }
+
+  if (row->nelems * 2 < row->size) {
+    matrix_compact_row(matrix, r);
+  }
+}
+
+
+/*
+ * Subtract a * row0 from row r to eliminate x
+ * - k = index of the element a.x in row r
+ * - row0 must be the row passed to matrix_load_pivot_row
+ */
+static inline void matrix_eliminate(matrix_t *matrix, uint32_t r, uint32_t k, row_t *row0) {
+  if (matrix->pivot.src == row0) {
+    matrix_submul_pivot_row(matrix, r, k);
+  } else {
+    matrix_submul_row(matrix, r, k, row0);
+  }
+}
+
+
+
 /*
  * Pivoting step: make x basic in r0
  * - k identifies the variable: k must be the index of the element where
@@ -1855,15 +2151,17 @@ void matrix_pivot(matrix_t *matrix, uint32_t r0, uint32_t k) {
 
   // eliminate x from the other rows
   col = matrix->column[x];
+  matrix_load_pivot_row(matrix, row0, col);
   n = col->size;
   for (i=0; i<n; i++) {
     r = col->data[i].r_idx;
     if (r >= 0 && r != r0) {
       j = col->data[i].r_ptr;
-      matrix_submul_row(matrix, r, j, row0);
+      matrix_eliminate(matrix, r, j, row0);
       assert(matrix->column[x] == col); // column[x] should not change
     }
   }
+  matrix_unload_pivot_row(matrix);
 
   // reset the column: it contains a single element
   if (col->capacity >= MATRIX_SHRINK_COLUMN_THRESHOLD) {
@@ -2047,18 +2345,20 @@ static void matrix_pivot_and_update(matrix_t *matrix, markowitz_t *d, uint32_t r
 
   // eliminate x from the other rows
   col = matrix->column[x];
+  matrix_load_pivot_row(matrix, row0, col);
   n = col->size;
   for (i=0; i<n; i++) {
     r = col->data[i].r_idx;
     if (r >= 0 && r != r0) {
       j = col->data[i].r_ptr;
-      matrix_submul_row(matrix, r, j, row0);
+      matrix_eliminate(matrix, r, j, row0);
       assert(matrix->column[x] == col); // column[x] should not change
 
       // update the heap for row r
       markowitz_update(d, matrix, r);
     }
   }
+  matrix_unload_pivot_row(matrix);
 
   // reset the column: it contains a single element
   col->free = -1;
@@ -2463,16 +2763,18 @@ static void gauss_elim_row(matrix_t *matrix, markowitz_t *d, byte_t *i_flag,
 
   // eliminate x from the other rows
   col = matrix->column[x];
+  matrix_load_pivot_row(matrix, row0, col);
   n = col->size;
   for (i=0; i<n; i++) {
     r = col->data[i].r_idx;
     if (r >= 0) {
       assert(r != r0);
       j = col->data[i].r_ptr;
-      matrix_submul_row(matrix, r, j, row0);
+      matrix_eliminate(matrix, r, j, row0);
       markowitz_update(d, matrix, r);
     }
   }
+  matrix_unload_pivot_row(matrix);
 
   // delete column x and row r0
   delete_column(col);
@@ -126,6 +126,37 @@ typedef struct column_s {
 
 
 
+/*
+ * Pivot row in split form
+ * - to eliminate a variable x from rows r_1, ..., r_k using a row row0
+ *   where x has coefficient 1, row0 may be copied once into parallel arrays
+ *   (this is done only if all coefficients of row0 are small integers):
+ *   col[i] = column index of element i
+ *   ptr[i] = index of the element in row0->data
+ *   coeff[i] = its coefficient
+ * - src = the copied row (NULL if no row is loaded)
+ * - nelems = number of elements in the arrays
+ * - size = size of the arrays
+ * - mark and stamp are used to find the elements of row0 that don't occur
+ *   in the row being updated: mark[i] == stamp iff col[i] occurs in that row
+ * - zero = auxiliary array to store the elements that become zero in that row
+ */
+typedef struct pivot_row_s {
+  row_t *src;
+  uint32_t nelems;
+  uint32_t size;
+  uint32_t stamp;
+  int32_t *col;
+  int32_t *ptr;
+  int64_t *coeff;
+  uint32_t *mark;
+  int32_t *zero;
+} pivot_row_t;
+
+#define DEF_PIVOT_ROW_SIZE 64
+#define MAX_PIVOT_ROW_SIZE (UINT32_MAX/sizeof(int64_t))
+
+
 /*
  * Matrix
  * - two arrays: one for rows, one for columns
@@ -149,6 +180,9 @@ typedef struct column_s {
  *   constant in row i. If constant[i] = k >= 0, then row[i][k] is
  *   <b, x_0, ..>.  If constant[i] = -1, then there's no constant in row i.
  *
+ * Pivot row: used by matrix_pivot and Gaussian elimination
+ * - while a pivot row is loaded, index[j] is the index of column j
+ *   in pivot.col (or -1 if j does not occur in the pivot row)
  */
 typedef struct matrix_s {
   uint32_t nrows;        // number of rows
@@ -169,6 +203,9 @@ typedef struct matrix_s {
 
   // optional components
   int32_t *constant;    // maps rows to constant
+
+  // pivot row
+  pivot_row_t pivot;
 } matrix_t;
 
 
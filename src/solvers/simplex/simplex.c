@@ -26,6 +26,7 @@
 
 #include "io/tracer.h"
 #include "solvers/egraph/theory_explanations.h"
+#include "solvers/simplex/fp_simplex.h"
 #include "solvers/simplex/integrality_constraints.h"
 #include "solvers/simplex/simplex.h"
 #include "terms/rational_hash_maps.h"
@@ -34,7 +35,9 @@
 #include "utils/dep_tables.h"
 #include "utils/dprng.h"
 #include "utils/hash_functions.h"
+#include "utils/int_array_sort2.h"
 #include "utils/int_hash_classes.h"
+#include "utils/ptr_array_sort2.h"
 
 
 /*
@@ -102,6 +105,12 @@ static void show_heap(FILE *f, simplex_solver_t *solver);
 #endif
 
 
+/*
+ * Propagator hook called before pivoting (defined in the propagator file)
+ */
+static void simplex_propagator_pivot(simplex_solver_t *solver, uint32_t r, uint32_t k);
+
+
 
 /**********
  *  PRNG  *
@@ -625,6 +634,10 @@ static void init_simplex_statistics(simplex_stats_t *stat) {
   stat->num_make_feasible = 0;
   stat->num_pivots = 0;
   stat->num_blands = 0;
+  stat->num_bound_flips = 0;
+  stat->num_flip_repairs = 0;
+  stat->num_fp_pivots = 0;
+  stat->num_warm_pivots = 0;
   stat->num_conflicts = 0;
 
   stat->num_make_intfeasible = 0;
@@ -640,6 +653,12 @@ static void init_simplex_statistics(simplex_stats_t *stat) {
   stat->num_dioph_recheck_conflicts = 0;
 
   stat->num_branch_atoms = 0;
+
+  stat->num_cut_rounds = 0;
+  stat->num_gomory_cuts = 0;
+  stat->num_mir_cuts = 0;
+  stat->num_cuts = 0;
+  stat->num_pool_cuts = 0;
 }
 
 
@@ -1583,6 +1602,12 @@ void init_simplex_solver(simplex_solver_t *solver, smt_core_t *core, gate_manage
   solver->interrupted = false;
   solver->use_blands_rule = false;
   solver->bland_threshold = SIMPLEX_DEFAULT_BLAND_THRESHOLD;
+  solver->weight = NULL;      // allocated later if needed
+  solver->weight_size = 0;
+  init_ivector(&solver->weighted, 0);
+  solver->flip_stamp = NULL;  // allocated later if needed
+  solver->flip_stamp_size = 0;
+  solver->flip_round = 0;
   solver->prop_row_size = SIMPLEX_DEFAULT_PROP_ROW_SIZE;
   solver->last_conflict_row = -1;
   solver->recheck = false;
@@ -1596,6 +1621,14 @@ void init_simplex_solver(simplex_solver_t *solver, smt_core_t *core, gate_manage
   solver->last_branch_atom = null_bvar;
   solver->dsolver = NULL;     // allocated later if needed
 
+  solver->cut_pool = NULL;    // allocated later if needed
+  solver->cut_rounds = 0;
+  solver->max_cut_rounds = SIMPLEX_DEFAULT_CUT_ROUNDS;
+  solver->max_cuts = SIMPLEX_DEFAULT_MAX_CUTS;
+  solver->cut_pool_size = SIMPLEX_DEFAULT_CUT_POOL_SIZE;
+  solver->cut_min_efficacy = SIMPLEX_DEFAULT_CUT_EFFICACY;
+  solver->cut_max_parallelism = SIMPLEX_DEFAULT_CUT_PARALLELISM;
+
   solver->cache = NULL;       // allocated later if needed
 
   init_simplex_statistics(&solver->stats);
@@ -1683,6 +1716,26 @@ static dsolver_t *simplex_get_dsolver(simplex_solver_t *solver) {
 }
 
 
+/*
+ * Return the cut pool
+ * - allocate and initialize it if needed
+ * - otherwise, adjust its capacity to cut_pool_size
+ */
+static cut_pool_t *simplex_get_cut_pool(simplex_solver_t *solver) {
+  cut_pool_t *pool;
+
+  pool = solver->cut_pool;
+  if (pool == NULL) {
+    pool = (cut_pool_t *) safe_malloc(sizeof(cut_pool_t));
+    init_cut_pool(pool, solver->cut_pool_size);
+    solver->cut_pool = pool;
+  } else if (pool->capacity != solver->cut_pool_size) {
+    cut_pool_set_capacity(pool, solver->cut_pool_size);
+  }
+  return pool;
+}
+
+
 /*
  * Return the cache
  * - allocate and initialize it if needed
@@ -3519,8 +3572,10 @@ static void simplex_set_basic_var_value(simplex_solver_t *solver, thvar_t x, row
  *          or upper bound on x if it exists
  *          or 0
  * - for every basic variable, val[x] is computed from the matrix
+ * - if fp is not NULL, it's the result of the floating-point warm start:
+ *   a non-basic variable is then set to the bound it's closer to in fp.
  */
-static void simplex_init_assignment(simplex_solver_t *solver) {
+static void simplex_init_assignment(simplex_solver_t *solver, fp_simplex_t *fp) {
   matrix_t *matrix;
   arith_vartable_t *vtbl;
   xrational_t *bound, *v;
@@ -3553,6 +3608,10 @@ static void simplex_init_assignment(simplex_solver_t *solver) {
         i = arith_var_lower_index(vtbl, x);
       }
 #endif
+      if (fp != NULL && fp_simplex_at_lower(fp, x)) {
+        i = arith_var_lower_index(vtbl, x);
+        assert(i >= 0);
+      }
 
       v = arith_var_value(vtbl, x);
       if (i >= 0) {
@@ -4138,6 +4197,454 @@ static void conflict_set_for_decrease(simplex_solver_t *solver, row_t *row, thva
 }
 
 
+/*
+ * PRICING AND BOUND FLIPPING
+ */
+
+/*
+ * Approximate value of a rational as a double
+ * - this is used only by the pricing heuristics so we don't need
+ *   q_get_double's exact rounding
+ */
+static double approx_double(rational_t *a) {
+  if (a->den != 0) {
+    return ((double) a->num)/a->den;
+  }
+  return q_get_double(a);
+}
+
+
+/*
+ * Forget all pricing weights
+ */
+static void forget_pricing_weights(simplex_solver_t *solver) {
+  ivector_t *v;
+  uint32_t i, n;
+  thvar_t x;
+
+  v = &solver->weighted;
+  n = v->size;
+  for (i=0; i<n; i++) {
+    x = v->data[i];
+    assert(0 <= x && x < solver->weight_size);
+    solver->weight[x] = -1.0;
+  }
+  ivector_reset(v);
+}
+
+
+/*
+ * Make the weight array large enough for all variables
+ * - the new weights are unknown
+ */
+static void resize_pricing_weights(simplex_solver_t *solver) {
+  uint32_t i, n;
+
+  n = solver->vtbl.nvars;
+  if (solver->weight_size < n) {
+    if (n >= UINT32_MAX/sizeof(double)) {
+      out_of_memory();
+    }
+    solver->weight = (double *) safe_realloc(solver->weight, n * sizeof(double));
+    for (i=solver->weight_size; i<n; i++) {
+      solver->weight[i] = -1.0;
+    }
+    solver->weight_size = n;
+  }
+}
+
+
+/*
+ * Set the weight of x to w
+ */
+static void set_pricing_weight(simplex_solver_t *solver, thvar_t x, double w) {
+  assert(0 <= x && x < solver->weight_size && w >= 0.0);
+
+  if (solver->weight[x] < 0.0) {
+    ivector_push(&solver->weighted, x);
+  }
+  solver->weight[x] = w;
+}
+
+
+/*
+ * Squared norm of a row: sum of the squared coefficients
+ * (the constant is ignored)
+ */
+static double row_norm2(row_t *row) {
+  double a, s;
+  uint32_t i, n;
+
+  s = 0.0;
+  n = row->size;
+  for (i=0; i<n; i++) {
+    if (row->data[i].c_idx > const_idx) {
+      a = approx_double(&row->data[i].coeff);
+      s += a * a;
+    }
+  }
+  return s;
+}
+
+
+/*
+ * Weight of the basic variable x
+ * - with steepest edge: the squared norm of x's row (computed on demand)
+ * - with devex: the reference weight of x (1.0 by default)
+ */
+static double pricing_weight(simplex_solver_t *solver, thvar_t x) {
+  matrix_t *matrix;
+  double w;
+
+  assert(0 <= x && x < solver->weight_size);
+
+  w = solver->weight[x];
+  if (w < 0.0) {
+    w = 1.0;
+    if (simplex_option_enabled(solver, SIMPLEX_STEEPEST_EDGE)) {
+      matrix = &solver->matrix;
+      w = row_norm2(matrix_row(matrix, matrix_basic_row(matrix, x)));
+    }
+    set_pricing_weight(solver, x, w);
+  }
+
+  return w;
+}
+
+
+/*
+ * Bound violation of x as a double
+ * - return 0.0 if x is within its bounds
+ * - if the violation is in the delta part only, we return a tiny positive number
+ */
+static double bound_violation(simplex_solver_t *solver, thvar_t x) {
+  xrational_t *v, *b;
+  double d;
+  int32_t k;
+
+  v = arith_var_value(&solver->vtbl, x);
+
+  k = arith_var_lower_index(&solver->vtbl, x);
+  if (k >= 0 && xq_gt(solver->bstack.bound + k, v)) {
+    b = solver->bstack.bound + k;
+    d = approx_double(&b->main) - approx_double(&v->main);
+    return d > 0.0 ? d : 1e-12;
+  }
+
+  k = arith_var_upper_index(&solver->vtbl, x);
+  if (k >= 0 && xq_lt(solver->bstack.bound + k, v)) {
+    b = solver->bstack.bound + k;
+    d = approx_double(&v->main) - approx_double(&b->main);
+    return d > 0.0 ? d : 1e-12;
+  }
+
+  return 0.0;
+}
+
+
+/*
+ * Select the next leaving variable and remove it from the infeasible_vars heap
+ * - return -1 if the heap is empty
+ * - by default or if Bland's rule is active: return the variable of smallest index
+ * - with steepest edge or devex pricing: examine the first SIMPLEX_PRICING_CANDIDATES
+ *   variables of the heap and return the one that maximizes violation^2/weight
+ */
+static thvar_t select_leaving_var(simplex_solver_t *solver) {
+  int_heap_t *heap;
+  double d, score, best_score;
+  uint32_t i, n;
+  thvar_t x, best;
+
+  heap = &solver->infeasible_vars;
+
+  if (solver->use_blands_rule ||
+      simplex_option_disabled(solver, SIMPLEX_STEEPEST_EDGE|SIMPLEX_DEVEX)) {
+    return int_heap_get_min(heap);
+  }
+
+  best = -1;
+  best_score = 0.0;
+  n = int_heap_nelems(heap);
+  if (n > SIMPLEX_PRICING_CANDIDATES) {
+    n = SIMPLEX_PRICING_CANDIDATES;
+  }
+  for (i=1; i<=n; i++) {
+    x = heap->heap[i];
+    d = bound_violation(solver, x);
+    if (d > 0.0) {
+      score = (d * d)/pricing_weight(solver, x);
+      if (best < 0 || score > best_score) {
+        best = x;
+        best_score = score;
+      }
+    }
+  }
+
+  if (best < 0) {
+    // the candidates are all feasible
+    return int_heap_get_min(heap);
+  }
+
+  int_heap_remove(heap, best);
+
+  return best;
+}
+
+
+/*
+ * Update the pricing weights before a pivoting step
+ * - x = leaving variable = basic variable of row r
+ * - y = entering variable = variable at index k in row r
+ *
+ * For steepest edge: the rows that contain y are about to change
+ * so their norms are forgotten.
+ *
+ * For devex, with a = coefficient of y in row r:
+ * - weight[z] := max(weight[z], (a_z/a)^2 weight[x]) for every basic variable z
+ *   whose row contains y with coefficient a_z
+ * - weight[y] := max(weight[x]/a^2, 1)
+ */
+static void update_pricing_weights(simplex_solver_t *solver, int32_t r, int32_t k, thvar_t x) {
+  matrix_t *matrix;
+  row_t *row;
+  column_t *col;
+  double a, ai, wx, w;
+  uint32_t i, n;
+  int32_t ri;
+  thvar_t y, z;
+
+  matrix = &solver->matrix;
+  row = matrix_row(matrix, r);
+  y = row->data[k].c_idx;
+  col = matrix->column[y];
+  n = col->size;
+
+  if (simplex_option_enabled(solver, SIMPLEX_STEEPEST_EDGE)) {
+    for (i=0; i<n; i++) {
+      ri = col->data[i].r_idx;
+      if (ri >= 0) {
+        z = matrix_basic_var(matrix, ri);
+        if (solver->weight[z] >= 0.0) {
+          solver->weight[z] = -1.0;
+        }
+      }
+    }
+    solver->weight[y] = -1.0;
+
+  } else {
+    assert(simplex_option_enabled(solver, SIMPLEX_DEVEX));
+
+    wx = pricing_weight(solver, x);
+    a = approx_double(&row->data[k].coeff);
+    for (i=0; i<n; i++) {
+      ri = col->data[i].r_idx;
+      if (ri >= 0 && ri != r) {
+        z = matrix_basic_var(matrix, ri);
+        ai = approx_double(matrix_coeff(matrix, ri, col->data[i].r_ptr))/a;
+        w = ai * ai * wx;
+        if (w > pricing_weight(solver, z)) {
+          set_pricing_weight(solver, z, w);
+        }
+      }
+    }
+    w = wx/(a * a);
+    set_pricing_weight(solver, y, w > 1.0 ? w : 1.0);
+  }
+}
+
+
+/*
+ * Start a new round of bound flipping
+ * - make the flip_stamp array large enough for all variables
+ * - increment flip_round so that all variables can be flipped again
+ */
+static void start_flip_round(simplex_solver_t *solver) {
+  uint32_t i, n;
+
+  n = solver->vtbl.nvars;
+  if (solver->flip_stamp_size < n) {
+    if (n >= UINT32_MAX/sizeof(uint32_t)) {
+      out_of_memory();
+    }
+    solver->flip_stamp = (uint32_t *) safe_realloc(solver->flip_stamp, n * sizeof(uint32_t));
+    for (i=solver->flip_stamp_size; i<n; i++) {
+      solver->flip_stamp[i] = 0;
+    }
+    solver->flip_stamp_size = n;
+  }
+
+  solver->flip_round ++;
+  if (solver->flip_round == 0) {
+    // wrap around: clear all stamps
+    for (i=0; i<solver->flip_stamp_size; i++) {
+      solver->flip_stamp[i] = 0;
+    }
+    solver->flip_round = 1;
+  }
+}
+
+
+/*
+ * Check whether the i-th variable y of row can be flipped to help x
+ * - x is the basic variable of row
+ * - if increase is true, x is below its lower bound otherwise x is above its upper bound
+ * - y can be flipped if it's bounded on both sides, not flipped yet in this
+ *   round, and it could be selected as entering variable
+ * - x = - sum a_i y_i: to increase x, y must decrease if a>0 or increase
+ *   if a<0. It's the opposite if x must decrease.
+ *
+ * If y can be flipped, the function returns true and stores
+ * - in *lower: true if y must move to its lower bound, false otherwise
+ * - in gain: the change in x when y is moved to that bound (gain > 0)
+ */
+static bool flip_candidate(simplex_solver_t *solver, row_t *row, uint32_t i, thvar_t x,
+                           bool increase, bool *lower, xrational_t *gain) {
+  arith_vartable_t *vtbl;
+  rational_t *a;
+  int32_t k;
+  thvar_t y;
+
+  vtbl = &solver->vtbl;
+  y = row->data[i].c_idx;
+  a = &row->data[i].coeff;
+  if (y <= const_idx || y == x || solver->flip_stamp[y] == solver->flip_round ||
+      arith_var_is_int(vtbl, y) ||
+      arith_var_lower_index(vtbl, y) < 0 || arith_var_upper_index(vtbl, y) < 0) {
+    return false;
+  }
+  if (increase ? !possible_entering_var_for_increase(vtbl, y, a) :
+      !possible_entering_var_for_decrease(vtbl, y, a)) {
+    return false;
+  }
+
+  *lower = (q_is_pos(a) == increase);
+  k = *lower ? arith_var_lower_index(vtbl, y) : arith_var_upper_index(vtbl, y);
+  xq_set(gain, arith_var_value(vtbl, y));
+  xq_sub(gain, solver->bstack.bound + k);
+  xq_mul(gain, a);
+  if (! increase) {
+    xq_neg(gain);
+  }
+  assert(xq_sgn(gain) > 0);
+
+  return true;
+}
+
+
+/*
+ * Bound flipping: try to fix the infeasible basic variable x without pivoting
+ * - row = x's row
+ * - if increase is true, x is below its lower bound otherwise x is above its upper bound
+ *
+ * The candidates are the non-basic variables of the row that are bounded
+ * on both sides and whose move can help x (cf. flip_candidate). If moving
+ * all of them to their opposite bound is not enough to bring x to its bound,
+ * nothing is done. Otherwise, the candidates are moved to their opposite
+ * bound one by one until x reaches its bound. The last move may stop
+ * between the two bounds (unless the variable is an integer variable).
+ *
+ * To prevent cycling, a variable is moved at most once per round (i.e.,
+ * per feasibility check).
+ *
+ * Return true if x is fixed, false otherwise.
+ */
+static bool try_bound_flips(simplex_solver_t *solver, row_t *row, thvar_t x, bool increase) {
+  arith_vartable_t *vtbl;
+  xrational_t remaining, gain, total;
+  uint32_t i, n;
+  int32_t k;
+  thvar_t y;
+  bool lower, fixed;
+
+  vtbl = &solver->vtbl;
+
+  xq_init(&remaining);
+  xq_init(&gain);
+  xq_init(&total);
+
+  // remaining = distance between x and its bound
+  if (increase) {
+    k = arith_var_lower_index(vtbl, x);
+    xq_set(&remaining, solver->bstack.bound + k);
+    xq_sub(&remaining, arith_var_value(vtbl, x));
+  } else {
+    k = arith_var_upper_index(vtbl, x);
+    xq_set(&remaining, arith_var_value(vtbl, x));
+    xq_sub(&remaining, solver->bstack.bound + k);
+  }
+  assert(xq_sgn(&remaining) > 0);
+
+  // first pass: check whether the candidates can fix x
+  fixed = false;
+  n = row->size;
+  for (i=0; i<n; i++) {
+    if (flip_candidate(solver, row, i, x, increase, &lower, &gain)) {
+      xq_add(&total, &gain);
+      if (xq_ge(&total, &remaining)) {
+        fixed = true;
+        break;
+      }
+    }
+  }
+
+  if (fixed) {
+    // second pass: move the candidates
+    fixed = false;
+    for (i=0; i<n; i++) {
+      if (flip_candidate(solver, row, i, x, increase, &lower, &gain)) {
+        y = row->data[i].c_idx;
+        if (xq_le(&gain, &remaining)) {
+          // move y to its opposite bound
+          if (lower) {
+            update_to_lower_bound(solver, y);
+          } else {
+            update_to_upper_bound(solver, y);
+          }
+          xq_sub(&remaining, &gain);
+        } else if (! arith_var_is_int(vtbl, y)) {
+          // move y by remaining/a: it stays strictly between its bounds
+          xq_set(&gain, &remaining);
+          xq_div(&gain, &row->data[i].coeff);
+          xq_set(&total, arith_var_value(vtbl, y));
+          if (increase) {
+            xq_sub(&total, &gain);
+          } else {
+            xq_add(&total, &gain);
+          }
+          update_non_basic_var_value(solver, y, &total);
+          clear_arith_var_lb(vtbl, y);
+          clear_arith_var_ub(vtbl, y);
+          xq_clear(&remaining); // remaining := 0
+        } else {
+          continue;
+        }
+
+        solver->flip_stamp[y] = solver->flip_round;
+        solver->stats.num_bound_flips ++;
+        if (xq_is_zero(&remaining)) {
+          fixed = true;
+          break;
+        }
+      }
+    }
+  }
+
+  if (fixed) {
+    assert(value_satisfies_bounds(solver, x));
+    solver->stats.num_flip_repairs ++;
+  } else {
+    // x may have been added to the heap again by the updates
+    int_heap_remove(&solver->infeasible_vars, x);
+  }
+
+  xq_clear(&remaining);
+  xq_clear(&gain);
+  xq_clear(&total);
+
+  return fixed;
+}
+
+
 /*
  * Check for feasibility:
  * - search for an assignment that satisfies all the bounds
@@ -4168,7 +4675,7 @@ static bool simplex_check_feasibility(simplex_solver_t *solver) {
   thvar_t x;
   int32_t r, k;
   uint32_t repeats, loops, bthreshold;
-  bool feasible;
+  bool feasible, pricing, flipping;
 
 #if TRACE
   printf("---> SIMPLEX: CHECK FEASIBILITY\n");
@@ -4197,6 +4704,19 @@ static bool simplex_check_feasibility(simplex_solver_t *solver) {
     bthreshold *= 100;
   }
 
+  /*
+   * Pricing weights are recomputed at every call.
+   */
+  pricing = simplex_option_enabled(solver, SIMPLEX_STEEPEST_EDGE|SIMPLEX_DEVEX);
+  if (pricing) {
+    resize_pricing_weights(solver);
+    forget_pricing_weights(solver);
+  }
+  flipping = simplex_option_enabled(solver, SIMPLEX_BOUND_FLIPPING);
+  if (flipping) {
+    start_flip_round(solver);
+  }
+
   for (;;) {
     // check interrupt at every iteration
     if (solver->interrupted) {
@@ -4211,7 +4731,7 @@ static bool simplex_check_feasibility(simplex_solver_t *solver) {
       }
     }
 
-    x = int_heap_get_min(&solver->infeasible_vars);
+    x = select_leaving_var(solver);
     if (x < 0) {
       feasible = true;
       break;
@@ -4226,6 +4746,10 @@ static bool simplex_check_feasibility(simplex_solver_t *solver) {
     k = -1;
 
     if (variable_below_lower_bound(solver, x)) {
+      if (flipping && !solver->use_blands_rule &&
+          try_bound_flips(solver, row, x, true)) {
+        continue;
+      }
       // find an entering variable that allows x to increase
       k = find_entering_var_for_increase(solver, row, x);
       if (k < 0) {
@@ -4237,12 +4761,18 @@ static bool simplex_check_feasibility(simplex_solver_t *solver) {
         break;
       } else {
         // pivot: make the entering variable basic
+        if (pricing) update_pricing_weights(solver, r, k, x);
+        if (solver->propagator != NULL) simplex_propagator_pivot(solver, r, k);
         matrix_pivot(matrix, r, k);
         update_to_lower_bound(solver, x);
         solver->stats.num_pivots ++;
       }
 
     } else if (variable_above_upper_bound(solver, x)) {
+      if (flipping && !solver->use_blands_rule &&
+          try_bound_flips(solver, row, x, false)) {
+        continue;
+      }
       // find an entering variable that allows x to decrease
       k = find_entering_var_for_decrease(solver, row, x);
       if (k < 0) {
@@ -4254,6 +4784,8 @@ static bool simplex_check_feasibility(simplex_solver_t *solver) {
         break;
       } else {
         // pivot: make the entering variable basic
+        if (pricing) update_pricing_weights(solver, r, k, x);
+        if (solver->propagator != NULL) simplex_propagator_pivot(solver, r, k);
         matrix_pivot(matrix, r, k);
         update_to_upper_bound(solver, x);
         solver->stats.num_pivots ++;
@@ -6270,6 +6802,7 @@ static void make_integer_vars_nonbasic(simplex_solver_t *solver) {
       row = matrix_row(matrix, i);
       k = find_real_var_in_row(solver, row);
       if (k >= 0) {
+        if (solver->propagator != NULL) simplex_propagator_pivot(solver, i, k);
         matrix_pivot(matrix, i, k);
         solver->stats.num_pivots ++;
 
@@ -8415,28 +8948,9 @@ static bool simplex_integrality_check(simplex_solver_t *solver) {
 
 
 
-#if 0
-
-// NOT READY FOR PRIME TIME.
-
-/*
- * MIXED-INTEGER GOMORY CUTS
- */
-
 /*
- * When we create atoms on the fly for an existing variables,
- * we reset the prop_ptr so that we can propagate the new atom if necessary.
- * - we reset the pointer to what's saved for the current base_level in the trail stack.
+ * CUTTING PLANES
  */
-static void reset_prop_ptr(simplex_solver_t *solver) {
-  if (solver->base_level == 0) {
-    assert(solver->trail_stack.top == 0);
-    solver->bstack.prop_ptr = 0;
-  } else {
-    assert(solver->trail_stack.top > 0);
-    solver->bstack.prop_ptr = arith_trail_top(&solver->trail_stack)->bound_ptr;
-  }
-}
 
 /*
  * Build atom (x >= c) or (x <= c) on the fly
@@ -8473,8 +8987,9 @@ static literal_t mk_dynamic_le_atom(simplex_solver_t *solver, thvar_t x, bool is
 
 /*
  * Build an atom equivalent to p >= 0.
+ * - p is stored in solver->buffer
  */
-static literal_t mk_gomory_atom(simplex_solver_t *solver) {
+static literal_t mk_cut_atom(simplex_solver_t *solver) {
   poly_buffer_t *b;
   bool negated, is_int;
   thvar_t x;
@@ -8517,83 +9032,53 @@ static literal_t mk_gomory_atom(simplex_solver_t *solver) {
 
 
 /*
- * Literal for an assumption: x >= a
- * - x is an existing variable
- * - is_int indicates whether x is an integer
+ * Check whether the premises of cut c are implied by the current bounds
  */
-static literal_t assumed_lb(simplex_solver_t *solver, thvar_t x, bool is_int, rational_t *a) {
+static bool cut_premises_hold(simplex_solver_t *solver, cut_t *c) {
+  uint32_t i, n;
   int32_t k;
-  literal_t l;
+  thvar_t x;
 
-  k = arith_var_lower_index(&solver->vtbl, x);
-  if (k >= 0 && xq_eq_q(solver->bstack.bound + k, a)) {
-    // this is the current bound on x
-    if (solver->decision_level == solver->base_level) {
-      return true_literal;
-    }
-    if (solver->bstack.tag[k] == ARITH_AXIOM_LB) {
-      return true_literal;
-    }
-    if (solver->bstack.tag[k] == ARITH_ASSERTED_LB) {
-      return solver->bstack.expl[k].lit;
+  n = c->nbounds;
+  for (i=0; i<n; i++) {
+    x = c->var[i];
+    if (c->tag[i] & GOMORY_BTYPE_MASK) {
+      k = arith_var_lower_index(&solver->vtbl, x);
+      if (k < 0 || xq_lt_q(solver->bstack.bound + k, c->bound + i)) return false;
+    } else {
+      k = arith_var_upper_index(&solver->vtbl, x);
+      if (k < 0 || xq_gt_q(solver->bstack.bound + k, c->bound + i)) return false;
     }
   }
 
-  // in all other cases, create a new atom
-  l = mk_dynamic_ge_atom(solver, x, is_int, a);
-  reset_prop_ptr(solver);
-
-  return l;
+  return true;
 }
 
 
 /*
- * Same thing for an assumption x <= a
+ * Add cut c as a clause:
+ * - the premises must hold
+ *
+ * In general, we add a clause of the form
+ *   (not l_1) \/ ... \/ (not l_n) \/ (p >= 0)
+ *
+ * where l_1 ... l_n are the literals that explain the current bounds on
+ * the premise variables. The current bounds may be stronger than the
+ * bounds that were used to construct the cut. At the base level, the
+ * premises hold until the next pop so they're omitted.
  */
-static literal_t assumed_ub(simplex_solver_t *solver, thvar_t x, bool is_int, rational_t *a) {
+static void add_cut(simplex_solver_t *solver, cut_t *c) {
+  ivector_t *v, *queue;
+  uint32_t i, n;
   int32_t k;
-  literal_t l;
-
-  k = arith_var_upper_index(&solver->vtbl, x);
-  if (k >= 0 && xq_eq_q(solver->bstack.bound + k, a)) {
-    // this is the current bound on x
-    if (solver->decision_level == solver->base_level) {
-      return true_literal;
-    }
-    if (solver->bstack.tag[k] == ARITH_AXIOM_UB) {
-      return true_literal;
-    }
-    if (solver->bstack.tag[k] == ARITH_ASSERTED_UB) {
-      return solver->bstack.expl[k].lit;
-    }
-  }
-
-  // in all other case, create a new atom
-  l = mk_dynamic_le_atom(solver, x, is_int, a);
-  reset_prop_ptr(solver);
-
-  return l;
-}
+  literal_t cut;
 
+  assert(cut_premises_hold(solver, c));
 
-
-/*
- * Add a Gomory cut
- * - simplex->buffer contains a polynomial p
- * - the cut is (p >= 0)
- * - this cut is implied by bounds on the variables stored in *c
- *
- * In general, we add a clause of the form
- *   (x_1 >= l_1) /\ ... /\ (x_k >= l_k) /\ ... (x_n <= u_n) => (p >= 0).
- *
- */
-static void add_gomory_cut(simplex_solver_t *solver, gomory_vector_t *g) {
-  ivector_t *v;
-  uint32_t i, n, x;
-  bool is_int;
-  literal_t l, cut;
-
-  cut = mk_gomory_atom(solver);
+  assert(poly_buffer_nterms(&solver->buffer) == 0);
+  poly_buffer_add_poly(&solver->buffer, c->poly);
+  normalize_poly_buffer(&solver->buffer);
+  cut = mk_cut_atom(solver);
 
 #if TRACE
   printf("---> cut atom:\n");
@@ -8606,155 +9091,501 @@ static void add_gomory_cut(simplex_solver_t *solver, gomory_vector_t *g) {
   ivector_reset(v);
 
   if (solver->decision_level > solver->base_level) {
-    n = g->nelems;
+    queue = &solver->expl_queue;
+    assert(queue->size == 0);
+    n = c->nbounds;
     for (i=0; i<n; i++) {
-      x = g->var[i];
-      is_int = gomory_var_is_int(g, i);
-      assert(is_int == arith_var_is_int(&solver->vtbl, x));
-      if (gomory_bound_is_lb(g, i)) {
-	l = assumed_lb(solver, x, is_int, g->bound + i);
+      if (c->tag[i] & GOMORY_BTYPE_MASK) {
+	k = arith_var_lower_index(&solver->vtbl, c->var[i]);
       } else {
-	l = assumed_ub(solver, x, is_int, g->bound + i);
-      }
-      if (l != true_literal) {
-	ivector_push(v, not(l));
+	k = arith_var_upper_index(&solver->vtbl, c->var[i]);
       }
+      assert(k >= 0);
+      enqueue_cnstr_index(queue, k, &solver->bstack);
     }
+    simplex_build_explanation(solver, v);
+    convert_expl_to_clause(v);
   }
 
   ivector_push(v, cut);
-  
+
   add_clause(solver->core, v->size, v->data);
+  solver->stats.num_cuts ++;
 
 #if TRACE
-  printf("---> Gomory clause:\n");
+  printf("---> cut clause:\n");
   print_litarray(stdout, v->size, v->data);
   printf("\n");
-  n = v->size - 1;
-  if (n > 0) {
-    for (i=0; i<n; i++) {
-      printf("     ");
-      print_simplex_atomdef(stdout, solver, var_of(v->data[i]));
+#endif
+}
+
+
+/*
+ * Check whether the cut (p >= 0) is violated by the current assignment
+ * - a = monomials of p, terminated by the end marker
+ * - sqnorm = squared Euclidean norm of p's coefficients
+ * - if p is violated, return true and store the square of its efficacy
+ *   in *sq_efficacy. The efficacy is the distance between the current
+ *   assignment and the hyperplane p = 0, ignoring the delta part of the
+ *   assignment.
+ */
+static bool cut_is_violated(simplex_solver_t *solver, monomial_t *a, double sqnorm, double *sq_efficacy) {
+  double d;
+  xrational_t *v;
+
+  v = &solver->xq0;
+  xq_clear(v);
+  while (a->var != max_idx) {
+    if (a->var == const_idx) {
+      xq_add_q(v, &a->coeff);
+    } else {
+      xq_addmul(v, arith_var_value(&solver->vtbl, a->var), &a->coeff);
     }
+    a ++;
   }
-  printf("---> cut atom:\n");
-  printf("     ");
-  print_simplex_atomdef(stdout, solver, var_of(cut));
-  printf("\n");
-#endif
 
+  if (xq_sgn(v) < 0) {
+    d = q_get_double(&v->main);
+    *sq_efficacy = (d * d)/sqnorm;
+    return true;
+  }
+
+  return false;
+}
+
+
+/*
+ * Check whether the cut stored in solver->buffer is usable and violated
+ * - it must contain at least one variable
+ * - the cut atom is built from p's integral form (p multiplied by the
+ *   lcm of the denominators of its non-constant coefficients). To avoid
+ *   numerical blow up in the tableau, all the coefficients in this form
+ *   must be no more than MAX_CUT_COEFF in absolute value.
+ * - the cut's efficacy must be at least solver->cut_min_efficacy.
+ * If so, return true and store the square of its efficacy in *sq_efficacy.
+ */
+#define MAX_CUT_COEFF 1000
+
+static inline bool efficacious_cut(simplex_solver_t *solver, double sq_efficacy) {
+  return sq_efficacy >= solver->cut_min_efficacy * solver->cut_min_efficacy;
+}
+
+static bool small_integral_coeffs(monomial_t *a, uint32_t n) {
+  rational_t lcm, aux;
+  uint32_t i;
+  int32_t c;
+  bool small;
+
+  q_init(&lcm);
+  q_init(&aux);
+  q_set_one(&lcm);
+  for (i=0; i<n; i++) {
+    if (a[i].var != const_idx) {
+      q_get_den(&aux, &a[i].coeff);
+      q_lcm(&lcm, &aux);
+    }
+  }
+
+  small = true;
+  for (i=0; i<n && small; i++) {
+    if (a[i].var != const_idx) {
+      q_set_abs(&aux, &a[i].coeff);
+      q_mul(&aux, &lcm);
+      small = q_get32(&aux, &c) && c <= MAX_CUT_COEFF;
+    }
+  }
+
+  q_clear(&aux);
+  q_clear(&lcm);
+
+  return small;
+}
+
+static bool good_cut(simplex_solver_t *solver, double *sq_efficacy) {
+  poly_buffer_t *b;
+  monomial_t *a;
+  uint32_t n;
 
+  b = &solver->buffer;
+  a = poly_buffer_mono(b);
+  n = poly_buffer_nterms(b);
+  assert(a[n].var == max_idx);
+
+  return n > 0 && (n > 1 || a[0].var != const_idx) &&
+    small_integral_coeffs(a, n) &&
+    cut_is_violated(solver, a, monarray_sqnorm(a), sq_efficacy) &&
+    efficacious_cut(solver, *sq_efficacy);
 }
 
 
 /*
- * Try a Gomory cut based on basic variable x
+ * Collect the data for a Gomory cut from the row of basic variable x
  * - x must be an integer variable with a non-integer value
+ * - all non-basic variables in the row must have an integer value
+ *   if they are integer variables
+ * - all the variables that are not integer or that have a non-integer
+ *   coefficient must be at a bound, and the bound must be rational
+ * - return false if that's not the case
  */
-static bool try_gomory_cut_for_var(simplex_solver_t *solver, gomory_vector_t *g, thvar_t x) {
+static bool collect_gomory_vector(simplex_solver_t *solver, gomory_vector_t *g, row_t *row, thvar_t x) {
   arith_vartable_t *vtbl;
-  row_t *row;
   rational_t *a;
   xrational_t *val;
   uint32_t i, n;
-  int32_t r;
   thvar_t y;
   bool is_int;
   bool is_lb;
 
-  assert(arith_var_is_int(&solver->vtbl, x) && 
-	 !arith_var_value_is_int(&solver->vtbl, x));
-
   vtbl = &solver->vtbl;
 
-  r = matrix_basic_row(&solver->matrix, x);
-  assert(r >= 0);
-  row = matrix_row(&solver->matrix, r);
-
   n = row->size;
   for (i=0; i<n; i++) {
     y = row->data[i].c_idx;
-    if (y >= 0) {
+    if (y >= 0 && y != x) {
       a = &row->data[i].coeff;
       is_int = arith_var_is_int(vtbl, y);
       if (! (is_int && q_is_integer(a))) {
 	/*
 	 * Process term a * y where either y is not an integer variable
-	 * or a is not an integer constant.
+	 * or a is not an integer constant. The bound on y is y's value.
+	 * The constant is treated as a variable fixed to 1.
 	 */
-	assert(y != x);
-	// the bound on y is y's value
 	val = arith_var_value(vtbl, y);
 	if (! xq_is_rational(val)) {
-	  // can't handle non-rational bounds
 	  return false;
 	}
-	is_lb = variable_at_lower_bound(solver, y);
-	gomory_vector_add_elem(g, y, a, &val->main, is_int, is_lb);
+	if (y == const_idx || variable_at_lower_bound(solver, y)) {
+	  is_lb = true;
+	} else if (variable_at_upper_bound(solver, y)) {
+	  is_lb = false;
+	} else {
+	  return false;
+	}
+	gomory_vector_add_elem(g, y, a, &val->main, is_int && y != const_idx, is_lb);
+      }
+    }
+  }
 
-#if TRACE
-	print_simplex_var(stdout, solver, y);
-	printf(" = ");
-	print_simplex_var_value(stdout, solver, y);
-	printf("; ");
-	print_simplex_var_bounds(stdout, solver, y);
-	fflush(stdout);
-#endif
+  return true;
+}
+
+
+/*
+ * Collect the data for an MIR cut from a row:
+ * - the row is sum a_i x_i = 0: we store sum a_i x_i for all
+ *   non-constant x_i in g and the opposite of the constant in beta
+ * - the bound for x_i is the closest bound to x_i's current value
+ *   (it must be a rational bound)
+ * - return false if some variable has no rational bound
+ */
+static bool collect_mir_vector(simplex_solver_t *solver, gomory_vector_t *g, row_t *row, rational_t *beta) {
+  arith_vartable_t *vtbl;
+  xrational_t *lb, *ub;
+  rational_t *a;
+  double v;
+  uint32_t i, n;
+  int32_t l, u;
+  thvar_t y;
+  bool is_int;
+
+  vtbl = &solver->vtbl;
+
+  q_clear(beta);
+  n = row->size;
+  for (i=0; i<n; i++) {
+    y = row->data[i].c_idx;
+    if (y < 0) continue;
+
+    a = &row->data[i].coeff;
+    if (y == const_idx) {
+      q_set_neg(beta, a);
+      continue;
+    }
+
+    is_int = arith_var_is_int(vtbl, y);
+    lb = NULL;
+    ub = NULL;
+    l = arith_var_lower_index(vtbl, y);
+    if (l >= 0 && xq_is_rational(solver->bstack.bound + l)) {
+      lb = solver->bstack.bound + l;
+    }
+    u = arith_var_upper_index(vtbl, y);
+    if (u >= 0 && xq_is_rational(solver->bstack.bound + u)) {
+      ub = solver->bstack.bound + u;
+    }
+
+    if (lb != NULL && ub != NULL) {
+      v = q_get_double(&arith_var_value(vtbl, y)->main);
+      if (v - q_get_double(&lb->main) <= q_get_double(&ub->main) - v) {
+	ub = NULL;
+      } else {
+	lb = NULL;
+      }
+    }
+
+    if (lb != NULL) {
+      assert(! is_int || q_is_integer(&lb->main));
+      gomory_vector_add_elem(g, y, a, &lb->main, is_int, true);
+    } else if (ub != NULL) {
+      assert(! is_int || q_is_integer(&ub->main));
+      gomory_vector_add_elem(g, y, a, &ub->main, is_int, false);
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Scaling factors for MIR cuts: we use 1/d where d = 1 or d is the
+ * absolute value of the coefficient of an integer variable that's not
+ * at its bound.
+ * - the factors are stored in array scale (which must be large enough
+ *   for SIMPLEX_MIR_SCALES rationals, all initialized)
+ * - return the number of distinct factors (at most SIMPLEX_MIR_SCALES)
+ */
+static uint32_t collect_mir_scales(simplex_solver_t *solver, gomory_vector_t *g, rational_t *scale) {
+  uint32_t i, j, k, n;
+
+  q_set_one(scale + 0);
+  k = 1;
+
+  n = g->nelems;
+  for (i=0; i<n && k < SIMPLEX_MIR_SCALES; i++) {
+    if (gomory_var_is_int(g, i) && q_is_nonzero(g->coeff + i) &&
+	! xq_eq_q(arith_var_value(&solver->vtbl, g->var[i]), g->bound + i)) {
+      q_set_abs(scale + k, g->coeff + i);
+      q_inv(scale + k);
+      for (j=0; j<k; j++) {
+	if (q_eq(scale + j, scale + k)) break;
       }
+      if (j == k) k ++;
     }
   }
 
+  return k;
+}
+
+
+/*
+ * Try a Gomory cut then an MIR cut based on the row of basic variable x
+ * - x must be an integer variable with a non-integer value
+ * - the cuts are added to the pool (if they're good enough)
+ * - g = buffer for the cut construction
+ */
+static void generate_cuts_for_var(simplex_solver_t *solver, cut_pool_t *pool, gomory_vector_t *g, thvar_t x) {
+  row_t *row;
+  rational_t beta, best_s;
+  rational_t scale[SIMPLEX_MIR_SCALES];
+  double sq_efficacy, best;
+  uint32_t i, n;
+  int32_t r;
+
+  assert(arith_var_is_int(&solver->vtbl, x) &&
+	 !arith_var_value_is_int(&solver->vtbl, x));
+
+  r = matrix_basic_row(&solver->matrix, x);
+  assert(r >= 0);
+  row = matrix_row(&solver->matrix, r);
+
   /*
-   * Build the cut: terms >= bound
-   * - terms are stored in solver->buffer
-   * - the bound is stored in solver->aux
+   * Gomory cut: this works only if the relevant variables
+   * are at a bound.
    */
-  if (make_gomory_cut(g, &solver->buffer)) {
+  reset_gomory_vector(g);
+  if (collect_gomory_vector(solver, g, row, x) &&
+      make_gomory_cut(g, &solver->buffer) &&
+      good_cut(solver, &sq_efficacy)) {
 #if TRACE
-    printf("---> Gomory cut:\n");    
+    printf("---> Gomory cut on row of ");
+    print_simplex_var(stdout, solver, x);
+    printf(": ");
     print_simplex_buffer(stdout, solver);
     printf(" >= 0\n");
     fflush(stdout);
 #endif
-    // deal with it
-    add_gomory_cut(solver, g);
+    (void) cut_pool_add(pool, &solver->buffer, g, sq_efficacy);
+    solver->stats.num_gomory_cuts ++;
   }
-
-  // cleanup
   reset_poly_buffer(&solver->buffer);
 
-  return true;
+  /*
+   * MIR cut: try all scaling factors s and -s, and keep the best cut.
+   */
+  reset_gomory_vector(g);
+  q_init(&beta);
+  q_init(&best_s);
+  for (i=0; i<SIMPLEX_MIR_SCALES; i++) {
+    q_init(scale + i);
+  }
+
+  if (collect_mir_vector(solver, g, row, &beta)) {
+    best = 0.0;
+    n = collect_mir_scales(solver, g, scale);
+    for (i=0; i<2*n; i++) {
+      if (make_mir_cut(g, &beta, scale + (i>>1), &solver->buffer) &&
+	  good_cut(solver, &sq_efficacy) && sq_efficacy > best) {
+	best = sq_efficacy;
+	q_set(&best_s, scale + (i>>1));
+      }
+      reset_poly_buffer(&solver->buffer);
+      q_neg(scale + (i>>1));
+    }
+
+    if (best > 0.0) {
+      (void) make_mir_cut(g, &beta, &best_s, &solver->buffer);
+#if TRACE
+      printf("---> MIR cut on row of ");
+      print_simplex_var(stdout, solver, x);
+      printf(": ");
+      print_simplex_buffer(stdout, solver);
+      printf(" >= 0\n");
+      fflush(stdout);
+#endif
+      (void) cut_pool_add(pool, &solver->buffer, g, best);
+      solver->stats.num_mir_cuts ++;
+    }
+    reset_poly_buffer(&solver->buffer);
+  }
+
+  for (i=0; i<SIMPLEX_MIR_SCALES; i++) {
+    q_clear(scale + i);
+  }
+  q_clear(&beta);
+  q_clear(&best_s);
+  reset_gomory_vector(g);
 }
 
+
 /*
- * Scan variables of v and try a Gomory cut for them
- * - each element of v must be a basic integer variable
- *   with a non-integer value.
- * - max_cuts = bound on the total number of cuts
+ * Ordering of the rows for cut generation:
+ * - x is before y if x's value is closer to one half than y's
+ */
+static double fractionality(simplex_solver_t *solver, thvar_t x) {
+  double v;
+
+  q_set(&solver->aux, &arith_var_value(&solver->vtbl, x)->main);
+  q_floor(&solver->aux);
+  v = q_get_double(&arith_var_value(&solver->vtbl, x)->main) - q_get_double(&solver->aux);
+  return v <= 0.5 ? v : 1.0 - v;
+}
+
+static bool more_fractional(void *data, int32_t x, int32_t y) {
+  return fractionality(data, x) > fractionality(data, y);
+}
+
+
+/*
+ * Ordering of the cuts: decreasing efficacy
+ */
+static bool more_efficacious(void *data, void *c1, void *c2) {
+  return ((cut_t *) c1)->sq_efficacy > ((cut_t *) c2)->sq_efficacy;
+}
+
+
+/*
+ * Check whether cut c is more parallel than allowed to one of the cuts in v
+ */
+static bool cut_parallel_to_any(simplex_solver_t *solver, cut_t *c, pvector_t *v) {
+  uint32_t i, n;
+
+  n = v->size;
+  for (i=0; i<n; i++) {
+    if (cuts_are_parallel(c, v->data[i], solver->cut_max_parallelism)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+/*
+ * Round of cut generation
+ * - v = the integer basic variables that have a non-integer value
+ * - we generate Gomory and MIR cuts from the rows of the most fractional
+ *   variables of v and store them in the pool
+ * - then we add the best cuts from the pool: the cuts must be violated by
+ *   the current assignment, their premises must hold, and they must not be
+ *   too parallel to each other.
  * - return the number of cuts added
  */
-static uint32_t try_gomory_cuts(simplex_solver_t *solver, ivector_t *v, uint32_t max_cuts) {
-  gomory_vector_t cut;
-  uint32_t i, n, num_cuts;
+static uint32_t simplex_add_cuts(simplex_solver_t *solver, ivector_t *v) {
+  cut_pool_t *pool;
+  gomory_vector_t g;
+  ivector_t rows;
+  pvector_t candidates, selected;
+  cut_t *c;
+  uint32_t i, n;
+
+  pool = simplex_get_cut_pool(solver);
+  cut_pool_next_round(pool);
 
 #if TRACE
-  printf("\nTRY GOMORY CUTS: dlevel = %"PRIu32", base_level = %"PRIu32"\n", solver->decision_level, solver->base_level);
+  printf("\nCUT ROUND %"PRIu32": dlevel = %"PRIu32", base_level = %"PRIu32"\n",
+	 pool->round, solver->decision_level, solver->base_level);
   fflush(stdout);
 #endif
 
-  init_gomory_vector(&cut);
-  num_cuts = 0;
-  n = v->size;
+  /*
+   * Generate new cuts
+   * - v is sorted in a copy: the order of v matters for branching
+   */
+  init_ivector(&rows, v->size);
+  ivector_copy(&rows, v->data, v->size);
+  int_array_sort2(rows.data, rows.size, solver, more_fractional);
+  n = rows.size;
+  if (n > SIMPLEX_CUT_ROWS_FACTOR * solver->max_cuts) {
+    n = SIMPLEX_CUT_ROWS_FACTOR * solver->max_cuts;
+  }
+  init_gomory_vector(&g);
   for (i=0; i<n; i++) {
-    num_cuts += try_gomory_cut_for_var(solver, &cut, v->data[i]);
-    if (num_cuts >= max_cuts) break;
+    generate_cuts_for_var(solver, pool, &g, rows.data[i]);
   }
-  delete_gomory_vector(&cut);
+  delete_gomory_vector(&g);
+  delete_ivector(&rows);
 
-  return num_cuts;  
-}
+  /*
+   * Select the cuts to add
+   */
+  init_pvector(&candidates, 0);
+  n = pool->ncuts;
+  for (i=0; i<n; i++) {
+    c = pool->data[i];
+    if (cut_is_violated(solver, c->poly->mono, c->sqnorm, &c->sq_efficacy) &&
+	efficacious_cut(solver, c->sq_efficacy) &&
+	cut_premises_hold(solver, c)) {
+      pvector_push(&candidates, c);
+    }
+  }
+  ptr_array_sort2(candidates.data, candidates.size, NULL, more_efficacious);
+
+  init_pvector(&selected, 0);
+  n = candidates.size;
+  for (i=0; i<n && selected.size < solver->max_cuts; i++) {
+    c = candidates.data[i];
+    if (! cut_parallel_to_any(solver, c, &selected)) {
+      if (c->stamp != pool->round) {
+	solver->stats.num_pool_cuts ++;
+      }
+      c->stamp = pool->round;
+      add_cut(solver, c);
+      pvector_push(&selected, c);
+    }
+  }
+  n = selected.size;
 
-#endif
+  delete_pvector(&selected);
+  delete_pvector(&candidates);
+
+  if (n > 0) {
+    solver->stats.num_cut_rounds ++;
+  }
+
+  return n;
+}
 
 
 
@@ -8858,7 +9689,7 @@ static bool simplex_intfeas_iter_strengthening(simplex_solver_t *solver) {
 static bool simplex_make_integer_feasible(simplex_solver_t *solver) {
   ivector_t *v;
   thvar_t x;
-  uint32_t nbounds, bb_score;
+  uint32_t nbounds, bb_score, ncuts;
 
 #if TRACE_BB
   printf("\n--- make integer feasible [dlevel = %"PRIu32", decisions = %"PRIu64"]: %"PRId32
@@ -8938,7 +9769,22 @@ static bool simplex_make_integer_feasible(simplex_solver_t *solver) {
   }
 
   /*
-   * Create a branch atom or add gomory cuts
+   * Add cuts if enabled: after max_cut_rounds rounds of cuts, or if no
+   * cut can be added, we create a branch atom.
+   */
+  if (simplex_option_enabled(solver, SIMPLEX_CUTS) && solver->cut_rounds < solver->max_cut_rounds) {
+    solver->cut_rounds ++;
+    ncuts = simplex_add_cuts(solver, v);
+    if (ncuts > 0) {
+      tprintf(solver->core->trace, 10, "(cuts: %"PRIu32" candidates, %"PRIu32" cuts)\n", v->size, ncuts);
+      ivector_reset(v);
+      return false;
+    }
+  }
+  solver->cut_rounds = 0;
+
+  /*
+   * Create a branch atom
    */
   x = select_branch_variable(solver, v, &bb_score);
   tprintf(solver->core->trace, 10,
@@ -9548,6 +10394,132 @@ void simplex_start_internalization(simplex_solver_t *solver) {
 
 
 
+/*******************************
+ *  FLOATING-POINT WARM START  *
+ ******************************/
+
+/*
+ * Copy the tableau and the bounds into fp
+ * - the delta part of strict bounds is ignored
+ */
+static void simplex_load_fp_tableau(simplex_solver_t *solver, fp_simplex_t *fp) {
+  matrix_t *matrix;
+  arith_vartable_t *vtbl;
+  xrational_t *bound;
+  row_t *row;
+  uint32_t i, j, n, m, r;
+  int32_t k;
+  thvar_t x;
+
+  matrix = &solver->matrix;
+  vtbl = &solver->vtbl;
+  bound = solver->bstack.bound;
+
+  n = vtbl->nvars;
+  m = matrix->nrows;
+  init_fp_simplex(fp, n, m);
+
+  for (i=0; i<m; i++) {
+    r = fp_simplex_add_row(fp, matrix_basic_var(matrix, i));
+    row = matrix_row(matrix, i);
+    for (j=0; j<row->size; j++) {
+      x = row->data[j].c_idx;
+      if (x >= 0) {
+        fp_simplex_row_add(fp, r, x, approx_double(&row->data[j].coeff));
+      }
+    }
+  }
+
+  for (x=1; x<n; x++) {
+    k = arith_var_lower_index(vtbl, x);
+    if (k >= 0) {
+      fp_simplex_set_lb(fp, x, approx_double(&bound[k].main));
+    }
+    k = arith_var_upper_index(vtbl, x);
+    if (k >= 0) {
+      fp_simplex_set_ub(fp, x, approx_double(&bound[k].main));
+    }
+  }
+}
+
+
+/*
+ * Pivot the exact tableau to the basis computed in fp:
+ * - for every variable y that's basic in fp but not in the matrix,
+ *   we search for a row where y occurs and whose basic variable is
+ *   non-basic in fp. If there's such a row, we pivot.
+ * - return the number of pivots
+ */
+static uint32_t simplex_load_fp_basis(simplex_solver_t *solver, fp_simplex_t *fp) {
+  matrix_t *matrix;
+  column_t *col;
+  uint32_t i, n, npivots;
+  int32_t r;
+  thvar_t x, y;
+
+  matrix = &solver->matrix;
+  npivots = 0;
+
+  n = solver->vtbl.nvars;
+  for (y=1; y<n; y++) {
+    if (fp_simplex_is_basic(fp, y) && matrix_is_nonbasic_var(matrix, y)) {
+      col = matrix_column(matrix, y);
+      if (col != NULL) {
+        for (i=0; i<col->size; i++) {
+          r = col->data[i].r_idx;
+          if (r >= 0) {
+            x = matrix_basic_var(matrix, r);
+            if (! fp_simplex_is_basic(fp, x)) {
+              matrix_pivot(matrix, r, col->data[i].r_ptr);
+              npivots ++;
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return npivots;
+}
+
+
+/*
+ * Warm start: search for a feasible basis in floating point then
+ * load it into the exact tableau.
+ * - the basis is not loaded if the floating-point search fails: loading
+ *   it may cost many exact pivots for nothing
+ * - return true if the basis is loaded, false otherwise
+ * - fp must be deleted by the caller
+ * - this must be called before the initial assignment is computed
+ *   (if the basis is loaded, fp is then used to select the initial
+ *   values of non-basic variables)
+ */
+static bool simplex_fp_warm_start(simplex_solver_t *solver, fp_simplex_t *fp) {
+  uint32_t max_pivots, npivots;
+  bool feasible;
+
+  simplex_load_fp_tableau(solver, fp);
+  fp_simplex_init_assignment(fp);
+
+  max_pivots = SIMPLEX_FP_PIVOT_FACTOR * solver->matrix.nrows + SIMPLEX_FP_MIN_PIVOTS;
+  feasible = fp_simplex_make_feasible(fp, max_pivots);
+  solver->stats.num_fp_pivots += fp_simplex_num_pivots(fp);
+
+  npivots = 0;
+  if (feasible && fp_simplex_num_pivots(fp) > 0) {
+    npivots = simplex_load_fp_basis(solver, fp);
+    solver->stats.num_warm_pivots += npivots;
+  }
+
+  tprintf(solver->core->trace, 12, "(fp warm start: %s, %"PRIu32" fp pivots, %"PRIu32" exact pivots)\n",
+          feasible ? "feasible" : "not feasible", fp_simplex_num_pivots(fp), npivots);
+
+  return feasible;
+}
+
+
+
 /******************
  *  START SEARCH  *
  *****************/
@@ -9559,6 +10531,7 @@ void simplex_start_internalization(simplex_solver_t *solver) {
  * - compute the initial assignment
  */
 void simplex_start_search(simplex_solver_t *solver) {
+  fp_simplex_t fp;
   bool feasible;
 
 #if TRACE
@@ -9630,7 +10603,16 @@ void simplex_start_search(simplex_solver_t *solver) {
 
   // compute the initial variable assignment
   reset_int_heap(&solver->infeasible_vars);
-  simplex_init_assignment(solver);
+  if (simplex_option_enabled(solver, SIMPLEX_FP_WARM_START)) {
+    if (simplex_fp_warm_start(solver, &fp)) {
+      simplex_init_assignment(solver, &fp);
+    } else {
+      simplex_init_assignment(solver, NULL);
+    }
+    delete_fp_simplex(&fp);
+  } else {
+    simplex_init_assignment(solver, NULL);
+  }
   feasible = simplex_make_feasible(solver);
   if (! feasible) goto done;
 
@@ -9995,6 +10977,11 @@ static void simplex_go_back(simplex_solver_t *solver, uint32_t back_level) {
   assert(undo->n_bounds <= bstack->prop_ptr && bstack->prop_ptr <= bstack->fix_ptr &&
          bstack->fix_ptr <= bstack->top);
 
+  // the propagator's row bounds depend on the bounds to be removed
+  if (solver->propagator != NULL) {
+    simplex_propagator_backtrack(solver, undo->n_bounds);
+  }
+
   i = bstack->top;
 
   /*
@@ -10344,6 +11331,12 @@ void simplex_pop(simplex_solver_t *solver) {
     cache_pop(solver->cache);
   }
 
+  // the cuts may refer to variables that were just removed
+  if (solver->cut_pool != NULL) {
+    reset_cut_pool(solver->cut_pool);
+  }
+  solver->cut_rounds = 0;
+
   // restore the propagation pointers
   solver->bstack.prop_ptr = top->bound_ptr;
   solver->bstack.fix_ptr = top->bound_ptr;
@@ -10418,6 +11411,11 @@ void simplex_reset(simplex_solver_t *solver) {
     reset_dsolver(solver->dsolver);
   }
 
+  if (solver->cut_pool != NULL) {
+    reset_cut_pool(solver->cut_pool);
+  }
+  solver->cut_rounds = 0;
+
   if (solver->cache != NULL) {
     reset_cache(solver->cache);
   }
@@ -10458,6 +11456,8 @@ void simplex_reset(simplex_solver_t *solver) {
   ivector_reset(&solver->aux_vector2);
   ivector_reset(&solver->rows_to_process);
 
+  forget_pricing_weights(solver);
+
   // empty arena
   arena_reset(&solver->arena);
 
@@ -10661,6 +11661,12 @@ void delete_simplex_solver(simplex_solver_t *solver) {
     solver->dsolver = NULL;
   }
 
+  if (solver->cut_pool != NULL) {
+    delete_cut_pool(solver->cut_pool);
+    safe_free(solver->cut_pool);
+    solver->cut_pool = NULL;
+  }
+
   if (solver->cache != NULL) {
     delete_cache(solver->cache);
     safe_free(solver->cache);
@@ -10696,6 +11702,12 @@ void delete_simplex_solver(simplex_solver_t *solver) {
   delete_ivector(&solver->aux_vector2);
   delete_ivector(&solver->rows_to_process);
 
+  safe_free(solver->weight);
+  solver->weight = NULL;
+  delete_ivector(&solver->weighted);
+  safe_free(solver->flip_stamp);
+  solver->flip_stamp = NULL;
+
   delete_arena(&solver->arena);
 }
 
@@ -183,6 +183,97 @@ static inline void simplex_disable_adjust_model(simplex_solver_t *solver) {
   simplex_disable_options(solver, SIMPLEX_ADJUST_MODEL);
 }
 
+static inline void simplex_enable_bound_flipping(simplex_solver_t *solver) {
+  simplex_enable_options(solver, SIMPLEX_BOUND_FLIPPING);
+}
+
+static inline void simplex_disable_bound_flipping(simplex_solver_t *solver) {
+  simplex_disable_options(solver, SIMPLEX_BOUND_FLIPPING);
+}
+
+static inline void simplex_enable_fp_warm_start(simplex_solver_t *solver) {
+  simplex_enable_options(solver, SIMPLEX_FP_WARM_START);
+}
+
+static inline void simplex_disable_fp_warm_start(simplex_solver_t *solver) {
+  simplex_disable_options(solver, SIMPLEX_FP_WARM_START);
+}
+
+
+/*
+ * Pricing rule for the leaving variable
+ * - the default is to pick the infeasible variable of smallest index
+ * - steepest edge and devex are exclusive: enabling one disables the other
+ */
+static inline void simplex_enable_steepest_edge(simplex_solver_t *solver) {
+  simplex_disable_options(solver, SIMPLEX_DEVEX);
+  simplex_enable_options(solver, SIMPLEX_STEEPEST_EDGE);
+}
+
+static inline void simplex_disable_steepest_edge(simplex_solver_t *solver) {
+  simplex_disable_options(solver, SIMPLEX_STEEPEST_EDGE);
+}
+
+static inline void simplex_enable_devex(simplex_solver_t *solver) {
+  simplex_disable_options(solver, SIMPLEX_STEEPEST_EDGE);
+  simplex_enable_options(solver, SIMPLEX_DEVEX);
+}
+
+static inline void simplex_disable_devex(simplex_solver_t *solver) {
+  simplex_disable_options(solver, SIMPLEX_DEVEX);
+}
+
+
+/*
+ * Cutting planes (Gomory and MIR cuts)
+ * - the default is to disable
+ */
+static inline void simplex_enable_cuts(simplex_solver_t *solver) {
+  simplex_enable_options(solver, SIMPLEX_CUTS);
+}
+
+static inline void simplex_disable_cuts(simplex_solver_t *solver) {
+  simplex_disable_options(solver, SIMPLEX_CUTS);
+}
+
+
+/*
+ * Parameters for cutting planes
+ * - n = number of cut rounds before a branch atom is created
+ * - m = maximal number of cuts per round (must be positive)
+ * - size = capacity of the cut pool (must be positive, it is
+ *   reduced to MAX_CUT_POOL_CAPACITY if it is larger)
+ * - e = minimal efficacy of a cut (must be non-negative)
+ * - p = maximal parallelism between two cuts of the same round
+ *   (must be between 0.0 and 1.0)
+ */
+static inline void simplex_set_max_cut_rounds(simplex_solver_t *solver, uint32_t n) {
+  solver->max_cut_rounds = n;
+}
+
+static inline void simplex_set_max_cuts(simplex_solver_t *solver, uint32_t m) {
+  assert(m > 0);
+  solver->max_cuts = m;
+}
+
+static inline void simplex_set_cut_pool_size(simplex_solver_t *solver, uint32_t size) {
+  assert(size > 0);
+  if (size > MAX_CUT_POOL_CAPACITY) {
+    size = MAX_CUT_POOL_CAPACITY;
+  }
+  solver->cut_pool_size = size;
+}
+
+static inline void simplex_set_cut_min_efficacy(simplex_solver_t *solver, double e) {
+  assert(e >= 0.0);
+  solver->cut_min_efficacy = e;
+}
+
+static inline void simplex_set_cut_max_parallelism(simplex_solver_t *solver, double p) {
+  assert(0.0 <= p && p <= 1.0);
+  solver->cut_max_parallelism = p;
+}
+
 
 /*
  * Enable/disable the equality propagator
@@ -452,6 +543,22 @@ static inline uint32_t simplex_num_pivots(simplex_solver_t *solver) {
   return solver->stats.num_pivots;
 }
 
+static inline uint32_t simplex_num_bound_flips(simplex_solver_t *solver) {
+  return solver->stats.num_bound_flips;
+}
+
+static inline uint32_t simplex_num_flip_repairs(simplex_solver_t *solver) {
+  return solver->stats.num_flip_repairs;
+}
+
+static inline uint32_t simplex_num_fp_pivots(simplex_solver_t *solver) {
+  return solver->stats.num_fp_pivots;
+}
+
+static inline uint32_t simplex_num_warm_pivots(simplex_solver_t *solver) {
+  return solver->stats.num_warm_pivots;
+}
+
 static inline uint32_t simplex_num_make_feasible(simplex_solver_t *solver) {
   return solver->stats.num_make_feasible;
 }
@@ -520,6 +627,26 @@ static inline uint32_t simplex_num_dioph_recheck_conflicts(simplex_solver_t *sol
   return solver->stats.num_dioph_recheck_conflicts;
 }
 
+static inline uint32_t simplex_num_cut_rounds(simplex_solver_t *solver) {
+  return solver->stats.num_cut_rounds;
+}
+
+static inline uint32_t simplex_num_gomory_cuts(simplex_solver_t *solver) {
+  return solver->stats.num_gomory_cuts;
+}
+
+static inline uint32_t simplex_num_mir_cuts(simplex_solver_t *solver) {
+  return solver->stats.num_mir_cuts;
+}
+
+static inline uint32_t simplex_num_cuts(simplex_solver_t *solver) {
+  return solver->stats.num_cuts;
+}
+
+static inline uint32_t simplex_num_pool_cuts(simplex_solver_t *solver) {
+  return solver->stats.num_pool_cuts;
+}
+
 
 
 
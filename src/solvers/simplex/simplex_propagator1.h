@@ -37,6 +37,9 @@
  * 3) simplex_reset_propagator: called in simplex_reset and simplex_reset_tableau
  * 4) simplex_delete_propagator: called in delete_simplex_solver
  * 5) simplex_do_propagation: called in simplex_propagate if the tableau is feasible
+ * 6) simplex_propagator_pivot: called before a pivoting step (during the search)
+ * 7) simplex_propagator_backtrack: called in simplex_go_back before bounds
+ *    are removed from the bound stack
  */
 
 
@@ -107,6 +110,349 @@ const char * const simplex_prop_level = "prop level ??";
 
 
 
+/*
+ * ROW BOUNDS
+ */
+
+/*
+ * For every row a_1 x_1 + ... + a_n x_n = 0 of the tableau, we keep:
+ * - nlb = number of monomials a_i x_i with no lower bound
+ * - nub = number of monomials a_i x_i with no upper bound
+ * - lvars = sum of the variables x_i whose monomial has no lower bound
+ * - uvars = sum of the variables x_i whose monomial has no upper bound
+ * - lsum = sum of the lower bounds on the other monomials
+ * - usum = sum of the upper bounds on the other monomials
+ *
+ * The lower bound on a_i x_i is a_i * (lower bound on x_i) if a_i > 0
+ * and a_i * (upper bound on x_i) if a_i < 0. The upper bound is similar.
+ * lvars and uvars are computed modulo 2^32: if nlb is 1 then lvars is
+ * the only variable whose monomial has no lower bound (same for uvars).
+ *
+ * These are updated incrementally when bounds are added or removed. A
+ * row can propagate only if nlb <= 1 or nub <= 1, so rows with more
+ * unbounded monomials are skipped without looking at their elements.
+ *
+ * The propagator object stores the row bounds for all rows and
+ * a bitvector to mark the rows whose bounds are valid:
+ * - the row bounds are computed the first time a row is visited
+ * - the row becomes invalid when it's modified by a pivoting step
+ * - bound_ptr = index in the bound stack: all valid row bounds
+ *   take the bounds of index 0 to bound_ptr-1 into account.
+ */
+typedef struct prop_row_bounds_s {
+  uint32_t nlb;
+  uint32_t nub;
+  uint32_t lvars;
+  uint32_t uvars;
+  xrational_t lsum;
+  xrational_t usum;
+} prop_row_bounds_t;
+
+typedef struct row_propagator_s {
+  uint32_t nrows;
+  uint32_t size;
+  prop_row_bounds_t *row;
+  byte_t *valid;
+  uint32_t bound_ptr;
+} row_propagator_t;
+
+#define DEF_ROW_PROPAGATOR_SIZE 100
+#define MAX_ROW_PROPAGATOR_SIZE (UINT32_MAX/sizeof(prop_row_bounds_t))
+
+
+/*
+ * Initialize: initial size = n
+ */
+static void init_row_propagator(row_propagator_t *prop, uint32_t n) {
+  if (n < DEF_ROW_PROPAGATOR_SIZE) {
+    n = DEF_ROW_PROPAGATOR_SIZE;
+  }
+  if (n > MAX_ROW_PROPAGATOR_SIZE) {
+    out_of_memory();
+  }
+  prop->nrows = 0;
+  prop->size = n;
+  prop->row = (prop_row_bounds_t *) safe_malloc(n * sizeof(prop_row_bounds_t));
+  prop->valid = allocate_bitvector(n);
+  prop->bound_ptr = 0;
+}
+
+
+/*
+ * Make room for n rows: all new rows are invalid
+ */
+static void row_propagator_set_nrows(row_propagator_t *prop, uint32_t n) {
+  uint32_t i, new_size;
+
+  if (n > prop->size) {
+    new_size = prop->size + (prop->size >> 1);
+    if (new_size < n) {
+      new_size = n;
+    }
+    if (new_size > MAX_ROW_PROPAGATOR_SIZE) {
+      out_of_memory();
+    }
+    prop->row = (prop_row_bounds_t *) safe_realloc(prop->row, new_size * sizeof(prop_row_bounds_t));
+    prop->valid = extend_bitvector(prop->valid, new_size);
+    prop->size = new_size;
+  }
+
+  for (i=prop->nrows; i<n; i++) {
+    xq_init(&prop->row[i].lsum);
+    xq_init(&prop->row[i].usum);
+    clr_bit(prop->valid, i);
+  }
+  if (n > prop->nrows) {
+    prop->nrows = n;
+  }
+}
+
+
+/*
+ * Invalidate all rows
+ */
+static void row_propagator_invalidate_all(row_propagator_t *prop) {
+  clear_bitvector(prop->valid, prop->nrows);
+}
+
+
+/*
+ * Empty the table
+ */
+static void reset_row_propagator(row_propagator_t *prop) {
+  uint32_t i, n;
+
+  n = prop->nrows;
+  for (i=0; i<n; i++) {
+    xq_clear(&prop->row[i].lsum);
+    xq_clear(&prop->row[i].usum);
+  }
+  prop->nrows = 0;
+  prop->bound_ptr = 0;
+}
+
+
+/*
+ * Delete
+ */
+static void delete_row_propagator(row_propagator_t *prop) {
+  reset_row_propagator(prop);
+  safe_free(prop->row);
+  delete_bitvector(prop->valid);
+  prop->row = NULL;
+  prop->valid = NULL;
+}
+
+
+#ifndef NDEBUG
+
+/*
+ * For debugging: check that the cached bounds for row r are
+ * what we get by computing from scratch.
+ */
+static bool good_row_bounds(simplex_solver_t *solver, row_propagator_t *prop, uint32_t r);
+
+#endif
+
+
+/*
+ * Check whether row r has valid bounds
+ */
+static inline bool row_bounds_are_valid(row_propagator_t *prop, uint32_t r) {
+  return r < prop->nrows && tst_bit(prop->valid, r);
+}
+
+
+/*
+ * Compute the row bounds of row r from scratch
+ * - the bounds are built from the current lower and upper
+ *   indices of all variables in the row
+ */
+static void compute_row_bounds(simplex_solver_t *solver, row_propagator_t *prop, uint32_t r) {
+  arith_vartable_t *vtbl;
+  xrational_t *bound;
+  prop_row_bounds_t *rb;
+  row_elem_t *a;
+  row_t *p;
+  uint32_t n;
+  thvar_t x;
+  int32_t l, u;
+
+  assert(r < prop->nrows);
+
+  vtbl = &solver->vtbl;
+  bound = solver->bstack.bound;
+  rb = prop->row + r;
+  rb->nlb = 0;
+  rb->nub = 0;
+  rb->lvars = 0;
+  rb->uvars = 0;
+  xq_clear(&rb->lsum);
+  xq_clear(&rb->usum);
+
+  p = solver->matrix.row[r];
+  n = p->size;
+  a = p->data;
+  while (n > 0) {
+    x = a->c_idx;
+    if (x >= 0) {
+      if (q_is_pos(&a->coeff)) {
+        l = arith_var_lower_index(vtbl, x);
+        u = arith_var_upper_index(vtbl, x);
+      } else {
+        l = arith_var_upper_index(vtbl, x);
+        u = arith_var_lower_index(vtbl, x);
+      }
+      if (l < 0) {
+        rb->nlb ++;
+        rb->lvars += x;
+      } else {
+        xq_addmul(&rb->lsum, bound + l, &a->coeff);
+      }
+      if (u < 0) {
+        rb->nub ++;
+        rb->uvars += x;
+      } else {
+        xq_addmul(&rb->usum, bound + u, &a->coeff);
+      }
+    }
+    a ++;
+    n --;
+  }
+
+  set_bit(prop->valid, r);
+}
+
+
+/*
+ * Apply the effect of bound i to the row bounds of all valid rows
+ * that contain the variable of bound i.
+ * - if undo is false: bound i is being added
+ * - if undo is true: bound i is being removed
+ */
+static void update_row_bounds(simplex_solver_t *solver, row_propagator_t *prop, uint32_t i, bool undo) {
+  arith_bstack_t *bstack;
+  prop_row_bounds_t *rb;
+  column_t *col;
+  rational_t *a;
+  xrational_t *sum;
+  uint32_t j, n, *count, *vars;
+  thvar_t x;
+  int32_t r, k;
+  bool lower;
+
+  bstack = &solver->bstack;
+  x = bstack->var[i];
+  col = solver->matrix.column[x];
+  if (col == NULL) return;
+
+  k = bstack->pre[i];
+  lower = constraint_is_lower_bound(bstack, i);
+
+  n = col->size;
+  for (j=0; j<n; j++) {
+    r = col->data[j].r_idx;
+    if (r >= 0 && row_bounds_are_valid(prop, r)) {
+      rb = prop->row + r;
+      a = &solver->matrix.row[r]->data[col->data[j].r_ptr].coeff;
+      // a lower bound on x is a lower bound on a.x if a > 0
+      if (lower == q_is_pos(a)) {
+        count = &rb->nlb;
+        vars = &rb->lvars;
+        sum = &rb->lsum;
+      } else {
+        count = &rb->nub;
+        vars = &rb->uvars;
+        sum = &rb->usum;
+      }
+
+      if (undo) {
+        xq_submul(sum, bstack->bound + i, a);
+        if (k < 0) {
+          (*count) ++;
+          (*vars) += x;
+        } else {
+          xq_addmul(sum, bstack->bound + k, a);
+        }
+      } else {
+        xq_addmul(sum, bstack->bound + i, a);
+        if (k < 0) {
+          assert(*count > 0);
+          (*count) --;
+          (*vars) -= x;
+        } else {
+          xq_submul(sum, bstack->bound + k, a);
+        }
+      }
+    }
+  }
+}
+
+
+/*
+ * Bring all valid row bounds up to date with the bound stack
+ * - also make room for new rows
+ */
+static void sync_row_bounds(simplex_solver_t *solver, row_propagator_t *prop) {
+  uint32_t i, n;
+
+  row_propagator_set_nrows(prop, solver->matrix.nrows);
+
+  n = solver->bstack.top;
+  for (i=prop->bound_ptr; i<n; i++) {
+    update_row_bounds(solver, prop, i, false);
+  }
+  prop->bound_ptr = n;
+}
+
+
+/*
+ * Get the row bounds for row r: sync then compute the
+ * bounds if they're not valid
+ */
+static prop_row_bounds_t *get_row_bounds(simplex_solver_t *solver, row_propagator_t *prop, uint32_t r) {
+  sync_row_bounds(solver, prop);
+  if (! row_bounds_are_valid(prop, r)) {
+    compute_row_bounds(solver, prop, r);
+  }
+  assert(good_row_bounds(solver, prop, r));
+
+  return prop->row + r;
+}
+
+
+#ifndef NDEBUG
+
+static bool good_row_bounds(simplex_solver_t *solver, row_propagator_t *prop, uint32_t r) {
+  prop_row_bounds_t saved;
+  prop_row_bounds_t *rb;
+  bool ok;
+
+  rb = prop->row + r;
+  saved.nlb = rb->nlb;
+  saved.nub = rb->nub;
+  saved.lvars = rb->lvars;
+  saved.uvars = rb->uvars;
+  xq_init(&saved.lsum);
+  xq_init(&saved.usum);
+  xq_set(&saved.lsum, &rb->lsum);
+  xq_set(&saved.usum, &rb->usum);
+
+  compute_row_bounds(solver, prop, r);
+  ok = saved.nlb == rb->nlb && saved.nub == rb->nub &&
+    saved.lvars == rb->lvars && saved.uvars == rb->uvars &&
+    xq_eq(&saved.lsum, &rb->lsum) && xq_eq(&saved.usum, &rb->usum);
+
+  xq_clear(&saved.lsum);
+  xq_clear(&saved.usum);
+
+  return ok;
+}
+
+#endif
+
+
+
 
 
 
@@ -385,17 +731,14 @@ static void explain_lower_bounds(simplex_solver_t *solver, thvar_t x, row_t *p,
 /*
  * Compute the bound implied on y by the other variables of p
  * - all monomials must have an upper bound except a.y
+ * - b = sum of the upper bounds on the other monomials
  * - return false if a conflict is detected, true otherwise
  */
-static bool try_upper_bound_propagation(simplex_solver_t *solver, thvar_t y, row_t *p)  {
+static bool try_upper_bound_propagation(simplex_solver_t *solver, thvar_t y, row_t *p, xrational_t *b) {
   row_elem_t *a;
-  xrational_t *bound, *sum;
+  xrational_t *sum;
   rational_t *c; // coefficient of y in p
-  arith_vartable_t *vtbl;
   ivector_t *v;
-  uint32_t n;
-  thvar_t x;
-  int32_t k;
   bool ok;
 
 #if TRACE_PROPAGATION
@@ -408,39 +751,16 @@ static bool try_upper_bound_propagation(simplex_solver_t *solver, thvar_t y, row
 
   ok = true;
 
-  bound = solver->bstack.bound;
-  vtbl = &solver->vtbl;
+  // sum := - (upper bounds on the other monomials)
   sum = &solver->bound;
+  xq_set(sum, b);
+  xq_neg(sum);
 
-  // initialize c to avoid GCC warning
-  c = NULL;
-
-  xq_clear(sum);
-  n = p->size;
   a = p->data;
-  do {
-    x = a->c_idx;
-    if (x == y) {
-      c = &a->coeff;
-    } else if (x >= 0) {
-      // sum := sum - upper_bound on a.x
-      if (q_is_pos(&a->coeff)) {
-        k = arith_var_upper_index(vtbl, x);
-      } else {
-        k = arith_var_lower_index(vtbl, x);
-      }
-
-#if TRACE_PROPAGATION
-      printf("     ");
-      print_simplex_bound(stdout, solver, k);
-      printf("\n");
-#endif
-      assert(k >= 0);
-      xq_submul(sum, bound + k, &a->coeff);
-    }
+  while (a->c_idx != y) {
     a ++;
-    n --;
-  } while (n > 0);
+  }
+  c = &a->coeff;
 
   // implied bound: c.y >= sum
   assert(q_is_nonzero(c));
@@ -500,17 +820,14 @@ static bool try_upper_bound_propagation(simplex_solver_t *solver, thvar_t y, row
 /*
  * Compute the bound implied on y by the other variables of p
  * - all monomials must have an lower bound except a.y
+ * - b = sum of the lower bounds on the other monomials
  * - return false if a conflict is detected, true otherwise
  */
-static bool try_lower_bound_propagation(simplex_solver_t *solver, thvar_t y, row_t *p) {
+static bool try_lower_bound_propagation(simplex_solver_t *solver, thvar_t y, row_t *p, xrational_t *b) {
   row_elem_t *a;
-  xrational_t *bound, *sum;
+  xrational_t *sum;
   rational_t *c; // coefficient of y in p
-  arith_vartable_t *vtbl;
   ivector_t *v;
-  uint32_t n;
-  thvar_t x;
-  int32_t k;
   bool ok;
 
 #if TRACE_PROPAGATION
@@ -523,38 +840,16 @@ static bool try_lower_bound_propagation(simplex_solver_t *solver, thvar_t y, row
 
   ok = true;
 
-  bound = solver->bstack.bound;
-  vtbl = &solver->vtbl;
+  // sum := - (lower bounds on the other monomials)
   sum = &solver->bound;
+  xq_set(sum, b);
+  xq_neg(sum);
 
-  // initialize c to avoid GCC warning
-  c = NULL;
-
-  xq_clear(sum);
-  n = p->size;
   a = p->data;
-  do {
-    x = a->c_idx;
-    if (x == y) {
-      c = &a->coeff;
-    } else if (x >= 0) {
-      // sum := sum - lower_bound on a.x
-      if (q_is_pos(&a->coeff)) {
-        k = arith_var_lower_index(vtbl, x);
-      } else {
-        k = arith_var_upper_index(vtbl, x);
-      }
-#if TRACE_PROPAGATION
-      printf("     ");
-      print_simplex_bound(stdout, solver, k);
-      printf("\n");
-#endif
-      assert(k >= 0);
-      xq_submul(sum, bound + k, &a->coeff);
-    }
+  while (a->c_idx != y) {
     a ++;
-    n --;
-  } while (n > 0);
+  }
+  c = &a->coeff;
 
   // implied bound: c.y <= sum
   assert(q_is_nonzero(c));
@@ -612,95 +907,12 @@ static bool try_lower_bound_propagation(simplex_solver_t *solver, thvar_t y, row
 
 
 
-/*
- * Add the upper bounds of all monomials in row p
- * - all monomials must have an upper bound
- * - the result is stored in b
- */
-static void add_upper_bounds(simplex_solver_t *solver, row_t *p, xrational_t *b) {
-  row_elem_t *a;
-  xrational_t *bound;
-  arith_vartable_t *vtbl;
-  uint32_t n;
-  thvar_t x;
-  int32_t k;
-
-  bound = solver->bstack.bound;
-  vtbl = &solver->vtbl;
-
-  xq_clear(b);
-  n = p->size;
-  a = p->data;
-  do {
-    x = a->c_idx;
-    if (x >= 0) {
-      if (q_is_pos(&a->coeff)) {
-        k = arith_var_upper_index(vtbl, x);
-      } else {
-        k = arith_var_lower_index(vtbl, x);
-      }
-      assert(k >= 0);
-
-#if TRACE_PROPAGATION
-      printf("     ");
-      print_simplex_bound(stdout, solver, k);
-      printf("\n");
-#endif
-      xq_addmul(b, bound + k, &a->coeff);
-    }
-    a ++;
-    n --;
-  } while (n > 0);
-}
-
-
-/*
- * Add the lower bounds of all monomials in p
- * - all monomials must have a loweer bound
- * - the result is stored in b
- */
-static void add_lower_bounds(simplex_solver_t *solver, row_t *p, xrational_t *b) {
-  row_elem_t *a;
-  xrational_t *bound;
-  arith_vartable_t *vtbl;
-  uint32_t n;
-  thvar_t x;
-  int32_t k;
-
-  bound = solver->bstack.bound;
-  vtbl = &solver->vtbl;
-
-  xq_clear(b);
-  n = p->size;
-  a = p->data;
-  do {
-    x = a->c_idx;
-    if (x >= 0) {
-      if (q_is_pos(&a->coeff)) {
-        k = arith_var_lower_index(vtbl, x);
-      } else {
-        k = arith_var_upper_index(vtbl, x);
-      }
-      assert(k >= 0);
-
-#if TRACE_PROPAGATION
-      printf("     ");
-      print_simplex_bound(stdout, solver, k);
-      printf("\n");
-#endif
-      xq_addmul(b, bound + k, &a->coeff);
-    }
-    a ++;
-    n --;
-  } while (n > 0);
-}
-
-
 /*
  * Try propagation for row p when all monomials have an upper bound
+ * - b = sum of the upper bounds on all monomials
  * - return false if a conflict is detected, true otherwise.
  */
-static bool full_upper_bound_propagation(simplex_solver_t *solver, row_t *p) {
+static bool full_upper_bound_propagation(simplex_solver_t *solver, row_t *p, xrational_t *b) {
   arith_bstack_t *bstack;
   arith_vartable_t *vtbl;
   xrational_t *sum, *aux;
@@ -721,7 +933,7 @@ static bool full_upper_bound_propagation(simplex_solver_t *solver, row_t *p) {
   ok = true;
 
   sum = &solver->bound;
-  add_upper_bounds(solver, p, sum);
+  xq_set(sum, b);
   xq_neg(sum);
 
   aux = &solver->delta;
@@ -814,9 +1026,10 @@ static bool full_upper_bound_propagation(simplex_solver_t *solver, row_t *p) {
 
 /*
  * Try propagation for row p when all monomials have a lower bound
+ * - b = sum of the lower bounds on all monomials
  * - return false is a conflict is detected, true otherwise
  */
-static bool full_lower_bound_propagation(simplex_solver_t *solver, row_t *p) {
+static bool full_lower_bound_propagation(simplex_solver_t *solver, row_t *p, xrational_t *b) {
   arith_bstack_t *bstack;
   arith_vartable_t *vtbl;
   xrational_t *sum, *aux;
@@ -837,7 +1050,7 @@ static bool full_lower_bound_propagation(simplex_solver_t *solver, row_t *p) {
   ok = true; // means no conflict
 
   sum = &solver->bound;
-  add_lower_bounds(solver, p, sum);
+  xq_set(sum, b);
   xq_neg(sum);
 
   aux = &solver->delta;
@@ -936,70 +1149,44 @@ static bool full_lower_bound_propagation(simplex_solver_t *solver, row_t *p) {
  */
 
 /*
- * Try propagation based on row p
+ * Try propagation based on row r
+ * - the row bounds tell us which monomials have no lower or upper bound
+ *   so we don't need to scan the row unless it can propagate
+ * - the bounds must be refreshed after the lower-bound propagation since
+ *   that may add derived bounds on variables of the row
  * - return false if a conflict is detected, true otherwise
  */
-static bool check_row_propagation(simplex_solver_t *solver, row_t *p)  {
-  arith_vartable_t *vtbl;
-  row_elem_t *a;
-  uint32_t n;
-  thvar_t x, y;
-  int32_t s;
+static bool check_row_propagation(simplex_solver_t *solver, uint32_t r)  {
+  row_propagator_t *prop;
+  prop_row_bounds_t *rb;
+  row_t *p;
+  thvar_t y;
   bool ok;
 
-  vtbl = &solver->vtbl;
+  prop = solver->propagator;
+  p = solver->matrix.row[r];
 
   ok = true;
 
-  y = null_thvar; // variable with no lower bound
-  assert(y < 0);
-  a = p->data;
-  n = p->size;
-  do {
-    x = a->c_idx;
-    if (x >= 0) {
-      s = q_sgn(&a->coeff);
-      if ((s > 0 && arith_var_lower_index(vtbl, x) < 0) ||
-          (s < 0 && arith_var_upper_index(vtbl, x) < 0)) {
-        // no lower bound on monomial a.x
-        if (y >= 0) goto try_upper_bounds;
-        y = x;
-      }
+  rb = get_row_bounds(solver, prop, r);
+  if (rb->nlb == 0) {
+    ok = full_lower_bound_propagation(solver, p, &rb->lsum);
+  } else if (rb->nlb == 1) {
+    y = rb->lvars; // the only variable with no lower bound on its monomial
+    if (var_has_unassigned_atoms(solver, y)) {
+      ok = try_lower_bound_propagation(solver, y, p, &rb->lsum);
     }
-    a ++;
-    n --;
-  } while (n > 0);
-
-  if (y < 0) {
-    ok = full_lower_bound_propagation(solver, p);
-  } else if (var_has_unassigned_atoms(solver, y)) {
-    ok = try_lower_bound_propagation(solver, y, p);
   }
   if (! ok) goto done;
 
- try_upper_bounds:
-  y = null_thvar;
-  a = p->data;
-  n = p->size;
-  do {
-    x = a->c_idx;
-    if (x >= 0) {
-      s = q_sgn(&a->coeff);
-      if ((s > 0 && arith_var_upper_index(vtbl, x) < 0) ||
-          (s < 0 && arith_var_lower_index(vtbl, x) < 0)) {
-        // no upper bound on a.x
-        if (y >= 0) goto done;
-        y = x;
-      }
+  rb = get_row_bounds(solver, prop, r);
+  if (rb->nub == 0) {
+    ok = full_upper_bound_propagation(solver, p, &rb->usum);
+  } else if (rb->nub == 1) {
+    y = rb->uvars; // the only variable with no upper bound
+    if (var_has_unassigned_atoms(solver, y)) {
+      ok = try_upper_bound_propagation(solver, y, p, &rb->usum);
     }
-    a ++;
-    n --;
-  } while (n > 0);
-
-  if (y < 0) {
-    ok = full_upper_bound_propagation(solver, p);
-  } else if (var_has_unassigned_atoms(solver, y)) {
-    ok = try_upper_bound_propagation(solver, y, p);
   }
 
  done:
@@ -1147,7 +1334,7 @@ static bool visit_candidate_rows(simplex_solver_t *solver) {
     assert(matrix_row_is_marked(matrix, r));
     row = matrix->row[r];
     if (row->nelems <= solver->prop_row_size) {
-      if (! check_row_propagation(solver, row)) {
+      if (! check_row_propagation(solver, r)) {
         // conflict: return immediately
 #if TRACE_PROPAGATION
         printf("---> END OF SIMPLEX PROPAGATION: CONFLICT DETECTED\n");
@@ -1196,7 +1383,7 @@ static bool visit_candidate_rows(simplex_solver_t *solver) {
   for (i=0; i<n; i++) {
     row = matrix->row[i];
     if (row->nelems <= solver->prop_row_size) {
-      if (! check_row_propagation(solver, row)) {
+      if (! check_row_propagation(solver, i)) {
 #if TRACE_PROPAGATION
         printf("---> END OF SIMPLEX PROPAGATION: CONFLICT DETECTED\n");
 #endif
@@ -1226,31 +1413,99 @@ static bool visit_candidate_rows(simplex_solver_t *solver) {
  * init_propagator should allocate and initialize the propagator object
  * - solver->propagator is NULL by default
  */
-static inline void simplex_init_propagator(simplex_solver_t *solver) {
-  // do nothing
+static void simplex_init_propagator(simplex_solver_t *solver) {
+  row_propagator_t *prop;
+
+  prop = solver->propagator;
+  if (prop == NULL) {
+    prop = (row_propagator_t *) safe_malloc(sizeof(row_propagator_t));
+    init_row_propagator(prop, solver->matrix.nrows);
+    solver->propagator = prop;
+  }
 }
 
 /*
  * reset_propagator should reset the propagator object
  */
-static inline void simplex_reset_propagator(simplex_solver_t *solver) {
-  // do nothing
+static void simplex_reset_propagator(simplex_solver_t *solver) {
+  reset_row_propagator(solver->propagator);
 }
 
 /*
  * delete_propagator should reset/delete the propagator object
  */
-static inline void simplex_delete_propagator(simplex_solver_t *solver) {
-  // do nothing
+static void simplex_delete_propagator(simplex_solver_t *solver) {
+  delete_row_propagator(solver->propagator);
+  safe_free(solver->propagator);
+  solver->propagator = NULL;
 }
 
 
 /*
  * start_propagator: called after init_propagator, after the initial tableau is
  * constructed and all initial constraints are found to be feasible.
+ * - the tableau may have changed since the previous search: all row bounds
+ *   are invalidated and will be recomputed from the current bounds
+ */
+static void simplex_start_propagator(simplex_solver_t *solver) {
+  row_propagator_t *prop;
+
+  prop = solver->propagator;
+  row_propagator_set_nrows(prop, solver->matrix.nrows);
+  row_propagator_invalidate_all(prop);
+  prop->bound_ptr = solver->bstack.top;
+}
+
+
+/*
+ * propagator_pivot: called before row r is pivoted with the k-th element
+ * of r as entering variable
+ * - all rows in the column of the entering variable are modified:
+ *   their bounds must be recomputed.
  */
-static inline void simplex_start_propagator(simplex_solver_t *solver) {
-  // do nothing
+static void simplex_propagator_pivot(simplex_solver_t *solver, uint32_t r, uint32_t k) {
+  row_propagator_t *prop;
+  column_t *col;
+  uint32_t i, n;
+  thvar_t x;
+  int32_t j;
+
+  prop = solver->propagator;
+  x = solver->matrix.row[r]->data[k].c_idx;
+  col = solver->matrix.column[x];
+  assert(col != NULL);
+
+  n = col->size;
+  for (i=0; i<n; i++) {
+    j = col->data[i].r_idx;
+    if (j >= 0 && j < prop->nrows) {
+      clr_bit(prop->valid, j);
+    }
+  }
+}
+
+
+/*
+ * propagator_backtrack: called when all bounds of index >= n
+ * are about to be removed from the bound stack (and before
+ * the lower/upper indices of the variables are restored).
+ */
+static void simplex_propagator_backtrack(simplex_solver_t *solver, uint32_t n) {
+  row_propagator_t *prop;
+  uint32_t i;
+
+  prop = solver->propagator;
+  i = prop->bound_ptr;
+  if (i > solver->bstack.top) {
+    i = solver->bstack.top;
+  }
+  while (i > n) {
+    i --;
+    update_row_bounds(solver, prop, i, true);
+  }
+  if (prop->bound_ptr > n) {
+    prop->bound_ptr = n;
+  }
 }
 
 
@@ -142,6 +142,7 @@
 #include "solvers/egraph/egraph_assertion_queues.h"
 #include "solvers/simplex/arith_atomtable.h"
 #include "solvers/simplex/arith_vartable.h"
+#include "solvers/simplex/cut_pool.h"
 #include "solvers/simplex/diophantine_systems.h"
 #include "solvers/simplex/matrices.h"
 #include "solvers/simplex/offset_equalities.h"
@@ -637,6 +638,10 @@ typedef struct simplex_stats_s {
   uint32_t num_make_feasible;  // calls to make_feasible
   uint32_t num_pivots;         // pivoting steps
   uint32_t num_blands;         // number of activations of bland's rule
+  uint32_t num_bound_flips;    // non-basic variables moved to their opposite bound
+  uint32_t num_flip_repairs;   // infeasible variables fixed by bound flips only
+  uint32_t num_fp_pivots;      // pivoting steps in the floating-point warm start
+  uint32_t num_warm_pivots;    // exact pivots to load the warm-start basis
   uint32_t num_conflicts;
 
   // stats on integer arithmetic solver
@@ -654,6 +659,13 @@ typedef struct simplex_stats_s {
 
   uint32_t num_branch_atoms;            // new branch&bound atoms created
 
+  // cutting planes
+  uint32_t num_cut_rounds;              // rounds of cut generation that added cuts
+  uint32_t num_gomory_cuts;             // Gomory cuts generated
+  uint32_t num_mir_cuts;                // MIR cuts generated
+  uint32_t num_cuts;                    // cuts added as clauses
+  uint32_t num_pool_cuts;               // cuts reused from the pool
+
 } simplex_stats_t;
 
 
@@ -700,6 +712,28 @@ typedef struct simplex_solver_s {
   bool use_blands_rule;     // true if Bland's rule is active
   uint32_t bland_threshold; // number of repeat entering variable
 
+  /*
+   * Pricing weights (used if STEEPEST_EDGE or DEVEX is enabled)
+   * - weight[x] = weight of the basic variable x, or a negative
+   *   number if it's not known
+   * - weight_size = size of the weight array
+   * - weighted = variables whose weight is known
+   * All weights are forgotten at the start of every feasibility check.
+   */
+  double *weight;
+  uint32_t weight_size;
+  ivector_t weighted;
+
+  /*
+   * Bound flipping (used if BOUND_FLIPPING is enabled)
+   * - a variable can be flipped at most once per feasibility check
+   * - flip_stamp[x] = flip_round if x was flipped in the current check
+   * - flip_stamp_size = size of the flip_stamp array
+   */
+  uint32_t *flip_stamp;
+  uint32_t flip_stamp_size;
+  uint32_t flip_round;
+
   /*
    * Parameters for propagation
    */
@@ -726,6 +760,26 @@ typedef struct simplex_solver_s {
    */
   dsolver_t *dsolver;
 
+  /*
+   * Cutting planes (used if CUTS is enabled)
+   * - cut_pool: allocated when needed, kept until the next pop or reset
+   * - cut_rounds = number of cut rounds since the last branch atom
+   * - max_cut_rounds = bound on cut_rounds: when it's reached, the
+   *   next call to make_integer_feasible creates a branch atom
+   * - max_cuts = maximal number of cuts added per round
+   * - cut_pool_size = capacity of the pool
+   * - cut_min_efficacy = cuts of lower efficacy are ignored
+   * - cut_max_parallelism = a cut is not added if it's more parallel
+   *   than this to a cut already added in the same round
+   */
+  cut_pool_t *cut_pool;
+  uint32_t cut_rounds;
+  uint32_t max_cut_rounds;
+  uint32_t max_cuts;
+  uint32_t cut_pool_size;
+  double cut_min_efficacy;
+  double cut_max_parallelism;
+
   /*
    * Optional cache for trichotomy lemmas: allocated when needed
    */
@@ -887,12 +941,23 @@ typedef struct simplex_solver_s {
  * - ADJUST_MODEL: attempt to modify the variable assignment to
  *   make the simplex model consistent with the egraph (as much as possible).
  * - EQPROP: enable propagation of equalities to the egraph
+ * - STEEPEST_EDGE: choose the leaving variable that maximizes
+ *   (bound violation)^2/(squared norm of its row)
+ * - DEVEX: same thing with approximate row norms (devex reference
+ *   weights) that are updated at every pivoting step
+ * - BOUND_FLIPPING: before pivoting, try to fix the leaving variable
+ *   by moving non-basic variables of its row to their opposite bound
+ * - CUTS: add Gomory and MIR cuts before creating branch atoms
+ * - FP_WARM_START: when the search starts, run a floating-point simplex
+ *   on the initial tableau and pivot the exact tableau to the resulting
+ *   basis before the first feasibility check
  *
  * Bland's rule threshold: based on the count of repeat
  * leaving variable. The counter is incremented whenever
  * a variable x leaves the basic for at least the second time.
  * When the counter becomes >= threshold, then Bland's rule
- * is activated to ensure termination.
+ * is activated to ensure termination. Pricing and bound flipping
+ * are disabled while Bland's rule is active.
  *
  * Propagation row size = maximal size of rows considered for propagation.
  */
@@ -901,6 +966,11 @@ typedef struct simplex_solver_s {
 #define SIMPLEX_ICHECK              0x4
 #define SIMPLEX_ADJUST_MODEL        0x8
 #define SIMPLEX_EQPROP              0x10
+#define SIMPLEX_STEEPEST_EDGE       0x20
+#define SIMPLEX_DEVEX               0x40
+#define SIMPLEX_BOUND_FLIPPING      0x80
+#define SIMPLEX_CUTS                0x100
+#define SIMPLEX_FP_WARM_START       0x200
 
 #define SIMPLEX_DISABLE_ALL_OPTIONS 0x0
 
@@ -908,6 +978,34 @@ typedef struct simplex_solver_s {
 #define SIMPLEX_DEFAULT_PROP_ROW_SIZE        30
 #define SIMPLEX_DEFAULT_CHECK_PERIOD   99999999
 
+/*
+ * Number of infeasible variables examined by the pricing heuristics
+ * (partial pricing)
+ */
+#define SIMPLEX_PRICING_CANDIDATES      100
+
+/*
+ * Default parameters for cutting planes
+ * - rows per round: number of rows examined per round is
+ *   SIMPLEX_CUT_ROWS_FACTOR * max_cuts
+ * - mir scales: number of scaling factors tried per row
+ */
+#define SIMPLEX_DEFAULT_CUT_ROUNDS          2
+#define SIMPLEX_DEFAULT_MAX_CUTS            8
+#define SIMPLEX_DEFAULT_CUT_POOL_SIZE     256
+#define SIMPLEX_DEFAULT_CUT_EFFICACY     1e-3
+#define SIMPLEX_DEFAULT_CUT_PARALLELISM  0.95
+
+#define SIMPLEX_CUT_ROWS_FACTOR             2
+#define SIMPLEX_MIR_SCALES                  6
+
+/*
+ * Bound on the number of pivots in the floating-point warm start:
+ * SIMPLEX_FP_PIVOT_FACTOR * number of rows + SIMPLEX_FP_MIN_PIVOTS
+ */
+#define SIMPLEX_FP_PIVOT_FACTOR            10
+#define SIMPLEX_FP_MIN_PIVOTS            1000
+
 // default options
 #define SIMPLEX_DEFAULT_OPTIONS (SIMPLEX_DISABLE_ALL_OPTIONS)
 
@@ -29,12 +29,6 @@
 #include "terms/mpq_aux.h"
 
 
-/*
- * Global variable for intermediate computations.
- */
-static mpz_t z0;
-
-
 /*
  * Debug code: double check results
  */
@@ -74,8 +68,6 @@ void init_mpq_aux(void) {
     abort();
   }
 
-  mpz_init(z0);
-
 #ifdef DEBUG
   mpq_init(check);
   mpq_init(aux);
@@ -87,8 +79,6 @@ void init_mpq_aux(void) {
  * Cleanup
  */
 void cleanup_mpq_aux(void) {
-  mpz_clear(z0);
-
 #ifdef DEBUG
   mpq_clear(check);
   mpq_clear(aux);
@@ -115,6 +105,18 @@ void mpq_init2(mpq_t q, unsigned long n) {
 
 
 
+/*
+ * Add b * c to a (GMP has mpz_addmul_ui but no signed version)
+ */
+static inline void add_mul_si(mpz_t a, const mpz_t b, long c) {
+  if (c >= 0) {
+    mpz_addmul_ui(a, b, (unsigned long) c);
+  } else {
+    mpz_submul_ui(a, b, - (unsigned long) c);
+  }
+}
+
+
 /*
  * Add rational num/den to q.
  * - den must be non zero
@@ -137,8 +139,7 @@ void mpq_add_si(mpq_t q, long num, unsigned long den) {
   //                num = 0 should be rare
   if (den == 1) {
     // a/b + d --> (a + bd)/b
-    mpz_mul_si(z0, den_q, num);
-    mpz_add(num_q, num_q, z0);
+    add_mul_si(num_q, den_q, num);
 
     check_result(q);
     return;
@@ -149,9 +150,8 @@ void mpq_add_si(mpq_t q, long num, unsigned long den) {
 
   if (gcd == 1) {
     // a/b + c/d  --> (a d + b c) / bd
-    mpz_mul_si(z0, den_q, num);
     mpz_mul_ui(num_q, num_q, den);
-    mpz_add(num_q, num_q, z0);
+    add_mul_si(num_q, den_q, num);
     mpz_mul_ui(den_q, den_q, den);
 
     check_result(q);
@@ -159,10 +159,8 @@ void mpq_add_si(mpq_t q, long num, unsigned long den) {
   }
 
   mpz_divexact_ui(den_q, den_q, gcd); // b0 = b/gcd
-  mpz_mul_si(z0, den_q, num);     // z0 = b0 * num
-
   mpz_mul_ui(num_q, num_q, den/gcd);
-  mpz_add(num_q, num_q, z0);      // num_q := (den_q/gcd) * num + (den/gcd) * num_q
+  add_mul_si(num_q, den_q, num);   // num_q := (den_q/gcd) * num + (den/gcd) * num_q
 
   gcd = mpz_gcd_ui(NULL, num_q, gcd);
   if (gcd == 1) {
@@ -283,6 +281,7 @@ void mpq_div_si(mpq_t q, long num, unsigned long den) {
  * are 32bits. Otherwise, mpq_set_si works fine.
  */
 void mpq_set_int64(mpq_t q, int64_t num, uint64_t den) {
+  mpz_t z0;
   uint64_t absnum;
 
   /*
@@ -297,6 +296,7 @@ void mpq_set_int64(mpq_t q, int64_t num, uint64_t den) {
 
   //  printf("- num = %lld, absnum = %llu\n", - num, absnum);
 
+  mpz_init(z0);
   mpz_set_ui(z0, (long) (absnum >> 32)); // high order bits of absnum
   mpz_mul_2exp(z0, z0, 32);
   mpz_add_ui(mpq_numref(q), z0, (unsigned long)(absnum & (~ 0))); // mask high order bits
@@ -308,6 +308,7 @@ void mpq_set_int64(mpq_t q, int64_t num, uint64_t den) {
   mpz_set_ui(z0, (unsigned long) (den >> 32));
   mpz_mul_2exp(z0, z0, 32);
   mpz_add_ui(mpq_denref(q), z0, (unsigned long)(den & (~ 0)));
+  mpz_clear(z0);
 }
 
 
@@ -317,10 +318,12 @@ void mpq_set_int64(mpq_t q, int64_t num, uint64_t den) {
  * - den = 64bit unsigned integer
  */
 void mpq_get_int64(mpq_t q, int64_t *num, uint64_t *den) {
+  mpz_t z0;
   unsigned long a, b;
   uint64_t aux;
 
   // convert the numerator
+  mpz_init(z0);
   mpz_abs(z0, mpq_numref(q));
   a = mpz_get_ui(z0);            // a = 32 lower order bits
   mpz_fdiv_q_2exp(z0, z0, 32);   // arithmetic shift
@@ -338,6 +341,7 @@ void mpq_get_int64(mpq_t q, int64_t *num, uint64_t *den) {
   mpz_fdiv_q_2exp(z0, z0, 32);
   b = mpz_get_ui(z0);
   *den = (((uint64_t) b) << 32) | ((uint64_t) a);
+  mpz_clear(z0);
 }
 
 
@@ -353,13 +357,19 @@ bool mpq_fits_int32(mpq_t q) {
  * Check whether q can be converted into two 64bit integers num/den
  */
 bool mpq_fits_int64(mpq_t q) {
+  mpz_t z0;
+  bool fits;
+
+  mpz_init(z0);
   mpz_fdiv_q_2exp(z0, mpq_numref(q), 32); // z0 = numerator>>32
-  if (mpz_fits_slong_p(z0)) {
+  fits = mpz_fits_slong_p(z0);
+  if (fits) {
     mpz_fdiv_q_2exp(z0, mpq_denref(q), 32); // denominator >> 32
-    return mpz_fits_ulong_p(z0);
-  } else {
-    return false;
+    fits = mpz_fits_ulong_p(z0);
   }
+  mpz_clear(z0);
+
+  return fits;
 }
 
 
@@ -377,12 +387,18 @@ bool mpq_is_int32(mpq_t q) {
  * - i.e., the numerator fits into a 64bit number and the denominator is 1
  */
 bool mpq_is_int64(mpq_t q) {
+  mpz_t z0;
+  bool fits;
+
+  fits = false;
   if (mpz_cmp_ui(mpq_denref(q), 1UL) == 0) {
+    mpz_init(z0);
     mpz_fdiv_q_2exp(z0, mpq_numref(q), 32); // z0 = numerator >> 32
-    return mpz_fits_slong_p(z0);
-  } else {
-    return false;
+    fits = mpz_fits_slong_p(z0);
+    mpz_clear(z0);
   }
+
+  return fits;
 }
 
 
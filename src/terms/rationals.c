@@ -40,6 +40,7 @@
 #include "terms/rationals.h"
 #include "utils/gcd.h"
 #include "utils/memalloc.h"
+#include "utils/yices_locks.h"
 
 
 
@@ -49,27 +50,137 @@
 
 /*
  * Bank of mpq numbers
- * - bank_q[] = mpq_rationals (all initialized)
+ * - bank_mpq(i) = mpq_rationals (all initialized)
  * - bank_free = index of the first unused elements in mpq
  *   (start of free list)
  * - bank_capacity = size of arrays mpq_bank
  * - bank_size = number of rationals currently stored
  *
  * The free list is encoded via the numerators:
- * succ(i) = mpz_get_si(mpq_numref(bank_q[i]))
+ * succ(i) = mpz_get_si(mpq_numref(bank_mpq(i)))
+ *
+ * In the thread-safe build, bank_q is an array of blocks
+ * and all operations on the free list are protected by bank_lock.
+ * Each thread also keeps a small cache of free numbers (see below).
  */
+#ifdef THREAD_SAFE
+mpq_t *bank_q[(UINT32_MAX/sizeof(mpq_t))/MPQ_BLOCK_SIZE];
+#else
 mpq_t *bank_q = NULL;
+#endif
+
+static yices_lock_t bank_lock;
 
 static int32_t bank_free = -1;
 static uint32_t bank_capacity = 0;
 static uint32_t bank_size = 0;
 
 
+#ifdef THREAD_SAFE
+
+/*
+ * Per-thread cache of free mpq numbers
+ * - free_mpq stores the index in the cache of the calling thread
+ *   if there's room, and alloc_mpq takes indices from the cache
+ *   first. Most allocations and deletions then don't need the lock.
+ * - indices cached by a thread that exits are not reused, but the
+ *   numbers are still deleted by cleanup_rationals.
+ * - the cache is valid only if its generation is equal to
+ *   bank_generation. The generation changes every time the bank is
+ *   initialized so that stale indices are never reused after
+ *   cleanup_rationals/init_rationals.
+ */
+#define MPQ_CACHE_SIZE 64
+
+typedef struct mpq_cache_s {
+  uint32_t generation;
+  uint32_t size;
+  int32_t index[MPQ_CACHE_SIZE];
+} mpq_cache_t;
+
+static YICES_THREAD_LOCAL mpq_cache_t mpq_cache;
+static uint32_t bank_generation = 0;
+
+#endif
+
+
 /*
  * Maximal size.
  */
 #define MAX_BANK_SIZE (UINT32_MAX/sizeof(mpq_t))
 
+
+#ifdef THREAD_SAFE
+
+/*
+ * Allocate and initialize one block of mpq numbers:
+ * - the new block is stored in bank_q[k]
+ */
+static void alloc_bank_block(uint32_t k) {
+  mpq_t *b;
+  uint32_t i;
+
+  assert(bank_q[k] == NULL);
+
+  b = (mpq_t *) safe_malloc(MPQ_BLOCK_SIZE * sizeof(mpq_t));
+  for (i=0; i<MPQ_BLOCK_SIZE; i++) {
+    mpq_init2(b[i], 64);
+  }
+  bank_q[k] = b;
+}
+
+/*
+ * Increase bank capacity to at least n
+ * - capacity is always a multiple of MPQ_BLOCK_SIZE
+ */
+static void resize_bank(uint32_t n) {
+  uint32_t k;
+
+  if (n >= MAX_BANK_SIZE) {
+    out_of_memory();
+  }
+
+  while (bank_capacity < n) {
+    k = bank_capacity >> MPQ_BLOCK_BITS;
+    alloc_bank_block(k);
+    bank_capacity += MPQ_BLOCK_SIZE;
+  }
+}
+
+/*
+ * Initialize bank for initial capacity n.
+ * (n must be positive).
+ */
+static void init_bank(uint32_t n) {
+  create_yices_lock(&bank_lock);
+  bank_generation ++;
+  bank_free = -1;
+  bank_capacity = 0;
+  bank_size = 0;
+  resize_bank(n);
+}
+
+/*
+ * Free the bank
+ */
+static void clear_bank(void) {
+  uint32_t i, k, n;
+
+  n = bank_capacity >> MPQ_BLOCK_BITS;
+  for (k=0; k<n; k++) {
+    for (i=0; i<MPQ_BLOCK_SIZE; i++) {
+      mpq_clear(bank_q[k][i]);
+    }
+    safe_free(bank_q[k]);
+    bank_q[k] = NULL;
+  }
+  bank_capacity = 0;
+
+  destroy_yices_lock(&bank_lock);
+}
+
+#else
+
 /*
  * Initialize bank for initial capacity n.
  * (n must be positive).
@@ -130,12 +241,14 @@ static void clear_bank(void) {
   free(bank_q);
 }
 
+#endif
+
 
 /*
  * Free-list operations
  */
 static inline int32_t free_list_next(int32_t i) {
-  return mpz_get_si(mpq_numref(bank_q[i]));
+  return mpz_get_si(mpq_numref(bank_mpq(i)));
 }
 
 /*
@@ -144,6 +257,14 @@ static inline int32_t free_list_next(int32_t i) {
 static int32_t alloc_mpq(void) {
   int32_t n;
 
+#ifdef THREAD_SAFE
+  if (mpq_cache.size > 0 && mpq_cache.generation == bank_generation) {
+    mpq_cache.size --;
+    return mpq_cache.index[mpq_cache.size];
+  }
+#endif
+
+  get_yices_lock(&bank_lock);
   n = bank_free;
   if (n >= 0) {
     bank_free = free_list_next(n);
@@ -155,6 +276,8 @@ static int32_t alloc_mpq(void) {
     bank_size = n + 1;
     assert(-1 <= bank_free && bank_free < (int32_t) bank_capacity);
   }
+  release_yices_lock(&bank_lock);
+
   return n;
 }
 
@@ -164,10 +287,24 @@ static int32_t alloc_mpq(void) {
  * Free allocated mpq number of index i
  */
 void free_mpq(int32_t i) {
+#ifdef THREAD_SAFE
+  if (mpq_cache.generation != bank_generation) {
+    mpq_cache.generation = bank_generation;
+    mpq_cache.size = 0;
+  }
+  if (mpq_cache.size < MPQ_CACHE_SIZE) {
+    mpq_cache.index[mpq_cache.size] = i;
+    mpq_cache.size ++;
+    return;
+  }
+#endif
+
+  get_yices_lock(&bank_lock);
   assert(0 <= i && i < bank_capacity);
   assert(-1 <= bank_free && bank_free < (int32_t) bank_capacity);
-  mpz_set_si(mpq_numref(bank_q[i]), bank_free);
+  mpz_set_si(mpq_numref(bank_mpq(i)), bank_free);
   bank_free = i;
+  release_yices_lock(&bank_lock);
 }
 
 
@@ -175,7 +312,7 @@ void free_mpq(int32_t i) {
  * Get gmp number of index i
  */
 mpq_ptr get_mpq(int32_t i) {
-  return bank_q[i];
+  return bank_mpq(i);
 }
 
 
@@ -185,35 +322,22 @@ mpq_ptr get_mpq(int32_t i) {
  ******************************/
 
 /*
- * Global gmp variables used for intermediate computations
+ * There are no global gmp variables for intermediate computations:
+ * operations that need temporary gmp numbers allocate them locally.
+ * This makes all the operations on distinct rationals safe to use
+ * from different threads (in the thread-safe build).
  */
-static mpz_t z0;
-static mpq_t q0;
-
-/*
- * String buffer for parsing.
- */
-static char* string_buffer;
-static uint32_t string_buffer_length;
-
 
 #define INITIAL_BANK_CAPACITY 1024
 
 void init_rationals(void) {
   init_mpq_aux();
   init_bank(INITIAL_BANK_CAPACITY);
-  string_buffer = NULL;
-  string_buffer_length = 0;
-  mpz_init2(z0, 64);
-  mpq_init2(q0, 64);
 }
 
 void cleanup_rationals(void) {
   cleanup_mpq_aux();
   clear_bank();
-  safe_free(string_buffer);
-  mpz_clear(z0);
-  mpq_clear(q0);
 }
 
 static void division_by_zero(void) {
@@ -249,13 +373,144 @@ static void division_by_zero(void) {
 
 
 
+/*
+ * Overflow-checked 64bit operations:
+ * - return true if a * b (or a + b) overflows
+ * - otherwise store the result in *r and return false
+ * GCC and clang provide builtins for these. For other compilers,
+ * we use the usual tests.
+ */
+#ifdef __GNUC__
+
+static inline bool mul64_overflow(int64_t a, int64_t b, int64_t *r) {
+  return __builtin_mul_overflow(a, b, r);
+}
+
+static inline bool add64_overflow(int64_t a, int64_t b, int64_t *r) {
+  return __builtin_add_overflow(a, b, r);
+}
+
+#else
+
+static inline bool mul64_overflow(int64_t a, int64_t b, int64_t *r) {
+  if (a > 0) {
+    if (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a) return true;
+  } else if (a < 0) {
+    if (b > 0 ? a < INT64_MIN / b : b < INT64_MAX / a) return true;
+  }
+  *r = a * b;
+  return false;
+}
+
+static inline bool add64_overflow(int64_t a, int64_t b, int64_t *r) {
+  if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b)) return true;
+  *r = a + b;
+  return false;
+}
+
+#endif
+
+
+/*
+ * Absolute value of a as an unsigned 64bit integer
+ */
+static inline uint64_t abs64(int64_t a) {
+  return a >= 0 ? (uint64_t) a : - (uint64_t) a;
+}
+
+
+/*
+ * Fast path for arithmetic on pairs num/den
+ * - the arguments are canonical fractions a/b and c/d (b and d positive)
+ * - the result is stored in num and den in canonical form: no gcd
+ *   computation on the result is needed.
+ * - the functions return false if an intermediate result
+ *   overflows 64 bits.
+ * If the operands are small (stored as pairs in rational_t),
+ * the functions always succeed.
+ */
+
+/*
+ * Sum a/b + c/d (Knuth's algorithm)
+ */
+static bool add_fractions64(int64_t a, int64_t b, int64_t c, int64_t d, int64_t *num, int64_t *den) {
+  int64_t g, t, u;
+
+  assert(b > 0 && d > 0);
+
+  g = (b == 1 || d == 1) ? 1 : (int64_t) gcd64(b, d);
+  if (g == 1) {
+    // (a * d + b * c)/(b * d) is canonical
+    return ! (mul64_overflow(a, d, &t) || mul64_overflow(b, c, &u) ||
+              add64_overflow(t, u, num) || mul64_overflow(b, d, den));
+  }
+
+  // t = a * (d/g) + c * (b/g) then the gcd of the result is gcd(t, g)
+  if (mul64_overflow(a, d/g, &t) || mul64_overflow(c, b/g, &u) || add64_overflow(t, u, &t)) {
+    return false;
+  }
+  if (t == 0) {
+    *num = 0;
+    *den = 1;
+    return true;
+  }
+  u = gcd64(abs64(t), g);
+  *num = t/u;
+  return ! mul64_overflow(b/g, d/u, den);
+}
+
+/*
+ * Product (a/b) * (c/d): remove common factors first
+ */
+static bool mul_fractions64(int64_t a, int64_t b, int64_t c, int64_t d, int64_t *num, int64_t *den) {
+  int64_t g;
+
+  assert(b > 0 && d > 0);
+
+  if (a == 0 || c == 0) {
+    *num = 0;
+    *den = 1;
+    return true;
+  }
+  if (d > 1) {
+    g = gcd64(abs64(a), d);
+    a /= g;
+    d /= g;
+  }
+  if (b > 1) {
+    g = gcd64(abs64(c), b);
+    c /= g;
+    b /= g;
+  }
+  return ! (mul64_overflow(a, c, num) || mul64_overflow(b, d, den));
+}
+
+
+/*
+ * Add the canonical fraction num/den to the gmp number q
+ */
+static void mpq_add_int64(mpq_t q, int64_t num, uint64_t den) {
+#if ULONG_SIZE == 8
+  mpq_add_si(q, num, den);
+#else
+  mpq_t aux;
+
+  mpq_init(aux);
+  mpq_set_int64(aux, num, den);
+  mpq_add(q, q, aux);
+  mpq_clear(aux);
+#endif
+}
+
+
+
 /*
  * Normalization: construct rational a/b when
  * a and b are two 64bit numbers.
  * - b must be non-zero
  */
 void q_set_int64(rational_t *r, int64_t a, uint64_t b) {
-  uint64_t abs_a;
+  uint64_t abs_a, g;
   int32_t i;
   bool a_positive;
 
@@ -277,47 +532,12 @@ void q_set_int64(rational_t *r, int64_t a, uint64_t b) {
     a_positive = false;
   }
 
-  // abs_a and b are positive. remove powers of 2
-  while (((abs_a | b) & 15) == 0) {
-    abs_a >>= 4;
-    b >>= 4;
-  }
-  switch ((abs_a | b) & 7) {
-  case 0: abs_a >>= 3; b >>= 3; break;
-  case 1: break;
-  case 2: abs_a >>= 1; b >>= 1; break;
-  case 3: break;
-  case 4: abs_a >>= 2; b >>= 2; break;
-  case 5: break;
-  case 6: abs_a >>= 1; b >>= 1; break;
-  case 7: break;
-  }
-
-  // abs_a and b are positive, and at least one of them is odd.
-  // if abs_a <= 2 or b <= 2 then gcd = 1.
-  if (abs_a > 2 && b > 2) {
-    uint64_t a_1 = abs_a;
-    uint64_t b_1 = b;
-
-    // compute gcd of abs_a and b
-    // loop invariant: abs_a is odd or b is odd (or both)
-    for (;;) {
-      if ((a_1 & 1) == 0) {
-        a_1 >>= 1;
-      } else if ((b_1 & 1) == 0) {
-        b_1 >>= 1;
-      } else if (a_1 >= b_1) {
-        a_1 = (a_1 - b_1) >> 1;
-        if (a_1 == 0) break;
-      } else {
-        b_1 = (b_1 - a_1) >> 1;
-      }
-    }
-
-    // b_1 is gcd(abs_a, b)
-    if (b_1 != 1) {
-      abs_a /= b_1;
-      b /= b_1;
+  // abs_a and b are positive: remove their gcd
+  if (abs_a > 1 && b > 1) {
+    g = gcd64(abs_a, b);
+    if (g != 1) {
+      abs_a /= g;
+      b /= g;
     }
   }
 
@@ -339,7 +559,7 @@ void q_set_int64(rational_t *r, int64_t a, uint64_t b) {
     } else {
       i = r->num;
     }
-    mpq_set_int64(bank_q[i], a, b);
+    mpq_set_int64(bank_mpq(i), a, b);
   }
 }
 
@@ -348,7 +568,7 @@ void q_set_int64(rational_t *r, int64_t a, uint64_t b) {
  * Normalization: construct a/b when a and b are 32 bits
  */
 void q_set_int32(rational_t *r, int32_t a, uint32_t b) {
-  uint32_t abs_a;
+  uint32_t abs_a, g;
   int32_t i;
   bool a_positive;
 
@@ -370,48 +590,12 @@ void q_set_int32(rational_t *r, int32_t a, uint32_t b) {
     a_positive = false;
   }
 
-  // abs_a and b are positive. remove powers of 2
-  while (((abs_a | b) & 15) == 0) {
-    abs_a >>= 4;
-    b >>= 4;
-  }
-  switch ((abs_a | b) & 7) {
-  case 0: abs_a >>= 3; b >>= 3; break;
-  case 1: break;
-  case 2: abs_a >>= 1; b >>= 1; break;
-  case 3: break;
-  case 4: abs_a >>= 2; b >>= 2; break;
-  case 5: break;
-  case 6: abs_a >>= 1; b >>= 1; break;
-  case 7: break;
-  }
-
-  // abs_a and b are positive, and at least one of them is odd.
-  // if abs_a <= 2 or b <= 2 then gcd = 1.
-  if (abs_a > 2 && b > 2) {
-    uint32_t a_1 = abs_a;
-    uint32_t b_1 = b;
-
-    // compute gcd of abs_a and b
-    // loop invariant: abs_a is odd or b is odd (or both)
-    for (;;) {
-      if ((a_1 & 1) == 0) {
-        a_1 >>= 1;
-      } else if ((b_1 & 1) == 0) {
-        b_1 >>= 1;
-      } else if (a_1 >= b_1) {
-        a_1 = (a_1 - b_1) >> 1;
-        if (a_1 == 0) break;
-
-      } else {
-        b_1 = (b_1 - a_1) >> 1;
-      }
-    }
-
-    // b_1 is gcd(abs_a, b)
-    if (b_1 != 1) {
-      abs_a /= b_1;
-      b /= b_1;
+  // abs_a and b are positive: remove their gcd
+  if (abs_a > 1 && b > 1) {
+    g = gcd32(abs_a, b);
+    if (g != 1) {
+      abs_a /= g;
+      b /= g;
     }
   }
 
@@ -433,7 +617,7 @@ void q_set_int32(rational_t *r, int32_t a, uint32_t b) {
     } else {
       i = r->num;
     }
-    mpq_set_int32(bank_q[i], a, b);
+    mpq_set_int32(bank_mpq(i), a, b);
   }
 }
 
@@ -456,7 +640,7 @@ void q_set64(rational_t *r, int64_t a) {
     } else {
       i = r->num;
     }
-    mpq_set_int64(bank_q[i], a, 1);
+    mpq_set_int64(bank_mpq(i), a, 1);
   }
 }
 
@@ -476,12 +660,38 @@ void q_set32(rational_t *r, int32_t a) {
     } else {
       i = r->num;
     }
-    mpq_set_int32(bank_q[i], a, 1);
+    mpq_set_int32(bank_mpq(i), a, 1);
   }
 }
 
 
 
+/*
+ * Assign num/den to r: num and den must have no common factor
+ * and den must be positive (no normalization).
+ */
+static void q_set_canonical64(rational_t *r, int64_t num, uint64_t den) {
+  int32_t i;
+
+  assert(den > 0);
+
+  if (MIN_NUMERATOR <= num && num <= MAX_NUMERATOR && den <= MAX_DENOMINATOR) {
+    if (r->den == 0) free_mpq(r->num);
+    r->num = (int32_t) num;
+    r->den = (uint32_t) den;
+  } else {
+    if (r->den != 0) {
+      i = alloc_mpq();
+      r->den = 0;
+      r->num = i;
+    } else {
+      i = r->num;
+    }
+    mpq_set_int64(bank_mpq(i), num, den);
+  }
+}
+
+
 /*
  * Convert r to a gmp number.
  * r->num and r->den must have no common factor
@@ -492,7 +702,7 @@ static void convert_to_gmp(rational_t *r) {
 
   assert(r->den != 0);
   i = alloc_mpq();
-  mpq_set_int32(bank_q[i], r->num, r->den);
+  mpq_set_int32(bank_mpq(i), r->num, r->den);
   r->num = i;
   r->den = 0;
 }
@@ -505,7 +715,7 @@ static void set_to_gmp64(rational_t *r, int64_t a) {
 
   assert(r->den != 0);
   i = alloc_mpq();
-  mpq_set_int64(bank_q[i], a, 1);
+  mpq_set_int64(bank_mpq(i), a, 1);
   r->num = i;
   r->den = 0;
 }
@@ -526,7 +736,7 @@ void q_normalize(rational_t *r) {
   long num;
 
   if (r->den == 0) {
-    q = bank_q[r->num];
+    q = bank_mpq(r->num);
     if (mpz_fits_ulong_p(mpq_denref(q)) && mpz_fits_slong_p(mpq_numref(q))) {
       num = mpz_get_si(mpq_numref(q));
       den = mpz_get_ui(mpq_denref(q));
@@ -557,7 +767,7 @@ static inline void q_prepare(rational_t *r) {
  */
 void q_set_mpz(rational_t *r, const mpz_t z) {
   q_prepare(r);
-  mpq_set_z(bank_q[r->num], z);
+  mpq_set_z(bank_mpq(r->num), z);
   q_normalize(r);
 }
 
@@ -567,7 +777,7 @@ void q_set_mpz(rational_t *r, const mpz_t z) {
  */
 void q_set_mpq(rational_t *r, const mpq_t q) {
   q_prepare(r);
-  mpq_set(bank_q[r->num], q);
+  mpq_set(bank_mpq(r->num), q);
   q_normalize(r);
 }
 
@@ -577,9 +787,9 @@ void q_set_mpq(rational_t *r, const mpq_t q) {
  */
 void q_set(rational_t *r1, const rational_t *r2) {
   if (r2->den == 0) {
-    //    q_set_mpq(r1, bank_q[r2->num]); BUG HERE
+    //    q_set_mpq(r1, bank_mpq(r2->num)); BUG HERE
     q_prepare(r1);
-    mpq_set(bank_q[r1->num], bank_q[r2->num]);
+    mpq_set(bank_mpq(r1->num), bank_mpq(r2->num));
   } else {
     if (r1->den == 0) free_mpq(r1->num);
     r1->num = r2->num;
@@ -594,7 +804,7 @@ void q_set(rational_t *r1, const rational_t *r2) {
 void q_set_neg(rational_t *r1, const rational_t *r2) {
   if (r2->den == 0) {
     q_prepare(r1);
-    mpq_neg(bank_q[r1->num], bank_q[r2->num]);
+    mpq_neg(bank_mpq(r1->num), bank_mpq(r2->num));
   } else {
     if (r1->den == 0) free_mpq(r1->num);
     r1->num = - r2->num;
@@ -609,7 +819,7 @@ void q_set_neg(rational_t *r1, const rational_t *r2) {
 void q_set_abs(rational_t *r1, const rational_t *r2) {
   if (r2->den == 0) {
     q_prepare(r1);
-    mpq_abs(bank_q[r1->num], bank_q[r2->num]);
+    mpq_abs(bank_mpq(r1->num), bank_mpq(r2->num));
   } else {
     if (r1->den == 0) free_mpq(r1->num);
     r1->den = r2->den;
@@ -632,7 +842,7 @@ void q_get_num(rational_t *r1, const rational_t *r2) {
   long num;
 
   if (r2->den == 0) {
-    q = bank_q[r2->num];
+    q = bank_mpq(r2->num);
     if (mpz_fits_slong_p(mpq_numref(q))) {
       num = mpz_get_si(mpq_numref(q));
       if (MIN_NUMERATOR <= num && num <= MAX_NUMERATOR) {
@@ -644,7 +854,7 @@ void q_get_num(rational_t *r1, const rational_t *r2) {
     }
     // BUG:    q_set_mpz(r1, mpq_numref(q));
     q_prepare(r1);
-    mpq_set_z(bank_q[r1->num], mpq_numref(bank_q[r2->num]));
+    mpq_set_z(bank_mpq(r1->num), mpq_numref(bank_mpq(r2->num)));
 
   } else {
     if (r1->den == 0) free_mpq(r1->num);
@@ -664,7 +874,7 @@ void q_get_den(rational_t *r1, const rational_t *r2) {
   unsigned long den;
 
   if (r2->den == 0) {
-    q = bank_q[r2->num];
+    q = bank_mpq(r2->num);
     if (mpz_fits_ulong_p(mpq_denref(q))) {
       den = mpz_get_ui(mpq_denref(q));
       if (den <= MAX_DENOMINATOR) {
@@ -676,7 +886,7 @@ void q_get_den(rational_t *r1, const rational_t *r2) {
     }
     // BUG    q_set_mpz(r1, mpq_denref(q));
     q_prepare(r1);
-    mpq_set_z(bank_q[r1->num], mpq_denref(bank_q[r2->num]));
+    mpq_set_z(bank_mpq(r1->num), mpq_denref(bank_mpq(r2->num)));
 
   } else {
     if (r1->den == 0) free_mpq(r1->num);
@@ -694,53 +904,27 @@ void q_get_den(rational_t *r1, const rational_t *r2) {
  ******************************************/
 
 /*
- * Resize string_buffer if necessary
- */
-static void resize_string_buffer(uint32_t new_size) {
-  uint32_t n;
-
-  if (string_buffer_length < new_size) {
-    /*
-     * try to make buffer 50% larger
-     * in principle the n += n >> 1 could overflow but
-     * then (n < new_size) will be true
-     * so n will be fixed to new_size.
-     *
-     * all this is very unlikely to happen in practice
-     * (this would require extremely large strings).
-     */
-    n = string_buffer_length + 1;
-    n += n >> 1;
-    if (n < new_size) n = new_size;
-
-    string_buffer = (char *) safe_realloc(string_buffer, n);
-    string_buffer_length = n;
-  }
-}
-
-/*
- * Assign q0 to r and try to convert to a pair of integers.
- * - q0 must be canonicalized
- * - return 0.
+ * Assign q to r and try to convert to a pair of integers.
+ * - q must be canonicalized
  */
-static int q_set_q0(rational_t *r) {
+static void q_set_canonical_mpq(rational_t *r, const mpq_t q) {
   int32_t i;
   unsigned long den;
   long num;
 
-  // try to store q0 as a pair num/den
-  if (mpz_fits_ulong_p(mpq_denref(q0)) && mpz_fits_slong_p(mpq_numref(q0))) {
-    num = mpz_get_si(mpq_numref(q0));
-    den = mpz_get_ui(mpq_denref(q0));
+  // try to store q as a pair num/den
+  if (mpz_fits_ulong_p(mpq_denref(q)) && mpz_fits_slong_p(mpq_numref(q))) {
+    num = mpz_get_si(mpq_numref(q));
+    den = mpz_get_ui(mpq_denref(q));
     if (MIN_NUMERATOR <= num && num <= MAX_NUMERATOR && den <= MAX_DENOMINATOR) {
       if (r->den == 0) free_mpq(r->num);
       r->num = (int32_t) num;
       r->den = (uint32_t) den;
-      return 0;
+      return;
     }
   }
 
-  // copy q0
+  // copy q
   if (r->den != 0) {
     i = alloc_mpq();
     r->den = 0;
@@ -748,9 +932,7 @@ static int q_set_q0(rational_t *r) {
   } else {
     i = r->num;
   }
-  mpq_set(bank_q[i], q0);
-
-  return 0;
+  mpq_set(bank_mpq(i), q);
 }
 
 /*
@@ -762,12 +944,7 @@ static int q_set_q0(rational_t *r) {
  * - returns 0 otherwise
  */
 int q_set_from_string(rational_t *r, const char *s) {
-  // GMP rejects an initial '+' so skip it
-  if (*s == '+') s ++;
-  if (mpq_set_str(q0, s, 10) < 0) return -1;
-  if (mpz_sgn(mpq_denref(q0)) == 0) return -2; // the denominator is zero
-  mpq_canonicalize(q0);
-  return q_set_q0(r);
+  return q_set_from_string_base(r, s, 10);
 }
 
 /*
@@ -779,13 +956,26 @@ int q_set_from_string(rational_t *r, const char *s) {
  * otherwise, the base is 10.
  */
 int q_set_from_string_base(rational_t *r, const char *s, int32_t base) {
+  mpq_t q;
+  int code;
+
   // GMP rejects an initial '+' so skip it
   if (*s == '+') s ++;
   assert(0 == base || (2 <= base && base <= 36));
-  if (mpq_set_str(q0, s, base) < 0) return -1;
-  if (mpz_sgn(mpq_denref(q0)) == 0) return -2; // the denominator is zero
-  mpq_canonicalize(q0);
-  return q_set_q0(r);
+
+  mpq_init(q);
+  if (mpq_set_str(q, s, base) < 0) {
+    code = -1;
+  } else if (mpz_sgn(mpq_denref(q)) == 0) {
+    code = -2; // the denominator is zero
+  } else {
+    mpq_canonicalize(q);
+    q_set_canonical_mpq(r, q);
+    code = 0;
+  }
+  mpq_clear(q);
+
+  return code;
 }
 
 /*
@@ -801,17 +991,18 @@ int q_set_from_string_base(rational_t *r, const char *s, int32_t base) {
  * - returns 0 otherwise
  */
 int q_set_from_float_string(rational_t *r, const char *s) {
+  mpq_t q;
   size_t len;
   int frac_len, sign;
   long int exponent;
-  char *b, c;
+  char *buffer, *b, c;
 
   len = strlen(s);
   if (len >= (size_t) UINT32_MAX) {
     // just to be safe if s is really long
     out_of_memory();
   }
-  resize_string_buffer(len + 1);
+  buffer = (char *) safe_malloc(len + 1);
   c = *s ++;
 
   // get sign
@@ -824,7 +1015,7 @@ int q_set_from_float_string(rational_t *r, const char *s) {
   }
 
   // copy integer part into buffer.
-  b = string_buffer;
+  b = buffer;
   while ('0' <= c && c <= '9') {
     *b ++ = c;
     c = * s ++;
@@ -847,39 +1038,52 @@ int q_set_from_float_string(rational_t *r, const char *s) {
   if (c == 'e' || c == 'E') {
     errno = 0;  // strtol sets errno on error
     exponent = strtol(s, (char **) NULL, 10);
-    if (errno != 0) return -1;
+    if (errno != 0) {
+      safe_free(buffer);
+      return -1;
+    }
   }
 
 #if 0
   printf("--> Float conversion\n");
   printf("--> sign = %d\n", sign);
-  printf("--> mantissa = %s\n", string_buffer);
+  printf("--> mantissa = %s\n", buffer);
   printf("--> frac_len = %d\n", frac_len);
   printf("--> exponent = %ld\n", exponent);
 #endif
 
-  mpq_set_ui(q0, 0, 1);
+  mpq_init(q);
 
   // set numerator
-  if (mpz_set_str(mpq_numref(q0), string_buffer, 10) < 0) {
+  if (mpz_set_str(mpq_numref(q), buffer, 10) < 0) {
+    mpq_clear(q);
+    safe_free(buffer);
     return -1;
   }
+  safe_free(buffer);
+
   if (sign < 0) {
-    mpq_neg(q0, q0);
+    mpq_neg(q, q);
   }
 
   // multiply by 10^exponent
   exponent -= frac_len;
   if (exponent > 0) {
-    mpz_ui_pow_ui(z0, 10, exponent);
-    mpz_mul(mpq_numref(q0), mpq_numref(q0), z0);
+    mpz_t z;
+    mpz_init(z);
+    mpz_ui_pow_ui(z, 10, exponent);
+    mpz_mul(mpq_numref(q), mpq_numref(q), z);
+    mpz_clear(z);
   } else if (exponent < 0) {
     // this works even if exponent == LONG_MIN.
-    mpz_ui_pow_ui(mpq_denref(q0), 10UL, (unsigned long) (- exponent));
-    mpq_canonicalize(q0);
+    mpz_ui_pow_ui(mpq_denref(q), 10UL, (unsigned long) (- exponent));
+    mpq_canonicalize(q);
   }
 
-  return q_set_q0(r);
+  q_set_canonical_mpq(r, q);
+  mpq_clear(q);
+
+  return 0;
 }
 
 
@@ -897,8 +1101,7 @@ int q_set_from_float_string(rational_t *r, const char *s) {
  * Add r2 to r1
  */
 void q_add(rational_t *r1, const rational_t *r2) {
-  uint64_t den;
-  int64_t num;
+  int64_t num, den;
 
   if (r1->den == 1 && r2->den == 1) {
     r1->num += r2->num;
@@ -910,15 +1113,14 @@ void q_add(rational_t *r1, const rational_t *r2) {
 
   if (r2->den == 0) {
     if (r1->den != 0) convert_to_gmp(r1) ;
-    mpq_add(bank_q[r1->num], bank_q[r1->num], bank_q[r2->num]);
+    mpq_add(bank_mpq(r1->num), bank_mpq(r1->num), bank_mpq(r2->num));
 
   } else if (r1->den == 0) {
-    mpq_add_si(bank_q[r1->num], r2->num, r2->den);
+    mpq_add_si(bank_mpq(r1->num), r2->num, r2->den);
 
   } else {
-    den = r1->den * ((uint64_t) r2->den);
-    num = r1->den * ((int64_t) r2->num) + r2->den * ((int64_t) r1->num);
-    q_set_int64(r1, num, den);
+    (void) add_fractions64(r1->num, r1->den, r2->num, r2->den, &num, &den); // no overflow on pairs
+    q_set_canonical64(r1, num, den);
   }
 }
 
@@ -927,8 +1129,7 @@ void q_add(rational_t *r1, const rational_t *r2) {
  * Subtract r2 from r1
  */
 void q_sub(rational_t *r1, const rational_t *r2) {
-  uint64_t den;
-  int64_t num;
+  int64_t num, den;
 
   if (r1->den == 1 && r2->den == 1) {
     r1->num -= r2->num;
@@ -940,15 +1141,14 @@ void q_sub(rational_t *r1, const rational_t *r2) {
 
   if (r2->den == 0) {
     if (r1->den != 0) convert_to_gmp(r1) ;
-    mpq_sub(bank_q[r1->num], bank_q[r1->num], bank_q[r2->num]);
+    mpq_sub(bank_mpq(r1->num), bank_mpq(r1->num), bank_mpq(r2->num));
 
   } else if (r1->den == 0) {
-    mpq_sub_si(bank_q[r1->num], r2->num, r2->den);
+    mpq_sub_si(bank_mpq(r1->num), r2->num, r2->den);
 
   } else {
-    den = r1->den * ((uint64_t) r2->den);
-    num = r2->den * ((int64_t) r1->num) - r1->den * ((int64_t) r2->num);
-    q_set_int64(r1, num, den);
+    (void) add_fractions64(r1->num, r1->den, - (int64_t) r2->num, r2->den, &num, &den); // no overflow on pairs
+    q_set_canonical64(r1, num, den);
   }
 }
 
@@ -958,7 +1158,7 @@ void q_sub(rational_t *r1, const rational_t *r2) {
  */
 void q_neg(rational_t *r) {
   if (r->den == 0) {
-    mpq_neg(bank_q[r->num], bank_q[r->num]);
+    mpq_neg(bank_mpq(r->num), bank_mpq(r->num));
   } else {
     r->num = - r->num;
   }
@@ -973,7 +1173,7 @@ void q_inv(rational_t *r) {
   uint32_t abs_num;
 
   if (r->den == 0) {
-    mpq_inv(bank_q[r->num], bank_q[r->num]);
+    mpq_inv(bank_mpq(r->num), bank_mpq(r->num));
 
   } else if (r->num < 0) {
     abs_num = (uint32_t) - r->num;
@@ -995,8 +1195,7 @@ void q_inv(rational_t *r) {
  * Multiply r1 by r2
  */
 void q_mul(rational_t *r1, const rational_t *r2) {
-  uint64_t den;
-  int64_t num;
+  int64_t num, den;
 
   if (r1->den == 1 && r2->den == 1) {
     num = r1->num * ((int64_t) r2->num);
@@ -1010,15 +1209,14 @@ void q_mul(rational_t *r1, const rational_t *r2) {
 
   if (r2->den == 0) {
     if (r1->den != 0) convert_to_gmp(r1);
-    mpq_mul(bank_q[r1->num], bank_q[r1->num], bank_q[r2->num]);
+    mpq_mul(bank_mpq(r1->num), bank_mpq(r1->num), bank_mpq(r2->num));
 
   } else if (r1->den == 0) {
-    mpq_mul_si(bank_q[r1->num], r2->num, r2->den);
+    mpq_mul_si(bank_mpq(r1->num), r2->num, r2->den);
 
   } else {
-    den = r1->den * ((uint64_t) r2->den);
-    num = r1->num * ((int64_t) r2->num);
-    q_set_int64(r1, num, den);
+    (void) mul_fractions64(r1->num, r1->den, r2->num, r2->den, &num, &den); // no overflow on pairs
+    q_set_canonical64(r1, num, den);
   }
 }
 
@@ -1027,29 +1225,26 @@ void q_mul(rational_t *r1, const rational_t *r2) {
  * Divide r1 by r2
  */
 void q_div(rational_t *r1, const rational_t *r2) {
-  uint64_t den;
-  int64_t num;
+  int64_t num, den;
 
   if (r2->den == 0) {
     if (r1->den != 0) convert_to_gmp(r1);
-    mpq_div(bank_q[r1->num], bank_q[r1->num], bank_q[r2->num]);
+    mpq_div(bank_mpq(r1->num), bank_mpq(r1->num), bank_mpq(r2->num));
 
   } else if (r1->den == 0) {
     if (r2->num == 0) {
       division_by_zero();
     } else {
-      mpq_div_si(bank_q[r1->num], r2->num, r2->den);
+      mpq_div_si(bank_mpq(r1->num), r2->num, r2->den);
     }
 
   } else if (r2->num > 0) {
-    den = r1->den * ((uint64_t) r2->num);
-    num = r1->num * ((int64_t) r2->den);
-    q_set_int64(r1, num, den);
+    (void) mul_fractions64(r1->num, r1->den, r2->den, r2->num, &num, &den); // no overflow on pairs
+    q_set_canonical64(r1, num, den);
 
   } else if (r2->num < 0) {
-    den = r1->den * ((uint64_t) (- r2->num));
-    num = r1->num * ( - ((int64_t) r2->den));
-    q_set_int64(r1, num, den);
+    (void) mul_fractions64(r1->num, r1->den, - (int64_t) r2->den, - (int64_t) r2->num, &num, &den); // no overflow on pairs
+    q_set_canonical64(r1, num, den);
 
   } else {
     division_by_zero();
@@ -1061,7 +1256,7 @@ void q_div(rational_t *r1, const rational_t *r2) {
  * Add r2 * r3 to  r1
  */
 void q_addmul(rational_t *r1, const rational_t *r2, const rational_t *r3) {
-  int64_t num;
+  int64_t num, den, np, dp;
   rational_t tmp;
 
   if (r1->den == 1 && r2->den == 1 && r3->den == 1) {
@@ -1074,6 +1269,23 @@ void q_addmul(rational_t *r1, const rational_t *r2, const rational_t *r3) {
     return;
   }
 
+  if (r2->den != 0 && r3->den != 0) {
+    /*
+     * Fast path: the product np/dp is computed in 64 bits
+     * without allocating a temporary rational.
+     */
+    (void) mul_fractions64(r2->num, r2->den, r3->num, r3->den, &np, &dp); // no overflow on pairs
+    if (r1->den != 0) {
+      if (add_fractions64(r1->num, r1->den, np, dp, &num, &den)) {
+        q_set_canonical64(r1, num, den);
+        return;
+      }
+      convert_to_gmp(r1);
+    }
+    mpq_add_int64(bank_mpq(r1->num), np, dp);
+    return;
+  }
+
   q_init(&tmp);
   q_set(&tmp, r2);
   q_mul(&tmp, r3);
@@ -1088,7 +1300,7 @@ void q_addmul(rational_t *r1, const rational_t *r2, const rational_t *r3) {
  * Subtract r2 * r3 from r1
  */
 void q_submul(rational_t *r1, const rational_t *r2, const rational_t *r3) {
-  int64_t num;
+  int64_t num, den, np, dp;
   rational_t tmp;
 
   if (r1->den == 1 && r2->den == 1 && r3->den == 1) {
@@ -1101,6 +1313,24 @@ void q_submul(rational_t *r1, const rational_t *r2, const rational_t *r3) {
     return;
   }
 
+  if (r2->den != 0 && r3->den != 0) {
+    /*
+     * Fast path: the product np/dp is computed in 64 bits
+     * without allocating a temporary rational.
+     */
+    (void) mul_fractions64(r2->num, r2->den, r3->num, r3->den, &np, &dp); // no overflow on pairs
+    np = - np;
+    if (r1->den != 0) {
+      if (add_fractions64(r1->num, r1->den, np, dp, &num, &den)) {
+        q_set_canonical64(r1, num, den);
+        return;
+      }
+      convert_to_gmp(r1);
+    }
+    mpq_add_int64(bank_mpq(r1->num), np, dp);
+    return;
+  }
+
   q_init(&tmp);
   q_set(&tmp, r2);
   q_mul(&tmp, r3);
@@ -1116,7 +1346,7 @@ void q_add_one(rational_t *r1) {
   int32_t n;
   if (r1->den == 0) {
     n = r1->num;
-    mpz_add(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_denref(bank_q[n]));
+    mpz_add(mpq_numref(bank_mpq(n)), mpq_numref(bank_mpq(n)), mpq_denref(bank_mpq(n)));
   } else {
     r1->num += r1->den;
     if (r1->num > MAX_NUMERATOR) {
@@ -1132,7 +1362,7 @@ void q_sub_one(rational_t *r1) {
   int32_t n;
   if (r1->den == 0) {
     n = r1->num;
-    mpz_sub(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_denref(bank_q[n]));
+    mpz_sub(mpq_numref(bank_mpq(n)), mpq_numref(bank_mpq(n)), mpq_denref(bank_mpq(n)));
   } else {
     r1->num -= r1->den;
     if (r1->num < MIN_NUMERATOR) {
@@ -1155,8 +1385,8 @@ void q_floor(rational_t *r) {
 
   if (r->den == 0) {
     n = r->num;
-    mpz_fdiv_q(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_denref(bank_q[n]));
-    mpz_set_ui(mpq_denref(bank_q[n]), 1UL);
+    mpz_fdiv_q(mpq_numref(bank_mpq(n)), mpq_numref(bank_mpq(n)), mpq_denref(bank_mpq(n)));
+    mpz_set_ui(mpq_denref(bank_mpq(n)), 1UL);
   } else {
     n = r->num / (int32_t) r->den;
     if (r->num < 0) n --;
@@ -1173,8 +1403,8 @@ void q_ceil(rational_t *r) {
 
   if (r->den == 0) {
     n = r->num;
-    mpz_cdiv_q(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_denref(bank_q[n]));
-    mpz_set_ui(mpq_denref(bank_q[n]), 1UL);
+    mpz_cdiv_q(mpq_numref(bank_mpq(n)), mpq_numref(bank_mpq(n)), mpq_denref(bank_mpq(n)));
+    mpz_set_ui(mpq_denref(bank_mpq(n)), 1UL);
   } else {
     n = r->num / (int32_t) r->den;
     if (r->num > 0) n ++;
@@ -1262,13 +1492,13 @@ void q_lcm(rational_t *r1, const rational_t *r2) {
     } else {
       // r2 is 32bits, r1 is gmp
       b = abs32(r2->num);
-      mpz_lcm_ui(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]), b);
+      mpz_lcm_ui(mpq_numref(bank_mpq(r1->num)), mpq_numref(bank_mpq(r1->num)), b);
     }
 
   } else {
     // r2 is a gmp rational
     if (r1->den != 0) convert_to_gmp(r1);
-    mpz_lcm(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r2->num]));
+    mpz_lcm(mpq_numref(bank_mpq(r1->num)), mpq_numref(bank_mpq(r1->num)), mpq_numref(bank_mpq(r2->num)));
   }
 
 }
@@ -1291,7 +1521,7 @@ void q_gcd(rational_t *r1, const rational_t *r2) {
     } else {
       // r1 is gmp, r2 is a small integer
       b = abs32(r2->num);
-      d = mpz_gcd_ui(NULL, mpq_numref(bank_q[r1->num]), b);
+      d = mpz_gcd_ui(NULL, mpq_numref(bank_mpq(r1->num)), b);
       free_mpq(r1->num);
     }
     assert(d <= MAX_NUMERATOR);
@@ -1301,13 +1531,13 @@ void q_gcd(rational_t *r1, const rational_t *r2) {
     if (r1->den != 0) {
       // r1 is a small integer, r2 is a gmp number
       a = abs32(r1->num);
-      d = mpz_gcd_ui(NULL, mpq_numref(bank_q[r2->num]), a);
+      d = mpz_gcd_ui(NULL, mpq_numref(bank_mpq(r2->num)), a);
       assert(d <= MAX_NUMERATOR);
       r1->num = d;
       r1->den = 1;
     } else {
       // both are gmp numbers
-      mpz_gcd(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r2->num]));
+      mpz_gcd(mpq_numref(bank_mpq(r1->num)), mpq_numref(bank_mpq(r1->num)), mpq_numref(bank_mpq(r2->num)));
     }
   }
 }
@@ -1339,11 +1569,11 @@ void q_integer_div(rational_t *r1, rational_t *r2) {
       }
     } else {
       // r1 is gmp, r2 is a small integer
-      mpz_fdiv_q_ui(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]), r2->num);
-      assert(mpq_is_integer(bank_q[r1->num]));
+      mpz_fdiv_q_ui(mpq_numref(bank_mpq(r1->num)), mpq_numref(bank_mpq(r1->num)), r2->num);
+      assert(mpq_is_integer(bank_mpq(r1->num)));
     }
   } else {
-    assert(mpq_is_integer(bank_q[r2->num]) && mpq_sgn(bank_q[r2->num]) > 0);
+    assert(mpq_is_integer(bank_mpq(r2->num)) && mpq_sgn(bank_mpq(r2->num)) > 0);
     if (r1->den != 0) {
       /*
        * r1 is a small integer, r2 is a gmp rational
@@ -1358,9 +1588,9 @@ void q_integer_div(rational_t *r1, rational_t *r2) {
       }
     } else {
       // both r1 and r2 are gmp rationals
-      mpz_fdiv_q(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]),
-                 mpq_numref(bank_q[r2->num]));
-      assert(mpq_is_integer(bank_q[r1->num]));
+      mpz_fdiv_q(mpq_numref(bank_mpq(r1->num)), mpq_numref(bank_mpq(r1->num)),
+                 mpq_numref(bank_mpq(r2->num)));
+      assert(mpq_is_integer(bank_mpq(r1->num)));
     }
   }
 }
@@ -1390,14 +1620,14 @@ void q_integer_rem(rational_t *r1, rational_t *r2) {
       r1->num = n;
     } else {
       // r1 is gmp, r2 is a small integer
-      n = mpz_fdiv_ui(mpq_numref(bank_q[r1->num]), r2->num);
+      n = mpz_fdiv_ui(mpq_numref(bank_mpq(r1->num)), r2->num);
       assert(0 <= n && n <= MAX_NUMERATOR);
       free_mpq(r1->num);
       r1->num = n;
       r1->den = 1;
     }
   } else {
-    assert(mpq_is_integer(bank_q[r2->num]) && mpq_sgn(bank_q[r2->num]) > 0);
+    assert(mpq_is_integer(bank_mpq(r2->num)) && mpq_sgn(bank_mpq(r2->num)) > 0);
     if (r1->den != 0) {
       /*
        * r1 is a small integer, r2 is a gmp rational
@@ -1408,18 +1638,18 @@ void q_integer_rem(rational_t *r1, rational_t *r2) {
       assert(r1->den == 1);
       if (r1->num < 0) {
         n = alloc_mpq();
-        mpq_set_si(bank_q[n], r1->num, 1UL);
-        mpz_add(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_numref(bank_q[r2->num]));
+        mpq_set_si(bank_mpq(n), r1->num, 1UL);
+        mpz_add(mpq_numref(bank_mpq(n)), mpq_numref(bank_mpq(n)), mpq_numref(bank_mpq(r2->num)));
         r1->num = n;
         r1->den = 0;
-        assert(mpq_is_integer(bank_q[n]) && mpq_sgn(bank_q[n]) > 0);
+        assert(mpq_is_integer(bank_mpq(n)) && mpq_sgn(bank_mpq(n)) > 0);
       }
 
     } else {
       // both r1 and r2 are gmp rationals
-      mpz_fdiv_r(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]),
-                 mpq_numref(bank_q[r2->num]));
-      assert(mpq_is_integer(bank_q[r1->num]));
+      mpz_fdiv_r(mpq_numref(bank_mpq(r1->num)), mpq_numref(bank_mpq(r1->num)),
+                 mpq_numref(bank_mpq(r2->num)));
+      assert(mpq_is_integer(bank_mpq(r1->num)));
     }
   }
 }
@@ -1437,7 +1667,7 @@ bool q_integer_divides(rational_t *r1, const rational_t *r2) {
 
   if (r1->den == 0) {
     if (r2->den == 0) {
-      return mpz_divisible_p(mpq_numref(bank_q[r2->num]), mpq_numref(bank_q[r1->num]));
+      return mpz_divisible_p(mpq_numref(bank_mpq(r2->num)), mpq_numref(bank_mpq(r1->num)));
     } else {
       return false;  // abs(r1) > abs(r2) so r1 can't divide r2
     }
@@ -1446,7 +1676,7 @@ bool q_integer_divides(rational_t *r1, const rational_t *r2) {
     assert(r1->den == 1);
     aux = abs32(r1->num);
     if (r2->den == 0) {
-      return mpz_divisible_ui_p(mpq_numref(bank_q[r2->num]), aux);
+      return mpz_divisible_ui_p(mpq_numref(bank_mpq(r2->num)), aux);
     } else {
       return abs32(r2->num) % aux == 0;
     }
@@ -1671,13 +1901,13 @@ int q_cmp(const rational_t *r1, const rational_t *r2) {
 
   if (r1->den == 0) {
     if (r2->den == 0) {
-      return mpq_cmp(bank_q[r1->num], bank_q[r2->num]);
+      return mpq_cmp(bank_mpq(r1->num), bank_mpq(r2->num));
     } else {
-      return mpq_cmp_si(bank_q[r1->num], r2->num, r2->den);
+      return mpq_cmp_si(bank_mpq(r1->num), r2->num, r2->den);
     }
   } else {
     if (r2->den == 0) {
-      return - mpq_cmp_si(bank_q[r2->num], r1->num, r1->den);
+      return - mpq_cmp_si(bank_mpq(r2->num), r1->num, r1->den);
     } else {
       num = r2->den * ((int64_t) r1->num) - r1->den * ((int64_t) r2->num);
       return (num < 0 ? -1 : (num > 0));
@@ -1693,7 +1923,7 @@ int q_cmp_int32(const rational_t *r1, int32_t num, uint32_t den) {
   int64_t nn;
 
   if (r1->den == 0) {
-    return mpq_cmp_si(bank_q[r1->num], num, den);
+    return mpq_cmp_si(bank_mpq(r1->num), num, den);
   } else {
     nn = den * ((int64_t) r1->num) - r1->den * ((int64_t) num);
     return (nn < 0 ? -1 : (nn > 0));
@@ -1701,13 +1931,28 @@ int q_cmp_int32(const rational_t *r1, int32_t num, uint32_t den) {
 }
 
 int q_cmp_int64(const rational_t *r1, int64_t num, uint64_t den) {
-  mpq_set_int64(q0, num, den);
-  mpq_canonicalize(q0);
+  mpq_t q;
+  int64_t a, b;
+  int c;
+
+  // fast path: compare r1->num * den with num * r1->den
+  if (r1->den != 0 && den <= INT64_MAX &&
+      ! mul64_overflow(r1->num, (int64_t) den, &a) &&
+      ! mul64_overflow(num, r1->den, &b)) {
+    return (a < b ? -1 : (a > b));
+  }
+
+  mpq_init(q);
+  mpq_set_int64(q, num, den);
+  mpq_canonicalize(q);
   if (r1->den == 0) {
-    return mpq_cmp(bank_q[r1->num], q0);
+    c = mpq_cmp(bank_mpq(r1->num), q);
   } else {
-    return - mpq_cmp_si(q0, r1->num, r1->den);
+    c = - mpq_cmp_si(q, r1->num, r1->den);
   }
+  mpq_clear(q);
+
+  return c;
 }
 
 
@@ -1748,8 +1993,8 @@ bool q_get32(rational_t *r, int32_t *v) {
   if (r->den == 1) {
     *v = r->num;
     return true;
-  } else if (r->den == 0 && mpq_fits_int32(bank_q[r->num])) {
-    mpq_get_int32(bank_q[r->num], v, &d);
+  } else if (r->den == 0 && mpq_fits_int32(bank_mpq(r->num))) {
+    mpq_get_int32(bank_mpq(r->num), v, &d);
     return d == 1;
   } else {
     return false;
@@ -1767,8 +2012,8 @@ bool q_get64(rational_t *r, int64_t *v) {
   if (r->den == 1) {
     *v = r->num;
     return true;
-  } else if (r->den == 0 && mpq_fits_int64(bank_q[r->num])) {
-    mpq_get_int64(bank_q[r->num], v, &d);
+  } else if (r->den == 0 && mpq_fits_int64(bank_mpq(r->num))) {
+    mpq_get_int64(bank_mpq(r->num), v, &d);
     return d == 1;
   } else {
     return false;
@@ -1785,8 +2030,8 @@ bool q_get_int32(rational_t *r, int32_t *num, uint32_t *den) {
     *num = r->num;
     *den = r->den;
     return true;
-  } else if (mpq_fits_int32(bank_q[r->num])) {
-    mpq_get_int32(bank_q[r->num], num, den);
+  } else if (mpq_fits_int32(bank_mpq(r->num))) {
+    mpq_get_int32(bank_mpq(r->num), num, den);
     return true;
   } else {
     return false;
@@ -1802,8 +2047,8 @@ bool q_get_int64(rational_t *r, int64_t *num, uint64_t *den) {
     *num = r->num;
     *den = r->den;
     return true;
-  } else if (mpq_fits_int64(bank_q[r->num])) {
-    mpq_get_int64(bank_q[r->num], num, den);
+  } else if (mpq_fits_int64(bank_mpq(r->num))) {
+    mpq_get_int64(bank_mpq(r->num), num, den);
     return true;
   } else {
     return false;
@@ -1817,19 +2062,19 @@ bool q_get_int64(rational_t *r, int64_t *num, uint64_t *den) {
  * a 64bit integer, or two a pair num/den of 32bit or 64bit integers.
  */
 bool q_is_int32(rational_t *r) {
-  return r->den == 1 || (r->den == 0 && mpq_is_int32(bank_q[r->num]));
+  return r->den == 1 || (r->den == 0 && mpq_is_int32(bank_mpq(r->num)));
 }
 
 bool q_is_int64(rational_t *r) {
-  return r->den == 1 || (r->den == 0 && mpq_is_int64(bank_q[r->num]));
+  return r->den == 1 || (r->den == 0 && mpq_is_int64(bank_mpq(r->num)));
 }
 
 bool q_fits_int32(rational_t *r) {
-  return r->den != 0 || mpq_fits_int32(bank_q[r->num]);
+  return r->den != 0 || mpq_fits_int32(bank_mpq(r->num));
 }
 
 bool q_fits_int64(rational_t *r) {
-  return r->den != 0 || mpq_fits_int64(bank_q[r->num]);
+  return r->den != 0 || mpq_fits_int64(bank_mpq(r->num));
 }
 
 
@@ -1844,7 +2089,7 @@ uint32_t q_size(rational_t *r) {
 
   n = 32;
   if (r->den == 0) {
-    n = mpz_size(mpq_numref(bank_q[r->num])) * mp_bits_per_limb;
+    n = mpz_size(mpq_numref(bank_mpq(r->num))) * mp_bits_per_limb;
     if (n > (size_t) UINT32_MAX) {
       n = UINT32_MAX;
     }
@@ -1862,8 +2107,8 @@ bool q_get_mpz(rational_t *r, mpz_t z) {
   if (r->den == 1) {
     mpz_set_si(z, r->num);
     return true;
-  } else if (r->den == 0 && mpq_is_integer(bank_q[r->num])) {
-    mpz_set(z, mpq_numref(bank_q[r->num]));
+  } else if (r->den == 0 && mpq_is_integer(bank_mpq(r->num))) {
+    mpz_set(z, mpq_numref(bank_mpq(r->num)));
     return true;
   } else {
     return false;
@@ -1876,7 +2121,7 @@ bool q_get_mpz(rational_t *r, mpz_t z) {
  */
 void q_get_mpq(rational_t *r, mpq_t q) {
   if (r->den == 0) {
-    mpq_set(q, bank_q[r->num]);
+    mpq_set(q, bank_mpq(r->num));
   } else {
     mpq_set_int32(q, r->num, r->den);
   }
@@ -1888,8 +2133,20 @@ void q_get_mpq(rational_t *r, mpq_t q) {
  * Convert to a double
  */
 double q_get_double(rational_t *r) {
-  q_get_mpq(r, q0);
-  return mpq_get_d(q0);
+  mpq_t q;
+  double d;
+
+  if (r->den == 1) {
+    return (double) r->num;
+  } else if (r->den == 0) {
+    return mpq_get_d(bank_mpq(r->num));
+  } else {
+    mpq_init(q);
+    mpq_set_si(q, r->num, r->den);
+    d = mpq_get_d(q);
+    mpq_clear(q);
+    return d;
+  }
 }
 
 
@@ -1904,7 +2161,7 @@ double q_get_double(rational_t *r) {
  */
 void q_print(FILE *f, const rational_t *r) {
   if (r->den == 0) {
-    mpq_out_str(f, 10, bank_q[r->num]);
+    mpq_out_str(f, 10, bank_mpq(r->num));
   } else if (r->den != 1) {
     fprintf(f, "%" PRId32 "/%" PRIu32, r->num, r->den);
   } else {
@@ -1920,13 +2177,13 @@ void q_print_abs(FILE *f, const rational_t *r) {
   int32_t abs_num;
 
   if (r->den == 0) {
-    q = bank_q[r->num];
+    q = bank_mpq(r->num);
     if (mpq_sgn(q) < 0) {
       mpq_neg(q, q);
-      mpq_out_str(f, 10, bank_q[r->num]);
+      mpq_out_str(f, 10, bank_mpq(r->num));
       mpq_neg(q, q);
     } else {
-      mpq_out_str(f, 10, bank_q[r->num]);
+      mpq_out_str(f, 10, bank_mpq(r->num));
     }
   } else {
     abs_num = r->num;
@@ -1961,7 +2218,7 @@ void q_print_abs(FILE *f, const rational_t *r) {
  */
 uint32_t q_hash_numerator(const rational_t *r) {
   if (r->den == 0) {
-    return (uint32_t) mpz_fdiv_ui(mpq_numref(bank_q[r->num]), HASH_MODULUS);
+    return (uint32_t) mpz_fdiv_ui(mpq_numref(bank_mpq(r->num)), HASH_MODULUS);
   } else if (r->num >= 0) {
     return (uint32_t) r->num;
   } else {
@@ -1971,15 +2228,15 @@ uint32_t q_hash_numerator(const rational_t *r) {
 
 uint32_t q_hash_denominator(const rational_t *r) {
   if (r->den == 0) {
-    return (uint32_t) mpz_fdiv_ui(mpq_denref(bank_q[r->num]), HASH_MODULUS);
+    return (uint32_t) mpz_fdiv_ui(mpq_denref(bank_mpq(r->num)), HASH_MODULUS);
   }
   return r->den;
 }
 
 void q_hash_decompose(const rational_t *r, uint32_t *h_num, uint32_t *h_den) {
   if (r->den == 0) {
-    *h_num = (uint32_t) mpz_fdiv_ui(mpq_numref(bank_q[r->num]), HASH_MODULUS);
-    *h_den = (uint32_t) mpz_fdiv_ui(mpq_denref(bank_q[r->num]), HASH_MODULUS);
+    *h_num = (uint32_t) mpz_fdiv_ui(mpq_numref(bank_mpq(r->num)), HASH_MODULUS);
+    *h_den = (uint32_t) mpz_fdiv_ui(mpq_denref(bank_mpq(r->num)), HASH_MODULUS);
   } else if (r->num >= 0) {
     *h_num = (uint32_t) r->num;
     *h_den = r->den;
@@ -49,9 +49,35 @@ typedef struct {
 
 /*
  * Global bank of GMP numbers
+ * - bank_mpq(i) = the gmp number of index i
+ *
+ * In the default build, bank_q is a single array that's resized
+ * (and may move) when the bank grows.
+ *
+ * In the thread-safe build, the bank is divided into blocks of
+ * MPQ_BLOCK_SIZE numbers and bank_q is a fixed array of pointers
+ * to these blocks. Blocks are never moved once allocated so a
+ * thread can read or update number i while other threads allocate
+ * new numbers.
  */
+#ifdef THREAD_SAFE
+
+#define MPQ_BLOCK_BITS 12
+#define MPQ_BLOCK_SIZE (1u<<MPQ_BLOCK_BITS)
+#define MPQ_BLOCK_MASK (MPQ_BLOCK_SIZE-1)
+
+extern mpq_t *bank_q[];
+
+#define bank_mpq(i) (bank_q[(i) >> MPQ_BLOCK_BITS][(i) & MPQ_BLOCK_MASK])
+
+#else
+
 extern mpq_t *bank_q;
 
+#define bank_mpq(i) (bank_q[i])
+
+#endif
+
 /*
  * Initialization: allocate and initialize
  * global variables.
@@ -346,7 +372,7 @@ extern void q_smt2_mod(rational_t *q, const rational_t *x, const rational_t *y);
  */
 static inline int q_sgn(rational_t *r) {
   if (r->den == 0) {
-    return mpq_sgn(bank_q[r->num]);
+    return mpq_sgn(bank_mpq(r->num));
   } else {
     return (r->num < 0 ? -1 : (r->num > 0));
   }
@@ -417,41 +443,41 @@ extern bool q_opposite(const rational_t *r1, const rational_t *r2);
  * Tests on rational r
  */
 static inline bool q_is_zero(const rational_t *r) {
-  return r->den == 0 ? mpq_is_zero(bank_q[r->num]) : r->num == 0;
+  return r->den == 0 ? mpq_is_zero(bank_mpq(r->num)) : r->num == 0;
 }
 
 static inline bool q_is_nonzero(const rational_t *r) {
-  return r->den == 0 ? mpq_is_nonzero(bank_q[r->num]) : r->num != 0;
+  return r->den == 0 ? mpq_is_nonzero(bank_mpq(r->num)) : r->num != 0;
 }
 
 static inline bool q_is_one(const rational_t *r) {
   return (r->den == 1 && r->num == 1) ||
-    (r->den == 0 && mpq_is_one(bank_q[r->num]));
+    (r->den == 0 && mpq_is_one(bank_mpq(r->num)));
 }
 
 static inline bool q_is_minus_one(const rational_t *r) {
   return (r->den == 1 && r->num == -1) ||
-    (r->den == 0 && mpq_is_minus_one(bank_q[r->num]));
+    (r->den == 0 && mpq_is_minus_one(bank_mpq(r->num)));
 }
 
 static inline bool q_is_pos(const rational_t *r) {
-  return (r->den > 0 ?  r->num > 0 : mpq_is_pos(bank_q[r->num]));
+  return (r->den > 0 ?  r->num > 0 : mpq_is_pos(bank_mpq(r->num)));
 }
 
 static inline bool q_is_nonneg(const rational_t *r) {
-  return (r->den > 0 ?  r->num >= 0 : mpq_is_nonneg(bank_q[r->num]));
+  return (r->den > 0 ?  r->num >= 0 : mpq_is_nonneg(bank_mpq(r->num)));
 }
 
 static inline bool q_is_neg(const rational_t *r) {
-  return (r->den > 0 ?  r->num < 0 : mpq_is_neg(bank_q[r->num]));
+  return (r->den > 0 ?  r->num < 0 : mpq_is_neg(bank_mpq(r->num)));
 }
 
 static inline bool q_is_nonpos(const rational_t *r) {
-  return (r->den > 0 ?  r->num <= 0 : mpq_is_nonpos(bank_q[r->num]));
+  return (r->den > 0 ?  r->num <= 0 : mpq_is_nonpos(bank_mpq(r->num)));
 }
 
 static inline bool q_is_integer(const rational_t *r) {
-  return (r->den == 1) || (r->den == 0 && mpq_is_integer(bank_q[r->num]));
+  return (r->den == 1) || (r->den == 0 && mpq_is_integer(bank_mpq(r->num)));
 }
 
 
@@ -282,6 +282,8 @@ static void type_table_init(type_table_t *table, uint32_t n) {
 
   // macro table: not allocated yet
   table->macro_tbl = NULL;
+
+  create_yices_lock(&table->lock);
 }
 
 
@@ -1202,6 +1204,8 @@ void delete_type_table(type_table_t *table) {
     safe_free(table->macro_tbl);
     table->macro_tbl = NULL;
   }
+
+  destroy_yices_lock(&table->lock);
 }
 
 
@@ -2249,6 +2253,9 @@ static type_t sup_fun_types(type_table_t *table, uint32_t n, type_t *a, type_t t
  * Compute the smallest supertype of tau1 and tau2.  Use the cheap
  * method first. If that fails, compute the result and keep the result
  * in the internal sup_tbl cache.
+ *
+ * The cache is protected by table->lock (a recursive lock, since
+ * sup_tuple_types and sup_fun_types call super_type).
  */
 type_t super_type(type_table_t *table, type_t tau1, type_t tau2) {
   tuple_type_t *tup1, *tup2;
@@ -2274,6 +2281,7 @@ type_t super_type(type_table_t *table, type_t tau1, type_t tau2) {
     }
     assert(tau1 < tau2);
 
+    get_yices_lock(&table->lock);
     sup_tbl = get_sup_table(table);
     r = int_hmap2_find(sup_tbl, tau1, tau2);
     if (r != NULL) {
@@ -2300,6 +2308,7 @@ type_t super_type(type_table_t *table, type_t tau1, type_t tau2) {
 
       int_hmap2_add(sup_tbl, tau1, tau2, aux);
     }
+    release_yices_lock(&table->lock);
   }
 
   assert(aux == NULL_TYPE || good_type(table, aux));
@@ -2442,6 +2451,7 @@ type_t inf_type(type_table_t *table, type_t tau1, type_t tau2) {
     }
     assert(tau1 < tau2);
 
+    get_yices_lock(&table->lock);
     inf_tbl = get_inf_table(table);
     r = int_hmap2_find(inf_tbl, tau1, tau2);
     if (r != NULL) {
@@ -2468,6 +2478,7 @@ type_t inf_type(type_table_t *table, type_t tau1, type_t tau2) {
 
       int_hmap2_add(inf_tbl, tau1, tau2, aux);
     }
+    release_yices_lock(&table->lock);
   }
 
   assert(aux == NULL_TYPE || good_type(table, aux));
@@ -2552,6 +2563,7 @@ type_t max_super_type(type_table_t *table, type_t tau) {
 
   aux = cheap_max_super_type(table, tau);
   if (aux == NULL_TYPE) {
+    get_yices_lock(&table->lock);
     max_tbl = get_max_table(table);
     r = int_hmap_find(max_tbl, tau);
     if (r != NULL) {
@@ -2565,6 +2577,7 @@ type_t max_super_type(type_table_t *table, type_t tau) {
       }
       int_hmap_add(max_tbl, tau, aux);
     }
+    release_yices_lock(&table->lock);
   }
 
   assert(good_type(table, aux));
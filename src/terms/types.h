@@ -70,6 +70,7 @@
 #include "utils/symbol_tables.h"
 #include "utils/tagged_pointers.h"
 #include "utils/tuple_hash_map.h"
+#include "utils/yices_locks.h"
 
 #include "yices_types.h"
 
@@ -300,6 +301,11 @@ typedef struct type_mtbl_s {
  * - max_tbl = map tau to its maximal super type
  *
  * Macro table: also allocated on demand
+ *
+ * In the thread-safe build, lock protects the three caches above.
+ * These are updated lazily by super_type, inf_type, and max_super_type,
+ * which can be called by solvers during search (e.g., by the array
+ * solver) even though the search does not otherwise modify the table.
  */
 typedef struct type_table_s {
   uint8_t *kind;
@@ -321,6 +327,8 @@ typedef struct type_table_s {
   int_hmap_t *max_tbl;
 
   type_mtbl_t *macro_tbl;
+
+  yices_lock_t lock;
 } type_table_t;
 
 
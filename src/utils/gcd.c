@@ -21,74 +21,55 @@
  */
 
 #include <assert.h>
+#include "utils/bit_tricks.h"
 #include "utils/gcd.h"
 
 
+/*
+ * Binary GCD: we use ctz to remove all the trailing zeros at once.
+ */
+
 /*
  * gcd of two 32bit unsigned positive numbers.
  */
 uint32_t gcd32(uint32_t a, uint32_t b) {
-  uint32_t x;
-  uint32_t k;
+  uint32_t k, t;
 
   assert(a>0 && b>0);
 
-  k = 1;
-  x = a | b;
-  while ((x & 1) == 0) {
-    k <<= 1;
-    x >>= 1;
-    a >>= 1;
-    b >>= 1;
-  }
-
+  k = ctz(a | b);
+  a >>= ctz(a);
   do {
-    if ((a & 1) == 0) {
-      a >>= 1;
-    } else if ((b & 1) == 0) {
-      b >>= 1;
-    } else if (a >= b) {
-      a = (a - b) >> 1;
-    } else {
-      b = (b - a) >> 1;
+    // a is odd
+    b >>= ctz(b);
+    if (a > b) {
+      t = a; a = b; b = t;
     }
-  } while (a > 0);
+    b -= a;
+  } while (b > 0);
 
-  return b * k;
+  return a << k;
 }
 
 /*
  * gcd of two 64bit unsigned positive numbers
  */
 uint64_t gcd64(uint64_t a, uint64_t b) {
-  uint64_t x;
-  uint64_t k;
+  uint64_t t;
+  uint32_t k;
 
   assert(a>0 && b>0);
 
-  k = 1;
-  x = a | b;
-  while ((x & 1) == 0) {
-    k <<= 1;
-    x >>= 1;
-    a >>= 1;
-    b >>= 1;
-  }
-
+  k = ctz64(a | b);
+  a >>= ctz64(a);
   do {
-    if ((a & 1) == 0) {
-      a >>= 1;
-    } else if ((b & 1) == 0) {
-      b >>= 1;
-    } else if (a >= b) {
-      a = (a - b) >> 1;
-    } else {
-      b = (b - a) >> 1;
+    // a is odd
+    b >>= ctz64(b);
+    if (a > b) {
+      t = a; a = b; b = t;
     }
-  } while (a > 0);
+    b -= a;
+  } while (b > 0);
 
-  return b * k;
+  return a << k;
 }
-
-
-
@@ -21,6 +21,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include <assert.h>
 
 #include "utils/int_hash_tables.h"
@@ -71,6 +72,23 @@ void init_int_htbl(int_htbl_t *table, uint32_t n) {
 }
 
 
+/*
+ * Initialize table as a copy of src
+ */
+void init_int_htbl_copy(int_htbl_t *table, const int_htbl_t *src) {
+  uint32_t n;
+
+  n = src->size;
+  table->records = (int_hrec_t *) safe_malloc(n * sizeof(int_hrec_t));
+  memcpy(table->records, src->records, n * sizeof(int_hrec_t));
+  table->size = n;
+  table->nelems = src->nelems;
+  table->ndeleted = src->ndeleted;
+  table->resize_threshold = src->resize_threshold;
+  table->cleanup_threshold = src->cleanup_threshold;
+}
+
+
 /*
  * Delete table
  */
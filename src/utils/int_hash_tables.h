@@ -119,6 +119,11 @@ typedef struct int_hobj_s {
  */
 extern void init_int_htbl(int_htbl_t *table, uint32_t n);
 
+/*
+ * Initialize table as a copy of src: same size and same records
+ */
+extern void init_int_htbl_copy(int_htbl_t *table, const int_htbl_t *src);
+
 /*
  * Delete: free the allocated memory
  */
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * LOCKS FOR THE THREAD-SAFE BUILD
+ */
+
+#include "utils/yices_locks.h"
+
+#ifdef THREAD_SAFE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Report a pthread error then abort
+ * - op = name of the operation that failed
+ * - code = error code returned by the pthread function
+ */
+static void __attribute__((noreturn)) lock_failure(const char *op, int code) {
+  fprintf(stderr, "yices: %s failed: %s\n", op, strerror(code));
+  fflush(stderr);
+  abort();
+}
+
+void create_yices_lock(yices_lock_t *lock) {
+  pthread_mutexattr_t attr;
+  int code;
+
+  code = pthread_mutexattr_init(&attr);
+  if (code != 0) {
+    lock_failure("pthread_mutexattr_init", code);
+  }
+  code = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  if (code != 0) {
+    lock_failure("pthread_mutexattr_settype", code);
+  }
+  code = pthread_mutex_init(lock, &attr);
+  if (code != 0) {
+    lock_failure("pthread_mutex_init", code);
+  }
+  pthread_mutexattr_destroy(&attr);
+}
+
+void get_yices_lock(yices_lock_t *lock) {
+  int code;
+
+  code = pthread_mutex_lock(lock);
+  if (code != 0) {
+    lock_failure("pthread_mutex_lock", code);
+  }
+}
+
+void release_yices_lock(yices_lock_t *lock) {
+  int code;
+
+  code = pthread_mutex_unlock(lock);
+  if (code != 0) {
+    lock_failure("pthread_mutex_unlock", code);
+  }
+}
+
+void destroy_yices_lock(yices_lock_t *lock) {
+  int code;
+
+  code = pthread_mutex_destroy(lock);
+  if (code != 0) {
+    lock_failure("pthread_mutex_destroy", code);
+  }
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * LOCKS AND THREAD-LOCAL STORAGE
+ *
+ * This provides a thin wrapper around pthread mutexes. If Yices is
+ * compiled without THREAD_SAFE, the lock type is a dummy and all
+ * operations do nothing.
+ *
+ * - create_yices_lock(lock): initialize a lock
+ * - get_yices_lock(lock): acquire the lock (blocking)
+ * - release_yices_lock(lock): release the lock
+ * - destroy_yices_lock(lock): delete the lock
+ *
+ * Locks are recursive: a thread that holds a lock can acquire it
+ * again, and must then release it as many times.
+ *
+ * YICES_THREAD_LOCAL can be used to declare per-thread global variables.
+ *
+ * Errors reported by the pthread library are considered fatal:
+ * they cause an error message to be printed on stderr, then
+ * the process is killed via abort().
+ */
+
+#ifndef __YICES_LOCKS_H
+#define __YICES_LOCKS_H
+
+#ifdef THREAD_SAFE
+
+#include <pthread.h>
+
+typedef pthread_mutex_t yices_lock_t;
+
+#define YICES_THREAD_LOCAL __thread
+
+extern void create_yices_lock(yices_lock_t *lock);
+extern void get_yices_lock(yices_lock_t *lock);
+extern void release_yices_lock(yices_lock_t *lock);
+extern void destroy_yices_lock(yices_lock_t *lock);
+
+#else
+
+typedef int yices_lock_t;
+
+#define YICES_THREAD_LOCAL
+
+static inline void create_yices_lock(yices_lock_t *lock) {}
+static inline void get_yices_lock(yices_lock_t *lock) {}
+static inline void release_yices_lock(yices_lock_t *lock) {}
+static inline void destroy_yices_lock(yices_lock_t *lock) {}
+
+#endif
+
+#endif /* __YICES_LOCKS_H */
@@ -124,6 +124,7 @@ static const char* const solver_code2string[NUM_SOLVER_CODES] = {
   "simplex",
   "ifw",
   "rfw",
+  "sparse-idl",
 };
 
 
@@ -366,6 +367,7 @@ static void test_set_configs(ctx_config_t *config) {
   test_set_config(config, "arith-solver", "simplex", 0, 0);
   test_set_config(config, "arith-solver", "ifw", 0, 0);
   test_set_config(config, "arith-solver", "rfw", 0, 0);
+  test_set_config(config, "arith-solver", "sparse-idl", 0, 0);
   test_set_config(config, "arith-solver", "xxxx", -1, CTX_INVALID_PARAMETER_VALUE);
 
   // yices_set_config is not intended to be used for setting the logic
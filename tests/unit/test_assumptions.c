@@ -0,0 +1,245 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST CHECK WITH ASSUMPTIONS
+ *
+ * Random formulas are checked under random assumptions. The result
+ * is compared with push/assert/check/pop on a second context:
+ * - if the result is sat, the model must satisfy the formula and the assumptions
+ * - if the result is unsat, the unsat core must be a subset of the
+ *   assumptions and the formula conjoined with the core must be unsat.
+ * More formulas are asserted between checks.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+#define NBOOLS 30
+#define NINTS 6
+#define NCLAUSES 100
+#define NASSUMPTIONS 12
+#define NCHECKS 40
+
+static term_t bvar[NBOOLS];
+static term_t ivar[NINTS];
+
+
+/*
+ * Random atom: boolean variable or (if arith is true) an integer
+ * constraint (x <= c) or (x - y <= c)
+ */
+static term_t random_atom(bool arith) {
+  term_t x, y;
+  int32_t c;
+
+  if (arith && (random() % 3) == 0) {
+    x = ivar[random() % NINTS];
+    c = (int32_t) (random() % 11) - 5;
+    if (random() & 1) {
+      y = ivar[random() % NINTS];
+      x = yices_sub(x, y);
+    }
+    return yices_arith_leq_atom(x, yices_int32(c));
+  }
+
+  return bvar[random() % NBOOLS];
+}
+
+static term_t random_literal(bool arith) {
+  term_t x;
+
+  x = random_atom(arith);
+  return (random() & 1) ? x : yices_not(x);
+}
+
+static term_t random_formula(uint32_t n, bool arith) {
+  term_t *a;
+  term_t f;
+  uint32_t i;
+
+  a = (term_t *) malloc(n * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    a[i] = yices_or3(random_literal(arith), random_literal(arith), random_literal(arith));
+  }
+  f = yices_and(n, a);
+  free(a);
+
+  return f;
+}
+
+
+/*
+ * Create a context for the given logic and mode
+ */
+static context_t *new_context(const char *logic, const char *mode) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, logic) == 0);
+  assert(yices_set_config(config, "mode", mode) == 0);
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+
+  return ctx;
+}
+
+
+/*
+ * Check whether t is in a[0 ... n-1]
+ */
+static bool in_array(term_t t, uint32_t n, const term_t *a) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (a[i] == t) return true;
+  }
+  return false;
+}
+
+
+/*
+ * Reference result: push, assert a[0 ... n-1], check, pop
+ */
+static smt_status_t check_with_push(context_t *ctx, uint32_t n, const term_t *a) {
+  smt_status_t stat;
+
+  assert(yices_push(ctx) == 0);
+  assert(yices_assert_formulas(ctx, n, a) == 0);
+  stat = yices_check_context(ctx, NULL);
+  assert(yices_pop(ctx) == 0);
+
+  return stat;
+}
+
+
+/*
+ * One round: ctx1 (multi-checks) and ctx2 (push-pop) contain f
+ */
+static void check_assumptions(context_t *ctx1, context_t *ctx2, term_t f, bool arith) {
+  term_t a[NASSUMPTIONS];
+  term_vector_t core;
+  model_t *mdl;
+  smt_status_t s1, s2;
+  uint32_t i, n;
+
+  n = random() % (NASSUMPTIONS + 1);
+  for (i=0; i<n; i++) {
+    a[i] = random_literal(arith);
+  }
+
+  s1 = yices_check_context_with_assumptions(ctx1, NULL, n, a);
+  s2 = check_with_push(ctx2, n, a);
+  assert(s1 == STATUS_SAT || s1 == STATUS_UNSAT);
+  assert(s1 == s2);
+
+  if (s1 == STATUS_SAT) {
+    mdl = yices_get_model(ctx1, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    for (i=0; i<n; i++) {
+      assert(yices_formula_true_in_model(mdl, a[i]) == 1);
+    }
+    yices_free_model(mdl);
+  } else {
+    yices_init_term_vector(&core);
+    assert(yices_get_unsat_core(ctx1, &core) == 0);
+    for (i=0; i<core.size; i++) {
+      assert(in_array(core.data[i], n, a));
+    }
+    assert(check_with_push(ctx2, core.size, core.data) == STATUS_UNSAT);
+    yices_delete_term_vector(&core);
+  }
+}
+
+
+static void test_logic(const char *logic, bool arith) {
+  context_t *ctx1, *ctx2;
+  term_t f, g;
+  uint32_t i;
+
+  ctx1 = new_context(logic, "multi-checks");
+  ctx2 = new_context(logic, "push-pop");
+
+  f = yices_true();
+  for (i=0; i<NCHECKS; i++) {
+    if (i % 10 == 0) {
+      // more assertions
+      g = random_formula(NCLAUSES/4, arith);
+      f = yices_and2(f, g);
+      assert(yices_assert_formula(ctx1, g) == 0);
+      assert(yices_assert_formula(ctx2, g) == 0);
+    }
+    check_assumptions(ctx1, ctx2, f, arith);
+    if (yices_context_status(ctx1) == STATUS_UNSAT &&
+        yices_check_context(ctx1, NULL) == STATUS_UNSAT) {
+      // f itself is unsat
+      assert(yices_check_context(ctx2, NULL) == STATUS_UNSAT);
+      break;
+    }
+  }
+
+  yices_free_context(ctx1);
+  yices_free_context(ctx2);
+}
+
+
+int main(void) {
+  uint32_t i;
+
+  yices_init();
+
+  for (i=0; i<NBOOLS; i++) {
+    bvar[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+  for (i=0; i<NINTS; i++) {
+    ivar[i] = yices_new_uninterpreted_term(yices_int_type());
+  }
+
+  srandom(2024);
+  for (i=0; i<10; i++) {
+    test_logic("NONE", false);
+    test_logic("QF_UF", false);
+    test_logic("QF_LIA", true);
+  }
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,332 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST TWO-LEVEL REWRITING IN THE BIT-BLASTER
+ *
+ * - check the rewrite rules on small examples
+ * - build random networks of binary OR/AND/XOR gates and check by
+ *   propagation in the core that every output has the expected truth table
+ * - check that definitions are removed on pop
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "solvers/bv/bit_blaster.h"
+#include "solvers/cdcl/smt_core.h"
+
+
+#ifdef MINGW
+
+/*
+ * Need some version of random()
+ * rand() exists on mingw
+ */
+static inline long int random(void) {
+  return rand();
+}
+
+#endif
+
+
+
+/*
+ * Descriptors for the null theory
+ */
+static void do_nothing(void *t) {
+}
+
+static void null_backtrack(void *t, uint32_t back_level) {
+}
+
+static bool null_propagate(void *t) {
+  return true;
+}
+
+static fcheck_code_t null_final_check(void *t) {
+  return FCHECK_SAT;
+}
+
+static th_ctrl_interface_t null_theory_ctrl = {
+  do_nothing,       // start_internalization
+  do_nothing,       // start_search
+  null_propagate,   // propagate
+  null_final_check, // final_check
+  do_nothing,       // increase_dlevel
+  null_backtrack,   // backtrack
+  do_nothing,       // push
+  do_nothing,       // pop
+  do_nothing,       // reset
+  do_nothing,       // clear
+};
+
+static th_smt_interface_t null_theory_smt = {
+  NULL,            // assert_atom
+  NULL,            // expand explanation
+  NULL,            // select polarity
+  NULL,            // delete_atom
+  NULL,            // end_deletion
+};
+
+
+
+/*
+ * Global variables
+ */
+static smt_core_t solver;
+static remap_table_t remap;
+static bit_blaster_t blaster;
+
+static void init(smt_mode_t mode) {
+  init_smt_core(&solver, 0, NULL, &null_theory_ctrl, &null_theory_smt, mode);
+  init_remap_table(&remap);
+  init_bit_blaster(&blaster, &solver, &remap);
+}
+
+static void cleanup(void) {
+  delete_bit_blaster(&blaster);
+  delete_remap_table(&remap);
+  delete_smt_core(&solver);
+}
+
+static literal_t fresh_lit(void) {
+  return bit_blaster_fresh_literal(&blaster);
+}
+
+
+
+/*
+ * Rewrite rules on small examples
+ */
+static void test_rules(void) {
+  literal_t a, b, c, x, y, z;
+
+  init(SMT_MODE_BASIC);
+
+  a = fresh_lit();
+  b = fresh_lit();
+  c = fresh_lit();
+
+  // (or a b) absorbs a and is true with (not a)
+  x = bit_blaster_make_or2(&blaster, a, b);
+  assert(bit_blaster_make_or2(&blaster, x, a) == x);
+  assert(bit_blaster_make_or2(&blaster, b, x) == x);
+  assert(bit_blaster_make_or2(&blaster, x, not(b)) == true_literal);
+
+  // (or a (and a c)) --> a
+  y = bit_blaster_make_and2(&blaster, a, c);
+  assert(bit_blaster_make_or2(&blaster, a, y) == a);
+  assert(bit_blaster_make_and2(&blaster, not(y), a) == bit_blaster_make_and2(&blaster, a, not(c)));
+
+  // (or a (and (not a) c)) --> (or a c)
+  z = bit_blaster_make_and2(&blaster, not(a), c);
+  assert(bit_blaster_make_or2(&blaster, a, z) == bit_blaster_make_or2(&blaster, a, c));
+
+  // (or (and a c) (and (not a) c)) --> c
+  assert(bit_blaster_make_or2(&blaster, y, z) == c);
+  assert(bit_blaster_make_or2(&blaster, z, y) == c);
+
+  // xor
+  x = bit_blaster_make_xor2(&blaster, a, b);
+  assert(bit_blaster_make_xor2(&blaster, x, a) == b);
+  assert(bit_blaster_make_xor2(&blaster, not(b), x) == not(a));
+  y = bit_blaster_make_xor2(&blaster, not(a), c);
+  assert(bit_blaster_make_xor2(&blaster, x, y) == not(bit_blaster_make_xor2(&blaster, b, c)));
+
+  cleanup();
+
+  printf("rewrite rules: ok\n");
+}
+
+
+
+/*
+ * RANDOM NETWORKS
+ *
+ * - pool of literals on NINPUTS inputs
+ * - table[i] = truth table of pool[i]: bit k is the value of
+ *   pool[i] when input j is (k >> j) & 1
+ */
+#define NINPUTS 5
+#define NASSIGNMENTS (1u << NINPUTS)
+#define POOL_SIZE 400
+
+static literal_t pool[POOL_SIZE];
+static uint32_t table[POOL_SIZE];
+static uint32_t pool_size;
+
+static void add_to_pool(literal_t l, uint32_t tt) {
+  assert(pool_size < POOL_SIZE);
+  pool[pool_size] = l;
+  table[pool_size] = tt;
+  pool_size ++;
+}
+
+/*
+ * Random element of the pool, possibly negated
+ */
+static void random_operand(literal_t *l, uint32_t *tt) {
+  uint32_t i;
+
+  // prefer recent elements
+  i = random() % pool_size;
+  if (random() % 2 == 0 && pool_size > 10) {
+    i = pool_size - 1 - random() % 10;
+  }
+  *l = pool[i];
+  *tt = table[i];
+  if (random() % 2 == 0) {
+    *l = not(*l);
+    *tt = ~(*tt);
+  }
+}
+
+static void build_random_network(void) {
+  literal_t a, b, l;
+  uint32_t i, k, ta, tb, tt;
+
+  pool_size = 0;
+  for (i=0; i<NINPUTS; i++) {
+    tt = 0;
+    for (k=0; k<NASSIGNMENTS; k++) {
+      if ((k >> i) & 1) tt |= (1u << k);
+    }
+    add_to_pool(fresh_lit(), tt);
+  }
+
+  while (pool_size < POOL_SIZE) {
+    random_operand(&a, &ta);
+    random_operand(&b, &tb);
+    switch (random() % 3) {
+    case 0:
+      l = bit_blaster_make_or2(&blaster, a, b);
+      tt = ta | tb;
+      break;
+    case 1:
+      l = bit_blaster_make_and2(&blaster, a, b);
+      tt = ta & tb;
+      break;
+    default:
+      l = bit_blaster_make_xor2(&blaster, a, b);
+      tt = ta ^ tb;
+      break;
+    }
+    add_to_pool(l, tt);
+  }
+}
+
+
+/*
+ * Check all truth tables: assign the inputs then propagate
+ */
+static void check_network(void) {
+  uint32_t i, k;
+  bool expected;
+
+  start_search(&solver);
+  for (k=0; k<NASSIGNMENTS; k++) {
+    for (i=0; i<NINPUTS; i++) {
+      decide_literal(&solver, ((k >> i) & 1) ? pool[i] : not(pool[i]));
+      smt_process(&solver);
+      assert(smt_status(&solver) == STATUS_SEARCHING);
+    }
+    for (i=0; i<pool_size; i++) {
+      expected = (table[i] >> k) & 1;
+      if (expected) {
+        assert(literal_value(&solver, pool[i]) == VAL_TRUE);
+      } else {
+        assert(literal_value(&solver, pool[i]) == VAL_FALSE);
+      }
+    }
+    smt_restart(&solver);
+  }
+}
+
+static void test_random_networks(uint32_t n) {
+  uint32_t i, nvars, total_vars;
+
+  total_vars = 0;
+  for (i=0; i<n; i++) {
+    init(SMT_MODE_BASIC);
+    build_random_network();
+    nvars = num_vars(&solver);
+    total_vars += nvars;
+    check_network();
+    cleanup();
+  }
+
+  printf("random networks: %"PRIu32" networks, %"PRIu32" gates, %"PRIu32" variables on average\n",
+         n, POOL_SIZE - NINPUTS, total_vars/n);
+}
+
+
+
+/*
+ * Definitions must be removed on pop
+ */
+static void test_push_pop(void) {
+  literal_t a, b, x, y;
+
+  init(SMT_MODE_PUSHPOP);
+
+  a = fresh_lit();
+  b = fresh_lit();
+
+  smt_push(&solver);
+  bit_blaster_push(&blaster);
+  x = bit_blaster_make_or2(&blaster, a, b);
+  assert(bit_blaster_make_or2(&blaster, x, a) == x);
+  bit_blaster_pop(&blaster);
+  smt_pop(&solver);
+
+  // y is likely to reuse x's variable
+  y = fresh_lit();
+  x = bit_blaster_make_or2(&blaster, y, a);
+  assert(x != y && x != a && x != true_literal);
+  assert(bit_blaster_make_or2(&blaster, x, a) == x);
+  assert(bit_blaster_make_or2(&blaster, x, b) != x);
+
+  cleanup();
+
+  printf("push/pop: ok\n");
+}
+
+
+int main(void) {
+  srandom(1234);
+
+  test_rules();
+  test_random_networks(200);
+  test_push_pop();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
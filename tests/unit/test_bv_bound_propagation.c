@@ -0,0 +1,236 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST WORD-LEVEL BOUND PROPAGATION IN THE BITVECTOR SOLVER
+ *
+ * Random problems made of bound atoms on a few small variables and
+ * on sums and bitwise ands of these variables. They are solved in
+ * a one-shot context and incrementally (push/pop). The results are
+ * compared with exhaustive enumeration and all models are checked.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "context/context.h"
+#include "solvers/bv/bvsolver.h"
+#include "yices.h"
+
+
+#define NBITS 4
+#define NVARS 3
+#define NTERMS 6
+#define NCLAUSES 12
+#define NPROBLEMS 150
+
+static term_t var[NVARS];
+static term_t term[NTERMS];
+
+
+/*
+ * Terms: the variables, two sums, and a bitwise and
+ */
+static void init_terms(void) {
+  uint32_t i;
+
+  for (i=0; i<NVARS; i++) {
+    var[i] = yices_new_uninterpreted_term(yices_bv_type(NBITS));
+    term[i] = var[i];
+  }
+  term[3] = yices_bvadd(var[0], var[1]);
+  term[4] = yices_bvadd(var[1], yices_bvconst_uint32(NBITS, 3));
+  term[5] = yices_bvand2(var[1], var[2]);
+}
+
+
+/*
+ * Random bound atom: (t >= c), (t <= c), (t < c), (t > c), or (t = c)
+ */
+static term_t random_atom(void) {
+  term_t t, c;
+
+  t = term[random() % NTERMS];
+  c = yices_bvconst_uint32(NBITS, (uint32_t) random());
+
+  switch (random() % 5) {
+  case 0:
+    return yices_bvge_atom(t, c);
+  case 1:
+    return yices_bvle_atom(t, c);
+  case 2:
+    return yices_bvlt_atom(t, c);
+  case 3:
+    return yices_bvgt_atom(t, c);
+  default:
+    return yices_eq(t, c);
+  }
+}
+
+static term_t random_literal(void) {
+  term_t a;
+
+  a = random_atom();
+  return (random() % 3 == 0) ? yices_not(a) : a;
+}
+
+static term_t random_formula(void) {
+  term_t a[NCLAUSES];
+  uint32_t i;
+
+  for (i=0; i<NCLAUSES; i++) {
+    switch (random() % 4) {
+    case 0:
+      a[i] = random_literal();
+      break;
+    case 1:
+      a[i] = yices_or2(random_literal(), random_literal());
+      break;
+    default:
+      a[i] = yices_or3(random_literal(), random_literal(), random_literal());
+      break;
+    }
+  }
+
+  return yices_and(NCLAUSES, a);
+}
+
+
+/*
+ * Check whether f is satisfiable by enumerating all assignments
+ */
+static bool brute_force_sat(term_t f) {
+  term_t val[NVARS];
+  model_t *mdl;
+  uint32_t k, i;
+  bool sat;
+
+  sat = false;
+  for (k=0; k < (1u << (NBITS * NVARS)) && !sat; k++) {
+    for (i=0; i<NVARS; i++) {
+      val[i] = yices_bvconst_uint32(NBITS, k >> (NBITS * i));
+    }
+    mdl = yices_model_from_map(NVARS, var, val);
+    assert(mdl != NULL);
+    sat = (yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return sat;
+}
+
+
+/*
+ * Check ctx and verify the model if it's sat
+ */
+static smt_status_t check(context_t *ctx, term_t f) {
+  smt_status_t stat;
+  model_t *mdl;
+
+  stat = yices_check_context(ctx, NULL);
+  assert(stat == STATUS_SAT || stat == STATUS_UNSAT);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return stat;
+}
+
+
+/*
+ * Solve random problems:
+ * - in a fresh one-shot context
+ * - in an incremental context after a push
+ */
+static void test_random_problems(void) {
+  ctx_config_t *config;
+  context_t *ctx, *inc;
+  term_t f;
+  smt_status_t s[2];
+  uint32_t i, nsat, nunsat, props, conflicts;
+  bool sat;
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, "QF_BV") == 0);
+  inc = yices_new_context(config);
+  assert(inc != NULL);
+
+  nsat = 0;
+  nunsat = 0;
+  props = 0;
+  conflicts = 0;
+  for (i=0; i<NPROBLEMS; i++) {
+    f = random_formula();
+    sat = brute_force_sat(f);
+
+    ctx = yices_new_context(config);
+    assert(ctx != NULL);
+    assert(yices_assert_formula(ctx, f) == 0);
+    s[0] = check(ctx, f);
+    props += bv_solver_bound_props(ctx->bv_solver);
+    conflicts += bv_solver_bound_conflicts(ctx->bv_solver);
+    yices_free_context(ctx);
+
+    assert(yices_push(inc) == 0);
+    assert(yices_assert_formula(inc, f) == 0);
+    s[1] = check(inc, f);
+    assert(yices_pop(inc) == 0);
+
+    assert(s[0] == s[1]);
+    assert(s[0] == (sat ? STATUS_SAT : STATUS_UNSAT));
+    if (sat) nsat ++; else nunsat ++;
+  }
+
+  props += bv_solver_bound_props(inc->bv_solver);
+  conflicts += bv_solver_bound_conflicts(inc->bv_solver);
+  assert(props > 0);
+
+  printf("%"PRIu32" problems: %"PRIu32" sat, %"PRIu32" unsat, %"PRIu32" bound propagations, %"PRIu32" bound conflicts\n",
+         NPROBLEMS, nsat, nunsat, props, conflicts);
+
+  yices_free_context(inc);
+  yices_free_config(config);
+}
+
+
+int main(void) {
+  yices_init();
+
+  srandom(4242);
+  init_terms();
+  test_random_problems();
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
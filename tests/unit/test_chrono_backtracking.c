@@ -0,0 +1,227 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST CHRONOLOGICAL BACKTRACKING
+ *
+ * Random 3-SAT and linear arithmetic problems are solved in push-pop
+ * mode with chronological backtracking (threshold 0: after every
+ * conflict, and a small threshold) and with normal backjumping.
+ * The results must agree and all models are checked.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "context/context_types.h"
+#include "yices.h"
+
+
+#define NBOOLS 80
+#define NCLAUSES 320
+#define NEXTRA 30
+#define NINTS 8
+#define NROUNDS 6
+
+static term_t bvar[NBOOLS];
+static term_t ivar[NINTS];
+
+static term_t random_literal(void) {
+  term_t x;
+
+  x = bvar[random() % NBOOLS];
+  return (random() & 1) ? x : yices_not(x);
+}
+
+/*
+ * Random arithmetic atom: (x + k * y) <= c or (x + k * y) = c
+ */
+static term_t random_arith_atom(void) {
+  term_t x, y, t, c;
+
+  x = ivar[random() % NINTS];
+  y = ivar[random() % NINTS];
+  t = yices_add(x, yices_mul(yices_int32((int32_t) (random() % 7) - 3), y));
+  c = yices_int32((int32_t) (random() % 21) - 10);
+
+  return (random() % 4 == 0) ? yices_arith_eq_atom(t, c) : yices_arith_leq_atom(t, c);
+}
+
+static term_t random_formula(uint32_t n, bool arith) {
+  term_t *a;
+  term_t f, l;
+  uint32_t i;
+
+  a = (term_t *) malloc(n * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    if (arith) {
+      l = random_arith_atom();
+      if (random() & 1) l = yices_not(l);
+      a[i] = yices_or3(l, random_arith_atom(), random_literal());
+    } else {
+      a[i] = yices_or3(random_literal(), random_literal(), random_literal());
+    }
+  }
+  f = yices_and(n, a);
+  free(a);
+
+  return f;
+}
+
+static context_t *new_context(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, "QF_LIA") == 0);
+  assert(yices_set_config(config, "mode", "push-pop") == 0);
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+
+  return ctx;
+}
+
+/*
+ * Check ctx and verify the model if it's sat
+ */
+static smt_status_t check(context_t *ctx, param_t *params, term_t f) {
+  smt_status_t stat;
+  model_t *mdl;
+
+  stat = yices_check_context(ctx, params);
+  assert(stat == STATUS_SAT || stat == STATUS_UNSAT);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return stat;
+}
+
+
+/*
+ * ctx[0] uses backjumping, ctx[1] always backtracks chronologically,
+ * ctx[2] uses a small threshold
+ */
+static void test_formulas(bool arith) {
+  context_t *ctx[3];
+  param_t *params[3];
+  term_t f, g;
+  smt_status_t s[3];
+  uint32_t i, j, nsat, nunsat;
+
+  for (j=0; j<3; j++) {
+    ctx[j] = new_context();
+    params[j] = yices_new_param_record();
+    yices_default_params_for_context(ctx[j], params[j]);
+  }
+  assert(yices_set_param(params[0], "chrono-backtracking", "false") == 0);
+  assert(yices_set_param(params[1], "chrono-backtracking", "true") == 0);
+  assert(yices_set_param(params[1], "chrono-threshold", "0") == 0);
+  assert(yices_set_param(params[2], "chrono-backtracking", "true") == 0);
+  assert(yices_set_param(params[2], "chrono-threshold", "3") == 0);
+
+  nsat = 0;
+  nunsat = 0;
+
+  f = random_formula(NCLAUSES, arith);
+  for (j=0; j<3; j++) {
+    assert(yices_assert_formula(ctx[j], f) == 0);
+  }
+
+  for (i=0; i<NROUNDS; i++) {
+    g = random_formula(NEXTRA, arith);
+    for (j=0; j<3; j++) {
+      assert(yices_push(ctx[j]) == 0);
+      assert(yices_assert_formula(ctx[j], g) == 0);
+    }
+
+    for (j=0; j<3; j++) {
+      s[j] = check(ctx[j], params[j], yices_and2(f, g));
+    }
+    assert(s[0] == s[1] && s[0] == s[2]);
+    if (s[0] == STATUS_SAT) nsat ++; else nunsat ++;
+
+    for (j=0; j<3; j++) {
+      assert(yices_pop(ctx[j]) == 0);
+    }
+
+    for (j=0; j<3; j++) {
+      s[j] = check(ctx[j], params[j], f);
+    }
+    assert(s[0] == s[1] && s[0] == s[2]);
+    if (s[0] == STATUS_UNSAT) break; // can't push anymore
+  }
+
+  printf("%s: %"PRIu32" sat, %"PRIu32" unsat, %"PRIu32" chrono backtracks\n",
+         arith ? "arithmetic" : "3-sat", nsat, nunsat, ctx[1]->core->stats.chrono_backtracks);
+  assert(ctx[0]->core->stats.chrono_backtracks == 0);
+
+  for (j=0; j<3; j++) {
+    yices_free_context(ctx[j]);
+    yices_free_param_record(params[j]);
+  }
+}
+
+
+int main(void) {
+  param_t *params;
+  uint32_t i;
+
+  yices_init();
+
+  for (i=0; i<NBOOLS; i++) {
+    bvar[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+  for (i=0; i<NINTS; i++) {
+    ivar[i] = yices_new_uninterpreted_term(yices_int_type());
+  }
+
+  params = yices_new_param_record();
+  assert(yices_set_param(params, "chrono-threshold", "-1") < 0);
+  yices_free_param_record(params);
+
+  srandom(1717);
+  for (i=0; i<3; i++) {
+    test_formulas(false);
+    test_formulas(true);
+  }
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
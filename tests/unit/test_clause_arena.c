@@ -0,0 +1,179 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST COMPACTION OF THE CLAUSE ARENA
+ *
+ * Random 3-SAT problems are solved in push-pop mode with aggressive
+ * clause deletion (so that the arena is compacted often). The results
+ * are compared with a context where clause deletion never happens.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "context/context_types.h"
+#include "yices.h"
+
+
+#define NVARS 120
+#define NCLAUSES 480
+#define NEXTRA 40
+#define NROUNDS 8
+
+static term_t var[NVARS];
+
+static term_t random_literal(void) {
+  term_t x;
+
+  x = var[random() % NVARS];
+  return (random() & 1) ? x : yices_not(x);
+}
+
+static term_t random_formula(uint32_t n) {
+  term_t *a;
+  term_t f;
+  uint32_t i;
+
+  a = (term_t *) malloc(n * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    a[i] = yices_or3(random_literal(), random_literal(), random_literal());
+  }
+  f = yices_and(n, a);
+  free(a);
+
+  return f;
+}
+
+static context_t *new_context(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  assert(yices_set_config(config, "mode", "push-pop") == 0);
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+
+  return ctx;
+}
+
+/*
+ * Check ctx and verify the model if it's sat
+ */
+static smt_status_t check(context_t *ctx, param_t *params, term_t f) {
+  smt_status_t stat;
+  model_t *mdl;
+
+  stat = yices_check_context(ctx, params);
+  assert(stat == STATUS_SAT || stat == STATUS_UNSAT);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return stat;
+}
+
+int main(void) {
+  context_t *ctx1, *ctx2;
+  param_t *gc_params, *nogc_params;
+  term_t f, g;
+  smt_status_t s1, s2;
+  uint32_t i, nsat, nunsat;
+
+  yices_init();
+
+  for (i=0; i<NVARS; i++) {
+    var[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+
+  ctx1 = new_context();
+  ctx2 = new_context();
+
+  gc_params = yices_new_param_record();
+  yices_default_params_for_context(ctx1, gc_params);
+  assert(yices_set_param(gc_params, "r-threshold", "50") == 0);
+  assert(yices_set_param(gc_params, "r-fraction", "0") == 0);
+  assert(yices_set_param(gc_params, "r-factor", "1.0") == 0);
+
+  nogc_params = yices_new_param_record();
+  yices_default_params_for_context(ctx2, nogc_params);
+  assert(yices_set_param(nogc_params, "r-threshold", "100000000") == 0);
+
+  srandom(4321);
+  nsat = 0;
+  nunsat = 0;
+
+  f = random_formula(NCLAUSES);
+  assert(yices_assert_formula(ctx1, f) == 0);
+  assert(yices_assert_formula(ctx2, f) == 0);
+
+  for (i=0; i<NROUNDS; i++) {
+    g = random_formula(NEXTRA);
+    assert(yices_push(ctx1) == 0);
+    assert(yices_push(ctx2) == 0);
+    assert(yices_assert_formula(ctx1, g) == 0);
+    assert(yices_assert_formula(ctx2, g) == 0);
+
+    s1 = check(ctx1, gc_params, yices_and2(f, g));
+    s2 = check(ctx2, nogc_params, yices_and2(f, g));
+    assert(s1 == s2);
+    if (s1 == STATUS_SAT) nsat ++; else nunsat ++;
+
+    assert(yices_pop(ctx1) == 0);
+    assert(yices_pop(ctx2) == 0);
+
+    // check again after pop: learned clauses were removed
+    s1 = check(ctx1, gc_params, f);
+    s2 = check(ctx2, nogc_params, f);
+    assert(s1 == s2);
+  }
+
+  printf("%"PRIu32" sat, %"PRIu32" unsat, %"PRIu32" compactions\n",
+         nsat, nunsat, ctx1->core->stats.arena_compactions);
+  assert(ctx1->core->stats.arena_compactions > 0);
+  assert(ctx2->core->stats.arena_compactions == 0);
+
+  yices_free_context(ctx1);
+  yices_free_context(ctx2);
+  yices_free_param_record(gc_params);
+  yices_free_param_record(nogc_params);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
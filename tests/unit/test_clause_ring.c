@@ -0,0 +1,160 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Test of the clause ring
+ */
+
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <assert.h>
+
+#include "solvers/cdcl/clause_ring.h"
+
+
+/*
+ * Check that c is equal to a[0 ... n-1]
+ */
+static bool same_clause(shared_clause_t *c, uint32_t n, const literal_t *a) {
+  uint32_t i;
+
+  if (c->len != n) return false;
+  for (i=0; i<n; i++) {
+    if (c->lit[i] != a[i]) return false;
+  }
+  return true;
+}
+
+
+/*
+ * Filters: nvars = 10, max length = 3, max glue = 2
+ */
+static void test_filters(void) {
+  clause_ring_t ring;
+  literal_t a[4];
+
+  init_clause_ring(&ring, 16, 10, 3, 2);
+  assert(ring.size == 16);
+
+  a[0] = pos_lit(1);
+  a[1] = neg_lit(2);
+  a[2] = pos_lit(9);
+  a[3] = neg_lit(3);
+  assert(clause_ring_accepts(&ring, 1, a, 1));
+  assert(clause_ring_accepts(&ring, 3, a, 2));
+  assert(!clause_ring_accepts(&ring, 3, a, 3));  // glue too large
+  assert(!clause_ring_accepts(&ring, 4, a, 2));  // too long
+
+  a[2] = pos_lit(10);
+  assert(!clause_ring_accepts(&ring, 3, a, 2));  // variable out of range
+
+  delete_clause_ring(&ring);
+  printf("filters: ok\n");
+}
+
+
+/*
+ * Two readers, two writers
+ */
+static void test_exchange(void) {
+  clause_ring_t ring;
+  shared_clause_t c;
+  uint64_t cursor0, cursor1;
+  literal_t a[3], b[2];
+
+  init_clause_ring(&ring, 10, 100, 8, 8);
+  assert(ring.size == 16);
+
+  cursor0 = clause_ring_head(&ring);
+  cursor1 = clause_ring_head(&ring);
+
+  a[0] = pos_lit(3);
+  a[1] = neg_lit(4);
+  a[2] = pos_lit(5);
+  b[0] = neg_lit(7);
+  b[1] = neg_lit(8);
+
+  assert(clause_ring_export(&ring, 0, 3, a, 2));
+  assert(clause_ring_export(&ring, 1, 2, b, 1));
+
+  // reader 0 sees only b
+  assert(clause_ring_import(&ring, &cursor0, 0, &c));
+  assert(same_clause(&c, 2, b) && c.glue == 1);
+  assert(!clause_ring_import(&ring, &cursor0, 0, &c));
+
+  // reader 1 sees only a
+  assert(clause_ring_import(&ring, &cursor1, 1, &c));
+  assert(same_clause(&c, 3, a) && c.glue == 2);
+  assert(!clause_ring_import(&ring, &cursor1, 1, &c));
+
+  // nothing new
+  assert(!clause_ring_import(&ring, &cursor0, 0, &c));
+  assert(cursor0 == 2 && cursor1 == 2);
+
+  delete_clause_ring(&ring);
+  printf("exchange: ok\n");
+}
+
+
+/*
+ * A slow reader: more than one lap behind
+ */
+static void test_overflow(void) {
+  clause_ring_t ring;
+  shared_clause_t c;
+  uint64_t cursor;
+  literal_t a[1];
+  uint32_t i, n;
+
+  init_clause_ring(&ring, 8, 100, 8, 8);
+  cursor = clause_ring_head(&ring);
+
+  for (i=0; i<20; i++) {
+    a[0] = pos_lit(i);
+    assert(clause_ring_export(&ring, 0, 1, a, 1));
+  }
+
+  // only the last 8 clauses are available
+  n = 0;
+  while (clause_ring_import(&ring, &cursor, 1, &c)) {
+    assert(c.len == 1 && c.lit[0] == pos_lit(12 + n));
+    n ++;
+  }
+  assert(n == 8 && cursor == 20);
+
+  delete_clause_ring(&ring);
+  printf("overflow: ok\n");
+}
+
+
+int main(void) {
+  test_filters();
+  test_exchange();
+  test_overflow();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
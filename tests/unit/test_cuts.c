@@ -0,0 +1,615 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE CUTTING PLANES
+ *
+ * 1) Validity of Gomory and MIR cuts: the cuts are built from random
+ *    constraints and checked on all the integer points of a small box.
+ *
+ * 2) Random integer problems are solved with and without cuts. The
+ *    results must agree and all models are checked.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "context/context.h"
+#include "solvers/simplex/gomory_cuts.h"
+#include "solvers/simplex/simplex.h"
+#include "terms/poly_buffer.h"
+#include "terms/rationals.h"
+#include "utils/cputime.h"
+#include "yices.h"
+
+
+/*
+ * PART 1: VALIDITY OF THE CUTS
+ */
+
+/*
+ * Random problem: n variables x_1 ... x_n
+ * - x_1 ... x_{n-1} are integer and x_n is not integer
+ * - lo[i] <= x_i <= hi[i]
+ * - a[i] = coefficient of x_i in the constraint
+ * - val[i] = value of x_i (0 is for const_idx)
+ */
+#define MAX_VARS 6
+
+static uint32_t nvars;
+static rational_t lo[MAX_VARS+1];
+static rational_t hi[MAX_VARS+1];
+static rational_t a[MAX_VARS+1];
+static rational_t val[MAX_VARS+1];
+
+static uint32_t num_cuts;
+static uint32_t num_checks;
+
+
+static void random_rational(rational_t *q, int32_t num, uint32_t den) {
+  int32_t n;
+  uint32_t d;
+
+  n = (int32_t) (random() % (2 * num + 1)) - num;
+  d = 1 + random() % den;
+  q_set_int32(q, n, d);
+}
+
+static void random_problem(void) {
+  uint32_t i;
+  int32_t l;
+
+  nvars = 3 + random() % (MAX_VARS - 2);
+  for (i=1; i<=nvars; i++) {
+    do {
+      random_rational(a + i, 10, 4);
+    } while (q_is_zero(a + i));
+
+    if (i < nvars) {
+      l = (int32_t) (random() % 11) - 5;
+      q_set32(lo + i, l);
+      q_set32(hi + i, l + 1 + random() % 3);
+    } else {
+      random_rational(lo + i, 20, 3);
+      q_set32(hi + i, 1 + random() % 10);
+      q_add(hi + i, lo + i);
+    }
+  }
+}
+
+
+/*
+ * Value of polynomial p at the point val
+ */
+static void eval_poly(rational_t *r, poly_buffer_t *p) {
+  monomial_t *m;
+  uint32_t i, n;
+
+  q_clear(r);
+  n = poly_buffer_nterms(p);
+  m = poly_buffer_mono(p);
+  for (i=0; i<n; i++) {
+    if (m[i].var == const_idx) {
+      q_add(r, &m[i].coeff);
+    } else {
+      assert(1 <= m[i].var && m[i].var <= nvars);
+      q_addmul(r, &m[i].coeff, val + m[i].var);
+    }
+  }
+}
+
+
+/*
+ * Store the vector of integer values in val[1 ... n-1] then try the next one
+ * - return false if all points of the box have been enumerated
+ */
+static bool next_point(void) {
+  uint32_t i;
+
+  for (i=1; i<nvars; i++) {
+    if (q_lt(val + i, hi + i)) {
+      q_add_one(val + i);
+      return true;
+    }
+    q_set(val + i, lo + i);
+  }
+  return false;
+}
+
+static void first_point(void) {
+  uint32_t i;
+
+  for (i=1; i<nvars; i++) {
+    q_set(val + i, lo + i);
+  }
+}
+
+
+/*
+ * Given the integer values val[1 ... n-1] and a target t, compute the value of x_n
+ * such that a_1 x_1 + ... + a_n x_n = t.
+ * - return false if the result is not between lo[n] and hi[n]
+ */
+static bool solve_last(rational_t *t) {
+  rational_t *x;
+  uint32_t i;
+
+  x = val + nvars;
+  q_set(x, t);
+  for (i=1; i<nvars; i++) {
+    q_submul(x, a + i, val + i);
+  }
+  q_div(x, a + nvars);
+
+  return q_le(lo + nvars, x) && q_le(x, hi + nvars);
+}
+
+
+/*
+ * Fill vector g with the constraint a_1 x_1 + ... + a_n x_n
+ * - the bound for each variable is chosen at random
+ */
+static void fill_vector(gomory_vector_t *g) {
+  uint32_t i;
+  bool is_lb;
+
+  reset_gomory_vector(g);
+  for (i=1; i<=nvars; i++) {
+    is_lb = random() % 2;
+    gomory_vector_add_elem(g, i, a + i, is_lb ? lo + i : hi + i, i < nvars, is_lb);
+  }
+}
+
+
+/*
+ * Check that the cut p >= 0 is satisfied at the current point
+ */
+static void check_cut(poly_buffer_t *p) {
+  rational_t r;
+
+  q_init(&r);
+  eval_poly(&r, p);
+  if (q_is_neg(&r)) {
+    printf("BUG: cut violated by a feasible point\n");
+    fflush(stdout);
+    exit(1);
+  }
+  q_clear(&r);
+  num_checks ++;
+}
+
+
+/*
+ * MIR cut: the constraint is a_1 x_1 + ... + a_n x_n = beta
+ * where beta is the value of a random point in the box.
+ */
+static void test_mir_cut(gomory_vector_t *g, poly_buffer_t *p) {
+  rational_t beta, s;
+  uint32_t i;
+
+  q_init(&beta);
+  q_init(&s);
+
+  for (i=1; i<nvars; i++) {
+    q_set(val + i, lo + i);
+    if (random() % 2) {
+      q_add_one(val + i);
+    }
+  }
+  q_set(val + nvars, lo + nvars);
+  for (i=1; i<=nvars; i++) {
+    q_addmul(&beta, a + i, val + i);
+  }
+
+  fill_vector(g);
+  do {
+    random_rational(&s, 4, 4);
+  } while (q_is_zero(&s));
+
+  if (make_mir_cut(g, &beta, &s, p)) {
+    num_cuts ++;
+    first_point();
+    do {
+      if (solve_last(&beta)) {
+        check_cut(p);
+      }
+    } while (next_point());
+  }
+
+  q_clear(&beta);
+  q_clear(&s);
+}
+
+
+/*
+ * Gomory cut: the constraint is that a_1 x_1 + ... + a_n x_n is an integer.
+ * - for each integer point, we check all the values of x_n for which the
+ *   sum is an integer
+ */
+static void test_gomory_cut(gomory_vector_t *g, poly_buffer_t *p) {
+  rational_t t, max;
+  uint32_t i;
+
+  q_init(&t);
+  q_init(&max);
+
+  fill_vector(g);
+  if (make_gomory_cut(g, p)) {
+    num_cuts ++;
+    first_point();
+    do {
+      // t and max = the sum for x_n = lo[n] and x_n = hi[n]
+      q_clear(&t);
+      for (i=1; i<nvars; i++) {
+        q_addmul(&t, a + i, val + i);
+      }
+      q_set(&max, &t);
+      q_addmul(&t, a + nvars, lo + nvars);
+      q_addmul(&max, a + nvars, hi + nvars);
+      if (q_gt(&t, &max)) {
+        q_swap(&t, &max);
+      }
+      q_ceil(&t);
+      while (q_le(&t, &max)) {
+        if (solve_last(&t)) {
+          check_cut(p);
+        }
+        q_add_one(&t);
+      }
+    } while (next_point());
+  }
+
+  q_clear(&t);
+  q_clear(&max);
+}
+
+
+static void test_cut_validity(uint32_t n) {
+  gomory_vector_t g;
+  poly_buffer_t p;
+  uint32_t i;
+
+  for (i=0; i<=MAX_VARS; i++) {
+    q_init(lo + i);
+    q_init(hi + i);
+    q_init(a + i);
+    q_init(val + i);
+  }
+  init_gomory_vector(&g);
+  init_poly_buffer(&p);
+
+  num_cuts = 0;
+  num_checks = 0;
+  for (i=0; i<n; i++) {
+    random_problem();
+    test_mir_cut(&g, &p);
+    random_problem();
+    test_gomory_cut(&g, &p);
+  }
+  printf("cut validity: %"PRIu32" cuts, %"PRIu32" points checked\n", num_cuts, num_checks);
+  fflush(stdout);
+
+  delete_poly_buffer(&p);
+  delete_gomory_vector(&g);
+  for (i=0; i<=MAX_VARS; i++) {
+    q_clear(lo + i);
+    q_clear(hi + i);
+    q_clear(a + i);
+    q_clear(val + i);
+  }
+}
+
+
+
+/*
+ * PART 2: SOLVING WITH CUTS
+ */
+
+/*
+ * Totals with and without cuts
+ */
+static uint32_t total_branch[2];
+static uint32_t total_cuts[2];
+static double total_time[2];
+
+
+static context_t *new_context(bool incremental) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, "QF_LIA") == 0);
+  if (incremental) {
+    assert(yices_set_config(config, "mode", "push-pop") == 0);
+  }
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+
+  return ctx;
+}
+
+static param_t *new_params(context_t *ctx, bool cuts) {
+  param_t *params;
+
+  params = yices_new_param_record();
+  yices_default_params_for_context(ctx, params);
+  if (cuts) {
+    assert(yices_set_param(params, "cuts", "true") == 0);
+    assert(yices_set_param(params, "cut-rounds", "4") == 0);
+  }
+  return params;
+}
+
+
+static smt_status_t check(context_t *ctx, term_t f, bool cuts) {
+  param_t *params;
+  model_t *mdl;
+  smt_status_t s;
+
+  params = new_params(ctx, cuts);
+  s = yices_check_context(ctx, params);
+  yices_free_param_record(params);
+
+  assert(s == STATUS_SAT || s == STATUS_UNSAT);
+  if (s == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return s;
+}
+
+
+/*
+ * Solve f with and without cuts and check that the results agree
+ */
+static smt_status_t solve(term_t f) {
+  context_t *ctx;
+  simplex_solver_t *simplex;
+  smt_status_t s[2];
+  double time;
+  uint32_t i;
+  bool searched;
+
+  for (i=0; i<2; i++) {
+    ctx = new_context(false);
+    assert(context_has_simplex_solver(ctx));
+    simplex = ctx->arith_solver;
+
+    time = get_cpu_time();
+    assert(yices_assert_formula(ctx, f) == 0);
+    searched = yices_context_status(ctx) == STATUS_IDLE;
+    s[i] = check(ctx, f, i == 1);
+    total_time[i] += get_cpu_time() - time;
+    assert(s[i] == s[0]);
+    // the search parameters are not applied if f simplifies to false
+    assert(!searched || simplex_option_enabled(simplex, SIMPLEX_CUTS) == (i == 1));
+
+    total_branch[i] += simplex_num_branch_and_bound(simplex);
+    total_cuts[i] += simplex_num_cuts(simplex);
+    yices_free_context(ctx);
+  }
+
+  assert(total_cuts[0] == 0);
+
+  return s[0];
+}
+
+
+/*
+ * Incremental test: the cuts kept in the pool must be removed on pop
+ * - f is asserted at the base level
+ * - then we push, assert g, check, pop and check again
+ */
+static void solve_incremental(term_t f, term_t g) {
+  context_t *ctx[2];
+  smt_status_t s[2];
+  uint32_t i;
+
+  for (i=0; i<2; i++) {
+    ctx[i] = new_context(true);
+    assert(yices_assert_formula(ctx[i], f) == 0);
+    assert(yices_push(ctx[i]) == 0);
+    assert(yices_assert_formula(ctx[i], g) == 0);
+    s[i] = check(ctx[i], yices_and2(f, g), i == 1);
+    assert(s[i] == s[0]);
+    assert(yices_pop(ctx[i]) == 0);
+    s[i] = check(ctx[i], f, i == 1);
+    assert(s[i] == s[0]);
+  }
+
+ done:
+  yices_free_context(ctx[0]);
+  yices_free_context(ctx[1]);
+}
+
+
+/*
+ * Random linear term: sum of k terms a_i x_i with a_i in [-coeff, coeff]
+ */
+static term_t random_poly(term_t *x, uint32_t n, uint32_t k, int32_t coeff) {
+  term_t *b;
+  term_t p;
+  uint32_t i;
+  int32_t c;
+
+  b = (term_t *) malloc(k * sizeof(term_t));
+  if (b == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<k; i++) {
+    do {
+      c = (int32_t) (random() % (2 * coeff + 1)) - coeff;
+    } while (c == 0);
+    b[i] = yices_mul(yices_int32(c), x[random() % n]);
+  }
+  p = yices_sum(k, b);
+  free(b);
+
+  return p;
+}
+
+
+/*
+ * Conjunction of m random constraints on n variables
+ * - each variable is in [-bound, bound]
+ * - constraint: p <= c or p >= c where p is a random polynomial with k monomials
+ */
+static term_t random_system(term_t *x, uint32_t n, uint32_t m, uint32_t k, int32_t bound) {
+  term_t *b;
+  term_t f, p, c;
+  uint32_t i;
+
+  b = (term_t *) malloc((m + 2 * n) * sizeof(term_t));
+  if (b == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    b[2*i] = yices_arith_leq_atom(x[i], yices_int32(bound));
+    b[2*i+1] = yices_arith_geq_atom(x[i], yices_int32(-bound));
+  }
+  for (i=0; i<m; i++) {
+    p = random_poly(x, n, k, 7);
+    c = yices_int32((int32_t) (random() % (2 * bound + 1)) - bound);
+    b[2*n + i] = (random() % 2) ? yices_arith_leq_atom(p, c) : yices_arith_geq_atom(p, c);
+  }
+  f = yices_and(m + 2 * n, b);
+  free(b);
+
+  return f;
+}
+
+
+/*
+ * Random disjunctions of constraints
+ */
+static term_t random_clauses(term_t *x, uint32_t n, uint32_t m, uint32_t k, int32_t bound) {
+  term_t *b;
+  term_t f, l1, l2;
+  uint32_t i;
+
+  b = (term_t *) malloc((m + 2 * n) * sizeof(term_t));
+  if (b == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    b[2*i] = yices_arith_leq_atom(x[i], yices_int32(bound));
+    b[2*i+1] = yices_arith_geq_atom(x[i], yices_int32(-bound));
+  }
+  for (i=0; i<m; i++) {
+    l1 = yices_arith_leq_atom(random_poly(x, n, k, 5), yices_int32((int32_t) (random() % bound)));
+    l2 = yices_arith_geq_atom(random_poly(x, n, k, 5), yices_int32((int32_t) (random() % bound)));
+    b[2*n + i] = yices_or2(l1, l2);
+  }
+  f = yices_and(m + 2 * n, b);
+  free(b);
+
+  return f;
+}
+
+
+static term_t *new_vars(uint32_t n, type_t tau) {
+  term_t *x;
+  uint32_t i;
+
+  x = (term_t *) malloc(n * sizeof(term_t));
+  if (x == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    x[i] = yices_new_uninterpreted_term(tau);
+  }
+  return x;
+}
+
+
+static void show_totals(const char *what) {
+  uint32_t i;
+
+  printf("%s:\n", what);
+  for (i=0; i<2; i++) {
+    printf("  %-12s %8"PRIu32" branch atoms %8"PRIu32" cuts %8.3f s\n",
+           i == 0 ? "no cuts" : "cuts", total_branch[i], total_cuts[i], total_time[i]);
+    total_branch[i] = 0;
+    total_cuts[i] = 0;
+    total_time[i] = 0;
+  }
+  fflush(stdout);
+}
+
+
+int main(void) {
+  term_t *x;
+  uint32_t i, nsat;
+
+  yices_init();
+  srandom(1234);
+
+  test_cut_validity(2000);
+
+  // small integer systems
+  x = new_vars(8, yices_int_type());
+  nsat = 0;
+  for (i=0; i<100; i++) {
+    if (solve(random_system(x, 8, 6, 4, 20)) == STATUS_SAT) nsat ++;
+  }
+  printf("small LIA systems: %"PRIu32" sat, %"PRIu32" unsat\n", nsat, 100 - nsat);
+  show_totals("small LIA systems");
+  free(x);
+
+  // small integer problems with disjunctions
+  x = new_vars(10, yices_int_type());
+  nsat = 0;
+  for (i=0; i<50; i++) {
+    if (solve(random_clauses(x, 10, 12, 3, 20)) == STATUS_SAT) nsat ++;
+  }
+  printf("small LIA clauses: %"PRIu32" sat, %"PRIu32" unsat\n", nsat, 50 - nsat);
+  show_totals("small LIA clauses");
+  free(x);
+
+  // push/pop
+  x = new_vars(8, yices_int_type());
+  for (i=0; i<30; i++) {
+    solve_incremental(random_system(x, 8, 4, 4, 20), random_system(x, 8, 3, 4, 20));
+  }
+  printf("incremental tests: ok\n");
+  free(x);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,233 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE VMTF DECISION QUEUE
+ *
+ * Random 3-SAT and bitvector problems are solved in push-pop mode
+ * with the VMTF queue and with the default heap. The results must
+ * agree and all models are checked. A third context switches between
+ * the two queues on every check.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+#define NBOOLS 100
+#define NCLAUSES 400
+#define NEXTRA 30
+#define NBVS 6
+#define BVSIZE 8
+#define NROUNDS 6
+
+static term_t bvar[NBOOLS];
+static term_t bv[NBVS];
+
+static term_t random_literal(void) {
+  term_t x;
+
+  x = bvar[random() % NBOOLS];
+  return (random() & 1) ? x : yices_not(x);
+}
+
+/*
+ * Random bitvector atom: (x op y) = c or (x op y) <= c
+ */
+static term_t random_bv_atom(void) {
+  term_t x, y, c, t;
+
+  x = bv[random() % NBVS];
+  y = bv[random() % NBVS];
+  c = yices_bvconst_uint32(BVSIZE, random() % (1 << BVSIZE));
+  switch (random() % 3) {
+  case 0:
+    t = yices_bvadd(x, y);
+    break;
+  case 1:
+    t = yices_bvmul(x, y);
+    break;
+  default:
+    t = yices_bvxor2(x, y);
+    break;
+  }
+  return (random() & 1) ? yices_bveq_atom(t, c) : yices_bvle_atom(t, c);
+}
+
+static term_t random_formula(uint32_t n, bool bitvectors) {
+  term_t *a;
+  term_t f, l;
+  uint32_t i;
+
+  a = (term_t *) malloc(n * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    l = bitvectors ? random_bv_atom() : random_literal();
+    if (random() & 1) l = yices_not(l);
+    a[i] = yices_or3(l, random_literal(), random_literal());
+  }
+  f = yices_and(n, a);
+  free(a);
+
+  return f;
+}
+
+static context_t *new_context(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, "QF_BV") == 0);
+  assert(yices_set_config(config, "mode", "push-pop") == 0);
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+
+  return ctx;
+}
+
+/*
+ * Check ctx and verify the model if it's sat
+ */
+static smt_status_t check(context_t *ctx, param_t *params, term_t f) {
+  smt_status_t stat;
+  model_t *mdl;
+
+  stat = yices_check_context(ctx, params);
+  assert(stat == STATUS_SAT || stat == STATUS_UNSAT);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return stat;
+}
+
+
+/*
+ * ctx[0] uses the heap, ctx[1] uses VMTF, ctx[2] alternates
+ */
+static void test_formulas(bool bitvectors) {
+  context_t *ctx[3];
+  param_t *params[2];
+  term_t f, g;
+  smt_status_t s[3];
+  uint32_t i, j, nsat, nunsat;
+
+  for (j=0; j<3; j++) {
+    ctx[j] = new_context();
+  }
+
+  params[0] = yices_new_param_record();
+  yices_default_params_for_context(ctx[0], params[0]);
+  assert(yices_set_param(params[0], "decision-queue", "heap") == 0);
+
+  params[1] = yices_new_param_record();
+  yices_default_params_for_context(ctx[1], params[1]);
+  assert(yices_set_param(params[1], "decision-queue", "vmtf") == 0);
+
+  nsat = 0;
+  nunsat = 0;
+
+  f = random_formula(NCLAUSES, bitvectors);
+  for (j=0; j<3; j++) {
+    assert(yices_assert_formula(ctx[j], f) == 0);
+  }
+
+  for (i=0; i<NROUNDS; i++) {
+    g = random_formula(NEXTRA, bitvectors);
+    for (j=0; j<3; j++) {
+      assert(yices_push(ctx[j]) == 0);
+      assert(yices_assert_formula(ctx[j], g) == 0);
+    }
+
+    s[0] = check(ctx[0], params[0], yices_and2(f, g));
+    s[1] = check(ctx[1], params[1], yices_and2(f, g));
+    s[2] = check(ctx[2], params[i & 1], yices_and2(f, g));
+    assert(s[0] == s[1] && s[0] == s[2]);
+    if (s[0] == STATUS_SAT) nsat ++; else nunsat ++;
+
+    // pop removes the variables created for g
+    for (j=0; j<3; j++) {
+      assert(yices_pop(ctx[j]) == 0);
+    }
+
+    s[0] = check(ctx[0], params[0], f);
+    s[1] = check(ctx[1], params[1], f);
+    s[2] = check(ctx[2], params[i & 1], f);
+    assert(s[0] == s[1] && s[0] == s[2]);
+    if (s[0] == STATUS_UNSAT) break; // can't push anymore
+  }
+
+  printf("%s: %"PRIu32" sat, %"PRIu32" unsat\n",
+         bitvectors ? "bitvectors" : "3-sat", nsat, nunsat);
+
+  for (j=0; j<3; j++) {
+    yices_free_context(ctx[j]);
+  }
+  yices_free_param_record(params[0]);
+  yices_free_param_record(params[1]);
+}
+
+
+int main(void) {
+  param_t *params;
+  uint32_t i;
+
+  yices_init();
+
+  for (i=0; i<NBOOLS; i++) {
+    bvar[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+  for (i=0; i<NBVS; i++) {
+    bv[i] = yices_new_uninterpreted_term(yices_bv_type(BVSIZE));
+  }
+
+  params = yices_new_param_record();
+  assert(yices_set_param(params, "decision-queue", "vsids") < 0);
+  yices_free_param_record(params);
+
+  srandom(909);
+  for (i=0; i<2; i++) {
+    test_formulas(false);
+    test_formulas(true);
+  }
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,490 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST EVALUATION PLANS
+ *
+ * Random terms are evaluated in random models with yices_term_array_value
+ * and with an evaluation plan. The results must be the same.
+ *
+ * Parallel evaluation (yices_eval_plans_in_models) must give the same
+ * results as yices_eval_plan_value and must not modify the models.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "model/models.h"
+#include "utils/cputime.h"
+#include "yices.h"
+
+
+/*
+ * Vocabulary: NVARS integer, bitvector, and Boolean variables
+ */
+#define NVARS 8
+#define BVSIZE 8
+
+static term_t ivar[NVARS];
+static term_t bvvar[NVARS];
+static term_t pvar[NVARS];
+
+/*
+ * Quantified formula: it can't be evaluated so it is used to
+ * produce evaluation errors.
+ */
+static term_t quant;
+static bool with_errors;
+
+
+static void init_vars(void) {
+  term_t z;
+  uint32_t i;
+
+  for (i=0; i<NVARS; i++) {
+    ivar[i] = yices_new_uninterpreted_term(yices_int_type());
+    bvvar[i] = yices_new_uninterpreted_term(yices_bv_type(BVSIZE));
+    pvar[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+
+  z = yices_new_variable(yices_int_type());
+  quant = yices_forall(1, &z, yices_arith_leq_atom(z, ivar[0]));
+}
+
+
+/*
+ * Random terms of depth at most d
+ */
+static term_t random_bool(uint32_t d);
+static term_t random_int(uint32_t d);
+static term_t random_bv(uint32_t d);
+
+static term_t random_int(uint32_t d) {
+  term_t t;
+
+  if (d == 0) {
+    if (random() % 4 == 0) {
+      return yices_int32((int32_t) (random() % 21) - 10);
+    }
+    return ivar[random() % NVARS];
+  }
+
+  switch (random() % 6) {
+  case 0:
+    t = yices_add(random_int(d-1), random_int(d-1));
+    break;
+  case 1:
+    t = yices_mul(yices_int32((int32_t) (random() % 7) - 3), random_int(d-1));
+    break;
+  case 2:
+    t = yices_ite(random_bool(d-1), random_int(d-1), random_int(d-1));
+    break;
+  case 3:
+    t = yices_mul(random_int(d-1), random_int(d-1));
+    break;
+  case 4:
+    // ground subterm
+    t = yices_ite(yices_arith_lt_atom(yices_int32(3), yices_int32((int32_t) (random() % 6))),
+                  yices_int32(1), yices_int32(2));
+    t = yices_add(t, random_int(d-1));
+    break;
+  default:
+    t = random_int(0);
+    break;
+  }
+
+  return t;
+}
+
+static term_t random_bv(uint32_t d) {
+  term_t t;
+
+  if (d == 0) {
+    if (random() % 4 == 0) {
+      return yices_bvconst_uint32(BVSIZE, (uint32_t) random());
+    }
+    return bvvar[random() % NVARS];
+  }
+
+  switch (random() % 6) {
+  case 0:
+    t = yices_bvadd(random_bv(d-1), random_bv(d-1));
+    break;
+  case 1:
+    t = yices_bvmul(random_bv(d-1), random_bv(d-1));
+    break;
+  case 2:
+    t = yices_bvdiv(random_bv(d-1), random_bv(d-1));
+    break;
+  case 3:
+    t = yices_ite(random_bool(d-1), random_bv(d-1), random_bv(d-1));
+    break;
+  case 4:
+    t = yices_bvshl(random_bv(d-1), random_bv(d-1));
+    break;
+  default:
+    t = random_bv(0);
+    break;
+  }
+
+  return t;
+}
+
+static term_t random_bool(uint32_t d) {
+  term_t t;
+
+  if (d == 0) {
+    return pvar[random() % NVARS];
+  }
+
+  switch (random() % 8) {
+  case 0:
+    t = yices_or2(random_bool(d-1), random_bool(d-1));
+    break;
+  case 1:
+    t = yices_xor2(random_bool(d-1), random_bool(d-1));
+    break;
+  case 2:
+    t = yices_not(random_bool(d-1));
+    break;
+  case 3:
+    t = yices_arith_leq_atom(random_int(d-1), random_int(d-1));
+    break;
+  case 4:
+    t = yices_bvle_atom(random_bv(d-1), random_bv(d-1));
+    break;
+  case 5:
+    t = yices_eq(random_bv(d-1), random_bv(d-1));
+    break;
+  case 6:
+    // error only if the quantifier must be evaluated
+    t = (with_errors && random() % 24 == 0) ? yices_ite(random_bool(d-1), quant, random_bool(d-1)) : random_bool(0);
+    break;
+  default:
+    t = random_bool(0);
+    break;
+  }
+
+  return t;
+}
+
+
+/*
+ * Random model: all variables are assigned except if partial is true
+ * in which case one variable is left out
+ */
+static model_t *random_model(bool partial) {
+  term_t var[3 * NVARS];
+  term_t val[3 * NVARS];
+  model_t *mdl;
+  uint32_t i, n;
+
+  n = 0;
+  for (i=0; i<NVARS; i++) {
+    var[n] = ivar[i];
+    val[n] = yices_int32((int32_t) (random() % 41) - 20);
+    n ++;
+    var[n] = bvvar[i];
+    val[n] = yices_bvconst_uint32(BVSIZE, (uint32_t) random());
+    n ++;
+    var[n] = pvar[i];
+    val[n] = (random() & 1) ? yices_true() : yices_false();
+    n ++;
+  }
+  if (partial) {
+    n --;
+  }
+
+  mdl = yices_model_from_map(n, var, val);
+  assert(mdl != NULL);
+
+  return mdl;
+}
+
+
+/*
+ * Check that the plan gives the same results as yices_term_array_value
+ * on m models.
+ */
+static void test_plan(uint32_t n, term_t *a, uint32_t m, bool partial) {
+  eval_plan_t *plan;
+  model_t *mdl;
+  term_t *b, *c;
+  double time, plan_time, array_time;
+  uint32_t i, j, nerrors;
+  int32_t r1, r2;
+  int32_t e1, e2;
+
+  b = (term_t *) malloc(n * sizeof(term_t));
+  c = (term_t *) malloc(n * sizeof(term_t));
+  if (b == NULL || c == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+
+  plan = yices_new_eval_plan(n, a);
+  assert(plan != NULL);
+
+  plan_time = 0;
+  array_time = 0;
+  nerrors = 0;
+  for (j=0; j<m; j++) {
+    mdl = random_model(partial && (j % 2 == 0));
+
+    time = get_cpu_time();
+    r1 = yices_term_array_value(mdl, n, a, b);
+    e1 = yices_error_code();
+    array_time += get_cpu_time() - time;
+
+    time = get_cpu_time();
+    r2 = yices_eval_plan_value(plan, mdl, c);
+    e2 = yices_error_code();
+    plan_time += get_cpu_time() - time;
+
+    assert(r1 == r2);
+    if (r1 == 0) {
+      for (i=0; i<n; i++) {
+        assert(b[i] == c[i]);
+      }
+    } else {
+      assert(e1 == e2);
+      nerrors ++;
+    }
+
+    yices_free_model(mdl);
+  }
+
+  printf("  %"PRIu32" terms, %"PRIu32" models (%"PRIu32" errors): term_array_value %.3f s, eval plan %.3f s\n",
+         n, m, nerrors, array_time, plan_time);
+  fflush(stdout);
+
+  yices_free_eval_plan(plan);
+  free(b);
+  free(c);
+}
+
+
+/*
+ * Elapsed time in seconds (get_cpu_time adds the time of all threads)
+ */
+static double wall_time(void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+
+/*
+ * Parallel evaluation:
+ * - nplans plans of n terms of depth d, evaluated in nmodels models
+ * - job j evaluates plan j % nplans in model j / nplans
+ */
+static void test_parallel(uint32_t nplans, uint32_t n, uint32_t d, uint32_t nmodels, uint32_t nthreads) {
+  eval_plan_t **plan, **job_plan;
+  model_t **mdl, **job_mdl;
+  uint32_t *nobjects;
+  term_t **b;
+  term_t *a, *c;
+  int32_t *status;
+  double time;
+  uint32_t i, j, m, nerrors;
+  int32_t r;
+
+  m = nplans * nmodels;
+  plan = (eval_plan_t **) malloc(nplans * sizeof(eval_plan_t *));
+  mdl = (model_t **) malloc(nmodels * sizeof(model_t *));
+  nobjects = (uint32_t *) malloc(nmodels * sizeof(uint32_t));
+  job_plan = (eval_plan_t **) malloc(m * sizeof(eval_plan_t *));
+  job_mdl = (model_t **) malloc(m * sizeof(model_t *));
+  b = (term_t **) malloc(m * sizeof(term_t *));
+  status = (int32_t *) malloc(m * sizeof(int32_t));
+  a = (term_t *) malloc(n * sizeof(term_t));
+  c = (term_t *) malloc(n * sizeof(term_t));
+  if (plan == NULL || mdl == NULL || nobjects == NULL || job_plan == NULL ||
+      job_mdl == NULL || b == NULL || status == NULL || a == NULL || c == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+
+  for (i=0; i<nplans; i++) {
+    with_errors = (i % 2 == 1);
+    for (j=0; j<n; j++) {
+      switch (j % 3) {
+      case 0: a[j] = random_bool(d); break;
+      case 1: a[j] = random_int(d); break;
+      default: a[j] = random_bv(d); break;
+      }
+    }
+    plan[i] = yices_new_eval_plan(n, a);
+    assert(plan[i] != NULL);
+  }
+  with_errors = false;
+
+  for (i=0; i<nmodels; i++) {
+    mdl[i] = random_model(false);
+    nobjects[i] = model_get_vtbl(mdl[i])->nobjects;
+  }
+
+  for (j=0; j<m; j++) {
+    job_plan[j] = plan[j % nplans];
+    job_mdl[j] = mdl[j / nplans];
+    b[j] = (term_t *) malloc(n * sizeof(term_t));
+    if (b[j] == NULL) {
+      fprintf(stderr, "Out of memory\n");
+      exit(1);
+    }
+  }
+
+  time = wall_time();
+  r = yices_eval_plans_in_models(m, job_plan, job_mdl, b, status, nthreads);
+  time = wall_time() - time;
+
+  // the models are not modified
+  for (i=0; i<nmodels; i++) {
+    assert(model_get_vtbl(mdl[i])->nobjects == nobjects[i]);
+  }
+
+  nerrors = 0;
+  for (j=0; j<m; j++) {
+    if (status[j] == 0) {
+      assert(yices_eval_plan_value(job_plan[j], job_mdl[j], c) == 0);
+      for (i=0; i<n; i++) {
+        assert(b[j][i] == c[i]);
+      }
+    } else {
+      assert(r < 0);
+      assert(yices_eval_plan_value(job_plan[j], job_mdl[j], c) < 0);
+      assert(yices_error_code() == status[j]);
+      nerrors ++;
+    }
+  }
+  assert((r == 0) == (nerrors == 0));
+
+  printf("  %"PRIu32" plans, %"PRIu32" models, %"PRIu32" threads (%"PRIu32" errors): %.3f s\n",
+         nplans, nmodels, nthreads, nerrors, time);
+  fflush(stdout);
+
+  for (j=0; j<m; j++) {
+    free(b[j]);
+  }
+  for (i=0; i<nmodels; i++) {
+    yices_free_model(mdl[i]);
+  }
+  for (i=0; i<nplans; i++) {
+    yices_free_eval_plan(plan[i]);
+  }
+  free(plan);
+  free(mdl);
+  free(nobjects);
+  free(job_plan);
+  free(job_mdl);
+  free(b);
+  free(status);
+  free(a);
+  free(c);
+}
+
+
+int main(void) {
+  eval_plan_t *plan;
+  term_t a[2000];
+  term_t b[2];
+  model_t *mdl;
+  uint32_t i;
+
+  yices_init();
+  srandom(7777);
+  init_vars();
+
+  // invalid term
+  a[0] = pvar[0];
+  a[1] = 1000000;
+  assert(yices_new_eval_plan(2, a) == NULL);
+  assert(yices_error_code() == INVALID_TERM);
+
+  // empty plan
+  plan = yices_new_eval_plan(0, a);
+  assert(plan != NULL);
+  mdl = random_model(false);
+  assert(yices_eval_plan_value(plan, mdl, b) == 0);
+  yices_free_model(mdl);
+  yices_free_eval_plan(plan);
+
+  // ground terms only
+  a[0] = yices_arith_lt_atom(yices_int32(2), yices_int32(3));
+  a[1] = yices_ite(a[0], yices_int32(5), yices_int32(7));
+  test_plan(2, a, 5, false);
+
+  printf("small terms:\n");
+  with_errors = true;
+  for (i=0; i<200; i++) {
+    a[i] = random_bool(3);
+  }
+  test_plan(200, a, 100, true);
+
+  printf("large terms:\n");
+  with_errors = false;
+  for (i=0; i<2000; i++) {
+    switch (i % 3) {
+    case 0: a[i] = random_bool(6); break;
+    case 1: a[i] = random_int(5); break;
+    default: a[i] = random_bv(5); break;
+    }
+  }
+  test_plan(2000, a, 200, false);
+
+  printf("parallel evaluation:\n");
+  test_parallel(4, 300, 4, 8, 1);
+  test_parallel(4, 300, 4, 8, 4);
+  test_parallel(2, 200, 4, 1, 8);
+  test_parallel(1, 2000, 5, 40, 1);
+  test_parallel(1, 2000, 5, 40, 4);
+
+  // the plan's terms must survive garbage collection
+  // (the variables are kept as roots so that we can build models)
+  plan = yices_new_eval_plan(2, a);
+  assert(plan != NULL);
+  for (i=0; i<NVARS; i++) {
+    a[2 + 3*i] = ivar[i];
+    a[3 + 3*i] = bvvar[i];
+    a[4 + 3*i] = pvar[i];
+  }
+  yices_garbage_collect(a, 2 + 3 * NVARS, NULL, 0, false);
+  mdl = random_model(false);
+  assert(yices_eval_plan_value(plan, mdl, b) == 0);
+  yices_free_model(mdl);
+  yices_free_eval_plan(plan);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,287 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST LAZY BIT-BLASTING
+ *
+ * Random bitvector problems with multiplications, divisions, and
+ * remainders are solved with eager and lazy bit-blasting. The results
+ * must agree and all models are checked. The problems are solved
+ * incrementally (push/pop), without and with the egraph.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "context/context.h"
+#include "solvers/bv/bvsolver.h"
+#include "yices.h"
+
+
+#define NVARS 4
+#define NCLAUSES 6
+
+
+/*
+ * Random term of the given depth on var[0 ... NVARS-1]
+ * - n = number of bits
+ */
+static term_t random_term(term_t *var, uint32_t n, uint32_t depth) {
+  term_t a, b;
+
+  if (depth == 0) {
+    if (random() % 4 == 0) {
+      return yices_bvconst_uint32(n, (uint32_t) random());
+    }
+    return var[random() % NVARS];
+  }
+
+  a = random_term(var, n, depth - 1);
+  b = random_term(var, n, random() % depth);
+
+  switch (random() % 10) {
+  case 0:
+    return yices_bvadd(a, b);
+  case 1:
+    return yices_bvsub(a, b);
+  case 2:
+    return yices_bvand2(a, b);
+  case 3:
+    return yices_bvdiv(a, b);
+  case 4:
+    return yices_bvrem(a, b);
+  case 5:
+    return yices_bvsdiv(a, b);
+  case 6:
+    return yices_bvsrem(a, b);
+  case 7:
+    return yices_bvsmod(a, b);
+  default:
+    return yices_bvmul(a, b);
+  }
+}
+
+/*
+ * Random atom: the left term has depth between 1 and d
+ */
+static term_t random_atom(term_t *var, uint32_t n, uint32_t d) {
+  term_t a, b;
+
+  a = random_term(var, n, 1 + random() % d);
+  b = random_term(var, n, random() % 2);
+
+  switch (random() % 4) {
+  case 0:
+    return yices_bvle_atom(a, b);
+  case 1:
+    return yices_bvslt_atom(a, b);
+  default:
+    return yices_eq(a, b);
+  }
+}
+
+static term_t random_literal(term_t *var, uint32_t n, uint32_t d) {
+  term_t a;
+
+  a = random_atom(var, n, d);
+  return (random() % 3 == 0) ? yices_not(a) : a;
+}
+
+static term_t random_formula(term_t *var, uint32_t n, uint32_t d) {
+  term_t a[NCLAUSES];
+  uint32_t i;
+
+  for (i=0; i<NCLAUSES; i++) {
+    if (random() % 2 == 0) {
+      a[i] = random_literal(var, n, d);
+    } else {
+      a[i] = yices_or2(random_literal(var, n, d), random_literal(var, n, d));
+    }
+  }
+
+  return yices_and(NCLAUSES, a);
+}
+
+
+/*
+ * Check ctx and verify the model if it's sat
+ */
+static smt_status_t check(context_t *ctx, param_t *params, term_t f) {
+  smt_status_t stat;
+  model_t *mdl;
+
+  stat = yices_check_context(ctx, params);
+  assert(stat == STATUS_SAT || stat == STATUS_UNSAT);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return stat;
+}
+
+
+/*
+ * Solve k random problems on variables of n bits
+ * - d = maximal depth of the terms
+ * - logic = "QF_BV" or "QF_UFBV"
+ * - ctx[0] is eager, ctx[1] is lazy
+ * - each problem is asserted after a push, on top of the
+ *   base formula asserted at level 1
+ */
+static void test_random_problems(const char *logic, uint32_t n, uint32_t d, uint32_t k) {
+  ctx_config_t *config;
+  context_t *ctx[2];
+  param_t *params[2];
+  term_t var[NVARS];
+  term_t base, f;
+  smt_status_t s[2];
+  uint32_t i, j, nsat, nunsat;
+  bv_solver_t *bv;
+
+  for (i=0; i<NVARS; i++) {
+    var[i] = yices_new_uninterpreted_term(yices_bv_type(n));
+  }
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, logic) == 0);
+  for (j=0; j<2; j++) {
+    ctx[j] = yices_new_context(config);
+    assert(ctx[j] != NULL);
+    params[j] = yices_new_param_record();
+    yices_default_params_for_context(ctx[j], params[j]);
+  }
+  yices_free_config(config);
+  assert(yices_set_param(params[1], "lazy-bitblasting", "true") == 0);
+
+  // base level: x0 != 0 and all variables are small if n is large
+  base = yices_neq(var[0], yices_bvconst_zero(n));
+  if (n > 16) {
+    for (i=0; i<NVARS; i++) {
+      base = yices_and2(base, yices_bvle_atom(var[i], yices_bvconst_uint32(n, 255)));
+    }
+  }
+  for (j=0; j<2; j++) {
+    assert(yices_push(ctx[j]) == 0);
+    assert(yices_assert_formula(ctx[j], base) == 0);
+  }
+
+  nsat = 0;
+  nunsat = 0;
+  for (i=0; i<k; i++) {
+    f = random_formula(var, n, d);
+    for (j=0; j<2; j++) {
+      assert(yices_push(ctx[j]) == 0);
+      assert(yices_assert_formula(ctx[j], f) == 0);
+      s[j] = check(ctx[j], params[j], yices_and2(base, f));
+    }
+    assert(s[0] == s[1]);
+    if (s[0] == STATUS_SAT) nsat ++; else nunsat ++;
+
+    for (j=0; j<2; j++) {
+      assert(yices_pop(ctx[j]) == 0);
+    }
+  }
+
+  bv = ctx[1]->bv_solver;
+  assert(bv != NULL && bv_solver_lazy_ops(bv) > 0);
+  assert(bv_solver_lazy_ops(ctx[0]->bv_solver) == 0);
+
+  printf("%s, %"PRIu32" bits: %"PRIu32" sat, %"PRIu32" unsat, %"PRIu32" lazy ops, %"PRIu32" refinements\n",
+         logic, n, nsat, nunsat, bv_solver_lazy_ops(bv), bv_solver_lazy_refinements(bv));
+
+  for (j=0; j<2; j++) {
+    yices_free_param_record(params[j]);
+    yices_free_context(ctx[j]);
+  }
+}
+
+
+/*
+ * Factoring: x * y = c with 1 < x, y < 2^(n/2) in n bits
+ * - the product doesn't overflow so it's sat iff c is not prime
+ */
+static void test_factoring(uint32_t n, uint32_t c, bool prime) {
+  context_t *ctx[2];
+  param_t *params;
+  term_t x, y, one, half, f;
+  smt_status_t s[2];
+  uint32_t j;
+
+  x = yices_new_uninterpreted_term(yices_bv_type(n));
+  y = yices_new_uninterpreted_term(yices_bv_type(n));
+  one = yices_bvconst_one(n);
+  half = yices_bvconst_uint32(n, 1u << (n/2));
+  f = yices_and(5, (term_t[]) { yices_bvgt_atom(x, one), yices_bvgt_atom(y, one),
+                                yices_bvlt_atom(x, half), yices_bvlt_atom(y, half),
+                                yices_eq(yices_bvmul(x, y), yices_bvconst_uint32(n, c)) });
+
+  params = yices_new_param_record();
+  for (j=0; j<2; j++) {
+    ctx[j] = yices_new_context(NULL);
+    yices_default_params_for_context(ctx[j], params);
+    if (j == 1) {
+      assert(yices_set_param(params, "lazy-bitblasting", "true") == 0);
+    }
+    assert(yices_assert_formula(ctx[j], f) == 0);
+    s[j] = check(ctx[j], params, f);
+  }
+  assert(s[0] == s[1]);
+  assert(s[0] == (prime ? STATUS_UNSAT : STATUS_SAT));
+
+  printf("factoring %"PRIu32" (%"PRIu32" bits): %s, %"PRIu32" refinements\n",
+         c, n, s[0] == STATUS_SAT ? "sat" : "unsat", bv_solver_lazy_refinements(ctx[1]->bv_solver));
+
+  for (j=0; j<2; j++) {
+    yices_free_context(ctx[j]);
+  }
+  yices_free_param_record(params);
+}
+
+
+int main(void) {
+  yices_init();
+
+  srandom(2909);
+  test_random_problems("QF_BV", 8, 2, 150);
+  test_random_problems("QF_BV", 70, 1, 40);
+  test_random_problems("QF_UFBV", 8, 2, 150);
+
+  test_factoring(16, 143, false);
+  test_factoring(16, 251, true);
+  test_factoring(24, 4087, false);
+  test_factoring(24, 4093, true);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -27,6 +27,8 @@
 #include "solvers/simplex/matrices.h"
 #include "terms/polynomials.h"
 #include "terms/rationals.h"
+#include "utils/cputime.h"
+#include "utils/memalloc.h"
 
 
 
@@ -379,6 +381,213 @@ static void random_pivot(matrix_t *matrix) {
 }
 
 
+
+/*
+ * TABLEAU CHECK
+ */
+
+/*
+ * Random polynomial with m variables and d non-zero coefficients in [-c, c]
+ * - the polynomial is stored in monarray
+ */
+static uint32_t make_random_int_poly(uint32_t m, uint32_t d, int32_t c) {
+  uint32_t i;
+  int32_t a;
+
+  assert(d < m && d < MAXMONOMIALS);
+
+  for (i=0; i<d; i++) {
+    monarray[i].var = random() % m;
+    do {
+      a = (int32_t) (random() % (2 * c + 1)) - c;
+    } while (a == 0);
+    q_set32(&monarray[i].coeff, a);
+  }
+  monarray[i].var = max_idx;
+
+  sort_monarray(monarray, i);
+  return normalize_monarray(monarray, i);
+}
+
+
+/*
+ * Random matrix with n rows, m columns, d non-zeros per row, and
+ * coefficients in [-c, c]. A copy of each row is stored in p[0 ... n-1].
+ */
+static void init_random_int_matrix(matrix_t *matrix, polynomial_t **p, uint32_t n, uint32_t m,
+                                   uint32_t d, int32_t c) {
+  uint32_t i, k;
+
+  init_matrix(matrix, 0, 0);
+  matrix_add_columns(matrix, m);
+
+  for (i=0; i<n; i++) {
+    do {
+      k = make_random_int_poly(m, d, c);
+    } while (k == 0 || (k == 1 && monarray[0].var == const_idx));
+    matrix_add_row(matrix, monarray, k);
+    p[i] = monarray_copy_to_poly(monarray, k);
+  }
+}
+
+
+/*
+ * Check whether element i of row can be used for pivoting
+ * - if unit is true, its coefficient must also be +1 or -1
+ */
+static bool pivot_candidate(matrix_t *matrix, uint32_t r, uint32_t i, bool unit) {
+  row_elem_t *e;
+
+  e = matrix->row[r]->data + i;
+  return e->c_idx > const_idx && e->c_idx != matrix->base_var[r] &&
+    (! unit || q_is_one(&e->coeff) || q_is_minus_one(&e->coeff));
+}
+
+
+/*
+ * Make x basic in row r, where x is a random non-basic variable of r
+ * - if prefer_unit is true, pick a variable with coefficient +1 or -1
+ *   if there's one
+ * - return false if row r has no candidate variable
+ */
+static bool pivot_in_row(matrix_t *matrix, uint32_t r, bool prefer_unit) {
+  uint32_t i, n, k, best;
+
+  n = matrix->row[r]->size;
+  best = n;
+  if (prefer_unit) {
+    k = 0;
+    for (i=0; i<n; i++) {
+      if (pivot_candidate(matrix, r, i, true)) {
+        k ++;
+        if (random() % k == 0) best = i;
+      }
+    }
+  }
+  if (best == n) {
+    k = 0;
+    for (i=0; i<n; i++) {
+      if (pivot_candidate(matrix, r, i, false)) {
+        k ++;
+        if (random() % k == 0) best = i;
+      }
+    }
+  }
+
+  if (best < n) {
+    matrix_pivot(matrix, r, best);
+    return true;
+  }
+  return false;
+}
+
+
+/*
+ * Check that any solution of the tableau satisfies the original rows p[0 ... n-1]
+ * - all rows must have a basic variable
+ * - random integer values are assigned to the non-basic variables,
+ *   then the basic variables are computed from the rows
+ */
+static void check_tableau(matrix_t *matrix, polynomial_t **p, uint32_t n) {
+  rational_t *val;
+  rational_t aux;
+  row_t *row;
+  uint32_t i, j, m;
+  int32_t x, y;
+
+  assert(good_matrix(matrix));
+
+  m = matrix->ncolumns;
+  val = (rational_t *) safe_malloc(m * sizeof(rational_t));
+  for (i=0; i<m; i++) {
+    q_init(&val[i]);
+    if (matrix->base_row[i] < 0) {
+      q_set32(&val[i], (int32_t) (random() % 21) - 10);
+    }
+  }
+  q_set_one(&val[const_idx]);
+
+  for (i=0; i<matrix->nrows; i++) {
+    x = matrix->base_var[i];
+    if (x < 0) {
+      printf("*** BUG: row %"PRIu32" has no basic variable ***\n", i);
+      exit(1);
+    }
+    row = matrix->row[i];
+    for (j=0; j<row->size; j++) {
+      y = row->data[j].c_idx;
+      if (y >= 0 && y != x) {
+        q_submul(&val[x], &row->data[j].coeff, &val[y]);
+      }
+    }
+  }
+
+  q_init(&aux);
+  for (i=0; i<n; i++) {
+    q_clear(&aux);
+    for (j=0; j<p[i]->nterms; j++) {
+      q_addmul(&aux, &p[i]->mono[j].coeff, &val[p[i]->mono[j].var]);
+    }
+    if (q_is_nonzero(&aux)) {
+      printf("*** BUG: row %"PRIu32" is not satisfied ***\n", i);
+      exit(1);
+    }
+  }
+  q_clear(&aux);
+
+  for (i=0; i<m; i++) {
+    q_clear(&val[i]);
+  }
+  safe_free(val);
+}
+
+
+/*
+ * Build a random tableau: n rows, m columns, d non-zeros per row,
+ * coefficients in [-c, c], then apply k random pivots.
+ * - if prefer_unit is true, the pivots are on coefficients +1/-1 when possible
+ *   (so rows with integer coefficients stay integer)
+ */
+static void test_random_tableau(uint32_t n, uint32_t m, uint32_t d, int32_t c, uint32_t k, bool prefer_unit) {
+  polynomial_t **p;
+  double time;
+  uint32_t i, r, npivots;
+
+  printf("tableau: %"PRIu32" rows, %"PRIu32" columns, coefficients in [-%"PRId32", %"PRId32"]%s: ",
+         n, m, c, c, prefer_unit ? ", unit pivots" : "");
+  fflush(stdout);
+
+  p = (polynomial_t **) safe_malloc(n * sizeof(polynomial_t *));
+  init_random_int_matrix(&matrix, p, n, m, d, c);
+
+  time = get_cpu_time();
+  npivots = 0;
+  for (i=0; i<n; i++) {
+    if (! pivot_in_row(&matrix, i, prefer_unit)) {
+      printf("*** BUG: can't pivot in row %"PRIu32" ***\n", i);
+      exit(1);
+    }
+    npivots ++;
+  }
+  for (i=0; i<k; i++) {
+    r = (uint32_t) (random() % n);
+    if (pivot_in_row(&matrix, r, prefer_unit)) {
+      npivots ++;
+    }
+  }
+  time = get_cpu_time() - time;
+
+  check_tableau(&matrix, p, n);
+  printf("%"PRIu32" pivots, %.3f s\n", npivots, time);
+
+  delete_matrix(&matrix);
+  for (i=0; i<n; i++) {
+    free_polynomial(p[i]);
+  }
+  safe_free(p);
+}
+
+
 int main(void) {
   uint32_t i;
 
@@ -418,6 +627,16 @@ int main(void) {
   }
 
   delete_matrix(&matrix);
+
+  printf("\n==== RANDOM TABLEAUX ====\n");
+  for (i=0; i<10; i++) {
+    test_random_tableau(100, 300, 5, 1, 500, false);
+    test_random_tableau(100, 300, 5, 3, 500, true);
+    test_random_tableau(50, 100, 4, 9, 100, false);
+  }
+  test_random_tableau(200, 600, 5, 1, 1000, true);
+  test_random_tableau(200, 600, 5, 2, 1000, true);
+
   for (i=0; i<MAXMONOMIALS; i++) {
     q_clear(&monarray[i].coeff);
   }
@@ -0,0 +1,210 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE PORTFOLIO SOLVER
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+#define NUM_WORKERS 4
+
+
+/*
+ * Pigeon-hole formula: p pigeons, h holes
+ * - x[i * h + j] means pigeon i is in hole j
+ * - the formula is unsat if p > h
+ */
+static term_t pigeon_hole(uint32_t p, uint32_t h) {
+  term_t *x, *a;
+  term_t f;
+  uint32_t i, j, k, n;
+
+  x = (term_t *) malloc(p * h * sizeof(term_t));
+  a = (term_t *) malloc((p * h + p + 1) * sizeof(term_t));
+  if (x == NULL || a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+
+  for (i=0; i<p * h; i++) {
+    x[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+
+  n = 0;
+  // every pigeon is in a hole
+  for (i=0; i<p; i++) {
+    a[n++] = yices_or(h, x + i * h);
+  }
+  f = yices_and(n, a);
+
+  // no two pigeons in the same hole
+  for (j=0; j<h; j++) {
+    for (i=0; i<p; i++) {
+      for (k=i+1; k<p; k++) {
+        f = yices_and2(f, yices_or2(yices_not(x[i * h + j]), yices_not(x[k * h + j])));
+      }
+    }
+  }
+
+  free(a);
+  free(x);
+
+  return f;
+}
+
+
+/*
+ * Arithmetic problem with large coefficients: forces the
+ * use of GMP rationals in all the workers.
+ * - sat if sat is true, unsat otherwise
+ */
+static term_t big_arith(bool sat) {
+  term_t x, y, big, f;
+
+  x = yices_new_uninterpreted_term(yices_real_type());
+  y = yices_new_uninterpreted_term(yices_real_type());
+  big = yices_parse_rational("123456789012345678901234567890/7");
+  f = yices_and3(yices_arith_geq_atom(yices_add(x, y), big),
+                 yices_arith_leq_atom(x, yices_mul(yices_int32(3), big)),
+                 yices_arith_leq_atom(y, sat ? big : yices_mul(yices_int32(-3), big)));
+  return yices_and2(f, yices_arith_geq_atom(x, yices_mul(yices_int32(2), big)));
+}
+
+
+/*
+ * Run a portfolio on formula f with logic and check the result
+ */
+static void test_portfolio(const char *logic, term_t f, smt_status_t expected, bool share) {
+  ctx_config_t *config;
+  context_t *ctx[NUM_WORKERS];
+  param_t *params;
+  smt_status_t stat;
+  model_t *mdl;
+  int32_t winner;
+  uint32_t i;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, logic);
+  yices_set_config(config, "mode", "interactive");
+  for (i=0; i<NUM_WORKERS; i++) {
+    ctx[i] = yices_new_context(config);
+    assert(ctx[i] != NULL);
+    assert(yices_assert_formula(ctx[i], f) == 0);
+  }
+  yices_free_config(config);
+
+  params = yices_new_param_record();
+  yices_default_params_for_context(ctx[0], params);
+  if (share) {
+    assert(yices_set_param(params, "share-clauses", "true") == 0);
+    assert(yices_set_param(params, "share-max-length", "10") == 0);
+  }
+
+  stat = yices_check_context_portfolio(NUM_WORKERS, ctx, params, &winner);
+  printf("portfolio (%s%s): status = %d, winner = %"PRId32"\n", logic,
+         share ? ", sharing" : "", (int) stat, winner);
+  yices_free_param_record(params);
+  fflush(stdout);
+
+  assert(stat == expected);
+  assert(0 <= winner && winner < NUM_WORKERS);
+  assert(yices_context_status(ctx[winner]) == expected);
+
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx[winner], true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  // the losers must be usable again (interactive mode)
+  for (i=0; i<NUM_WORKERS; i++) {
+    stat = yices_context_status(ctx[i]);
+    assert(stat == STATUS_IDLE || stat == expected);
+  }
+
+  for (i=0; i<NUM_WORKERS; i++) {
+    yices_free_context(ctx[i]);
+  }
+}
+
+
+/*
+ * Errors: empty portfolio, duplicate contexts, non-idle context
+ */
+static void test_errors(void) {
+  context_t *ctx[2];
+  int32_t winner;
+
+  ctx[0] = yices_new_context(NULL);
+  ctx[1] = ctx[0];
+
+  assert(yices_check_context_portfolio(0, ctx, NULL, &winner) == STATUS_ERROR);
+  assert(yices_error_code() == CTX_INVALID_OPERATION);
+  yices_clear_error();
+
+  assert(yices_check_context_portfolio(2, ctx, NULL, &winner) == STATUS_ERROR);
+  assert(yices_error_code() == CTX_INVALID_OPERATION);
+  yices_clear_error();
+
+  assert(yices_check_context_portfolio(1, ctx, NULL, &winner) == STATUS_SAT);
+  assert(winner == 0);
+
+  // ctx[0] is now SAT
+  assert(yices_check_context_portfolio(1, ctx, NULL, &winner) == STATUS_ERROR);
+  assert(yices_error_code() == CTX_INVALID_OPERATION);
+  yices_clear_error();
+
+  yices_free_context(ctx[0]);
+}
+
+
+int main(void) {
+  yices_init();
+
+  test_errors();
+  test_portfolio("QF_UF", pigeon_hole(7, 7), STATUS_SAT, false);
+  test_portfolio("QF_UF", pigeon_hole(8, 7), STATUS_UNSAT, false);
+  test_portfolio("QF_LRA", big_arith(true), STATUS_SAT, false);
+  test_portfolio("QF_LRA", big_arith(false), STATUS_UNSAT, false);
+
+  test_portfolio("QF_UF", pigeon_hole(7, 7), STATUS_SAT, true);
+  test_portfolio("QF_UF", pigeon_hole(8, 7), STATUS_UNSAT, true);
+  test_portfolio("QF_LRA", big_arith(false), STATUS_UNSAT, true);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,306 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * MICROBENCHMARKS FOR RATIONAL ARITHMETIC
+ *
+ * Time q_add, q_mul, and q_addmul on vectors of rationals. The
+ * operands are small integers, small fractions, fractions whose
+ * intermediate products overflow 32 bits, or GMP numbers. The last
+ * benchmark mimics simplex pivoting (row_i := row_i - a * row_k).
+ *
+ * All results are checked against GMP.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <gmp.h>
+
+#include "terms/rationals.h"
+#include "utils/cputime.h"
+
+
+#define N 1000
+#define NROUNDS 1000
+
+static rational_t a[N], b[N], c[N];
+static mpq_t qa[N], qb[N], qc[N];
+
+
+/*
+ * Kinds of operands
+ */
+typedef enum {
+  SMALL_INT,  // integers in [-100, 100]
+  SMALL_FRAC, // fractions with numerator and denominator < 1000
+  WIDE_FRAC,  // fractions with numerator and denominator < 2^20
+  BIG,        // GMP numbers
+} operand_kind_t;
+
+#define NUM_KINDS 4
+
+static const char * const kind_name[NUM_KINDS] = {
+  "small int", "small frac", "wide frac", "big",
+};
+
+
+static void random_rational(rational_t *r, operand_kind_t kind) {
+  int64_t num;
+  uint32_t den;
+
+  switch (kind) {
+  case SMALL_INT:
+    q_set32(r, (int32_t) (random() % 201) - 100);
+    break;
+
+  case SMALL_FRAC:
+    num = (int32_t) (random() % 1999) - 999;
+    den = 1 + random() % 999;
+    q_set_int32(r, num, den);
+    break;
+
+  case WIDE_FRAC:
+    num = (int32_t) (random() % (1<<21)) - (1<<20);
+    den = 1 + random() % (1<<20);
+    q_set_int32(r, num, den);
+    break;
+
+  case BIG:
+    num = (int64_t) random() * (int64_t) random();
+    if (random() & 1) num = - num;
+    den = 1 + random() % 999;
+    q_set_int64(r, num, den);
+    break;
+  }
+}
+
+
+/*
+ * Fill in a[i] and b[i] with random operands
+ */
+static void init_operands(operand_kind_t kind_a, operand_kind_t kind_b) {
+  uint32_t i;
+
+  for (i=0; i<N; i++) {
+    random_rational(&a[i], kind_a);
+    random_rational(&b[i], kind_b);
+    random_rational(&c[i], kind_b);
+    q_get_mpq(&a[i], qa[i]);
+    q_get_mpq(&b[i], qb[i]);
+    q_get_mpq(&c[i], qc[i]);
+  }
+}
+
+
+static void check_result(rational_t *r, mpq_t q) {
+  mpq_t aux;
+
+  mpq_init(aux);
+  q_get_mpq(r, aux);
+  if (! mpq_equal(aux, q)) {
+    printf("Error: r = ");
+    q_print(stdout, r);
+    printf(", expected ");
+    mpq_out_str(stdout, 10, q);
+    printf("\n");
+    fflush(stdout);
+    abort();
+  }
+  mpq_clear(aux);
+}
+
+
+static void check_all(void) {
+  uint32_t i;
+
+  for (i=0; i<N; i++) {
+    check_result(&a[i], qa[i]);
+  }
+}
+
+
+static void show_time(const char *op, operand_kind_t kind_a, operand_kind_t kind_b, double time) {
+  printf("%-8s %-10s %-10s: %8.4f s  (%.1f ns/op)\n", op, kind_name[kind_a], kind_name[kind_b],
+         time, 1e9 * time / ((double) N * NROUNDS));
+  fflush(stdout);
+}
+
+
+/*
+ * a[i] := a[i] + b[i] then a[i] := a[i] - b[i]
+ */
+static void bench_add(operand_kind_t kind_a, operand_kind_t kind_b) {
+  double time;
+  uint32_t i, k;
+
+  init_operands(kind_a, kind_b);
+  time = get_cpu_time();
+  for (k=0; k<NROUNDS; k += 2) {
+    for (i=0; i<N; i++) {
+      q_add(&a[i], &b[i]);
+    }
+    for (i=0; i<N; i++) {
+      q_sub(&a[i], &b[i]);
+    }
+  }
+  time = get_cpu_time() - time;
+  show_time("add/sub", kind_a, kind_b, time);
+  check_all();
+}
+
+
+/*
+ * a[i] := a[i] * b[i] then a[i] := a[i] / b[i]
+ */
+static void bench_mul(operand_kind_t kind_a, operand_kind_t kind_b) {
+  double time;
+  uint32_t i, k;
+
+  init_operands(kind_a, kind_b);
+  for (i=0; i<N; i++) {
+    if (q_is_zero(&b[i])) {
+      q_set_one(&b[i]);
+      mpq_set_ui(qb[i], 1, 1);
+    }
+  }
+  time = get_cpu_time();
+  for (k=0; k<NROUNDS; k += 2) {
+    for (i=0; i<N; i++) {
+      q_mul(&a[i], &b[i]);
+    }
+    for (i=0; i<N; i++) {
+      q_div(&a[i], &b[i]);
+    }
+  }
+  time = get_cpu_time() - time;
+  show_time("mul/div", kind_a, kind_b, time);
+  check_all();
+}
+
+
+/*
+ * a[i] := a[i] + b[i] * c[i] then a[i] := a[i] - b[i] * c[i]
+ */
+static void bench_addmul(operand_kind_t kind_a, operand_kind_t kind_b) {
+  double time;
+  uint32_t i, k;
+
+  init_operands(kind_a, kind_b);
+  time = get_cpu_time();
+  for (k=0; k<NROUNDS; k += 2) {
+    for (i=0; i<N; i++) {
+      q_addmul(&a[i], &b[i], &c[i]);
+    }
+    for (i=0; i<N; i++) {
+      q_submul(&a[i], &b[i], &c[i]);
+    }
+  }
+  time = get_cpu_time() - time;
+  show_time("addmul", kind_a, kind_b, time);
+  check_all();
+}
+
+
+/*
+ * Pivoting: a is row i, b is row k, and c[0] is the multiplier
+ * - a[j] := a[j] - c[0] * b[j] for all j, and check against GMP
+ * - this is repeated with a fresh row a every 8 rounds so that the
+ *   coefficients stay of moderate size
+ */
+static void bench_pivot(operand_kind_t kind) {
+  mpq_t aux;
+  double time, total;
+  uint32_t i, k;
+
+  mpq_init(aux);
+  total = 0;
+  for (k=0; k<NROUNDS; k++) {
+    if ((k & 7) == 0) {
+      init_operands(kind, kind);
+    }
+    time = get_cpu_time();
+    for (i=0; i<N; i++) {
+      q_submul(&a[i], &c[0], &b[i]);
+    }
+    total += get_cpu_time() - time;
+
+    for (i=0; i<N; i++) {
+      mpq_mul(aux, qc[0], qb[i]);
+      mpq_sub(qa[i], qa[i], aux);
+    }
+  }
+  mpq_clear(aux);
+
+  show_time("pivot", kind, kind, total);
+  check_all();
+}
+
+
+int main(void) {
+  uint32_t i, k, j;
+
+  init_rationals();
+  for (i=0; i<N; i++) {
+    q_init(&a[i]);
+    q_init(&b[i]);
+    q_init(&c[i]);
+    mpq_init(qa[i]);
+    mpq_init(qb[i]);
+    mpq_init(qc[i]);
+  }
+
+  srandom(18271);
+
+  for (k=0; k<NUM_KINDS; k++) {
+    for (j=0; j<NUM_KINDS; j++) {
+      bench_add(k, j);
+    }
+  }
+  printf("\n");
+  for (k=0; k<NUM_KINDS; k++) {
+    for (j=0; j<NUM_KINDS; j++) {
+      bench_mul(k, j);
+    }
+  }
+  printf("\n");
+  for (k=0; k<NUM_KINDS; k++) {
+    for (j=0; j<NUM_KINDS; j++) {
+      bench_addmul(k, j);
+    }
+  }
+  printf("\n");
+  for (k=0; k<NUM_KINDS; k++) {
+    bench_pivot(k);
+  }
+
+  for (i=0; i<N; i++) {
+    q_clear(&a[i]);
+    q_clear(&b[i]);
+    q_clear(&c[i]);
+    mpq_clear(qa[i]);
+    mpq_clear(qb[i]);
+    mpq_clear(qc[i]);
+  }
+  cleanup_rationals();
+
+  printf("\nAll tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE RESTART STRATEGIES
+ *
+ * Random 3-SAT problems near the phase transition are solved with
+ * every restart strategy. The results must agree with the default
+ * strategy and all models are checked. The stable strategy is also
+ * used with short phases so that the core switches between focused
+ * and stable mode several times.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+#define NVARS 150
+#define NCLAUSES 640
+#define NROUNDS 12
+
+#define NSTRATEGIES 6
+
+static const char * const strategy[NSTRATEGIES] = {
+  "default", "minisat", "picosat", "luby", "glucose", "stable",
+};
+
+static term_t var[NVARS];
+
+static term_t random_literal(void) {
+  term_t x;
+
+  x = var[random() % NVARS];
+  return (random() & 1) ? x : yices_not(x);
+}
+
+static term_t random_formula(uint32_t n) {
+  term_t *a;
+  term_t f;
+  uint32_t i;
+
+  a = (term_t *) malloc(n * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    a[i] = yices_or3(random_literal(), random_literal(), random_literal());
+  }
+  f = yices_and(n, a);
+  free(a);
+
+  return f;
+}
+
+/*
+ * Check f in a fresh context and verify the model if it's sat
+ */
+static smt_status_t check(param_t *params, term_t f) {
+  context_t *ctx;
+  smt_status_t stat;
+  model_t *mdl;
+
+  ctx = yices_new_context(NULL);
+  assert(ctx != NULL);
+  assert(yices_assert_formula(ctx, f) == 0);
+  stat = yices_check_context(ctx, params);
+  assert(stat == STATUS_SAT || stat == STATUS_UNSAT);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+  yices_free_context(ctx);
+
+  return stat;
+}
+
+int main(void) {
+  param_t *params[NSTRATEGIES + 1];
+  term_t f;
+  smt_status_t s0, s;
+  uint32_t i, j, nsat, nunsat;
+
+  yices_init();
+
+  for (i=0; i<NVARS; i++) {
+    var[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+
+  for (j=0; j<NSTRATEGIES; j++) {
+    params[j] = yices_new_param_record();
+    assert(yices_set_param(params[j], "restart", strategy[j]) == 0);
+  }
+
+  // stable with short phases
+  params[j] = yices_new_param_record();
+  assert(yices_set_param(params[j], "restart", "stable") == 0);
+  assert(yices_set_param(params[j], "stab-threshold", "20") == 0);
+  assert(yices_set_param(params[j], "stab-factor", "1.5") == 0);
+  assert(yices_set_param(params[j], "lbd-margin", "1.1") == 0);
+
+  // invalid settings
+  assert(yices_set_param(params[0], "restart", "fast") < 0);
+  assert(yices_set_param(params[0], "lbd-margin", "0.5") < 0);
+  assert(yices_set_param(params[0], "stab-threshold", "0") < 0);
+  assert(yices_set_param(params[0], "stab-factor", "0.9") < 0);
+
+  srandom(1717);
+  nsat = 0;
+  nunsat = 0;
+
+  for (i=0; i<NROUNDS; i++) {
+    f = random_formula(NCLAUSES);
+    s0 = check(params[0], f);
+    for (j=1; j<=NSTRATEGIES; j++) {
+      s = check(params[j], f);
+      assert(s == s0);
+    }
+    if (s0 == STATUS_SAT) nsat ++; else nunsat ++;
+  }
+
+  printf("%"PRIu32" sat, %"PRIu32" unsat\n", nsat, nunsat);
+
+  for (j=0; j<=NSTRATEGIES; j++) {
+    yices_free_param_record(params[j]);
+  }
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
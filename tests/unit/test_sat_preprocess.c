@@ -0,0 +1,207 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST SAT PREPROCESSING IN SMT_CORE
+ *
+ * Random 3-SAT formulas are checked with and without preprocessing.
+ * The status must agree and the models must satisfy the formulas.
+ * In multi-checks mode, more clauses are added after each check so that
+ * eliminated variables must be restored.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+#define NVARS 60
+#define NCLAUSES 250
+#define NROUNDS 4
+
+static term_t var[NVARS];
+
+
+/*
+ * Random literal/clause/formula
+ */
+static term_t random_literal(void) {
+  term_t x;
+
+  x = var[random() % NVARS];
+  return (random() & 1) ? x : yices_not(x);
+}
+
+static term_t random_clause(void) {
+  return yices_or3(random_literal(), random_literal(), random_literal());
+}
+
+static term_t random_formula(uint32_t n) {
+  term_t *a;
+  term_t f;
+  uint32_t i;
+
+  a = (term_t *) malloc(n * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    a[i] = random_clause();
+  }
+  f = yices_and(n, a);
+  free(a);
+
+  return f;
+}
+
+
+/*
+ * Create a context in multi-checks mode for the given logic
+ */
+static context_t *new_context(const char *logic) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, logic) == 0);
+  assert(yices_set_config(config, "mode", "multi-checks") == 0);
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+
+  return ctx;
+}
+
+
+/*
+ * Check ctx with or without preprocessing
+ * - if the result is sat, check that the model satisfies f
+ */
+static smt_status_t check(context_t *ctx, term_t f, bool preprocess) {
+  param_t *params;
+  model_t *mdl;
+  smt_status_t stat;
+
+  params = yices_new_param_record();
+  yices_default_params_for_context(ctx, params);
+  assert(yices_set_param(params, "sat-preprocess", preprocess ? "true" : "false") == 0);
+  stat = yices_check_context(ctx, params);
+  yices_free_param_record(params);
+
+  assert(stat == STATUS_SAT || stat == STATUS_UNSAT);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return stat;
+}
+
+
+/*
+ * Single check: compare the result with a context that doesn't preprocess
+ */
+static void test_one_check(const char *logic, uint32_t n) {
+  context_t *ctx1, *ctx2;
+  smt_status_t s1, s2;
+  term_t f;
+
+  f = random_formula(n);
+
+  ctx1 = new_context(logic);
+  ctx2 = new_context(logic);
+  assert(yices_assert_formula(ctx1, f) == 0);
+  assert(yices_assert_formula(ctx2, f) == 0);
+  s1 = check(ctx1, f, true);
+  s2 = check(ctx2, f, false);
+  assert(s1 == s2);
+
+  yices_free_context(ctx1);
+  yices_free_context(ctx2);
+}
+
+
+/*
+ * Several checks: after each check, add more clauses
+ * - variables eliminated in earlier checks must be restored
+ */
+static void test_multi_checks(const char *logic, uint32_t n) {
+  context_t *ctx1, *ctx2;
+  smt_status_t s1, s2;
+  term_t f, g;
+  uint32_t i;
+
+  ctx1 = new_context(logic);
+  ctx2 = new_context(logic);
+
+  f = yices_true();
+  for (i=0; i<NROUNDS; i++) {
+    g = random_formula(n);
+    f = yices_and2(f, g);
+    assert(yices_assert_formula(ctx1, g) == 0);
+    assert(yices_assert_formula(ctx2, g) == 0);
+    s1 = check(ctx1, f, true);
+    s2 = check(ctx2, f, false);
+    assert(s1 == s2);
+    if (s1 == STATUS_UNSAT) break;
+  }
+
+  yices_free_context(ctx1);
+  yices_free_context(ctx2);
+}
+
+
+int main(void) {
+  uint32_t i;
+
+  yices_init();
+
+  for (i=0; i<NVARS; i++) {
+    var[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+
+  srandom(1234);
+  for (i=0; i<20; i++) {
+    test_one_check("NONE", NCLAUSES);
+    test_one_check("QF_UF", NCLAUSES + 10);
+  }
+  for (i=0; i<10; i++) {
+    test_multi_checks("NONE", NCLAUSES/NROUNDS);
+    test_multi_checks("QF_BV", NCLAUSES/NROUNDS + 5);
+  }
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,300 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE SIMPLEX PIVOTING STRATEGIES
+ *
+ * The same problems are solved with the default pivoting rule,
+ * with steepest-edge and devex pricing, and with bound flipping.
+ * The results must agree and all models are checked. The number
+ * of pivots and bound flips of each strategy are reported.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "context/context.h"
+#include "solvers/simplex/simplex.h"
+#include "utils/cputime.h"
+#include "yices.h"
+
+
+#define NSTRATEGIES 5
+
+static const char * const strategy_name[NSTRATEGIES] = {
+  "default", "steepest-edge", "devex", "bound-flipping", "devex+flipping",
+};
+
+/*
+ * Options to enable for each strategy (NULL terminated)
+ */
+static const char * const strategy_options[NSTRATEGIES][3] = {
+  { NULL, NULL, NULL },
+  { "arith-steepest-edge", NULL, NULL },
+  { "arith-devex", NULL, NULL },
+  { "arith-bound-flipping", NULL, NULL },
+  { "arith-devex", "arith-bound-flipping", NULL },
+};
+
+
+/*
+ * Totals for each strategy
+ */
+static uint32_t total_pivots[NSTRATEGIES];
+static uint32_t total_flips[NSTRATEGIES];
+static double total_time[NSTRATEGIES];
+
+
+static context_t *new_context(uint32_t i, const char *logic) {
+  ctx_config_t *config;
+  context_t *ctx;
+  uint32_t j;
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, logic) == 0);
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+
+  for (j=0; strategy_options[i][j] != NULL; j++) {
+    assert(yices_context_enable_option(ctx, strategy_options[i][j]) == 0);
+  }
+
+  return ctx;
+}
+
+
+/*
+ * Solve f with all strategies and check that they agree
+ */
+static smt_status_t solve(term_t f, const char *logic) {
+  context_t *ctx;
+  model_t *mdl;
+  smt_status_t s[NSTRATEGIES];
+  simplex_solver_t *simplex;
+  double time;
+  uint32_t i;
+
+  for (i=0; i<NSTRATEGIES; i++) {
+    ctx = new_context(i, logic);
+    assert(context_has_simplex_solver(ctx));
+    simplex = ctx->arith_solver;
+    assert(simplex_option_enabled(simplex, SIMPLEX_STEEPEST_EDGE) == (i == 1));
+    assert(simplex_option_enabled(simplex, SIMPLEX_DEVEX) == (i == 2 || i == 4));
+    assert(simplex_option_enabled(simplex, SIMPLEX_BOUND_FLIPPING) == (i >= 3));
+
+    time = get_cpu_time();
+    assert(yices_assert_formula(ctx, f) == 0);
+    s[i] = yices_check_context(ctx, NULL);
+    total_time[i] += get_cpu_time() - time;
+
+    assert(s[i] == STATUS_SAT || s[i] == STATUS_UNSAT);
+    assert(s[i] == s[0]);
+    if (s[i] == STATUS_SAT) {
+      mdl = yices_get_model(ctx, true);
+      assert(mdl != NULL);
+      assert(yices_formula_true_in_model(mdl, f) == 1);
+      yices_free_model(mdl);
+    }
+
+    total_pivots[i] += simplex_num_pivots(simplex);
+    total_flips[i] += simplex_num_bound_flips(simplex);
+    yices_free_context(ctx);
+  }
+
+  return s[0];
+}
+
+
+/*
+ * Random linear term: sum of k terms a_i x_i with a_i in [-coeff, coeff]
+ */
+static term_t random_poly(term_t *x, uint32_t n, uint32_t k, int32_t coeff) {
+  term_t *a;
+  term_t p;
+  uint32_t i;
+  int32_t c;
+
+  a = (term_t *) malloc(k * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<k; i++) {
+    do {
+      c = (int32_t) (random() % (2 * coeff + 1)) - coeff;
+    } while (c == 0);
+    a[i] = yices_mul(yices_int32(c), x[random() % n]);
+  }
+  p = yices_sum(k, a);
+  free(a);
+
+  return p;
+}
+
+
+/*
+ * Conjunction of m random constraints on n variables
+ * - each variable is in [-bound, bound]
+ * - constraint: p <= c where p is a random polynomial with k monomials
+ */
+static term_t random_system(term_t *x, uint32_t n, uint32_t m, uint32_t k, int32_t bound) {
+  term_t *a;
+  term_t f, b;
+  uint32_t i;
+
+  a = (term_t *) malloc((m + 2 * n) * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  b = yices_int32(bound);
+  for (i=0; i<n; i++) {
+    a[2*i] = yices_arith_leq_atom(x[i], b);
+    a[2*i+1] = yices_arith_geq_atom(x[i], yices_neg(b));
+  }
+  for (i=0; i<m; i++) {
+    a[2*n + i] = yices_arith_leq_atom(random_poly(x, n, k, 9),
+                                      yices_int32((int32_t) (random() % (2 * bound)) - bound/2));
+  }
+  f = yices_and(m + 2 * n, a);
+  free(a);
+
+  return f;
+}
+
+
+/*
+ * Random disjunctions of constraints
+ */
+static term_t random_clauses(term_t *x, uint32_t n, uint32_t m, uint32_t k, int32_t bound) {
+  term_t *a;
+  term_t f, l1, l2;
+  uint32_t i;
+
+  a = (term_t *) malloc((m + 2 * n) * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    a[2*i] = yices_arith_leq_atom(x[i], yices_int32(bound));
+    a[2*i+1] = yices_arith_geq_atom(x[i], yices_int32(-bound));
+  }
+  for (i=0; i<m; i++) {
+    l1 = yices_arith_leq_atom(random_poly(x, n, k, 5), yices_int32((int32_t) (random() % bound)));
+    l2 = yices_arith_geq_atom(random_poly(x, n, k, 5), yices_int32((int32_t) (random() % bound)));
+    a[2*n + i] = yices_or2(l1, l2);
+  }
+  f = yices_and(m + 2 * n, a);
+  free(a);
+
+  return f;
+}
+
+
+static term_t *new_vars(uint32_t n, type_t tau) {
+  term_t *x;
+  uint32_t i;
+
+  x = (term_t *) malloc(n * sizeof(term_t));
+  if (x == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    x[i] = yices_new_uninterpreted_term(tau);
+  }
+  return x;
+}
+
+
+static void show_totals(const char *what) {
+  uint32_t i;
+
+  printf("%s:\n", what);
+  for (i=0; i<NSTRATEGIES; i++) {
+    printf("  %-16s %8"PRIu32" pivots %8"PRIu32" flips %8.3f s\n",
+           strategy_name[i], total_pivots[i], total_flips[i], total_time[i]);
+    total_pivots[i] = 0;
+    total_flips[i] = 0;
+    total_time[i] = 0;
+  }
+  fflush(stdout);
+}
+
+
+int main(void) {
+  term_t *x;
+  uint32_t i, nsat;
+
+  yices_init();
+  srandom(4321);
+
+  // small real systems
+  x = new_vars(20, yices_real_type());
+  nsat = 0;
+  for (i=0; i<200; i++) {
+    if (solve(random_system(x, 20, 15, 4, 10), "QF_LRA") == STATUS_SAT) nsat ++;
+  }
+  printf("small LRA systems: %"PRIu32" sat, %"PRIu32" unsat\n", nsat, 200 - nsat);
+  show_totals("small LRA systems");
+  free(x);
+
+  // small integer problems
+  x = new_vars(10, yices_int_type());
+  nsat = 0;
+  for (i=0; i<50; i++) {
+    if (solve(random_clauses(x, 10, 12, 3, 20), "QF_LIA") == STATUS_SAT) nsat ++;
+  }
+  printf("small LIA clauses: %"PRIu32" sat, %"PRIu32" unsat\n", nsat, 50 - nsat);
+  show_totals("small LIA clauses");
+  free(x);
+
+  // disjunctive real problems
+  x = new_vars(30, yices_real_type());
+  for (i=0; i<10; i++) {
+    (void) solve(random_clauses(x, 30, 40, 4, 50), "QF_LRA");
+  }
+  show_totals("LRA clauses");
+  free(x);
+
+  // large real systems
+  x = new_vars(2000, yices_real_type());
+  for (i=0; i<3; i++) {
+    (void) solve(random_system(x, 2000, 1500, 6, 100), "QF_LRA");
+  }
+  show_totals("large LRA systems");
+  free(x);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
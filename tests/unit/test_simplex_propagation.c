@@ -0,0 +1,256 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST SIMPLEX BOUND PROPAGATION
+ *
+ * Random problems are solved with and without simplex propagation.
+ * The results must agree and all models are checked. The number of
+ * derived bounds is reported. When compiled in debug mode, the
+ * propagator checks its cached row bounds against a full recomputation.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "context/context.h"
+#include "solvers/simplex/simplex.h"
+#include "utils/cputime.h"
+#include "yices.h"
+
+
+/*
+ * Totals with propagation disabled (index 0) and enabled (index 1)
+ */
+static uint32_t total_bound_props[2];
+static uint32_t total_conflicts[2];
+static double total_time[2];
+
+
+/*
+ * Solve f in a fresh context
+ * - if push is true, f is asserted after a push so that the
+ *   search backtracks into a non-zero base level
+ */
+static smt_status_t solve_with(term_t f, const char *logic, bool prop, bool push) {
+  ctx_config_t *config;
+  param_t *params;
+  context_t *ctx;
+  model_t *mdl;
+  simplex_solver_t *simplex;
+  smt_status_t s;
+  double time;
+
+  config = yices_new_config();
+  assert(yices_default_config_for_logic(config, logic) == 0);
+  if (push) {
+    assert(yices_set_config(config, "mode", "push-pop") == 0);
+  }
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+  assert(context_has_simplex_solver(ctx));
+  simplex = ctx->arith_solver;
+
+  params = yices_new_param_record();
+  yices_default_params_for_context(ctx, params);
+  assert(yices_set_param(params, "simplex-prop", prop ? "true" : "false") == 0);
+
+  if (push) {
+    assert(yices_push(ctx) == 0);
+  }
+
+  time = get_cpu_time();
+  assert(yices_assert_formula(ctx, f) == 0);
+  s = yices_check_context(ctx, params);
+  total_time[prop] += get_cpu_time() - time;
+
+  assert(s == STATUS_SAT || s == STATUS_UNSAT);
+  if (s == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  assert(simplex_option_enabled(simplex, SIMPLEX_PROPAGATION) == prop);
+  total_bound_props[prop] += simplex->stats.num_bound_props;
+  total_conflicts[prop] += simplex_num_conflicts(simplex);
+
+  if (push) {
+    assert(yices_pop(ctx) == 0);
+  }
+
+  yices_free_param_record(params);
+  yices_free_context(ctx);
+
+  return s;
+}
+
+
+/*
+ * Solve f with and without propagation and check that the results agree
+ */
+static smt_status_t solve(term_t f, const char *logic, bool push) {
+  smt_status_t s0, s1;
+
+  s0 = solve_with(f, logic, false, push);
+  s1 = solve_with(f, logic, true, push);
+  assert(s0 == s1);
+
+  return s0;
+}
+
+
+/*
+ * Random linear term: sum of k terms a_i x_i with a_i in [-coeff, coeff]
+ */
+static term_t random_poly(term_t *x, uint32_t n, uint32_t k, int32_t coeff) {
+  term_t *a;
+  term_t p;
+  uint32_t i;
+  int32_t c;
+
+  a = (term_t *) malloc(k * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<k; i++) {
+    do {
+      c = (int32_t) (random() % (2 * coeff + 1)) - coeff;
+    } while (c == 0);
+    a[i] = yices_mul(yices_int32(c), x[random() % n]);
+  }
+  p = yices_sum(k, a);
+  free(a);
+
+  return p;
+}
+
+
+/*
+ * Random disjunctions of constraints
+ * - some variables are left unbounded on one side so that rows
+ *   have monomials with missing bounds
+ */
+static term_t random_clauses(term_t *x, uint32_t n, uint32_t m, uint32_t k, int32_t bound) {
+  term_t *a;
+  term_t f, l1, l2;
+  uint32_t i, j;
+
+  a = (term_t *) malloc((m + 2 * n) * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (i % 4 != 1) {
+      a[j++] = yices_arith_leq_atom(x[i], yices_int32(bound));
+    }
+    if (i % 4 != 2) {
+      a[j++] = yices_arith_geq_atom(x[i], yices_int32(-bound));
+    }
+  }
+  for (i=0; i<m; i++) {
+    l1 = yices_arith_leq_atom(random_poly(x, n, k, 5), yices_int32((int32_t) (random() % bound)));
+    l2 = yices_arith_geq_atom(random_poly(x, n, k, 5), yices_int32((int32_t) (random() % bound) - bound));
+    a[j++] = yices_or2(l1, l2);
+  }
+  f = yices_and(j, a);
+  free(a);
+
+  return f;
+}
+
+
+static term_t *new_vars(uint32_t n, type_t tau) {
+  term_t *x;
+  uint32_t i;
+
+  x = (term_t *) malloc(n * sizeof(term_t));
+  if (x == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    x[i] = yices_new_uninterpreted_term(tau);
+  }
+  return x;
+}
+
+
+static void show_totals(const char *what) {
+  uint32_t i;
+
+  printf("%s:\n", what);
+  for (i=0; i<2; i++) {
+    printf("  %-16s %8"PRIu32" bound props %8"PRIu32" conflicts %8.3f s\n",
+           i ? "propagation" : "no propagation", total_bound_props[i], total_conflicts[i], total_time[i]);
+    total_bound_props[i] = 0;
+    total_conflicts[i] = 0;
+    total_time[i] = 0;
+  }
+  fflush(stdout);
+}
+
+
+int main(void) {
+  term_t *x;
+  uint32_t i, nsat;
+
+  yices_init();
+  srandom(1234);
+
+  // small integer problems
+  x = new_vars(10, yices_int_type());
+  nsat = 0;
+  for (i=0; i<60; i++) {
+    if (solve(random_clauses(x, 10, 14, 3, 20), "QF_LIA", i % 3 == 0) == STATUS_SAT) nsat ++;
+  }
+  printf("small LIA clauses: %"PRIu32" sat, %"PRIu32" unsat\n", nsat, 60 - nsat);
+  show_totals("small LIA clauses");
+  free(x);
+
+  // integer problems with small domains
+  x = new_vars(12, yices_int_type());
+  nsat = 0;
+  for (i=0; i<20; i++) {
+    if (solve(random_clauses(x, 12, 30, 3, 3), "QF_LIA", i % 2 == 0) == STATUS_SAT) nsat ++;
+  }
+  printf("LIA clauses: %"PRIu32" sat, %"PRIu32" unsat\n", nsat, 20 - nsat);
+  show_totals("LIA clauses");
+  free(x);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,361 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE SPARSE IDL SOLVER
+ *
+ * Random difference-logic problems and small job-shop scheduling
+ * problems are solved by the sparse IDL solver (with several
+ * propagation bounds) and by simplex. The results must agree
+ * and all models are checked. The random problems are solved in
+ * push/pop mode.
+ */
+
+/*
+ * Force assert to work even if compiled with debug disabled
+ */
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "context/context.h"
+#include "solvers/floyd_warshall/idl_sparse.h"
+#include "yices.h"
+
+
+#define NINTS 25
+#define NCLAUSES 70
+#define NEXTRA 20
+#define NROUNDS 8
+
+#define NCTX 4
+
+static term_t ivar[NINTS];
+
+/*
+ * Propagation bound for each sparse context (ctx[0] is simplex)
+ */
+static const uint32_t prop_bound[NCTX] = {
+  0, DEFAULT_SIDL_PROP_BOUND, 0, 3,
+};
+
+
+/*
+ * Random atom: (x - y <= c), (x - y = c), (x <= c), or (x >= c)
+ */
+static term_t random_atom(void) {
+  term_t x, y, c;
+
+  x = ivar[random() % NINTS];
+  y = ivar[random() % NINTS];
+  c = yices_int32((int32_t) (random() % 21) - 10);
+
+  switch (random() % 6) {
+  case 0:
+    return yices_arith_eq_atom(yices_sub(x, y), c);
+  case 1:
+    return yices_arith_leq_atom(x, c);
+  case 2:
+    return yices_arith_geq_atom(x, c);
+  default:
+    return yices_arith_leq_atom(yices_sub(x, y), c);
+  }
+}
+
+static term_t random_literal(void) {
+  term_t a;
+
+  a = random_atom();
+  return (random() % 3 == 0) ? yices_not(a) : a;
+}
+
+static term_t random_formula(uint32_t n) {
+  term_t *a;
+  term_t f;
+  uint32_t i;
+
+  a = (term_t *) malloc(n * sizeof(term_t));
+  if (a == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+  for (i=0; i<n; i++) {
+    switch (random() % 8) {
+    case 0:
+      a[i] = random_literal();
+      break;
+    case 1:
+    case 2:
+      a[i] = yices_or2(random_literal(), random_literal());
+      break;
+    default:
+      a[i] = yices_or3(random_literal(), random_literal(), random_literal());
+      break;
+    }
+  }
+  f = yices_and(n, a);
+  free(a);
+
+  return f;
+}
+
+
+/*
+ * Contexts: sparse-idl or simplex
+ */
+static context_t *new_context(bool sparse, const char *mode) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  if (sparse) {
+    assert(yices_set_config(config, "uf-solver", "none") == 0);
+    assert(yices_set_config(config, "array-solver", "none") == 0);
+    assert(yices_set_config(config, "bv-solver", "none") == 0);
+    assert(yices_set_config(config, "arith-solver", "sparse-idl") == 0);
+    assert(yices_set_config(config, "arith-fragment", "IDL") == 0);
+  } else {
+    assert(yices_default_config_for_logic(config, "QF_IDL") == 0);
+  }
+  assert(yices_set_config(config, "mode", mode) == 0);
+  ctx = yices_new_context(config);
+  assert(ctx != NULL);
+  yices_free_config(config);
+
+  return ctx;
+}
+
+
+/*
+ * Check ctx and verify the model if it's sat
+ */
+static smt_status_t check(context_t *ctx, term_t f) {
+  smt_status_t stat;
+  model_t *mdl;
+
+  stat = yices_check_context(ctx, NULL);
+  assert(stat == STATUS_SAT || stat == STATUS_UNSAT);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    assert(mdl != NULL);
+    assert(yices_formula_true_in_model(mdl, f) == 1);
+    yices_free_model(mdl);
+  }
+
+  return stat;
+}
+
+
+/*
+ * ctx[0] uses simplex, the other contexts use the sparse solver
+ */
+static void test_random_formulas(void) {
+  context_t *ctx[NCTX];
+  term_t f, g;
+  smt_status_t s[NCTX];
+  uint32_t i, j, nsat, nunsat, nprops;
+
+  ctx[0] = new_context(false, "push-pop");
+  for (j=1; j<NCTX; j++) {
+    ctx[j] = new_context(true, "push-pop");
+    assert(context_has_sidl_solver(ctx[j]));
+    sidl_set_prop_bound(ctx[j]->arith_solver, prop_bound[j]);
+  }
+
+  nsat = 0;
+  nunsat = 0;
+
+  f = random_formula(NCLAUSES);
+  for (j=0; j<NCTX; j++) {
+    assert(yices_assert_formula(ctx[j], f) == 0);
+  }
+  for (j=0; j<NCTX; j++) {
+    s[j] = check(ctx[j], f);
+    assert(s[j] == s[0]);
+  }
+
+  for (i=0; i<NROUNDS && s[0] == STATUS_SAT; i++) {
+    g = random_formula(NEXTRA);
+    for (j=0; j<NCTX; j++) {
+      assert(yices_push(ctx[j]) == 0);
+      assert(yices_assert_formula(ctx[j], g) == 0);
+    }
+
+    for (j=0; j<NCTX; j++) {
+      s[j] = check(ctx[j], yices_and2(f, g));
+      assert(s[j] == s[0]);
+    }
+    if (s[0] == STATUS_SAT) nsat ++; else nunsat ++;
+
+    for (j=0; j<NCTX; j++) {
+      assert(yices_pop(ctx[j]) == 0);
+    }
+
+    for (j=0; j<NCTX; j++) {
+      s[j] = check(ctx[j], f);
+      assert(s[j] == s[0]);
+    }
+  }
+
+  nprops = ((sidl_solver_t *) ctx[1]->arith_solver)->stats.num_propagations;
+  printf("random: %"PRIu32" sat, %"PRIu32" unsat, %"PRIu32" propagations\n", nsat, nunsat, nprops);
+  assert(((sidl_solver_t *) ctx[2]->arith_solver)->stats.num_propagations == 0);
+
+  for (j=0; j<NCTX; j++) {
+    yices_free_context(ctx[j]);
+  }
+}
+
+
+/*
+ * Job-shop problem: n jobs on m machines
+ * - each job visits every machine once, in a random order
+ * - the tasks of a job are sequential; two tasks on the same machine can't overlap
+ * - all tasks must be complete by the deadline
+ */
+static term_t job_shop(uint32_t n, uint32_t m, int32_t deadline) {
+  term_t *start;
+  int32_t *dur;
+  uint32_t *machine;
+  ivector_t v;
+  term_t t, u, zero, a, b;
+  uint32_t i, j, k, tmp;
+
+  start = (term_t *) malloc(n * m * sizeof(term_t));
+  dur = (int32_t *) malloc(n * m * sizeof(int32_t));
+  machine = (uint32_t *) malloc(n * m * sizeof(uint32_t));
+  if (start == NULL || dur == NULL || machine == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+
+  init_ivector(&v, 10);
+  zero = yices_zero();
+
+  for (i=0; i<n; i++) {
+    // random permutation of the machines
+    for (j=0; j<m; j++) {
+      machine[i*m + j] = j;
+    }
+    for (j=m-1; j>0; j--) {
+      k = random() % (j+1);
+      tmp = machine[i*m + j];
+      machine[i*m + j] = machine[i*m + k];
+      machine[i*m + k] = tmp;
+    }
+
+    for (j=0; j<m; j++) {
+      start[i*m + j] = yices_new_uninterpreted_term(yices_int_type());
+      dur[i*m + j] = 1 + random() % 9;
+      ivector_push(&v, yices_arith_geq_atom(start[i*m + j], zero));
+      t = yices_add(start[i*m + j], yices_int32(dur[i*m + j]));
+      ivector_push(&v, yices_arith_leq_atom(t, yices_int32(deadline)));
+      if (j > 0) {
+        u = yices_add(start[i*m + j - 1], yices_int32(dur[i*m + j - 1]));
+        ivector_push(&v, yices_arith_leq_atom(u, start[i*m + j]));
+      }
+    }
+  }
+
+  // disjunctions: tasks on the same machine
+  for (i=0; i<n*m; i++) {
+    for (k=i+1; k<n*m; k++) {
+      if (i/m != k/m && machine[i] == machine[k]) {
+        a = yices_arith_leq_atom(yices_add(start[i], yices_int32(dur[i])), start[k]);
+        b = yices_arith_leq_atom(yices_add(start[k], yices_int32(dur[k])), start[i]);
+        ivector_push(&v, yices_or2(a, b));
+      }
+    }
+  }
+
+  t = yices_and(v.size, v.data);
+
+  delete_ivector(&v);
+  free(start);
+  free(dur);
+  free(machine);
+
+  return t;
+}
+
+
+/*
+ * Solve a job-shop problem with decreasing deadlines
+ */
+static void test_job_shop(uint32_t n, uint32_t m) {
+  context_t *ctx[NCTX];
+  smt_status_t s[NCTX];
+  term_t f;
+  int32_t deadline;
+  uint32_t j;
+
+  for (deadline = 12 * n; deadline > 0; deadline -= n) {
+    f = job_shop(n, m, deadline);
+
+    ctx[0] = new_context(false, "one-shot");
+    assert(yices_assert_formula(ctx[0], f) == 0);
+    s[0] = check(ctx[0], f);
+    for (j=1; j<NCTX; j++) {
+      ctx[j] = new_context(true, "one-shot");
+      sidl_set_prop_bound(ctx[j]->arith_solver, prop_bound[j]);
+      assert(yices_assert_formula(ctx[j], f) == 0);
+      s[j] = check(ctx[j], f);
+      assert(s[j] == s[0]);
+    }
+
+    printf("job shop %"PRIu32" x %"PRIu32", deadline %"PRId32": %s\n",
+           n, m, deadline, s[0] == STATUS_SAT ? "sat" : "unsat");
+
+    for (j=0; j<NCTX; j++) {
+      yices_free_context(ctx[j]);
+    }
+
+    if (s[0] == STATUS_UNSAT) break;
+  }
+}
+
+
+int main(void) {
+  uint32_t i;
+
+  yices_init();
+
+  for (i=0; i<NINTS; i++) {
+    ivar[i] = yices_new_uninterpreted_term(yices_int_type());
+  }
+
+  srandom(2929);
+  for (i=0; i<10; i++) {
+    test_random_formulas();
+  }
+  test_job_shop(3, 3);
+  test_job_shop(5, 4);
+  test_job_shop(6, 6);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}